@@ -71,6 +71,9 @@ std::string getAccelerationModelName( const AvailableAcceleration accelerationTy
     case solar_sail_acceleration:
         accelerationName = "solar sail acceleration";
         break;
+    case gridded_spherical_harmonic_gravity:
+        accelerationName = "gridded spherical harmonic gravity ";
+        break;
     default:
         std::string errorMessage = "Error, acceleration type " +
                 std::to_string( accelerationType ) +
@@ -127,6 +130,11 @@ AvailableAcceleration getAccelerationModelType(
     {
         accelerationType = mutual_spherical_harmonic_gravity;
     }
+    else if( std::dynamic_pointer_cast< GriddedSphericalHarmonicsGravitationalAccelerationModel >(
+                 accelerationModel ) != nullptr )
+    {
+        accelerationType = gridded_spherical_harmonic_gravity;
+    }
     else if( std::dynamic_pointer_cast< AerodynamicAcceleration >(
                  accelerationModel ) != nullptr )
     {
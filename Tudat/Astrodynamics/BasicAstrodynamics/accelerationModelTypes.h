@@ -16,6 +16,7 @@
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressure.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/griddedSphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/mutualSphericalHarmonicGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
@@ -61,7 +62,8 @@ enum AvailableAcceleration
     direct_tidal_dissipation_in_orbiting_body_acceleration,
     panelled_radiation_pressure_acceleration,
     momentum_wheel_desaturation_acceleration,
-    solar_sail_acceleration
+    solar_sail_acceleration,
+    gridded_spherical_harmonic_gravity
 };
 
 //! Function to get a string representing a 'named identification' of an acceleration type
@@ -0,0 +1,96 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This program reports the computation time of the spherical harmonic gravitational acceleration at a large number
+ *      of points, evaluated point by point with the Cartesian recursion, and with the batched evaluation on a single
+ *      and on all available threads. The times depend on the machine and compiler settings, and are therefore not
+ *      checked.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+
+int main( )
+{
+    using namespace tudat;
+    using namespace tudat::gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const unsigned int numberOfThreads = std::max( 1u, std::thread::hardware_concurrency( ) );
+
+    std::cout << "Computation time per point of spherical harmonic acceleration (microseconds)" << std::endl;
+    std::cout << std::setw( 8 ) << "Degree" << std::setw( 10 ) << "Points" << std::setw( 16 ) << "Single-point"
+              << std::setw( 16 ) << "Batched" << std::setw( 16 ) << "Batched (" + std::to_string( numberOfThreads ) +
+                 "T)" << std::endl;
+
+    for( int maximumDegree : { 20, 70, 200 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        unit_tests::createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+        std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianCache =
+                std::make_shared< CartesianSphericalHarmonicsCache >( maximumDegree, maximumDegree );
+        BatchedSphericalHarmonicsGravityEvaluator evaluator( referenceRadius, cosineCoefficients, sineCoefficients );
+        BatchedSphericalHarmonicsGravityEvaluator multiThreadEvaluator(
+                    referenceRadius, cosineCoefficients, sineCoefficients, numberOfThreads );
+
+        // Create (pseudo-)random points between 1.05 and 4 reference radii
+        const int numberOfPoints = std::max( 64, 2000000 / ( maximumDegree * maximumDegree ) );
+        CartesianPointBlock positions = CartesianPointBlock::Random( numberOfPoints, 3 );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            positions.row( i ) *=
+                    referenceRadius * ( 2.525 + 1.475 * std::sin( 3.0 * i ) ) / positions.row( i ).norm( );
+        }
+        CartesianPointBlock singlePointAccelerations( numberOfPoints, 3 );
+        CartesianPointBlock batchedAccelerations, multiThreadAccelerations;
+
+        auto startTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            singlePointAccelerations.row( i ) = computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        positions.row( i ).transpose( ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache ).transpose( );
+        }
+        auto singlePointEndTime = std::chrono::steady_clock::now( );
+        evaluator.computeAccelerations( gravitationalParameter, positions, batchedAccelerations );
+        auto batchedEndTime = std::chrono::steady_clock::now( );
+        multiThreadEvaluator.computeAccelerations( gravitationalParameter, positions, multiThreadAccelerations );
+        auto multiThreadEndTime = std::chrono::steady_clock::now( );
+
+        // Print time per point, and the (relative) difference between the accelerations, so that the computations
+        // cannot be optimized away.
+        std::cout << std::setw( 8 ) << maximumDegree << std::setw( 10 ) << numberOfPoints
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         singlePointEndTime - startTime ).count( ) / numberOfPoints
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         batchedEndTime - singlePointEndTime ).count( ) / numberOfPoints
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         multiThreadEndTime - batchedEndTime ).count( ) / numberOfPoints
+                  << "    (difference: " << std::max(
+                         ( batchedAccelerations - singlePointAccelerations ).norm( ),
+                         ( multiThreadAccelerations - singlePointAccelerations ).norm( ) ) /
+                     singlePointAccelerations.norm( ) << ")" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
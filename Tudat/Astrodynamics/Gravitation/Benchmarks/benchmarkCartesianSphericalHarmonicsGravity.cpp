@@ -0,0 +1,96 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This program reports the computation time of the spherical harmonic gravitational acceleration, evaluated in
+ *      spherical coordinates and with the Cartesian (Cunningham) recursion, with and without the gravity gradient. The
+ *      times depend on the machine and compiler settings, and are therefore not checked.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
+
+int main( )
+{
+    using namespace tudat;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    std::cout << "Computation time per evaluation of spherical harmonic acceleration (microseconds)" << std::endl;
+    std::cout << std::setw( 8 ) << "Degree" << std::setw( 16 ) << "Spherical" << std::setw( 16 ) << "Cartesian"
+              << std::setw( 16 ) << "Cart. + grad." << std::endl;
+
+    for( int maximumDegree : { 20, 70, 360 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        unit_tests::createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+        std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache =
+                std::make_shared< basic_mathematics::SphericalHarmonicsCache >( maximumDegree + 1, maximumDegree + 1 );
+        std::shared_ptr< gravitation::CartesianSphericalHarmonicsCache > cartesianCache =
+                std::make_shared< gravitation::CartesianSphericalHarmonicsCache >( maximumDegree, maximumDegree );
+
+        int numberOfEvaluations = std::max( 10, 200000 / ( maximumDegree * maximumDegree ) );
+        Eigen::Vector3d position( 4.0e6, -5.5e6, 2.2e6 );
+        Eigen::Vector3d sphericalCoordinatesAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Vector3d cartesianAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Matrix3d gravityGradient;
+        std::map< std::pair< int, int >, Eigen::Vector3d > dummyMap;
+
+        auto startTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            sphericalCoordinatesAccelerationSum += gravitation::computeGeodesyNormalizedGravitationalAccelerationSum(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, sphericalHarmonicsCache, dummyMap );
+        }
+        auto sphericalCoordinatesEndTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            cartesianAccelerationSum += gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache );
+        }
+        auto cartesianEndTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache, Eigen::Matrix3d::Identity( ),
+                        true, gravityGradient );
+        }
+        auto gradientEndTime = std::chrono::steady_clock::now( );
+
+        // Print time per evaluation, and the (relative) difference between the summed accelerations, so that the
+        // computations cannot be optimized away.
+        std::cout << std::setw( 8 ) << maximumDegree
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         sphericalCoordinatesEndTime - startTime ).count( ) / numberOfEvaluations
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         cartesianEndTime - sphericalCoordinatesEndTime ).count( ) / numberOfEvaluations
+                  << std::setw( 16 ) << std::chrono::duration< double, std::micro >(
+                         gradientEndTime - cartesianEndTime ).count( ) / numberOfEvaluations
+                  << "    (difference: " << ( cartesianAccelerationSum - sphericalCoordinatesAccelerationSum ).norm( ) /
+                     sphericalCoordinatesAccelerationSum.norm( ) << ")" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This program reports the computation time of the gridded and direct spherical harmonic acceleration model along
+ *      an orbit, the time required to compute the grid, and the number of evaluations after which the latter is paid
+ *      back. The times depend on the machine and compiler settings, and are therefore not checked.
+ *
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/griddedSphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+
+int main( )
+{
+    using namespace tudat;
+    using namespace tudat::gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const double minimumRadius = 6678.0E3;
+    const double maximumRadius = 7378.0E3;
+
+    // Create positions along an eccentric, inclined orbit (about 3 km between subsequent positions).
+    const int numberOfPoints = 20000;
+    std::vector< Eigen::Vector3d > positions;
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        const double argumentOfLatitude = 5.0E-4 * i;
+        positions.push_back( ( 7.0E6 + 3.0E5 * std::sin( argumentOfLatitude ) ) * Eigen::Vector3d(
+                                 std::cos( argumentOfLatitude ), 0.6 * std::sin( argumentOfLatitude ),
+                                 0.8 * std::sin( argumentOfLatitude ) ) );
+    }
+
+    std::cout << "Computation time of gridded and direct (Cartesian recursion) spherical harmonic acceleration"
+              << std::endl;
+    std::cout << std::setw( 8 ) << "Degree" << std::setw( 16 ) << "Grid (s)" << std::setw( 16 ) << "Direct (us)"
+              << std::setw( 16 ) << "Gridded (us)" << std::setw( 16 ) << "Payback (evals)" << std::endl;
+
+    for( int maximumDegree : { 50, 70 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        unit_tests::createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+
+        auto startTime = std::chrono::steady_clock::now( );
+        std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid =
+                std::make_shared< SphericalHarmonicsAccelerationGrid >(
+                    gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                    minimumRadius, maximumRadius, 8, 2 * maximumDegree + 1, 4 * maximumDegree, 0 );
+        auto gridEndTime = std::chrono::steady_clock::now( );
+
+        Eigen::Vector3d position;
+        std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel =
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    [ & ]( ){ return position; }, gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients );
+        directAccelerationModel->setEvaluationAlgorithm( cartesian_recursion_evaluation );
+        GriddedSphericalHarmonicsGravitationalAccelerationModel griddedAccelerationModel(
+                    [ & ]( ){ return position; }, [ & ]( ){ return gravitationalParameter; }, accelerationGrid );
+
+        Eigen::Vector3d directAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Vector3d griddedAccelerationSum = Eigen::Vector3d::Zero( );
+
+        auto directStartTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            position = positions.at( i );
+            directAccelerationModel->updateMembers( static_cast< double >( i ) );
+            directAccelerationSum += directAccelerationModel->getAcceleration( );
+        }
+        auto directEndTime = std::chrono::steady_clock::now( );
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            position = positions.at( i );
+            griddedAccelerationModel.updateMembers( static_cast< double >( i ) );
+            griddedAccelerationSum += griddedAccelerationModel.getAcceleration( );
+        }
+        auto griddedEndTime = std::chrono::steady_clock::now( );
+
+        const double directTime = std::chrono::duration< double >(
+                    directEndTime - directStartTime ).count( ) / numberOfPoints;
+        const double griddedTime = std::chrono::duration< double >(
+                    griddedEndTime - directEndTime ).count( ) / numberOfPoints;
+        const double gridComputationTime = std::chrono::duration< double >( gridEndTime - startTime ).count( );
+
+        // Print times, and the mean difference between the accelerations (relative to the maximum interpolation error),
+        // so that the computations cannot be optimized away.
+        std::cout << std::setw( 8 ) << maximumDegree << std::setw( 16 ) << gridComputationTime
+                  << std::setw( 16 ) << 1.0E6 * directTime << std::setw( 16 ) << 1.0E6 * griddedTime
+                  << std::setw( 16 ) << gridComputationTime / ( directTime - griddedTime )
+                  << "    (difference/max. error: " << ( directAccelerationSum - griddedAccelerationSum ).norm( ) /
+                     ( numberOfPoints * accelerationGrid->getMaximumInterpolationError( ) ) << ")" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_SPHERICAL_HARMONICS_TEST_COEFFICIENTS_H
+#define TUDAT_SPHERICAL_HARMONICS_TEST_COEFFICIENTS_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to create (pseudo-)random geodesy-normalized spherical harmonic coefficients for testing.
+/*!
+ * Function to create (pseudo-)random geodesy-normalized spherical harmonic coefficients for testing. The coefficients
+ * of degree n are drawn uniformly from [-1.0E-5/n^2, 1.0E-5/n^2], so that they decay with degree similarly to Kaula's
+ * rule. The degree 1 and S_{n,0} coefficients are zero, C_{0,0} is one and C_{2,0} is set to the Earth's value.
+ * \param maximumDegree Maximum degree (and order) of the coefficients.
+ * \param cosineCoefficients Cosine coefficients (returned by reference).
+ * \param sineCoefficients Sine coefficients (returned by reference).
+ */
+inline void createTestCoefficients( const int maximumDegree, Eigen::MatrixXd& cosineCoefficients,
+                                    Eigen::MatrixXd& sineCoefficients )
+{
+    cosineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    sineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    for( int n = 0; n <= maximumDegree; n++ )
+    {
+        for( int m = 0; m <= maximumDegree; m++ )
+        {
+            double scaling = ( n < 2 || m > n ) ? 0.0 : 1.0E-5 / static_cast< double >( n * n );
+            cosineCoefficients( n, m ) *= scaling;
+            sineCoefficients( n, m ) *= ( m == 0 ) ? 0.0 : scaling;
+        }
+    }
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.841651437908150e-4;
+}
+
+} // namespace unit_tests
+
+} // namespace tudat
+
+#endif // TUDAT_SPHERICAL_HARMONICS_TEST_COEFFICIENTS_H
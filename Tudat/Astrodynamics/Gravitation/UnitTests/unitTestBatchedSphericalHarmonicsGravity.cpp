@@ -0,0 +1,317 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to create (pseudo-)random positions between 1.05 and 4 reference radii (including a point on the z-axis).
+gravitation::CartesianPointBlock createTestPositions( const int numberOfPoints, const double referenceRadius )
+{
+    gravitation::CartesianPointBlock positions = gravitation::CartesianPointBlock::Random( numberOfPoints, 3 );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        double distance = referenceRadius * ( 2.525 + 1.475 * std::sin( 3.0 * i ) );
+        positions.row( i ) *= distance / positions.row( i ).norm( );
+    }
+    positions.row( 0 ) << 0.0, 0.0, -1.3 * referenceRadius;
+    return positions;
+}
+
+BOOST_AUTO_TEST_SUITE( test_batched_spherical_harmonics_gravity )
+
+//! Test whether batched evaluation reproduces acceleration and gravity gradient of single-point Cartesian recursion.
+BOOST_AUTO_TEST_CASE( testBatchedSphericalHarmonicsGravityField )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const int numberOfPoints = 77;
+    const CartesianPointBlock positions = createTestPositions( numberOfPoints, referenceRadius );
+
+    for( int maximumDegree : { 2, 12, 50 } )
+    {
+        for( bool truncateOrder : { false, true } )
+        {
+            Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+            createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+            if( truncateOrder )
+            {
+                cosineCoefficients.conservativeResize( Eigen::NoChange, 2 );
+                sineCoefficients.conservativeResize( Eigen::NoChange, 2 );
+            }
+
+            // Compute expected results point by point
+            std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianCache =
+                    std::make_shared< CartesianSphericalHarmonicsCache >( maximumDegree, maximumDegree );
+            CartesianPointBlock expectedAccelerations( numberOfPoints, 3 );
+            std::vector< Eigen::Matrix3d > expectedGravityGradients( numberOfPoints );
+            for( int i = 0; i < numberOfPoints; i++ )
+            {
+                expectedAccelerations.row( i ) = computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                            positions.row( i ).transpose( ), gravitationalParameter, referenceRadius,
+                            cosineCoefficients, sineCoefficients, cartesianCache, Eigen::Matrix3d::Identity( ),
+                            true, expectedGravityGradients.at( i ) ).transpose( );
+            }
+
+            // Check results for various block sizes and numbers of threads
+            for( int pointsPerBlock : { 1, 8, 32 } )
+            {
+                for( unsigned int numberOfThreads : { 1, 3 } )
+                {
+                    BatchedSphericalHarmonicsGravityEvaluator evaluator(
+                                referenceRadius, cosineCoefficients, sineCoefficients, numberOfThreads, pointsPerBlock );
+                    BOOST_CHECK_EQUAL( evaluator.getMaximumDegree( ), maximumDegree );
+                    BOOST_CHECK_EQUAL( evaluator.getMaximumOrder( ), truncateOrder ? 1 : maximumDegree );
+                    BOOST_CHECK_EQUAL( evaluator.getNumberOfThreads( ), numberOfThreads );
+
+                    CartesianPointBlock accelerations, accelerationsOnly;
+                    Eigen::VectorXd potentials;
+                    GravityGradientBlock gravityGradients;
+                    evaluator.computeGravityField( gravitationalParameter, positions, accelerations,
+                                                   true, potentials, true, gravityGradients );
+                    evaluator.computeAccelerations( gravitationalParameter, positions, accelerationsOnly );
+
+                    for( int i = 0; i < numberOfPoints; i++ )
+                    {
+                        BOOST_CHECK_SMALL( ( accelerations.row( i ) - expectedAccelerations.row( i ) ).norm( ),
+                                           1.0E-14 * expectedAccelerations.row( i ).norm( ) );
+                        BOOST_CHECK_SMALL( ( accelerationsOnly.row( i ) - expectedAccelerations.row( i ) ).norm( ),
+                                           1.0E-14 * expectedAccelerations.row( i ).norm( ) );
+
+                        const Eigen::Matrix3d& expectedGradient = expectedGravityGradients.at( i );
+                        Eigen::Matrix< double, 1, 6 > expectedGradientComponents;
+                        expectedGradientComponents << expectedGradient( 0, 0 ), expectedGradient( 0, 1 ),
+                                expectedGradient( 0, 2 ), expectedGradient( 1, 1 ), expectedGradient( 1, 2 ),
+                                expectedGradient( 2, 2 );
+                        BOOST_CHECK_SMALL( ( gravityGradients.row( i ) - expectedGradientComponents ).norm( ),
+                                           1.0E-14 * expectedGradient.norm( ) );
+                    }
+
+                    // Check potential by comparing its numerical derivative to the acceleration
+                    for( int i = 0; i < numberOfPoints; i += 7 )
+                    {
+                        const double perturbation = 1.0;
+                        CartesianPointBlock perturbedPositions( 6, 3 );
+                        for( int j = 0; j < 3; j++ )
+                        {
+                            perturbedPositions.row( 2 * j ) = positions.row( i );
+                            perturbedPositions.row( 2 * j + 1 ) = positions.row( i );
+                            perturbedPositions( 2 * j, j ) += perturbation;
+                            perturbedPositions( 2 * j + 1, j ) -= perturbation;
+                        }
+
+                        CartesianPointBlock perturbedAccelerations;
+                        Eigen::VectorXd perturbedPotentials;
+                        evaluator.computeGravityField( gravitationalParameter, perturbedPositions, perturbedAccelerations,
+                                                       true, perturbedPotentials, false, gravityGradients );
+
+                        Eigen::Vector3d numericalAcceleration;
+                        for( int j = 0; j < 3; j++ )
+                        {
+                            numericalAcceleration( j ) = ( perturbedPotentials( 2 * j ) - perturbedPotentials( 2 * j + 1 ) ) /
+                                    ( 2.0 * perturbation );
+                        }
+                        BOOST_CHECK_SMALL( ( numericalAcceleration - accelerations.row( i ).transpose( ) ).norm( ),
+                                           1.0E-6 * accelerations.row( i ).norm( ) );
+                    }
+                }
+            }
+        }
+    }
+
+    // Check that potential of point mass is exact.
+    BatchedSphericalHarmonicsGravityEvaluator pointMassEvaluator(
+                referenceRadius, Eigen::MatrixXd::Identity( 1, 1 ), Eigen::MatrixXd::Zero( 1, 1 ) );
+    CartesianPointBlock accelerations;
+    Eigen::VectorXd potentials;
+    GravityGradientBlock gravityGradients;
+    pointMassEvaluator.computeGravityField( gravitationalParameter, positions, accelerations,
+                                            true, potentials, false, gravityGradients );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( potentials( i ), gravitationalParameter / positions.row( i ).norm( ), 1.0E-15 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    accelerations.row( i ),
+                    ( -gravitationalParameter / std::pow( positions.row( i ).norm( ), 3 ) * positions.row( i ) ),
+                    1.0E-15 );
+    }
+
+    // Check that empty block of points is handled, and that inconsistent coefficients are caught.
+    CartesianPointBlock emptyPositions( 0, 3 );
+    pointMassEvaluator.computeAccelerations( gravitationalParameter, emptyPositions, accelerations );
+    BOOST_CHECK_EQUAL( accelerations.rows( ), 0 );
+    BOOST_CHECK_THROW( pointMassEvaluator.resetCoefficients( Eigen::MatrixXd::Zero( 3, 3 ), Eigen::MatrixXd::Zero( 3, 2 ) ),
+                       std::runtime_error );
+}
+
+//! Test batched evaluation of several spherical harmonic acceleration models due to the same gravity field.
+BOOST_AUTO_TEST_CASE( testBatchedSphericalHarmonicsAccelerationModels )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 16, cosineCoefficients, sineCoefficients );
+
+    const int numberOfSpacecraft = 5;
+    std::vector< Eigen::Vector3d > positions;
+    for( int i = 0; i < numberOfSpacecraft; i++ )
+    {
+        positions.push_back( Eigen::Vector3d( 7.0e6 + 1.0e5 * i, -2.0e6 * i, 3.0e6 - 1.0e6 * i ) );
+    }
+    Eigen::Vector3d centralBodyPosition( 1.0e8, 2.0e8, -3.0e7 );
+    Eigen::Quaterniond rotationToInertialFrame = Eigen::Quaterniond(
+                Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitZ( ) ) );
+
+    // Create batched and unbatched acceleration models (with different gravitational parameters for mutual attraction)
+    std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > > batchedModels;
+    std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > > unbatchedModels;
+    for( int i = 0; i < numberOfSpacecraft; i++ )
+    {
+        const double currentGravitationalParameter = gravitationalParameter + 1.0E3 * i;
+        for( int j = 0; j < 2; j++ )
+        {
+            std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > accelerationModel =
+                    std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                        [ &positions, i ]( ){ return positions.at( i ); },
+                        [ = ]( ){ return currentGravitationalParameter; }, referenceRadius,
+                        [ & ]( ){ return cosineCoefficients; },
+                        [ & ]( ){ return sineCoefficients; },
+                        [ & ]( ){ return centralBodyPosition; }, [ & ]( ){ return rotationToInertialFrame; } );
+            accelerationModel->setEvaluationAlgorithm( cartesian_recursion_evaluation );
+            accelerationModel->setComputeGravityGradient( true );
+            ( j == 0 ? batchedModels : unbatchedModels ).push_back( accelerationModel );
+        }
+    }
+
+    std::shared_ptr< BatchedSphericalHarmonicsGravityCache > batchedGravityCache =
+            createBatchedSphericalHarmonicsGravityCache( batchedModels, 2 );
+    BOOST_CHECK_EQUAL( batchedGravityCache->getNumberOfEvaluationPoints( ), numberOfSpacecraft );
+    BOOST_CHECK_EQUAL( batchedGravityCache->getEvaluator( )->getNumberOfThreads( ), 2 );
+    for( int i = 0; i < numberOfSpacecraft; i++ )
+    {
+        BOOST_CHECK_EQUAL( batchedModels.at( i )->getBatchedGravityCache( ), batchedGravityCache );
+    }
+
+    for( int k = 0; k < 4; k++ )
+    {
+        // Update environment, and change coefficients for last update
+        for( int i = 0; i < numberOfSpacecraft; i++ )
+        {
+            positions.at( i ) += Eigen::Vector3d( 1.0e4 * i, 2.0e4, -3.0e4 );
+        }
+        rotationToInertialFrame = rotationToInertialFrame * Eigen::AngleAxisd( 0.1, Eigen::Vector3d::UnitZ( ) );
+        if( k == 3 )
+        {
+            cosineCoefficients( 2, 0 ) *= 1.1;
+        }
+
+        for( int i = 0; i < numberOfSpacecraft; i++ )
+        {
+            batchedModels.at( i )->updateMembers( static_cast< double >( k ) );
+            unbatchedModels.at( i )->updateMembers( static_cast< double >( k ) );
+
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( unbatchedModels.at( i )->getAcceleration( ),
+                                               batchedModels.at( i )->getAcceleration( ), 1.0E-14 );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( unbatchedModels.at( i )->getAccelerationInBodyFixedFrame( ),
+                                               batchedModels.at( i )->getAccelerationInBodyFixedFrame( ), 1.0E-14 );
+            BOOST_CHECK_SMALL( ( unbatchedModels.at( i )->getCurrentGravityGradient( ) -
+                                 batchedModels.at( i )->getCurrentGravityGradient( ) ).norm( ),
+                               1.0E-14 * unbatchedModels.at( i )->getCurrentGravityGradient( ).norm( ) );
+        }
+    }
+
+    // Check that resetting the time of a single model forces a new evaluation of all points
+    positions.at( 1 ) *= 1.01;
+    batchedModels.at( 0 )->resetTime( );
+    batchedModels.at( 1 )->resetTime( );
+    batchedModels.at( 1 )->updateMembers( 3.0 );
+    unbatchedModels.at( 1 )->resetTime( );
+    unbatchedModels.at( 1 )->updateMembers( 3.0 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( unbatchedModels.at( 1 )->getAcceleration( ),
+                                       batchedModels.at( 1 )->getAcceleration( ), 1.0E-14 );
+
+    // Check that models for different gravity fields cannot be combined
+    std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > > inconsistentModels;
+    inconsistentModels.push_back( unbatchedModels.at( 0 ) );
+    inconsistentModels.push_back(
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    [ & ]( ){ return positions.at( 0 ); }, gravitationalParameter, referenceRadius,
+                    cosineCoefficients.block( 0, 0, 5, 5 ), sineCoefficients.block( 0, 0, 5, 5 ) ) );
+    BOOST_CHECK_THROW( createBatchedSphericalHarmonicsGravityCache( inconsistentModels ), std::runtime_error );
+}
+
+//! Test whether batched evaluation reproduces single-point evaluation for a large number of points, up to high degree.
+/*!
+ *  Test whether batched evaluation reproduces single-point evaluation for a large number of points, up to high degree.
+ *  The computation times of these evaluations are reported by benchmark_BatchedSphericalHarmonicsGravity.
+ */
+BOOST_AUTO_TEST_CASE( testBatchedSphericalHarmonicsManyPoints )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    for( int maximumDegree : { 20, 70, 200 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+        std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianCache =
+                std::make_shared< CartesianSphericalHarmonicsCache >( maximumDegree, maximumDegree );
+        BatchedSphericalHarmonicsGravityEvaluator evaluator( referenceRadius, cosineCoefficients, sineCoefficients );
+
+        const int numberOfPoints = std::max( 64, 2000000 / ( maximumDegree * maximumDegree ) );
+        const CartesianPointBlock positions = createTestPositions( numberOfPoints, referenceRadius );
+        CartesianPointBlock singlePointAccelerations( numberOfPoints, 3 );
+        CartesianPointBlock batchedAccelerations;
+
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            singlePointAccelerations.row( i ) = computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        positions.row( i ).transpose( ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache ).transpose( );
+        }
+        evaluator.computeAccelerations( gravitationalParameter, positions, batchedAccelerations );
+
+        BOOST_CHECK_SMALL( ( singlePointAccelerations - batchedAccelerations ).norm( ),
+                           1.0E-13 * singlePointAccelerations.norm( ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,314 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to compute the acceleration using the existing evaluation in spherical coordinates.
+Eigen::Vector3d computeSphericalCoordinatesAcceleration(
+        const Eigen::Vector3d& position, const double gravitationalParameter, const double referenceRadius,
+        const Eigen::MatrixXd& cosineCoefficients, const Eigen::MatrixXd& sineCoefficients )
+{
+    static std::map< int, std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > > sphericalHarmonicsCaches;
+    int maximumDegree = cosineCoefficients.rows( ) - 1;
+    if( sphericalHarmonicsCaches.count( maximumDegree ) == 0 )
+    {
+        sphericalHarmonicsCaches[ maximumDegree ] = std::make_shared< basic_mathematics::SphericalHarmonicsCache >(
+                    maximumDegree + 1, maximumDegree + 1 );
+    }
+
+    std::map< std::pair< int, int >, Eigen::Vector3d > dummyMap;
+    return gravitation::computeGeodesyNormalizedGravitationalAccelerationSum(
+                position, gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                sphericalHarmonicsCaches.at( maximumDegree ), dummyMap );
+}
+
+BOOST_AUTO_TEST_SUITE( test_cartesian_spherical_harmonics_gravity )
+
+//! Test whether Cartesian recursion reproduces acceleration computed in spherical coordinates.
+BOOST_AUTO_TEST_CASE( testCartesianSphericalHarmonicsAcceleration )
+{
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    std::vector< Eigen::Vector3d > testPositions;
+    testPositions.push_back( Eigen::Vector3d( 7.0e6, 8.0e6, 9.0e6 ) );
+    testPositions.push_back( Eigen::Vector3d( 4.0e6, -5.5e6, 2.2e6 ) );
+    testPositions.push_back( Eigen::Vector3d( -6.6e6, 0.1e6, -1.3e6 ) );
+    testPositions.push_back( Eigen::Vector3d( 0.0, -2.0e7, 3.0e4 ) );
+    testPositions.push_back( Eigen::Vector3d( -3.0e6, -3.0e6, -5.7e6 ) );
+
+    for( int maximumDegree : { 2, 5, 20, 50 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+
+        // Create cache for lower degree, to check whether it is resized as needed
+        std::shared_ptr< gravitation::CartesianSphericalHarmonicsCache > cartesianCache =
+                std::make_shared< gravitation::CartesianSphericalHarmonicsCache >( 2, 2 );
+
+        for( unsigned int i = 0; i < testPositions.size( ); i++ )
+        {
+            Eigen::Vector3d expectedAcceleration = computeSphericalCoordinatesAcceleration(
+                        testPositions.at( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients );
+            Eigen::Vector3d computedAcceleration =
+                    gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        testPositions.at( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache );
+
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, computedAcceleration, 1.0E-13 );
+            BOOST_CHECK_EQUAL( cartesianCache->getMaximumDegree( ), std::max( 2, maximumDegree ) );
+        }
+
+        // Check non-square coefficient block (maximum order lower than maximum degree)
+        if( maximumDegree > 5 )
+        {
+            Eigen::MatrixXd cosineBlock = cosineCoefficients.block( 0, 0, maximumDegree + 1, 5 );
+            Eigen::MatrixXd sineBlock = sineCoefficients.block( 0, 0, maximumDegree + 1, 5 );
+            Eigen::MatrixXd paddedCosineBlock = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+            Eigen::MatrixXd paddedSineBlock = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+            paddedCosineBlock.leftCols( 5 ) = cosineBlock;
+            paddedSineBlock.leftCols( 5 ) = sineBlock;
+
+            Eigen::Vector3d expectedAcceleration = computeSphericalCoordinatesAcceleration(
+                        testPositions.at( 0 ), gravitationalParameter, referenceRadius,
+                        paddedCosineBlock, paddedSineBlock );
+            Eigen::Vector3d computedAcceleration =
+                    gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        testPositions.at( 0 ), gravitationalParameter, referenceRadius,
+                        cosineBlock, sineBlock, cartesianCache );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, computedAcceleration, 1.0E-13 );
+        }
+    }
+
+    // Check that acceleration is well-defined on the rotation axis (where the spherical formulation is singular)
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 20, cosineCoefficients, sineCoefficients );
+    std::shared_ptr< gravitation::CartesianSphericalHarmonicsCache > cartesianCache =
+            std::make_shared< gravitation::CartesianSphericalHarmonicsCache >( 20, 20 );
+    Eigen::Vector3d polarAcceleration = gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                Eigen::Vector3d( 0.0, 0.0, 7.0e6 ), gravitationalParameter, referenceRadius,
+                cosineCoefficients, sineCoefficients, cartesianCache );
+    Eigen::Vector3d nearPolarAcceleration = gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                Eigen::Vector3d( 1.0E-3, 2.0E-3, 7.0e6 ), gravitationalParameter, referenceRadius,
+                cosineCoefficients, sineCoefficients, cartesianCache );
+    for( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_EQUAL( std::isnan( polarAcceleration( i ) ), false );
+    }
+    // Difference should be consistent with gravity gradient (order 1E-6 s^-2) times offset (order 1E-3 m)
+    BOOST_CHECK_SMALL( ( polarAcceleration - nearPolarAcceleration ).norm( ), 1.0E-8 );
+}
+
+//! Test gravity gradient computed with Cartesian recursion against numerical derivative of acceleration.
+BOOST_AUTO_TEST_CASE( testCartesianSphericalHarmonicsGravityGradient )
+{
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 30, cosineCoefficients, sineCoefficients );
+    std::shared_ptr< gravitation::CartesianSphericalHarmonicsCache > cartesianCache =
+            std::make_shared< gravitation::CartesianSphericalHarmonicsCache >( 30, 30 );
+
+    // Define rotation from body-fixed to inertial frame
+    Eigen::Matrix3d rotationToInertialFrame =
+            ( Eigen::AngleAxisd( 0.3, Eigen::Vector3d::UnitZ( ) ) *
+              Eigen::AngleAxisd( -0.2, Eigen::Vector3d::UnitX( ) ) ).toRotationMatrix( );
+
+    for( Eigen::Vector3d position : { Eigen::Vector3d( 4.0e6, -5.5e6, 2.2e6 ),
+                                      Eigen::Vector3d( -1.0e6, 2.0e3, -7.0e6 ),
+                                      Eigen::Vector3d( 0.0, 0.0, 7.0e6 ) } )
+    {
+        Eigen::Matrix3d gravityGradient;
+        Eigen::Vector3d acceleration = gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                    cartesianCache, rotationToInertialFrame, true, gravityGradient );
+
+        // Check that acceleration is not modified by computing gravity gradient
+        Eigen::Vector3d accelerationWithoutGradient =
+                gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                    cartesianCache, rotationToInertialFrame );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( acceleration, accelerationWithoutGradient, 1.0E-15 );
+
+        // Compute gravity gradient by central differences, w.r.t. inertial position
+        Eigen::Matrix3d numericalGravityGradient;
+        double positionPerturbation = 10.0;
+        for( int i = 0; i < 3; i++ )
+        {
+            Eigen::Vector3d perturbation = positionPerturbation * rotationToInertialFrame.transpose( ).col( i );
+            numericalGravityGradient.col( i ) =
+                    ( gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                          position + perturbation, gravitationalParameter, referenceRadius,
+                          cosineCoefficients, sineCoefficients, cartesianCache, rotationToInertialFrame ) -
+                      gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                          position - perturbation, gravitationalParameter, referenceRadius,
+                          cosineCoefficients, sineCoefficients, cartesianCache, rotationToInertialFrame ) ) /
+                    ( 2.0 * positionPerturbation );
+        }
+
+        double gradientMagnitude = gravityGradient.cwiseAbs( ).maxCoeff( );
+        for( int i = 0; i < 3; i++ )
+        {
+            for( int j = 0; j < 3; j++ )
+            {
+                BOOST_CHECK_SMALL( gravityGradient( i, j ) - numericalGravityGradient( i, j ),
+                                   1.0E-7 * gradientMagnitude );
+            }
+        }
+
+        // Check symmetry and trace (Laplace equation)
+        BOOST_CHECK_SMALL( ( gravityGradient - gravityGradient.transpose( ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-15 * gradientMagnitude );
+        BOOST_CHECK_SMALL( gravityGradient.trace( ), 1.0E-12 * gradientMagnitude );
+    }
+}
+
+//! Test selection of Cartesian recursion in acceleration model.
+BOOST_AUTO_TEST_CASE( testCartesianSphericalHarmonicsAccelerationModel )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 12, cosineCoefficients, sineCoefficients );
+
+    Eigen::Vector3d position( 7.0e6, 8.0e6, 9.0e6 );
+    Eigen::Quaterniond rotationToInertialFrame = Eigen::Quaterniond(
+                Eigen::AngleAxisd( 1.2, Eigen::Vector3d::UnitZ( ) ) );
+
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > sphericalCoordinatesModel =
+            std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                [ & ]( ){ return position; }, [ = ]( ){ return gravitationalParameter; }, referenceRadius,
+                [ = ]( ){ return cosineCoefficients; }, [ = ]( ){ return sineCoefficients; },
+                [ ]( ){ return Eigen::Vector3d::Zero( ); }, [ & ]( ){ return rotationToInertialFrame; } );
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > cartesianModel =
+            std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                [ & ]( ){ return position; }, [ = ]( ){ return gravitationalParameter; }, referenceRadius,
+                [ = ]( ){ return cosineCoefficients; }, [ = ]( ){ return sineCoefficients; },
+                [ ]( ){ return Eigen::Vector3d::Zero( ); }, [ & ]( ){ return rotationToInertialFrame; } );
+
+    // Gravity gradient can only be computed with Cartesian recursion
+    BOOST_CHECK_EQUAL( cartesianModel->getEvaluationAlgorithm( ), spherical_coordinates_evaluation );
+    BOOST_CHECK_THROW( cartesianModel->setComputeGravityGradient( true ), std::runtime_error );
+    cartesianModel->setEvaluationAlgorithm( cartesian_recursion_evaluation );
+    BOOST_CHECK_THROW( cartesianModel->getCurrentGravityGradient( ), std::runtime_error );
+    cartesianModel->setComputeGravityGradient( true );
+    BOOST_CHECK_EQUAL( cartesianModel->getEvaluationAlgorithm( ), cartesian_recursion_evaluation );
+
+    for( int i = 0; i < 3; i++ )
+    {
+        position += Eigen::Vector3d( 1.0e5, -2.0e5, 3.0e5 );
+        sphericalCoordinatesModel->updateMembers( static_cast< double >( i ) );
+        cartesianModel->updateMembers( static_cast< double >( i ) );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( sphericalCoordinatesModel->getAcceleration( ),
+                                           cartesianModel->getAcceleration( ), 1.0E-13 );
+
+        // Check gravity gradient against directly computed gravity gradient
+        Eigen::Matrix3d expectedGravityGradient;
+        computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                    rotationToInertialFrame.inverse( ) * position, gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients,
+                    std::make_shared< CartesianSphericalHarmonicsCache >( 12, 12 ),
+                    rotationToInertialFrame.toRotationMatrix( ), true, expectedGravityGradient );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedGravityGradient, cartesianModel->getCurrentGravityGradient( ),
+                                           1.0E-14 );
+
+        // Check acceleration with alternative coefficients
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    sphericalCoordinatesModel->getAccelerationWithAlternativeCoefficients(
+                        2.0 * cosineCoefficients, sineCoefficients ),
+                    cartesianModel->getAccelerationWithAlternativeCoefficients(
+                        2.0 * cosineCoefficients, sineCoefficients ), 1.0E-13 );
+    }
+
+    // Check that gravity gradient computation must be switched off before reverting to spherical coordinates
+    BOOST_CHECK_THROW( cartesianModel->setEvaluationAlgorithm( spherical_coordinates_evaluation ),
+                       std::runtime_error );
+    cartesianModel->setComputeGravityGradient( false );
+    cartesianModel->setEvaluationAlgorithm( spherical_coordinates_evaluation );
+}
+
+//! Test whether Cartesian recursion reproduces acceleration computed in spherical coordinates up to high degree.
+/*!
+ *  Test whether Cartesian recursion reproduces acceleration computed in spherical coordinates, summed over a range of
+ *  positions, up to high degree, and whether the acceleration is unaffected by the computation of the gravity gradient.
+ *  The computation times of these evaluations are reported by benchmark_CartesianSphericalHarmonicsGravity.
+ */
+BOOST_AUTO_TEST_CASE( testCartesianSphericalHarmonicsHighDegreeAcceleration )
+{
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+
+    for( int maximumDegree : { 20, 70, 360 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+        std::shared_ptr< gravitation::CartesianSphericalHarmonicsCache > cartesianCache =
+                std::make_shared< gravitation::CartesianSphericalHarmonicsCache >( maximumDegree, maximumDegree );
+
+        int numberOfEvaluations = std::max( 10, 200000 / ( maximumDegree * maximumDegree ) );
+        Eigen::Vector3d position( 4.0e6, -5.5e6, 2.2e6 );
+        Eigen::Vector3d sphericalCoordinatesAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Vector3d cartesianAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Vector3d gradientAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Matrix3d gravityGradient;
+
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            sphericalCoordinatesAccelerationSum += computeSphericalCoordinatesAcceleration(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients );
+            cartesianAccelerationSum += gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache );
+            gradientAccelerationSum += gravitation::computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        position + Eigen::Vector3d::Constant( i ), gravitationalParameter, referenceRadius,
+                        cosineCoefficients, sineCoefficients, cartesianCache, Eigen::Matrix3d::Identity( ),
+                        true, gravityGradient );
+        }
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( sphericalCoordinatesAccelerationSum, cartesianAccelerationSum, 1.0E-12 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( cartesianAccelerationSum, gradientAccelerationSum, 1.0E-14 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,342 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/griddedSphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to create (pseudo-)random positions with a distance between two given values.
+std::vector< Eigen::Vector3d > createGriddedTestPositions( const int numberOfPoints, const double minimumDistance,
+                                                           const double maximumDistance )
+{
+    std::vector< Eigen::Vector3d > positions;
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        Eigen::Vector3d position = Eigen::Vector3d::Random( );
+        const double distance = minimumDistance + ( maximumDistance - minimumDistance ) *
+                0.5 * ( 1.0 + std::sin( 3.0 * i ) );
+        positions.push_back( position * distance / position.norm( ) );
+    }
+    return positions;
+}
+
+BOOST_AUTO_TEST_SUITE( test_gridded_spherical_harmonics_gravity )
+
+const double gravitationalParameter = 3.986004418e14;
+const double referenceRadius = 6378137.0;
+const double minimumRadius = 6678.0E3;
+const double maximumRadius = 7378.0E3;
+
+//! Test interpolation of grid against direct evaluation, and consistency with reported interpolation error.
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsAccelerationGridInterpolation )
+{
+    using namespace gravitation;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 50, cosineCoefficients, sineCoefficients );
+
+    SphericalHarmonicsAccelerationGrid accelerationGrid(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                minimumRadius, maximumRadius, 12, 181, 360, 0 );
+    BOOST_CHECK_EQUAL( accelerationGrid.getMaximumDegree( ), 50 );
+    BOOST_CHECK_EQUAL( accelerationGrid.getMaximumOrder( ), 50 );
+    BOOST_CHECK_EQUAL( accelerationGrid.getMaximumInterpolationError( ),
+                       gravitationalParameter * accelerationGrid.getMaximumInterpolationErrorPerUnitGravitationalParameter( ) );
+
+    // Compute non-central accelerations directly.
+    const int numberOfPoints = 10000;
+    std::vector< Eigen::Vector3d > positions = createGriddedTestPositions( numberOfPoints, minimumRadius, maximumRadius );
+    positions.push_back( Eigen::Vector3d( 0.0, 0.0, -minimumRadius ) );
+    positions.push_back( Eigen::Vector3d( 0.0, 0.0, maximumRadius ) );
+    positions.push_back( Eigen::Vector3d( 7.0E6, -1.0E-3, 1.0E6 ) );
+    positions.push_back( Eigen::Vector3d( 7.0E6, 1.0E-3, 1.0E6 ) );
+
+    Eigen::MatrixXd nonCentralCosineCoefficients = cosineCoefficients;
+    nonCentralCosineCoefficients( 0, 0 ) = 0.0;
+    BatchedSphericalHarmonicsGravityEvaluator gravityEvaluator(
+                referenceRadius, nonCentralCosineCoefficients, sineCoefficients );
+    CartesianPointBlock positionBlock( positions.size( ), 3 );
+    for( unsigned int i = 0; i < positions.size( ); i++ )
+    {
+        positionBlock.row( i ) = positions.at( i ).transpose( );
+    }
+    CartesianPointBlock directAccelerations;
+    gravityEvaluator.computeAccelerations( gravitationalParameter, positionBlock, directAccelerations );
+
+    // Check that the interpolation error does not (significantly) exceed the reported error, which should be small
+    // compared to the non-central acceleration.
+    double maximumError = 0.0;
+    double maximumNonCentralAcceleration = 0.0;
+    for( unsigned int i = 0; i < positions.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( accelerationGrid.isPositionInGrid( positions.at( i ) ), true );
+        Eigen::Vector3d interpolatedAcceleration =
+                gravitationalParameter * accelerationGrid.interpolateNonCentralAcceleration( positions.at( i ) );
+        maximumError = std::max(
+                    maximumError, ( interpolatedAcceleration - directAccelerations.row( i ).transpose( ) ).norm( ) );
+        maximumNonCentralAcceleration = std::max( maximumNonCentralAcceleration, directAccelerations.row( i ).norm( ) );
+    }
+    BOOST_CHECK_SMALL( maximumError, 1.5 * accelerationGrid.getMaximumInterpolationError( ) );
+    BOOST_CHECK_SMALL( accelerationGrid.getMaximumInterpolationError( ), 1.0E-4 * maximumNonCentralAcceleration );
+
+    // Check that interpolation at the grid nodes reproduces the directly evaluated acceleration.
+    const double latitudeStep = mathematical_constants::PI / 180.0;
+    const double longitudeStep = 2.0 * mathematical_constants::PI / 360.0;
+    const double radiusStep = ( maximumRadius - minimumRadius ) / 11.0;
+    CartesianPointBlock nodePositions( 4, 3 );
+    nodePositions.row( 0 ) << 0.0, 0.0, minimumRadius + 3.0 * radiusStep;
+    nodePositions.row( 1 ) << maximumRadius, 0.0, 0.0;
+    nodePositions.row( 2 ) = minimumRadius * Eigen::Vector3d(
+                std::cos( 37.0 * latitudeStep ) * std::cos( 359.0 * longitudeStep ),
+                std::cos( 37.0 * latitudeStep ) * std::sin( 359.0 * longitudeStep ),
+                std::sin( 37.0 * latitudeStep ) ).transpose( );
+    nodePositions.row( 3 ) = ( minimumRadius + 5.0 * radiusStep ) * Eigen::Vector3d(
+                std::cos( -61.0 * latitudeStep ) * std::cos( 123.0 * longitudeStep ),
+                std::cos( -61.0 * latitudeStep ) * std::sin( 123.0 * longitudeStep ),
+                std::sin( -61.0 * latitudeStep ) ).transpose( );
+    CartesianPointBlock nodeAccelerations;
+    gravityEvaluator.computeAccelerations( 1.0, nodePositions, nodeAccelerations );
+    for( int i = 0; i < 4; i++ )
+    {
+        BOOST_CHECK_SMALL( ( accelerationGrid.interpolateNonCentralAcceleration( nodePositions.row( i ).transpose( ) ) -
+                             nodeAccelerations.row( i ).transpose( ) ).norm( ),
+                           1.0E-10 * nodeAccelerations.row( i ).norm( ) );
+    }
+
+    // Check positions outside of grid.
+    BOOST_CHECK_EQUAL( accelerationGrid.isPositionInGrid( Eigen::Vector3d( 0.0, 0.99 * minimumRadius, 0.0 ) ), false );
+    BOOST_CHECK_EQUAL( accelerationGrid.isPositionInGrid( Eigen::Vector3d( 0.0, 0.0, 1.01 * maximumRadius ) ), false );
+    BOOST_CHECK_THROW( accelerationGrid.interpolateNonCentralAcceleration( Eigen::Vector3d( 0.0, 0.0, 1.0E7 ) ),
+                       std::runtime_error );
+
+    // Check inconsistent grid settings.
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid(
+                           gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                           minimumRadius, maximumRadius, 3, 181, 360 ), std::runtime_error );
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid(
+                           gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                           maximumRadius, minimumRadius, 12, 181, 360 ), std::runtime_error );
+}
+
+//! Test gridded acceleration model against spherical harmonic acceleration model.
+BOOST_AUTO_TEST_CASE( testGriddedSphericalHarmonicsAccelerationModel )
+{
+    using namespace gravitation;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 30, cosineCoefficients, sineCoefficients );
+    std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid =
+            std::make_shared< SphericalHarmonicsAccelerationGrid >(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                minimumRadius, maximumRadius, 12, 121, 240, 2 );
+
+    Eigen::Vector3d position( 7.0E6, 0.0, 0.0 );
+    Eigen::Vector3d centralBodyPosition( 1.0E8, 2.0E8, -3.0E7 );
+    Eigen::Quaterniond rotationToInertialFrame = Eigen::Quaterniond(
+                Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitZ( ) ) * Eigen::AngleAxisd( 0.2, Eigen::Vector3d::UnitX( ) ) );
+
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel =
+            std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                [ & ]( ){ return position; }, [ ]( ){ return gravitationalParameter; }, referenceRadius,
+                [ & ]( ){ return cosineCoefficients; }, [ & ]( ){ return sineCoefficients; },
+                [ & ]( ){ return centralBodyPosition; }, [ & ]( ){ return rotationToInertialFrame; } );
+    directAccelerationModel->setEvaluationAlgorithm( cartesian_recursion_evaluation );
+
+    GriddedSphericalHarmonicsGravitationalAccelerationModel griddedAccelerationModel(
+                [ & ]( ){ return position; }, [ ]( ){ return gravitationalParameter; }, accelerationGrid,
+                [ & ]( ){ return centralBodyPosition; }, [ & ]( ){ return rotationToInertialFrame; }, false,
+                directAccelerationModel );
+    GriddedSphericalHarmonicsGravitationalAccelerationModel griddedOnlyAccelerationModel(
+                [ & ]( ){ return position; }, [ ]( ){ return gravitationalParameter; }, accelerationGrid,
+                [ & ]( ){ return centralBodyPosition; }, [ & ]( ){ return rotationToInertialFrame; } );
+
+    // Compare accelerations inside grid.
+    std::vector< Eigen::Vector3d > relativePositions = createGriddedTestPositions( 100, minimumRadius, maximumRadius );
+    for( unsigned int i = 0; i < relativePositions.size( ); i++ )
+    {
+        position = centralBodyPosition + relativePositions.at( i );
+        directAccelerationModel->updateMembers( static_cast< double >( i ) );
+        griddedAccelerationModel.updateMembers( static_cast< double >( i ) );
+        griddedOnlyAccelerationModel.updateMembers( static_cast< double >( i ) );
+
+        BOOST_CHECK_SMALL( ( griddedAccelerationModel.getAcceleration( ) -
+                             directAccelerationModel->getAcceleration( ) ).norm( ),
+                           1.5 * accelerationGrid->getMaximumInterpolationError( ) );
+        BOOST_CHECK_EQUAL( griddedAccelerationModel.getAcceleration( ), griddedOnlyAccelerationModel.getAcceleration( ) );
+        BOOST_CHECK_SMALL( ( griddedAccelerationModel.getCurrentBodyFixedRelativePosition( ) -
+                             rotationToInertialFrame.inverse( ) * relativePositions.at( i ) ).norm( ), 1.0E-6 );
+    }
+    BOOST_CHECK_EQUAL( griddedAccelerationModel.getNumberOfDirectEvaluations( ), 0 );
+
+    // Check that acceleration is not recomputed at the same time.
+    position = centralBodyPosition + Eigen::Vector3d( 0.0, 7.1E6, 0.0 );
+    Eigen::Vector3d previousAcceleration = griddedAccelerationModel.getAcceleration( );
+    griddedAccelerationModel.updateMembers( 99.0 );
+    BOOST_CHECK_EQUAL( griddedAccelerationModel.getAcceleration( ), previousAcceleration );
+    griddedAccelerationModel.resetTime( );
+    griddedAccelerationModel.updateMembers( 99.0 );
+    BOOST_CHECK_EQUAL( ( griddedAccelerationModel.getAcceleration( ) - previousAcceleration ).norm( ) > 1.0, true );
+
+    // Check that direct acceleration model is used outside of grid, and that an exception is thrown if none is set.
+    position = centralBodyPosition + Eigen::Vector3d( 0.0, 4.0E7, 1.0E6 );
+    directAccelerationModel->updateMembers( 200.0 );
+    griddedAccelerationModel.updateMembers( 200.0 );
+    BOOST_CHECK_EQUAL( griddedAccelerationModel.getAcceleration( ), directAccelerationModel->getAcceleration( ) );
+    BOOST_CHECK_EQUAL( griddedAccelerationModel.getNumberOfDirectEvaluations( ), 1 );
+    BOOST_CHECK_THROW( griddedOnlyAccelerationModel.updateMembers( 200.0 ), std::runtime_error );
+}
+
+//! Test writing and loading of acceleration grid files.
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsAccelerationGridFile )
+{
+    using namespace gravitation;
+
+    const std::string fileName = ( boost::filesystem::temp_directory_path( ) /
+                                   boost::filesystem::unique_path( "testAccelerationGrid-%%%%-%%%%.bin" ) ).string( );
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 20, cosineCoefficients, sineCoefficients );
+    SphericalHarmonicsAccelerationGrid accelerationGrid(
+                gravitationalParameter, referenceRadius, cosineCoefficients.block( 0, 0, 21, 15 ),
+                sineCoefficients.block( 0, 0, 21, 15 ), minimumRadius, maximumRadius, 6, 61, 120 );
+    accelerationGrid.writeToFile( fileName );
+    BOOST_CHECK_EQUAL( boost::filesystem::file_size( fileName ), 128 + 3 * 8 * 6 * 61 * 120 );
+
+    {
+        SphericalHarmonicsAccelerationGrid loadedAccelerationGrid( fileName );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getMaximumDegree( ), 20 );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getMaximumOrder( ), 14 );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getNumberOfRadii( ), 6 );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getNumberOfLatitudes( ), 61 );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getNumberOfLongitudes( ), 120 );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getMinimumRadius( ), minimumRadius );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getMaximumRadius( ), maximumRadius );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getReferenceRadius( ), referenceRadius );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getGravitationalParameter( ), gravitationalParameter );
+        BOOST_CHECK_EQUAL( loadedAccelerationGrid.getMaximumInterpolationError( ),
+                           accelerationGrid.getMaximumInterpolationError( ) );
+
+        // Check that loaded grid is interpolated identically.
+        std::vector< Eigen::Vector3d > positions = createGriddedTestPositions( 100, minimumRadius, maximumRadius );
+        for( unsigned int i = 0; i < positions.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( loadedAccelerationGrid.interpolateNonCentralAcceleration( positions.at( i ) ),
+                               accelerationGrid.interpolateNonCentralAcceleration( positions.at( i ) ) );
+        }
+
+        // Check that the mapped file cannot be overwritten by the loaded grid.
+        BOOST_CHECK_THROW( loadedAccelerationGrid.writeToFile( fileName ), std::runtime_error );
+    }
+
+    // Check that truncated files, files of unknown version and other files are rejected.
+    boost::filesystem::resize_file( fileName, boost::filesystem::file_size( fileName ) - 8 );
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid loadedAccelerationGrid( fileName ), std::runtime_error );
+
+    accelerationGrid.writeToFile( fileName );
+    {
+        std::fstream fileStream( fileName.c_str( ), std::ios::in | std::ios::out | std::ios::binary );
+        fileStream.seekp( 8 );
+        fileStream.put( 2 );
+    }
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid loadedAccelerationGrid( fileName ), std::runtime_error );
+
+    {
+        std::ofstream fileStream( fileName.c_str( ) );
+        fileStream << "0.3986004418E15  6378137.0" << std::endl;
+    }
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid loadedAccelerationGrid( fileName ), std::runtime_error );
+
+    boost::filesystem::remove( fileName );
+    BOOST_CHECK_THROW( SphericalHarmonicsAccelerationGrid loadedAccelerationGrid( fileName ), std::runtime_error );
+}
+
+//! Test whether gridded acceleration model reproduces direct acceleration model along an orbit.
+/*!
+ *  Test whether gridded acceleration model reproduces direct acceleration model along an orbit, to within the reported
+ *  interpolation error. The computation times of these models are reported by
+ *  benchmark_GriddedSphericalHarmonicsGravity.
+ */
+BOOST_AUTO_TEST_CASE( testGriddedSphericalHarmonicsAccelerationAlongOrbit )
+{
+    using namespace gravitation;
+
+    for( int maximumDegree : { 50, 70 } )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        createTestCoefficients( maximumDegree, cosineCoefficients, sineCoefficients );
+
+        std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid =
+                std::make_shared< SphericalHarmonicsAccelerationGrid >(
+                    gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                    minimumRadius, maximumRadius, 8, 2 * maximumDegree + 1, 4 * maximumDegree, 0 );
+
+        Eigen::Vector3d position;
+        std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel =
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    [ & ]( ){ return position; }, gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients );
+        directAccelerationModel->setEvaluationAlgorithm( cartesian_recursion_evaluation );
+        GriddedSphericalHarmonicsGravitationalAccelerationModel griddedAccelerationModel(
+                    [ & ]( ){ return position; }, [ ]( ){ return gravitationalParameter; }, accelerationGrid );
+
+        // Create positions along an eccentric, inclined orbit (about 3 km between subsequent positions).
+        const int numberOfPoints = 20000;
+        std::vector< Eigen::Vector3d > positions;
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            const double argumentOfLatitude = 5.0E-4 * i;
+            positions.push_back( ( 7.0E6 + 3.0E5 * std::sin( argumentOfLatitude ) ) * Eigen::Vector3d(
+                                     std::cos( argumentOfLatitude ), 0.6 * std::sin( argumentOfLatitude ),
+                                     0.8 * std::sin( argumentOfLatitude ) ) );
+        }
+        Eigen::Vector3d directAccelerationSum = Eigen::Vector3d::Zero( );
+        Eigen::Vector3d griddedAccelerationSum = Eigen::Vector3d::Zero( );
+
+        for( int i = 0; i < numberOfPoints; i++ )
+        {
+            position = positions.at( i );
+            directAccelerationModel->updateMembers( static_cast< double >( i ) );
+            directAccelerationSum += directAccelerationModel->getAcceleration( );
+            griddedAccelerationModel.updateMembers( static_cast< double >( i ) );
+            griddedAccelerationSum += griddedAccelerationModel.getAcceleration( );
+        }
+
+        BOOST_CHECK_SMALL( ( directAccelerationSum - griddedAccelerationSum ).norm( ),
+                           numberOfPoints * accelerationGrid->getMaximumInterpolationError( ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,496 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      The weights of the solid harmonics follow from the derivative relations listed in
+ *      cartesianSphericalHarmonicsGravity.cpp: the acceleration due to the coefficients of degree n is a linear combination
+ *      of the solid harmonics of degree n+1, and the gravity gradient one of the solid harmonics of degree n+2. For each
+ *      solid harmonic U(j,k) = V(j,k) + iW(j,k), these combinations are collected into a weight of V(j,k) and one of
+ *      W(j,k), per output component. Since the column-wise recursion of the solid harmonics only couples terms of the same
+ *      order, the recursion and summation are performed order by order (after computing all sectoral terms), so that only
+ *      the terms of the last three degrees of a single order need to be stored for the points of a block.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Constructor
+BatchedSphericalHarmonicsGravityEvaluator::BatchedSphericalHarmonicsGravityEvaluator(
+        const double referenceRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const unsigned int numberOfThreads,
+        const int pointsPerBlock ):
+    referenceRadius_( referenceRadius ), maximumDegree_( -1 ), maximumOrder_( -1 ),
+    numberOfOrders_( 0 ), numberOfDegrees_( 0 ), pointsPerBlock_( pointsPerBlock )
+{
+    if( pointsPerBlock_ < 1 )
+    {
+        throw std::runtime_error( "Error when creating batched spherical harmonic gravity evaluator, number of points per "
+                                  "block must be positive." );
+    }
+
+    unsigned int numberOfUsedThreads =
+            ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+    if( numberOfUsedThreads > 1 )
+    {
+        parallelTaskExecutor_ = std::make_shared< utilities::ParallelTaskExecutor >( numberOfUsedThreads );
+    }
+    workspaces_.resize( numberOfUsedThreads );
+
+    resetCoefficients( cosineHarmonicCoefficients, sineHarmonicCoefficients );
+}
+
+//! Function to reset the spherical harmonic coefficients.
+void BatchedSphericalHarmonicsGravityEvaluator::resetCoefficients(
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients )
+{
+    if( cosineHarmonicCoefficients.rows( ) != sineHarmonicCoefficients.rows( ) ||
+            cosineHarmonicCoefficients.cols( ) != sineHarmonicCoefficients.cols( ) )
+    {
+        throw std::runtime_error( "Error when setting coefficients of batched spherical harmonic gravity evaluator, "
+                                  "coefficient matrices are of unequal size." );
+    }
+    else if( cosineHarmonicCoefficients.rows( ) == 0 || cosineHarmonicCoefficients.cols( ) == 0 )
+    {
+        throw std::runtime_error( "Error when setting coefficients of batched spherical harmonic gravity evaluator, "
+                                  "coefficient matrices are empty." );
+    }
+
+    // Only recompute weights if coefficients have changed.
+    if( cosineHarmonicCoefficients.rows( ) == cosineHarmonicCoefficients_.rows( ) &&
+            cosineHarmonicCoefficients.cols( ) == cosineHarmonicCoefficients_.cols( ) &&
+            cosineHarmonicCoefficients == cosineHarmonicCoefficients_ &&
+            sineHarmonicCoefficients == sineHarmonicCoefficients_ )
+    {
+        return;
+    }
+
+    cosineHarmonicCoefficients_ = cosineHarmonicCoefficients;
+    sineHarmonicCoefficients_ = sineHarmonicCoefficients;
+
+    const int maximumDegree = static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1;
+    const int maximumOrder = std::min( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1, maximumDegree );
+
+    // Reset recursion coefficients and workspaces if degree or order have changed.
+    if( maximumDegree != maximumDegree_ || maximumOrder != maximumOrder_ )
+    {
+        maximumDegree_ = maximumDegree;
+        maximumOrder_ = maximumOrder;
+        numberOfOrders_ = maximumOrder_ + 3;
+
+        numberOfDegrees_ = maximumDegree_ + 3;
+
+        // Store recursion coefficients per order (with contiguous degrees).
+        CartesianSphericalHarmonicsCache recursionCache( maximumDegree_, maximumOrder_ );
+        firstRecursionCoefficients_ = Eigen::Map< const Eigen::ArrayXd >(
+                    Eigen::ArrayXXd( recursionCache.getFirstRecursionCoefficients( ) ).data( ),
+                    numberOfDegrees_ * numberOfOrders_ );
+        secondRecursionCoefficients_ = Eigen::Map< const Eigen::ArrayXd >(
+                    Eigen::ArrayXXd( recursionCache.getSecondRecursionCoefficients( ) ).data( ),
+                    numberOfDegrees_ * numberOfOrders_ );
+        sectoralRecursionCoefficients_ = recursionCache.getSectoralRecursionCoefficients( );
+
+        for( unsigned int i = 0; i < workspaces_.size( ); i++ )
+        {
+            BlockWorkspace& workspace = workspaces_.at( i );
+            workspace.scaledX.resize( pointsPerBlock_ );
+            workspace.scaledY.resize( pointsPerBlock_ );
+            workspace.scaledZ.resize( pointsPerBlock_ );
+            workspace.squaredRadiusRatio.resize( pointsPerBlock_ );
+            workspace.sectoralCosineTerms = Eigen::ArrayXXd::Zero( pointsPerBlock_, numberOfOrders_ );
+            workspace.sectoralSineTerms = Eigen::ArrayXXd::Zero( pointsPerBlock_, numberOfOrders_ );
+            workspace.cosineTerms = Eigen::ArrayXXd::Zero( pointsPerBlock_, 3 );
+            workspace.sineTerms = Eigen::ArrayXXd::Zero( pointsPerBlock_, 3 );
+            workspace.weightedSums = Eigen::ArrayXXd::Zero( pointsPerBlock_, 10 );
+        }
+    }
+
+    computeSolidHarmonicWeights( );
+}
+
+//! Function to set the weights of the solid harmonics from the current coefficients.
+void BatchedSphericalHarmonicsGravityEvaluator::computeSolidHarmonicWeights( )
+{
+    typedef CartesianSphericalHarmonicsCache::DegreeOrderArray DegreeOrderArray;
+
+    // Retrieve derivative coefficients (up to degree one higher than needed for gravity gradient).
+    CartesianSphericalHarmonicsCache derivativeCache( maximumDegree_ + 1, maximumOrder_ + 1 );
+    const DegreeOrderArray& raisingCoefficients = derivativeCache.getRaisingDerivativeCoefficients( );
+    const DegreeOrderArray& loweringCoefficients = derivativeCache.getLoweringDerivativeCoefficients( );
+    const DegreeOrderArray& verticalCoefficients = derivativeCache.getVerticalDerivativeCoefficients( );
+
+    accelerationWeights_ = Eigen::MatrixXd::Zero( 6, numberOfDegrees_ * numberOfOrders_ );
+    potentialWeights_ = Eigen::MatrixXd::Zero( 2, numberOfDegrees_ * numberOfOrders_ );
+    gravityGradientWeights_ = Eigen::MatrixXd::Zero( 12, numberOfDegrees_ * numberOfOrders_ );
+
+    // Add weights of V(j,k) and W(j,k) to given output component (0-2: acceleration, 3: potential, 4-9: gravity gradient).
+    auto addWeights = [ & ]( const int component, const int j, const int k,
+            const double cosineWeight, const double sineWeight )
+    {
+        const int index = k * numberOfDegrees_ + j;
+        if( component < 3 )
+        {
+            accelerationWeights_( component, index ) += cosineWeight;
+            accelerationWeights_( component + 3, index ) += sineWeight;
+        }
+        else if( component == 3 )
+        {
+            potentialWeights_( 0, index ) += cosineWeight;
+            potentialWeights_( 1, index ) += sineWeight;
+        }
+        else
+        {
+            gravityGradientWeights_( component - 4, index ) += cosineWeight;
+            gravityGradientWeights_( component + 2, index ) += sineWeight;
+        }
+    };
+
+    for( int degree = 0; degree <= maximumDegree_; degree++ )
+    {
+        const int nextDegree = degree + 1;
+        const int secondDegree = degree + 2;
+        for( int order = 0; order <= std::min( degree, maximumOrder_ ); order++ )
+        {
+            const double cosineCoefficient = cosineHarmonicCoefficients_( degree, order );
+            const double sineCoefficient = ( order == 0 ) ? 0.0 : sineHarmonicCoefficients_( degree, order );
+
+            // Add weights of real/imaginary part of ( C - iS ) U(j,k) (or ( C - iS ) conj( U(j,k) )) times factor to
+            // given output component.
+            auto addRealTerm = [ & ]( const int component, const int j, const int k, const double factor ){
+                addWeights( component, j, k, factor * cosineCoefficient, factor * sineCoefficient ); };
+            auto addImaginaryTerm = [ & ]( const int component, const int j, const int k, const double factor ){
+                addWeights( component, j, k, -factor * sineCoefficient, factor * cosineCoefficient ); };
+            auto addConjugateRealTerm = [ & ]( const int component, const int j, const int k, const double factor ){
+                addWeights( component, j, k, factor * cosineCoefficient, -factor * sineCoefficient ); };
+            auto addConjugateImaginaryTerm = [ & ]( const int component, const int j, const int k, const double factor ){
+                addWeights( component, j, k, -factor * sineCoefficient, -factor * cosineCoefficient ); };
+
+            // Set weights for potential.
+            addRealTerm( 3, degree, order, 1.0 );
+
+            // Set weights for acceleration.
+            if( order == 0 )
+            {
+                addRealTerm( 0, nextDegree, 1, -raisingCoefficients( degree, 0 ) );
+                addImaginaryTerm( 1, nextDegree, 1, -raisingCoefficients( degree, 0 ) );
+                addRealTerm( 2, nextDegree, 0, -verticalCoefficients( degree, 0 ) );
+            }
+            else
+            {
+                addRealTerm( 0, nextDegree, order - 1, 0.5 * loweringCoefficients( degree, order ) );
+                addRealTerm( 0, nextDegree, order + 1, -0.5 * raisingCoefficients( degree, order ) );
+                addImaginaryTerm( 1, nextDegree, order - 1, -0.5 * loweringCoefficients( degree, order ) );
+                addImaginaryTerm( 1, nextDegree, order + 1, -0.5 * raisingCoefficients( degree, order ) );
+                addRealTerm( 2, nextDegree, order, -verticalCoefficients( degree, order ) );
+            }
+
+            // Set weights for gravity gradient (components xx, xy, xz, yy, yz, zz in columns 4 to 9), with the terms
+            // obtained from D+ D+, D+ D- (equal to -Dz Dz), D- D-, Dz D+ and Dz D- (see computeCartesianGeodesyNormalized-
+            // GravitationalAccelerationSum).
+            double factor = raisingCoefficients( degree, order ) * raisingCoefficients( nextDegree, order + 1 );
+            addRealTerm( 4, secondDegree, order + 2, 0.25 * factor );
+            addRealTerm( 7, secondDegree, order + 2, -0.25 * factor );
+            addImaginaryTerm( 5, secondDegree, order + 2, 0.25 * factor );
+
+            factor = verticalCoefficients( degree, order ) * verticalCoefficients( nextDegree, order );
+            addRealTerm( 4, secondDegree, order, -0.5 * factor );
+            addRealTerm( 7, secondDegree, order, -0.5 * factor );
+            addRealTerm( 9, secondDegree, order, factor );
+
+            if( order >= 2 )
+            {
+                factor = loweringCoefficients( degree, order ) * loweringCoefficients( nextDegree, order - 1 );
+                addRealTerm( 4, secondDegree, order - 2, 0.25 * factor );
+                addRealTerm( 7, secondDegree, order - 2, -0.25 * factor );
+                addImaginaryTerm( 5, secondDegree, order - 2, -0.25 * factor );
+            }
+            else
+            {
+                const int conjugateOrder = 2 - order;
+                factor = ( order == 1 ) ?
+                            -loweringCoefficients( degree, 1 ) * raisingCoefficients( nextDegree, 0 ) :
+                            raisingCoefficients( degree, 0 ) * raisingCoefficients( nextDegree, 1 );
+                addConjugateRealTerm( 4, secondDegree, conjugateOrder, 0.25 * factor );
+                addConjugateRealTerm( 7, secondDegree, conjugateOrder, -0.25 * factor );
+                addConjugateImaginaryTerm( 5, secondDegree, conjugateOrder, -0.25 * factor );
+            }
+
+            factor = raisingCoefficients( degree, order ) * verticalCoefficients( nextDegree, order + 1 );
+            addRealTerm( 6, secondDegree, order + 1, 0.5 * factor );
+            addImaginaryTerm( 8, secondDegree, order + 1, 0.5 * factor );
+
+            if( order >= 1 )
+            {
+                factor = -loweringCoefficients( degree, order ) * verticalCoefficients( nextDegree, order - 1 );
+                addRealTerm( 6, secondDegree, order - 1, 0.5 * factor );
+                addImaginaryTerm( 8, secondDegree, order - 1, -0.5 * factor );
+            }
+            else
+            {
+                factor = raisingCoefficients( degree, 0 ) * verticalCoefficients( nextDegree, 1 );
+                addConjugateRealTerm( 6, secondDegree, 1, 0.5 * factor );
+                addConjugateImaginaryTerm( 8, secondDegree, 1, -0.5 * factor );
+            }
+        }
+    }
+}
+
+//! Function to evaluate the weighted sums of the solid harmonics for a single block of points.
+void BatchedSphericalHarmonicsGravityEvaluator::evaluateBlock(
+        const CartesianPointBlock& bodyFixedPositions,
+        const int firstPoint, const int numberOfPoints,
+        const bool computePotentials, const bool computeGravityGradients,
+        BlockWorkspace& workspace )
+{
+    const int highestDegree = maximumDegree_ + ( computeGravityGradients ? 2 : 1 );
+    const int highestOrder = maximumOrder_ + ( computeGravityGradients ? 2 : 1 );
+
+    // Compute scaled position components of all points.
+    const auto xComponents = bodyFixedPositions.col( 0 ).segment( firstPoint, numberOfPoints ).array( );
+    const auto yComponents = bodyFixedPositions.col( 1 ).segment( firstPoint, numberOfPoints ).array( );
+    const auto zComponents = bodyFixedPositions.col( 2 ).segment( firstPoint, numberOfPoints ).array( );
+
+    auto squaredRadiusRatio = workspace.squaredRadiusRatio.head( numberOfPoints );
+    auto scaledX = workspace.scaledX.head( numberOfPoints );
+    auto scaledY = workspace.scaledY.head( numberOfPoints );
+    auto scaledZ = workspace.scaledZ.head( numberOfPoints );
+    squaredRadiusRatio = referenceRadius_ * referenceRadius_ /
+            ( xComponents.square( ) + yComponents.square( ) + zComponents.square( ) );
+    scaledX = xComponents * squaredRadiusRatio / referenceRadius_;
+    scaledY = yComponents * squaredRadiusRatio / referenceRadius_;
+    scaledZ = zComponents * squaredRadiusRatio / referenceRadius_;
+
+    // Compute sectoral terms of all points.
+    workspace.sectoralCosineTerms.col( 0 ).head( numberOfPoints ) = squaredRadiusRatio.sqrt( );
+    workspace.sectoralSineTerms.col( 0 ).head( numberOfPoints ).setZero( );
+    for( int order = 1; order <= highestOrder; order++ )
+    {
+        const auto previousCosineTerms = workspace.sectoralCosineTerms.col( order - 1 ).head( numberOfPoints );
+        const auto previousSineTerms = workspace.sectoralSineTerms.col( order - 1 ).head( numberOfPoints );
+        workspace.sectoralCosineTerms.col( order ).head( numberOfPoints ) = sectoralRecursionCoefficients_( order ) *
+                ( scaledX * previousCosineTerms - scaledY * previousSineTerms );
+        workspace.sectoralSineTerms.col( order ).head( numberOfPoints ) = sectoralRecursionCoefficients_( order ) *
+                ( scaledX * previousSineTerms + scaledY * previousCosineTerms );
+    }
+
+    auto weightedSums = workspace.weightedSums.topRows( numberOfPoints );
+    weightedSums.setZero( );
+
+    // Define function adding weighted solid harmonics of given degree and order to output components of all points.
+    auto addWeightedTerms = [ & ]( const int index, const int slot )
+    {
+        const auto cosineTerms = workspace.cosineTerms.col( slot ).head( numberOfPoints );
+        const auto sineTerms = workspace.sineTerms.col( slot ).head( numberOfPoints );
+
+        const double* weights = accelerationWeights_.col( index ).data( );
+        for( int i = 0; i < 3; i++ )
+        {
+            weightedSums.col( i ) += weights[ i ] * cosineTerms + weights[ i + 3 ] * sineTerms;
+        }
+        if( computePotentials )
+        {
+            weights = potentialWeights_.col( index ).data( );
+            weightedSums.col( 3 ) += weights[ 0 ] * cosineTerms + weights[ 1 ] * sineTerms;
+        }
+        if( computeGravityGradients )
+        {
+            weights = gravityGradientWeights_.col( index ).data( );
+            for( int i = 0; i < 6; i++ )
+            {
+                weightedSums.col( i + 4 ) += weights[ i ] * cosineTerms + weights[ i + 6 ] * sineTerms;
+            }
+        }
+    };
+
+    // Compute and add solid harmonics order by order, using the column-wise recursion over the degrees.
+    for( int order = 0; order <= highestOrder; order++ )
+    {
+        int currentSlot = 0, previousSlot = 2, secondPreviousSlot = 1;
+        workspace.cosineTerms.col( currentSlot ).head( numberOfPoints ) =
+                workspace.sectoralCosineTerms.col( order ).head( numberOfPoints );
+        workspace.sineTerms.col( currentSlot ).head( numberOfPoints ) =
+                workspace.sectoralSineTerms.col( order ).head( numberOfPoints );
+        workspace.cosineTerms.col( previousSlot ).head( numberOfPoints ).setZero( );
+        workspace.sineTerms.col( previousSlot ).head( numberOfPoints ).setZero( );
+        addWeightedTerms( order * numberOfDegrees_ + order, currentSlot );
+
+        for( int degree = order + 1; degree <= highestDegree; degree++ )
+        {
+            secondPreviousSlot = previousSlot;
+            previousSlot = currentSlot;
+            currentSlot = ( currentSlot + 1 ) % 3;
+
+            const int index = order * numberOfDegrees_ + degree;
+            const double firstCoefficient = firstRecursionCoefficients_( index );
+            const double secondCoefficient = secondRecursionCoefficients_( index );
+            workspace.cosineTerms.col( currentSlot ).head( numberOfPoints ) =
+                    firstCoefficient * scaledZ * workspace.cosineTerms.col( previousSlot ).head( numberOfPoints ) -
+                    secondCoefficient * squaredRadiusRatio *
+                    workspace.cosineTerms.col( secondPreviousSlot ).head( numberOfPoints );
+            workspace.sineTerms.col( currentSlot ).head( numberOfPoints ) =
+                    firstCoefficient * scaledZ * workspace.sineTerms.col( previousSlot ).head( numberOfPoints ) -
+                    secondCoefficient * squaredRadiusRatio *
+                    workspace.sineTerms.col( secondPreviousSlot ).head( numberOfPoints );
+            addWeightedTerms( index, currentSlot );
+        }
+    }
+}
+
+//! Function to compute the gravitational acceleration, potential and gravity gradient at a block of points.
+void BatchedSphericalHarmonicsGravityEvaluator::computeGravityField(
+        const double gravitationalParameter,
+        const CartesianPointBlock& bodyFixedPositions,
+        CartesianPointBlock& accelerations,
+        const bool computePotentials,
+        Eigen::VectorXd& potentials,
+        const bool computeGravityGradients,
+        GravityGradientBlock& gravityGradients )
+{
+    const int numberOfPoints = static_cast< int >( bodyFixedPositions.rows( ) );
+
+    accelerations.resize( numberOfPoints, 3 );
+    if( computePotentials )
+    {
+        potentials.resize( numberOfPoints );
+    }
+    if( computeGravityGradients )
+    {
+        gravityGradients.resize( numberOfPoints, 6 );
+    }
+
+    // Define function evaluating a single block of points, and scaling the results.
+    const double accelerationScaling = gravitationalParameter / ( referenceRadius_ * referenceRadius_ );
+    auto evaluateSingleBlock = [ & ]( const unsigned int blockIndex, const unsigned int threadIndex )
+    {
+        const int firstPoint = static_cast< int >( blockIndex ) * pointsPerBlock_;
+        const int numberOfPointsInBlock = std::min( pointsPerBlock_, numberOfPoints - firstPoint );
+        BlockWorkspace& workspace = workspaces_.at( threadIndex );
+
+        evaluateBlock( bodyFixedPositions, firstPoint, numberOfPointsInBlock, computePotentials, computeGravityGradients,
+                       workspace );
+
+        accelerations.middleRows( firstPoint, numberOfPointsInBlock ) =
+                accelerationScaling * workspace.weightedSums.topLeftCorner( numberOfPointsInBlock, 3 ).matrix( );
+        if( computePotentials )
+        {
+            potentials.segment( firstPoint, numberOfPointsInBlock ) = gravitationalParameter / referenceRadius_ *
+                    workspace.weightedSums.col( 3 ).head( numberOfPointsInBlock ).matrix( );
+        }
+        if( computeGravityGradients )
+        {
+            gravityGradients.middleRows( firstPoint, numberOfPointsInBlock ) =
+                    accelerationScaling / referenceRadius_ *
+                    workspace.weightedSums.block( 0, 4, numberOfPointsInBlock, 6 ).matrix( );
+        }
+    };
+
+    // Evaluate all blocks, distributed over the threads if requested.
+    const unsigned int numberOfBlocks = static_cast< unsigned int >(
+                ( numberOfPoints + pointsPerBlock_ - 1 ) / pointsPerBlock_ );
+    if( parallelTaskExecutor_ != nullptr && numberOfBlocks > 1 )
+    {
+        parallelTaskExecutor_->executeTasks( numberOfBlocks, evaluateSingleBlock );
+    }
+    else
+    {
+        for( unsigned int i = 0; i < numberOfBlocks; i++ )
+        {
+            evaluateSingleBlock( i, 0 );
+        }
+    }
+}
+
+//! Function to compute the gravitational acceleration at a block of points.
+void BatchedSphericalHarmonicsGravityEvaluator::computeAccelerations(
+        const double gravitationalParameter,
+        const CartesianPointBlock& bodyFixedPositions,
+        CartesianPointBlock& accelerations )
+{
+    Eigen::VectorXd dummyPotentials;
+    GravityGradientBlock dummyGravityGradients;
+    computeGravityField( gravitationalParameter, bodyFixedPositions, accelerations,
+                         false, dummyPotentials, false, dummyGravityGradients );
+}
+
+//! Constructor
+BatchedSphericalHarmonicsGravityCache::BatchedSphericalHarmonicsGravityCache(
+        const double referenceRadius,
+        const std::function< Eigen::MatrixXd( ) > cosineHarmonicCoefficientsFunction,
+        const std::function< Eigen::MatrixXd( ) > sineHarmonicCoefficientsFunction,
+        const unsigned int numberOfThreads,
+        const int pointsPerBlock ):
+    cosineHarmonicCoefficientsFunction_( cosineHarmonicCoefficientsFunction ),
+    sineHarmonicCoefficientsFunction_( sineHarmonicCoefficientsFunction ),
+    computeGravityGradients_( false ), currentTime_( TUDAT_NAN )
+{
+    evaluator_ = std::make_shared< BatchedSphericalHarmonicsGravityEvaluator >(
+                referenceRadius, cosineHarmonicCoefficientsFunction_( ), sineHarmonicCoefficientsFunction_( ),
+                numberOfThreads, pointsPerBlock );
+}
+
+//! Function to add a point at which the gravity field is to be evaluated.
+int BatchedSphericalHarmonicsGravityCache::addEvaluationPoint(
+        const std::function< Eigen::Vector3d( ) > bodyFixedPositionFunction )
+{
+    positionFunctions_.push_back( bodyFixedPositionFunction );
+    positions_.resize( positionFunctions_.size( ), 3 );
+    currentTime_ = TUDAT_NAN;
+    return static_cast< int >( positionFunctions_.size( ) ) - 1;
+}
+
+//! Function to update the gravity field at all points to the current time.
+void BatchedSphericalHarmonicsGravityCache::update( const double currentTime )
+{
+    if( !( currentTime_ == currentTime ) )
+    {
+        for( unsigned int i = 0; i < positionFunctions_.size( ); i++ )
+        {
+            positions_.row( i ) = positionFunctions_.at( i )( ).transpose( );
+        }
+
+        evaluator_->resetCoefficients( cosineHarmonicCoefficientsFunction_( ), sineHarmonicCoefficientsFunction_( ) );
+        evaluator_->computeGravityField( 1.0, positions_, accelerations_, false, potentials_,
+                                         computeGravityGradients_, gravityGradients_ );
+        currentTime_ = currentTime;
+    }
+}
+
+//! Function to retrieve the gravity gradient for a unit gravitational parameter at a point (if computed).
+Eigen::Matrix3d BatchedSphericalHarmonicsGravityCache::getUnitGravityGradient( const int pointIndex )
+{
+    if( !computeGravityGradients_ )
+    {
+        throw std::runtime_error( "Error when retrieving gravity gradient from batched spherical harmonic gravity cache, "
+                                  "gravity gradients are not computed." );
+    }
+
+    Eigen::Matrix3d gravityGradient;
+    gravityGradient << gravityGradients_( pointIndex, 0 ), gravityGradients_( pointIndex, 1 ),
+            gravityGradients_( pointIndex, 2 ),
+            gravityGradients_( pointIndex, 1 ), gravityGradients_( pointIndex, 3 ), gravityGradients_( pointIndex, 4 ),
+            gravityGradients_( pointIndex, 2 ), gravityGradients_( pointIndex, 4 ), gravityGradients_( pointIndex, 5 );
+    return gravityGradient;
+}
+
+} // namespace gravitation
+
+} // namespace tudat
@@ -0,0 +1,353 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Cunningham, L.E. On the computation of the spherical harmonic terms needed during the numerical integration of
+ *          the orbital motion of an artificial satellite. Celestial Mechanics, 2, 207-216, 1970.
+ *
+ */
+
+#ifndef TUDAT_BATCHED_SPHERICAL_HARMONICS_GRAVITY_H
+#define TUDAT_BATCHED_SPHERICAL_HARMONICS_GRAVITY_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelExecution.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Typedef for structure-of-arrays block of Cartesian vectors (one row per point, columns x, y and z stored contiguously).
+typedef Eigen::Matrix< double, Eigen::Dynamic, 3 > CartesianPointBlock;
+
+//! Typedef for structure-of-arrays block of gravity gradients (one row per point, columns xx, xy, xz, yy, yz and zz).
+typedef Eigen::Matrix< double, Eigen::Dynamic, 6 > GravityGradientBlock;
+
+//! Class for evaluating a spherical harmonic gravity field at many points at once.
+/*!
+ *  Class for evaluating the acceleration (and optionally the potential and gravity gradient) due to a single set of
+ *  geodesy-normalized spherical harmonic coefficients at a large number of points at once. The points are processed in
+ *  blocks, and the Cartesian (Cunningham) recursion of the solid spherical harmonics (see
+ *  CartesianSphericalHarmonicsCache) is evaluated for all points of a block at once, so that all operations are
+ *  vectorized across points. The coefficients are combined with the derivative coefficients of the recursion into
+ *  weights of the solid harmonics when they are set, so that the summation reduces to a weighted sum of the solid
+ *  harmonics, computed order by order for all points of a block. The blocks may be distributed over a number of threads, each
+ *  thread using its own (pre-allocated) workspace.
+ *
+ *  The potential is defined as positive, i.e. equal to mu/r for a point mass, and the acceleration is its gradient.
+ *  All quantities are expressed in the frame in which the coefficients are defined.
+ */
+class BatchedSphericalHarmonicsGravityEvaluator
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param referenceRadius Reference radius of the spherical harmonic expansion.
+     *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+     *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+     *  \param numberOfThreads Number of threads over which the blocks of points are distributed (1 for serial evaluation,
+     *  0 to use all available threads).
+     *  \param pointsPerBlock Number of points that are processed at once by a single thread.
+     */
+    BatchedSphericalHarmonicsGravityEvaluator(
+            const double referenceRadius,
+            const Eigen::MatrixXd& cosineHarmonicCoefficients,
+            const Eigen::MatrixXd& sineHarmonicCoefficients,
+            const unsigned int numberOfThreads = 1,
+            const int pointsPerBlock = 64 );
+
+    //! Function to reset the spherical harmonic coefficients.
+    /*!
+     *  Function to reset the spherical harmonic coefficients, recomputing the weights of the solid harmonics (only if the
+     *  coefficients differ from the current ones).
+     *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+     *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+     */
+    void resetCoefficients( const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                            const Eigen::MatrixXd& sineHarmonicCoefficients );
+
+    //! Function to compute the gravitational acceleration, potential and gravity gradient at a block of points.
+    /*!
+     *  Function to compute the gravitational acceleration, and optionally the potential and gravity gradient, at a block
+     *  of points.
+     *  \param gravitationalParameter Gravitational parameter associated with the spherical harmonics.
+     *  \param bodyFixedPositions Positions at which the gravity field is to be evaluated, in the frame in which the
+     *  coefficients are defined.
+     *  \param accelerations Gravitational accelerations at the positions (returned by reference).
+     *  \param computePotentials Boolean denoting whether the potentials are to be computed.
+     *  \param potentials Gravitational potentials at the positions (returned by reference, only set if computePotentials
+     *  is true).
+     *  \param computeGravityGradients Boolean denoting whether the gravity gradients are to be computed.
+     *  \param gravityGradients Gravity gradients at the positions (returned by reference, only set if
+     *  computeGravityGradients is true).
+     */
+    void computeGravityField( const double gravitationalParameter,
+                              const CartesianPointBlock& bodyFixedPositions,
+                              CartesianPointBlock& accelerations,
+                              const bool computePotentials,
+                              Eigen::VectorXd& potentials,
+                              const bool computeGravityGradients,
+                              GravityGradientBlock& gravityGradients );
+
+    //! Function to compute the gravitational acceleration at a block of points.
+    /*!
+     *  Function to compute the gravitational acceleration at a block of points.
+     *  \param gravitationalParameter Gravitational parameter associated with the spherical harmonics.
+     *  \param bodyFixedPositions Positions at which the acceleration is to be evaluated, in the frame in which the
+     *  coefficients are defined.
+     *  \param accelerations Gravitational accelerations at the positions (returned by reference).
+     */
+    void computeAccelerations( const double gravitationalParameter,
+                               const CartesianPointBlock& bodyFixedPositions,
+                               CartesianPointBlock& accelerations );
+
+    //! Function to retrieve the reference radius of the spherical harmonic expansion.
+    double getReferenceRadius( )
+    {
+        return referenceRadius_;
+    }
+
+    //! Function to retrieve the maximum degree of the spherical harmonic expansion.
+    int getMaximumDegree( )
+    {
+        return maximumDegree_;
+    }
+
+    //! Function to retrieve the maximum order of the spherical harmonic expansion.
+    int getMaximumOrder( )
+    {
+        return maximumOrder_;
+    }
+
+    //! Function to retrieve the number of threads over which the blocks of points are distributed.
+    unsigned int getNumberOfThreads( )
+    {
+        return static_cast< unsigned int >( workspaces_.size( ) );
+    }
+
+private:
+
+    //! Workspace used by a single thread for the evaluation of a block of points.
+    struct BlockWorkspace
+    {
+        //! Position components, scaled by the reference radius over the squared distance, of the points of the block.
+        Eigen::ArrayXd scaledX, scaledY, scaledZ;
+
+        //! Squared ratio of reference radius over distance of the points of the block.
+        Eigen::ArrayXd squaredRadiusRatio;
+
+        //! Cosine and sine sectoral solid harmonics of the points of the block (rows: points, columns: order).
+        Eigen::ArrayXXd sectoralCosineTerms, sectoralSineTerms;
+
+        //! Cosine and sine solid harmonics of a single order and the last three degrees (used cyclically).
+        Eigen::ArrayXXd cosineTerms, sineTerms;
+
+        //! Sums of the weighted solid harmonics for the points of the block (rows: points, columns: output components).
+        Eigen::ArrayXXd weightedSums;
+    };
+
+    //! Function to set the weights of the solid harmonics from the current coefficients.
+    void computeSolidHarmonicWeights( );
+
+    //! Function to evaluate the weighted sums of the solid harmonics for a single block of points.
+    /*!
+     *  Function to evaluate the weighted sums of the solid harmonics for a single block of points.
+     *  \param bodyFixedPositions Positions of all points.
+     *  \param firstPoint Index of the first point of the block.
+     *  \param numberOfPoints Number of points in the block.
+     *  \param computePotentials Boolean denoting whether the potentials are to be computed.
+     *  \param computeGravityGradients Boolean denoting whether the gravity gradients are to be computed.
+     *  \param workspace Workspace to be used for the block.
+     */
+    void evaluateBlock( const CartesianPointBlock& bodyFixedPositions,
+                        const int firstPoint, const int numberOfPoints,
+                        const bool computePotentials, const bool computeGravityGradients,
+                        BlockWorkspace& workspace );
+
+    //! Reference radius of the spherical harmonic expansion.
+    double referenceRadius_;
+
+    //! Maximum degree of the spherical harmonic expansion.
+    int maximumDegree_;
+
+    //! Maximum order of the spherical harmonic expansion.
+    int maximumOrder_;
+
+    //! Number of orders of solid harmonics that are computed (maximum order plus three).
+    int numberOfOrders_;
+
+    //! Number of degrees of solid harmonics that are computed (maximum degree plus three).
+    int numberOfDegrees_;
+
+    //! Number of points that are processed at once by a single thread.
+    int pointsPerBlock_;
+
+    //! Current geodesy-normalized cosine coefficients.
+    Eigen::MatrixXd cosineHarmonicCoefficients_;
+
+    //! Current geodesy-normalized sine coefficients.
+    Eigen::MatrixXd sineHarmonicCoefficients_;
+
+    //! Coefficients of the column-wise recursion of the solid harmonics (degree n, order m at m * numberOfDegrees_ + n).
+    Eigen::ArrayXd firstRecursionCoefficients_;
+
+    //! Coefficients of the column-wise recursion of the solid harmonics (stored as firstRecursionCoefficients_).
+    Eigen::ArrayXd secondRecursionCoefficients_;
+
+    //! Coefficients of the sectoral recursion of the solid harmonics.
+    Eigen::ArrayXd sectoralRecursionCoefficients_;
+
+    //! Weights of the solid harmonics in the acceleration.
+    /*!
+     *  Weights of the solid harmonics in the (unscaled) acceleration. The weights of the harmonic of degree n and order m
+     *  are in column m * numberOfDegrees_ + n, with the rows denoting the weights of the cosine harmonic in the x, y and z
+     *  component, followed by those of the sine harmonic.
+     */
+    Eigen::MatrixXd accelerationWeights_;
+
+    //! Weights of the cosine and sine solid harmonics in the (unscaled) potential (stored as accelerationWeights_).
+    Eigen::MatrixXd potentialWeights_;
+
+    //! Weights of the solid harmonics in the (unscaled) gravity gradient (xx, xy, xz, yy, yz, zz; as accelerationWeights_).
+    Eigen::MatrixXd gravityGradientWeights_;
+
+    //! Workspaces of the threads.
+    std::vector< BlockWorkspace > workspaces_;
+
+    //! Object distributing the blocks of points over the threads (nullptr if evaluated serially).
+    std::shared_ptr< utilities::ParallelTaskExecutor > parallelTaskExecutor_;
+};
+
+//! Class for batched evaluation of the spherical harmonic gravity field of a single body for several acceleration models.
+/*!
+ *  Class for batched evaluation of the spherical harmonic gravity field of a single body for several acceleration models
+ *  (typically for several spacecraft orbiting the same body). Each acceleration model registers a function returning its
+ *  current body-fixed position, and the field is evaluated for all registered positions at once (using a
+ *  BatchedSphericalHarmonicsGravityEvaluator) when the first of the models is updated to a new time. The accelerations
+ *  are computed for a unit gravitational parameter, so that each model may apply its own (e.g. mutual) value.
+ */
+class BatchedSphericalHarmonicsGravityCache
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param referenceRadius Reference radius of the spherical harmonic expansion.
+     *  \param cosineHarmonicCoefficientsFunction Function returning the geodesy-normalized cosine coefficients.
+     *  \param sineHarmonicCoefficientsFunction Function returning the geodesy-normalized sine coefficients.
+     *  \param numberOfThreads Number of threads over which the evaluation is distributed.
+     *  \param pointsPerBlock Number of points that are processed at once by a single thread.
+     */
+    BatchedSphericalHarmonicsGravityCache(
+            const double referenceRadius,
+            const std::function< Eigen::MatrixXd( ) > cosineHarmonicCoefficientsFunction,
+            const std::function< Eigen::MatrixXd( ) > sineHarmonicCoefficientsFunction,
+            const unsigned int numberOfThreads = 1,
+            const int pointsPerBlock = 64 );
+
+    //! Function to add a point at which the gravity field is to be evaluated.
+    /*!
+     *  Function to add a point at which the gravity field is to be evaluated.
+     *  \param bodyFixedPositionFunction Function returning the current position at which the field is to be evaluated, in
+     *  the frame in which the coefficients are defined.
+     *  \return Index of the point, to be used when retrieving the results.
+     */
+    int addEvaluationPoint( const std::function< Eigen::Vector3d( ) > bodyFixedPositionFunction );
+
+    //! Function to update the gravity field at all points to the current time.
+    /*!
+     *  Function to update the gravity field at all points to the current time, if not yet done for this time (an update
+     *  is always performed if the time is NaN).
+     *  \param currentTime Time to which the cache is to be updated.
+     */
+    void update( const double currentTime = TUDAT_NAN );
+
+    //! Function to reset the current time of the cache, so that the next call to update recomputes the gravity field.
+    void resetCurrentTime( )
+    {
+        currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to set whether the gravity gradients are to be computed when updating the cache.
+    void setComputeGravityGradients( const bool computeGravityGradients )
+    {
+        computeGravityGradients_ = computeGravityGradients;
+        currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to retrieve the acceleration for a unit gravitational parameter at a point, as computed by last update.
+    Eigen::Vector3d getUnitAcceleration( const int pointIndex )
+    {
+        return accelerations_.row( pointIndex ).transpose( );
+    }
+
+    //! Function to retrieve the gravity gradient for a unit gravitational parameter at a point (if computed).
+    Eigen::Matrix3d getUnitGravityGradient( const int pointIndex );
+
+    //! Function to retrieve the number of points at which the gravity field is evaluated.
+    int getNumberOfEvaluationPoints( )
+    {
+        return static_cast< int >( positionFunctions_.size( ) );
+    }
+
+    //! Function to retrieve the object used to evaluate the gravity field.
+    std::shared_ptr< BatchedSphericalHarmonicsGravityEvaluator > getEvaluator( )
+    {
+        return evaluator_;
+    }
+
+private:
+
+    //! Functions returning the positions at which the gravity field is to be evaluated.
+    std::vector< std::function< Eigen::Vector3d( ) > > positionFunctions_;
+
+    //! Function returning the geodesy-normalized cosine coefficients.
+    std::function< Eigen::MatrixXd( ) > cosineHarmonicCoefficientsFunction_;
+
+    //! Function returning the geodesy-normalized sine coefficients.
+    std::function< Eigen::MatrixXd( ) > sineHarmonicCoefficientsFunction_;
+
+    //! Object used to evaluate the gravity field.
+    std::shared_ptr< BatchedSphericalHarmonicsGravityEvaluator > evaluator_;
+
+    //! Boolean denoting whether the gravity gradients are to be computed when updating the cache.
+    bool computeGravityGradients_;
+
+    //! Time of last update.
+    double currentTime_;
+
+    //! Current positions of the points.
+    CartesianPointBlock positions_;
+
+    //! Current accelerations (for unit gravitational parameter) at the points.
+    CartesianPointBlock accelerations_;
+
+    //! Current gravity gradients (for unit gravitational parameter) at the points (only set if requested).
+    GravityGradientBlock gravityGradients_;
+
+    //! Dummy vector of potentials (not computed).
+    Eigen::VectorXd potentials_;
+};
+
+} // namespace gravitation
+
+} // namespace tudat
+
+#endif // TUDAT_BATCHED_SPHERICAL_HARMONICS_GRAVITY_H
@@ -0,0 +1,364 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      The (geodesy-normalized) solid harmonics are combined into the complex solid harmonics U = V + iW. Their
+ *      derivatives follow from the derivative operators D+ = d/dx + i d/dy, D- = d/dx - i d/dy and Dz = d/dz, which map
+ *      the solid harmonics of degree n and order m onto those of degree n+1 and order m+1, m-1 and m, respectively:
+ *          D+ U(n,m) = -a+(n,m) U(n+1,m+1) / R
+ *          D- U(n,m) =  a-(n,m) U(n+1,m-1) / R, for m > 0, and D- U(n,0) = -a+(n,0) conj( U(n+1,1) ) / R
+ *          Dz U(n,m) = -az(n,m) U(n+1,m) / R
+ *      The potential of a single term is GM/R Re( ( C - iS ) U ), so that its derivatives are obtained from these
+ *      expressions, using d/dx = ( D+ + D- ) / 2 and d/dy = -i( D+ - D- ) / 2.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Function to reset the maximum degree and order of the spherical harmonic expansion for which cache is to be used.
+void CartesianSphericalHarmonicsCache::resetMaximumDegreeAndOrder( const int maximumDegree, const int maximumOrder )
+{
+    maximumDegree_ = maximumDegree;
+    maximumOrder_ = std::min( maximumOrder, maximumDegree );
+    highestComputedOrder_ = maximumOrder_ + 2;
+
+    const int numberOfDegrees = maximumDegree_ + 3;
+    const int numberOfOrders = highestComputedOrder_ + 1;
+
+    cosineSolidHarmonics_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    sineSolidHarmonics_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    firstRecursionCoefficients_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    secondRecursionCoefficients_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    sectoralRecursionCoefficients_ = Eigen::ArrayXd::Zero( numberOfOrders );
+    raisingDerivativeCoefficients_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    loweringDerivativeCoefficients_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    verticalDerivativeCoefficients_ = DegreeOrderArray::Zero( numberOfDegrees, numberOfOrders );
+    cosineCoefficientBuffer_ = Eigen::RowVectorXd::Zero( maximumOrder_ + 1 );
+    sineCoefficientBuffer_ = Eigen::RowVectorXd::Zero( maximumOrder_ + 1 );
+
+    for( int degree = 0; degree < numberOfDegrees; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for( int order = 0; ( order <= degree ) && ( order < numberOfOrders ); order++ )
+        {
+            const double m = static_cast< double >( order );
+
+            // Set coefficients of column-wise recursion (for non-sectoral terms).
+            if( order < degree )
+            {
+                firstRecursionCoefficients_( degree, order ) =
+                        std::sqrt( ( 2.0 * n - 1.0 ) * ( 2.0 * n + 1.0 ) / ( ( n - m ) * ( n + m ) ) );
+                if( degree > 1 )
+                {
+                    secondRecursionCoefficients_( degree, order ) =
+                            std::sqrt( ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 ) /
+                                       ( ( 2.0 * n - 3.0 ) * ( n + m ) * ( n - m ) ) );
+                }
+            }
+
+            // Set coefficients relating derivatives to solid harmonics of next degree.
+            const double degreeRatio = ( 2.0 * n + 1.0 ) / ( 2.0 * n + 3.0 );
+            raisingDerivativeCoefficients_( degree, order ) = std::sqrt(
+                        ( order == 0 ? 0.5 : 1.0 ) * degreeRatio * ( n + m + 1.0 ) * ( n + m + 2.0 ) );
+            if( order == 0 )
+            {
+                loweringDerivativeCoefficients_( degree, order ) = raisingDerivativeCoefficients_( degree, order );
+            }
+            else
+            {
+                loweringDerivativeCoefficients_( degree, order ) = std::sqrt(
+                            ( order == 1 ? 2.0 : 1.0 ) * degreeRatio * ( n - m + 1.0 ) * ( n - m + 2.0 ) );
+            }
+            verticalDerivativeCoefficients_( degree, order ) =
+                    std::sqrt( degreeRatio * ( n - m + 1.0 ) * ( n + m + 1.0 ) );
+        }
+    }
+
+    // Set coefficients of sectoral recursion.
+    for( int order = 1; order < numberOfOrders; order++ )
+    {
+        const double m = static_cast< double >( order );
+        sectoralRecursionCoefficients_( order ) =
+                std::sqrt( ( order == 1 ? 2.0 : 1.0 ) * ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+}
+
+//! Function to update the solid spherical harmonics to the current position.
+void CartesianSphericalHarmonicsCache::update(
+        const Eigen::Vector3d& bodyFixedPosition, const double referenceRadius, const int highestDegree )
+{
+    if( highestDegree > maximumDegree_ + 2 )
+    {
+        throw std::runtime_error( "Error when updating Cartesian spherical harmonics cache, requested degree is too high." );
+    }
+
+    // Compute scaled position components.
+    const double squaredDistance = bodyFixedPosition.squaredNorm( );
+    const double scaledX = bodyFixedPosition.x( ) * referenceRadius / squaredDistance;
+    const double scaledY = bodyFixedPosition.y( ) * referenceRadius / squaredDistance;
+    const double scaledZ = bodyFixedPosition.z( ) * referenceRadius / squaredDistance;
+    const double squaredRadiusRatio = referenceRadius * referenceRadius / squaredDistance;
+
+    cosineSolidHarmonics_( 0, 0 ) = referenceRadius / std::sqrt( squaredDistance );
+    sineSolidHarmonics_( 0, 0 ) = 0.0;
+
+    for( int degree = 1; degree <= highestDegree; degree++ )
+    {
+        // Compute non-sectoral terms for all orders at once (terms of degree n-2 and order n-1 are zero).
+        const int numberOfOrders = std::min( degree, highestComputedOrder_ + 1 );
+        if( degree == 1 )
+        {
+            cosineSolidHarmonics_( 1, 0 ) = firstRecursionCoefficients_( 1, 0 ) * scaledZ * cosineSolidHarmonics_( 0, 0 );
+            sineSolidHarmonics_( 1, 0 ) = 0.0;
+        }
+        else
+        {
+            cosineSolidHarmonics_.row( degree ).head( numberOfOrders ) =
+                    scaledZ * firstRecursionCoefficients_.row( degree ).head( numberOfOrders ) *
+                    cosineSolidHarmonics_.row( degree - 1 ).head( numberOfOrders ) -
+                    squaredRadiusRatio * secondRecursionCoefficients_.row( degree ).head( numberOfOrders ) *
+                    cosineSolidHarmonics_.row( degree - 2 ).head( numberOfOrders );
+            sineSolidHarmonics_.row( degree ).head( numberOfOrders ) =
+                    scaledZ * firstRecursionCoefficients_.row( degree ).head( numberOfOrders ) *
+                    sineSolidHarmonics_.row( degree - 1 ).head( numberOfOrders ) -
+                    squaredRadiusRatio * secondRecursionCoefficients_.row( degree ).head( numberOfOrders ) *
+                    sineSolidHarmonics_.row( degree - 2 ).head( numberOfOrders );
+        }
+
+        // Compute sectoral term.
+        if( degree <= highestComputedOrder_ )
+        {
+            const double previousCosineTerm = cosineSolidHarmonics_( degree - 1, degree - 1 );
+            const double previousSineTerm = sineSolidHarmonics_( degree - 1, degree - 1 );
+            cosineSolidHarmonics_( degree, degree ) = sectoralRecursionCoefficients_( degree ) *
+                    ( scaledX * previousCosineTerm - scaledY * previousSineTerm );
+            sineSolidHarmonics_( degree, degree ) = sectoralRecursionCoefficients_( degree ) *
+                    ( scaledX * previousSineTerm + scaledY * previousCosineTerm );
+        }
+    }
+}
+
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, using a Cartesian recursion.
+Eigen::Vector3d computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianSphericalHarmonicsCache,
+        const Eigen::Matrix3d& accelerationRotation,
+        const bool computeGravityGradient,
+        Eigen::Matrix3d& gravityGradient )
+{
+    typedef CartesianSphericalHarmonicsCache::DegreeOrderArray DegreeOrderArray;
+
+    if( cosineHarmonicCoefficients.rows( ) != sineHarmonicCoefficients.rows( ) ||
+            cosineHarmonicCoefficients.cols( ) != sineHarmonicCoefficients.cols( ) )
+    {
+        throw std::runtime_error( "Error when computing Cartesian spherical harmonic acceleration, coefficient matrices "
+                                  "are of unequal size." );
+    }
+
+    // Set highest degree and order, and update solid harmonics.
+    const int highestDegree = static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1;
+    const int highestOrder = std::min( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1, highestDegree );
+    if( cartesianSphericalHarmonicsCache->getMaximumDegree( ) < highestDegree ||
+            cartesianSphericalHarmonicsCache->getMaximumOrder( ) < highestOrder )
+    {
+        cartesianSphericalHarmonicsCache->resetMaximumDegreeAndOrder(
+                    std::max( highestDegree, cartesianSphericalHarmonicsCache->getMaximumDegree( ) ),
+                    std::max( highestOrder, cartesianSphericalHarmonicsCache->getMaximumOrder( ) ) );
+    }
+    cartesianSphericalHarmonicsCache->update(
+                positionOfBodySubjectToAcceleration, equatorialRadius, highestDegree + ( computeGravityGradient ? 2 : 1 ) );
+
+    const DegreeOrderArray& cosineSolidHarmonics = cartesianSphericalHarmonicsCache->getCosineSolidHarmonics( );
+    const DegreeOrderArray& sineSolidHarmonics = cartesianSphericalHarmonicsCache->getSineSolidHarmonics( );
+    const DegreeOrderArray& raisingCoefficients = cartesianSphericalHarmonicsCache->getRaisingDerivativeCoefficients( );
+    const DegreeOrderArray& loweringCoefficients = cartesianSphericalHarmonicsCache->getLoweringDerivativeCoefficients( );
+    const DegreeOrderArray& verticalCoefficients = cartesianSphericalHarmonicsCache->getVerticalDerivativeCoefficients( );
+    Eigen::RowVectorXd& cosineCoefficients = cartesianSphericalHarmonicsCache->getCosineCoefficientBuffer( );
+    Eigen::RowVectorXd& sineCoefficients = cartesianSphericalHarmonicsCache->getSineCoefficientBuffer( );
+
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+    Eigen::Matrix3d potentialHessian = Eigen::Matrix3d::Zero( );
+    for( int degree = 0; degree <= highestDegree; degree++ )
+    {
+        // Copy coefficients of current degree to contiguous buffer.
+        const int numberOfOrders = std::min( degree, highestOrder ) + 1;
+        cosineCoefficients.head( numberOfOrders ) = cosineHarmonicCoefficients.row( degree ).head( numberOfOrders );
+        sineCoefficients.head( numberOfOrders ) = sineHarmonicCoefficients.row( degree ).head( numberOfOrders );
+
+        // Add contribution of zonal term.
+        const int nextDegree = degree + 1;
+        acceleration.x( ) -= raisingCoefficients( degree, 0 ) * cosineCoefficients( 0 ) *
+                cosineSolidHarmonics( nextDegree, 1 );
+        acceleration.y( ) -= raisingCoefficients( degree, 0 ) * cosineCoefficients( 0 ) *
+                sineSolidHarmonics( nextDegree, 1 );
+        acceleration.z( ) -= verticalCoefficients( degree, 0 ) * cosineCoefficients( 0 ) *
+                cosineSolidHarmonics( nextDegree, 0 );
+
+        // Add contribution of all tesseral and sectoral terms of current degree at once.
+        const int numberOfNonZonalOrders = numberOfOrders - 1;
+        if( numberOfNonZonalOrders > 0 )
+        {
+            const auto currentCosineCoefficients = cosineCoefficients.segment( 1, numberOfNonZonalOrders ).array( );
+            const auto currentSineCoefficients = sineCoefficients.segment( 1, numberOfNonZonalOrders ).array( );
+
+            const auto raisedCosineTerms = cosineSolidHarmonics.row( nextDegree ).segment( 2, numberOfNonZonalOrders );
+            const auto raisedSineTerms = sineSolidHarmonics.row( nextDegree ).segment( 2, numberOfNonZonalOrders );
+            const auto loweredCosineTerms = cosineSolidHarmonics.row( nextDegree ).segment( 0, numberOfNonZonalOrders );
+            const auto loweredSineTerms = sineSolidHarmonics.row( nextDegree ).segment( 0, numberOfNonZonalOrders );
+            const auto verticalCosineTerms = cosineSolidHarmonics.row( nextDegree ).segment( 1, numberOfNonZonalOrders );
+            const auto verticalSineTerms = sineSolidHarmonics.row( nextDegree ).segment( 1, numberOfNonZonalOrders );
+
+            const auto currentRaisingCoefficients = raisingCoefficients.row( degree ).segment( 1, numberOfNonZonalOrders );
+            const auto currentLoweringCoefficients = loweringCoefficients.row( degree ).segment( 1, numberOfNonZonalOrders );
+            const auto currentVerticalCoefficients = verticalCoefficients.row( degree ).segment( 1, numberOfNonZonalOrders );
+
+            acceleration.x( ) += 0.5 * (
+                        currentLoweringCoefficients * ( currentCosineCoefficients * loweredCosineTerms +
+                                                        currentSineCoefficients * loweredSineTerms ) -
+                        currentRaisingCoefficients * ( currentCosineCoefficients * raisedCosineTerms +
+                                                       currentSineCoefficients * raisedSineTerms ) ).sum( );
+            acceleration.y( ) -= 0.5 * (
+                        currentLoweringCoefficients * ( currentCosineCoefficients * loweredSineTerms -
+                                                        currentSineCoefficients * loweredCosineTerms ) +
+                        currentRaisingCoefficients * ( currentCosineCoefficients * raisedSineTerms -
+                                                       currentSineCoefficients * raisedCosineTerms ) ).sum( );
+            acceleration.z( ) -= ( currentVerticalCoefficients * ( currentCosineCoefficients * verticalCosineTerms +
+                                                                   currentSineCoefficients * verticalSineTerms ) ).sum( );
+        }
+
+        // Add contribution of current degree to second derivatives of potential.
+        if( computeGravityGradient )
+        {
+            const int secondDegree = degree + 2;
+            for( int order = 0; order < numberOfOrders; order++ )
+            {
+                const double cosineCoefficient = cosineCoefficients( order );
+                const double sineCoefficient = sineCoefficients( order );
+
+                // Real and imaginary parts of ( C - iS ) U(n+2,k), and of ( C - iS ) conj( U(n+2,k) ).
+                auto getRealTerm = [ & ]( const int k ){
+                    return cosineCoefficient * cosineSolidHarmonics( secondDegree, k ) +
+                            sineCoefficient * sineSolidHarmonics( secondDegree, k ); };
+                auto getImaginaryTerm = [ & ]( const int k ){
+                    return cosineCoefficient * sineSolidHarmonics( secondDegree, k ) -
+                            sineCoefficient * cosineSolidHarmonics( secondDegree, k ); };
+                auto getConjugateRealTerm = [ & ]( const int k ){
+                    return cosineCoefficient * cosineSolidHarmonics( secondDegree, k ) -
+                            sineCoefficient * sineSolidHarmonics( secondDegree, k ); };
+                auto getConjugateImaginaryTerm = [ & ]( const int k ){
+                    return -cosineCoefficient * sineSolidHarmonics( secondDegree, k ) -
+                            sineCoefficient * cosineSolidHarmonics( secondDegree, k ); };
+
+                // D+ D+
+                double factor = raisingCoefficients( degree, order ) * raisingCoefficients( nextDegree, order + 1 );
+                const double realRaisingRaising = factor * getRealTerm( order + 2 );
+                const double imaginaryRaisingRaising = factor * getImaginaryTerm( order + 2 );
+
+                // D+ D- (equal to -Dz Dz)
+                const double realVerticalVertical = verticalCoefficients( degree, order ) *
+                        verticalCoefficients( nextDegree, order ) * getRealTerm( order );
+
+                // D- D-
+                double realLoweringLowering, imaginaryLoweringLowering;
+                if( order >= 2 )
+                {
+                    factor = loweringCoefficients( degree, order ) * loweringCoefficients( nextDegree, order - 1 );
+                    realLoweringLowering = factor * getRealTerm( order - 2 );
+                    imaginaryLoweringLowering = factor * getImaginaryTerm( order - 2 );
+                }
+                else if( order == 1 )
+                {
+                    factor = -loweringCoefficients( degree, 1 ) * raisingCoefficients( nextDegree, 0 );
+                    realLoweringLowering = factor * getConjugateRealTerm( 1 );
+                    imaginaryLoweringLowering = factor * getConjugateImaginaryTerm( 1 );
+                }
+                else
+                {
+                    factor = raisingCoefficients( degree, 0 ) * raisingCoefficients( nextDegree, 1 );
+                    realLoweringLowering = factor * getConjugateRealTerm( 2 );
+                    imaginaryLoweringLowering = factor * getConjugateImaginaryTerm( 2 );
+                }
+
+                // Dz D+
+                factor = raisingCoefficients( degree, order ) * verticalCoefficients( nextDegree, order + 1 );
+                const double realVerticalRaising = factor * getRealTerm( order + 1 );
+                const double imaginaryVerticalRaising = factor * getImaginaryTerm( order + 1 );
+
+                // Dz D-
+                double realVerticalLowering, imaginaryVerticalLowering;
+                if( order >= 1 )
+                {
+                    factor = -loweringCoefficients( degree, order ) * verticalCoefficients( nextDegree, order - 1 );
+                    realVerticalLowering = factor * getRealTerm( order - 1 );
+                    imaginaryVerticalLowering = factor * getImaginaryTerm( order - 1 );
+                }
+                else
+                {
+                    factor = raisingCoefficients( degree, 0 ) * verticalCoefficients( nextDegree, 1 );
+                    realVerticalLowering = factor * getConjugateRealTerm( 1 );
+                    imaginaryVerticalLowering = factor * getConjugateImaginaryTerm( 1 );
+                }
+
+                potentialHessian( 0, 0 ) += 0.25 * ( realRaisingRaising - 2.0 * realVerticalVertical + realLoweringLowering );
+                potentialHessian( 1, 1 ) -= 0.25 * ( realRaisingRaising + 2.0 * realVerticalVertical + realLoweringLowering );
+                potentialHessian( 2, 2 ) += realVerticalVertical;
+                potentialHessian( 0, 1 ) += 0.25 * ( imaginaryRaisingRaising - imaginaryLoweringLowering );
+                potentialHessian( 0, 2 ) += 0.5 * ( realVerticalRaising + realVerticalLowering );
+                potentialHessian( 1, 2 ) += 0.5 * ( imaginaryVerticalRaising - imaginaryVerticalLowering );
+            }
+        }
+    }
+
+    // Scale and rotate gravity gradient.
+    if( computeGravityGradient )
+    {
+        potentialHessian( 1, 0 ) = potentialHessian( 0, 1 );
+        potentialHessian( 2, 0 ) = potentialHessian( 0, 2 );
+        potentialHessian( 2, 1 ) = potentialHessian( 1, 2 );
+        gravityGradient = gravitationalParameter / ( equatorialRadius * equatorialRadius * equatorialRadius ) *
+                accelerationRotation * potentialHessian * accelerationRotation.transpose( );
+    }
+
+    return gravitationalParameter / ( equatorialRadius * equatorialRadius ) * ( accelerationRotation * acceleration );
+}
+
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, using a Cartesian recursion.
+Eigen::Vector3d computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianSphericalHarmonicsCache,
+        const Eigen::Matrix3d& accelerationRotation )
+{
+    Eigen::Matrix3d dummyGravityGradient;
+    return computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                positionOfBodySubjectToAcceleration, gravitationalParameter, equatorialRadius,
+                cosineHarmonicCoefficients, sineHarmonicCoefficients, cartesianSphericalHarmonicsCache,
+                accelerationRotation, false, dummyGravityGradient );
+}
+
+} // namespace gravitation
+
+} // namespace tudat
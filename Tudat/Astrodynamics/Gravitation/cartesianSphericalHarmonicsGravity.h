@@ -0,0 +1,254 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Cunningham, L.E. On the computation of the spherical harmonic terms needed during the numerical integration of
+ *          the orbital motion of an artificial satellite. Celestial Mechanics, 2, 207-216, 1970.
+ *      Montenbruck, O., Gill, E. Satellite Orbits. Springer, 2000.
+ *
+ */
+
+#ifndef TUDAT_CARTESIAN_SPHERICAL_HARMONICS_GRAVITY_H
+#define TUDAT_CARTESIAN_SPHERICAL_HARMONICS_GRAVITY_H
+
+#include <memory>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Cache object for the Cartesian (Cunningham) recursion of geodesy-normalized solid spherical harmonics.
+/*!
+ *  Cache object for the Cartesian (Cunningham) recursion of geodesy-normalized solid spherical harmonics
+ *  \f$ \bar{V}_{n,m}+i\bar{W}_{n,m}=(R/r)^{n+1}\bar{P}_{n,m}(\sin\phi)\exp(im\lambda) \f$, which are computed directly
+ *  from the Cartesian position, without any trigonometric functions and without singularities at the poles. The
+ *  solid harmonics of each degree are stored contiguously per order, and the recursion (as well as the summation of
+ *  the acceleration) is evaluated for all orders of a degree at once. The recursion coefficients, and the coefficients
+ *  relating the derivatives of the solid harmonics to those of the next degree, are precomputed when the maximum degree
+ *  and order are (re)set. The solid harmonics are computed up to two degrees and orders above the maximum degree and
+ *  order of the expansion, as required for the acceleration and the gravity gradient, respectively.
+ */
+class CartesianSphericalHarmonicsCache
+{
+public:
+
+    //! Typedef for row-major array, in which rows denote degree and columns denote order.
+    typedef Eigen::Array< double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > DegreeOrderArray;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param maximumDegree Maximum degree of spherical harmonic expansion for which cache is to be used.
+     *  \param maximumOrder Maximum order of spherical harmonic expansion for which cache is to be used.
+     */
+    CartesianSphericalHarmonicsCache( const int maximumDegree = 0, const int maximumOrder = 0 )
+    {
+        resetMaximumDegreeAndOrder( maximumDegree, maximumOrder );
+    }
+
+    //! Function to reset the maximum degree and order of the spherical harmonic expansion for which cache is to be used.
+    /*!
+     *  Function to reset the maximum degree and order of the spherical harmonic expansion for which cache is to be used,
+     *  recomputing the recursion coefficients.
+     *  \param maximumDegree Maximum degree of spherical harmonic expansion for which cache is to be used.
+     *  \param maximumOrder Maximum order of spherical harmonic expansion for which cache is to be used.
+     */
+    void resetMaximumDegreeAndOrder( const int maximumDegree, const int maximumOrder );
+
+    //! Function to update the solid spherical harmonics to the current position.
+    /*!
+     *  Function to update the solid spherical harmonics to the current position, up to the given degree (which may not
+     *  exceed the maximum degree plus two).
+     *  \param bodyFixedPosition Position at which solid harmonics are to be computed, in frame fixed to the body for
+     *  which the spherical harmonic expansion is defined.
+     *  \param referenceRadius Reference radius of the spherical harmonic expansion.
+     *  \param highestDegree Degree up to which solid harmonics are to be computed.
+     */
+    void update( const Eigen::Vector3d& bodyFixedPosition, const double referenceRadius, const int highestDegree );
+
+    //! Function to retrieve the maximum degree of the spherical harmonic expansion for which cache is to be used.
+    int getMaximumDegree( )
+    {
+        return maximumDegree_;
+    }
+
+    //! Function to retrieve the maximum order of the spherical harmonic expansion for which cache is to be used.
+    int getMaximumOrder( )
+    {
+        return maximumOrder_;
+    }
+
+    //! Function to retrieve the current cosine solid harmonics \f$ \bar{V}_{n,m} \f$ (rows: degree, columns: order)
+    const DegreeOrderArray& getCosineSolidHarmonics( )
+    {
+        return cosineSolidHarmonics_;
+    }
+
+    //! Function to retrieve the current sine solid harmonics \f$ \bar{W}_{n,m} \f$ (rows: degree, columns: order)
+    const DegreeOrderArray& getSineSolidHarmonics( )
+    {
+        return sineSolidHarmonics_;
+    }
+
+    //! Function to retrieve the coefficients of degree n-1 solid harmonics in recursion for degree n (same order).
+    const DegreeOrderArray& getFirstRecursionCoefficients( )
+    {
+        return firstRecursionCoefficients_;
+    }
+
+    //! Function to retrieve the coefficients of degree n-2 solid harmonics in recursion for degree n (same order).
+    const DegreeOrderArray& getSecondRecursionCoefficients( )
+    {
+        return secondRecursionCoefficients_;
+    }
+
+    //! Function to retrieve the coefficients of degree n-1 solid harmonics in recursion for sectoral harmonics of degree n.
+    const Eigen::ArrayXd& getSectoralRecursionCoefficients( )
+    {
+        return sectoralRecursionCoefficients_;
+    }
+
+    //! Function to retrieve the coefficients relating (x+iy)-derivatives to solid harmonics of order m+1 at degree n+1.
+    const DegreeOrderArray& getRaisingDerivativeCoefficients( )
+    {
+        return raisingDerivativeCoefficients_;
+    }
+
+    //! Function to retrieve the coefficients relating (x-iy)-derivatives to solid harmonics of order m-1 at degree n+1.
+    const DegreeOrderArray& getLoweringDerivativeCoefficients( )
+    {
+        return loweringDerivativeCoefficients_;
+    }
+
+    //! Function to retrieve the coefficients relating z-derivatives to solid harmonics of order m at degree n+1.
+    const DegreeOrderArray& getVerticalDerivativeCoefficients( )
+    {
+        return verticalDerivativeCoefficients_;
+    }
+
+    //! Function to retrieve pre-allocated buffer for the cosine coefficients of a single degree (stored contiguously).
+    Eigen::RowVectorXd& getCosineCoefficientBuffer( )
+    {
+        return cosineCoefficientBuffer_;
+    }
+
+    //! Function to retrieve pre-allocated buffer for the sine coefficients of a single degree (stored contiguously).
+    Eigen::RowVectorXd& getSineCoefficientBuffer( )
+    {
+        return sineCoefficientBuffer_;
+    }
+
+private:
+
+    //! Maximum degree of the spherical harmonic expansion for which cache is to be used.
+    int maximumDegree_;
+
+    //! Maximum order of the spherical harmonic expansion for which cache is to be used.
+    int maximumOrder_;
+
+    //! Highest order for which the solid harmonics are computed (maximum order plus two).
+    int highestComputedOrder_;
+
+    //! Current cosine solid harmonics (rows: degree, columns: order)
+    DegreeOrderArray cosineSolidHarmonics_;
+
+    //! Current sine solid harmonics (rows: degree, columns: order)
+    DegreeOrderArray sineSolidHarmonics_;
+
+    //! Coefficients of degree n-1 solid harmonics in recursion for degree n (same order).
+    DegreeOrderArray firstRecursionCoefficients_;
+
+    //! Coefficients of degree n-2 solid harmonics in recursion for degree n (same order).
+    DegreeOrderArray secondRecursionCoefficients_;
+
+    //! Coefficients of degree n-1 solid harmonics in recursion for sectoral solid harmonics of degree n.
+    Eigen::ArrayXd sectoralRecursionCoefficients_;
+
+    //! Coefficients relating (x+iy)-derivatives to solid harmonics of order m+1 at degree n+1.
+    DegreeOrderArray raisingDerivativeCoefficients_;
+
+    //! Coefficients relating (x-iy)-derivatives to solid harmonics of order m-1 at degree n+1.
+    DegreeOrderArray loweringDerivativeCoefficients_;
+
+    //! Coefficients relating z-derivatives to solid harmonics of order m at degree n+1.
+    DegreeOrderArray verticalDerivativeCoefficients_;
+
+    //! Pre-allocated buffer for the cosine coefficients of a single degree.
+    Eigen::RowVectorXd cosineCoefficientBuffer_;
+
+    //! Pre-allocated buffer for the sine coefficients of a single degree.
+    Eigen::RowVectorXd sineCoefficientBuffer_;
+};
+
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, using a Cartesian recursion.
+/*!
+ *  Compute gravitational acceleration due to multiple spherical harmonics terms, defined using geodesy-normalization
+ *  (see computeGeodesyNormalizedGravitationalAccelerationSum), using the Cartesian recursion of Cunningham (1970), in its
+ *  geodesy-normalized form. In contrast to the formulation in spherical coordinates, no trigonometric functions are
+ *  evaluated, and the formulation is free of singularities at the poles. The terms of all orders of a single degree are
+ *  evaluated at once. The gravity gradient (second derivative of the potential) may be computed in the same pass.
+ *  \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the reference frame that is
+ *  associated with the harmonic coefficients.
+ *  \param gravitationalParameter Gravitational parameter associated with the spherical harmonics.
+ *  \param equatorialRadius Reference radius of the spherical harmonics.
+ *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+ *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+ *  \param cartesianSphericalHarmonicsCache Cache object for the solid spherical harmonics (its maximum degree and order
+ *  are increased if they are insufficient for the coefficients that are provided).
+ *  \param accelerationRotation Rotation matrix from frame associated with the harmonic coefficients to frame in which
+ *  acceleration (and gravity gradient) is to be returned.
+ *  \param computeGravityGradient Boolean denoting whether the gravity gradient is to be computed.
+ *  \param gravityGradient Gravity gradient, in frame defined by accelerationRotation (returned by reference, only set if
+ *  computeGravityGradient is true).
+ *  \return Cartesian acceleration vector resulting from the summation of all harmonic terms.
+ */
+Eigen::Vector3d computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianSphericalHarmonicsCache,
+        const Eigen::Matrix3d& accelerationRotation,
+        const bool computeGravityGradient,
+        Eigen::Matrix3d& gravityGradient );
+
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, using a Cartesian recursion.
+/*!
+ *  Compute gravitational acceleration due to multiple spherical harmonics terms, defined using geodesy-normalization,
+ *  using the Cartesian recursion of Cunningham (1970), without computing the gravity gradient.
+ *  \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the reference frame that is
+ *  associated with the harmonic coefficients.
+ *  \param gravitationalParameter Gravitational parameter associated with the spherical harmonics.
+ *  \param equatorialRadius Reference radius of the spherical harmonics.
+ *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+ *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+ *  \param cartesianSphericalHarmonicsCache Cache object for the solid spherical harmonics.
+ *  \param accelerationRotation Rotation matrix from frame associated with the harmonic coefficients to frame in which
+ *  acceleration is to be returned.
+ *  \return Cartesian acceleration vector resulting from the summation of all harmonic terms.
+ */
+Eigen::Vector3d computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianSphericalHarmonicsCache,
+        const Eigen::Matrix3d& accelerationRotation = Eigen::Matrix3d::Identity( ) );
+
+} // namespace gravitation
+
+} // namespace tudat
+
+#endif // TUDAT_CARTESIAN_SPHERICAL_HARMONICS_GRAVITY_H
@@ -0,0 +1,495 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/griddedSphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Identifier at the start of a spherical harmonic acceleration grid file.
+static const char accelerationGridFileIdentifier[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'S', 'A', 'G' };
+
+//! Version of the spherical harmonic acceleration grid file format.
+static const std::uint32_t accelerationGridFileVersion = 1;
+
+//! Byte order mark of a grid file (used to detect files written on a machine of different endianness).
+static const std::uint32_t accelerationGridFileByteOrderMark = 0x01020304;
+
+//! Size of the header of a spherical harmonic acceleration grid file, in bytes.
+static const std::size_t accelerationGridFileHeaderSize = 128;
+
+//! Byte offsets of the entries in the header of a spherical harmonic acceleration grid file.
+enum AccelerationGridFileHeaderOffsets
+{
+    grid_version_offset = 8,
+    grid_byte_order_mark_offset = 12,
+    grid_number_of_radii_offset = 16,
+    grid_number_of_latitudes_offset = 20,
+    grid_number_of_longitudes_offset = 24,
+    grid_maximum_degree_offset = 28,
+    grid_maximum_order_offset = 32,
+    grid_minimum_radius_offset = 40,
+    grid_maximum_radius_offset = 48,
+    grid_reference_radius_offset = 56,
+    grid_gravitational_parameter_offset = 64,
+    grid_interpolation_error_offset = 72
+};
+
+//! Function to compute the weights of cubic Lagrange interpolation on four equidistant nodes.
+/*!
+ *  Function to compute the weights of cubic Lagrange interpolation on four equidistant nodes (at 0, 1, 2 and 3).
+ *  \param nodeDistance Distance of the interpolation point from the first node, in units of the node spacing.
+ *  \param weights Weights of the four nodes (returned by reference).
+ */
+static inline void computeCubicLagrangeWeights( const double nodeDistance, double weights[ 4 ] )
+{
+    const double distanceFromSecondNode = nodeDistance - 1.0;
+    const double distanceFromThirdNode = nodeDistance - 2.0;
+    const double distanceFromFourthNode = nodeDistance - 3.0;
+    weights[ 0 ] = -distanceFromSecondNode * distanceFromThirdNode * distanceFromFourthNode / 6.0;
+    weights[ 1 ] = nodeDistance * distanceFromThirdNode * distanceFromFourthNode / 2.0;
+    weights[ 2 ] = -nodeDistance * distanceFromSecondNode * distanceFromFourthNode / 2.0;
+    weights[ 3 ] = nodeDistance * distanceFromSecondNode * distanceFromThirdNode / 6.0;
+}
+
+//! Function to compute the first node of the interpolation stencil on a non-periodic axis of the grid.
+/*!
+ *  Function to compute the first node of the four-node interpolation stencil on a non-periodic axis of the grid, such
+ *  that the interpolation point lies between the second and third node (shifted inward at the boundaries).
+ *  \param nodeIndex (Non-integer) index of the interpolation point on the axis.
+ *  \param numberOfNodes Number of nodes on the axis.
+ *  \return Index of the first node of the stencil.
+ */
+static inline int getFirstStencilNode( const double nodeIndex, const int numberOfNodes )
+{
+    return std::min( std::max( static_cast< int >( std::floor( nodeIndex ) ) - 1, 0 ), numberOfNodes - 4 );
+}
+
+//! Constructor, computes the grid from a set of spherical harmonic coefficients.
+SphericalHarmonicsAccelerationGrid::SphericalHarmonicsAccelerationGrid(
+        const double gravitationalParameter,
+        const double referenceRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const double minimumRadius,
+        const double maximumRadius,
+        const int numberOfRadii,
+        const int numberOfLatitudes,
+        const int numberOfLongitudes,
+        const unsigned int numberOfThreads,
+        const int numberOfErrorTestPoints ):
+    gridData_( nullptr ), gravitationalParameter_( gravitationalParameter ), referenceRadius_( referenceRadius ),
+    maximumDegree_( static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1 ),
+    maximumOrder_( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1 ),
+    minimumRadius_( minimumRadius ), maximumRadius_( maximumRadius ),
+    numberOfRadii_( numberOfRadii ), numberOfLatitudes_( numberOfLatitudes ), numberOfLongitudes_( numberOfLongitudes )
+{
+    setGridSpacing( );
+    computeGrid( cosineHarmonicCoefficients, sineHarmonicCoefficients, numberOfThreads, numberOfErrorTestPoints );
+}
+
+//! Constructor, computes the grid from a spherical harmonic gravity field.
+SphericalHarmonicsAccelerationGrid::SphericalHarmonicsAccelerationGrid(
+        const std::shared_ptr< SphericalHarmonicsGravityField > gravityField,
+        const int maximumDegree,
+        const int maximumOrder,
+        const double minimumRadius,
+        const double maximumRadius,
+        const int numberOfRadii,
+        const int numberOfLatitudes,
+        const int numberOfLongitudes,
+        const unsigned int numberOfThreads,
+        const int numberOfErrorTestPoints ):
+    SphericalHarmonicsAccelerationGrid(
+        gravityField->getGravitationalParameter( ), gravityField->getReferenceRadius( ),
+        gravityField->getCosineCoefficientsBlock( maximumDegree, maximumOrder ),
+        gravityField->getSineCoefficientsBlock( maximumDegree, maximumOrder ),
+        minimumRadius, maximumRadius, numberOfRadii, numberOfLatitudes, numberOfLongitudes,
+        numberOfThreads, numberOfErrorTestPoints )
+{ }
+
+//! Constructor, maps a grid file (written by writeToFile) into memory.
+SphericalHarmonicsAccelerationGrid::SphericalHarmonicsAccelerationGrid( const std::string& fileName ):
+    fileName_( fileName ), gridData_( nullptr )
+{
+    try
+    {
+        mappedFile_.open( fileName_ );
+    }
+    catch( std::exception& caughtException )
+    {
+        throw std::runtime_error( "Error when loading spherical harmonic acceleration grid, could not map file " +
+                                  fileName_ + ": " + caughtException.what( ) );
+    }
+
+    // Check and read header.
+    const char* fileData = mappedFile_.data( );
+    if( mappedFile_.size( ) < accelerationGridFileHeaderSize ||
+            std::memcmp( fileData, accelerationGridFileIdentifier, sizeof( accelerationGridFileIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when loading spherical harmonic acceleration grid, " + fileName_ +
+                                  " is not an acceleration grid file." );
+    }
+
+    std::uint32_t version, byteOrderMark;
+    std::memcpy( &version, fileData + grid_version_offset, sizeof( std::uint32_t ) );
+    std::memcpy( &byteOrderMark, fileData + grid_byte_order_mark_offset, sizeof( std::uint32_t ) );
+    if( byteOrderMark != accelerationGridFileByteOrderMark )
+    {
+        throw std::runtime_error( "Error when loading spherical harmonic acceleration grid " + fileName_ +
+                                  ", file was written with a different byte order." );
+    }
+    else if( version != accelerationGridFileVersion )
+    {
+        throw std::runtime_error( "Error when loading spherical harmonic acceleration grid " + fileName_ +
+                                  ", format version " + std::to_string( version ) + " is not supported." );
+    }
+
+    std::int32_t numberOfRadii, numberOfLatitudes, numberOfLongitudes, maximumDegree, maximumOrder;
+    std::memcpy( &numberOfRadii, fileData + grid_number_of_radii_offset, sizeof( std::int32_t ) );
+    std::memcpy( &numberOfLatitudes, fileData + grid_number_of_latitudes_offset, sizeof( std::int32_t ) );
+    std::memcpy( &numberOfLongitudes, fileData + grid_number_of_longitudes_offset, sizeof( std::int32_t ) );
+    std::memcpy( &maximumDegree, fileData + grid_maximum_degree_offset, sizeof( std::int32_t ) );
+    std::memcpy( &maximumOrder, fileData + grid_maximum_order_offset, sizeof( std::int32_t ) );
+    std::memcpy( &minimumRadius_, fileData + grid_minimum_radius_offset, sizeof( double ) );
+    std::memcpy( &maximumRadius_, fileData + grid_maximum_radius_offset, sizeof( double ) );
+    std::memcpy( &referenceRadius_, fileData + grid_reference_radius_offset, sizeof( double ) );
+    std::memcpy( &gravitationalParameter_, fileData + grid_gravitational_parameter_offset, sizeof( double ) );
+    std::memcpy( &maximumInterpolationErrorPerUnitGravitationalParameter_,
+                 fileData + grid_interpolation_error_offset, sizeof( double ) );
+    numberOfRadii_ = numberOfRadii;
+    numberOfLatitudes_ = numberOfLatitudes;
+    numberOfLongitudes_ = numberOfLongitudes;
+    maximumDegree_ = maximumDegree;
+    maximumOrder_ = maximumOrder;
+
+    setGridSpacing( );
+    if( mappedFile_.size( ) != accelerationGridFileHeaderSize + 3 * sizeof( double ) *
+            static_cast< std::size_t >( numberOfRadii_ ) * numberOfLatitudes_ * numberOfLongitudes_ )
+    {
+        throw std::runtime_error( "Error when loading spherical harmonic acceleration grid " + fileName_ +
+                                  ", file size is inconsistent with grid dimensions." );
+    }
+
+    gridData_ = reinterpret_cast< const double* >( fileData + accelerationGridFileHeaderSize );
+}
+
+//! Destructor, unmaps the grid file (if any).
+SphericalHarmonicsAccelerationGrid::~SphericalHarmonicsAccelerationGrid( )
+{
+    if( mappedFile_.is_open( ) )
+    {
+        mappedFile_.close( );
+    }
+}
+
+//! Function to write the grid to a binary file.
+void SphericalHarmonicsAccelerationGrid::writeToFile( const std::string& fileName ) const
+{
+    if( fileName == fileName_ )
+    {
+        throw std::runtime_error( "Error when writing spherical harmonic acceleration grid, cannot overwrite file " +
+                                  fileName + " from which grid is loaded." );
+    }
+
+    // Set header.
+    const std::int32_t numberOfRadii = numberOfRadii_;
+    const std::int32_t numberOfLatitudes = numberOfLatitudes_;
+    const std::int32_t numberOfLongitudes = numberOfLongitudes_;
+    const std::int32_t maximumDegree = maximumDegree_;
+    const std::int32_t maximumOrder = maximumOrder_;
+
+    char header[ accelerationGridFileHeaderSize ];
+    std::memset( header, 0, accelerationGridFileHeaderSize );
+    std::memcpy( header, accelerationGridFileIdentifier, sizeof( accelerationGridFileIdentifier ) );
+    std::memcpy( header + grid_version_offset, &accelerationGridFileVersion, sizeof( std::uint32_t ) );
+    std::memcpy( header + grid_byte_order_mark_offset, &accelerationGridFileByteOrderMark, sizeof( std::uint32_t ) );
+    std::memcpy( header + grid_number_of_radii_offset, &numberOfRadii, sizeof( std::int32_t ) );
+    std::memcpy( header + grid_number_of_latitudes_offset, &numberOfLatitudes, sizeof( std::int32_t ) );
+    std::memcpy( header + grid_number_of_longitudes_offset, &numberOfLongitudes, sizeof( std::int32_t ) );
+    std::memcpy( header + grid_maximum_degree_offset, &maximumDegree, sizeof( std::int32_t ) );
+    std::memcpy( header + grid_maximum_order_offset, &maximumOrder, sizeof( std::int32_t ) );
+    std::memcpy( header + grid_minimum_radius_offset, &minimumRadius_, sizeof( double ) );
+    std::memcpy( header + grid_maximum_radius_offset, &maximumRadius_, sizeof( double ) );
+    std::memcpy( header + grid_reference_radius_offset, &referenceRadius_, sizeof( double ) );
+    std::memcpy( header + grid_gravitational_parameter_offset, &gravitationalParameter_, sizeof( double ) );
+    std::memcpy( header + grid_interpolation_error_offset,
+                 &maximumInterpolationErrorPerUnitGravitationalParameter_, sizeof( double ) );
+
+    std::ofstream fileStream( fileName.c_str( ), std::ios::binary | std::ios::trunc );
+    if( !fileStream.is_open( ) )
+    {
+        throw std::runtime_error( "Error when writing spherical harmonic acceleration grid, could not open file " +
+                                  fileName );
+    }
+    fileStream.write( header, accelerationGridFileHeaderSize );
+    fileStream.write( reinterpret_cast< const char* >( gridData_ ), 3 * sizeof( double ) *
+                      static_cast< std::size_t >( numberOfRadii_ ) * numberOfLatitudes_ * numberOfLongitudes_ );
+
+    if( !fileStream.good( ) )
+    {
+        fileStream.close( );
+        std::remove( fileName.c_str( ) );
+        throw std::runtime_error( "Error when writing spherical harmonic acceleration grid, could not write file " +
+                                  fileName );
+    }
+}
+
+//! Function to interpolate the non-central acceleration per unit gravitational parameter.
+Eigen::Vector3d SphericalHarmonicsAccelerationGrid::interpolateNonCentralAcceleration(
+        const Eigen::Vector3d& bodyFixedPosition ) const
+{
+    const double radius = bodyFixedPosition.norm( );
+    if( !( radius >= minimumRadius_ && radius <= maximumRadius_ ) )
+    {
+        throw std::runtime_error( "Error when interpolating spherical harmonic acceleration grid, radius " +
+                                  std::to_string( radius ) + " is outside of grid (" +
+                                  std::to_string( minimumRadius_ ) + " to " + std::to_string( maximumRadius_ ) + ")." );
+    }
+
+    // Compute (non-integer) indices of the position on the three axes of the grid.
+    const double latitude = std::atan2( bodyFixedPosition.z( ),
+                                        std::sqrt( bodyFixedPosition.x( ) * bodyFixedPosition.x( ) +
+                                                   bodyFixedPosition.y( ) * bodyFixedPosition.y( ) ) );
+    double longitude = std::atan2( bodyFixedPosition.y( ), bodyFixedPosition.x( ) );
+    if( longitude < 0.0 )
+    {
+        longitude += 2.0 * mathematical_constants::PI;
+    }
+
+    const double radiusIndex = ( radius - minimumRadius_ ) / radiusStep_;
+    const double latitudeIndex = ( latitude + 0.5 * mathematical_constants::PI ) / latitudeStep_;
+    const double longitudeIndex = longitude / longitudeStep_;
+
+    // Set interpolation stencils (longitude stencil wraps around the periodic axis).
+    const int firstRadius = getFirstStencilNode( radiusIndex, numberOfRadii_ );
+    const int firstLatitude = getFirstStencilNode( latitudeIndex, numberOfLatitudes_ );
+    const int firstLongitude = static_cast< int >( std::floor( longitudeIndex ) ) - 1;
+
+    double radiusWeights[ 4 ], latitudeWeights[ 4 ], longitudeWeights[ 4 ];
+    computeCubicLagrangeWeights( radiusIndex - firstRadius, radiusWeights );
+    computeCubicLagrangeWeights( latitudeIndex - firstLatitude, latitudeWeights );
+    computeCubicLagrangeWeights( longitudeIndex - firstLongitude, longitudeWeights );
+
+    // Sum contributions of the 4 x 4 lines of 4 consecutive radial nodes.
+    double acceleration[ 3 ] = { 0.0, 0.0, 0.0 };
+    for( int i = 0; i < 4; i++ )
+    {
+        const long long latitudeOffset = static_cast< long long >( firstLatitude + i ) * numberOfLongitudes_;
+        double latitudeAcceleration[ 3 ] = { 0.0, 0.0, 0.0 };
+        for( int j = 0; j < 4; j++ )
+        {
+            int currentLongitude = firstLongitude + j;
+            if( currentLongitude < 0 )
+            {
+                currentLongitude += numberOfLongitudes_;
+            }
+            else if( currentLongitude >= numberOfLongitudes_ )
+            {
+                currentLongitude -= numberOfLongitudes_;
+            }
+
+            const double* radialNodes = gridData_ + 3 * ( ( latitudeOffset + currentLongitude ) * numberOfRadii_ +
+                                                          firstRadius );
+            for( int k = 0; k < 3; k++ )
+            {
+                latitudeAcceleration[ k ] += longitudeWeights[ j ] * (
+                            radiusWeights[ 0 ] * radialNodes[ k ] + radiusWeights[ 1 ] * radialNodes[ 3 + k ] +
+                            radiusWeights[ 2 ] * radialNodes[ 6 + k ] + radiusWeights[ 3 ] * radialNodes[ 9 + k ] );
+            }
+        }
+
+        for( int k = 0; k < 3; k++ )
+        {
+            acceleration[ k ] += latitudeWeights[ i ] * latitudeAcceleration[ k ];
+        }
+    }
+
+    return Eigen::Vector3d( acceleration[ 0 ], acceleration[ 1 ], acceleration[ 2 ] );
+}
+
+//! Function to check the dimensions of the grid and set the grid spacings.
+void SphericalHarmonicsAccelerationGrid::setGridSpacing( )
+{
+    if( numberOfRadii_ < 4 || numberOfLatitudes_ < 4 || numberOfLongitudes_ < 4 )
+    {
+        throw std::runtime_error( "Error in spherical harmonic acceleration grid, at least 4 nodes are required in "
+                                  "radius, latitude and longitude, found " + std::to_string( numberOfRadii_ ) + ", " +
+                                  std::to_string( numberOfLatitudes_ ) + " and " +
+                                  std::to_string( numberOfLongitudes_ ) + "." );
+    }
+    else if( !( minimumRadius_ > 0.0 && maximumRadius_ > minimumRadius_ ) )
+    {
+        throw std::runtime_error( "Error in spherical harmonic acceleration grid, radii of shell (" +
+                                  std::to_string( minimumRadius_ ) + " to " + std::to_string( maximumRadius_ ) +
+                                  ") are inconsistent." );
+    }
+
+    radiusStep_ = ( maximumRadius_ - minimumRadius_ ) / static_cast< double >( numberOfRadii_ - 1 );
+    latitudeStep_ = mathematical_constants::PI / static_cast< double >( numberOfLatitudes_ - 1 );
+    longitudeStep_ = 2.0 * mathematical_constants::PI / static_cast< double >( numberOfLongitudes_ );
+}
+
+//! Function to compute the values of the grid from a set of spherical harmonic coefficients.
+void SphericalHarmonicsAccelerationGrid::computeGrid(
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const unsigned int numberOfThreads,
+        const int numberOfErrorTestPoints )
+{
+    if( cosineHarmonicCoefficients.rows( ) != sineHarmonicCoefficients.rows( ) ||
+            cosineHarmonicCoefficients.cols( ) != sineHarmonicCoefficients.cols( ) ||
+            cosineHarmonicCoefficients.rows( ) == 0 || cosineHarmonicCoefficients.cols( ) == 0 )
+    {
+        throw std::runtime_error( "Error when computing spherical harmonic acceleration grid, cosine and sine "
+                                  "coefficients are inconsistent." );
+    }
+
+    // Remove central term, which is computed analytically by the acceleration model.
+    Eigen::MatrixXd nonCentralCosineCoefficients = cosineHarmonicCoefficients;
+    nonCentralCosineCoefficients( 0, 0 ) = 0.0;
+    BatchedSphericalHarmonicsGravityEvaluator gravityEvaluator(
+                referenceRadius_, nonCentralCosineCoefficients, sineHarmonicCoefficients, numberOfThreads );
+
+    // Compute grid values per latitude, for all longitudes and radii at once.
+    const int nodesPerLatitude = numberOfLongitudes_ * numberOfRadii_;
+    gridValues_.resize( 3 * static_cast< std::size_t >( nodesPerLatitude ) * numberOfLatitudes_ );
+
+    CartesianPointBlock nodePositions( nodesPerLatitude, 3 );
+    CartesianPointBlock nodeAccelerations;
+    for( int i = 0; i < numberOfLatitudes_; i++ )
+    {
+        const double latitude = ( i == numberOfLatitudes_ - 1 ) ?
+                    0.5 * mathematical_constants::PI : -0.5 * mathematical_constants::PI + i * latitudeStep_;
+        for( int j = 0; j < numberOfLongitudes_; j++ )
+        {
+            const double longitude = j * longitudeStep_;
+            const Eigen::Vector3d unitPosition(
+                        std::cos( latitude ) * std::cos( longitude ), std::cos( latitude ) * std::sin( longitude ),
+                        std::sin( latitude ) );
+            for( int k = 0; k < numberOfRadii_; k++ )
+            {
+                const double radius = ( k == numberOfRadii_ - 1 ) ? maximumRadius_ : minimumRadius_ + k * radiusStep_;
+                nodePositions.row( j * numberOfRadii_ + k ) = radius * unitPosition.transpose( );
+            }
+        }
+
+        gravityEvaluator.computeAccelerations( 1.0, nodePositions, nodeAccelerations );
+        double* latitudeValues = gridValues_.data( ) + 3 * static_cast< std::size_t >( i ) * nodesPerLatitude;
+        for( int j = 0; j < nodesPerLatitude; j++ )
+        {
+            for( int k = 0; k < 3; k++ )
+            {
+                latitudeValues[ 3 * j + k ] = nodeAccelerations( j, k );
+            }
+        }
+    }
+    gridData_ = gridValues_.data( );
+
+    // Estimate interpolation error from the centres of a sample of cells, spread over the grid by a golden ratio sequence.
+    maximumInterpolationErrorPerUnitGravitationalParameter_ = TUDAT_NAN;
+    const long long numberOfCells =
+            static_cast< long long >( numberOfRadii_ - 1 ) * ( numberOfLatitudes_ - 1 ) * numberOfLongitudes_;
+    const int numberOfTestPoints = static_cast< int >(
+                std::min( static_cast< long long >( std::max( numberOfErrorTestPoints, 0 ) ), numberOfCells ) );
+    if( numberOfTestPoints > 0 )
+    {
+        const double goldenRatioConjugate = 0.5 * ( std::sqrt( 5.0 ) - 1.0 );
+        CartesianPointBlock testPositions( numberOfTestPoints, 3 );
+        for( int i = 0; i < numberOfTestPoints; i++ )
+        {
+            long long cellIndex = i;
+            if( numberOfTestPoints < numberOfCells )
+            {
+                const double sequenceValue = std::fmod( ( i + 0.5 ) * goldenRatioConjugate, 1.0 );
+                cellIndex = std::min( static_cast< long long >( sequenceValue * numberOfCells ), numberOfCells - 1 );
+            }
+
+            const long long radiusIndex = cellIndex % ( numberOfRadii_ - 1 );
+            const long long longitudeIndex = ( cellIndex / ( numberOfRadii_ - 1 ) ) % numberOfLongitudes_;
+            const long long latitudeIndex = cellIndex / ( ( numberOfRadii_ - 1 ) * numberOfLongitudes_ );
+
+            const double radius = minimumRadius_ + ( radiusIndex + 0.5 ) * radiusStep_;
+            const double latitude = -0.5 * mathematical_constants::PI + ( latitudeIndex + 0.5 ) * latitudeStep_;
+            const double longitude = ( longitudeIndex + 0.5 ) * longitudeStep_;
+            testPositions.row( i ) << radius * std::cos( latitude ) * std::cos( longitude ),
+                    radius * std::cos( latitude ) * std::sin( longitude ), radius * std::sin( latitude );
+        }
+
+        CartesianPointBlock testAccelerations;
+        gravityEvaluator.computeAccelerations( 1.0, testPositions, testAccelerations );
+
+        maximumInterpolationErrorPerUnitGravitationalParameter_ = 0.0;
+        for( int i = 0; i < numberOfTestPoints; i++ )
+        {
+            maximumInterpolationErrorPerUnitGravitationalParameter_ = std::max(
+                        maximumInterpolationErrorPerUnitGravitationalParameter_,
+                        ( interpolateNonCentralAcceleration( testPositions.row( i ).transpose( ) ) -
+                          testAccelerations.row( i ).transpose( ) ).norm( ) );
+        }
+    }
+}
+
+//! Update class members.
+void GriddedSphericalHarmonicsGravitationalAccelerationModel::updateMembers( const double currentTime )
+{
+    if( !( this->currentTime_ == currentTime ) )
+    {
+        rotationToIntegrationFrame_ = rotationFromBodyFixedToIntegrationFrameFunction_( );
+        this->updateBaseMembers( );
+
+        currentInertialRelativePosition_ =
+                this->positionOfBodySubjectToAcceleration - this->positionOfBodyExertingAcceleration;
+        currentBodyFixedRelativePosition_ = rotationToIntegrationFrame_.inverse( ) * currentInertialRelativePosition_;
+
+        if( accelerationGrid_->isPositionInGrid( currentBodyFixedRelativePosition_ ) )
+        {
+            // Compute central term analytically, and interpolate the other terms from the grid.
+            const double distance = currentInertialRelativePosition_.norm( );
+            currentAcceleration_ = -this->gravitationalParameter / ( distance * distance * distance ) *
+                    currentInertialRelativePosition_ + this->gravitationalParameter * (
+                        rotationToIntegrationFrame_ *
+                        accelerationGrid_->interpolateNonCentralAcceleration( currentBodyFixedRelativePosition_ ) );
+        }
+        else if( directAccelerationModel_ != nullptr )
+        {
+            directAccelerationModel_->updateMembers( currentTime );
+            currentAcceleration_ = directAccelerationModel_->getAcceleration( );
+            numberOfDirectEvaluations_++;
+        }
+        else
+        {
+            throw std::runtime_error( "Error in gridded spherical harmonic acceleration, distance " +
+                                      std::to_string( currentBodyFixedRelativePosition_.norm( ) ) +
+                                      " is outside of grid (" +
+                                      std::to_string( accelerationGrid_->getMinimumRadius( ) ) + " to " +
+                                      std::to_string( accelerationGrid_->getMaximumRadius( ) ) +
+                                      "), and no direct acceleration model is provided." );
+        }
+
+        this->currentTime_ = currentTime;
+    }
+}
+
+} // namespace gravitation
+
+} // namespace tudat
@@ -0,0 +1,459 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_GRIDDED_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+#define TUDAT_GRIDDED_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace gravitation
+{
+
+//! Class for storing and interpolating a precomputed grid of spherical harmonic gravitational accelerations.
+/*!
+ *  Class for storing and interpolating a precomputed grid of the accelerations due to a spherical harmonic gravity field,
+ *  over a spherical shell around the body. The grid stores the acceleration, in the body-fixed frame, due to all terms
+ *  except the central (degree zero) term, per unit gravitational parameter. The grid nodes are equidistant in radius
+ *  (between the inner and outer radius of the shell, inclusive), latitude (from -90 to 90 degrees, inclusive) and
+ *  longitude (from 0 to 360 degrees, exclusive, periodic). The values of the grid are stored with the radius as the
+ *  fastest varying index (followed by longitude and latitude), and the three components of each node contiguously.
+ *
+ *  The acceleration is interpolated by tricubic Lagrange interpolation, using the 4 x 4 x 4 nodes around the point
+ *  (shifted inward at the radial and latitudinal boundaries of the grid). With the memory layout of the grid, the 64
+ *  nodes are read as 16 contiguous runs of 4 nodes, so that an interpolation accesses only a few cache lines. The
+ *  interpolation error is estimated when building the grid, by comparing the interpolated acceleration with the
+ *  directly evaluated acceleration at the centres of a sample of grid cells (where the interpolation error is largest).
+ *
+ *  The grid can be written to, and loaded from, a binary file. A loaded file is mapped read-only into memory, so that
+ *  processes using the same grid (e.g. in a Monte Carlo analysis) share the physical pages.
+ */
+class SphericalHarmonicsAccelerationGrid
+{
+public:
+
+    //! Constructor, computes the grid from a set of spherical harmonic coefficients.
+    /*!
+     *  Constructor, computes the grid from a set of spherical harmonic coefficients, using the
+     *  BatchedSphericalHarmonicsGravityEvaluator, and estimates the interpolation error of the grid.
+     *  \param gravitationalParameter Gravitational parameter of the gravity field (only used to scale the reported
+     *  interpolation error, the grid is stored per unit gravitational parameter).
+     *  \param referenceRadius Reference radius of the spherical harmonic expansion.
+     *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+     *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+     *  \param minimumRadius Inner radius of the spherical shell covered by the grid.
+     *  \param maximumRadius Outer radius of the spherical shell covered by the grid.
+     *  \param numberOfRadii Number of grid nodes in radial direction (at least 4).
+     *  \param numberOfLatitudes Number of grid nodes in latitude, including both poles (at least 4).
+     *  \param numberOfLongitudes Number of grid nodes in longitude (at least 4).
+     *  \param numberOfThreads Number of threads used to compute the grid (1 for serial computation, 0 to use all
+     *  available threads).
+     *  \param numberOfErrorTestPoints Number of grid cells at which the interpolation error is estimated (all cells if
+     *  the grid contains fewer cells, the error is set to NaN if zero).
+     */
+    SphericalHarmonicsAccelerationGrid(
+            const double gravitationalParameter,
+            const double referenceRadius,
+            const Eigen::MatrixXd& cosineHarmonicCoefficients,
+            const Eigen::MatrixXd& sineHarmonicCoefficients,
+            const double minimumRadius,
+            const double maximumRadius,
+            const int numberOfRadii,
+            const int numberOfLatitudes,
+            const int numberOfLongitudes,
+            const unsigned int numberOfThreads = 1,
+            const int numberOfErrorTestPoints = 10000 );
+
+    //! Constructor, computes the grid from a spherical harmonic gravity field.
+    /*!
+     *  Constructor, computes the grid from a spherical harmonic gravity field, truncated at a given degree and order,
+     *  using its current coefficients (time variations of the field are not included in the grid).
+     *  \param gravityField Gravity field from which the grid is to be computed.
+     *  \param maximumDegree Maximum degree of the gravity field that is to be used.
+     *  \param maximumOrder Maximum order of the gravity field that is to be used.
+     *  \param minimumRadius Inner radius of the spherical shell covered by the grid.
+     *  \param maximumRadius Outer radius of the spherical shell covered by the grid.
+     *  \param numberOfRadii Number of grid nodes in radial direction (at least 4).
+     *  \param numberOfLatitudes Number of grid nodes in latitude, including both poles (at least 4).
+     *  \param numberOfLongitudes Number of grid nodes in longitude (at least 4).
+     *  \param numberOfThreads Number of threads used to compute the grid (1 for serial computation, 0 to use all
+     *  available threads).
+     *  \param numberOfErrorTestPoints Number of grid cells at which the interpolation error is estimated (the error is
+     *  set to NaN if zero).
+     */
+    SphericalHarmonicsAccelerationGrid(
+            const std::shared_ptr< SphericalHarmonicsGravityField > gravityField,
+            const int maximumDegree,
+            const int maximumOrder,
+            const double minimumRadius,
+            const double maximumRadius,
+            const int numberOfRadii,
+            const int numberOfLatitudes,
+            const int numberOfLongitudes,
+            const unsigned int numberOfThreads = 1,
+            const int numberOfErrorTestPoints = 10000 );
+
+    //! Constructor, maps a grid file (written by writeToFile) into memory.
+    /*!
+     *  Constructor, maps a grid file (written by writeToFile) into memory and reads its header.
+     *  \param fileName Name of the grid file.
+     */
+    SphericalHarmonicsAccelerationGrid( const std::string& fileName );
+
+    //! Destructor, unmaps the grid file (if any).
+    ~SphericalHarmonicsAccelerationGrid( );
+
+    //! Copy constructor (deleted, since the grid may refer to a mapped file).
+    SphericalHarmonicsAccelerationGrid( const SphericalHarmonicsAccelerationGrid& ) = delete;
+
+    //! Assignment operator (deleted, since the grid may refer to a mapped file).
+    SphericalHarmonicsAccelerationGrid& operator=( const SphericalHarmonicsAccelerationGrid& ) = delete;
+
+    //! Function to write the grid to a binary file.
+    /*!
+     *  Function to write the grid to a binary file, which can be loaded by the constructor from file. The file consists
+     *  of a header of 128 bytes, containing the identifier "TUDATSAG", the format version and a byte order mark (32-bit
+     *  unsigned integers), the number of radii, latitudes and longitudes and the maximum degree and order (32-bit
+     *  integers), the inner and outer radius, reference radius, gravitational parameter and interpolation error per
+     *  unit gravitational parameter (doubles), padded with zeros. The header is followed by the values of the grid, in
+     *  the order in which they are stored in memory. All data is stored in the native byte order of the machine.
+     *  \param fileName Name of the file to which the grid is to be written.
+     */
+    void writeToFile( const std::string& fileName ) const;
+
+    //! Function to check whether a position is inside the spherical shell covered by the grid.
+    /*!
+     *  Function to check whether a position is inside the spherical shell covered by the grid.
+     *  \param bodyFixedPosition Position in the body-fixed frame.
+     *  \return True if the position is inside the shell covered by the grid.
+     */
+    bool isPositionInGrid( const Eigen::Vector3d& bodyFixedPosition ) const
+    {
+        const double radius = bodyFixedPosition.norm( );
+        return ( radius >= minimumRadius_ && radius <= maximumRadius_ );
+    }
+
+    //! Function to interpolate the non-central acceleration per unit gravitational parameter.
+    /*!
+     *  Function to interpolate the acceleration, per unit gravitational parameter, due to all terms of the gravity field
+     *  except the central term, at a position in the body-fixed frame. The position must be inside the shell covered by
+     *  the grid (see isPositionInGrid).
+     *  \param bodyFixedPosition Position in the body-fixed frame at which the acceleration is to be interpolated.
+     *  \return Non-central acceleration per unit gravitational parameter, in the body-fixed frame.
+     */
+    Eigen::Vector3d interpolateNonCentralAcceleration( const Eigen::Vector3d& bodyFixedPosition ) const;
+
+    //! Function to retrieve the estimated maximum interpolation error of the grid.
+    /*!
+     *  Function to retrieve the estimated maximum interpolation error of the grid (norm of the difference between the
+     *  interpolated and directly evaluated acceleration), for the gravitational parameter with which the grid was built.
+     *  \return Estimated maximum interpolation error of the grid [m/s^2].
+     */
+    double getMaximumInterpolationError( ) const
+    {
+        return gravitationalParameter_ * maximumInterpolationErrorPerUnitGravitationalParameter_;
+    }
+
+    //! Function to retrieve the estimated maximum interpolation error of the grid, per unit gravitational parameter.
+    /*!
+     *  Function to retrieve the estimated maximum interpolation error of the grid, per unit gravitational parameter.
+     *  \return Estimated maximum interpolation error of the grid, per unit gravitational parameter.
+     */
+    double getMaximumInterpolationErrorPerUnitGravitationalParameter( ) const
+    {
+        return maximumInterpolationErrorPerUnitGravitationalParameter_;
+    }
+
+    //! Function to retrieve the gravitational parameter with which the grid was built.
+    double getGravitationalParameter( ) const
+    {
+        return gravitationalParameter_;
+    }
+
+    //! Function to retrieve the reference radius of the spherical harmonic expansion.
+    double getReferenceRadius( ) const
+    {
+        return referenceRadius_;
+    }
+
+    //! Function to retrieve the maximum degree of the spherical harmonic expansion.
+    int getMaximumDegree( ) const
+    {
+        return maximumDegree_;
+    }
+
+    //! Function to retrieve the maximum order of the spherical harmonic expansion.
+    int getMaximumOrder( ) const
+    {
+        return maximumOrder_;
+    }
+
+    //! Function to retrieve the inner radius of the spherical shell covered by the grid.
+    double getMinimumRadius( ) const
+    {
+        return minimumRadius_;
+    }
+
+    //! Function to retrieve the outer radius of the spherical shell covered by the grid.
+    double getMaximumRadius( ) const
+    {
+        return maximumRadius_;
+    }
+
+    //! Function to retrieve the number of grid nodes in radial direction.
+    int getNumberOfRadii( ) const
+    {
+        return numberOfRadii_;
+    }
+
+    //! Function to retrieve the number of grid nodes in latitude.
+    int getNumberOfLatitudes( ) const
+    {
+        return numberOfLatitudes_;
+    }
+
+    //! Function to retrieve the number of grid nodes in longitude.
+    int getNumberOfLongitudes( ) const
+    {
+        return numberOfLongitudes_;
+    }
+
+private:
+
+    //! Function to check the dimensions of the grid and set the grid spacings.
+    void setGridSpacing( );
+
+    //! Function to compute the values of the grid from a set of spherical harmonic coefficients.
+    /*!
+     *  Function to compute the values of the grid from a set of spherical harmonic coefficients, and estimate the
+     *  interpolation error of the grid.
+     *  \param cosineHarmonicCoefficients Matrix with geodesy-normalized cosine harmonic coefficients.
+     *  \param sineHarmonicCoefficients Matrix with geodesy-normalized sine harmonic coefficients.
+     *  \param numberOfThreads Number of threads used to compute the grid.
+     *  \param numberOfErrorTestPoints Number of grid cells at which the interpolation error is estimated.
+     */
+    void computeGrid( const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                      const Eigen::MatrixXd& sineHarmonicCoefficients,
+                      const unsigned int numberOfThreads,
+                      const int numberOfErrorTestPoints );
+
+    //! Name of the file from which the grid was loaded (empty if grid was computed).
+    std::string fileName_;
+
+    //! Values of the grid (empty if grid was loaded from file).
+    std::vector< double > gridValues_;
+
+    //! Memory-mapped grid file (not opened if grid was computed).
+    boost::iostreams::mapped_file_source mappedFile_;
+
+    //! Pointer to the values of the grid (in gridValues_ or in the mapped file).
+    const double* gridData_;
+
+    //! Gravitational parameter with which the grid was built.
+    double gravitationalParameter_;
+
+    //! Reference radius of the spherical harmonic expansion.
+    double referenceRadius_;
+
+    //! Maximum degree of the spherical harmonic expansion.
+    int maximumDegree_;
+
+    //! Maximum order of the spherical harmonic expansion.
+    int maximumOrder_;
+
+    //! Inner radius of the spherical shell covered by the grid.
+    double minimumRadius_;
+
+    //! Outer radius of the spherical shell covered by the grid.
+    double maximumRadius_;
+
+    //! Number of grid nodes in radial direction.
+    int numberOfRadii_;
+
+    //! Number of grid nodes in latitude.
+    int numberOfLatitudes_;
+
+    //! Number of grid nodes in longitude.
+    int numberOfLongitudes_;
+
+    //! Spacing of the grid nodes in radial direction.
+    double radiusStep_;
+
+    //! Spacing of the grid nodes in latitude.
+    double latitudeStep_;
+
+    //! Spacing of the grid nodes in longitude.
+    double longitudeStep_;
+
+    //! Estimated maximum interpolation error of the grid, per unit gravitational parameter.
+    double maximumInterpolationErrorPerUnitGravitationalParameter_;
+};
+
+//! Class for calculating the spherical harmonic gravitational acceleration from a precomputed grid.
+/*!
+ *  Class for calculating the gravitational acceleration due to a spherical harmonic gravity field from a precomputed
+ *  grid (see SphericalHarmonicsAccelerationGrid). The central term is computed analytically, and the acceleration due
+ *  to the other terms is interpolated from the grid. Outside of the shell covered by the grid, the acceleration is
+ *  either evaluated directly by a spherical harmonic acceleration model (if provided), or an exception is thrown.
+ *  This model is intended for applications where a large number of (approximate) evaluations of a high-degree field
+ *  is required, such as conjunction screening and Monte Carlo analyses; the interpolation error is bounded by the
+ *  (estimated) error with which the grid was built, see SphericalHarmonicsAccelerationGrid::getMaximumInterpolationError.
+ */
+class GriddedSphericalHarmonicsGravitationalAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+{
+private:
+
+    //! Typedef for base class.
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor. Contrary to the other gravitational acceleration models, the members are not updated by the
+     *  constructor, since the position of the body undergoing the acceleration need not be inside the grid when the
+     *  model is created.
+     *  \param positionOfBodySubjectToAccelerationFunction Function returning position of body subject to
+     *  acceleration.
+     *  \param gravitationalParameterFunction Function returning the gravitational parameter.
+     *  \param accelerationGrid Precomputed grid of the non-central accelerations.
+     *  \param positionOfBodyExertingAccelerationFunction Function returning position of body exerting acceleration.
+     *  \param rotationFromBodyFixedToIntegrationFrameFunction Function returning the rotation from the body-fixed frame
+     *  (in which the grid is defined) to the frame in which the acceleration is computed.
+     *  \param isMutualAttractionUsed Boolean denoting whether the gravitational parameter is the sum of those of the
+     *  body exerting and undergoing the acceleration.
+     *  \param directAccelerationModel Spherical harmonic acceleration model that is used outside of the shell covered
+     *  by the grid (if nullptr, an exception is thrown outside of the grid).
+     */
+    GriddedSphericalHarmonicsGravitationalAccelerationModel(
+            const StateFunction positionOfBodySubjectToAccelerationFunction,
+            const std::function< double( ) > gravitationalParameterFunction,
+            const std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid,
+            const StateFunction positionOfBodyExertingAccelerationFunction =
+            [ ]( ){ return Eigen::Vector3d::Zero( ); },
+            const std::function< Eigen::Quaterniond( ) > rotationFromBodyFixedToIntegrationFrameFunction =
+            [ ]( ){ return Eigen::Quaterniond( Eigen::Matrix3d::Identity( ) ); },
+            const bool isMutualAttractionUsed = false,
+            const std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel = nullptr ):
+        Base( positionOfBodySubjectToAccelerationFunction, gravitationalParameterFunction,
+              positionOfBodyExertingAccelerationFunction, isMutualAttractionUsed ),
+        accelerationGrid_( accelerationGrid ),
+        rotationFromBodyFixedToIntegrationFrameFunction_( rotationFromBodyFixedToIntegrationFrameFunction ),
+        directAccelerationModel_( directAccelerationModel ),
+        currentAcceleration_( Eigen::Vector3d::Zero( ) ),
+        numberOfDirectEvaluations_( 0 )
+    { }
+
+    //! Function to retrieve the current acceleration.
+    /*!
+     *  Function to retrieve the current acceleration, as computed by the last call to updateMembers.
+     *  \return Current gravitational acceleration.
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return currentAcceleration_;
+    }
+
+    //! Update class members.
+    /*!
+     *  Updates the positions, gravitational parameter and rotation to the integration frame, and computes the
+     *  acceleration from the grid (or from the direct acceleration model, if the body is outside of the grid).
+     *  \param currentTime Time at which acceleration model is to be updated.
+     */
+    void updateMembers( const double currentTime = TUDAT_NAN );
+
+    //! Function to reset the current time
+    /*!
+     *  Function to reset the current time of the acceleration model, and of the direct acceleration model (if any).
+     *  \param currentTime Current time (default NaN).
+     */
+    void resetTime( const double currentTime = TUDAT_NAN )
+    {
+        this->currentTime_ = currentTime;
+        if( directAccelerationModel_ != nullptr )
+        {
+            directAccelerationModel_->resetTime( currentTime );
+        }
+    }
+
+    //! Function to retrieve the grid from which the acceleration is interpolated.
+    std::shared_ptr< SphericalHarmonicsAccelerationGrid > getAccelerationGrid( )
+    {
+        return accelerationGrid_;
+    }
+
+    //! Function to retrieve the acceleration model used outside of the grid (nullptr if none).
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > getDirectAccelerationModel( )
+    {
+        return directAccelerationModel_;
+    }
+
+    //! Function to retrieve the number of evaluations outside of the grid, by the direct acceleration model.
+    int getNumberOfDirectEvaluations( )
+    {
+        return numberOfDirectEvaluations_;
+    }
+
+    //! Function to retrieve the current position of the body undergoing the acceleration, in the body-fixed frame.
+    Eigen::Vector3d getCurrentBodyFixedRelativePosition( )
+    {
+        return currentBodyFixedRelativePosition_;
+    }
+
+private:
+
+    //! Grid from which the non-central acceleration is interpolated.
+    std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid_;
+
+    //! Function returning the rotation from the body-fixed frame to the frame in which the acceleration is computed.
+    std::function< Eigen::Quaterniond( ) > rotationFromBodyFixedToIntegrationFrameFunction_;
+
+    //! Spherical harmonic acceleration model that is used outside of the grid (nullptr if none).
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel_;
+
+    //! Current rotation from the body-fixed frame to the frame in which the acceleration is computed.
+    Eigen::Quaterniond rotationToIntegrationFrame_;
+
+    //! Current position of the body undergoing the acceleration w.r.t. the body exerting it, in the integration frame.
+    Eigen::Vector3d currentInertialRelativePosition_;
+
+    //! Current position of the body undergoing the acceleration w.r.t. the body exerting it, in the body-fixed frame.
+    Eigen::Vector3d currentBodyFixedRelativePosition_;
+
+    //! Current acceleration.
+    Eigen::Vector3d currentAcceleration_;
+
+    //! Number of evaluations outside of the grid, by the direct acceleration model.
+    int numberOfDirectEvaluations_;
+};
+
+} // namespace gravitation
+
+} // namespace tudat
+
+#endif // TUDAT_GRIDDED_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
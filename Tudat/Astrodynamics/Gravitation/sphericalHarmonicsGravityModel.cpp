@@ -178,6 +178,47 @@ Eigen::Vector3d computeSingleGeodesyNormalizedGravitationalAcceleration(
                 sphericalGradient, positionOfBodySubjectToAcceleration );
 }
 
+//! Function to create a cache with which a set of spherical harmonic accelerations are evaluated together.
+std::shared_ptr< BatchedSphericalHarmonicsGravityCache > createBatchedSphericalHarmonicsGravityCache(
+        const std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > >& accelerationModels,
+        const unsigned int numberOfThreads )
+{
+    if( accelerationModels.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when creating batched spherical harmonic gravity cache, no acceleration models "
+                                  "provided." );
+    }
+
+    // Check that all accelerations are due to the same gravity field.
+    const Eigen::MatrixXd cosineCoefficients = accelerationModels.at( 0 )->getCosineHarmonicCoefficientsFunction( )( );
+    const Eigen::MatrixXd sineCoefficients = accelerationModels.at( 0 )->getSineHarmonicCoefficientsFunction( )( );
+    for( unsigned int i = 1; i < accelerationModels.size( ); i++ )
+    {
+        const Eigen::MatrixXd currentCosineCoefficients = accelerationModels.at( i )->getCosineHarmonicCoefficientsFunction( )( );
+        const Eigen::MatrixXd currentSineCoefficients = accelerationModels.at( i )->getSineHarmonicCoefficientsFunction( )( );
+        if( accelerationModels.at( i )->getReferenceRadius( ) != accelerationModels.at( 0 )->getReferenceRadius( ) ||
+                currentCosineCoefficients.rows( ) != cosineCoefficients.rows( ) ||
+                currentCosineCoefficients.cols( ) != cosineCoefficients.cols( ) ||
+                currentCosineCoefficients != cosineCoefficients || currentSineCoefficients != sineCoefficients )
+        {
+            throw std::runtime_error( "Error when creating batched spherical harmonic gravity cache, acceleration models "
+                                      "are not due to the same gravity field." );
+        }
+    }
+
+    std::shared_ptr< BatchedSphericalHarmonicsGravityCache > batchedGravityCache =
+            std::make_shared< BatchedSphericalHarmonicsGravityCache >(
+                accelerationModels.at( 0 )->getReferenceRadius( ),
+                accelerationModels.at( 0 )->getCosineHarmonicCoefficientsFunction( ),
+                accelerationModels.at( 0 )->getSineHarmonicCoefficientsFunction( ),
+                numberOfThreads );
+    for( unsigned int i = 0; i < accelerationModels.size( ); i++ )
+    {
+        accelerationModels.at( i )->setBatchedGravityCache( batchedGravityCache );
+    }
+    return batchedGravityCache;
+}
+
 } // namespace gravitation
 
 } // namespace tudat
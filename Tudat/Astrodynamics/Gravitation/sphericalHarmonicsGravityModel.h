@@ -25,6 +25,8 @@
 #include <Eigen/Geometry>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/batchedSphericalHarmonicsGravity.h"
+#include "Tudat/Astrodynamics/Gravitation/cartesianSphericalHarmonicsGravity.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
 #include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
@@ -144,6 +146,20 @@ Eigen::Vector3d computeSingleGeodesyNormalizedGravitationalAcceleration(
         const double sineHarmonicCoefficient,
         std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > sphericalHarmonicsCache );
 
+//! Enum defining the algorithm with which a spherical harmonic acceleration is evaluated.
+/*!
+ *  Enum defining the algorithm with which a spherical harmonic acceleration is evaluated: either term-by-term in
+ *  spherical coordinates, using the associated Legendre polynomials (see
+ *  computeGeodesyNormalizedGravitationalAccelerationSum), or directly in Cartesian coordinates using the Cunningham
+ *  recursion (see computeCartesianGeodesyNormalizedGravitationalAccelerationSum), which requires no trigonometric
+ *  functions, is free of singularities at the poles, and can provide the gravity gradient in the same pass.
+ */
+enum SphericalHarmonicsEvaluationAlgorithm
+{
+    spherical_coordinates_evaluation,
+    cartesian_recursion_evaluation
+};
+
 //! Template class for general spherical harmonics gravitational acceleration model.
 /*!
  * This templated class implements a general spherical harmonics gravitational acceleration model.
@@ -220,7 +236,11 @@ public:
               rotationFromBodyFixedToIntegrationFrameFunction ),
           sphericalHarmonicsCache_( sphericalHarmonicsCache ),
           currentAcceleration_( Eigen::Vector3d::Zero( ) ),
-          saveSphericalHarmonicTermsSeparately_( false )
+          saveSphericalHarmonicTermsSeparately_( false ),
+          evaluationAlgorithm_( spherical_coordinates_evaluation ),
+          computeGravityGradient_( false ),
+          currentGravityGradient_( Eigen::Matrix3d::Zero( ) ),
+          batchedEvaluationPointIndex_( -1 )
     {
         maximumDegree_ = static_cast< int >( getCosineHarmonicsCoefficients( ).rows( ) );
         maximumOrder_ = static_cast< int >( getCosineHarmonicsCoefficients( ).cols( ) );
@@ -283,7 +303,11 @@ public:
           rotationFromBodyFixedToIntegrationFrameFunction_( rotationFromBodyFixedToIntegrationFrameFunction ),
           sphericalHarmonicsCache_( sphericalHarmonicsCache ),
           currentAcceleration_( Eigen::Vector3d::Zero( ) ),
-          saveSphericalHarmonicTermsSeparately_( false )
+          saveSphericalHarmonicTermsSeparately_( false ),
+          evaluationAlgorithm_( spherical_coordinates_evaluation ),
+          computeGravityGradient_( false ),
+          currentGravityGradient_( Eigen::Matrix3d::Zero( ) ),
+          batchedEvaluationPointIndex_( -1 )
     {
         maximumDegree_ = static_cast< int >( getCosineHarmonicsCoefficients( ).rows( ) );
         maximumOrder_ = static_cast< int >( getCosineHarmonicsCoefficients( ).cols( ) );
@@ -341,16 +365,45 @@ public:
             currentRelativePosition_ = rotationToIntegrationFrame_.inverse( ) * (
                         currentInertialRelativePosition_ );
 
-            currentAcceleration_ =
-                    computeGeodesyNormalizedGravitationalAccelerationSum(
-                        currentRelativePosition_,
-                        gravitationalParameter,
-                        equatorialRadius,
-                        cosineHarmonicCoefficients,
-                        sineHarmonicCoefficients, sphericalHarmonicsCache_,
-                        accelerationPerTerm_,
-                        saveSphericalHarmonicTermsSeparately_,
-                        rotationToIntegrationFrame_.toRotationMatrix( ) );
+            if( batchedGravityCache_ != nullptr && !saveSphericalHarmonicTermsSeparately_ )
+            {
+                // Retrieve acceleration (for unit gravitational parameter) from evaluation of all points at once.
+                batchedGravityCache_->update( currentTime );
+                const Eigen::Matrix3d rotationToIntegrationFrame = rotationToIntegrationFrame_.toRotationMatrix( );
+                currentAcceleration_ = gravitationalParameter * ( rotationToIntegrationFrame *
+                        batchedGravityCache_->getUnitAcceleration( batchedEvaluationPointIndex_ ) );
+                if( computeGravityGradient_ )
+                {
+                    currentGravityGradient_ = gravitationalParameter * rotationToIntegrationFrame *
+                            batchedGravityCache_->getUnitGravityGradient( batchedEvaluationPointIndex_ ) *
+                            rotationToIntegrationFrame.transpose( );
+                }
+            }
+            else if( evaluationAlgorithm_ == cartesian_recursion_evaluation && !saveSphericalHarmonicTermsSeparately_ )
+            {
+                currentAcceleration_ =
+                        computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                            currentRelativePosition_,
+                            gravitationalParameter,
+                            equatorialRadius,
+                            cosineHarmonicCoefficients,
+                            sineHarmonicCoefficients, cartesianSphericalHarmonicsCache_,
+                            rotationToIntegrationFrame_.toRotationMatrix( ),
+                            computeGravityGradient_, currentGravityGradient_ );
+            }
+            else
+            {
+                currentAcceleration_ =
+                        computeGeodesyNormalizedGravitationalAccelerationSum(
+                            currentRelativePosition_,
+                            gravitationalParameter,
+                            equatorialRadius,
+                            cosineHarmonicCoefficients,
+                            sineHarmonicCoefficients, sphericalHarmonicsCache_,
+                            accelerationPerTerm_,
+                            saveSphericalHarmonicTermsSeparately_,
+                            rotationToIntegrationFrame_.toRotationMatrix( ) );
+            }
             currentAccelerationInBodyFixedFrame_ = rotationToIntegrationFrame_.inverse( ) * currentAcceleration_;
         }
     }
@@ -366,6 +419,17 @@ public:
     Eigen::VectorXd getAccelerationWithAlternativeCoefficients(
             const Eigen::MatrixXd& cosineCoefficients, const Eigen::MatrixXd& sineCoefficients)
     {
+        if( evaluationAlgorithm_ == cartesian_recursion_evaluation )
+        {
+            return computeCartesianGeodesyNormalizedGravitationalAccelerationSum(
+                        currentRelativePosition_,
+                        gravitationalParameter,
+                        equatorialRadius,
+                        cosineCoefficients,
+                        sineCoefficients, cartesianSphericalHarmonicsCache_,
+                        rotationToIntegrationFrame_.toRotationMatrix( ) );
+        }
+
         std::map< std::pair< int, int >, Eigen::Vector3d > dummy;
         return computeGeodesyNormalizedGravitationalAccelerationSum(
                     currentRelativePosition_,
@@ -544,6 +608,142 @@ public:
         return returnVector;
     }
 
+    //! Function to set the algorithm with which the acceleration is evaluated.
+    /*!
+     * Function to set the algorithm with which the acceleration is evaluated (in spherical coordinates by default). Note
+     * that the acceleration is always evaluated in spherical coordinates if the separate spherical harmonic terms are to
+     * be saved (see setSaveSphericalHarmonicTermsSeparately).
+     * \param evaluationAlgorithm Algorithm with which the acceleration is to be evaluated.
+     */
+    void setEvaluationAlgorithm( const SphericalHarmonicsEvaluationAlgorithm evaluationAlgorithm )
+    {
+        evaluationAlgorithm_ = evaluationAlgorithm;
+        if( evaluationAlgorithm_ == cartesian_recursion_evaluation && cartesianSphericalHarmonicsCache_ == nullptr )
+        {
+            cartesianSphericalHarmonicsCache_ = std::make_shared< CartesianSphericalHarmonicsCache >(
+                        maximumDegree_ - 1, maximumOrder_ - 1 );
+        }
+        else if( evaluationAlgorithm_ == spherical_coordinates_evaluation && computeGravityGradient_ )
+        {
+            throw std::runtime_error( "Error when setting spherical harmonic acceleration evaluation in spherical "
+                                      "coordinates, gravity gradient computation is only supported by Cartesian recursion." );
+        }
+
+        this->currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to retrieve the algorithm with which the acceleration is evaluated.
+    /*!
+     * Function to retrieve the algorithm with which the acceleration is evaluated.
+     * \return Algorithm with which the acceleration is evaluated.
+     */
+    SphericalHarmonicsEvaluationAlgorithm getEvaluationAlgorithm( )
+    {
+        return evaluationAlgorithm_;
+    }
+
+    //! Function to set whether the gravity gradient is to be computed when updating the acceleration.
+    /*!
+     * Function to set whether the gravity gradient (i.e. the partial derivative of the acceleration w.r.t. the position of
+     * the body undergoing the acceleration) is to be computed when updating the acceleration. This is only supported when
+     * using the Cartesian recursion (see setEvaluationAlgorithm) or batched evaluation (see setBatchedGravityCache), in
+     * which case the gradient is obtained in the same pass as the acceleration.
+     * \param computeGravityGradient Boolean denoting whether the gravity gradient is to be computed.
+     */
+    void setComputeGravityGradient( const bool computeGravityGradient )
+    {
+        if( computeGravityGradient && evaluationAlgorithm_ != cartesian_recursion_evaluation &&
+                batchedGravityCache_ == nullptr )
+        {
+            throw std::runtime_error( "Error when requesting gravity gradient computation for spherical harmonic "
+                                      "acceleration, only supported by Cartesian recursion." );
+        }
+        computeGravityGradient_ = computeGravityGradient;
+        if( computeGravityGradient_ && batchedGravityCache_ != nullptr )
+        {
+            batchedGravityCache_->setComputeGravityGradients( true );
+        }
+        this->currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to set the cache with which the acceleration is evaluated together with that of other bodies.
+    /*!
+     * Function to set the cache with which the acceleration is evaluated together with that of other bodies undergoing an
+     * acceleration due to the same spherical harmonic gravity field (typically several spacecraft orbiting the same body).
+     * The current position of the body undergoing the acceleration is registered with the cache, and the accelerations at
+     * the positions of all registered bodies are computed at once when the first of the associated acceleration models is
+     * updated to a new time. The separate spherical harmonic terms (see setSaveSphericalHarmonicTermsSeparately) are
+     * still computed by this object if requested. Typically set by createBatchedSphericalHarmonicsGravityCache.
+     * \param batchedGravityCache Cache with which the acceleration is to be evaluated.
+     */
+    void setBatchedGravityCache( const std::shared_ptr< BatchedSphericalHarmonicsGravityCache > batchedGravityCache )
+    {
+        std::shared_ptr< BatchedSphericalHarmonicsGravityEvaluator > evaluator = batchedGravityCache->getEvaluator( );
+        if( evaluator->getReferenceRadius( ) != equatorialRadius ||
+                evaluator->getMaximumDegree( ) != maximumDegree_ - 1 ||
+                evaluator->getMaximumOrder( ) != std::min( maximumOrder_, maximumDegree_ ) - 1 )
+        {
+            throw std::runtime_error( "Error when setting batched evaluation of spherical harmonic acceleration, reference "
+                                      "radius or maximum degree and order are inconsistent." );
+        }
+
+        // Register function returning current body-fixed position with cache.
+        const StateFunction subjectPositionFunction = this->subjectPositionFunction;
+        const StateFunction sourcePositionFunction = this->sourcePositionFunction;
+        const std::function< Eigen::Quaterniond( ) > rotationFunction = rotationFromBodyFixedToIntegrationFrameFunction_;
+        batchedGravityCache_ = batchedGravityCache;
+        batchedEvaluationPointIndex_ = batchedGravityCache_->addEvaluationPoint(
+                    [ = ]( ){ return Eigen::Vector3d( rotationFunction( ).inverse( ) *
+                                                      ( subjectPositionFunction( ) - sourcePositionFunction( ) ) ); } );
+        if( computeGravityGradient_ )
+        {
+            batchedGravityCache_->setComputeGravityGradients( true );
+        }
+
+        this->currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to retrieve the cache with which the acceleration is evaluated together with that of other bodies.
+    /*!
+     * Function to retrieve the cache with which the acceleration is evaluated together with that of other bodies (nullptr
+     * if not used).
+     * \return Cache with which the acceleration is evaluated together with that of other bodies.
+     */
+    std::shared_ptr< BatchedSphericalHarmonicsGravityCache > getBatchedGravityCache( )
+    {
+        return batchedGravityCache_;
+    }
+
+    //! Function to reset the current time
+    /*!
+     * Function to reset the current time of the acceleration model, and of the batched evaluation cache (if used).
+     * \param currentTime Current time (default NaN).
+     */
+    void resetTime( const double currentTime = TUDAT_NAN )
+    {
+        this->currentTime_ = currentTime;
+        if( batchedGravityCache_ != nullptr )
+        {
+            batchedGravityCache_->resetCurrentTime( );
+        }
+    }
+
+    //! Function to retrieve the current gravity gradient in the inertial frame.
+    /*!
+     * Function to retrieve the current gravity gradient in the inertial frame, as computed by last call to updateMembers
+     * function (only computed if requested by setComputeGravityGradient).
+     * \return Current gravity gradient in the inertial frame.
+     */
+    Eigen::Matrix3d getCurrentGravityGradient( )
+    {
+        if( !computeGravityGradient_ )
+        {
+            throw std::runtime_error( "Error when retrieving gravity gradient of spherical harmonic acceleration, "
+                                      "gravity gradient is not computed." );
+        }
+        return currentGravityGradient_;
+    }
+
     //! Function to retrieve maximum degree of gravity field expansion
     /*!
      * Function to retrieve maximum degree of gravity field expansion
@@ -629,6 +829,24 @@ private:
     //! Boolean that denotes whether each of the separate spherical harmonic terms should be saved (in accelerationPerTerm_)
     bool saveSphericalHarmonicTermsSeparately_;
 
+    //! Algorithm with which the acceleration is evaluated.
+    SphericalHarmonicsEvaluationAlgorithm evaluationAlgorithm_;
+
+    //! Boolean denoting whether the gravity gradient is to be computed when updating the acceleration.
+    bool computeGravityGradient_;
+
+    //! Current gravity gradient in inertial frame, as computed by last call to updateMembers function (if requested).
+    Eigen::Matrix3d currentGravityGradient_;
+
+    //! Cache for Cartesian recursion of solid spherical harmonics (only created if Cartesian recursion is used).
+    std::shared_ptr< CartesianSphericalHarmonicsCache > cartesianSphericalHarmonicsCache_;
+
+    //! Cache with which the acceleration is evaluated together with that of other bodies (nullptr if not used).
+    std::shared_ptr< BatchedSphericalHarmonicsGravityCache > batchedGravityCache_;
+
+    //! Index of the body undergoing the acceleration in the list of points of batchedGravityCache_.
+    int batchedEvaluationPointIndex_;
+
     //! Maximum degree of gravity field expansion
     int maximumDegree_;
 
@@ -642,6 +860,21 @@ private:
 typedef std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel >
 SphericalHarmonicsGravitationalAccelerationModelPointer;
 
+//! Function to create a cache with which a set of spherical harmonic accelerations are evaluated together.
+/*!
+ * Function to create a cache with which a set of spherical harmonic accelerations, all due to the same gravity field
+ * (typically acting on several spacecraft orbiting the same body), are evaluated together: the accelerations at the
+ * positions of all bodies undergoing the accelerations are then computed at once (vectorized over the bodies, and
+ * optionally distributed over several threads) when the first of the acceleration models is updated to a new time. The
+ * coefficients are retrieved from the first acceleration model.
+ * \param accelerationModels Acceleration models that are to be evaluated together.
+ * \param numberOfThreads Number of threads over which the evaluation is to be distributed.
+ * \return Cache with which the accelerations are evaluated (set in all acceleration models).
+ */
+std::shared_ptr< BatchedSphericalHarmonicsGravityCache > createBatchedSphericalHarmonicsGravityCache(
+        const std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > >& accelerationModels,
+        const unsigned int numberOfThreads = 1 );
+
 
 } // namespace gravitation
 
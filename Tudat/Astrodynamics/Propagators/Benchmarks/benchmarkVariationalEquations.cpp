@@ -0,0 +1,196 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This program reports the computation time of the contribution of the state partials to the variational
+ *      equations (VariationalEquations::getBodyInitialStatePartialMatrix), evaluated serially and split into column
+ *      blocks over multiple threads, for a number of mutually attracting bodies (of which the initial states are
+ *      estimated) and a block of 228 spherical harmonic coefficients (degree 2 to 20). The times depend on the machine
+ *      (in particular the number of available cores), and are therefore not checked.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelExecution.h"
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/centralGravityAccelerationPartial.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/EstimatableParameters/initialTranslationalState.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/EstimatableParameters/sphericalHarmonicCosineCoefficients.h"
+#include "Tudat/Astrodynamics/Propagators/variationalEquations.h"
+
+int main( )
+{
+    using namespace tudat;
+    using namespace tudat::gravitation;
+    using namespace tudat::acceleration_partials;
+    using namespace tudat::estimatable_parameters;
+    using namespace tudat::propagators;
+
+    const double gravitationalParameter = 3.986004418e14;
+
+    // Create (estimated) spherical harmonic coefficients of central body
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 21, 21 );
+    std::vector< std::pair< int, int > > blockIndices;
+    for( int degree = 2; degree <= 20; degree++ )
+    {
+        for( int order = 0; order <= degree; order++ )
+        {
+            blockIndices.push_back( std::make_pair( degree, order ) );
+        }
+    }
+    std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > coefficientsParameter =
+            std::make_shared< SphericalHarmonicsCosineCoefficients >(
+                [ & ]( ){ return cosineCoefficients; }, [ & ]( const Eigen::MatrixXd& coefficients )
+    { cosineCoefficients = coefficients; }, blockIndices, "Earth" );
+
+    std::vector< unsigned int > numberOfThreadsList = { 1, 2, 4 };
+    if( utilities::getNumberOfAvailableThreads( ) > 4 )
+    {
+        numberOfThreadsList.push_back( utilities::getNumberOfAvailableThreads( ) );
+    }
+
+    std::cout << "Computation time per evaluation of state partial contribution to variational equations "
+              << "(microseconds), " << utilities::getNumberOfAvailableThreads( ) << " available thread(s)" << std::endl;
+    std::cout << std::setw( 8 ) << "Bodies" << std::setw( 12 ) << "Parameters" << std::setw( 10 ) << "Threads"
+              << std::setw( 10 ) << "Blocks" << std::setw( 16 ) << "Default" << std::setw( 16 ) << "Forced split"
+              << std::endl;
+
+    for( int numberOfBodies : { 1, 4, 10, 20 } )
+    {
+        // Create bodies on (perturbed) circular orbits, with central and mutual point mass gravity
+        std::vector< Eigen::Vector6d > bodyStates( numberOfBodies );
+        std::vector< std::string > bodyNames;
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            bodyNames.push_back( "Body" + std::to_string( i ) );
+            bodyStates[ i ] << 7.0E6 * std::cos( 0.3 * i ), 7.0E6 * std::sin( 0.3 * i ), 1.0E5 * i,
+                    -7.5E3 * std::sin( 0.3 * i ), 7.5E3 * std::cos( 0.3 * i ), 10.0 * i;
+        }
+
+        std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > > initialStateParameters;
+        orbit_determination::StateDerivativePartialsMap accelerationPartials( numberOfBodies );
+        std::vector< std::shared_ptr< CentralGravitationalAccelerationModel3d > > accelerationModels;
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            initialStateParameters.push_back( std::make_shared< InitialTranslationalStateParameter< double > >(
+                                                  bodyNames.at( i ), bodyStates.at( i ), "Earth" ) );
+
+            std::function< Eigen::Vector3d( ) > positionFunction =
+                    [ &bodyStates, i ]( ){ return bodyStates.at( i ).segment( 0, 3 ); };
+            accelerationModels.push_back( std::make_shared< CentralGravitationalAccelerationModel3d >(
+                                              positionFunction, gravitationalParameter ) );
+            accelerationPartials[ i ].push_back( std::make_shared< CentralGravitationPartial >(
+                                                     accelerationModels.back( ), bodyNames.at( i ), "Earth" ) );
+            for( int j = 0; j < numberOfBodies; j++ )
+            {
+                if( i != j )
+                {
+                    accelerationModels.push_back( std::make_shared< CentralGravitationalAccelerationModel3d >(
+                                                      positionFunction, 1.0E3, [ &bodyStates, j ]( )
+                    { return bodyStates.at( j ).segment( 0, 3 ); } ) );
+                    accelerationPartials[ i ].push_back( std::make_shared< CentralGravitationPartial >(
+                                                             accelerationModels.back( ), bodyNames.at( i ),
+                                                             bodyNames.at( j ) ) );
+                }
+            }
+        }
+
+        std::shared_ptr< EstimatableParameterSet< double > > parameterSet =
+                std::make_shared< EstimatableParameterSet< double > >(
+                    std::vector< std::shared_ptr< EstimatableParameter< double > > >( ),
+                    std::vector< std::shared_ptr< EstimatableParameter< Eigen::VectorXd > > >(
+                        { coefficientsParameter } ), initialStateParameters );
+
+        std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap > stateDerivativePartials;
+        stateDerivativePartials[ translational_state ] = accelerationPartials;
+        std::map< IntegratedStateType, int > stateTypeStartIndices;
+        stateTypeStartIndices[ translational_state ] = 0;
+        VariationalEquations variationalEquations( stateDerivativePartials, parameterSet, stateTypeStartIndices );
+
+        // Update acceleration models and partials to current state
+        std::unordered_map< IntegratedStateType, Eigen::VectorXd > currentStates;
+        currentStates[ translational_state ] = Eigen::VectorXd( 6 * numberOfBodies );
+        for( int i = 0; i < numberOfBodies; i++ )
+        {
+            currentStates[ translational_state ].segment( 6 * i, 6 ) = bodyStates.at( i );
+        }
+        for( unsigned int i = 0; i < accelerationModels.size( ); i++ )
+        {
+            accelerationModels.at( i )->updateMembers( 0.0 );
+        }
+        variationalEquations.updatePartials( 0.0, currentStates );
+
+        const int numberOfRows = 6 * numberOfBodies;
+        const int numberOfParameters = variationalEquations.getNumberOfParameterValues( );
+        const Eigen::MatrixXd stateTransitionAndSensitivityMatrices =
+                Eigen::MatrixXd::Random( numberOfRows, numberOfParameters );
+        Eigen::MatrixXd serialMatrixDerivative = Eigen::MatrixXd::Zero( numberOfRows, numberOfParameters );
+        Eigen::MatrixXd matrixDerivative = Eigen::MatrixXd::Zero( numberOfRows, numberOfParameters );
+
+        // Set number of evaluations such that each timing takes on the order of 0.5 s
+        const int numberOfEvaluations = std::max(
+                    10, static_cast< int >( 1.0E9 / ( numberOfRows * numberOfRows * numberOfParameters ) ) );
+
+        for( unsigned int numberOfThreads : numberOfThreadsList )
+        {
+            // Time evaluation with default and with zero minimum number of multiplications per column block (minimum
+            // of three repetitions, to reduce the influence of other processes)
+            variationalEquations.setNumberOfEvaluationThreads( numberOfThreads );
+            double evaluationTimes[ 2 ];
+            int numberOfBlocks[ 2 ];
+            for( unsigned int k = 0; k < 2; k++ )
+            {
+                variationalEquations.setMinimumMultiplicationsPerColumnBlock( ( k == 0 ) ? 1.0E5 : 0.0 );
+                numberOfBlocks[ k ] = variationalEquations.getNumberOfColumnBlocks( );
+
+                evaluationTimes[ k ] = TUDAT_NAN;
+                for( unsigned int repetition = 0; repetition < 3; repetition++ )
+                {
+                    auto startTime = std::chrono::steady_clock::now( );
+                    for( int i = 0; i < numberOfEvaluations; i++ )
+                    {
+                        variationalEquations.getBodyInitialStatePartialMatrix< double >(
+                                    stateTransitionAndSensitivityMatrices,
+                                    matrixDerivative.block( 0, 0, numberOfRows, numberOfParameters ) );
+                    }
+                    evaluationTimes[ k ] = std::fmin( evaluationTimes[ k ], std::chrono::duration< double, std::micro >(
+                                                          std::chrono::steady_clock::now( ) - startTime ).count( ) /
+                                                      numberOfEvaluations );
+                }
+
+                if( numberOfThreads == 1 && k == 0 )
+                {
+                    serialMatrixDerivative = matrixDerivative;
+                }
+            }
+
+            // Print times, and the difference w.r.t. the serial evaluation, so that the computations cannot be
+            // optimized away.
+            std::cout << std::setw( 8 ) << numberOfBodies << std::setw( 12 ) << numberOfParameters
+                      << std::setw( 10 ) << numberOfThreads << std::setw( 10 )
+                      << std::to_string( numberOfBlocks[ 0 ] ) + "/" + std::to_string( numberOfBlocks[ 1 ] )
+                      << std::setw( 16 ) << evaluationTimes[ 0 ]
+                      << std::setw( 16 ) << evaluationTimes[ 1 ] << "    (difference: "
+                      << ( matrixDerivative - serialMatrixDerivative ).norm( ) << ")" << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
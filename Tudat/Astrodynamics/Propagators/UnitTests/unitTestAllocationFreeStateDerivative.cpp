@@ -0,0 +1,303 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/Propagators/dynamicsStateDerivativeModel.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Boolean denoting whether heap allocations are currently being counted
+bool countHeapAllocations = false;
+
+//! Number of heap allocations since counting was last started
+unsigned int numberOfHeapAllocations = 0;
+
+//! Function to start counting heap allocations
+void startCountingHeapAllocations( )
+{
+    numberOfHeapAllocations = 0;
+    countHeapAllocations = true;
+}
+
+//! Function to stop counting heap allocations, returning the number of allocations since counting was started
+unsigned int stopCountingHeapAllocations( )
+{
+    countHeapAllocations = false;
+    return numberOfHeapAllocations;
+}
+
+} // namespace unit_tests
+
+} // namespace tudat
+
+#if defined( __GLIBC__ )
+// Replace malloc, so that both operator new and Eigen's (aligned) allocations are counted
+extern "C" void* __libc_malloc( std::size_t size );
+
+extern "C" void* malloc( std::size_t size ) noexcept
+{
+    if( tudat::unit_tests::countHeapAllocations )
+    {
+        tudat::unit_tests::numberOfHeapAllocations++;
+    }
+    return __libc_malloc( size );
+}
+#else
+// Replace operator new (Eigen allocations are not counted on this platform)
+void* operator new( std::size_t size )
+{
+    if( tudat::unit_tests::countHeapAllocations )
+    {
+        tudat::unit_tests::numberOfHeapAllocations++;
+    }
+
+    void* allocatedMemory = std::malloc( size == 0 ? 1 : size );
+    if( allocatedMemory == nullptr )
+    {
+        throw std::bad_alloc( );
+    }
+    return allocatedMemory;
+}
+
+void operator delete( void* memoryToFree ) noexcept
+{
+    std::free( memoryToFree );
+}
+#endif
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+
+//! State derivative model for a set of uncoupled harmonic oscillators, which does not allocate any memory.
+class HarmonicOscillatorStateDerivative: public SingleStateTypeDerivative< double, double >
+{
+public:
+
+    HarmonicOscillatorStateDerivative( const int numberOfOscillators ):
+        SingleStateTypeDerivative< double, double >( custom_state ),
+        numberOfOscillators_( numberOfOscillators ){ }
+
+    void calculateSystemStateDerivative(
+            const double time,
+            const Eigen::VectorXd& stateOfSystemToBeIntegrated,
+            Eigen::Block< Eigen::MatrixXd > stateDerivative )
+    {
+        for( int i = 0; i < numberOfOscillators_; i++ )
+        {
+            stateDerivative( 2 * i, 0 ) = stateOfSystemToBeIntegrated( 2 * i + 1 );
+            stateDerivative( 2 * i + 1, 0 ) = -static_cast< double >( i + 1 ) * stateOfSystemToBeIntegrated( 2 * i );
+        }
+    }
+
+    void clearStateDerivativeModel( ){ }
+
+    void updateStateDerivativeModel( const double currentTime ){ }
+
+    void convertCurrentStateToGlobalRepresentation(
+            const Eigen::VectorXd& internalSolution, const double& time,
+            Eigen::Block< Eigen::VectorXd > currentLocalSolution )
+    {
+        currentLocalSolution = internalSolution;
+    }
+
+    Eigen::MatrixXd convertFromOutputSolution(
+            const Eigen::MatrixXd& outputSolution, const double& time )
+    {
+        return outputSolution;
+    }
+
+    void convertToOutputSolution(
+            const Eigen::MatrixXd& internalSolution, const double& time,
+            Eigen::Block< Eigen::VectorXd > currentLocalSolution )
+    {
+        currentLocalSolution = internalSolution;
+    }
+
+    int getConventionalStateSize( )
+    {
+        return 2 * numberOfOscillators_;
+    }
+
+private:
+
+    int numberOfOscillators_;
+};
+
+//! Function to create a state derivative model for two sets of harmonic oscillators, with a no-op environment update
+std::shared_ptr< DynamicsStateDerivativeModel< double, double > > createOscillatorStateDerivativeModel(
+        int& numberOfEnvironmentUpdates )
+{
+    std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > stateDerivativeModels;
+    stateDerivativeModels.push_back( std::make_shared< HarmonicOscillatorStateDerivative >( 3 ) );
+    stateDerivativeModels.push_back( std::make_shared< HarmonicOscillatorStateDerivative >( 2 ) );
+
+    std::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+            std::make_shared< DynamicsStateDerivativeModel< double, double > >(
+                stateDerivativeModels,
+                [ &numberOfEnvironmentUpdates ](
+                const double, const std::unordered_map< IntegratedStateType, Eigen::VectorXd >&,
+                const std::vector< IntegratedStateType >& ){ numberOfEnvironmentUpdates++; } );
+    stateDerivativeModel->setPropagationSettings( std::vector< IntegratedStateType >( ), true, false );
+    return stateDerivativeModel;
+}
+
+BOOST_AUTO_TEST_SUITE( test_allocation_free_state_derivative )
+
+//! Test whether the in-place state derivative of the full dynamics does not allocate after the first evaluation
+BOOST_AUTO_TEST_CASE( testAllocationFreeDynamicsStateDerivative )
+{
+    int numberOfEnvironmentUpdates = 0;
+    std::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+            createOscillatorStateDerivativeModel( numberOfEnvironmentUpdates );
+
+    Eigen::VectorXd state = Eigen::VectorXd::LinSpaced( 10, 1.0, 10.0 );
+    Eigen::VectorXd stateDerivative;
+
+    // First evaluation sizes the output
+    stateDerivativeModel->computeStateDerivativeInPlace( 0.0, state, stateDerivative );
+
+    // Check that subsequent evaluations do not allocate
+    startCountingHeapAllocations( );
+    for( unsigned int i = 1; i <= 100; i++ )
+    {
+        stateDerivativeModel->computeStateDerivativeInPlace( static_cast< double >( i ), state, stateDerivative );
+    }
+    BOOST_CHECK_EQUAL( stopCountingHeapAllocations( ), 0 );
+
+    // Check result against analytical model and by-value state derivative
+    for( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_EQUAL( stateDerivative( 2 * i ), state( 2 * i + 1 ) );
+        BOOST_CHECK_EQUAL( stateDerivative( 2 * i + 1 ), -static_cast< double >( i + 1 ) * state( 2 * i ) );
+    }
+    for( int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( stateDerivative( 6 + 2 * i ), state( 6 + 2 * i + 1 ) );
+        BOOST_CHECK_EQUAL( stateDerivative( 6 + 2 * i + 1 ), -static_cast< double >( i + 1 ) * state( 6 + 2 * i ) );
+    }
+    BOOST_CHECK( Eigen::MatrixXd( stateDerivative ) == stateDerivativeModel->computeStateDerivative( 0.0, state ) );
+
+    // Check function evaluation counting, and that the cumulative evaluations are only recorded on request
+    BOOST_CHECK_EQUAL( numberOfEnvironmentUpdates, 102 );
+    BOOST_CHECK_EQUAL( stateDerivativeModel->getNumberOfFunctionEvaluations( ), 102 );
+    BOOST_CHECK_EQUAL( stateDerivativeModel->getCumulativeNumberOfFunctionEvaluations( ).size( ), 0 );
+
+    stateDerivativeModel->setRecordCumulativeFunctionEvaluations( true );
+    stateDerivativeModel->computeStateDerivativeInPlace( 200.0, state, stateDerivative );
+    stateDerivativeModel->computeStateDerivativeInPlace( 300.0, state, stateDerivative );
+    BOOST_CHECK_EQUAL( stateDerivativeModel->getCumulativeNumberOfFunctionEvaluations( ).size( ), 2 );
+    BOOST_CHECK_EQUAL( stateDerivativeModel->getCumulativeNumberOfFunctionEvaluations( ).at( 300.0 ), 104 );
+}
+
+//! Test whether steady-state Runge-Kutta integration steps using the in-place state derivative do not allocate.
+BOOST_AUTO_TEST_CASE( testAllocationFreeIntegrationSteps )
+{
+    for( unsigned int integratorType = 0; integratorType < 2; integratorType++ )
+    {
+        int numberOfEnvironmentUpdates = 0;
+        std::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+                createOscillatorStateDerivativeModel( numberOfEnvironmentUpdates );
+        Eigen::VectorXd initialState = Eigen::VectorXd::LinSpaced( 10, 1.0, 10.0 );
+
+        std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+                [ stateDerivativeModel ]( const double time, const Eigen::VectorXd& state )
+        {
+            return Eigen::VectorXd( stateDerivativeModel->computeStateDerivative( time, state ) );
+        };
+
+        // Create integrators using by-value and in-place state derivative function
+        std::vector< std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > > integrators;
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            if( integratorType == 0 )
+            {
+                integrators.push_back( std::make_shared< RungeKutta4Integrator< double, Eigen::VectorXd, Eigen::VectorXd > >(
+                                           stateDerivativeFunction, 0.0, initialState ) );
+            }
+            else
+            {
+                integrators.push_back(
+                            std::make_shared< RungeKuttaVariableStepSizeIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > >(
+                                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                                stateDerivativeFunction, 0.0, initialState, 1.0E-6, 1.0,
+                                Eigen::VectorXd::Constant( 10, 1.0E-10 ), Eigen::VectorXd::Constant( 10, 1.0E-10 ) ) );
+            }
+        }
+        integrators.at( 1 )->setInPlaceStateDerivativeFunction(
+                    std::bind( &DynamicsStateDerivativeModel< double, double >::computeStateDerivativeInPlace< Eigen::VectorXd >,
+                               stateDerivativeModel, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3 ) );
+
+        // Perform first steps, during which buffers are sized
+        double stepSize = 0.01;
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            integrators.at( i )->performIntegrationStep( stepSize );
+        }
+
+        // Perform steady-state steps, returned state is discarded
+        unsigned int numberOfSteps = 50;
+        startCountingHeapAllocations( );
+        for( unsigned int j = 0; j < numberOfSteps; j++ )
+        {
+            integrators.at( 1 )->performIntegrationStep( integrators.at( 1 )->getNextStepSize( ) );
+        }
+        unsigned int numberOfAllocations = stopCountingHeapAllocations( );
+
+        // Only allocation per step is the copy of the state that is returned by performIntegrationStep
+#if defined( __GLIBC__ )
+        BOOST_CHECK_EQUAL( numberOfAllocations, numberOfSteps );
+#else
+        BOOST_CHECK_EQUAL( numberOfAllocations, 0 );
+#endif
+
+        // Check that both integrators produce identical results
+        for( unsigned int j = 0; j < numberOfSteps; j++ )
+        {
+            integrators.at( 0 )->performIntegrationStep( integrators.at( 0 )->getNextStepSize( ) );
+        }
+        BOOST_CHECK_EQUAL( integrators.at( 0 )->getCurrentIndependentVariable( ),
+                           integrators.at( 1 )->getCurrentIndependentVariable( ) );
+        for( int i = 0; i < initialState.rows( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( integrators.at( 0 )->getCurrentState( )( i ),
+                               integrators.at( 1 )->getCurrentState( )( i ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
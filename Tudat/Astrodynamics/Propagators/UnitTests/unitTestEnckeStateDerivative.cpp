@@ -545,6 +545,77 @@ BOOST_AUTO_TEST_CASE( testEnckePopagatorForHighEccentricities )
     }
 
 }
+//! Test whether the Encke propagator, and propagation of non-translational states, are rejected when using an integrator
+//! for second-order systems.
+BOOST_AUTO_TEST_CASE( testEnckePropagatorWithSecondOrderIntegrator )
+{
+    using namespace tudat::numerical_integrators;
+    using namespace tudat::simulation_setup;
+    using namespace tudat::basic_astrodynamics;
+    using namespace tudat::orbital_element_conversions;
+    using namespace tudat::propagators;
+
+    // Create central body and vehicle (without using Spice).
+    const double earthGravitationalParameter = 3.986004418E14;
+    NamedBodyMap bodyMap;
+    bodyMap[ "Earth" ] = std::make_shared< Body >( );
+    bodyMap[ "Earth" ]->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                          Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" ) );
+    bodyMap[ "Earth" ]->setGravityFieldModel(
+                std::make_shared< gravitation::GravityFieldModel >( earthGravitationalParameter ) );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 1000.0 );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Create acceleration models.
+    std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToPropagate, centralBodies );
+
+    // Define initial state.
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.05;
+    initialKeplerElements( inclinationIndex ) = 0.8;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, earthGravitationalParameter );
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaNystromVariableStepSizeSettings< > >(
+                0.0, 10.0, RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince, 1.0E-3, 300.0 );
+
+    // Check that Runge-Kutta-Nystrom integrator is accepted for the Cowell propagator, and rejected for Encke propagator.
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > cowellPropagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, accelerationModelMap, bodiesToPropagate, initialState, 3600.0, cowell );
+    BOOST_CHECK_NO_THROW( SingleArcDynamicsSimulator< >(
+                              bodyMap, integratorSettings, cowellPropagatorSettings, false ) );
+
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > enckePropagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, accelerationModelMap, bodiesToPropagate, initialState, 3600.0, encke );
+    BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                           bodyMap, integratorSettings, enckePropagatorSettings, false ), std::runtime_error );
+
+    // Check that Runge-Kutta-Nystrom integrator is rejected if mass is propagated alongside Cowell translational state.
+    std::map< std::string, std::shared_ptr< MassRateModel > > massRateModels;
+    massRateModels[ "Vehicle" ] = std::make_shared< CustomMassRateModel >( [ ]( const double ){ return -0.01; } );
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > propagatorSettingsList;
+    propagatorSettingsList.push_back( cowellPropagatorSettings );
+    propagatorSettingsList.push_back(
+                std::make_shared< MassPropagatorSettings< double > >(
+                    bodiesToPropagate, massRateModels, Eigen::VectorXd::Constant( 1, 1000.0 ),
+                    std::make_shared< PropagationTimeTerminationSettings >( 3600.0 ) ) );
+    std::shared_ptr< MultiTypePropagatorSettings< double > > multiTypePropagatorSettings =
+            std::make_shared< MultiTypePropagatorSettings< double > >(
+                propagatorSettingsList, std::make_shared< PropagationTimeTerminationSettings >( 3600.0 ) );
+    BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                           bodyMap, integratorSettings, multiTypePropagatorSettings, false ), std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 
@@ -0,0 +1,324 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/Mathematics/Statistics/basicStatistics.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+#include "Tudat/SimulationSetup/PropagationSetup/ensembleDynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+//! Function to create a (non-integrated) simulator for a vehicle orbiting the Earth, with its own environment.
+std::shared_ptr< SingleArcDynamicsSimulator< > > createVehicleSimulator(
+        const bool useAerodynamicAcceleration, const int saveFrequency = 1, const bool terminateExactlyOnFinalCondition = true,
+        const bool clearNumericalSolutions = false )
+{
+    double initialEphemerisTime = 0.0;
+    double finalEphemerisTime = 86400.0;
+
+    // Create bodies needed in simulation
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth" }, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+    bodySettings[ "Earth" ]->gravityFieldSettings = std::make_shared< GravityFieldSettings >( central_spice );
+    bodySettings[ "Earth" ]->atmosphereSettings = std::make_shared< ExponentialAtmosphereSettings >( aerodynamics::earth );
+
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 500.0 );
+    bodyMap[ "Vehicle" ]->setAerodynamicCoefficientInterface(
+                createConstantCoefficientAerodynamicCoefficientInterface(
+                    ( Eigen::Vector3d( ) << 2.2, 0.0, 0.0 ).finished( ), Eigen::Vector3d::Zero( ),
+                    1.0, 4.0, 1.0, Eigen::Vector3d::Zero( ), true, true ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Set accelerations acting on vehicle
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    if( useAerodynamicAcceleration )
+    {
+        accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( aerodynamic ) );
+    }
+
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    // Set nominal initial state
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 6378.0E3 + 350.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.001;
+    initialKeplerElements( inclinationIndex ) = 0.9;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( ) );
+
+    // Create settings for propagation
+    std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      altitude_dependent_variable, "Vehicle", "Earth" ) );
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >
+            ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialState,
+              std::make_shared< PropagationTimeTerminationSettings >(
+                  finalEphemerisTime, terminateExactlyOnFinalCondition ), cowell,
+              std::make_shared< DependentVariableSaveSettings >( dependentVariables, false ) );
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+            ( initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 300.0, 1.0E-12, 1.0E-12,
+              saveFrequency );
+
+    return std::make_shared< SingleArcDynamicsSimulator< > >(
+                bodyMap, integratorSettings, propagatorSettings, false, clearNumericalSolutions, clearNumericalSolutions );
+}
+
+//! Function to create a list of initial state dispersions
+std::vector< Eigen::VectorXd > getInitialStateDispersions( const unsigned int numberOfMembers )
+{
+    std::vector< Eigen::VectorXd > initialStateDispersions;
+    for( unsigned int i = 0; i < numberOfMembers; i++ )
+    {
+        Eigen::VectorXd currentDispersion = Eigen::VectorXd::Zero( 6 );
+        currentDispersion( i % 3 ) = 100.0 * static_cast< double >( i );
+        currentDispersion( 3 + ( i + 1 ) % 3 ) = -0.1 * static_cast< double >( i );
+        initialStateDispersions.push_back( currentDispersion );
+    }
+    return initialStateDispersions;
+}
+
+BOOST_AUTO_TEST_SUITE( test_ensemble_propagation )
+
+//! Test whether ensemble of Kepler orbits is propagated correctly, independently of the number of threads
+BOOST_AUTO_TEST_CASE( testKeplerEnsemblePropagation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    unsigned int numberOfMembers = 7;
+    std::vector< Eigen::VectorXd > initialStateDispersions = getInitialStateDispersions( numberOfMembers );
+
+    // Propagate each member individually
+    std::shared_ptr< SingleArcDynamicsSimulator< > > serialSimulator = createVehicleSimulator( false );
+    Eigen::VectorXd nominalInitialState = serialSimulator->getPropagatorSettings( )->getInitialStates( );
+    double gravitationalParameter =
+            serialSimulator->getNamedBodyMap( ).at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( );
+
+    std::vector< double > serialFinalTimes;
+    std::vector< Eigen::VectorXd > serialFinalStates;
+    for( unsigned int i = 0; i < numberOfMembers; i++ )
+    {
+        serialSimulator->integrateEquationsOfMotion( nominalInitialState + initialStateDispersions.at( i ) );
+        serialFinalTimes.push_back( serialSimulator->getEquationsOfMotionNumericalSolution( ).rbegin( )->first );
+        serialFinalStates.push_back( serialSimulator->getEquationsOfMotionNumericalSolution( ).rbegin( )->second );
+
+        // Check against analytical solution
+        Eigen::Vector6d expectedFinalState = convertKeplerianToCartesianElements(
+                    propagateKeplerOrbit( convertCartesianToKeplerianElements(
+                                              Eigen::Vector6d( nominalInitialState + initialStateDispersions.at( i ) ),
+                                              gravitationalParameter ),
+                                          serialFinalTimes.at( i ), gravitationalParameter ),
+                    gravitationalParameter );
+        BOOST_CHECK_SMALL( ( serialFinalStates.at( i ).segment( 0, 3 ) - expectedFinalState.segment( 0, 3 ) ).norm( ), 0.1 );
+        BOOST_CHECK_SMALL( ( serialFinalStates.at( i ).segment( 3, 3 ) - expectedFinalState.segment( 3, 3 ) ).norm( ), 1.0E-4 );
+    }
+
+    // Propagate ensemble with various numbers of threads, and compare to serial results.
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 5; numberOfThreads++ )
+    {
+        EnsembleDynamicsSimulator< > ensembleSimulator(
+                    std::bind( &createVehicleSimulator, false, 1, true, false ), numberOfThreads );
+        BOOST_CHECK_EQUAL( ensembleSimulator.getThreadSimulators( ).size( ), numberOfThreads );
+
+        ensembleSimulator.propagateEnsemble( initialStateDispersions, nullptr, true );
+
+        std::vector< double > finalTimes = ensembleSimulator.getFinalTimes( );
+        std::vector< Eigen::VectorXd > finalStates = ensembleSimulator.getFinalStates( );
+        std::vector< std::shared_ptr< PropagationTerminationDetails > > terminationReasons =
+                ensembleSimulator.getPropagationTerminationReasons( );
+        std::vector< std::map< double, Eigen::VectorXd > > stateHistories = ensembleSimulator.getStateHistories( );
+
+        BOOST_CHECK_EQUAL( finalStates.size( ), numberOfMembers );
+        BOOST_CHECK_EQUAL( stateHistories.size( ), numberOfMembers );
+        for( unsigned int i = 0; i < numberOfMembers; i++ )
+        {
+            BOOST_CHECK_EQUAL( finalTimes.at( i ), serialFinalTimes.at( i ) );
+            BOOST_CHECK_EQUAL( terminationReasons.at( i )->getPropagationTerminationReason( ),
+                               termination_condition_reached );
+            BOOST_CHECK_EQUAL( stateHistories.at( i ).rbegin( )->first, serialFinalTimes.at( i ) );
+            for( unsigned int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( finalStates.at( i )( j ), serialFinalStates.at( i )( j ) );
+                BOOST_CHECK_EQUAL( stateHistories.at( i ).rbegin( )->second( j ), serialFinalStates.at( i )( j ) );
+            }
+        }
+
+        // Check ensemble statistics
+        Eigen::VectorXd expectedMean = statistics::computeSampleMean( serialFinalStates );
+        Eigen::MatrixXd expectedCovariance = statistics::computeSampleCovariance( serialFinalStates );
+        Eigen::VectorXd computedMean = ensembleSimulator.getFinalStateSampleMean( );
+        Eigen::MatrixXd computedCovariance = ensembleSimulator.getFinalStateSampleCovariance( );
+        for( unsigned int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_EQUAL( computedMean( j ), expectedMean( j ) );
+            for( unsigned int k = 0; k < 6; k++ )
+            {
+                BOOST_CHECK_EQUAL( computedCovariance( j, k ), expectedCovariance( j, k ) );
+            }
+        }
+    }
+
+    // Check that inconsistent dispersions are rejected
+    EnsembleDynamicsSimulator< > ensembleSimulator( std::bind( &createVehicleSimulator, false, 1, true, false ), 2 );
+    initialStateDispersions.at( 3 ) = Eigen::VectorXd::Zero( 3 );
+    BOOST_CHECK_THROW( ensembleSimulator.propagateEnsemble( initialStateDispersions ), std::runtime_error );
+
+    // Check that environment shared between threads is rejected
+    BOOST_CHECK_THROW( EnsembleDynamicsSimulator< >( [ = ]( ){ return serialSimulator; }, 2 ), std::runtime_error );
+}
+
+//! Test whether ensemble with perturbed environment is propagated correctly, independently of the number of threads
+BOOST_AUTO_TEST_CASE( testPerturbedEnvironmentEnsemblePropagation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    unsigned int numberOfMembers = 6;
+    std::vector< Eigen::VectorXd > initialStateDispersions( numberOfMembers, Eigen::VectorXd::Zero( 6 ) );
+
+    // Define function to perturb the vehicle mass of each member
+    std::function< void( const unsigned int, const NamedBodyMap& ) > environmentPerturbationFunction =
+            [ ]( const unsigned int memberIndex, const NamedBodyMap& bodyMap )
+    {
+        bodyMap.at( "Vehicle" )->setConstantBodyMass( 250.0 + 100.0 * static_cast< double >( memberIndex ) );
+    };
+
+    // Propagate each member individually
+    std::shared_ptr< SingleArcDynamicsSimulator< > > serialSimulator = createVehicleSimulator( true );
+    Eigen::VectorXd nominalInitialState = serialSimulator->getPropagatorSettings( )->getInitialStates( );
+    std::vector< Eigen::VectorXd > serialFinalStates;
+    std::vector< Eigen::VectorXd > serialFinalDependentVariables;
+    for( unsigned int i = 0; i < numberOfMembers; i++ )
+    {
+        environmentPerturbationFunction( i, serialSimulator->getNamedBodyMap( ) );
+        serialSimulator->integrateEquationsOfMotion( nominalInitialState );
+        serialFinalStates.push_back( serialSimulator->getEquationsOfMotionNumericalSolution( ).rbegin( )->second );
+        serialFinalDependentVariables.push_back( serialSimulator->getDependentVariableHistory( ).rbegin( )->second );
+
+        // Check that heavier vehicle decays less
+        if( i > 0 )
+        {
+            BOOST_CHECK( serialFinalDependentVariables.at( i )( 0 ) > serialFinalDependentVariables.at( i - 1 )( 0 ) );
+        }
+    }
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 4; numberOfThreads++ )
+    {
+        EnsembleDynamicsSimulator< > ensembleSimulator(
+                    std::bind( &createVehicleSimulator, true, 1, true, false ), numberOfThreads );
+        ensembleSimulator.propagateEnsemble( initialStateDispersions, environmentPerturbationFunction );
+
+        std::vector< Eigen::VectorXd > finalStates = ensembleSimulator.getFinalStates( );
+        std::vector< Eigen::VectorXd > finalDependentVariables = ensembleSimulator.getFinalDependentVariables( );
+        BOOST_CHECK_EQUAL( ensembleSimulator.getStateHistories( ).size( ), 0 );
+        for( unsigned int i = 0; i < numberOfMembers; i++ )
+        {
+            for( unsigned int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( finalStates.at( i )( j ), serialFinalStates.at( i )( j ) );
+            }
+            BOOST_CHECK_EQUAL( finalDependentVariables.at( i )( 0 ), serialFinalDependentVariables.at( i )( 0 ) );
+        }
+    }
+}
+
+//! Test whether final results of ensemble members are those at the end of the propagation, also if they are not saved
+BOOST_AUTO_TEST_CASE( testEnsembleFinalStateWithReducedSaving )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    unsigned int numberOfMembers = 4;
+    std::vector< Eigen::VectorXd > initialStateDispersions = getInitialStateDispersions( numberOfMembers );
+
+    // Propagate each member individually, saving each step, and terminating on the first step beyond the final time
+    std::shared_ptr< SingleArcDynamicsSimulator< > > serialSimulator = createVehicleSimulator( true, 1, false );
+    Eigen::VectorXd nominalInitialState = serialSimulator->getPropagatorSettings( )->getInitialStates( );
+    std::vector< double > serialFinalTimes;
+    std::vector< Eigen::VectorXd > serialFinalStates;
+    std::vector< Eigen::VectorXd > serialFinalDependentVariables;
+    for( unsigned int i = 0; i < numberOfMembers; i++ )
+    {
+        serialSimulator->integrateEquationsOfMotion( nominalInitialState + initialStateDispersions.at( i ) );
+        serialFinalTimes.push_back( serialSimulator->getEquationsOfMotionNumericalSolution( ).rbegin( )->first );
+        serialFinalStates.push_back( serialSimulator->getEquationsOfMotionNumericalSolution( ).rbegin( )->second );
+        serialFinalDependentVariables.push_back( serialSimulator->getDependentVariableHistory( ).rbegin( )->second );
+        BOOST_CHECK( serialFinalTimes.at( i ) > 86400.0 );
+
+        BOOST_CHECK_EQUAL( serialSimulator->getFinalPropagationTime( ), serialFinalTimes.at( i ) );
+        for( unsigned int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_EQUAL( serialSimulator->getFinalPropagatedState( )( j ), serialFinalStates.at( i )( j ) );
+        }
+        BOOST_CHECK_EQUAL( serialSimulator->getFinalDependentVariables( )( 0 ), serialFinalDependentVariables.at( i )( 0 ) );
+    }
+
+    // Propagate ensemble, saving only every 7th step (with and without clearing the numerical solutions), and compare
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        bool clearNumericalSolutions = ( testCase == 1 );
+        EnsembleDynamicsSimulator< > ensembleSimulator(
+                    std::bind( &createVehicleSimulator, true, 7, false, clearNumericalSolutions ), 2 );
+        BOOST_CHECK_EQUAL( ensembleSimulator.getThreadSimulators( ).at( 0 )->getSetIntegratedResult( ), false );
+        ensembleSimulator.propagateEnsemble( initialStateDispersions, nullptr, true );
+
+        std::vector< double > finalTimes = ensembleSimulator.getFinalTimes( );
+        std::vector< Eigen::VectorXd > finalStates = ensembleSimulator.getFinalStates( );
+        std::vector< Eigen::VectorXd > finalDependentVariables = ensembleSimulator.getFinalDependentVariables( );
+        std::vector< std::map< double, Eigen::VectorXd > > stateHistories = ensembleSimulator.getStateHistories( );
+        for( unsigned int i = 0; i < numberOfMembers; i++ )
+        {
+            BOOST_CHECK_EQUAL( finalTimes.at( i ), serialFinalTimes.at( i ) );
+            for( unsigned int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( finalStates.at( i )( j ), serialFinalStates.at( i )( j ) );
+            }
+            BOOST_CHECK_EQUAL( finalDependentVariables.at( i ).rows( ), 1 );
+            BOOST_CHECK_EQUAL( finalDependentVariables.at( i )( 0 ), serialFinalDependentVariables.at( i )( 0 ) );
+
+            // Check that histories are retained, but need not contain the final state
+            BOOST_CHECK( stateHistories.at( i ).size( ) > 1 );
+            BOOST_CHECK( stateHistories.at( i ).rbegin( )->first <= serialFinalTimes.at( i ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
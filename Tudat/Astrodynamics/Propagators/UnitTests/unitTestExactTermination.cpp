@@ -24,6 +24,7 @@
 
 #include "Tudat/External/SpiceInterface/spiceInterface.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
 #include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
@@ -348,6 +349,145 @@ BOOST_AUTO_TEST_CASE( testEnckePopagatorForSphericalHarmonicCentralBodies )
     }
 }
 
+//! Test exact termination with integrators that provide dense output, to see if the final state is obtained from an
+//! integration step to the final time (and is not affected by the interpolation error of the dense output). A harmonic
+//! oscillator (x(t) = cos(t), v(t) = -sin(t)) is propagated with RKF7(8) and DP8(7) integrators, terminating exactly on a
+//! final time, and on a final value of the position.
+BOOST_AUTO_TEST_CASE( testExactTerminationWithDenseOutput )
+{
+    using namespace numerical_integrators;
+    using namespace propagators;
+
+    // Create state derivative function, storing the current position to be used as (termination) dependent variable
+    std::shared_ptr< double > currentPosition = std::make_shared< double >( TUDAT_NAN );
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ = ]( const double, const Eigen::VectorXd& state )
+    {
+        *currentPosition = state( 0 );
+        return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+    };
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+
+    std::vector< RungeKuttaCoefficients::CoefficientSets > coefficientSets =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg78, RungeKuttaCoefficients::rungeKutta87DormandPrince };
+    for( unsigned int integratorCase = 0; integratorCase < coefficientSets.size( ); integratorCase++ )
+    {
+        for( unsigned int terminationCase = 0; terminationCase < 2; terminationCase++ )
+        {
+            // Terminate exactly at t = 10, or when x first drops below -0.5 (at t = 2 pi / 3)
+            std::shared_ptr< PropagationTerminationCondition > terminationCondition;
+            if( terminationCase == 0 )
+            {
+                terminationCondition = std::make_shared< FixedTimePropagationTerminationCondition >( 10.0, true, true );
+            }
+            else
+            {
+                terminationCondition = std::make_shared< SingleVariableLimitPropagationTerminationCondition >(
+                            nullptr, [ = ]( ){ return *currentPosition; }, -0.5, true, true,
+                            std::make_shared< root_finders::RootFinderSettings >(
+                                root_finders::bisection_root_finder, 1.0E-14, 100 ) );
+            }
+
+            // Propagate dynamics
+            std::shared_ptr< RungeKuttaVariableStepSizeSettings< > > integratorSettings =
+                    std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                        0.0, 0.1, coefficientSets.at( integratorCase ), 1.0E-4, 1.0, 1.0E-13, 1.0E-13 );
+            std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+            std::map< double, double > computationTimeHistory;
+            EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                        stateDerivativeFunction, stateHistory, initialState, integratorSettings, terminationCondition,
+                        dependentVariableHistory, computationTimeHistory,
+                        [ = ]( ){ return ( Eigen::VectorXd( 1 ) << *currentPosition ).finished( ); } );
+
+            // Check final time
+            const double finalTime = stateHistory.rbegin( )->first;
+            const Eigen::VectorXd finalState = stateHistory.rbegin( )->second;
+            if( terminationCase == 0 )
+            {
+                BOOST_CHECK_SMALL( finalTime - 10.0, 1.0E-14 );
+            }
+            else
+            {
+                // Final time is located using the dense output, so termination variable is met to within interpolation error
+                BOOST_CHECK_SMALL( finalTime - 2.0 * mathematical_constants::PI / 3.0, 1.0E-10 );
+                BOOST_CHECK_SMALL( finalState( 0 ) + 0.5, 1.0E-10 );
+            }
+
+            // Check final state against analytical solution, to within integration tolerance
+            BOOST_CHECK_SMALL( finalState( 0 ) - std::cos( finalTime ), 1.0E-11 );
+            BOOST_CHECK_SMALL( finalState( 1 ) + std::sin( finalTime ), 1.0E-11 );
+
+            // Check that final state is obtained from a single integration step from the second to last state
+            const double secondToLastTime = std::prev( stateHistory.end( ), 2 )->first;
+            RungeKuttaVariableStepSizeIntegratorXd singleStepIntegrator(
+                        RungeKuttaCoefficients::get( coefficientSets.at( integratorCase ) ), stateDerivativeFunction,
+                        secondToLastTime, std::prev( stateHistory.end( ), 2 )->second, 1.0E-4, 1.0, 1.0E-13, 1.0E-13 );
+            singleStepIntegrator.setStepSizeControl( false );
+            Eigen::VectorXd singleStepFinalState =
+                    singleStepIntegrator.performIntegrationStep( finalTime - secondToLastTime );
+            for( unsigned int i = 0; i < 2; i++ )
+            {
+                BOOST_CHECK_SMALL( finalState( i ) - singleStepFinalState( i ), 1.0E-15 );
+            }
+        }
+    }
+}
+
+//! Test whether a termination condition on a dependent variable is checked at the end of each step, when saving the
+//! dense output of the integrator at an interval that exceeds the step size. A harmonic oscillator (x(t) = cos(t)) is
+//! propagated with fixed steps of 0.1, until x drops below -0.5 (at t = 2 pi / 3 = 2.094). The dense output is saved
+//! every 0.41, so that the last output epoch before the crossing (t = 2.05) lies in the step in which it occurs.
+BOOST_AUTO_TEST_CASE( testDependentVariableTerminationWithDenseOutputSaving )
+{
+    using namespace numerical_integrators;
+    using namespace propagators;
+
+    // Create state derivative function, storing the current position to be used as (termination) dependent variable
+    std::shared_ptr< double > currentPosition = std::make_shared< double >( TUDAT_NAN );
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ = ]( const double, const Eigen::VectorXd& state )
+    {
+        *currentPosition = state( 0 );
+        return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+    };
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+
+    for( unsigned int terminationCase = 0; terminationCase < 2; terminationCase++ )
+    {
+        // Terminate at first step after x drops below -0.5, or exactly when it does
+        const bool terminateExactly = ( terminationCase == 1 );
+        std::shared_ptr< PropagationTerminationCondition > terminationCondition =
+                std::make_shared< SingleVariableLimitPropagationTerminationCondition >(
+                    nullptr, [ = ]( ){ return *currentPosition; }, -0.5, true, terminateExactly,
+                    terminateExactly ? std::make_shared< root_finders::RootFinderSettings >(
+                                           root_finders::bisection_root_finder, 1.0E-14, 100 ) : nullptr );
+
+        // Propagate dynamics with fixed step size (tolerances are set such that each step is accepted)
+        std::shared_ptr< RungeKuttaVariableStepSizeSettings< > > integratorSettings =
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 0.1, RungeKuttaCoefficients::rungeKuttaFehlberg78, 0.1, 0.1, 1.0, 1.0 );
+        integratorSettings->denseOutputSaveInterval_ = 0.41;
+        std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        std::map< double, double > computationTimeHistory;
+        EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistory, initialState, integratorSettings, terminationCondition,
+                    dependentVariableHistory, computationTimeHistory,
+                    [ = ]( ){ return ( Eigen::VectorXd( 1 ) << *currentPosition ).finished( ); } );
+
+        // Check that propagation is terminated in (or at the end of) the step in which the crossing occurs
+        if( terminateExactly )
+        {
+            BOOST_CHECK_SMALL( stateHistory.rbegin( )->first - 2.0 * mathematical_constants::PI / 3.0, 1.0E-8 );
+            BOOST_CHECK_SMALL( stateHistory.rbegin( )->second( 0 ) + 0.5, 1.0E-8 );
+        }
+        else
+        {
+            BOOST_CHECK_SMALL( computationTimeHistory.rbegin( )->first - 2.1, 1.0E-12 );
+            BOOST_CHECK_SMALL( stateHistory.rbegin( )->first - 5.0 * 0.41, 1.0E-12 );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
@@ -0,0 +1,186 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+BOOST_AUTO_TEST_SUITE( test_fixed_size_state_propagation )
+
+//! Test whether propagation of a single body with a fixed-size state reproduces the dynamically-sized propagation exactly
+BOOST_AUTO_TEST_CASE( testFixedSizeStatePropagation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 4.0 * 3600.0;
+    std::vector< std::string > bodyNames = { "Earth", "Moon", "Sun" };
+    NamedBodyMap bodyMap = createBodies(
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 ) );
+    bodyMap[ "Vehicle0" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle1" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle0" ]->setConstantBodyMass( 500.0 );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Define initial state of vehicles
+    double earthGravitationalParameter = bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( );
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.05;
+    initialKeplerElements( inclinationIndex ) = 1.2;
+    initialKeplerElements( longitudeOfAscendingNodeIndex ) = 0.4;
+    Eigen::VectorXd initialStates = Eigen::VectorXd::Zero( 12 );
+    initialStates.segment( 0, 6 ) = convertKeplerianToCartesianElements(
+                initialKeplerElements, earthGravitationalParameter );
+    initialKeplerElements( inclinationIndex ) = 0.2;
+    initialStates.segment( 6, 6 ) = convertKeplerianToCartesianElements(
+                initialKeplerElements, earthGravitationalParameter );
+
+    // Test cases: Cowell (state size 6), unified state model (7, post-processed), Cowell with mass (7) and two bodies (12)
+    for( unsigned int testCase = 0; testCase < 4; testCase++ )
+    {
+        std::vector< std::string > bodiesToIntegrate = { "Vehicle0" };
+        std::vector< std::string > centralBodies = { "Earth" };
+        if( testCase == 3 )
+        {
+            bodiesToIntegrate.push_back( "Vehicle1" );
+            centralBodies.push_back( "Earth" );
+        }
+
+        // Create accelerations, with a spherical harmonic field and third-body perturbations
+        SelectedAccelerationMap accelerationMap;
+        for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+        {
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Earth" ].push_back(
+                        std::make_shared< SphericalHarmonicAccelerationSettings >( 8, 8 ) );
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Moon" ].push_back(
+                        std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Sun" ].push_back(
+                        std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        }
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+        std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+        dependentVariables.push_back(
+                    std::make_shared< SingleDependentVariableSaveSettings >(
+                        relative_distance_dependent_variable, "Vehicle0", "Moon" ) );
+        dependentVariables.push_back(
+                    std::make_shared< SingleAccelerationDependentVariableSaveSettings >(
+                        spherical_harmonic_gravity, "Vehicle0", "Earth" ) );
+
+        // Create propagator settings for current case
+        std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate,
+                  initialStates.segment( 0, 6 * bodiesToIntegrate.size( ) ),
+                  std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ),
+                  ( testCase == 1 ) ? unified_state_model_quaternions : cowell );
+        if( testCase == 2 )
+        {
+            std::map< std::string, std::shared_ptr< MassRateModel > > massRateModels;
+            massRateModels[ "Vehicle0" ] = std::make_shared< CustomMassRateModel >(
+                        [ ]( const double ){ return -0.01; } );
+            std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > propagatorSettingsList;
+            propagatorSettingsList.push_back( propagatorSettings );
+            propagatorSettingsList.push_back(
+                        std::make_shared< MassPropagatorSettings< double > >(
+                            std::vector< std::string >{ "Vehicle0" }, massRateModels,
+                            ( Eigen::VectorXd( 1 ) << 500.0 ).finished( ),
+                            std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) ) );
+            propagatorSettings = std::make_shared< MultiTypePropagatorSettings< double > >(
+                        propagatorSettingsList,
+                        std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) );
+        }
+        propagatorSettings->resetDependentVariablesToSave(
+                    std::make_shared< DependentVariableSaveSettings >( dependentVariables, false ) );
+
+        // Propagate with dynamically-sized state and (if possible) fixed-size state
+        std::vector< std::map< double, Eigen::VectorXd > > stateHistories;
+        std::vector< std::map< double, Eigen::VectorXd > > dependentVariableHistories;
+        for( unsigned int useFixedSizeState = 0; useFixedSizeState < 2; useFixedSizeState++ )
+        {
+            std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                    std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+                    ( initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                      1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+            SingleArcDynamicsSimulator< > dynamicsSimulator(
+                        bodyMap, integratorSettings, propagatorSettings, false );
+            dynamicsSimulator.setUseFixedSizeStatePropagation( useFixedSizeState == 1 );
+            dynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+
+            BOOST_CHECK_EQUAL( dynamicsSimulator.isFixedSizeStatePropagationUsed( ),
+                               ( useFixedSizeState == 1 ) && ( testCase < 3 ) );
+            BOOST_CHECK_EQUAL( dynamicsSimulator.getPropagationTerminationReason( )->getPropagationTerminationReason( ),
+                               termination_condition_reached );
+
+            stateHistories.push_back( dynamicsSimulator.getEquationsOfMotionNumericalSolution( ) );
+            dependentVariableHistories.push_back( dynamicsSimulator.getDependentVariableHistory( ) );
+        }
+
+        // Compare results, which should be identical
+        BOOST_CHECK( stateHistories.at( 0 ).size( ) > 20 );
+        BOOST_CHECK_EQUAL( stateHistories.at( 0 ).size( ), stateHistories.at( 1 ).size( ) );
+        BOOST_CHECK_EQUAL( dependentVariableHistories.at( 0 ).size( ), dependentVariableHistories.at( 1 ).size( ) );
+        BOOST_CHECK_EQUAL( stateHistories.at( 0 ).begin( )->second.rows( ),
+                           ( testCase == 3 ) ? 12 : ( ( testCase == 2 ) ? 7 : 6 ) );
+
+        auto fixedSizeStateIterator = stateHistories.at( 1 ).begin( );
+        for( auto stateIterator : stateHistories.at( 0 ) )
+        {
+            BOOST_CHECK_EQUAL( stateIterator.first, fixedSizeStateIterator->first );
+            for( int i = 0; i < stateIterator.second.rows( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( stateIterator.second( i ), fixedSizeStateIterator->second( i ) );
+            }
+            fixedSizeStateIterator++;
+        }
+
+        auto fixedSizeDependentVariableIterator = dependentVariableHistories.at( 1 ).begin( );
+        for( auto dependentVariableIterator : dependentVariableHistories.at( 0 ) )
+        {
+            BOOST_CHECK_EQUAL( dependentVariableIterator.first, fixedSizeDependentVariableIterator->first );
+            for( int i = 0; i < dependentVariableIterator.second.rows( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( dependentVariableIterator.second( i ),
+                                   fixedSizeDependentVariableIterator->second( i ) );
+            }
+            fixedSizeDependentVariableIterator++;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
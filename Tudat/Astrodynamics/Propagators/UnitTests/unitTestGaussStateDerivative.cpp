@@ -461,6 +461,64 @@ BOOST_AUTO_TEST_CASE( testGaussPopagatorForSphericalHarmonicCentralBodies )
         }
     }
 }
+//! Test whether the Gauss propagators are rejected when using an integrator for second-order systems.
+BOOST_AUTO_TEST_CASE( testGaussPropagatorWithSecondOrderIntegrator )
+{
+    using namespace tudat::numerical_integrators;
+    using namespace tudat::simulation_setup;
+    using namespace tudat::basic_astrodynamics;
+    using namespace tudat::orbital_element_conversions;
+    using namespace tudat::propagators;
+
+    // Create central body and vehicle (without using Spice).
+    const double earthGravitationalParameter = 3.986004418E14;
+    NamedBodyMap bodyMap;
+    bodyMap[ "Earth" ] = std::make_shared< Body >( );
+    bodyMap[ "Earth" ]->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                          Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" ) );
+    bodyMap[ "Earth" ]->setGravityFieldModel(
+                std::make_shared< gravitation::GravityFieldModel >( earthGravitationalParameter ) );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Create acceleration models.
+    std::vector< std::string > bodiesToPropagate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToPropagate, centralBodies );
+
+    // Define initial state.
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.05;
+    initialKeplerElements( inclinationIndex ) = 0.8;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, earthGravitationalParameter );
+
+    // Check that Gauss-Jackson integrator is only accepted for the Cowell propagator, which propagates positions and
+    // velocities.
+    std::shared_ptr< IntegratorSettings< > > integratorSettings = std::make_shared< GaussJacksonSettings< > >( 0.0, 10.0 );
+    std::vector< TranslationalPropagatorType > propagatorTypes = { cowell, gauss_keplerian, gauss_modified_equinoctial };
+    for( unsigned int i = 0; i < propagatorTypes.size( ); i++ )
+    {
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                    centralBodies, accelerationModelMap, bodiesToPropagate, initialState, 3600.0, propagatorTypes.at( i ) );
+        if( propagatorTypes.at( i ) == cowell )
+        {
+            BOOST_CHECK_NO_THROW( SingleArcDynamicsSimulator< >(
+                                      bodyMap, integratorSettings, propagatorSettings, false ) );
+        }
+        else
+        {
+            BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >(
+                                   bodyMap, integratorSettings, propagatorSettings, false ), std::runtime_error );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 
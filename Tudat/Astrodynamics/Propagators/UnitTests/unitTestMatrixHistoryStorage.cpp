@@ -0,0 +1,252 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/Propagators/matrixHistoryStorage.h"
+#include "Tudat/Mathematics/Interpolators/chebyshevMatrixInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+#include "Tudat/Basics/utilities.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace propagators;
+
+//! Function to compute a smooth 6x9 test matrix as a function of time.
+Eigen::MatrixXd computeTestMatrix( const double currentTime )
+{
+    Eigen::MatrixXd currentMatrix = Eigen::MatrixXd( 6, 9 );
+    for( int j = 0; j < 6; j++ )
+    {
+        for( int k = 0; k < 9; k++ )
+        {
+            currentMatrix( j, k ) = std::pow( 10.0, j - k ) * std::sin( 1.0E-3 * ( j + 1 ) * currentTime + k ) +
+                    ( j == k ? 1.0 : 0.0 );
+        }
+    }
+    return currentMatrix;
+}
+
+//! Function to create a smooth history of 6x9 matrices, on an irregular grid of epochs.
+std::map< double, Eigen::MatrixXd > createTestMatrixHistory( )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory;
+    double currentTime = 0.0;
+    for( int i = 0; i < 200; i++ )
+    {
+        matrixHistory[ currentTime ] = computeTestMatrix( currentTime );
+        currentTime += 50.0 + 10.0 * std::sin( static_cast< double >( i ) );
+    }
+    return matrixHistory;
+}
+
+BOOST_AUTO_TEST_SUITE( test_matrix_history_storage )
+
+//! Test whether matrices are stored and retrieved correctly from a memory-mapped file
+BOOST_AUTO_TEST_CASE( testMemoryMappedMatrixHistory )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory = createTestMatrixHistory( );
+    std::string fileName = ( boost::filesystem::temp_directory_path( ) /
+                             boost::filesystem::unique_path( "testMatrixHistory-%%%%-%%%%.dat" ) ).string( );
+
+    for( unsigned int test = 0; test < 2; test++ )
+    {
+        bool storeAsFloatDeltas = ( test == 1 );
+        std::map< double, Eigen::MatrixXd > matrixHistoryToStore = matrixHistory;
+        {
+            MemoryMappedMatrixHistory memoryMappedHistory( matrixHistoryToStore, fileName, storeAsFloatDeltas, true );
+
+            // Check that input is cleared, and that file has expected size
+            BOOST_CHECK_EQUAL( matrixHistoryToStore.size( ), 0 );
+            BOOST_CHECK_EQUAL( boost::filesystem::file_size( fileName ),
+                               matrixHistory.size( ) * 54 * ( storeAsFloatDeltas ? sizeof( float ) : sizeof( double ) ) );
+            BOOST_CHECK_EQUAL( memoryMappedHistory.getNumberOfEpochs( ), matrixHistory.size( ) );
+            BOOST_CHECK_EQUAL( memoryMappedHistory.getNumberOfRows( ), 6 );
+            BOOST_CHECK_EQUAL( memoryMappedHistory.getNumberOfColumns( ), 9 );
+
+            // Check retrieved matrices: exact in double precision, to within float precision of difference otherwise
+            int epochIndex = 0;
+            Eigen::MatrixXd retrievedMatrix;
+            for( auto matrixIterator : matrixHistory )
+            {
+                BOOST_CHECK_EQUAL( memoryMappedHistory.getEpochs( ).at( epochIndex ), matrixIterator.first );
+                memoryMappedHistory.getMatrix( epochIndex, retrievedMatrix );
+                if( !storeAsFloatDeltas )
+                {
+                    BOOST_CHECK_EQUAL( ( retrievedMatrix - matrixIterator.second ).cwiseAbs( ).maxCoeff( ), 0.0 );
+                }
+                else
+                {
+                    Eigen::MatrixXd matrixDifference = matrixIterator.second - matrixHistory.begin( )->second;
+                    for( int j = 0; j < 6; j++ )
+                    {
+                        for( int k = 0; k < 9; k++ )
+                        {
+                            BOOST_CHECK_SMALL( retrievedMatrix( j, k ) - matrixIterator.second( j, k ),
+                                               1.0E-7 * std::fabs( matrixDifference( j, k ) ) + 1.0E-300 );
+                        }
+                    }
+                }
+                epochIndex++;
+            }
+            BOOST_CHECK_THROW( memoryMappedHistory.getMatrix( epochIndex ), std::runtime_error );
+        }
+
+        // Check that file is removed after history is destroyed
+        BOOST_CHECK_EQUAL( boost::filesystem::exists( fileName ), false );
+    }
+
+    // Check that input is retained if requested
+    std::map< double, Eigen::MatrixXd > matrixHistoryToStore = matrixHistory;
+    MemoryMappedMatrixHistory memoryMappedHistory( matrixHistoryToStore, fileName, false, false );
+    BOOST_CHECK_EQUAL( matrixHistoryToStore.size( ), matrixHistory.size( ) );
+    std::map< double, Eigen::MatrixXd > retrievedMatrixHistory = memoryMappedHistory.getMatrixHistory( );
+    BOOST_CHECK_EQUAL( retrievedMatrixHistory.size( ), matrixHistory.size( ) );
+    BOOST_CHECK_EQUAL( ( retrievedMatrixHistory.rbegin( )->second - matrixHistory.rbegin( )->second ).norm( ), 0.0 );
+}
+
+//! Test whether interpolation of memory-mapped matrix history is consistent with in-memory Lagrange interpolation.
+BOOST_AUTO_TEST_CASE( testMemoryMappedMatrixInterpolation )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory = createTestMatrixHistory( );
+    std::vector< double > epochs = utilities::createVectorFromMapKeys( matrixHistory );
+
+    // Matrix w.r.t. which differences are stored in single precision
+    Eigen::MatrixXd referenceMatrix = matrixHistory.begin( )->second;
+
+    for( unsigned int numberOfStages = 4; numberOfStages <= 8; numberOfStages += 4 )
+    {
+        interpolators::LagrangeInterpolator< double, Eigen::MatrixXd > inMemoryInterpolator(
+                    epochs, utilities::createVectorFromMapValues( matrixHistory ), numberOfStages );
+
+        for( unsigned int test = 0; test < 2; test++ )
+        {
+            std::map< double, Eigen::MatrixXd > matrixHistoryToStore = matrixHistory;
+            std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >
+                    memoryMappedInterpolator = createMatrixHistoryInterpolator(
+                        matrixHistoryToStore, numberOfStages, std::make_shared< MatrixHistoryStorageSettings >(
+                            test == 0 ? memory_mapped_matrix_history : memory_mapped_float_delta_matrix_history ) );
+            BOOST_CHECK( std::dynamic_pointer_cast< MemoryMappedLagrangeMatrixInterpolator >(
+                             memoryMappedInterpolator ) != nullptr );
+            std::string fileName = std::dynamic_pointer_cast< MemoryMappedLagrangeMatrixInterpolator >(
+                        memoryMappedInterpolator )->getMatrixHistory( )->getFileName( );
+            BOOST_CHECK_EQUAL( boost::filesystem::exists( fileName ), true );
+
+            // Compare interpolated matrices over full domain (including boundaries and nodes), and beyond (only for
+            // double precision storage, as the extrapolation amplifies the single precision rounding errors)
+            std::vector< double > testTimes;
+            for( int i = -10; i < 1100; i++ )
+            {
+                testTimes.push_back( epochs.front( ) + static_cast< double >( i ) / 1000.0 *
+                                     ( epochs.back( ) - epochs.front( ) ) );
+            }
+            testTimes.insert( testTimes.end( ), epochs.begin( ), epochs.end( ) );
+
+            for( unsigned int i = 0; i < testTimes.size( ); i++ )
+            {
+                Eigen::MatrixXd expectedMatrix = inMemoryInterpolator.interpolate( testTimes.at( i ) );
+                Eigen::MatrixXd interpolatedMatrix = memoryMappedInterpolator->interpolate( testTimes.at( i ) );
+                if( test == 0 )
+                {
+                    BOOST_CHECK_EQUAL( ( interpolatedMatrix - expectedMatrix ).cwiseAbs( ).maxCoeff( ), 0.0 );
+                }
+                else if( testTimes.at( i ) >= epochs.front( ) && testTimes.at( i ) <= epochs.back( ) )
+                {
+                    for( int k = 0; k < 9; k++ )
+                    {
+                        BOOST_CHECK_SMALL( ( interpolatedMatrix - expectedMatrix ).col( k ).cwiseAbs( ).maxCoeff( ),
+                                           1.0E-6 * ( expectedMatrix.col( k ).cwiseAbs( ).maxCoeff( ) +
+                                                      referenceMatrix.col( k ).cwiseAbs( ).maxCoeff( ) ) );
+                    }
+                }
+            }
+
+            // Check that file is removed when interpolator is no longer used
+            memoryMappedInterpolator = nullptr;
+            BOOST_CHECK_EQUAL( boost::filesystem::exists( fileName ), false );
+        }
+    }
+
+    // Check in-memory storage through same interface
+    std::map< double, Eigen::MatrixXd > matrixHistoryToStore = matrixHistory;
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > inMemoryInterpolator =
+            createMatrixHistoryInterpolator( matrixHistoryToStore, 4, nullptr, false );
+    typedef interpolators::LagrangeInterpolator< double, Eigen::MatrixXd > MatrixLagrangeInterpolator;
+    BOOST_CHECK( std::dynamic_pointer_cast< MatrixLagrangeInterpolator >( inMemoryInterpolator ) != nullptr );
+    BOOST_CHECK_EQUAL( matrixHistoryToStore.size( ), matrixHistory.size( ) );
+}
+
+//! Test whether Chebyshev storage of matrix history is created correctly, and consistent with its fit residuals.
+BOOST_AUTO_TEST_CASE( testChebyshevMatrixHistoryStorage )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory = createTestMatrixHistory( );
+    std::vector< double > epochs = utilities::createVectorFromMapKeys( matrixHistory );
+
+    std::map< double, Eigen::MatrixXd > matrixHistoryToStore = matrixHistory;
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > chebyshevInterpolator =
+            createMatrixHistoryInterpolator(
+                matrixHistoryToStore, 8, std::make_shared< ChebyshevMatrixHistoryStorageSettings >( 6, 40, 1.0E-8 ) );
+    std::shared_ptr< interpolators::ChebyshevMatrixInterpolator > castChebyshevInterpolator =
+            std::dynamic_pointer_cast< interpolators::ChebyshevMatrixInterpolator >( chebyshevInterpolator );
+    BOOST_CHECK( castChebyshevInterpolator != nullptr );
+    BOOST_CHECK_EQUAL( matrixHistoryToStore.size( ), 0 );
+    double maximumRelativeFitResidual = castChebyshevInterpolator->getMaximumRelativeFitResidual( );
+    BOOST_CHECK( maximumRelativeFitResidual < 1.0E-3 );
+
+    // Compare to analytical matrices, relative to the magnitude of each matrix column over the full history. As the
+    // grid is too coarse to reach the tolerance, the error is compared to the residuals of the fit.
+    Eigen::VectorXd columnMagnitudes = Eigen::VectorXd::Zero( 9 );
+    for( auto matrixIterator : matrixHistory )
+    {
+        for( int k = 0; k < 9; k++ )
+        {
+            columnMagnitudes( k ) = std::max(
+                        columnMagnitudes( k ), matrixIterator.second.col( k ).cwiseAbs( ).maxCoeff( ) );
+        }
+    }
+
+    for( int i = 0; i <= 1000; i++ )
+    {
+        double currentTime = epochs.front( ) + static_cast< double >( i ) / 1000.0 * ( epochs.back( ) - epochs.front( ) );
+        Eigen::MatrixXd matrixDifference = chebyshevInterpolator->interpolate( currentTime ) -
+                computeTestMatrix( currentTime );
+        for( int k = 0; k < 9; k++ )
+        {
+            BOOST_CHECK_SMALL( matrixDifference.col( k ).cwiseAbs( ).maxCoeff( ),
+                               5.0 * maximumRelativeFitResidual * columnMagnitudes( k ) );
+        }
+    }
+
+    // Check that inconsistent settings are rejected
+    matrixHistoryToStore = matrixHistory;
+    BOOST_CHECK_THROW( createMatrixHistoryInterpolator(
+                           matrixHistoryToStore, 8, std::make_shared< MatrixHistoryStorageSettings >(
+                               chebyshev_matrix_history ) ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -242,6 +242,167 @@ BOOST_AUTO_TEST_CASE( testKeplerMultiArcDynamics )
     }
 }
 
+//! Function to create a multi-arc simulator for the Moon w.r.t. the Earth, with a newly created environment
+std::shared_ptr< MultiArcDynamicsSimulator< > > createMoonMultiArcSimulator(
+        const bool transferInitialStateInformationPerArc )
+{
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = 2.0E7;
+    double buffer = 5.0 * 3600.0;
+
+    // Create bodies needed in simulation
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth", "Moon" }, initialEphemerisTime - buffer, finalEphemerisTime + buffer );
+    std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >( bodySettings[ "Moon" ]->ephemerisSettings )->
+            resetFrameOrigin( "Earth" );
+    bodySettings[ "Moon" ]->ephemerisSettings->resetMakeMultiArcEphemeris( true );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Set accelerations and propagation settings (with initial states taken from Spice) per arc
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Moon" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    std::vector< std::string > bodiesToIntegrate = { "Moon" };
+    std::vector< std::string > centralBodies = { "SSB" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    std::vector< double > integrationArcStarts;
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > arcPropagationSettingsList;
+    double arcDuration = 1.0E6;
+    double arcOverlap = 1.0E4;
+    double currentStartTime = initialEphemerisTime + 1.0E4;
+    while( currentStartTime + arcDuration < finalEphemerisTime - 1.0E4 )
+    {
+        integrationArcStarts.push_back( currentStartTime );
+        arcPropagationSettingsList.push_back(
+                    std::make_shared< TranslationalStatePropagatorSettings< double > >
+                    ( centralBodies, accelerationModelMap, bodiesToIntegrate,
+                      spice_interface::getBodyCartesianStateAtEpoch(
+                          "Moon", "Earth", "ECLIPJ2000", "NONE", currentStartTime ), currentStartTime + arcDuration ) );
+        currentStartTime += arcDuration - arcOverlap;
+    }
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+            ( initialEphemerisTime, 120.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0, 3600.0, 1.0E-12, 1.0E-12 );
+    return std::make_shared< MultiArcDynamicsSimulator< > >(
+                bodyMap, integratorSettings, std::make_shared< MultiArcPropagatorSettings< double > >(
+                    arcPropagationSettingsList, transferInitialStateInformationPerArc ), integrationArcStarts, false, false );
+}
+
+//! Test whether parallel propagation of arcs gives results identical to serial propagation
+BOOST_AUTO_TEST_CASE( testParallelMultiArcDynamics )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Test independent arcs (case 0) and arcs taking initial state from previous arc (case 1)
+    for( unsigned testCase = 0; testCase < 2; testCase++ )
+    {
+        bool transferInitialStateInformationPerArc = ( testCase == 1 );
+
+        // Propagate arcs serially
+        std::shared_ptr< MultiArcDynamicsSimulator< > > serialSimulator =
+                createMoonMultiArcSimulator( transferInitialStateInformationPerArc );
+        serialSimulator->integrateEquationsOfMotion(
+                    serialSimulator->getMultiArcPropagatorSettings( )->getInitialStates( ) );
+        std::vector< std::map< double, Eigen::VectorXd > > serialResults =
+                serialSimulator->getEquationsOfMotionNumericalSolution( );
+        BOOST_CHECK_EQUAL( serialSimulator->integrationCompletedSuccessfully( ), true );
+
+        for( unsigned int numberOfThreads = 1; numberOfThreads < 5; numberOfThreads++ )
+        {
+            // Propagate arcs in parallel, using separate environment for each thread
+            std::shared_ptr< MultiArcDynamicsSimulator< > > parallelSimulator =
+                    createMoonMultiArcSimulator( transferInitialStateInformationPerArc );
+            unsigned int numberOfSynchronizations = 0;
+            parallelSimulator->setParallelArcPropagation(
+                        numberOfThreads, std::bind( &createMoonMultiArcSimulator, transferInitialStateInformationPerArc ),
+                        [ & ]( const std::shared_ptr< MultiArcDynamicsSimulator< > >& ){ numberOfSynchronizations++; } );
+            BOOST_CHECK_EQUAL( parallelSimulator->getNumberOfArcPropagationThreads( ), numberOfThreads );
+
+            parallelSimulator->integrateEquationsOfMotion(
+                        parallelSimulator->getMultiArcPropagatorSettings( )->getInitialStates( ) );
+            BOOST_CHECK_EQUAL( parallelSimulator->integrationCompletedSuccessfully( ), true );
+
+            // Check that each worker simulator is synchronized once per propagation
+            BOOST_CHECK_EQUAL( numberOfSynchronizations, numberOfThreads - 1 );
+
+            // Check that results are identical
+            std::vector< std::map< double, Eigen::VectorXd > > parallelResults =
+                    parallelSimulator->getEquationsOfMotionNumericalSolution( );
+            BOOST_CHECK_EQUAL( parallelResults.size( ), serialResults.size( ) );
+            for( unsigned int i = 0; i < serialResults.size( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( parallelResults.at( i ).size( ), serialResults.at( i ).size( ) );
+
+                auto serialIterator = serialResults.at( i ).begin( );
+                auto parallelIterator = parallelResults.at( i ).begin( );
+                for( ; serialIterator != serialResults.at( i ).end( ); serialIterator++, parallelIterator++ )
+                {
+                    BOOST_CHECK_EQUAL( serialIterator->first, parallelIterator->first );
+                    for( int j = 0; j < 6; j++ )
+                    {
+                        BOOST_CHECK_EQUAL( serialIterator->second( j ), parallelIterator->second( j ) );
+                    }
+                }
+            }
+
+            // Check that results and termination details of each arc are retrieved from the single-arc simulators as for
+            // serial propagation (also for arcs propagated by additional threads)
+            std::vector< std::shared_ptr< SingleArcDynamicsSimulator< > > > serialArcSimulators =
+                    serialSimulator->getSingleArcDynamicsSimulators( );
+            std::vector< std::shared_ptr< SingleArcDynamicsSimulator< > > > parallelArcSimulators =
+                    parallelSimulator->getSingleArcDynamicsSimulators( );
+            for( unsigned int i = 0; i < serialArcSimulators.size( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( parallelArcSimulators.at( i )->getPropagationTerminationReason( )->
+                                   getPropagationTerminationReason( ),
+                                   serialArcSimulators.at( i )->getPropagationTerminationReason( )->
+                                   getPropagationTerminationReason( ) );
+                BOOST_CHECK_EQUAL( parallelArcSimulators.at( i )->integrationCompletedSuccessfully( ), true );
+                BOOST_CHECK_EQUAL( parallelArcSimulators.at( i )->getCumulativeComputationTimeHistory( ).size( ),
+                                   serialArcSimulators.at( i )->getCumulativeComputationTimeHistory( ).size( ) );
+                BOOST_CHECK_EQUAL( parallelArcSimulators.at( i )->getCumulativeNumberOfFunctionEvaluations( ).size( ),
+                                   serialArcSimulators.at( i )->getCumulativeNumberOfFunctionEvaluations( ).size( ) );
+
+                const StateHistory< double, Eigen::VectorXd >& serialArcHistory =
+                        serialArcSimulators.at( i )->getEquationsOfMotionNumericalSolutionHistory( );
+                const StateHistory< double, Eigen::VectorXd >& parallelArcHistory =
+                        parallelArcSimulators.at( i )->getEquationsOfMotionNumericalSolutionHistory( );
+                BOOST_CHECK_EQUAL( serialArcHistory.size( ), serialResults.at( i ).size( ) );
+                BOOST_CHECK_EQUAL( parallelArcHistory.size( ), serialArcHistory.size( ) );
+                if( parallelArcHistory.size( ) == serialArcHistory.size( ) )
+                {
+                    for( unsigned int j = 0; j < serialArcHistory.size( ); j++ )
+                    {
+                        BOOST_CHECK_EQUAL( parallelArcHistory.getTime( j ), serialArcHistory.getTime( j ) );
+                        for( int k = 0; k < 6; k++ )
+                        {
+                            BOOST_CHECK_EQUAL( parallelArcHistory.getState( j )( k ), serialArcHistory.getState( j )( k ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Check that sharing the environment between threads is caught
+    std::shared_ptr< MultiArcDynamicsSimulator< > > dynamicsSimulator = createMoonMultiArcSimulator( false );
+    bool isExceptionCaught = false;
+    try
+    {
+        dynamicsSimulator->setParallelArcPropagation( 2, [ & ]( ){ return dynamicsSimulator; } );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 }
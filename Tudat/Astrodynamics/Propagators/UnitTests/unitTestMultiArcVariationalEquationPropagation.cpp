@@ -406,6 +406,175 @@ BOOST_AUTO_TEST_CASE( testEarthMoonMultiArcVariationalEquationCalculation )
     }
 }
 
+//! Function to create a multi-arc variational equations solver for the Moon w.r.t. the Earth, with a newly created
+//! environment
+std::shared_ptr< MultiArcVariationalEquationsSolver< > > createMoonMultiArcVariationalEquationsSolver(
+        const bool transferInitialStateInformationPerArc )
+{
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = 1.6E7;
+    double buffer = 5.0 * 3600.0;
+
+    // Create bodies needed in simulation
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth", "Moon" }, initialEphemerisTime - buffer, finalEphemerisTime + buffer );
+    std::dynamic_pointer_cast< InterpolatedSpiceEphemerisSettings >( bodySettings[ "Moon" ]->ephemerisSettings )->
+            resetFrameOrigin( "Earth" );
+    bodySettings[ "Moon" ]->ephemerisSettings->resetMakeMultiArcEphemeris( true );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Set accelerations and propagation settings (with initial states taken from Spice) per arc
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Moon" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    std::vector< std::string > bodiesToIntegrate = { "Moon" };
+    std::vector< std::string > centralBodies = { "SSB" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    std::vector< double > integrationArcStarts;
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > arcPropagationSettingsList;
+    double arcDuration = 1.0E6;
+    double arcOverlap = 1.0E4;
+    double currentStartTime = initialEphemerisTime + 1.0E4;
+    while( currentStartTime + arcDuration < finalEphemerisTime - 1.0E4 )
+    {
+        integrationArcStarts.push_back( currentStartTime );
+        arcPropagationSettingsList.push_back(
+                    std::make_shared< TranslationalStatePropagatorSettings< double > >
+                    ( centralBodies, accelerationModelMap, bodiesToIntegrate,
+                      spice_interface::getBodyCartesianStateAtEpoch(
+                          "Moon", "Earth", "ECLIPJ2000", "NONE", currentStartTime ), currentStartTime + arcDuration ) );
+        currentStartTime += arcDuration - arcOverlap;
+    }
+    std::shared_ptr< MultiArcPropagatorSettings< double > > propagatorSettings =
+            std::make_shared< MultiArcPropagatorSettings< double > >(
+                arcPropagationSettingsList, transferInitialStateInformationPerArc );
+
+    // Define parameters: arc-wise initial states of Moon, and gravitational parameter of Earth
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back(
+                std::make_shared< ArcWiseInitialTranslationalStateEstimatableParameterSettings< double > >(
+                    "Moon", integrationArcStarts, "SSB" ) );
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    std::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate( parameterNames, bodyMap );
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+            ( initialEphemerisTime, 120.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0, 3600.0, 1.0E-12, 1.0E-12 );
+    return std::make_shared< MultiArcVariationalEquationsSolver< > >(
+                bodyMap, integratorSettings, propagatorSettings, parametersToEstimate, integrationArcStarts,
+                true, std::shared_ptr< IntegratorSettings< double > >( ), false, false );
+}
+
+//! Function to retrieve state transition and sensitivity matrices, and states, at a number of epochs in each arc
+std::vector< Eigen::MatrixXd > getMultiArcVariationalEquationsTestData(
+        const std::shared_ptr< MultiArcVariationalEquationsSolver< > > variationalEquationsSolver )
+{
+    std::vector< Eigen::MatrixXd > testData;
+    std::vector< std::map< double, Eigen::VectorXd > > stateHistory =
+            variationalEquationsSolver->getDynamicsSimulator( )->getEquationsOfMotionNumericalSolution( );
+    std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionMatrixInterface =
+            variationalEquationsSolver->getStateTransitionMatrixInterface( );
+    for( unsigned int i = 0; i < stateHistory.size( ); i++ )
+    {
+        double arcStartTime = stateHistory.at( i ).begin( )->first;
+        double arcEndTime = stateHistory.at( i ).rbegin( )->first;
+        for( int j = 1; j < 5; j++ )
+        {
+            double testEpoch = arcStartTime + static_cast< double >( j ) / 5.0 * ( arcEndTime - arcStartTime );
+            testData.push_back( stateTransitionMatrixInterface->getCombinedStateTransitionAndSensitivityMatrix( testEpoch ) );
+        }
+        testData.push_back( stateHistory.at( i ).rbegin( )->second );
+    }
+    return testData;
+}
+
+//! Test whether parallel propagation of variational equations of arcs gives results identical to serial propagation
+BOOST_AUTO_TEST_CASE( testParallelMultiArcVariationalEquationCalculation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Test independent arcs (case 0) and arcs taking initial state from previous arc (case 1)
+    for( unsigned testCase = 0; testCase < 2; testCase++ )
+    {
+        bool transferInitialStateInformationPerArc = ( testCase == 1 );
+
+        // Propagate arcs serially, with nominal and perturbed gravitational parameter of Earth
+        std::shared_ptr< MultiArcVariationalEquationsSolver< > > serialSolver =
+                createMoonMultiArcVariationalEquationsSolver( transferInitialStateInformationPerArc );
+        Eigen::VectorXd nominalParameters =
+                serialSolver->getParametersToEstimate( )->getFullParameterValues< double >( );
+        Eigen::VectorXd perturbedParameters = nominalParameters;
+        perturbedParameters( perturbedParameters.rows( ) - 1 ) *= ( 1.0 + 1.0E-4 );
+
+        serialSolver->resetParameterEstimate( nominalParameters );
+        std::vector< Eigen::MatrixXd > serialResults = getMultiArcVariationalEquationsTestData( serialSolver );
+        serialSolver->resetParameterEstimate( perturbedParameters );
+        std::vector< Eigen::MatrixXd > serialPerturbedResults = getMultiArcVariationalEquationsTestData( serialSolver );
+
+        for( unsigned int numberOfThreads = 1; numberOfThreads < 4; numberOfThreads++ )
+        {
+            // Propagate arcs in parallel, using separate environment for each thread
+            std::shared_ptr< MultiArcVariationalEquationsSolver< > > parallelSolver =
+                    createMoonMultiArcVariationalEquationsSolver( transferInitialStateInformationPerArc );
+            parallelSolver->setParallelArcPropagation(
+                        numberOfThreads, std::bind( &createMoonMultiArcVariationalEquationsSolver,
+                                                    transferInitialStateInformationPerArc ) );
+            BOOST_CHECK_EQUAL( parallelSolver->getNumberOfArcPropagationThreads( ), numberOfThreads );
+            BOOST_CHECK_EQUAL( parallelSolver->getDynamicsSimulator( )->getNumberOfArcPropagationThreads( ),
+                               numberOfThreads );
+
+            // Check that results are identical, also after modifying parameter values (which are to be transferred to
+            // the environment of each thread)
+            for( unsigned int parameterCase = 0; parameterCase < 2; parameterCase++ )
+            {
+                parallelSolver->resetParameterEstimate(
+                            ( parameterCase == 0 ) ? nominalParameters : perturbedParameters );
+                std::vector< Eigen::MatrixXd > parallelResults = getMultiArcVariationalEquationsTestData( parallelSolver );
+                std::vector< Eigen::MatrixXd >& currentSerialResults =
+                        ( parameterCase == 0 ) ? serialResults : serialPerturbedResults;
+
+                BOOST_CHECK_EQUAL( parallelResults.size( ), currentSerialResults.size( ) );
+                for( unsigned int i = 0; i < currentSerialResults.size( ); i++ )
+                {
+                    BOOST_CHECK_EQUAL( parallelResults.at( i ).rows( ), currentSerialResults.at( i ).rows( ) );
+                    BOOST_CHECK_EQUAL( parallelResults.at( i ).cols( ), currentSerialResults.at( i ).cols( ) );
+                    for( int j = 0; j < currentSerialResults.at( i ).rows( ); j++ )
+                    {
+                        for( int k = 0; k < currentSerialResults.at( i ).cols( ); k++ )
+                        {
+                            BOOST_CHECK_EQUAL( parallelResults.at( i )( j, k ), currentSerialResults.at( i )( j, k ) );
+                        }
+                    }
+                }
+            }
+
+            // Check that propagation of dynamics only is also identical
+            parallelSolver->resetParameterEstimate( perturbedParameters, false );
+            Eigen::VectorXd parallelFinalState =
+                    parallelSolver->getDynamicsSimulator( )->getEquationsOfMotionNumericalSolution( ).back( ).rbegin( )->second;
+            BOOST_CHECK_EQUAL( ( parallelFinalState - serialPerturbedResults.back( ) ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        }
+    }
+
+    // Check that sharing the environment or parameters between threads is caught
+    std::shared_ptr< MultiArcVariationalEquationsSolver< > > variationalEquationsSolver =
+            createMoonMultiArcVariationalEquationsSolver( false );
+    bool isExceptionCaught = false;
+    try
+    {
+        variationalEquationsSolver->setParallelArcPropagation( 2, [ & ]( ){ return variationalEquationsSolver; } );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
 
 BOOST_AUTO_TEST_SUITE_END( )
 
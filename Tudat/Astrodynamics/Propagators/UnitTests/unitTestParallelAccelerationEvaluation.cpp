@@ -0,0 +1,335 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Gravitation/UnitTests/sphericalHarmonicsTestCoefficients.h"
+#include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace gravitation;
+using namespace propagators;
+
+BOOST_AUTO_TEST_SUITE( test_parallel_acceleration_evaluation )
+
+//! Test whether acceleration models are correctly partitioned into independent groups
+BOOST_AUTO_TEST_CASE( testAccelerationModelGrouping )
+{
+    std::function< Eigen::Vector3d( ) > positionFunction = [ ]( ){ return Eigen::Vector3d::UnitX( ); };
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 3, 3 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 3, 3 );
+
+    std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > firstCache =
+            std::make_shared< basic_mathematics::SphericalHarmonicsCache >( );
+    std::shared_ptr< basic_mathematics::SphericalHarmonicsCache > secondCache =
+            std::make_shared< basic_mathematics::SphericalHarmonicsCache >( );
+
+    std::vector< std::shared_ptr< AccelerationModel< Eigen::Vector3d > > > accelerationModelList;
+    std::vector< std::string > namesOfBodiesUndergoingAcceleration;
+
+    // Spherical harmonic accelerations on different bodies, sharing a cache
+    accelerationModelList.push_back(
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients, positionFunction,
+                    [ ]( ){ return Eigen::Quaterniond::Identity( ); }, false, firstCache ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "A" );
+    accelerationModelList.push_back(
+                std::make_shared< CentralGravitationalAccelerationModel3d >( positionFunction, 1.0 ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "B" );
+    accelerationModelList.push_back(
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients, positionFunction,
+                    [ ]( ){ return Eigen::Quaterniond::Identity( ); }, false, firstCache ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "C" );
+
+    // Acceleration on body already undergoing acceleration
+    accelerationModelList.push_back(
+                std::make_shared< CentralGravitationalAccelerationModel3d >( positionFunction, 1.0 ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "A" );
+
+    // Third-body acceleration, of which the acceleration on the central body shares a cache with a direct acceleration
+    accelerationModelList.push_back(
+                std::make_shared< ThirdBodySphericalHarmonicsGravitationalAccelerationModel >(
+                    std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                        positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients ),
+                    std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                        positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients, positionFunction,
+                        [ ]( ){ return Eigen::Quaterniond::Identity( ); }, false, secondCache ), "Central" ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "D" );
+    accelerationModelList.push_back(
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients, positionFunction,
+                    [ ]( ){ return Eigen::Quaterniond::Identity( ); }, false, secondCache ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "E" );
+
+    // Same acceleration model object used for two bodies
+    accelerationModelList.push_back( accelerationModelList.at( 1 ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "F" );
+
+    // Independent acceleration
+    accelerationModelList.push_back(
+                std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                    positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients ) );
+    namesOfBodiesUndergoingAcceleration.push_back( "G" );
+
+    // Spherical harmonic accelerations on different bodies, with separate caches but evaluated by a shared batched cache
+    std::vector< std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > > batchedAccelerationModels;
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        batchedAccelerationModels.push_back(
+                    std::make_shared< SphericalHarmonicsGravitationalAccelerationModel >(
+                        positionFunction, 1.0, 1.0, cosineCoefficients, sineCoefficients ) );
+        accelerationModelList.push_back( batchedAccelerationModels.at( i ) );
+        namesOfBodiesUndergoingAcceleration.push_back( std::string( 1, static_cast< char >( 'H' + i ) ) );
+    }
+    createBatchedSphericalHarmonicsGravityCache( batchedAccelerationModels );
+
+    std::vector< std::vector< unsigned int > > accelerationModelGroups = getIndependentAccelerationModelGroups(
+                accelerationModelList, namesOfBodiesUndergoingAcceleration );
+    std::vector< std::vector< unsigned int > > expectedAccelerationModelGroups =
+    { { 0, 2, 3 }, { 1, 6 }, { 4, 5 }, { 7 }, { 8, 9 } };
+    BOOST_CHECK( accelerationModelGroups == expectedAccelerationModelGroups );
+
+    // Check inconsistent input
+    namesOfBodiesUndergoingAcceleration.pop_back( );
+    BOOST_CHECK_THROW( getIndependentAccelerationModelGroups(
+                           accelerationModelList, namesOfBodiesUndergoingAcceleration ), std::runtime_error );
+}
+
+//! Test whether parallel evaluation of acceleration models of a constellation reproduces the serial results exactly
+BOOST_AUTO_TEST_CASE( testParallelAccelerationEvaluation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 6.0 * 3600.0;
+    std::vector< std::string > bodyNames = { "Earth", "Moon", "Sun" };
+    NamedBodyMap bodyMap = createBodies(
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 ) );
+
+    unsigned int numberOfVehicles = 5;
+    std::vector< std::string > bodiesToIntegrate;
+    std::vector< std::string > centralBodies;
+    for( unsigned int i = 0; i < numberOfVehicles; i++ )
+    {
+        bodiesToIntegrate.push_back( "Vehicle" + std::to_string( i ) );
+        centralBodies.push_back( "Earth" );
+        bodyMap[ bodiesToIntegrate.at( i ) ] = std::make_shared< Body >( );
+    }
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Define initial states, at varying orbital planes
+    double earthGravitationalParameter = bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( );
+    Eigen::VectorXd initialStates = Eigen::VectorXd::Zero( 6 * numberOfVehicles );
+    for( unsigned int i = 0; i < numberOfVehicles; i++ )
+    {
+        Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+        initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3 + 100.0E3 * static_cast< double >( i );
+        initialKeplerElements( eccentricityIndex ) = 0.01;
+        initialKeplerElements( inclinationIndex ) = 0.3 * static_cast< double >( i );
+        initialKeplerElements( longitudeOfAscendingNodeIndex ) = 0.7 * static_cast< double >( i );
+        initialStates.segment( 6 * i, 6 ) = convertKeplerianToCartesianElements(
+                    initialKeplerElements, earthGravitationalParameter );
+    }
+
+    std::map< double, Eigen::VectorXd > serialStateHistory;
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 5; numberOfThreads++ )
+    {
+        // Create accelerations, with a spherical harmonic field and third-body perturbations for each vehicle
+        SelectedAccelerationMap accelerationMap;
+        for( unsigned int i = 0; i < numberOfVehicles; i++ )
+        {
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Earth" ].push_back(
+                        std::make_shared< SphericalHarmonicAccelerationSettings >( 8, 8 ) );
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Moon" ].push_back(
+                        std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Sun" ].push_back(
+                        std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        }
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+        // Propagate with given number of threads (using 0 to denote all available threads for the last case)
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialStates, finalEphemerisTime );
+        propagatorSettings->numberOfAccelerationEvaluationThreads_ = ( numberOfThreads == 4 ) ? 0 : numberOfThreads;
+        std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+                ( initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                  1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodyMap, integratorSettings, propagatorSettings );
+
+        // Check settings and independent groups (one per vehicle) of state derivative model
+        std::shared_ptr< NBodyStateDerivative< double, double > > stateDerivativeModel =
+                std::dynamic_pointer_cast< NBodyStateDerivative< double, double > >(
+                    dynamicsSimulator.getDynamicsStateDerivative( )->getStateDerivativeModels( ).at(
+                        translational_state ).at( 0 ) );
+        BOOST_CHECK_EQUAL( stateDerivativeModel->getNumberOfAccelerationEvaluationThreads( ),
+                           ( numberOfThreads == 4 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads );
+        std::vector< std::vector< unsigned int > > accelerationModelGroups =
+                stateDerivativeModel->getIndependentAccelerationModelGroups( );
+        BOOST_CHECK_EQUAL( accelerationModelGroups.size( ), numberOfVehicles );
+        for( unsigned int i = 0; i < accelerationModelGroups.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( accelerationModelGroups.at( i ).size( ), 3 );
+        }
+
+        // Compare results to serial propagation; results should be identical
+        std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        if( numberOfThreads == 1 )
+        {
+            serialStateHistory = stateHistory;
+            BOOST_CHECK( serialStateHistory.size( ) > 50 );
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( stateHistory.size( ), serialStateHistory.size( ) );
+            std::map< double, Eigen::VectorXd >::const_iterator serialIterator = serialStateHistory.begin( );
+            for( std::map< double, Eigen::VectorXd >::const_iterator stateIterator = stateHistory.begin( );
+                 stateIterator != stateHistory.end( ) && serialIterator != serialStateHistory.end( ); stateIterator++ )
+            {
+                BOOST_CHECK_EQUAL( stateIterator->first, serialIterator->first );
+                for( int j = 0; j < stateIterator->second.rows( ); j++ )
+                {
+                    BOOST_CHECK_EQUAL( stateIterator->second( j ), serialIterator->second( j ) );
+                }
+                serialIterator++;
+            }
+        }
+    }
+}
+
+//! Test whether parallel evaluation of acceleration models that share a batched gravity cache reproduces serial results
+BOOST_AUTO_TEST_CASE( testParallelAccelerationEvaluationWithBatchedGravity )
+{
+    // Create central body with spherical harmonic gravity field (without using Spice)
+    const double earthGravitationalParameter = 3.986004418e14;
+    const double earthRadius = 6378137.0;
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createTestCoefficients( 8, cosineCoefficients, sineCoefficients );
+
+    NamedBodyMap bodyMap;
+    bodyMap[ "Earth" ] = std::make_shared< Body >( );
+    bodyMap[ "Earth" ]->setEphemeris( std::make_shared< ephemerides::ConstantEphemeris >(
+                                          Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" ) );
+    bodyMap[ "Earth" ]->setRotationalEphemeris( std::make_shared< ephemerides::SimpleRotationalEphemeris >(
+                                                    Eigen::Quaterniond::Identity( ), 7.2921150E-5, 0.0,
+                                                    "ECLIPJ2000", "IAU_Earth" ) );
+    bodyMap[ "Earth" ]->setGravityFieldModel( std::make_shared< SphericalHarmonicsGravityField >(
+                                                  earthGravitationalParameter, earthRadius,
+                                                  cosineCoefficients, sineCoefficients, "IAU_Earth" ) );
+
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle0", "Vehicle1" };
+    std::vector< std::string > centralBodies = { "Earth", "Earth" };
+    for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+    {
+        bodyMap[ bodiesToIntegrate.at( i ) ] = std::make_shared< Body >( );
+    }
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Define initial states, at different orbital planes
+    Eigen::VectorXd initialStates = Eigen::VectorXd::Zero( 12 );
+    for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+    {
+        Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+        initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3 + 500.0E3 * static_cast< double >( i );
+        initialKeplerElements( eccentricityIndex ) = 0.01;
+        initialKeplerElements( inclinationIndex ) = 0.4 + 0.5 * static_cast< double >( i );
+        initialStates.segment( 6 * i, 6 ) = convertKeplerianToCartesianElements(
+                    initialKeplerElements, earthGravitationalParameter );
+    }
+
+    std::map< double, Eigen::VectorXd > serialStateHistory;
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 3; numberOfThreads++ )
+    {
+        // Create spherical harmonic accelerations, evaluated for both vehicles at once by a shared cache
+        SelectedAccelerationMap accelerationMap;
+        for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+        {
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Earth" ].push_back(
+                        std::make_shared< SphericalHarmonicAccelerationSettings >( 8, 8 ) );
+        }
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+        BOOST_CHECK( setBatchedSphericalHarmonicsGravityEvaluation( accelerationModelMap, "Earth" ) != nullptr );
+
+        // Propagate with given number of threads
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialStates, 3.0 * 3600.0 );
+        propagatorSettings->numberOfAccelerationEvaluationThreads_ = numberOfThreads;
+        std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+                ( 0.0, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodyMap, integratorSettings, propagatorSettings );
+
+        // Check that the accelerations sharing the batched cache are updated on a single thread
+        std::shared_ptr< NBodyStateDerivative< double, double > > stateDerivativeModel =
+                std::dynamic_pointer_cast< NBodyStateDerivative< double, double > >(
+                    dynamicsSimulator.getDynamicsStateDerivative( )->getStateDerivativeModels( ).at(
+                        translational_state ).at( 0 ) );
+        BOOST_CHECK_EQUAL( stateDerivativeModel->getNumberOfAccelerationEvaluationThreads( ), numberOfThreads );
+        std::vector< std::vector< unsigned int > > accelerationModelGroups =
+                stateDerivativeModel->getIndependentAccelerationModelGroups( );
+        BOOST_CHECK_EQUAL( accelerationModelGroups.size( ), 1 );
+        BOOST_CHECK_EQUAL( accelerationModelGroups.at( 0 ).size( ), 2 );
+
+        // Compare results to serial propagation; results should be identical
+        std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        if( numberOfThreads == 1 )
+        {
+            serialStateHistory = stateHistory;
+            BOOST_CHECK( serialStateHistory.size( ) > 50 );
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( stateHistory.size( ), serialStateHistory.size( ) );
+            std::map< double, Eigen::VectorXd >::const_iterator serialIterator = serialStateHistory.begin( );
+            for( std::map< double, Eigen::VectorXd >::const_iterator stateIterator = stateHistory.begin( );
+                 stateIterator != stateHistory.end( ) && serialIterator != serialStateHistory.end( ); stateIterator++ )
+            {
+                BOOST_CHECK_EQUAL( stateIterator->first, serialIterator->first );
+                for( int j = 0; j < stateIterator->second.rows( ); j++ )
+                {
+                    BOOST_CHECK_EQUAL( stateIterator->second( j ), serialIterator->second( j ) );
+                }
+                serialIterator++;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,248 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+//! Function to retrieve settings for a list of dependent variables, which require various environment updates
+std::shared_ptr< DependentVariableSaveSettings > getTestDependentVariableSettings( const bool useAerodynamicAcceleration )
+{
+    std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      mach_number_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      local_density_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( std::make_shared< BodyAerodynamicAngleVariableSaveSettings >(
+                                      "Vehicle", reference_frames::latitude_angle, "Earth" ) );
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      keplerian_state_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      total_acceleration_dependent_variable, "Vehicle" ) );
+    dependentVariables.push_back( std::make_shared< SingleAccelerationDependentVariableSaveSettings >(
+                                      central_gravity, "Vehicle", "Earth" ) );
+    if( useAerodynamicAcceleration )
+    {
+        dependentVariables.push_back( std::make_shared< SingleAccelerationDependentVariableSaveSettings >(
+                                          aerodynamic, "Vehicle", "Earth" ) );
+    }
+    return std::make_shared< DependentVariableSaveSettings >( dependentVariables, false );
+}
+
+//! Function to create a (non-integrated) simulator for a vehicle orbiting the Earth, with its own environment.
+std::shared_ptr< SingleArcDynamicsSimulator< > > createVehicleSimulator(
+        const bool useAerodynamicAcceleration,
+        const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings )
+{
+    double initialEphemerisTime = 0.0;
+    double finalEphemerisTime = 3.0 * 3600.0;
+
+    // Create bodies needed in simulation (without direct calls to Spice during propagation)
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth" }, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+    bodySettings[ "Earth" ]->rotationModelSettings = std::make_shared< SimpleRotationModelSettings >(
+                "ECLIPJ2000", "IAU_Earth", Eigen::Quaterniond( Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitX( ) ) ),
+                initialEphemerisTime, 2.0 * mathematical_constants::PI / 86164.0 );
+    bodySettings[ "Earth" ]->gravityFieldSettings = std::make_shared< GravityFieldSettings >( central_spice );
+    bodySettings[ "Earth" ]->atmosphereSettings = std::make_shared< ExponentialAtmosphereSettings >( aerodynamics::earth );
+
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 500.0 );
+    bodyMap[ "Vehicle" ]->setAerodynamicCoefficientInterface(
+                createConstantCoefficientAerodynamicCoefficientInterface(
+                    ( Eigen::Vector3d( ) << 2.2, 0.0, 0.0 ).finished( ), Eigen::Vector3d::Zero( ),
+                    1.0, 4.0, 1.0, Eigen::Vector3d::Zero( ), true, true ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Set accelerations acting on vehicle
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    if( useAerodynamicAcceleration )
+    {
+        accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( aerodynamic ) );
+    }
+
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    // Set initial state
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 6378.0E3 + 250.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.001;
+    initialKeplerElements( inclinationIndex ) = 0.9;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( ) );
+
+    // Create settings for propagation
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >
+            ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialState,
+              std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime, true ), cowell,
+              dependentVariableSettings );
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+            ( initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+
+    return std::make_shared< SingleArcDynamicsSimulator< > >(
+                bodyMap, integratorSettings, propagatorSettings, false );
+}
+
+BOOST_AUTO_TEST_SUITE( test_post_processed_dependent_variables )
+
+//! Test whether dependent variables computed from a stored state history are identical to those computed during
+//! propagation, both when the environment models they require are, and are not, updated during the propagation.
+BOOST_AUTO_TEST_CASE( testPostProcessedDependentVariables )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        const bool useAerodynamicAcceleration = ( testCase == 0 );
+
+        // Propagate with dependent variables computed during the propagation
+        std::shared_ptr< SingleArcDynamicsSimulator< > > referenceSimulator = createVehicleSimulator(
+                    useAerodynamicAcceleration, getTestDependentVariableSettings( useAerodynamicAcceleration ) );
+        referenceSimulator->integrateEquationsOfMotion(
+                    referenceSimulator->getPropagatorSettings( )->getInitialStates( ) );
+        std::map< double, Eigen::VectorXd > referenceDependentVariables =
+                referenceSimulator->getDependentVariableHistory( );
+
+        // Propagate without dependent variables, and compute them afterwards
+        std::shared_ptr< SingleArcDynamicsSimulator< > > dynamicsSimulator = createVehicleSimulator(
+                    useAerodynamicAcceleration, nullptr );
+        dynamicsSimulator->integrateEquationsOfMotion( dynamicsSimulator->getPropagatorSettings( )->getInitialStates( ) );
+        BOOST_CHECK_EQUAL( dynamicsSimulator->getDependentVariableHistory( ).size( ), 0 );
+
+        std::map< double, Eigen::VectorXd > postProcessedDependentVariables =
+                dynamicsSimulator->computeDependentVariablesFromNumericalSolution(
+                    getTestDependentVariableSettings( useAerodynamicAcceleration ) );
+
+        // Compare results
+        BOOST_CHECK_EQUAL( postProcessedDependentVariables.size( ), referenceDependentVariables.size( ) );
+        BOOST_CHECK( dynamicsSimulator->getPostProcessedDependentVariableIds( ) ==
+                     referenceSimulator->getDependentVariableIds( ) );
+        for( auto variableIterator : referenceDependentVariables )
+        {
+            BOOST_CHECK_EQUAL( postProcessedDependentVariables.count( variableIterator.first ), 1 );
+            Eigen::VectorXd postProcessedValue = postProcessedDependentVariables[ variableIterator.first ];
+            BOOST_CHECK_EQUAL( postProcessedValue.rows( ), variableIterator.second.rows( ) );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( postProcessedValue, variableIterator.second, 1.0E-14 );
+        }
+
+        // Compute dependent variables at a subset of epochs from an external state history
+        std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator->getEquationsOfMotionNumericalSolution( );
+        std::vector< double > epochs;
+        unsigned int epochCounter = 0;
+        for( auto stateIterator : stateHistory )
+        {
+            if( epochCounter % 3 == 0 )
+            {
+                epochs.push_back( stateIterator.first );
+            }
+            epochCounter++;
+        }
+        epochs.push_back( stateHistory.begin( )->first );
+
+        std::shared_ptr< SingleArcDynamicsSimulator< > > separateSimulator = createVehicleSimulator(
+                    useAerodynamicAcceleration, nullptr );
+        std::map< double, Eigen::VectorXd > subsetDependentVariables =
+                separateSimulator->computeDependentVariablesFromStateHistory(
+                    getTestDependentVariableSettings( useAerodynamicAcceleration ), stateHistory, epochs );
+        BOOST_CHECK_EQUAL( subsetDependentVariables.size( ), epochs.size( ) - 1 );
+        for( auto variableIterator : subsetDependentVariables )
+        {
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( variableIterator.second,
+                                               referenceDependentVariables.at( variableIterator.first ), 1.0E-14 );
+        }
+
+        // Check error handling
+        BOOST_CHECK_THROW( dynamicsSimulator->computeDependentVariablesFromStateHistory(
+                               getTestDependentVariableSettings( useAerodynamicAcceleration ), stateHistory,
+                               std::vector< double >{ stateHistory.begin( )->first + 1.0E-3 } ), std::runtime_error );
+        BOOST_CHECK_THROW( dynamicsSimulator->computeDependentVariablesFromNumericalSolution(
+                               getTestDependentVariableSettings( useAerodynamicAcceleration ),
+                               std::vector< double >( ), 2 ), std::runtime_error );
+        BOOST_CHECK_THROW( separateSimulator->computeDependentVariablesFromNumericalSolution(
+                               getTestDependentVariableSettings( useAerodynamicAcceleration ) ), std::runtime_error );
+        if( !useAerodynamicAcceleration )
+        {
+            BOOST_CHECK_THROW( dynamicsSimulator->computeDependentVariablesFromNumericalSolution(
+                                   getTestDependentVariableSettings( true ) ), std::runtime_error );
+        }
+    }
+}
+
+//! Test whether dependent variables computed on multiple threads are identical to those computed on a single thread.
+BOOST_AUTO_TEST_CASE( testParallelPostProcessedDependentVariables )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    std::shared_ptr< SingleArcDynamicsSimulator< > > dynamicsSimulator = createVehicleSimulator( true, nullptr );
+    dynamicsSimulator->integrateEquationsOfMotion( dynamicsSimulator->getPropagatorSettings( )->getInitialStates( ) );
+
+    std::map< double, Eigen::VectorXd > serialDependentVariables =
+            dynamicsSimulator->computeDependentVariablesFromNumericalSolution( getTestDependentVariableSettings( true ) );
+
+    for( unsigned int numberOfThreads = 2; numberOfThreads <= 4; numberOfThreads++ )
+    {
+        std::map< double, Eigen::VectorXd > parallelDependentVariables =
+                dynamicsSimulator->computeDependentVariablesFromNumericalSolution(
+                    getTestDependentVariableSettings( true ), std::vector< double >( ), numberOfThreads,
+                    [ ]( ){ return createVehicleSimulator( true, nullptr ); } );
+
+        BOOST_CHECK_EQUAL( parallelDependentVariables.size( ), serialDependentVariables.size( ) );
+        for( auto variableIterator : serialDependentVariables )
+        {
+            BOOST_CHECK_EQUAL( parallelDependentVariables.count( variableIterator.first ), 1 );
+            for( int i = 0; i < variableIterator.second.rows( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( parallelDependentVariables[ variableIterator.first ]( i ),
+                                   variableIterator.second( i ) );
+            }
+        }
+    }
+
+    // Check that environment may not be shared between threads
+    BOOST_CHECK_THROW( dynamicsSimulator->computeDependentVariablesFromNumericalSolution(
+                           getTestDependentVariableSettings( true ), std::vector< double >( ), 2,
+                           [ = ]( ){ return dynamicsSimulator; } ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
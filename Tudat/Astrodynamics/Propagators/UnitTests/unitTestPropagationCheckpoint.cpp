@@ -0,0 +1,413 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Propagators/integrateEquations.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+//! Gravitational parameter of the Earth used in the tests.
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Function to compute the (Cowell) state derivative of a body orbiting a point-mass Earth.
+Eigen::VectorXd computeKeplerStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative = Eigen::VectorXd::Zero( 6 );
+    const double distance = state.segment( 0, 3 ).norm( );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -earthGravitationalParameter / ( distance * distance * distance ) *
+            state.segment( 0, 3 );
+    return stateDerivative;
+}
+
+//! Function to retrieve the initial state of the orbit used in the tests.
+Eigen::VectorXd getTestInitialState( )
+{
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.1;
+    initialKeplerElements( inclinationIndex ) = 0.8;
+    initialKeplerElements( longitudeOfAscendingNodeIndex ) = 0.4;
+    return convertKeplerianToCartesianElements( initialKeplerElements, earthGravitationalParameter );
+}
+
+//! Function to retrieve the integrator settings used in the tests.
+std::vector< std::shared_ptr< IntegratorSettings< > > > getTestIntegratorSettings( )
+{
+    std::vector< std::shared_ptr< IntegratorSettings< > > > integratorSettingsList;
+    integratorSettingsList.push_back(
+                std::make_shared< IntegratorSettings< > >( euler, 0.0, 1.0 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 10.0 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 10.0, RungeKuttaCoefficients::rungeKutta54DormandPrince, 1.0E-3, 1000.0, 1.0E-10, 1.0E-10 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< BulirschStoerIntegratorSettings< > >(
+                    0.0, 10.0, bulirsch_stoer_sequence, 6, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< AdamsBashforthMoultonSettings< > >(
+                    0.0, 10.0, 1.0E-3, 1000.0, 1.0E-10, 1.0E-10 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< GaussJacksonSettings< > >( 0.0, 20.0 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< GaussJacksonVariableStepSizeSettings< > >(
+                    0.0, 10.0, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaNystromVariableStepSizeSettings< > >(
+                    0.0, 10.0, RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince,
+                    1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+    return integratorSettingsList;
+}
+
+BOOST_AUTO_TEST_SUITE( test_propagation_checkpoint )
+
+//! Test whether an integrator continues bit-identically from a serialized integrator state.
+BOOST_AUTO_TEST_CASE( testIntegratorStateSerialization )
+{
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeKeplerStateDerivative;
+    const Eigen::VectorXd initialState = getTestInitialState( );
+
+    std::vector< std::shared_ptr< IntegratorSettings< > > > integratorSettingsList = getTestIntegratorSettings( );
+
+    // Also test Runge-Kutta integrator without compile-time Butcher tableau
+    integratorSettingsList.push_back( nullptr );
+
+    for( unsigned int testCase = 0; testCase < integratorSettingsList.size( ); testCase++ )
+    {
+        // Create two integrators with identical settings
+        std::vector< std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > > integrators;
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            if( integratorSettingsList.at( testCase ) != nullptr )
+            {
+                integrators.push_back( createIntegrator< double, Eigen::VectorXd >(
+                                           stateDerivativeFunction, initialState,
+                                           integratorSettingsList.at( testCase ) ) );
+            }
+            else
+            {
+                integrators.push_back(
+                            std::make_shared< RungeKuttaVariableStepSizeIntegrator< double, Eigen::VectorXd > >(
+                                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg56 ),
+                                stateDerivativeFunction, 0.0, initialState, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+            }
+        }
+
+        // Take a number of steps with the first integrator (long enough to fill the history of multistep methods)
+        double stepSize = 10.0;
+        for( unsigned int i = 0; i < 50; i++ )
+        {
+            integrators.at( 0 )->performIntegrationStep( stepSize );
+            stepSize = integrators.at( 0 )->getNextStepSize( );
+        }
+
+        // Copy state of first integrator to second integrator
+        std::stringstream integratorStateStream( std::ios::in | std::ios::out | std::ios::binary );
+        integrators.at( 0 )->writeIntegratorState( integratorStateStream );
+        integrators.at( 1 )->readIntegratorState( integratorStateStream );
+        BOOST_CHECK_EQUAL( integrators.at( 1 )->getCurrentIndependentVariable( ),
+                           integrators.at( 0 )->getCurrentIndependentVariable( ) );
+        BOOST_CHECK_EQUAL( integrators.at( 1 )->getNextStepSize( ), integrators.at( 0 )->getNextStepSize( ) );
+
+        // Continue both integrators, and check whether results are bit-identical
+        std::vector< double > stepSizes = { stepSize, stepSize };
+        for( unsigned int i = 0; i < 50; i++ )
+        {
+            std::vector< Eigen::VectorXd > newStates;
+            for( unsigned int j = 0; j < 2; j++ )
+            {
+                newStates.push_back( integrators.at( j )->performIntegrationStep( stepSizes.at( j ) ) );
+                stepSizes.at( j ) = integrators.at( j )->getNextStepSize( );
+            }
+
+            BOOST_CHECK_EQUAL( integrators.at( 1 )->getCurrentIndependentVariable( ),
+                               integrators.at( 0 )->getCurrentIndependentVariable( ) );
+            BOOST_CHECK_EQUAL( stepSizes.at( 1 ), stepSizes.at( 0 ) );
+            for( int k = 0; k < 6; k++ )
+            {
+                BOOST_CHECK_EQUAL( newStates.at( 1 )( k ), newStates.at( 0 )( k ) );
+            }
+        }
+    }
+
+    // Check whether reading the state of a different type of integrator is detected
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > rungeKutta4Integrator =
+            createIntegrator< double, Eigen::VectorXd >(
+                stateDerivativeFunction, initialState, integratorSettingsList.at( 1 ) );
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > adamsBashforthMoultonIntegrator =
+            createIntegrator< double, Eigen::VectorXd >(
+                stateDerivativeFunction, initialState, integratorSettingsList.at( 5 ) );
+    std::stringstream integratorStateStream( std::ios::in | std::ios::out | std::ios::binary );
+    rungeKutta4Integrator->writeIntegratorState( integratorStateStream );
+    BOOST_CHECK_THROW( adamsBashforthMoultonIntegrator->readIntegratorState( integratorStateStream ),
+                       std::runtime_error );
+}
+
+//! Test whether an interrupted propagation resumed from a checkpoint reproduces the uninterrupted propagation exactly
+BOOST_AUTO_TEST_CASE( testPropagationResumeFromCheckpoint )
+{
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeKeplerStateDerivative;
+    std::function< Eigen::VectorXd( ) > dependentVariableFunction = [ ]( ){ return Eigen::VectorXd::Ones( 2 ); };
+    const Eigen::VectorXd initialState = getTestInitialState( );
+    const double finalTime = 4.0 * 3600.0;
+    const std::string checkpointFile = "propagationCheckpointTest.dat";
+
+    std::vector< std::shared_ptr< IntegratorSettings< > > > integratorSettingsList = getTestIntegratorSettings( );
+
+    // Also test saving of results with dense output
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 10.0, RungeKuttaCoefficients::rungeKutta87DormandPrince, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12 ) );
+    integratorSettingsList.back( )->denseOutputSaveInterval_ = 60.0;
+
+    for( unsigned int testCase = 1; testCase < integratorSettingsList.size( ); testCase++ )
+    {
+        std::shared_ptr< IntegratorSettings< > > integratorSettings = integratorSettingsList.at( testCase );
+
+        // Propagate without interruption
+        std::map< double, Eigen::VectorXd > fullStateHistory, fullDependentVariableHistory;
+        std::map< double, double > fullComputationTimeHistory;
+        std::shared_ptr< PropagationTerminationDetails > fullTerminationDetails =
+                EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, fullStateHistory, initialState, integratorSettings,
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                    fullDependentVariableHistory, fullComputationTimeHistory, dependentVariableFunction );
+        BOOST_CHECK_EQUAL( fullTerminationDetails->getPropagationTerminationReason( ), termination_condition_reached );
+
+        // Propagate up to half the final time (emulating an interruption), writing checkpoints every 7 steps
+        std::shared_ptr< PropagationCheckpointHandler > checkpointHandler =
+                std::make_shared< PropagationCheckpointHandler >(
+                    std::make_shared< PropagationCheckpointSettings >( checkpointFile, 7 ) );
+        std::map< double, Eigen::VectorXd > interruptedStateHistory, interruptedDependentVariableHistory;
+        std::map< double, double > interruptedComputationTimeHistory;
+        EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, interruptedStateHistory, initialState, integratorSettings,
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime / 2.0, true ),
+                    interruptedDependentVariableHistory, interruptedComputationTimeHistory, dependentVariableFunction,
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                    std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                    checkpointHandler );
+        BOOST_CHECK( checkpointHandler->getNumberOfWrittenCheckpoints( ) > 1 );
+
+        // For every other case, remove the end of the last checkpoint (emulating an interruption while it was appended
+        // to the checkpoint file), so that the propagation is resumed from the previous checkpoint
+        if( testCase % 2 == 0 )
+        {
+            std::ifstream checkpointInputStream( checkpointFile, std::ios::binary );
+            std::string checkpointFileContents( ( std::istreambuf_iterator< char >( checkpointInputStream ) ),
+                                                std::istreambuf_iterator< char >( ) );
+            checkpointInputStream.close( );
+            std::ofstream checkpointOutputStream( checkpointFile, std::ios::binary | std::ios::trunc );
+            checkpointOutputStream.write( checkpointFileContents.data( ), checkpointFileContents.size( ) - 3 );
+        }
+
+        // Resume propagation from the last (complete) checkpoint, with a newly created integrator
+        std::map< double, Eigen::VectorXd > resumedStateHistory, resumedDependentVariableHistory;
+        std::map< double, double > resumedComputationTimeHistory;
+        std::shared_ptr< PropagationTerminationDetails > resumedTerminationDetails =
+                EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, resumedStateHistory, initialState, integratorSettings,
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                    resumedDependentVariableHistory, resumedComputationTimeHistory, dependentVariableFunction,
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                    std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                    std::make_shared< PropagationCheckpointHandler >( nullptr, checkpointFile ) );
+        BOOST_CHECK_EQUAL( resumedTerminationDetails->getPropagationTerminationReason( ),
+                           termination_condition_reached );
+
+        // Check whether resumed propagation is bit-identical to uninterrupted propagation
+        BOOST_CHECK( fullStateHistory.size( ) > 20 );
+        BOOST_CHECK_EQUAL( resumedStateHistory.size( ), fullStateHistory.size( ) );
+        BOOST_CHECK_EQUAL( resumedDependentVariableHistory.size( ), fullDependentVariableHistory.size( ) );
+        BOOST_CHECK_EQUAL( resumedComputationTimeHistory.size( ), fullComputationTimeHistory.size( ) );
+        auto resumedStateIterator = resumedStateHistory.begin( );
+        for( auto stateIterator : fullStateHistory )
+        {
+            BOOST_CHECK_EQUAL( resumedStateIterator->first, stateIterator.first );
+            for( int i = 0; i < 6; i++ )
+            {
+                BOOST_CHECK_EQUAL( resumedStateIterator->second( i ), stateIterator.second( i ) );
+            }
+            resumedStateIterator++;
+        }
+    }
+
+    // Check whether resuming from a missing checkpoint file is detected
+    std::remove( checkpointFile.c_str( ) );
+    std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+    std::map< double, double > computationTimeHistory;
+    BOOST_CHECK_THROW(
+                ( EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                      stateDerivativeFunction, stateHistory, initialState, integratorSettingsList.at( 1 ),
+                      std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                      dependentVariableHistory, computationTimeHistory, dependentVariableFunction,
+                      std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                      std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                      std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                      std::make_shared< PropagationCheckpointHandler >( nullptr, checkpointFile ) ) ),
+                std::runtime_error );
+}
+
+//! Test whether a dynamics simulator resumed from a checkpoint reproduces the uninterrupted propagation exactly
+BOOST_AUTO_TEST_CASE( testDynamicsSimulatorResumeFromCheckpoint )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 4.0 * 3600.0;
+    std::vector< std::string > bodyNames = { "Earth", "Moon", "Sun" };
+    NamedBodyMap bodyMap = createBodies(
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 ) );
+    bodyMap[ "Vehicle0" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle1" ] = std::make_shared< Body >( );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    Eigen::VectorXd initialStates = Eigen::VectorXd::Zero( 12 );
+    initialStates.segment( 0, 6 ) = getTestInitialState( );
+    initialStates.segment( 6, 6 ) = getTestInitialState( ).reverse( );
+
+    const std::string checkpointFile = "dynamicsSimulatorCheckpointTest.dat";
+
+    // Test cases: single body (fixed-size state) and two bodies (dynamically-sized state)
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        std::vector< std::string > bodiesToIntegrate = { "Vehicle0" };
+        std::vector< std::string > centralBodies = { "Earth" };
+        if( testCase == 1 )
+        {
+            bodiesToIntegrate.push_back( "Vehicle1" );
+            centralBodies.push_back( "Earth" );
+        }
+
+        // Create accelerations and propagator settings
+        SelectedAccelerationMap accelerationMap;
+        for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+        {
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Earth" ].push_back(
+                        std::make_shared< SphericalHarmonicAccelerationSettings >( 4, 4 ) );
+            accelerationMap[ bodiesToIntegrate.at( i ) ][ "Moon" ].push_back(
+                        std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        }
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+        std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate,
+                  initialStates.segment( 0, 6 * bodiesToIntegrate.size( ) ),
+                  std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) );
+        propagatorSettings->resetDependentVariablesToSave(
+                    std::make_shared< DependentVariableSaveSettings >(
+                        std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >{
+                            std::make_shared< SingleDependentVariableSaveSettings >(
+                                relative_distance_dependent_variable, "Vehicle0", "Moon" ) }, false ) );
+        std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                std::make_shared< AdamsBashforthMoultonSettings< > >(
+                    initialEphemerisTime, 10.0, 1.0E-3, 300.0, 1.0E-10, 1.0E-10 );
+
+        // Propagate without checkpoints
+        SingleArcDynamicsSimulator< > fullDynamicsSimulator(
+                    bodyMap, integratorSettings, propagatorSettings, false );
+        fullDynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+        BOOST_CHECK_EQUAL( fullDynamicsSimulator.isFixedSizeStatePropagationUsed( ), ( testCase == 0 ) );
+        BOOST_CHECK_EQUAL( fullDynamicsSimulator.getNumberOfWrittenCheckpoints( ), 0 );
+
+        // Propagate with checkpoints, after which the last checkpoint is written well before the end of the propagation
+        propagatorSettings->resetCheckpointSettings(
+                    std::make_shared< PropagationCheckpointSettings >( checkpointFile, 50 ) );
+        SingleArcDynamicsSimulator< > checkpointDynamicsSimulator(
+                    bodyMap, integratorSettings, propagatorSettings, false );
+        checkpointDynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+        BOOST_CHECK( checkpointDynamicsSimulator.getNumberOfWrittenCheckpoints( ) > 0 );
+
+        // Resume propagation from last checkpoint
+        propagatorSettings->resetCheckpointSettings( nullptr );
+        SingleArcDynamicsSimulator< > resumedDynamicsSimulator(
+                    bodyMap, integratorSettings, propagatorSettings, false );
+        resumedDynamicsSimulator.resumeEquationsOfMotionIntegrationFromCheckpoint( checkpointFile );
+        BOOST_CHECK_EQUAL( resumedDynamicsSimulator.getPropagationTerminationReason( )->getPropagationTerminationReason( ),
+                           termination_condition_reached );
+
+        // Check whether results are identical
+        std::map< double, Eigen::VectorXd > fullStateHistory = fullDynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        std::map< double, Eigen::VectorXd > resumedStateHistory =
+                resumedDynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        std::map< double, Eigen::VectorXd > fullDependentVariableHistory =
+                fullDynamicsSimulator.getDependentVariableHistory( );
+        std::map< double, Eigen::VectorXd > resumedDependentVariableHistory =
+                resumedDynamicsSimulator.getDependentVariableHistory( );
+
+        BOOST_CHECK( fullStateHistory.size( ) > 20 );
+        BOOST_CHECK_EQUAL( resumedStateHistory.size( ), fullStateHistory.size( ) );
+        BOOST_CHECK_EQUAL( resumedDependentVariableHistory.size( ), fullDependentVariableHistory.size( ) );
+        BOOST_CHECK_EQUAL( resumedDynamicsSimulator.getDynamicsStateDerivative( )->getNumberOfFunctionEvaluations( ),
+                           fullDynamicsSimulator.getDynamicsStateDerivative( )->getNumberOfFunctionEvaluations( ) );
+
+        auto resumedStateIterator = resumedStateHistory.begin( );
+        for( auto stateIterator : fullStateHistory )
+        {
+            BOOST_CHECK_EQUAL( resumedStateIterator->first, stateIterator.first );
+            for( int i = 0; i < stateIterator.second.rows( ); i++ )
+            {
+                BOOST_CHECK_EQUAL( resumedStateIterator->second( i ), stateIterator.second( i ) );
+            }
+            resumedStateIterator++;
+        }
+
+        auto resumedDependentVariableIterator = resumedDependentVariableHistory.begin( );
+        for( auto dependentVariableIterator : fullDependentVariableHistory )
+        {
+            BOOST_CHECK_EQUAL( resumedDependentVariableIterator->first, dependentVariableIterator.first );
+            BOOST_CHECK_EQUAL( resumedDependentVariableIterator->second( 0 ), dependentVariableIterator.second( 0 ) );
+            resumedDependentVariableIterator++;
+        }
+    }
+    std::remove( checkpointFile.c_str( ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
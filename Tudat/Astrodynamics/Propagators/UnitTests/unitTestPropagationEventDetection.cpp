@@ -0,0 +1,522 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstdio>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Propagators/integrateEquations.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+using mathematical_constants::PI;
+
+//! Function to compute the state derivative of a harmonic oscillator (x(t) = cos(t), v(t) = -sin(t) for x0 = 1, v0 = 0).
+Eigen::VectorXd computeHarmonicOscillatorStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative = Eigen::VectorXd::Zero( 2 );
+    stateDerivative( 0 ) = state( 1 );
+    stateDerivative( 1 ) = -state( 0 );
+    return stateDerivative;
+}
+
+//! Function to create an event detector for the harmonic oscillator
+/*!
+ *  Function to create an event detector for the harmonic oscillator, with events: zero crossings of position (any
+ *  direction), increasing zero crossings of velocity, and (if requested) a terminal increasing crossing of x = 0.5.
+ */
+std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > createHarmonicOscillatorEventDetector(
+        const bool useTerminalEvent )
+{
+    std::vector< std::string > eventNames = { "Position zero", "Velocity zero" };
+    std::vector< PropagationEventCrossingDirection > crossingDirections =
+    { any_event_crossing, increasing_event_crossing };
+    std::vector< bool > areEventsTerminal = { false, false };
+    if( useTerminalEvent )
+    {
+        eventNames.push_back( "Position half" );
+        crossingDirections.push_back( increasing_event_crossing );
+        areEventsTerminal.push_back( true );
+    }
+
+    return std::make_shared< PropagationEventDetector< Eigen::VectorXd, double > >(
+                [ = ]( const double, const Eigen::VectorXd& state, Eigen::VectorXd& eventValues )
+    {
+        eventValues.resize( eventNames.size( ) );
+        eventValues( 0 ) = state( 0 );
+        eventValues( 1 ) = state( 1 );
+        if( useTerminalEvent )
+        {
+            eventValues( 2 ) = state( 0 ) - 0.5;
+        }
+    }, eventNames, crossingDirections, areEventsTerminal );
+}
+
+BOOST_AUTO_TEST_SUITE( test_propagation_event_detection )
+
+//! Test whether events are located accurately within the integration steps, with and without dense output.
+BOOST_AUTO_TEST_CASE( testEventDetectionOnIntegrationSteps )
+{
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeHarmonicOscillatorStateDerivative;
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+    const double finalTime = 10.0;
+
+    // Integrators with dense output (DP87), and without (RK4, RKF78, ABM; using Hermite interpolation)
+    std::vector< std::shared_ptr< IntegratorSettings< > > > integratorSettingsList;
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 0.1, RungeKuttaCoefficients::rungeKutta87DormandPrince, 1.0E-4, 1.0, 1.0E-13, 1.0E-13 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 0.005 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                    0.0, 0.1, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-4, 1.0, 1.0E-13, 1.0E-13 ) );
+    integratorSettingsList.push_back(
+                std::make_shared< AdamsBashforthMoultonSettings< > >(
+                    0.0, 0.01, 1.0E-4, 0.05, 1.0E-10, 1.0E-10 ) );
+
+    for( unsigned int testCase = 0; testCase < integratorSettingsList.size( ); testCase++ )
+    {
+        // Propagate with non-terminal events
+        std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector =
+                createHarmonicOscillatorEventDetector( false );
+        std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        std::map< double, double > computationTimeHistory;
+        std::shared_ptr< PropagationTerminationDetails > terminationDetails =
+                EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistory, initialState, integratorSettingsList.at( testCase ),
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                    dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                    std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                    nullptr, eventDetector );
+        BOOST_CHECK_EQUAL( terminationDetails->getPropagationTerminationReason( ), termination_condition_reached );
+
+        // Check events: position zero at pi/2, 3pi/2, 5pi/2; increasing velocity zero at pi, 3pi
+        std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > detectedEvents =
+                eventDetector->getDetectedEvents( );
+        std::vector< double > expectedEventTimes = { PI / 2.0, PI, 3.0 * PI / 2.0, 5.0 * PI / 2.0, 3.0 * PI };
+        std::vector< unsigned int > expectedEventIndices = { 0, 1, 0, 0, 1 };
+        std::vector< bool > expectedIsIncreasing = { false, true, true, false, true };
+        BOOST_CHECK_EQUAL( detectedEvents.size( ), expectedEventTimes.size( ) );
+        for( unsigned int i = 0; i < std::min( detectedEvents.size( ), expectedEventTimes.size( ) ); i++ )
+        {
+            BOOST_CHECK_EQUAL( detectedEvents.at( i ).eventIndex_, expectedEventIndices.at( i ) );
+            BOOST_CHECK_EQUAL( detectedEvents.at( i ).isIncreasing_, expectedIsIncreasing.at( i ) );
+            BOOST_CHECK_EQUAL( detectedEvents.at( i ).isTerminal_, false );
+            BOOST_CHECK_SMALL( detectedEvents.at( i ).eventTime_ - expectedEventTimes.at( i ), 1.0E-8 );
+            BOOST_CHECK_SMALL( detectedEvents.at( i ).eventState_( 0 ) -
+                               std::cos( detectedEvents.at( i ).eventTime_ ), 1.0E-8 );
+            BOOST_CHECK_SMALL( detectedEvents.at( i ).eventState_( 1 ) +
+                               std::sin( detectedEvents.at( i ).eventTime_ ), 1.0E-8 );
+        }
+
+        // Check whether event detection leaves propagation unchanged
+        std::map< double, Eigen::VectorXd > stateHistoryWithoutEvents;
+        EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistoryWithoutEvents, initialState, integratorSettingsList.at( testCase ),
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                    dependentVariableHistory, computationTimeHistory );
+        BOOST_CHECK_EQUAL( stateHistoryWithoutEvents.size( ), stateHistory.size( ) );
+        BOOST_CHECK_EQUAL( stateHistoryWithoutEvents.rbegin( )->first, stateHistory.rbegin( )->first );
+        BOOST_CHECK_EQUAL( stateHistoryWithoutEvents.rbegin( )->second( 0 ), stateHistory.rbegin( )->second( 0 ) );
+
+        // Propagate with terminal event (increasing crossing of x = 0.5, at t = 2pi - pi/3)
+        eventDetector = createHarmonicOscillatorEventDetector( true );
+        terminationDetails = EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistory, initialState, integratorSettingsList.at( testCase ),
+                    std::make_shared< FixedTimePropagationTerminationCondition >( finalTime, true ),
+                    dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                    std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                    nullptr, eventDetector );
+        BOOST_CHECK_EQUAL( terminationDetails->getPropagationTerminationReason( ), terminal_event_detected );
+
+        detectedEvents = eventDetector->getDetectedEvents( );
+        BOOST_CHECK_EQUAL( detectedEvents.size( ), 4 );
+        BOOST_CHECK( eventDetector->isTerminalEventDetected( ) );
+        BOOST_CHECK_EQUAL( eventDetector->getTerminalEvent( ).eventIndex_, 2 );
+        BOOST_CHECK_SMALL( eventDetector->getTerminalEvent( ).eventTime_ - ( 2.0 * PI - PI / 3.0 ), 1.0E-8 );
+
+        // Check whether propagation stopped at terminal event
+        BOOST_CHECK_EQUAL( stateHistory.rbegin( )->first, eventDetector->getTerminalEvent( ).eventTime_ );
+        BOOST_CHECK_SMALL( stateHistory.rbegin( )->second( 0 ) - 0.5, 1.0E-8 );
+        BOOST_CHECK_SMALL( stateHistory.rbegin( )->second( 1 ) - std::sqrt( 3.0 ) / 2.0, 1.0E-8 );
+        BOOST_CHECK_EQUAL( computationTimeHistory.rbegin( )->first, stateHistory.rbegin( )->first );
+    }
+}
+
+//! Test whether events in a single step are sorted, and whether terminal events stop at the first terminal event.
+BOOST_AUTO_TEST_CASE( testMultipleEventsInSingleStep )
+{
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeHarmonicOscillatorStateDerivative;
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+
+    // Events at x = 0.3, 0.2 (terminal), 0.1 (terminal) (descending), all occurring in the first (large) step
+    std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector =
+            std::make_shared< PropagationEventDetector< Eigen::VectorXd, double > >(
+                [ ]( const double, const Eigen::VectorXd& state, Eigen::VectorXd& eventValues )
+    {
+        eventValues = ( Eigen::VectorXd( 3 ) << state( 0 ) - 0.1, state( 0 ) - 0.3, state( 0 ) - 0.2 ).finished( );
+    }, std::vector< std::string >{ "x = 0.1", "x = 0.3", "x = 0.2" },
+    std::vector< PropagationEventCrossingDirection >{ decreasing_event_crossing, any_event_crossing,
+                                                      decreasing_event_crossing },
+    std::vector< bool >{ true, false, true } );
+
+    std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+    std::map< double, double > computationTimeHistory;
+    std::shared_ptr< PropagationTerminationDetails > terminationDetails =
+            EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                stateDerivativeFunction, stateHistory, initialState,
+                std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 1.5 ),
+                std::make_shared< FixedTimePropagationTerminationCondition >( 10.0, true ),
+                dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                nullptr, eventDetector );
+    BOOST_CHECK_EQUAL( terminationDetails->getPropagationTerminationReason( ), terminal_event_detected );
+
+    // Check that only the events up to the first terminal event are logged, in chronological order
+    std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > detectedEvents = eventDetector->getDetectedEvents( );
+    BOOST_CHECK_EQUAL( detectedEvents.size( ), 2 );
+    BOOST_CHECK_EQUAL( detectedEvents.at( 0 ).eventName_, "x = 0.3" );
+    BOOST_CHECK_EQUAL( detectedEvents.at( 1 ).eventName_, "x = 0.2" );
+    BOOST_CHECK( detectedEvents.at( 0 ).eventTime_ < detectedEvents.at( 1 ).eventTime_ );
+    BOOST_CHECK_EQUAL( detectedEvents.at( 1 ).isTerminal_, true );
+
+    // Check that event states are on the interpolant of the (single) step
+    BOOST_CHECK_SMALL( detectedEvents.at( 0 ).eventState_( 0 ) - 0.3, 1.0E-10 );
+    BOOST_CHECK_SMALL( detectedEvents.at( 1 ).eventState_( 0 ) - 0.2, 1.0E-10 );
+    BOOST_CHECK_EQUAL( stateHistory.size( ), 2 );
+    BOOST_CHECK_EQUAL( stateHistory.rbegin( )->first, detectedEvents.at( 1 ).eventTime_ );
+
+    // Check inconsistent input
+    BOOST_CHECK_THROW( ( PropagationEventDetector< Eigen::VectorXd, double >(
+                             [ ]( const double, const Eigen::VectorXd&, Eigen::VectorXd& ){ },
+                             std::vector< std::string >{ "A", "B" },
+                             std::vector< PropagationEventCrossingDirection >{ any_event_crossing },
+                             std::vector< bool >{ false, false } ) ), std::runtime_error );
+}
+
+//! Test whether the state derivatives for the Hermite interpolation are re-used when events occur in consecutive steps.
+BOOST_AUTO_TEST_CASE( testHermiteInterpolationStateDerivativeReuse )
+{
+    // Count state derivative evaluations
+    unsigned int numberOfStateDerivativeEvaluations = 0;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ & ]( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfStateDerivativeEvaluations++;
+        return computeHarmonicOscillatorStateDerivative( time, state );
+    };
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+    const double stepSize = 0.2;
+    const unsigned int numberOfSteps = 50;
+
+    // Event at each zero crossing of cos( pi t / h ), i.e. halfway each RK4 step
+    std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector =
+            std::make_shared< PropagationEventDetector< Eigen::VectorXd, double > >(
+                [ = ]( const double time, const Eigen::VectorXd&, Eigen::VectorXd& eventValues )
+    {
+        eventValues = ( Eigen::VectorXd( 1 ) << std::cos( PI * time / stepSize ) ).finished( );
+    }, std::vector< std::string >{ "Time event" },
+    std::vector< PropagationEventCrossingDirection >{ any_event_crossing }, std::vector< bool >{ false } );
+
+    std::vector< unsigned int > numberOfEvaluationsPerCase;
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        numberOfStateDerivativeEvaluations = 0;
+        std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        std::map< double, double > computationTimeHistory;
+        EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistory, initialState,
+                    std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, stepSize ),
+                    std::make_shared< FixedTimePropagationTerminationCondition >(
+                        static_cast< double >( numberOfSteps ) * stepSize - 0.5 * stepSize, true ),
+                    dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                    std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                    nullptr, ( testCase == 0 ) ? nullptr : eventDetector );
+        numberOfEvaluationsPerCase.push_back( numberOfStateDerivativeEvaluations );
+    }
+
+    // Check that one state derivative evaluation per step is added (at the end of each step), and one at the start of
+    // the first step
+    BOOST_CHECK_EQUAL( numberOfEvaluationsPerCase.at( 1 ) - numberOfEvaluationsPerCase.at( 0 ), numberOfSteps + 1 );
+
+    // Check event times
+    std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > detectedEvents = eventDetector->getDetectedEvents( );
+    BOOST_CHECK_EQUAL( detectedEvents.size( ), numberOfSteps );
+    for( unsigned int i = 0; i < detectedEvents.size( ); i++ )
+    {
+        BOOST_CHECK_SMALL( detectedEvents.at( i ).eventTime_ - ( static_cast< double >( i ) + 0.5 ) * stepSize, 1.0E-10 );
+    }
+}
+
+//! Test whether detected events are retained when resuming a propagation from a checkpoint.
+BOOST_AUTO_TEST_CASE( testEventDetectionResumeFromCheckpoint )
+{
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeHarmonicOscillatorStateDerivative;
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+    const std::string checkpointFile = "propagationEventCheckpointTest.dat";
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                0.0, 0.1, RungeKuttaCoefficients::rungeKutta87DormandPrince, 1.0E-4, 1.0, 1.0E-12, 1.0E-12 );
+
+    // Propagate without interruption
+    std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > fullEventDetector =
+            createHarmonicOscillatorEventDetector( false );
+    std::map< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+    std::map< double, double > computationTimeHistory;
+    EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                stateDerivativeFunction, stateHistory, initialState, integratorSettings,
+                std::make_shared< FixedTimePropagationTerminationCondition >( 10.0, true ),
+                dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                nullptr, fullEventDetector );
+
+    // Propagate up to t = 6 (emulating an interruption), writing checkpoints every 3 steps
+    EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                stateDerivativeFunction, stateHistory, initialState, integratorSettings,
+                std::make_shared< FixedTimePropagationTerminationCondition >( 6.0, true ),
+                dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                std::make_shared< PropagationCheckpointHandler >(
+                    std::make_shared< PropagationCheckpointSettings >( checkpointFile, 3 ) ),
+                createHarmonicOscillatorEventDetector( false ) );
+
+    // Resume propagation from last checkpoint
+    std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > resumedEventDetector =
+            createHarmonicOscillatorEventDetector( false );
+    EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                stateDerivativeFunction, stateHistory, initialState, integratorSettings,
+                std::make_shared< FixedTimePropagationTerminationCondition >( 10.0, true ),
+                dependentVariableHistory, computationTimeHistory, std::function< Eigen::VectorXd( ) >( ),
+                std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) >( ),
+                std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) >( ),
+                std::make_shared< PropagationCheckpointHandler >( nullptr, checkpointFile ),
+                resumedEventDetector );
+    std::remove( checkpointFile.c_str( ) );
+
+    // Check whether detected events are identical
+    BOOST_CHECK_EQUAL( resumedEventDetector->getDetectedEvents( ).size( ), fullEventDetector->getDetectedEvents( ).size( ) );
+    for( unsigned int i = 0; i < std::min( resumedEventDetector->getDetectedEvents( ).size( ),
+                                           fullEventDetector->getDetectedEvents( ).size( ) ); i++ )
+    {
+        BOOST_CHECK_EQUAL( resumedEventDetector->getDetectedEvents( ).at( i ).eventIndex_,
+                           fullEventDetector->getDetectedEvents( ).at( i ).eventIndex_ );
+        BOOST_CHECK_EQUAL( resumedEventDetector->getDetectedEvents( ).at( i ).eventName_,
+                           fullEventDetector->getDetectedEvents( ).at( i ).eventName_ );
+        BOOST_CHECK_EQUAL( resumedEventDetector->getDetectedEvents( ).at( i ).eventTime_,
+                           fullEventDetector->getDetectedEvents( ).at( i ).eventTime_ );
+    }
+}
+
+//! Test built-in events (apsides, node crossings, eclipses and altitude crossings) in dynamics simulator.
+BOOST_AUTO_TEST_CASE( testDynamicsSimulatorEventDetection )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 6.0 * 3600.0;
+    std::vector< std::string > bodyNames = { "Earth", "Sun" };
+    NamedBodyMap bodyMap = createBodies(
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 ) );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Create accelerations
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    // Define orbit close to ecliptic plane, so that eclipses occur in each orbit
+    const double earthGravitationalParameter = bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( );
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 8000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.1;
+    initialKeplerElements( inclinationIndex ) = 0.1;
+    initialKeplerElements( argumentOfPeriapsisIndex ) = 1.0;
+    initialKeplerElements( trueAnomalyIndex ) = 0.5;
+    const Eigen::Vector6d initialState =
+            convertKeplerianToCartesianElements( initialKeplerElements, earthGravitationalParameter );
+
+    std::vector< std::shared_ptr< PropagationEventSettings > > eventSettings;
+    eventSettings.push_back( std::make_shared< ApsisEventSettings >( "Vehicle" ) );
+    eventSettings.push_back( std::make_shared< NodeCrossingEventSettings >( "Vehicle" ) );
+    eventSettings.push_back( std::make_shared< EclipseEventSettings >( "Vehicle", "Earth" ) );
+    eventSettings.push_back( std::make_shared< AltitudeCrossingEventSettings >( "Vehicle", 1500.0E3 ) );
+
+    std::shared_ptr< IntegratorSettings< > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKutta87DormandPrince,
+                1.0E-3, 1000.0, 1.0E-12, 1.0E-12 );
+    const double earthRadius = bodyMap.at( "Earth" )->getShapeModel( )->getAverageRadius( );
+
+    // Test cases: fixed-size and dynamically-sized state propagation
+    std::vector< std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > > detectedEventsPerTestCase;
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+                std::make_shared< TranslationalStatePropagatorSettings< double > >
+                ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialState,
+                  std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) );
+        propagatorSettings->resetEventSettings( eventSettings );
+
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodyMap, integratorSettings, propagatorSettings, false );
+        dynamicsSimulator.setUseFixedSizeStatePropagation( testCase == 0 );
+        dynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+        BOOST_CHECK_EQUAL( dynamicsSimulator.isFixedSizeStatePropagationUsed( ), ( testCase == 0 ) );
+        BOOST_CHECK_EQUAL( dynamicsSimulator.getPropagationTerminationReason( )->getPropagationTerminationReason( ),
+                           termination_condition_reached );
+
+        std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > detectedEvents =
+                dynamicsSimulator.getDetectedEvents( );
+        detectedEventsPerTestCase.push_back( detectedEvents );
+
+        std::vector< unsigned int > numberOfEventsPerType = { 0, 0, 0, 0 };
+        for( unsigned int i = 0; i < detectedEvents.size( ); i++ )
+        {
+            const double eventTime = detectedEvents.at( i ).eventTime_;
+            const Eigen::Vector3d position = detectedEvents.at( i ).eventState_.segment( 0, 3 );
+            const Eigen::Vector3d velocity = detectedEvents.at( i ).eventState_.segment( 3, 3 );
+            numberOfEventsPerType[ detectedEvents.at( i ).eventIndex_ ]++;
+
+            if( i > 0 )
+            {
+                BOOST_CHECK( eventTime >= detectedEvents.at( i - 1 ).eventTime_ );
+            }
+
+            switch( detectedEvents.at( i ).eventIndex_ )
+            {
+            case 0:
+                // Apsis: radial velocity is zero, increasing crossing is periapsis
+                BOOST_CHECK_EQUAL( detectedEvents.at( i ).eventName_, "Apsis of Vehicle" );
+                BOOST_CHECK_SMALL( position.dot( velocity ) / ( position.norm( ) * velocity.norm( ) ), 1.0E-9 );
+                BOOST_CHECK_EQUAL( detectedEvents.at( i ).isIncreasing_,
+                                   ( position.norm( ) < initialKeplerElements( semiMajorAxisIndex ) ) );
+                break;
+            case 1:
+                // Node: position in x-y plane, increasing crossing is ascending node
+                BOOST_CHECK_SMALL( position.z( ), 1.0E-3 );
+                BOOST_CHECK_EQUAL( detectedEvents.at( i ).isIncreasing_, ( velocity.z( ) > 0.0 ) );
+                break;
+            case 2:
+            {
+                // Eclipse: Earth limb touches Sun limb
+                const Eigen::Vector3d sunPosition = spice_interface::getBodyCartesianPositionAtEpoch(
+                            "Sun", "Earth", "ECLIPJ2000", "None", eventTime );
+                BOOST_CHECK_SMALL( computeEclipseEventFunction(
+                                       sunPosition - position, -position,
+                                       bodyMap.at( "Sun" )->getShapeModel( )->getAverageRadius( ), earthRadius ),
+                                   1.0E-10 );
+                break;
+            }
+            case 3:
+                // Altitude crossing
+                BOOST_CHECK_SMALL( position.norm( ) - earthRadius - 1500.0E3, 1.0E-3 );
+                BOOST_CHECK_EQUAL( detectedEvents.at( i ).isIncreasing_, ( position.dot( velocity ) > 0.0 ) );
+                break;
+            default:
+                BOOST_CHECK( false );
+            }
+        }
+
+        // Period is approximately 2 hours, each type of event occurs twice per orbit
+        for( unsigned int i = 0; i < numberOfEventsPerType.size( ); i++ )
+        {
+            BOOST_CHECK( numberOfEventsPerType.at( i ) >= 5 );
+            BOOST_CHECK( numberOfEventsPerType.at( i ) <= 7 );
+        }
+    }
+
+    // Compare events between fixed-size and dynamically-sized propagation
+    BOOST_CHECK_EQUAL( detectedEventsPerTestCase.at( 0 ).size( ), detectedEventsPerTestCase.at( 1 ).size( ) );
+    for( unsigned int i = 0; i < std::min( detectedEventsPerTestCase.at( 0 ).size( ),
+                                           detectedEventsPerTestCase.at( 1 ).size( ) ); i++ )
+    {
+        BOOST_CHECK_EQUAL( detectedEventsPerTestCase.at( 0 ).at( i ).eventIndex_,
+                           detectedEventsPerTestCase.at( 1 ).at( i ).eventIndex_ );
+        BOOST_CHECK_SMALL( detectedEventsPerTestCase.at( 0 ).at( i ).eventTime_ -
+                           detectedEventsPerTestCase.at( 1 ).at( i ).eventTime_, 1.0E-6 );
+    }
+
+    // Propagate with terminal descending altitude crossing
+    eventSettings.push_back( std::make_shared< AltitudeCrossingEventSettings >(
+                                 "Vehicle", 1000.0E3, decreasing_event_crossing, true, "Descent" ) );
+    std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >
+            ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialState,
+              std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime ) );
+    propagatorSettings->resetEventSettings( eventSettings );
+    SingleArcDynamicsSimulator< > dynamicsSimulator( bodyMap, integratorSettings, propagatorSettings, true );
+    BOOST_CHECK_EQUAL( dynamicsSimulator.getPropagationTerminationReason( )->getPropagationTerminationReason( ),
+                       terminal_event_detected );
+    BOOST_CHECK( dynamicsSimulator.integrationCompletedSuccessfully( ) );
+
+    std::vector< DetectedPropagationEvent< double, Eigen::VectorXd > > detectedEvents =
+            dynamicsSimulator.getDetectedEvents( );
+    BOOST_CHECK( detectedEvents.size( ) > 1 );
+    BOOST_CHECK_EQUAL( detectedEvents.back( ).eventName_, "Descent" );
+    BOOST_CHECK_EQUAL( detectedEvents.back( ).isTerminal_, true );
+    BOOST_CHECK_EQUAL( detectedEvents.back( ).isIncreasing_, false );
+
+    std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+    BOOST_CHECK_EQUAL( stateHistory.rbegin( )->first, detectedEvents.back( ).eventTime_ );
+    BOOST_CHECK_SMALL( stateHistory.rbegin( )->second.segment( 0, 3 ).norm( ) - earthRadius - 1000.0E3, 1.0E-3 );
+    BOOST_CHECK( stateHistory.rbegin( )->first < finalEphemerisTime );
+
+    // Check unknown body
+    eventSettings.push_back( std::make_shared< ApsisEventSettings >( "Moon" ) );
+    propagatorSettings->resetEventSettings( eventSettings );
+    BOOST_CHECK_THROW( dynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,316 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Propagators/propagationOutputSink.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+//! Function to create propagator and integrator settings for a vehicle orbiting the Earth (forward or backward in time)
+void createVehiclePropagationSettings(
+        const NamedBodyMap& bodyMap,
+        const bool propagateForward,
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > >& propagatorSettings,
+        std::shared_ptr< IntegratorSettings< > >& integratorSettings )
+{
+    double initialEphemerisTime = 0.0;
+    double finalEphemerisTime = ( propagateForward ? 1.0 : -1.0 ) * 4.0 * 3600.0;
+
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( central_gravity ) );
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( std::make_shared< AccelerationSettings >( aerodynamic ) );
+
+    std::vector< std::string > bodiesToIntegrate = { "Vehicle" };
+    std::vector< std::string > centralBodies = { "Earth" };
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 6378.0E3 + 350.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.001;
+    initialKeplerElements( inclinationIndex ) = 0.9;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( ) );
+
+    std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+    dependentVariables.push_back( std::make_shared< SingleDependentVariableSaveSettings >(
+                                      altitude_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( std::make_shared< SingleAccelerationDependentVariableSaveSettings >(
+                                      aerodynamic, "Vehicle", "Earth" ) );
+
+    // Terminate exactly on final time, so that the final saved epoch is modified at the end of the propagation
+    propagatorSettings = std::make_shared< TranslationalStatePropagatorSettings< double > >
+            ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialState,
+              std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime, true ), cowell,
+              std::make_shared< DependentVariableSaveSettings >( dependentVariables, false ) );
+    integratorSettings = std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+            ( initialEphemerisTime, ( propagateForward ? 1.0 : -1.0 ) * 10.0,
+              RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_propagation_output_sinks )
+
+//! Test whether results streamed to output sinks are consistent with results stored in dynamics simulator
+BOOST_AUTO_TEST_CASE( testPropagationOutputSinks )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth" }, -86400.0, 86400.0 );
+    bodySettings[ "Earth" ]->ephemerisSettings = std::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ) );
+    bodySettings[ "Earth" ]->gravityFieldSettings = std::make_shared< GravityFieldSettings >( central_spice );
+    bodySettings[ "Earth" ]->atmosphereSettings = std::make_shared< ExponentialAtmosphereSettings >( aerodynamics::earth );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 500.0 );
+    bodyMap[ "Vehicle" ]->setAerodynamicCoefficientInterface(
+                createConstantCoefficientAerodynamicCoefficientInterface(
+                    ( Eigen::Vector3d( ) << 2.2, 0.0, 0.0 ).finished( ), Eigen::Vector3d::Zero( ),
+                    1.0, 4.0, 1.0, Eigen::Vector3d::Zero( ), true, true ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    std::string outputFile = input_output::getTudatRootPath( ) + "Astrodynamics/Propagators/UnitTests/" +
+            "propagationOutputSinkTestFile.dat";
+
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        bool propagateForward = ( testCase == 0 );
+
+        // Propagate without output sink
+        std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings;
+        std::shared_ptr< IntegratorSettings< > > integratorSettings;
+        createVehiclePropagationSettings( bodyMap, propagateForward, propagatorSettings, integratorSettings );
+        SingleArcDynamicsSimulator< > referenceSimulator( bodyMap, integratorSettings, propagatorSettings );
+        std::map< double, Eigen::VectorXd > referenceStateHistory =
+                referenceSimulator.getEquationsOfMotionNumericalSolution( );
+        std::map< double, Eigen::VectorXd > referenceDependentVariableHistory =
+                referenceSimulator.getDependentVariableHistory( );
+        BOOST_CHECK( referenceStateHistory.size( ) > 100 );
+
+        // Create output sinks
+        unsigned int ringBufferSize = 25;
+        double windowDuration = 600.0;
+        std::shared_ptr< InMemoryPropagationOutputSink< > > inMemorySink =
+                std::make_shared< InMemoryPropagationOutputSink< > >( );
+        std::shared_ptr< BinaryFilePropagationOutputSink< > > fileSink =
+                std::make_shared< BinaryFilePropagationOutputSink< > >( outputFile );
+        std::shared_ptr< RingBufferPropagationOutputSink< > > ringBufferSink =
+                std::make_shared< RingBufferPropagationOutputSink< > >( ringBufferSize );
+        std::shared_ptr< ReducingPropagationOutputSink< > > reducingSink =
+                std::make_shared< ReducingPropagationOutputSink< > >( windowDuration );
+
+        std::vector< std::shared_ptr< PropagationOutputSink< > > > outputSinks =
+        { inMemorySink, fileSink, ringBufferSink, reducingSink };
+
+        // Propagate with output sinks, and check that results are only streamed if they are not set in environment
+        createVehiclePropagationSettings( bodyMap, propagateForward, propagatorSettings, integratorSettings );
+        propagatorSettings->resetOutputSink(
+                    std::make_shared< MultiplePropagationOutputSink< > >( outputSinks ) );
+        BOOST_CHECK_THROW( SingleArcDynamicsSimulator< >( bodyMap, integratorSettings, propagatorSettings, true, false, true ),
+                           std::runtime_error );
+        SingleArcDynamicsSimulator< > streamingSimulator( bodyMap, integratorSettings, propagatorSettings );
+
+        // Check that only final epoch is retained by simulator
+        std::map< double, Eigen::VectorXd > streamedStateHistory =
+                streamingSimulator.getEquationsOfMotionNumericalSolution( );
+        BOOST_CHECK_EQUAL( streamedStateHistory.size( ), 1 );
+        BOOST_CHECK_EQUAL( streamingSimulator.getDependentVariableHistory( ).size( ), 1 );
+        BOOST_CHECK_EQUAL( streamingSimulator.getCumulativeComputationTimeHistory( ).size( ), 1 );
+        double finalTime = propagateForward ? referenceStateHistory.rbegin( )->first : referenceStateHistory.begin( )->first;
+        BOOST_CHECK_EQUAL( streamedStateHistory.begin( )->first, finalTime );
+        BOOST_CHECK( streamedStateHistory.begin( )->second == referenceStateHistory.at( finalTime ) );
+
+        // Check in-memory output
+        BOOST_CHECK( inMemorySink->getStateHistory( ).toMap( ) == referenceStateHistory );
+        BOOST_CHECK( inMemorySink->getDependentVariableHistory( ).toMap( ) == referenceDependentVariableHistory );
+
+        // Check file output
+        std::map< double, Eigen::VectorXd > fileStateHistory, fileDependentVariableHistory;
+        readBinaryPropagationOutputFile( outputFile, fileStateHistory, fileDependentVariableHistory );
+        BOOST_CHECK_EQUAL( fileSink->getNumberOfWrittenEpochs( ), referenceStateHistory.size( ) );
+        BOOST_CHECK( fileStateHistory == referenceStateHistory );
+        BOOST_CHECK( fileDependentVariableHistory == referenceDependentVariableHistory );
+
+        // Check ring buffer output: last epochs of propagation
+        std::map< double, Eigen::VectorXd > ringBufferStateHistory = ringBufferSink->getStateHistory( );
+        std::map< double, Eigen::VectorXd > ringBufferDependentVariableHistory =
+                ringBufferSink->getDependentVariableHistory( );
+        BOOST_CHECK_EQUAL( ringBufferSink->getNumberOfStoredEpochs( ), ringBufferSize );
+        BOOST_CHECK_EQUAL( ringBufferStateHistory.size( ), ringBufferSize );
+        std::map< double, Eigen::VectorXd >::const_iterator referenceIterator =
+                propagateForward ? std::prev( referenceStateHistory.end( ), ringBufferSize ) : referenceStateHistory.begin( );
+        for( auto ringBufferIterator : ringBufferStateHistory )
+        {
+            BOOST_CHECK_EQUAL( ringBufferIterator.first, referenceIterator->first );
+            BOOST_CHECK( ringBufferIterator.second == referenceIterator->second );
+            BOOST_CHECK( ringBufferDependentVariableHistory.at( ringBufferIterator.first ) ==
+                         referenceDependentVariableHistory.at( ringBufferIterator.first ) );
+            referenceIterator++;
+        }
+
+        // Recompute window statistics from reference results, in order of propagation
+        std::vector< double > propagationTimes;
+        for( auto stateIterator : referenceStateHistory )
+        {
+            propagationTimes.push_back( stateIterator.first );
+        }
+        if( !propagateForward )
+        {
+            std::reverse( propagationTimes.begin( ), propagationTimes.end( ) );
+        }
+
+        std::map< double, Eigen::VectorXd > expectedMinimum, expectedMaximum, expectedMean, expectedDecimated;
+        unsigned int currentIndex = 0;
+        while( currentIndex < propagationTimes.size( ) )
+        {
+            double windowStartTime = propagationTimes.at( currentIndex );
+            Eigen::VectorXd minimum, maximum, sum;
+            unsigned int numberOfEpochs = 0;
+            while( currentIndex < propagationTimes.size( ) &&
+                   std::fabs( propagationTimes.at( currentIndex ) - windowStartTime ) < windowDuration )
+            {
+                double currentTime = propagationTimes.at( currentIndex );
+                Eigen::VectorXd currentOutput = Eigen::VectorXd::Zero( 10 );
+                currentOutput << referenceStateHistory.at( currentTime ),
+                        referenceDependentVariableHistory.at( currentTime );
+                if( numberOfEpochs == 0 )
+                {
+                    expectedDecimated[ windowStartTime ] = currentOutput;
+                    minimum = maximum = sum = currentOutput;
+                }
+                else
+                {
+                    minimum = minimum.cwiseMin( currentOutput );
+                    maximum = maximum.cwiseMax( currentOutput );
+                    sum += currentOutput;
+                }
+                numberOfEpochs++;
+                currentIndex++;
+            }
+            expectedMinimum[ windowStartTime ] = minimum;
+            expectedMaximum[ windowStartTime ] = maximum;
+            expectedMean[ windowStartTime ] = sum / static_cast< double >( numberOfEpochs );
+        }
+
+        // Check reducing output
+        BOOST_CHECK_EQUAL( reducingSink->getMeanHistory( ).size( ), expectedMean.size( ) );
+        BOOST_CHECK( expectedMean.size( ) > 20 );
+        BOOST_CHECK( reducingSink->getDecimatedHistory( ).toMap( ) == expectedDecimated );
+        BOOST_CHECK( reducingSink->getMinimumHistory( ).toMap( ) == expectedMinimum );
+        BOOST_CHECK( reducingSink->getMaximumHistory( ).toMap( ) == expectedMaximum );
+        for( auto meanIterator : expectedMean )
+        {
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( meanIterator.second,
+                                               Eigen::VectorXd( reducingSink->getMeanHistory( ).at( meanIterator.first ) ),
+                                               1.0E-14 );
+        }
+    }
+
+    std::remove( outputFile.c_str( ) );
+}
+
+//! Test whether memory used by the (contiguous) histories remains bounded when streaming a long propagation
+BOOST_AUTO_TEST_CASE( testStreamedPropagationMemoryUse )
+{
+    // Define harmonic oscillator, with its energy as dependent variable
+    Eigen::VectorXd currentState;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ & ]( const double, const Eigen::VectorXd& state )
+    {
+        currentState = state;
+        return ( Eigen::VectorXd( 2 ) << state( 1 ), -state( 0 ) ).finished( );
+    };
+    std::function< Eigen::VectorXd( ) > dependentVariableFunction = [ & ]( )
+    {
+        return ( Eigen::VectorXd( 1 ) << 0.5 * currentState.squaredNorm( ) ).finished( );
+    };
+    Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << 1.0, 0.0 ).finished( );
+
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        double timeStep = ( testCase == 0 ) ? 0.125 : -0.125;
+        unsigned int numberOfSteps = 200000;
+
+        // Propagate, streaming all results, and checking that they are streamed in order of propagation
+        unsigned int numberOfStreamedEpochs = 0;
+        double previousStreamedTime = TUDAT_NAN;
+        bool areEpochsStreamedInOrder = true;
+        std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > outputStreamingFunction =
+                [ & ]( const double time, const Eigen::VectorXd&, const Eigen::VectorXd& dependentVariables )
+        {
+            if( numberOfStreamedEpochs > 0 && !( ( time - previousStreamedTime ) * timeStep > 0.0 ) )
+            {
+                areEpochsStreamedInOrder = false;
+            }
+            if( dependentVariables.rows( ) != 1 )
+            {
+                areEpochsStreamedInOrder = false;
+            }
+            previousStreamedTime = time;
+            numberOfStreamedEpochs++;
+        };
+
+        StateHistory< double, Eigen::VectorXd > stateHistory, dependentVariableHistory;
+        StateHistory< double, double > computationTimeHistory;
+        std::shared_ptr< PropagationTerminationDetails > terminationDetails =
+                EquationIntegrationInterface< Eigen::VectorXd, double >::integrateEquations(
+                    stateDerivativeFunction, stateHistory, initialState,
+                    std::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, timeStep ),
+                    std::make_shared< FixedTimePropagationTerminationCondition >(
+                        static_cast< double >( numberOfSteps ) * timeStep, timeStep > 0.0, true ),
+                    dependentVariableHistory, computationTimeHistory, dependentVariableFunction,
+                    std::function< void( Eigen::VectorXd& ) >( ), TUDAT_NAN, std::chrono::steady_clock::now( ),
+                    outputStreamingFunction );
+        BOOST_CHECK_EQUAL( terminationDetails->getPropagationTerminationReason( ), termination_condition_reached );
+
+        // Check that all epochs were streamed, with only the final epoch retained
+        BOOST_CHECK_EQUAL( numberOfStreamedEpochs, numberOfSteps + 1 );
+        BOOST_CHECK_EQUAL( areEpochsStreamedInOrder, true );
+        BOOST_CHECK_EQUAL( stateHistory.size( ), 1 );
+        BOOST_CHECK_EQUAL( dependentVariableHistory.size( ), 1 );
+
+        // Check that memory of removed entries was reused, instead of allocating memory for each propagated epoch
+        BOOST_CHECK( stateHistory.getCapacity( ) < 10 );
+        BOOST_CHECK( dependentVariableHistory.getCapacity( ) < 10 );
+        BOOST_CHECK( computationTimeHistory.getCapacity( ) < 10 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
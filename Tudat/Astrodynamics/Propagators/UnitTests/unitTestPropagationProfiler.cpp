@@ -0,0 +1,258 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Propagators/propagationProfiler.h"
+#include "Tudat/External/SpiceInterface/spiceInterface.h"
+#include "Tudat/SimulationSetup/tudatSimulationHeader.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+//! Using declarations.
+using namespace numerical_integrators;
+using namespace simulation_setup;
+using namespace basic_astrodynamics;
+using namespace orbital_element_conversions;
+using namespace propagators;
+
+BOOST_AUTO_TEST_SUITE( test_propagation_profiler )
+
+//! Test whether the profiler correctly registers functions and records their calls
+BOOST_AUTO_TEST_CASE( testPropagationProfiler )
+{
+    PropagationProfiler profiler;
+
+    // Register functions directly
+    unsigned int firstIndex = profiler.addProfiledFunction( acceleration_model_profile, "first acceleration" );
+    unsigned int secondIndex = profiler.addProfiledFunction( acceleration_model_profile, "second acceleration" );
+    BOOST_CHECK_EQUAL( firstIndex, 0 );
+    BOOST_CHECK_EQUAL( secondIndex, 1 );
+
+    // Register function through wrapper
+    int numberOfEvaluations = 0;
+    std::function< double( ) > profiledFunction = profiler.createProfiledFunction< double >(
+                dependent_variable_profile, "dependent variable",
+                std::function< double( ) >( [ & ]( ){ numberOfEvaluations++; return 2.0; } ) );
+
+    // Record calls
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        profiler.addFunctionCall( firstIndex, PropagationProfiler::ClockType::now( ) );
+        BOOST_CHECK_EQUAL( profiledFunction( ), 2.0 );
+    }
+    profiler.addFunctionCall( secondIndex, PropagationProfiler::ClockType::now( ) );
+
+    // Check recorded statistics
+    const std::vector< ProfiledFunctionStatistics >& profilingReport = profiler.getProfilingReport( );
+    BOOST_CHECK_EQUAL( profilingReport.size( ), 3 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 5 );
+    BOOST_CHECK_EQUAL( profilingReport.at( 0 ).numberOfCalls_, 5 );
+    BOOST_CHECK_EQUAL( profilingReport.at( 1 ).numberOfCalls_, 1 );
+    BOOST_CHECK_EQUAL( profilingReport.at( 2 ).numberOfCalls_, 5 );
+    BOOST_CHECK_EQUAL( profilingReport.at( 2 ).functionType_, dependent_variable_profile );
+    BOOST_CHECK_EQUAL( profilingReport.at( 2 ).functionId_, "dependent variable" );
+    BOOST_CHECK_EQUAL( profiler.getNumberOfCalls( acceleration_model_profile ), 6 );
+    BOOST_CHECK_EQUAL( profiler.getNumberOfCalls( torque_model_profile ), 0 );
+    for( unsigned int i = 0; i < profilingReport.size( ); i++ )
+    {
+        BOOST_CHECK( profilingReport.at( i ).cumulativeWallTime_ >= 0.0 );
+    }
+    BOOST_CHECK_EQUAL( profiler.getCumulativeWallTime( acceleration_model_profile ),
+                       profilingReport.at( 0 ).cumulativeWallTime_ + profilingReport.at( 1 ).cumulativeWallTime_ );
+
+    // Check printed report
+    std::stringstream reportStream;
+    profiler.printProfilingReport( reportStream );
+    BOOST_CHECK( reportStream.str( ).find( "second acceleration" ) != std::string::npos );
+    BOOST_CHECK( reportStream.str( ).find( "dependent variable" ) != std::string::npos );
+
+    // Check reset of statistics
+    profiler.resetStatistics( );
+    BOOST_CHECK_EQUAL( profiler.getProfilingReport( ).size( ), 3 );
+    BOOST_CHECK_EQUAL( profiler.getNumberOfCalls( acceleration_model_profile ), 0 );
+    BOOST_CHECK_EQUAL( profiler.getNumberOfCalls( dependent_variable_profile ), 0 );
+    BOOST_CHECK_EQUAL( profiler.getCumulativeWallTime( dependent_variable_profile ), 0.0 );
+}
+
+//! Test whether profiling of a propagation records all models, and leaves the propagation results unchanged
+BOOST_AUTO_TEST_CASE( testProfiledPropagation )
+{
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create bodies
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 3.0 * 3600.0;
+    std::vector< std::string > bodyNames = { "Earth", "Moon", "Sun" };
+    NamedBodyMap bodyMap = createBodies(
+                getDefaultBodySettings( bodyNames, initialEphemerisTime - 3600.0, finalEphemerisTime + 3600.0 ) );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 500.0 );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Define initial state
+    Eigen::Vector6d initialKeplerElements = Eigen::Vector6d::Zero( );
+    initialKeplerElements( semiMajorAxisIndex ) = 7000.0E3;
+    initialKeplerElements( eccentricityIndex ) = 0.01;
+    initialKeplerElements( inclinationIndex ) = 1.2;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements(
+                initialKeplerElements, bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( ) );
+    Eigen::VectorXd initialMass = Eigen::VectorXd::Constant( 1, 500.0 );
+
+    std::map< double, Eigen::VectorXd > unprofiledStateHistory;
+    std::map< double, Eigen::VectorXd > unprofiledDependentVariableHistory;
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        bool profilePropagation = ( testCase == 1 );
+
+        // Create accelerations and mass rate model
+        SelectedAccelerationMap accelerationMap;
+        accelerationMap[ "Vehicle" ][ "Earth" ].push_back(
+                    std::make_shared< SphericalHarmonicAccelerationSettings >( 8, 8 ) );
+        accelerationMap[ "Vehicle" ][ "Moon" ].push_back(
+                    std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        accelerationMap[ "Vehicle" ][ "Sun" ].push_back(
+                    std::make_shared< AccelerationSettings >( point_mass_gravity ) );
+        AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                    bodyMap, accelerationMap, { "Vehicle" }, { "Earth" } );
+
+        std::map< std::string, std::shared_ptr< MassRateModel > > massRateModels;
+        massRateModels[ "Vehicle" ] = std::make_shared< CustomMassRateModel >( [ ]( const double ){ return -0.01; } );
+
+        // Create propagator settings
+        std::shared_ptr< PropagationTerminationSettings > terminationSettings =
+                std::make_shared< PropagationTimeTerminationSettings >( finalEphemerisTime );
+        std::vector< std::shared_ptr< SingleArcPropagatorSettings< double > > > propagatorSettingsList;
+        propagatorSettingsList.push_back(
+                    std::make_shared< TranslationalStatePropagatorSettings< double > >(
+                        std::vector< std::string >{ "Earth" }, accelerationModelMap,
+                        std::vector< std::string >{ "Vehicle" }, initialState, terminationSettings ) );
+        propagatorSettingsList.push_back(
+                    std::make_shared< MassPropagatorSettings< double > >(
+                        std::vector< std::string >{ "Vehicle" }, massRateModels, initialMass, terminationSettings ) );
+
+        std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+        dependentVariables.push_back(
+                    std::make_shared< SingleDependentVariableSaveSettings >(
+                        total_acceleration_norm_dependent_variable, "Vehicle" ) );
+        dependentVariables.push_back(
+                    std::make_shared< SingleDependentVariableSaveSettings >(
+                        relative_distance_dependent_variable, "Vehicle", "Moon" ) );
+
+        std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings =
+                std::make_shared< MultiTypePropagatorSettings< double > >(
+                    propagatorSettingsList, terminationSettings,
+                    std::make_shared< DependentVariableSaveSettings >( dependentVariables, false ) );
+        propagatorSettings->setProfilePropagation( profilePropagation );
+        BOOST_CHECK_EQUAL( propagatorSettings->getProfilePropagation( ), profilePropagation );
+
+        std::shared_ptr< IntegratorSettings< > > integratorSettings =
+                std::make_shared< RungeKuttaVariableStepSizeSettings< > >
+                ( initialEphemerisTime, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                  1.0E-3, 300.0, 1.0E-12, 1.0E-12 );
+
+        // Propagate twice, to check that the statistics are reset at the start of each propagation
+        SingleArcDynamicsSimulator< > dynamicsSimulator( bodyMap, integratorSettings, propagatorSettings );
+        dynamicsSimulator.integrateEquationsOfMotion( propagatorSettings->getInitialStates( ) );
+
+        std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+        std::map< double, Eigen::VectorXd > dependentVariableHistory = dynamicsSimulator.getDependentVariableHistory( );
+        std::vector< ProfiledFunctionStatistics > profilingReport = dynamicsSimulator.getPropagationProfilingReport( );
+        if( !profilePropagation )
+        {
+            BOOST_CHECK( dynamicsSimulator.getPropagationProfiler( ) == nullptr );
+            BOOST_CHECK_EQUAL( profilingReport.size( ), 0 );
+
+            unprofiledStateHistory = stateHistory;
+            unprofiledDependentVariableHistory = dependentVariableHistory;
+            continue;
+        }
+
+        // Check that results are unaffected by profiling
+        BOOST_CHECK_EQUAL( stateHistory.size( ), unprofiledStateHistory.size( ) );
+        BOOST_CHECK_EQUAL( dependentVariableHistory.size( ), unprofiledDependentVariableHistory.size( ) );
+        for( auto stateIterator : unprofiledStateHistory )
+        {
+            BOOST_CHECK( stateHistory.at( stateIterator.first ) == stateIterator.second );
+            BOOST_CHECK( dependentVariableHistory.at( stateIterator.first ) ==
+                         unprofiledDependentVariableHistory.at( stateIterator.first ) );
+        }
+
+        // Check that each model has been profiled
+        std::shared_ptr< PropagationProfiler > profiler = dynamicsSimulator.getPropagationProfiler( );
+        BOOST_CHECK( profiler != nullptr );
+        unsigned long long numberOfFunctionEvaluations =
+                dynamicsSimulator.getDynamicsStateDerivative( )->getNumberOfFunctionEvaluations( );
+
+        int numberOfAccelerationModels = 0, numberOfMassRateModels = 0, numberOfDependentVariables = 0,
+                numberOfEnvironmentUpdates = 0;
+        for( unsigned int i = 0; i < profilingReport.size( ); i++ )
+        {
+            switch( profilingReport.at( i ).functionType_ )
+            {
+            case acceleration_model_profile:
+                numberOfAccelerationModels++;
+                BOOST_CHECK_EQUAL( profilingReport.at( i ).numberOfCalls_, numberOfFunctionEvaluations );
+                break;
+            case mass_rate_model_profile:
+                numberOfMassRateModels++;
+                BOOST_CHECK_EQUAL( profilingReport.at( i ).functionId_, "custom mass rate of Vehicle" );
+                BOOST_CHECK_EQUAL( profilingReport.at( i ).numberOfCalls_, numberOfFunctionEvaluations );
+                break;
+            case environment_update_profile:
+                numberOfEnvironmentUpdates++;
+                BOOST_CHECK_EQUAL( profilingReport.at( i ).numberOfCalls_, numberOfFunctionEvaluations );
+                break;
+            case dependent_variable_profile:
+                numberOfDependentVariables++;
+                BOOST_CHECK( profilingReport.at( i ).numberOfCalls_ >= dependentVariableHistory.size( ) );
+                break;
+            default:
+                BOOST_CHECK( false );
+            }
+        }
+        BOOST_CHECK_EQUAL( numberOfAccelerationModels, 3 );
+        BOOST_CHECK_EQUAL( numberOfMassRateModels, 1 );
+        BOOST_CHECK_EQUAL( numberOfDependentVariables, 2 );
+        BOOST_CHECK( numberOfEnvironmentUpdates > 0 );
+
+        BOOST_CHECK( profiler->getNumberOfCalls( acceleration_model_profile ) == 3 * numberOfFunctionEvaluations );
+        BOOST_CHECK( profiler->getCumulativeWallTime( acceleration_model_profile ) > 0.0 );
+
+        // Check identification of spherical harmonic acceleration
+        bool sphericalHarmonicAccelerationFound = false;
+        for( unsigned int i = 0; i < profilingReport.size( ); i++ )
+        {
+            if( profilingReport.at( i ).functionId_ == "spherical harmonic gravity of Earth on Vehicle" )
+            {
+                sphericalHarmonicAccelerationFound = true;
+            }
+        }
+        BOOST_CHECK( sphericalHarmonicAccelerationFound );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,234 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Basics/timeType.h"
+#include "Tudat/Astrodynamics/Propagators/stateHistory.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+
+//! Function to compare the contents of a state history to those of a map
+template< typename TimeType, typename StateType >
+void compareStateHistoryToMap( const StateHistory< TimeType, StateType >& stateHistory,
+                               const std::map< TimeType, StateType >& stateMap )
+{
+    BOOST_CHECK_EQUAL( stateHistory.size( ), stateMap.size( ) );
+    BOOST_CHECK_EQUAL( stateHistory.empty( ), stateMap.empty( ) );
+
+    // Compare forward iteration
+    typename std::map< TimeType, StateType >::const_iterator mapIterator = stateMap.begin( );
+    for( typename StateHistory< TimeType, StateType >::const_iterator historyIterator = stateHistory.begin( );
+         historyIterator != stateHistory.end( ); historyIterator++ )
+    {
+        BOOST_CHECK( historyIterator->first == mapIterator->first );
+        BOOST_CHECK( StateType( historyIterator->second ) == mapIterator->second );
+        mapIterator++;
+    }
+    BOOST_CHECK( mapIterator == stateMap.end( ) );
+
+    // Compare reverse iteration
+    typename std::map< TimeType, StateType >::const_reverse_iterator reverseMapIterator = stateMap.rbegin( );
+    for( typename StateHistory< TimeType, StateType >::const_reverse_iterator historyIterator = stateHistory.rbegin( );
+         historyIterator != stateHistory.rend( ); historyIterator++ )
+    {
+        BOOST_CHECK( historyIterator->first == reverseMapIterator->first );
+        BOOST_CHECK( StateType( historyIterator->second ) == reverseMapIterator->second );
+        reverseMapIterator++;
+    }
+
+    // Compare lookup
+    for( auto mapEntry : stateMap )
+    {
+        BOOST_CHECK_EQUAL( stateHistory.count( mapEntry.first ), 1 );
+        BOOST_CHECK( StateType( stateHistory.at( mapEntry.first ) ) == mapEntry.second );
+        BOOST_CHECK( stateHistory.find( mapEntry.first )->first == mapEntry.first );
+        BOOST_CHECK( stateHistory.lower_bound( mapEntry.first )->first == stateMap.lower_bound( mapEntry.first )->first );
+    }
+
+    // Check conversion to map
+    std::map< TimeType, StateType > convertedMap = stateHistory;
+    BOOST_CHECK( convertedMap == stateMap );
+}
+
+BOOST_AUTO_TEST_SUITE( test_state_history )
+
+//! Test whether state history behaves identically to map for vector entries, added in various orders
+BOOST_AUTO_TEST_CASE( testVectorStateHistory )
+{
+    for( unsigned int testCase = 0; testCase < 3; testCase++ )
+    {
+        StateHistory< double, Eigen::VectorXd > stateHistory;
+        std::map< double, Eigen::VectorXd > stateMap;
+
+        // Add entries in forward, backward and alternating order, respectively
+        for( int i = 0; i < 100; i++ )
+        {
+            double currentTime;
+            if( testCase == 0 )
+            {
+                currentTime = 10.0 * static_cast< double >( i );
+            }
+            else if( testCase == 1 )
+            {
+                currentTime = -10.0 * static_cast< double >( i );
+            }
+            else
+            {
+                currentTime = 10.0 * static_cast< double >( ( i % 2 == 0 ) ? i : 200 - i );
+            }
+
+            Eigen::VectorXd currentState = Eigen::VectorXd::Constant( 4, currentTime );
+            currentState( 1 ) = static_cast< double >( i );
+
+            stateHistory[ currentTime ] = currentState;
+            stateMap[ currentTime ] = currentState;
+        }
+        compareStateHistoryToMap( stateHistory, stateMap );
+
+        // Overwrite existing entries
+        stateHistory[ stateMap.begin( )->first ] = Eigen::VectorXd::Zero( 4 );
+        stateMap[ stateMap.begin( )->first ] = Eigen::VectorXd::Zero( 4 );
+        stateHistory.insert( stateMap.rbegin( )->first, Eigen::VectorXd::Ones( 4 ) );
+        stateMap[ stateMap.rbegin( )->first ] = Eigen::VectorXd::Ones( 4 );
+        compareStateHistoryToMap( stateHistory, stateMap );
+
+        // Remove first, last and intermediate entries
+        stateHistory.erase( stateHistory.begin( ) );
+        stateMap.erase( stateMap.begin( ) );
+        stateHistory.erase( std::prev( stateHistory.end( ) ) );
+        stateMap.erase( std::prev( stateMap.end( ) ) );
+        double intermediateTime = std::next( stateMap.begin( ), 40 )->first;
+        BOOST_CHECK_EQUAL( stateHistory.erase( intermediateTime ), 1 );
+        BOOST_CHECK_EQUAL( stateHistory.erase( intermediateTime ), 0 );
+        stateMap.erase( intermediateTime );
+        compareStateHistoryToMap( stateHistory, stateMap );
+
+        // Check lookup of non-existing entries
+        BOOST_CHECK_EQUAL( stateHistory.count( intermediateTime ), 0 );
+        BOOST_CHECK( stateHistory.find( intermediateTime ) == stateHistory.end( ) );
+        BOOST_CHECK_THROW( stateHistory.at( intermediateTime ), std::out_of_range );
+        BOOST_CHECK( stateHistory.lower_bound( intermediateTime )->first == stateMap.lower_bound( intermediateTime )->first );
+        BOOST_CHECK( stateHistory.upper_bound( intermediateTime )->first == stateMap.upper_bound( intermediateTime )->first );
+
+        // Check contiguous storage
+        Eigen::MatrixXd stateBlock = stateHistory.getStateBlock( );
+        BOOST_CHECK_EQUAL( stateBlock.rows( ), 4 );
+        BOOST_CHECK_EQUAL( stateBlock.cols( ), static_cast< int >( stateMap.size( ) ) );
+        int currentColumn = 0;
+        for( auto mapEntry : stateMap )
+        {
+            BOOST_CHECK( stateBlock.col( currentColumn ) == mapEntry.second );
+            BOOST_CHECK_EQUAL( stateHistory.getTimesData( )[ currentColumn ], mapEntry.first );
+            BOOST_CHECK_EQUAL( stateHistory.getTimeVector( ).at( currentColumn ), mapEntry.first );
+            BOOST_CHECK( stateHistory.getStateVector( ).at( currentColumn ) == mapEntry.second );
+            currentColumn++;
+        }
+
+        // Check entries of inconsistent size are rejected
+        BOOST_CHECK_THROW( stateHistory.insert( 1.0E6, Eigen::VectorXd::Zero( 3 ) ), std::runtime_error );
+
+        // Check clearing, and subsequent reuse with different entry size
+        stateHistory.clear( );
+        stateMap.clear( );
+        compareStateHistoryToMap( stateHistory, stateMap );
+        for( int i = 0; i < 10; i++ )
+        {
+            stateHistory[ static_cast< double >( -i ) ] = Eigen::VectorXd::Constant( 2, i );
+            stateMap[ static_cast< double >( -i ) ] = Eigen::VectorXd::Constant( 2, i );
+        }
+        compareStateHistoryToMap( stateHistory, stateMap );
+
+        // Check construction from map
+        StateHistory< double, Eigen::VectorXd > historyFromMap = stateMap;
+        compareStateHistoryToMap( historyFromMap, stateMap );
+    }
+}
+
+//! Test state history with matrix entries, scalar entries and Time as independent variable
+BOOST_AUTO_TEST_CASE( testOtherStateHistoryTypes )
+{
+    StateHistory< double, Eigen::MatrixXd > matrixHistory;
+    std::map< double, Eigen::MatrixXd > matrixMap;
+    StateHistory< Time, double > scalarHistory;
+    std::map< Time, double > scalarMap;
+
+    for( int i = 0; i < 50; i++ )
+    {
+        Eigen::MatrixXd currentMatrix = Eigen::MatrixXd::Random( 3, 5 );
+        matrixHistory[ static_cast< double >( i ) ] = currentMatrix;
+        matrixMap[ static_cast< double >( i ) ] = currentMatrix;
+
+        Time currentTime = Time( i, 0.5L );
+        scalarHistory[ currentTime ] = 2.0 * static_cast< double >( i );
+        scalarMap[ currentTime ] = 2.0 * static_cast< double >( i );
+    }
+    compareStateHistoryToMap( matrixHistory, matrixMap );
+    compareStateHistoryToMap( scalarHistory, scalarMap );
+
+    BOOST_CHECK_EQUAL( matrixHistory.getNumberOfRows( ), 3 );
+    BOOST_CHECK_EQUAL( matrixHistory.getNumberOfColumns( ), 5 );
+    BOOST_CHECK( matrixHistory.getStateBlock( ).col( 7 ) ==
+                 Eigen::Map< const Eigen::VectorXd >( matrixMap.at( 7.0 ).data( ), 15 ) );
+
+    // Check in-place modification
+    matrixHistory.getState( 3 ).setZero( );
+    matrixMap[ 3.0 ].setZero( );
+    scalarHistory.getState( 4 ) = -1.0;
+    scalarMap[ Time( 4, 0.5L ) ] = -1.0;
+    compareStateHistoryToMap( matrixHistory, matrixMap );
+    compareStateHistoryToMap( scalarHistory, scalarMap );
+}
+
+//! Test whether memory use remains bounded when entries are continuously added at one end and removed at the other end
+BOOST_AUTO_TEST_CASE( testStreamedStateHistoryCapacity )
+{
+    for( unsigned int testCase = 0; testCase < 2; testCase++ )
+    {
+        bool addEntriesForward = ( testCase == 0 );
+        StateHistory< double, Eigen::VectorXd > stateHistory;
+        std::map< double, Eigen::VectorXd > stateMap;
+
+        // Emulate streaming of propagation results: add entry, and remove all but the latest few entries
+        unsigned int numberOfRetainedEntries = 3;
+        for( int i = 0; i < 100000; i++ )
+        {
+            double currentTime = ( addEntriesForward ? 1.0 : -1.0 ) * static_cast< double >( i );
+            Eigen::VectorXd currentState = Eigen::VectorXd::Constant( 6, currentTime );
+            stateHistory[ currentTime ] = currentState;
+            stateMap[ currentTime ] = currentState;
+            while( stateHistory.size( ) > numberOfRetainedEntries )
+            {
+                stateHistory.erase( addEntriesForward ? stateHistory.begin( ) : std::prev( stateHistory.end( ) ) );
+                stateMap.erase( addEntriesForward ? stateMap.begin( ) : std::prev( stateMap.end( ) ) );
+            }
+            BOOST_CHECK( stateHistory.getCapacity( ) <= 4 * static_cast< int >( numberOfRetainedEntries ) );
+        }
+        compareStateHistoryToMap( stateHistory, stateMap );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -64,7 +64,8 @@ executeEarthMoonSimulation(
         Eigen::Matrix< StateScalarType, 12, 1 >::Zero( ),
         const int propagationType = 0,
         const Eigen::Vector3d parameterPerturbation = Eigen::Vector3d::Zero( ),
-        const bool propagateVariationalEquations = 1 )
+        const bool propagateVariationalEquations = 1,
+        const unsigned int numberOfVariationalEquationsThreads = 1 )
 {
 
     //Load spice kernels.
@@ -194,6 +195,14 @@ executeEarthMoonSimulation(
                     bodyMap, integratorSettings, propagatorSettings, parametersToEstimate,
                     1, std::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ), 1, 0 );
 
+        // Split variational equations over threads, also for this (small) problem, if requested
+        if( numberOfVariationalEquationsThreads != 1 )
+        {
+            dynamicsSimulator.setNumberOfVariationalEquationsThreads( numberOfVariationalEquationsThreads );
+            dynamicsSimulator.getDynamicsSimulator( )->getDynamicsStateDerivative( )->getVariationalEquationsCalculator( )->
+                    setMinimumMultiplicationsPerColumnBlock( 0.0 );
+        }
+
         // Propagate requested equations.
         if( propagateVariationalEquations )
         {
@@ -338,6 +347,41 @@ BOOST_AUTO_TEST_CASE( testEarthMoonVariationalEquationCalculation )
     }
 }
 
+//! Test whether the variational equations evaluated over multiple threads are equal to those evaluated serially.
+/*!
+ *  Test whether the variational equations evaluated over multiple threads (with the state transition and sensitivity
+ *  matrix split into blocks of columns) are equal to those evaluated serially, for the Earth-Moon system of
+ *  testEarthMoonVariationalEquationCalculation, for a number of threads that does and does not divide the number of
+ *  columns.
+ */
+BOOST_AUTO_TEST_CASE( testParallelVariationalEquationCalculation )
+{
+    std::vector< std::string > centralBodies;
+    centralBodies.push_back( "Earth" );
+    centralBodies.push_back( "Sun" );
+
+    for( unsigned int k = 0; k < 2; k++ )
+    {
+        std::pair< std::vector< Eigen::MatrixXd >, std::vector< Eigen::VectorXd > > serialOutput =
+                executeEarthMoonSimulation< double, double >(
+                    centralBodies, Eigen::Matrix< double, 12, 1 >::Zero( ), k, Eigen::Vector3d::Zero( ), 1, 1 );
+
+        std::vector< unsigned int > numberOfThreadsList = { 2, 4, 15 };
+        for( unsigned int i = 0; i < numberOfThreadsList.size( ); i++ )
+        {
+            std::pair< std::vector< Eigen::MatrixXd >, std::vector< Eigen::VectorXd > > parallelOutput =
+                    executeEarthMoonSimulation< double, double >(
+                        centralBodies, Eigen::Matrix< double, 12, 1 >::Zero( ), k, Eigen::Vector3d::Zero( ), 1,
+                        numberOfThreadsList.at( i ) );
+
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        serialOutput.first.at( 0 ), parallelOutput.first.at( 0 ), 1.0E-12 );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        serialOutput.second.at( 0 ), parallelOutput.second.at( 0 ), 1.0E-14 );
+        }
+    }
+}
+
 template< typename TimeType = double , typename StateScalarType  = double >
 std::pair< std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > >,
 std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
@@ -604,6 +648,253 @@ BOOST_AUTO_TEST_CASE( testEarthOrbiterVariationalEquationCalculation )
 
 }
 
+//! Function to propagate the variational equations of a set of Earth orbiters that do not interact with one another.
+/*!
+ *  Function to propagate the variational equations of a set of Earth orbiters that do not interact with one another,
+ *  with the initial states and radiation pressure coefficients of all vehicles, and the Earth gravitational parameter
+ *  estimated.
+ *  \param vehicleIndices Indices of vehicles that are to be propagated (which define their initial orbits)
+ *  \param matrixHistoryStorageSettings Settings for the storage of the state transition and sensitivity matrix histories
+ *  \param testTimes Additional epochs at which the combined state transition and sensitivity matrix is to be computed
+ *  \param matricesAtTestTimes Combined state transition and sensitivity matrices at testTimes (returned by pointer, if
+ *  not nullptr)
+ *  \return Combined state transition and sensitivity matrix at test epoch, and variational equations object used in
+ *  propagation.
+ */
+std::pair< Eigen::MatrixXd, std::shared_ptr< VariationalEquations > > executeConstellationSimulation(
+        const std::vector< int >& vehicleIndices,
+        const std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings = nullptr,
+        const std::vector< double >& testTimes = std::vector< double >( ),
+        std::vector< Eigen::MatrixXd >* matricesAtTestTimes = nullptr )
+{
+    //Load spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    double initialEphemerisTime = 1.0E7;
+    double finalEphemerisTime = initialEphemerisTime + 4.0 * 3600.0;
+
+    // Create bodies needed in simulation
+    std::map< std::string, std::shared_ptr< BodySettings > > bodySettings =
+            getDefaultBodySettings( { "Earth", "Sun" } );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+
+    SelectedAccelerationMap accelerationMap;
+    std::vector< std::string > bodiesToIntegrate;
+    std::vector< std::string > centralBodies;
+    Eigen::VectorXd initialStates = Eigen::VectorXd::Zero( 6 * vehicleIndices.size( ) );
+    double earthGravitationalParameter = bodyMap.at( "Earth" )->getGravityFieldModel( )->getGravitationalParameter( );
+    for( unsigned int i = 0; i < vehicleIndices.size( ); i++ )
+    {
+        // Create vehicle with radiation pressure interface
+        std::string vehicleName = "Vehicle" + std::to_string( vehicleIndices.at( i ) );
+        bodyMap[ vehicleName ] = std::make_shared< Body >( );
+        bodyMap[ vehicleName ]->setConstantBodyMass( 400.0 );
+        bodyMap[ vehicleName ]->setRadiationPressureInterface(
+                    "Sun", createRadiationPressureInterface(
+                        std::make_shared< CannonBallRadiationPressureInterfaceSettings >(
+                            "Sun", 4.0 + vehicleIndices.at( i ), 1.2, std::vector< std::string >{ "Earth" } ),
+                        vehicleName, bodyMap ) );
+        bodyMap[ vehicleName ]->setEphemeris( std::make_shared< TabulatedCartesianEphemeris< > >(
+                                                  std::shared_ptr< interpolators::OneDimensionalInterpolator
+                                                  < double, Eigen::Vector6d > >( ), "Earth", "ECLIPJ2000" ) );
+
+        // Set accelerations of vehicle
+        accelerationMap[ vehicleName ][ "Earth" ].push_back(
+                    std::make_shared< AccelerationSettings >( basic_astrodynamics::central_gravity ) );
+        accelerationMap[ vehicleName ][ "Sun" ].push_back(
+                    std::make_shared< AccelerationSettings >( basic_astrodynamics::cannon_ball_radiation_pressure ) );
+        bodiesToIntegrate.push_back( vehicleName );
+        centralBodies.push_back( "Earth" );
+
+        // Set initial state of vehicle
+        Eigen::Vector6d initialStateInKeplerianElements;
+        initialStateInKeplerianElements( semiMajorAxisIndex ) = 7000.0E3 + 500.0E3 * vehicleIndices.at( i );
+        initialStateInKeplerianElements( eccentricityIndex ) = 0.01 + 0.02 * vehicleIndices.at( i );
+        initialStateInKeplerianElements( inclinationIndex ) =
+                unit_conversions::convertDegreesToRadians( 40.0 + 20.0 * vehicleIndices.at( i ) );
+        initialStateInKeplerianElements( argumentOfPeriapsisIndex ) = 0.3 * vehicleIndices.at( i );
+        initialStateInKeplerianElements( longitudeOfAscendingNodeIndex ) = 1.1 * vehicleIndices.at( i );
+        initialStateInKeplerianElements( trueAnomalyIndex ) = 2.0 * vehicleIndices.at( i );
+        initialStates.segment( 6 * i, 6 ) = convertKeplerianToCartesianElements(
+                    initialStateInKeplerianElements, earthGravitationalParameter );
+    }
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Create acceleration models and propagation settings
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, bodiesToIntegrate, centralBodies );
+    std::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            std::make_shared< TranslationalStatePropagatorSettings< double > >
+            ( centralBodies, accelerationModelMap, bodiesToIntegrate, initialStates, finalEphemerisTime );
+    std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+            std::make_shared< IntegratorSettings< double > >( rungeKutta4, initialEphemerisTime, 10.0 );
+
+    // Define parameters.
+    std::vector< std::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    for( unsigned int i = 0; i < vehicleIndices.size( ); i++ )
+    {
+        parameterNames.push_back(
+                    std::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                        bodiesToIntegrate.at( i ), initialStates.segment( 6 * i, 6 ), "Earth" ) );
+    }
+    parameterNames.push_back( std::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    for( unsigned int i = 0; i < vehicleIndices.size( ); i++ )
+    {
+        parameterNames.push_back( std::make_shared< EstimatableParameterSettings >(
+                                      bodiesToIntegrate.at( i ), radiation_pressure_coefficient ) );
+    }
+    std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate( parameterNames, bodyMap );
+
+    // Propagate variational equations
+    SingleArcVariationalEquationsSolver< double, double > dynamicsSimulator(
+                bodyMap, integratorSettings, propagatorSettings, parametersToEstimate,
+                1, std::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ), 1, 0 );
+    dynamicsSimulator.setMatrixHistoryStorageSettings( matrixHistoryStorageSettings );
+    dynamicsSimulator.integrateVariationalAndDynamicalEquations( propagatorSettings->getInitialStates( ), 1 );
+
+    if( matricesAtTestTimes != nullptr )
+    {
+        matricesAtTestTimes->clear( );
+        for( unsigned int i = 0; i < testTimes.size( ); i++ )
+        {
+            matricesAtTestTimes->push_back(
+                        dynamicsSimulator.getStateTransitionMatrixInterface( )->
+                        getCombinedStateTransitionAndSensitivityMatrix( testTimes.at( i ) ) );
+        }
+    }
+
+    return std::make_pair(
+                dynamicsSimulator.getStateTransitionMatrixInterface( )->getCombinedStateTransitionAndSensitivityMatrix(
+                    initialEphemerisTime + 3.5 * 3600.0 ),
+                dynamicsSimulator.getDynamicsSimulator( )->getDynamicsStateDerivative( )->
+                getVariationalEquationsCalculator( ) );
+}
+
+//! Test the block-sparse evaluation of the variational equations for bodies that do not interact with one another.
+/*!
+ *  Test the block-sparse evaluation of the variational equations, for a set of Earth orbiters that do not interact with
+ *  one another. It is checked that only the diagonal blocks of the state partials are used, and that only the partials
+ *  of each vehicle w.r.t. its own radiation pressure coefficient (and the common Earth gravitational parameter) are used.
+ *  The state transition and sensitivity matrices of the combined propagation are compared to those of each vehicle
+ *  propagated individually.
+ */
+BOOST_AUTO_TEST_CASE( testBlockSparseVariationalEquationCalculation )
+{
+    std::vector< int > vehicleIndices = { 0, 1, 2 };
+    int numberOfVehicles = vehicleIndices.size( );
+    std::pair< Eigen::MatrixXd, std::shared_ptr< VariationalEquations > > combinedOutput =
+            executeConstellationSimulation( vehicleIndices );
+
+    // Check block structure of partials
+    std::vector< std::pair< int, int > > stateBlockIndices = combinedOutput.second->getStateBlockIndices( );
+    std::vector< std::vector< int > > nonZeroStateBlocks = combinedOutput.second->getNonZeroStatePartialBlocks( );
+    std::vector< std::vector< std::pair< int, int > > > nonZeroParameterBlocks =
+            combinedOutput.second->getNonZeroParameterPartialBlocks( );
+    BOOST_CHECK_EQUAL( stateBlockIndices.size( ), numberOfVehicles );
+    BOOST_CHECK_EQUAL( nonZeroStateBlocks.size( ), numberOfVehicles );
+    BOOST_CHECK_EQUAL( nonZeroParameterBlocks.size( ), numberOfVehicles );
+    for( int i = 0; i < numberOfVehicles; i++ )
+    {
+        BOOST_CHECK_EQUAL( stateBlockIndices.at( i ).first, 6 * i );
+        BOOST_CHECK_EQUAL( stateBlockIndices.at( i ).second, 6 );
+
+        BOOST_CHECK_EQUAL( nonZeroStateBlocks.at( i ).size( ), 1 );
+        BOOST_CHECK_EQUAL( nonZeroStateBlocks.at( i ).at( 0 ), i );
+
+        BOOST_CHECK_EQUAL( nonZeroParameterBlocks.at( i ).size( ), 2 );
+        BOOST_CHECK_EQUAL( nonZeroParameterBlocks.at( i ).at( 0 ).first, 6 * numberOfVehicles );
+        BOOST_CHECK_EQUAL( nonZeroParameterBlocks.at( i ).at( 0 ).second, 1 );
+        BOOST_CHECK_EQUAL( nonZeroParameterBlocks.at( i ).at( 1 ).first, 6 * numberOfVehicles + 1 + i );
+        BOOST_CHECK_EQUAL( nonZeroParameterBlocks.at( i ).at( 1 ).second, 1 );
+    }
+
+    // Compare against individually propagated vehicles
+    for( int i = 0; i < numberOfVehicles; i++ )
+    {
+        Eigen::MatrixXd singleVehicleMatrix = executeConstellationSimulation( { vehicleIndices.at( i ) } ).first;
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    combinedOutput.first.block( 6 * i, 6 * i, 6, 6 ), singleVehicleMatrix.block( 0, 0, 6, 6 ), 1.0E-12 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    combinedOutput.first.block( 6 * i, 6 * numberOfVehicles, 6, 1 ),
+                    singleVehicleMatrix.block( 0, 6, 6, 1 ), 1.0E-12 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    combinedOutput.first.block( 6 * i, 6 * numberOfVehicles + 1 + i, 6, 1 ),
+                    singleVehicleMatrix.block( 0, 7, 6, 1 ), 1.0E-12 );
+
+        // Check that there is no coupling between vehicles
+        for( int j = 0; j < numberOfVehicles; j++ )
+        {
+            if( i != j )
+            {
+                BOOST_CHECK_EQUAL( combinedOutput.first.block( 6 * i, 6 * j, 6, 6 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+                BOOST_CHECK_EQUAL( combinedOutput.first( 6 * i, 6 * numberOfVehicles + 1 + j ), 0.0 );
+            }
+        }
+    }
+}
+
+//! Test the memory-mapped storage of the state transition and sensitivity matrix histories.
+/*!
+ *  Test the memory-mapped storage of the state transition and sensitivity matrix histories, by comparing the
+ *  interpolated state transition and sensitivity matrices to those of the default in-memory storage. In double
+ *  precision, the results must be identical. When storing single precision differences w.r.t. the initial matrices,
+ *  the results must be equal to within single precision, relative to the size of the entries of each column.
+ */
+BOOST_AUTO_TEST_CASE( testMemoryMappedVariationalEquationsStorage )
+{
+    std::vector< int > vehicleIndices = { 0, 1 };
+    std::vector< double > testTimes;
+    for( unsigned int i = 0; i < 50; i++ )
+    {
+        testTimes.push_back( 1.0E7 + 10.0 + 287.3 * i );
+    }
+
+    std::vector< Eigen::MatrixXd > inMemoryMatrices;
+    executeConstellationSimulation( vehicleIndices, nullptr, testTimes, &inMemoryMatrices );
+
+    // Test memory-mapped storage (double and float), and Chebyshev polynomial fit
+    for( unsigned int test = 0; test < 3; test++ )
+    {
+        std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings;
+        if( test < 2 )
+        {
+            matrixHistoryStorageSettings = std::make_shared< MatrixHistoryStorageSettings >(
+                        test == 0 ? memory_mapped_matrix_history : memory_mapped_float_delta_matrix_history );
+        }
+        else
+        {
+            matrixHistoryStorageSettings = std::make_shared< ChebyshevMatrixHistoryStorageSettings >( 10, 40, 1.0E-10 );
+        }
+
+        std::vector< Eigen::MatrixXd > storedMatrices;
+        executeConstellationSimulation( vehicleIndices, matrixHistoryStorageSettings, testTimes, &storedMatrices );
+
+        BOOST_CHECK_EQUAL( storedMatrices.size( ), testTimes.size( ) );
+        for( unsigned int i = 0; i < testTimes.size( ); i++ )
+        {
+            if( test == 0 )
+            {
+                BOOST_CHECK_EQUAL( ( storedMatrices.at( i ) - inMemoryMatrices.at( i ) ).cwiseAbs( ).maxCoeff( ),
+                                   0.0 );
+            }
+            else
+            {
+                // Chebyshev fit is compared to 4th order Lagrange interpolation, so both contribute to difference
+                double relativeTolerance = ( test == 1 ) ? 1.0E-6 : 1.0E-7;
+                for( int j = 0; j < inMemoryMatrices.at( i ).cols( ); j++ )
+                {
+                    BOOST_CHECK_SMALL(
+                                ( storedMatrices.at( i ) - inMemoryMatrices.at( i ) ).col( j ).cwiseAbs( ).maxCoeff( ),
+                                relativeTolerance * ( inMemoryMatrices.at( i ).col( j ).cwiseAbs( ).maxCoeff( ) +
+                                                      inMemoryMatrices.at( 0 ).col( j ).cwiseAbs( ).maxCoeff( ) ) );
+                }
+            }
+        }
+    }
+}
+
 template< typename TimeType = double , typename StateScalarType  = double >
         std::pair< std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > >,
 std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
@@ -19,6 +19,7 @@
 #include <functional>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/massRateModel.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
 #include "Tudat/Astrodynamics/Propagators/singleStateTypeDerivative.h"
 
 
@@ -146,13 +147,61 @@ public:
 
 
         // Update local variables of mass rate model objects.
+        unsigned int currentModelIndex = 0;
         for( massRateModelIterator_ = massRateModels_.begin( );
              massRateModelIterator_ != massRateModels_.end( );
              massRateModelIterator_++ )
         {
             for( unsigned int i = 0; i < massRateModelIterator_->second.size( ); i++ )
             {
-                massRateModelIterator_->second.at ( i )->updateMembers( static_cast< double >( currentTime ) );
+                if( propagationProfiler_ == nullptr )
+                {
+                    massRateModelIterator_->second.at ( i )->updateMembers( static_cast< double >( currentTime ) );
+                }
+                else
+                {
+                    PropagationProfiler::ClockType::time_point startTime = PropagationProfiler::ClockType::now( );
+                    massRateModelIterator_->second.at ( i )->updateMembers( static_cast< double >( currentTime ) );
+                    propagationProfiler_->addFunctionCall( profiledMassRateModelIndices_[ currentModelIndex ], startTime );
+                    currentModelIndex++;
+                }
+            }
+        }
+    }
+
+    //! Function to set the object used to profile the computation time of the mass rate models.
+    /*!
+     * Function to set the object used to profile the computation time of the mass rate models. Each mass rate model
+     * is registered with the profiler by this function, identified by its type and the body of which the mass is propagated.
+     * \param profiler Object used to profile the computation time of the models (nullptr to stop profiling).
+     */
+    void setPropagationProfiler( const std::shared_ptr< PropagationProfiler > profiler )
+    {
+        propagationProfiler_ = profiler;
+        profiledMassRateModelIndices_.clear( );
+        if( propagationProfiler_ != nullptr )
+        {
+            for( massRateModelIterator_ = massRateModels_.begin( );
+                 massRateModelIterator_ != massRateModels_.end( );
+                 massRateModelIterator_++ )
+            {
+                for( unsigned int i = 0; i < massRateModelIterator_->second.size( ); i++ )
+                {
+                    std::string massRateName = "custom mass rate";
+                    try
+                    {
+                        if( basic_astrodynamics::getMassRateModelType( massRateModelIterator_->second.at( i ) ) ==
+                                basic_astrodynamics::from_thrust_mass_rate_model )
+                        {
+                            massRateName = "from thrust mass rate";
+                        }
+                    }
+                    catch( const std::runtime_error& ){ }
+
+                    profiledMassRateModelIndices_.push_back(
+                                propagationProfiler_->addProfiledFunction(
+                                    mass_rate_model_profile, massRateName + " of " + massRateModelIterator_->first ) );
+                }
             }
         }
     }
@@ -245,6 +294,12 @@ private:
     //! Predefined iterator to save (de-)allocation time.
     std::map< std::string, std::vector< std::shared_ptr< basic_astrodynamics::MassRateModel > > >::const_iterator massRateModelIterator_;
 
+    //! Object used to profile the computation time of the mass rate models (nullptr if not profiled).
+    std::shared_ptr< PropagationProfiler > propagationProfiler_;
+
+    //! Index in propagationProfiler_ of each mass rate model, in the order in which they are updated.
+    std::vector< unsigned int > profiledMassRateModelIndices_;
+
     //! List of bodies for which the mass is to be propagated.
     /*!
      * List of bodies for which the mass is to be propagated. Note that this vector have
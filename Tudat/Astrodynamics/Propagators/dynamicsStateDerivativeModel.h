@@ -27,6 +27,7 @@
 #include "Tudat/Astrodynamics/Propagators/singleStateTypeDerivative.h"
 #include "Tudat/Astrodynamics/Propagators/nBodyStateDerivative.h"
 #include "Tudat/Astrodynamics/Propagators/rotationalMotionStateDerivative.h"
+#include "Tudat/Astrodynamics/Propagators/stateHistory.h"
 #include "Tudat/Astrodynamics/Propagators/variationalEquations.h"
 
 namespace tudat
@@ -65,7 +66,7 @@ public:
             stateDerivativeModels,
             const std::function< void(
                 const TimeType, const std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&,
-                const std::vector< IntegratedStateType > ) > environmentUpdateFunction,
+                const std::vector< IntegratedStateType >& ) > environmentUpdateFunction,
             const std::shared_ptr< VariationalEquations > variationalEquations =
             std::shared_ptr< VariationalEquations >( ) ):
         environmentUpdateFunction_( environmentUpdateFunction ), variationalEquations_( variationalEquations ),
@@ -128,6 +129,11 @@ public:
             currentStatesPerTypeInConventionalRepresentation_[ stateDerivativeModels.at( i )->getIntegratedStateType( )  ] =
                     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
                         conventionalStateTypeSize_.at( stateDerivativeModels.at( i )->getIntegratedStateType( )  ), 1 );
+
+            // Pre-allocate buffer for propagated state of current model
+            currentPropagatedStatesPerModel_[ stateDerivativeModels.at( i )->getIntegratedStateType( ) ].push_back(
+                        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
+                            stateDerivativeModels.at( i )->getPropagatedStateSize( ) ) );
         }
     }
 
@@ -145,93 +151,26 @@ public:
      */
     StateType computeStateDerivative( const TimeType time, const StateType& state )
     {
-//        std::cout << "Computing state derivative: " <<time<<" "<<state.transpose( ) << std::endl;
-
-        // Initialize state derivative
-        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
-        {
-            stateDerivative_.resize( state.rows( ), state.cols( ) );
-        }
-
-        // If dynamical equations are integrated, update the environment with the current state.
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    stateDerivativeModelsIterator_->second.at( i )->clearStateDerivativeModel( );
-                }
-            }
-
-            convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
-            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
-                                        integratedStatesFromEnvironment_ );
-        }
-        else
-        {
-            environmentUpdateFunction_(
-                        time, std::unordered_map<
-                        IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ),
-                        integratedStatesFromEnvironment_ );
-        }
-
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->clearPartials( );
-        }
-
-        // If dynamical equations are integrated, evaluate dynamics state derivatives.
-        std::pair< int, int > currentIndices;
-        if( evaluateDynamicsEquations_ )
-        {
-            // Iterate over all types of equations.
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Update state derivative models
-                    stateDerivativeModelsIterator_->second.at( i )->updateStateDerivativeModel( time );
-                }
-            }
-
-            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
-                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
-                 stateDerivativeModelsIterator_++ )
-            {
-                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
-                {
-                    // Evaluate and set current dynamical state derivative
-                    currentIndices = propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
-
-                    stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
-                                time, state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ),
-                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
-                }
-            }
-        }
-
-        // If variational equations are to be integrated: evaluate and set.
-        if( evaluateVariationalEquations_ )
-        {
-            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
-
-            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
-                        time, state.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
-                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
-        }
-
-        // Update counters
-        functionEvaluationCounter_++;
-        cumulativeFunctionEvaluationCounter_[ time ] = functionEvaluationCounter_;
-
+        updateStateDerivative( time, state );
         return stateDerivative_;
+    }
 
+    //! Function to calculate the system state derivative, without returning it by value.
+    /*!
+     *  Function to calculate the system state derivative, identical to computeStateDerivative, but with the state
+     *  derivative returned by reference. Once the derivative has been computed for a state of the current size, this
+     *  function does not perform any heap allocation itself (the state derivative models and environment updates that it
+     *  calls may still do so). This function is used by the numerical integrators during the propagation
+     *  (see NumericalIntegrator::setInPlaceStateDerivativeFunction).
+     *  \param time Current time.
+     *  \param state Current complete state (matrix or vector)
+     *  \param stateDerivative Calculated state derivative (returned by reference).
+     */
+    template< typename StateMatrixType >
+    void computeStateDerivativeInPlace( const TimeType time, const StateMatrixType& state, StateMatrixType& stateDerivative )
+    {
+        updateStateDerivative( time, state );
+        stateDerivative = stateDerivative_;
     }
 
     //! Function to calculate the system state derivative with double precision, regardless of template arguments.
@@ -355,6 +294,28 @@ public:
         }
     }
 
+    //! Function to convert a state history from propagator-specific form to the conventional form.
+    /*!
+     * Function to convert a state history from propagator-specific form to the conventional form
+     * (not necessarily in inertial frame), with both histories stored contiguously.
+     * \sa DynamicsStateDerivativeModel::convertToOutputSolution
+     * \param convertedSolution State history (rawSolution), converted to the 'conventional form' (by reference)
+     * \param rawSolution State history in propagator-specific form (i.e. form that is used in
+     *        numerical integration).
+     */
+    void convertNumericalStateSolutionsToOutputSolutions(
+            StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& convertedSolution,
+            const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& rawSolution )
+    {
+        convertedSolution.reserve( convertedSolution.size( ) + rawSolution.size( ) );
+        for( unsigned int i = 0; i < rawSolution.size( ); i++ )
+        {
+            convertedSolution.insert(
+                        rawSolution.getTime( i ),
+                        convertToOutputSolution( rawSolution.getState( i ), rawSolution.getTime( i ) ) );
+        }
+    }
+
     //! Function to process the state vector during propagation.
     /*!
      * Function to process the state vector during propagation.
@@ -382,6 +343,27 @@ public:
         }
     }
 
+    //! Function to check whether the state vector is to be post-processed during propagation.
+    /*!
+     * Function to check whether the state vector is to be post-processed during propagation (see postProcessState), i.e.
+     * whether any of the state derivative models modifies its part of the state after an integration step.
+     * \return True if the state vector is to be post-processed during propagation.
+     */
+    bool isStateToBePostProcessed( )
+    {
+        for( auto stateDerivativeModelsIterator : stateDerivativeModels_ )
+        {
+            for( unsigned int i = 0; i < stateDerivativeModelsIterator.second.size( ); i++ )
+            {
+                if( stateDerivativeModelsIterator.second.at( i )->isStateToBePostProcessed( ) )
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     //! Function to process the state vector and variational equations during propagation.
     /*!
      * Function to process the state vector and variational equations during propagation.
@@ -531,6 +513,17 @@ public:
         return conventionalStateTypeStartIndex_;
     }
 
+    //! Function to get the total length of the propagated state vector.
+    /*!
+     * Function to get the total length of the propagated state vector (i.e. in propagator-specific form), excluding the
+     * variational equations.
+     * \return Total length of the propagated state vector.
+     */
+    int getPropagatedStateSize( )
+    {
+        return totalPropagatedStateSize_;
+    }
+
     //! Function to retrieve number of calls to the computeStateDerivative function
     /*!
      * Function to retrieve number of calls to the computeStateDerivative function since object creation/last call to
@@ -575,6 +568,44 @@ public:
         cumulativeFunctionEvaluationCounter_.clear( );
     }
 
+    //! Function to set the number of calls to the computeStateDerivative function (total and per time step)
+    /*!
+     * Function to set the number of calls to the computeStateDerivative function (total and per time step), typically
+     * called when resuming a propagation from a checkpoint (automatically by DynamicsSimulator)
+     * \param functionEvaluationCounter Number of calls to the computeStateDerivative function
+     * \param cumulativeFunctionEvaluationCounter Number of calls to the computeStateDerivative function per time step
+     */
+    void setFunctionEvaluationCounters(
+            const unsigned int functionEvaluationCounter,
+            const std::map< TimeType, unsigned int >& cumulativeFunctionEvaluationCounter )
+    {
+        functionEvaluationCounter_ = functionEvaluationCounter;
+        cumulativeFunctionEvaluationCounter_ = cumulativeFunctionEvaluationCounter;
+    }
+
+    //! Function to set whether the number of calls to the computeStateDerivative function per time step is recorded
+    /*!
+     * Function to set whether the number of calls to the computeStateDerivative function per time step is recorded
+     * (see getCumulativeNumberOfFunctionEvaluations). By default, it is not, since recording it requires an
+     * allocation for each function evaluation.
+     * \param recordCumulativeFunctionEvaluations Boolean denoting whether the cumulative number of function evaluations
+     * is to be recorded.
+     */
+    void setRecordCumulativeFunctionEvaluations( const bool recordCumulativeFunctionEvaluations )
+    {
+        recordCumulativeFunctionEvaluations_ = recordCumulativeFunctionEvaluations;
+    }
+
+    //! Function to retrieve whether the number of calls to the computeStateDerivative function per time step is recorded
+    /*!
+     * Function to retrieve whether the number of calls to the computeStateDerivative function per time step is recorded
+     * \return Boolean denoting whether the cumulative number of function evaluations is recorded.
+     */
+    bool getRecordCumulativeFunctionEvaluations( )
+    {
+        return recordCumulativeFunctionEvaluations_;
+    }
+
     //! Function to retrieve the object used for computing the state derivative in the variational equations
     /*!
      * Function to retrieve the object used for computing the state derivative in the variational equations
@@ -588,6 +619,106 @@ public:
 
 private:
 
+    //! Function to calculate the system state derivative, and set it in the stateDerivative_ member
+    /*!
+     *  Function to calculate the system state derivative, and set it in the stateDerivative_ member (see
+     *  computeStateDerivative). All intermediate quantities are stored in pre-allocated member variables.
+     *  \param time Current time.
+     *  \param state Current complete state (matrix or vector).
+     */
+    template< typename StateMatrixType >
+    void updateStateDerivative( const TimeType time, const StateMatrixType& state )
+    {
+        // Initialize state derivative
+        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
+        {
+            stateDerivative_.resize( state.rows( ), state.cols( ) );
+        }
+
+        // If dynamical equations are integrated, update the environment with the current state.
+        if( evaluateDynamicsEquations_ )
+        {
+            // Iterate over all types of equations.
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    stateDerivativeModelsIterator_->second.at( i )->clearStateDerivativeModel( );
+                }
+            }
+
+            convertCurrentStateToGlobalRepresentationPerType( state, time, evaluateVariationalEquations_ );
+            environmentUpdateFunction_( time, currentStatesPerTypeInConventionalRepresentation_,
+                                        integratedStatesFromEnvironment_ );
+        }
+        else
+        {
+            environmentUpdateFunction_( time, emptyStatesPerType_, integratedStatesFromEnvironment_ );
+        }
+
+        if( evaluateVariationalEquations_ )
+        {
+            variationalEquations_->clearPartials( );
+        }
+
+        // If dynamical equations are integrated, evaluate dynamics state derivatives.
+        std::pair< int, int > currentIndices;
+        if( evaluateDynamicsEquations_ )
+        {
+            // Iterate over all types of equations.
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    // Update state derivative models
+                    stateDerivativeModelsIterator_->second.at( i )->updateStateDerivativeModel( time );
+                }
+            }
+
+            for( stateDerivativeModelsIterator_ = stateDerivativeModels_.begin( );
+                 stateDerivativeModelsIterator_ != stateDerivativeModels_.end( );
+                 stateDerivativeModelsIterator_++ )
+            {
+                std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& currentPropagatedStates =
+                        currentPropagatedStatesPerModel_.at( stateDerivativeModelsIterator_->first );
+                for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
+                {
+                    // Evaluate and set current dynamical state derivative
+                    currentIndices = propagatedStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
+                    currentPropagatedStates[ i ] = state.block(
+                                currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 );
+
+                    stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
+                                time, currentPropagatedStates[ i ],
+                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
+                }
+            }
+        }
+
+        // If variational equations are to be integrated: evaluate and set.
+        if( evaluateVariationalEquations_ )
+        {
+            variationalEquations_->updatePartials( time, currentStatesPerTypeInConventionalRepresentation_ );
+
+            currentVariationalState_ = state.block(
+                        0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) );
+            variationalEquations_->evaluateVariationalEquations< StateScalarType >(
+                        time, currentVariationalState_,
+                        stateDerivative_.block( 0, 0, totalConventionalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ) );
+        }
+
+        // Update counters
+        functionEvaluationCounter_++;
+        if( recordCumulativeFunctionEvaluations_ )
+        {
+            cumulativeFunctionEvaluationCounter_[ time ] = functionEvaluationCounter_;
+        }
+    }
+
     //! Function to convert the to the conventional form in the global frame per dynamics type.
     /*!
      * Function to convert the propagator-specific form of the state to the conventional form in the global frame, split
@@ -602,8 +733,9 @@ private:
      * \param stateIncludesVariationalState Boolean defining whether the stae includes the state transition/sensitivity
      * matrices
      */
+    template< typename StateMatrixType >
     void convertCurrentStateToGlobalRepresentationPerType(
-            const StateType& state, const TimeType& time, const bool stateIncludesVariationalState )
+            const StateMatrixType& state, const TimeType& time, const bool stateIncludesVariationalState )
     {
         int startColumn = 0;
         if( stateIncludesVariationalState )
@@ -623,6 +755,8 @@ private:
              stateDerivativeModelsIterator_++ )
         {
             int currentStateTypeSize = 0;
+            std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& currentPropagatedStates =
+                    currentPropagatedStatesPerModel_.at( stateDerivativeModelsIterator_->first );
 
             // Iterate over all state derivative models of current type
             for( unsigned int i = 0; i < stateDerivativeModelsIterator_->second.size( ); i++ )
@@ -632,8 +766,10 @@ private:
                 currentConventionalIndices = conventionalStateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
 
                 // Set current block in split state (in global form)
+                currentPropagatedStates[ i ] = state.block(
+                            currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 );
                 stateDerivativeModelsIterator_->second.at( i )->convertCurrentStateToGlobalRepresentation(
-                            state.block( currentPropagatedIndices.first, startColumn, currentPropagatedIndices.second, 1 ), time,
+                            currentPropagatedStates[ i ], time,
                             currentStatesPerTypeInConventionalRepresentation_.at(
                                 stateDerivativeModelsIterator_->first ).block(
                                 currentStateTypeSize, 0, currentConventionalIndices.second, 1 ) );
@@ -642,10 +778,11 @@ private:
         }
     }
 
+    //! Function which is used to update time-dependent environment models to current time and state
     std::function<
     void( const TimeType, const std::unordered_map< IntegratedStateType,
           Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&,
-          const std::vector< IntegratedStateType > ) > environmentUpdateFunction_;
+          const std::vector< IntegratedStateType >& ) > environmentUpdateFunction_;
 
     //! Object used for computing the state derivative in the variational equations
     std::shared_ptr< VariationalEquations > variationalEquations_;
@@ -707,9 +844,23 @@ private:
     std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
     currentStatesPerTypeInConventionalRepresentation_;
 
+    //! Current propagated state of each state derivative model (pre-allocated), sorted per state type.
+    std::unordered_map< IntegratedStateType, std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    currentPropagatedStatesPerModel_;
+
+    //! Current state transition and sensitivity matrices (pre-allocated), if variational equations are propagated.
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > currentVariationalState_;
+
+    //! Empty list of states, used to update the environment if the dynamical equations are not evaluated.
+    std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
+    emptyStatesPerType_;
+
     //! Variable to keep track of the number of calls to the computeStateDerivative function
     unsigned int functionEvaluationCounter_ = 0;
 
+    //! Boolean denoting whether the number of calls to the computeStateDerivative function per time step is recorded
+    bool recordCumulativeFunctionEvaluations_ = false;
+
     //! Variable to keep track of the number of calls to the computeStateDerivative function per time step
     std::map< TimeType, unsigned int > cumulativeFunctionEvaluationCounter_;
 };
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <stdexcept>
 #include "Tudat/Astrodynamics/Propagators/environmentUpdateTypes.h"
 
 namespace tudat
@@ -17,6 +18,37 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to get a string representing an environment update type.
+std::string getEnvironmentUpdateTypeName( const EnvironmentModelsToUpdate updateType )
+{
+    std::string updateTypeName;
+    switch( updateType )
+    {
+    case body_translational_state_update:
+        updateTypeName = "translational state update";
+        break;
+    case body_rotational_state_update:
+        updateTypeName = "rotational state update";
+        break;
+    case body_mass_update:
+        updateTypeName = "mass update";
+        break;
+    case spherical_harmonic_gravity_field_update:
+        updateTypeName = "spherical harmonic gravity field update";
+        break;
+    case vehicle_flight_conditions_update:
+        updateTypeName = "flight conditions update";
+        break;
+    case radiation_pressure_interface_update:
+        updateTypeName = "radiation pressure interface update";
+        break;
+    default:
+        throw std::runtime_error( "Error, did not recognize environment update type " +
+                                  std::to_string( updateType ) );
+    }
+    return updateTypeName;
+}
+
 //! Function to extend existing list of required environment update types
 void addEnvironmentUpdates( std::map< propagators::EnvironmentModelsToUpdate,
                             std::vector< std::string > >& environmentUpdateList,
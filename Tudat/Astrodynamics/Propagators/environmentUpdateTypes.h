@@ -33,6 +33,14 @@ enum EnvironmentModelsToUpdate
     radiation_pressure_interface_update = 5
 };
 
+//! Function to get a string representing an environment update type.
+/*!
+ * Function to get a string representing an environment update type.
+ * \param updateType Type of environment update.
+ * \return String with environment update type.
+ */
+std::string getEnvironmentUpdateTypeName( const EnvironmentModelsToUpdate updateType );
+
 //! Function to extend existing list of required environment update types
 /*!
  * Function to extend existing list of required environment update types
@@ -18,7 +18,12 @@ Eigen::MatrixXd, double, double >(
         const std::function< void( Eigen::MatrixXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::MatrixXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::MatrixXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::MatrixXd&, const Eigen::VectorXd& ) > finalStateFunction );
 
 template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
 Eigen::VectorXd, double, double >(
@@ -32,7 +37,31 @@ Eigen::VectorXd, double, double >(
         const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > finalStateFunction );
+
+template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
+Eigen::VectorXd, double, double >(
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator,
+        const double initialTimeStep,
+        const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
+        StateHistory< double, Eigen::VectorXd >& solutionHistory,
+        StateHistory< double, Eigen::VectorXd >& dependentVariableHistory,
+        StateHistory< double, double >& cumulativeComputationTimeHistory,
+        const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+        const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
+        const int saveFrequency,
+        const double printInterval,
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > finalStateFunction );
 
 } // namespace propagators
 
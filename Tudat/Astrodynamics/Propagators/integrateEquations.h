@@ -22,7 +22,10 @@
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
 #include "Tudat/Basics/timeType.h"
+#include "Tudat/Astrodynamics/Propagators/propagationCheckpoint.h"
+#include "Tudat/Astrodynamics/Propagators/propagationEventDetection.h"
 #include "Tudat/Astrodynamics/Propagators/singleStateTypeDerivative.h"
+#include "Tudat/Astrodynamics/Propagators/stateHistory.h"
 #include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
 #include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
 #include "Tudat/Mathematics/RootFinders/createRootFinder.h"
@@ -66,13 +69,41 @@ TimeStepType getTerminationDependentVariableErrorForGivenTimeStep(
     return dependentVariableError;
 }
 
+//! Function to determine, for a given time step within the last step of the numerical integrator, the error in termination
+//! dependent variable, using the dense output of the integrator
+/*!
+ *  Function to determine, for a given time step within the last step of the numerical integrator, the error in termination
+ *  dependent variable. The state is computed from the dense output of the integrator, so that no integration step needs to
+ *  be taken (the state derivative function is only evaluated to update the environment and dependent variables). This
+ *  function is used as input for the root finder when the propagation must terminate exactly on a dependent variable value
+ *  \param timeStep Time step w.r.t. the start of the last step of the numerical integrator
+ *  \param integrator Numerical integrator used for propagation (must provide dense output)
+ *  \param dependentVariableTerminationCondition Settings used to determine value/type of dependent variable at which propagation
+ *  is to terminate
+ *  \return The difference between the reached and required value of the termination dependent variable
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+TimeStepType getTerminationDependentVariableErrorFromDenseOutput(
+        TimeStepType timeStep,
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > >
+        integrator,
+        const std::shared_ptr< SingleVariableLimitPropagationTerminationCondition > dependentVariableTerminationCondition )
+{
+    // Interpolate state within last step, and retrieve value of dependent variable
+    const TimeType currentTime = integrator->getPreviousIndependentVariable( ) + timeStep;
+    integrator->getStateDerivativeFunction( )( currentTime, integrator->getDenseOutputState( currentTime ) );
+    return static_cast< TimeStepType >( dependentVariableTerminationCondition->getStopConditionError( ) );
+}
+
 //! Function that propagates to an exact final condition (within tolerance) for dependent variable termination condition
 /*!
  * Function that propagates to an exact final condition (within tolerance) for dependent variable termination condition.
  * Determines the time step that is to be taken by using a root finder, and returns (by reference) the converged final time
  * and state.
+ * If the integrator provides dense output, the state within the last step is interpolated, so that no integration steps
+ * are taken by the root finder.
  * \param integrator Numerical integrator that is used for propagation. Upon input to this function, the integrator is rolled
- * back to the secondToLastTime/secondToLastState
+ * back to the secondToLastTime/secondToLastState (or, if it provides dense output, is at the lastTime/lastState).
  * \param dependentVariableTerminationCondition Termination condition that is to be used
  * \param secondToLastTime Second to last time (e.g. last time at which integration did not exceed termination condition)
  * \param lastTime Time at which integration first exceeded termination condition
@@ -96,9 +127,20 @@ void getFinalStateForExactDependentVariableTerminationCondition(
     TUDAT_UNUSED_PARAMETER( secondToLastState );
 
     // Function for which the root (zero value) occurs at the required end time/state
-    std::function< TimeStepType( TimeStepType ) > dependentVariableErrorFunction =
-            std::bind( &getTerminationDependentVariableErrorForGivenTimeStep< StateType, TimeType, TimeStepType >, std::placeholders::_1,
-                       integrator, dependentVariableTerminationCondition );
+    const bool useDenseOutput = integrator->isDenseOutputAvailable( );
+    std::function< TimeStepType( TimeStepType ) > dependentVariableErrorFunction;
+    if( useDenseOutput )
+    {
+        dependentVariableErrorFunction =
+                std::bind( &getTerminationDependentVariableErrorFromDenseOutput< StateType, TimeType, TimeStepType >,
+                           std::placeholders::_1, integrator, dependentVariableTerminationCondition );
+    }
+    else
+    {
+        dependentVariableErrorFunction =
+                std::bind( &getTerminationDependentVariableErrorForGivenTimeStep< StateType, TimeType, TimeStepType >,
+                           std::placeholders::_1, integrator, dependentVariableTerminationCondition );
+    }
 
     // Create root finder.
     bool increasingTime = static_cast< double >( lastTime - secondToLastTime ) > 0.0;
@@ -129,8 +171,16 @@ void getFinalStateForExactDependentVariableTerminationCondition(
                     std::make_shared< basic_mathematics::FunctionProxy< TimeStepType, TimeStepType > >(
                         dependentVariableErrorFunction ), ( lastTime - secondToLastTime ) / 2.0 );
 
-        endState = integrator->performIntegrationStep( finalTimeStep );
-        endTime = integrator->getCurrentIndependentVariable( );
+        if( useDenseOutput )
+        {
+            endTime = secondToLastTime + finalTimeStep;
+            endState = integrator->getDenseOutputState( endTime );
+        }
+        else
+        {
+            endState = integrator->performIntegrationStep( finalTimeStep );
+            endTime = integrator->getCurrentIndependentVariable( );
+        }
     }
     // If dependent variable has no root in given interval, set end time and state at NaN
     catch( std::runtime_error& caughtException )
@@ -251,6 +301,9 @@ void getFinalStateForExactHybridVariableTerminationCondition(
 //! Function that propagates to an exact final condition (within tolerance) for arbitrary termination condition
 /*!
  * Function that propagates to an exact final condition (within tolerance) for arbitrary termination condition.
+ * If the integrator provides dense output, the final state is interpolated within the last step (and the integrator is left
+ * at the lastTime/lastState), so that the final time can be located without taking integration steps. Otherwise, the
+ * integrator is rolled back, and a step to the final condition is taken.
  * \param integrator Numerical integrator that is used for propagation. Upon input to this function, the integrator is at
  * the lastTime/lastState
  * \param terminationCondition Termination condition that is to be used
@@ -281,12 +334,20 @@ void getFinalStateForExactTerminationCondition(
         std::shared_ptr< FixedTimePropagationTerminationCondition > timeTerminationCondition =
                 std::dynamic_pointer_cast< FixedTimePropagationTerminationCondition >( terminationCondition );
 
-        // Determine final time step and propagate
+        // Determine final time step and propagate (or interpolate within last step, if integrator provides dense output)
         TimeStepType finalTimeStep = timeTerminationCondition->getStopTime( ) - secondToLastTime;
 
-        integrator->rollbackToPreviousState( );
-        endState = integrator->performIntegrationStep( finalTimeStep );
-        endTime = integrator->getCurrentIndependentVariable( );
+        if( integrator->isDenseOutputAvailable( ) )
+        {
+            endTime = secondToLastTime + finalTimeStep;
+            endState = integrator->getDenseOutputState( endTime );
+        }
+        else
+        {
+            integrator->rollbackToPreviousState( );
+            endState = integrator->performIntegrationStep( finalTimeStep );
+            endTime = integrator->getCurrentIndependentVariable( );
+        }
 
         break;
     }
@@ -301,7 +362,10 @@ void getFinalStateForExactTerminationCondition(
     }
     case dependent_variable_stopping_condition:
     {
-        integrator->rollbackToPreviousState( );
+        if( !integrator->isDenseOutputAvailable( ) )
+        {
+            integrator->rollbackToPreviousState( );
+        }
 
         std::shared_ptr< SingleVariableLimitPropagationTerminationCondition > dependentVariableTerminationCondition =
                 std::dynamic_pointer_cast< SingleVariableLimitPropagationTerminationCondition >( terminationCondition );
@@ -335,74 +399,108 @@ void getFinalStateForExactTerminationCondition(
     }
 }
 
+//! Function to remove the entries of a propagation history that were saved beyond the exact final condition
+/*!
+ *  Function to remove the entries of a propagation history that were saved beyond the exact final condition, i.e. the entry
+ *  at the end of the last integration step, and any entries that were saved within the last integration step beyond the
+ *  final time (when saving results from the dense output of the integrator). Entries are removed starting from the latest
+ *  propagated epoch.
+ *  \param history History of state or dependent variables from which entries are to be removed (modified by reference)
+ *  \param lastTime Time at the end of the last integration step (e.g. time at which integration first exceeded termination
+ *  condition)
+ *  \param endTime Time at which exact termination condition is met (NaN if it could not be determined).
+ *  \param isPropagationForward Boolean denoting whether the propagation is forward in time
+ */
+template< typename HistoryType, typename TimeType >
+void removeHistoryEntriesBeyondFinalCondition(
+        HistoryType& history, const TimeType lastTime, const TimeType endTime, const bool isPropagationForward )
+{
+    while( history.size( ) > 0 )
+    {
+        auto latestEntryIterator = isPropagationForward ? std::prev( history.end( ) ) : history.begin( );
+        const TimeType latestEntryTime = latestEntryIterator->first;
+        if( latestEntryTime == lastTime ||
+                ( isPropagationForward ? ( latestEntryTime > endTime ) : ( latestEntryTime < endTime ) ) )
+        {
+            history.erase( latestEntryIterator );
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
 //! Function that propagates to an exact final condition (within tolerance) for arbitrary termination condition
 /*!
  * Function that propagates to an exact final condition (within tolerance) for arbitrary termination condition.
+ * If the integrator provides dense output, this is only used to locate the final time, after which the integrator is
+ * rolled back and an integration step to this final time is taken.
  * \param integrator Numerical integrator that is used for propagation. Upon input to this function, the integrator is at
  * the final time/state encountered by the propagation
  * \param propagationTerminationCondition Termination condition that is to be used
  * \param timeStep Last time step taken by integrator.
  * \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
  * derivative model).
- * \param solutionHistory History of state variables that are to be saved given as map
+ * \param solutionHistory History of state variables that are to be saved given as map or StateHistory
  * (time as key; returned by reference)
- * \param dependentVariableHistory History of dependent variables that are to be saved given as map
+ * \param dependentVariableHistory History of dependent variables that are to be saved given as map or StateHistory
  * (time as key; returned by reference)
  * \param currentCpuTime Current run time of propagation.
+ * \param endTime Time at which exact termination condition is met (returned by reference).
+ * \param endState State at time where exact termination condition is met (returned by reference).
  */
-template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd > >
 void propagateToExactTerminationCondition(
         const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
         const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
         const TimeStepType timeStep,
         const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
-        std::map< TimeType, StateType >& solutionHistory,
-        std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
-        const double currentCpuTime )
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
+        const double currentCpuTime,
+        TimeType& endTime,
+        StateType& endState )
 {
     // Turn off step size control
     integrator->setStepSizeControl( false );
 
     // Determine exact final time/state
-    TimeType endTime;
-    StateType endState;
+    const TimeType secondToLastTime = integrator->getPreviousIndependentVariable( );
+    const TimeType lastTime = integrator->getCurrentIndependentVariable( );
     getFinalStateForExactTerminationCondition(
                 integrator, propagationTerminationCondition,
-                integrator->getPreviousIndependentVariable( ),
-                integrator->getCurrentIndependentVariable( ),
+                secondToLastTime,
+                lastTime,
                 integrator->getPreviousState( ),
                 integrator->getCurrentState( ),
                 endTime, endState );
 
-    // Check if any dependent variables are saved. If so, remove last entry
+    // If the final time was located using the dense output, take an integration step to it, so that the final state is
+    // not affected by the (lower order) interpolation error
+    if( integrator->isDenseOutputAvailable( ) && ( endTime == endTime ) && ( endTime != lastTime ) )
+    {
+        integrator->rollbackToPreviousState( );
+        endState = integrator->performIntegrationStep( endTime - secondToLastTime );
+        endTime = integrator->getCurrentIndependentVariable( );
+    }
+
+    // Check if any dependent variables are saved. If so, remove entries beyond final condition
     bool recomputeDependentVariables = false;
     if( dependentVariableHistory.size( ) > 0 )
     {
         if( dependentVariableHistory.rbegin( )->first == solutionHistory.rbegin( )->first )
         {
-            if( timeStep > 0 )
-            {
-                dependentVariableHistory.erase( std::prev( dependentVariableHistory.end() ) );
-            }
-            else
-            {
-                dependentVariableHistory.erase(  dependentVariableHistory.begin( ) );
-            }
+            removeHistoryEntriesBeyondFinalCondition( dependentVariableHistory, lastTime, endTime, timeStep > 0 );
             recomputeDependentVariables = true;
         }
     }
 
-    // Remove state entry last added, and enter converged final state
-    if( timeStep > 0 )
-    {
-        solutionHistory.erase( std::prev( solutionHistory.end() ) );
-        solutionHistory[ endTime ] = endState;
-    }
-    else
-    {
-        solutionHistory.erase( solutionHistory.begin( ) );
-        solutionHistory[ endTime ] = endState;
-    }
+    // Remove state entries beyond final condition, and enter converged final state
+    removeHistoryEntriesBeyondFinalCondition( solutionHistory, lastTime, endTime, timeStep > 0 );
+    solutionHistory[ endTime ] = endState;
 
     // Recompute final dependent variables, if required
     if( recomputeDependentVariables )
@@ -418,6 +516,70 @@ void propagateToExactTerminationCondition(
     integrator->setStepSizeControl( true );
 }
 
+//! Function to pass the saved propagation results to an output streaming function, and remove them from the histories
+/*!
+ *  Function to pass the saved propagation results to an output streaming function, and remove them from the histories, so
+ *  that the memory used by the histories does not grow during the propagation. During the propagation, the latest saved
+ *  epoch is retained (and not yet streamed), since it may still be modified when terminating exactly on the final
+ *  condition (see propagateToExactTerminationCondition). Once the propagation is finished, the latest saved epoch is
+ *  streamed, but retained in the histories. Entries are streamed in the order in which they were propagated.
+ *  \param outputStreamingFunction Function to which time, state and dependent variables (empty if none) are passed
+ *  \param solutionHistory History of state variables from which entries are to be streamed (modified by reference)
+ *  \param dependentVariableHistory History of dependent variables from which entries are to be streamed (modified by
+ *  reference)
+ *  \param cumulativeComputationTimeHistory History of cumulative computation times, of which only the latest entry is
+ *  retained (modified by reference)
+ *  \param isPropagationForward Boolean denoting whether the propagation is forward in time
+ *  \param isPropagationFinished Boolean denoting whether the propagation is finished.
+ */
+template< typename StateType, typename TimeType, typename StateHistoryType, typename DependentVariableHistoryType,
+          typename ComputationTimeHistoryType >
+void streamSavedPropagationResults(
+        const std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) >& outputStreamingFunction,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
+        ComputationTimeHistoryType& cumulativeComputationTimeHistory,
+        const bool isPropagationForward,
+        const bool isPropagationFinished )
+{
+    static const Eigen::VectorXd noDependentVariables = Eigen::VectorXd::Zero( 0 );
+
+    // Stream and remove all but the latest entry
+    while( solutionHistory.size( ) > 1 )
+    {
+        auto stateIterator = isPropagationForward ? solutionHistory.begin( ) : std::prev( solutionHistory.end( ) );
+        auto dependentVariableIterator = dependentVariableHistory.find( stateIterator->first );
+        if( dependentVariableIterator != dependentVariableHistory.end( ) )
+        {
+            outputStreamingFunction( stateIterator->first, stateIterator->second, dependentVariableIterator->second );
+            dependentVariableHistory.erase( dependentVariableIterator );
+        }
+        else
+        {
+            outputStreamingFunction( stateIterator->first, stateIterator->second, noDependentVariables );
+        }
+        solutionHistory.erase( stateIterator );
+    }
+
+    // Stream latest entry upon termination
+    if( isPropagationFinished && solutionHistory.size( ) == 1 )
+    {
+        auto dependentVariableIterator = dependentVariableHistory.find( solutionHistory.begin( )->first );
+        outputStreamingFunction(
+                    solutionHistory.begin( )->first, solutionHistory.begin( )->second,
+                    ( dependentVariableIterator != dependentVariableHistory.end( ) ) ?
+                        Eigen::VectorXd( dependentVariableIterator->second ) : noDependentVariables );
+    }
+
+    // Remove all but latest computation time
+    while( cumulativeComputationTimeHistory.size( ) > 1 )
+    {
+        cumulativeComputationTimeHistory.erase(
+                    isPropagationForward ? cumulativeComputationTimeHistory.begin( ) :
+                                           std::prev( cumulativeComputationTimeHistory.end( ) ) );
+    }
+}
+
 //! Function to numerically integrate a given first order differential equation
 /*!
  *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
@@ -425,12 +587,12 @@ void propagateToExactTerminationCondition(
  *  \param integrator Numerical integrator used for propagation
  *  \param initialTimeStep Time step to use for first step of numerical integration
  *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
- *  \param solutionHistory History of state variables that are to be saved given as map
+ *  \param solutionHistory History of state variables that are to be saved given as map or StateHistory
  *  (time as key; returned by reference)
- *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
+ *  \param dependentVariableHistory History of dependent variables that are to be saved given as map or StateHistory
  *  (time as key; returned by reference)
  *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
- *  as map (time as key; returned by reference)
+ *  as map or StateHistory (time as key; returned by reference)
  *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
  *  derivative model).
  *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
@@ -439,52 +601,147 @@ void propagateToExactTerminationCondition(
  *  \param printInterval Frequency with which to print progress to console (nan = never).
  *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
  *  By default now(), i.e. the moment at which this function is called.
+ *  \param outputStreamingFunction Function to which the saved states and dependent variables are passed during the
+ *  propagation, after which they are removed from the histories (see streamSavedPropagationResults). By default none, in
+ *  which case the full histories are retained.
+ *  \param denseOutputSaveInterval Fixed interval at which to save the numerical integrated states, interpolated within the
+ *  integration steps using the dense output of the integrator (NaN if not used, in which case saveFrequency is used).
+ *  \param checkpointHandler Object with which checkpoints are written during the propagation, and with which the
+ *  propagation is resumed from a checkpoint, if required (see PropagationCheckpointHandler). When resuming, the
+ *  integrator state, current time and step size, saved results and computation time are read from the checkpoint instead
+ *  of being initialized from the integrator. By default none.
+ *  \param eventDetector Object with which events (zero crossings of event functions) are detected after each step. If a
+ *  terminal event is detected, the propagation is stopped at (and the last saved state is that of) the terminal event.
+ *  By default none.
+ *  \param finalStateFunction Function to which the time, state and dependent variables (empty if none) at the end of the
+ *  propagation are passed once it is finished, i.e. at the end of the last step, or at the exact final condition or
+ *  terminal event. These are passed regardless of whether the final state is saved (or retained) in the histories.
+ *  By default none.
  *  \return Event that triggered the termination of the propagation
  */
-template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType,
+          typename StateHistoryType = std::map< TimeType, StateType >,
+          typename DependentVariableHistoryType = std::map< TimeType, Eigen::VectorXd >,
+          typename ComputationTimeHistoryType = std::map< TimeType, double > >
 std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator(
         const std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
         const TimeStepType initialTimeStep,
         const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-        std::map< TimeType, StateType >& solutionHistory,
-        std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
-        std::map< TimeType, double >& cumulativeComputationTimeHistory,
+        StateHistoryType& solutionHistory,
+        DependentVariableHistoryType& dependentVariableHistory,
+        ComputationTimeHistoryType& cumulativeComputationTimeHistory,
         const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
         const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
         const int saveFrequency = TUDAT_NAN,
         const TimeType printInterval = TUDAT_NAN,
-        const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+        const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+        const std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) > outputStreamingFunction =
+        std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) >( ),
+        const double denseOutputSaveInterval = TUDAT_NAN,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler =
+        std::shared_ptr< PropagationCheckpointHandler >( ),
+        const std::shared_ptr< PropagationEventDetector< StateType, TimeType > > eventDetector =
+        std::shared_ptr< PropagationEventDetector< StateType, TimeType > >( ),
+        const std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) > finalStateFunction =
+        std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) >( ) )
 {
     std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason;
+    const bool isPropagationForward = ( initialTimeStep > 0 );
+
+    // Check whether results are to be saved at fixed intervals, using dense output of integrator
+    const bool saveDenseOutput = ( denseOutputSaveInterval == denseOutputSaveInterval );
+    if( saveDenseOutput && !integrator->isDenseOutputAvailable( ) )
+    {
+        throw std::runtime_error( "Error, requested saving of propagation results at fixed intervals using dense output, "
+                                  "but the numerical integrator does not provide dense output." );
+    }
+    else if( saveDenseOutput && !( denseOutputSaveInterval > 0.0 ) )
+    {
+        throw std::runtime_error( "Error, interval at which to save propagation results using dense output must be positive." );
+    }
+    const TimeStepType denseOutputTimeStep = static_cast< TimeStepType >(
+                isPropagationForward ? denseOutputSaveInterval : -denseOutputSaveInterval );
+    unsigned long long denseOutputSaveIndex = 1;
 
     // Get Initial state and time.
     TimeType currentTime = integrator->getCurrentIndependentVariable( );
     TimeType initialTime = currentTime;
     StateType newState = integrator->getCurrentState( );
 
-    // Initialization of numerical solutions for variational equations
-    solutionHistory.clear( );
-    solutionHistory[ currentTime ] = newState;
-
-    dependentVariableHistory.clear( );
-    if( !( dependentVariableFunction == nullptr ) )
-    {
-        integrator->getStateDerivativeFunction( )( currentTime, newState );
-        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
-    }
-
-    // CPU time
-    cumulativeComputationTimeHistory.clear( );
-    double currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
-                std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
-    cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
-
     // Set initial time step and total integration time.
     TimeStepType timeStep = initialTimeStep;
     TimeType previousTime = currentTime;
     TimeType previousPrintTime = TUDAT_NAN;
 
     int saveIndex = 0;
+    double currentCPUTime = 0.0;
+    std::chrono::steady_clock::time_point clockTimeAtStart = initialClockTime;
+
+    // Check whether, and at which time, a checkpoint was written (after which only the results saved since are written)
+    bool isCheckpointWritten = false;
+    TimeType previousCheckpointTime = currentTime;
+
+    if( checkpointHandler != nullptr && checkpointHandler->isPropagationToBeResumed( ) )
+    {
+        // Retrieve integrator state, propagation loop variables and saved results from checkpoint (of which the saved
+        // results are reconstructed from the results added in each of its records)
+        solutionHistory.clear( );
+        dependentVariableHistory.clear( );
+        cumulativeComputationTimeHistory.clear( );
+        checkpointHandler->readCheckpoint( [ & ]( std::istream& checkpointStream )
+        {
+            serialization::readAndCheckBinaryIdentifier( checkpointStream, "IntegrationLoop" );
+            serialization::readBinaryValue( checkpointStream, initialTime );
+            serialization::readBinaryValue( checkpointStream, timeStep );
+            serialization::readBinaryValue( checkpointStream, previousPrintTime );
+            serialization::readBinaryValue( checkpointStream, saveIndex );
+            serialization::readBinaryValue( checkpointStream, denseOutputSaveIndex );
+            serialization::readBinaryValue( checkpointStream, currentCPUTime );
+            integrator->readIntegratorState( checkpointStream );
+            readHistoryIncrementFromBinaryStream< TimeType, StateType >(
+                        checkpointStream, solutionHistory, isPropagationForward );
+            readHistoryIncrementFromBinaryStream< TimeType, Eigen::VectorXd >(
+                        checkpointStream, dependentVariableHistory, isPropagationForward );
+            readHistoryIncrementFromBinaryStream< TimeType, double >(
+                        checkpointStream, cumulativeComputationTimeHistory, isPropagationForward );
+            if( eventDetector != nullptr )
+            {
+                eventDetector->initialize( integrator->getCurrentIndependentVariable( ), integrator->getCurrentState( ) );
+                eventDetector->readDetectedEvents( checkpointStream );
+            }
+        } );
+        currentTime = integrator->getCurrentIndependentVariable( );
+        previousTime = currentTime;
+        newState = integrator->getCurrentState( );
+
+        // Continue cumulative computation time from its value at the checkpoint
+        clockTimeAtStart = std::chrono::steady_clock::now( ) - std::chrono::duration_cast< std::chrono::steady_clock::duration >(
+                    std::chrono::duration< double >( currentCPUTime ) );
+    }
+    else
+    {
+        // Initialization of numerical solutions for variational equations
+        solutionHistory.clear( );
+        solutionHistory[ currentTime ] = newState;
+
+        dependentVariableHistory.clear( );
+        if( !( dependentVariableFunction == nullptr ) )
+        {
+            integrator->getStateDerivativeFunction( )( currentTime, newState );
+            dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+        }
+
+        // CPU time
+        cumulativeComputationTimeHistory.clear( );
+        currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    std::chrono::steady_clock::now( ) - clockTimeAtStart ).count( ) * 1.0e-9;
+        cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
+
+        if( eventDetector != nullptr )
+        {
+            eventDetector->initialize( currentTime, newState );
+        }
+    }
 
     propagationTerminationReason = std::make_shared< PropagationTerminationDetails >(
                 unknown_propagation_termination_reason );
@@ -495,6 +752,7 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
     {
         try
         {
+            bool isTerminalEventDetected = false;
             if( ( newState.allFinite( ) == true ) && ( !newState.hasNaN( ) ) )
             {
                 previousTime = currentTime;
@@ -523,17 +781,75 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
                 currentTime = integrator->getCurrentIndependentVariable( );
                 timeStep = integrator->getNextStepSize( );
 
+                // Detect events in last step, and move to the terminal event, if one occurred
+                if( eventDetector != nullptr )
+                {
+                    isTerminalEventDetected = eventDetector->detectEventsInLastStep(
+                                integrator, previousTime, currentTime, newState, statePostProcessingFunction );
+                    if( isTerminalEventDetected )
+                    {
+                        currentTime = eventDetector->getTerminalEvent( ).eventTime_;
+                        newState = eventDetector->getTerminalEvent( ).eventState_;
+                    }
+                }
+
                 // Save integration result in map
-                saveIndex++;
-                saveIndex = saveIndex % saveFrequency;
-                if( saveIndex == 0 )
+                if( saveDenseOutput )
                 {
-                    solutionHistory[ currentTime ] = newState;
+                    // Save results at all fixed output epochs within last step, interpolated by integrator. Evaluating
+                    // the dependent variables at these epochs updates the environment to the interpolated states.
+                    bool isEnvironmentUpdatedToSavedState = false;
+                    TimeType nextSaveTime = initialTime +
+                            static_cast< TimeStepType >( denseOutputSaveIndex ) * denseOutputTimeStep;
+                    while( isPropagationForward ? ( nextSaveTime <= currentTime ) : ( nextSaveTime >= currentTime ) )
+                    {
+                        StateType interpolatedState = integrator->getDenseOutputState( nextSaveTime );
+                        if( statePostProcessingFunction != nullptr )
+                        {
+                            statePostProcessingFunction( interpolatedState );
+                        }
+                        solutionHistory[ nextSaveTime ] = interpolatedState;
+
+                        if( !( dependentVariableFunction == nullptr ) )
+                        {
+                            integrator->getStateDerivativeFunction( )( nextSaveTime, interpolatedState );
+                            dependentVariableHistory[ nextSaveTime ] = dependentVariableFunction( );
+                            isEnvironmentUpdatedToSavedState = true;
+                        }
+
+                        denseOutputSaveIndex++;
+                        nextSaveTime = initialTime + static_cast< TimeStepType >( denseOutputSaveIndex ) * denseOutputTimeStep;
+                    }
 
-                    if( !( dependentVariableFunction == nullptr ) )
+                    // Save state at terminal event
+                    if( isTerminalEventDetected )
+                    {
+                        solutionHistory[ currentTime ] = newState;
+                        if( !( dependentVariableFunction == nullptr ) )
+                        {
+                            integrator->getStateDerivativeFunction( )( currentTime, newState );
+                            dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+                        }
+                    }
+                    // Reset environment to end of step, so that the termination condition is checked at the new state
+                    else if( isEnvironmentUpdatedToSavedState )
                     {
                         integrator->getStateDerivativeFunction( )( currentTime, newState );
-                        dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+                    }
+                }
+                else
+                {
+                    saveIndex++;
+                    saveIndex = saveIndex % saveFrequency;
+                    if( saveIndex == 0 || isTerminalEventDetected )
+                    {
+                        solutionHistory[ currentTime ] = newState;
+
+                        if( !( dependentVariableFunction == nullptr ) )
+                        {
+                            integrator->getStateDerivativeFunction( )( currentTime, newState );
+                            dependentVariableHistory[ currentTime ] = dependentVariableFunction( );
+                        }
                     }
                 }
             }
@@ -547,9 +863,16 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
             }
 
             currentCPUTime = std::chrono::duration_cast< std::chrono::nanoseconds >(
-                        std::chrono::steady_clock::now( ) - initialClockTime ).count( ) * 1.0e-9;
+                        std::chrono::steady_clock::now( ) - clockTimeAtStart ).count( ) * 1.0e-9;
             cumulativeComputationTimeHistory[ currentTime ] = currentCPUTime;
 
+            // Pass saved results to output function, if required
+            if( outputStreamingFunction != nullptr )
+            {
+                streamSavedPropagationResults( outputStreamingFunction, solutionHistory, dependentVariableHistory,
+                                               cumulativeComputationTimeHistory, isPropagationForward, false );
+            }
+
             // Print solutions
             if( printInterval == printInterval )
             {
@@ -563,14 +886,25 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
                 }
             }
 
-            if( propagationTerminationCondition->checkStopCondition( static_cast< double >( currentTime ), currentCPUTime ) )
+            if( isTerminalEventDetected )
+            {
+                propagationTerminationReason = std::make_shared< PropagationTerminationDetails >(
+                            terminal_event_detected );
+                breakPropagation = true;
+            }
+            else if( propagationTerminationCondition->checkStopCondition(
+                         static_cast< double >( currentTime ), currentCPUTime ) )
             {
                 if( propagationTerminationCondition->getTerminateExactlyOnFinalCondition( ) )
                 {
+                    TimeType endTime;
+                    StateType endState;
                     propagateToExactTerminationCondition(
                                 integrator, propagationTerminationCondition,
                                 timeStep, dependentVariableFunction,
-                                solutionHistory, dependentVariableHistory, currentCPUTime );
+                                solutionHistory, dependentVariableHistory, currentCPUTime, endTime, endState );
+                    currentTime = endTime;
+                    newState = endState;
                 }
 
                 // Set termination details
@@ -594,6 +928,37 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
                 }
                 breakPropagation = true;
             }
+
+            // Write checkpoint from which the propagation can be resumed, if required
+            if( !breakPropagation && checkpointHandler != nullptr && checkpointHandler->isCheckpointToBeWritten( ) )
+            {
+                checkpointHandler->writeCheckpoint( [ & ]( std::ostream& checkpointStream )
+                {
+                    serialization::writeBinaryIdentifier( checkpointStream, "IntegrationLoop" );
+                    serialization::writeBinaryValue( checkpointStream, initialTime );
+                    serialization::writeBinaryValue( checkpointStream, timeStep );
+                    serialization::writeBinaryValue( checkpointStream, previousPrintTime );
+                    serialization::writeBinaryValue( checkpointStream, saveIndex );
+                    serialization::writeBinaryValue( checkpointStream, denseOutputSaveIndex );
+                    serialization::writeBinaryValue( checkpointStream, currentCPUTime );
+                    integrator->writeIntegratorState( checkpointStream );
+                    writeHistoryIncrementToBinaryStream< StateType >(
+                                checkpointStream, solutionHistory, isPropagationForward, isCheckpointWritten,
+                                previousCheckpointTime );
+                    writeHistoryIncrementToBinaryStream< Eigen::VectorXd >(
+                                checkpointStream, dependentVariableHistory, isPropagationForward, isCheckpointWritten,
+                                previousCheckpointTime );
+                    writeHistoryIncrementToBinaryStream< double >(
+                                checkpointStream, cumulativeComputationTimeHistory, isPropagationForward,
+                                isCheckpointWritten, previousCheckpointTime );
+                    if( eventDetector != nullptr )
+                    {
+                        eventDetector->writeDetectedEvents( checkpointStream );
+                    }
+                }, isCheckpointWritten );
+                isCheckpointWritten = true;
+                previousCheckpointTime = currentTime;
+            }
         }
         catch( const std::exception& caughtException )
         {
@@ -607,6 +972,33 @@ std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrato
     }
     while( !breakPropagation );
 
+    if( outputStreamingFunction != nullptr )
+    {
+        streamSavedPropagationResults( outputStreamingFunction, solutionHistory, dependentVariableHistory,
+                                       cumulativeComputationTimeHistory, isPropagationForward, true );
+    }
+
+    // Pass final time, state and dependent variables (recomputed only if not saved at final time) to output function
+    if( finalStateFunction != nullptr )
+    {
+        Eigen::VectorXd finalDependentVariables = Eigen::VectorXd::Zero( 0 );
+        if( !( dependentVariableFunction == nullptr ) && newState.allFinite( ) &&
+                propagationTerminationReason->getPropagationTerminationReason( ) != runtime_error_caught_in_propagation )
+        {
+            auto dependentVariableIterator = dependentVariableHistory.find( currentTime );
+            if( dependentVariableIterator != dependentVariableHistory.end( ) )
+            {
+                finalDependentVariables = dependentVariableIterator->second;
+            }
+            else
+            {
+                integrator->getStateDerivativeFunction( )( currentTime, newState );
+                finalDependentVariables = dependentVariableFunction( );
+            }
+        }
+        finalStateFunction( currentTime, newState, finalDependentVariables );
+    }
+
     return propagationTerminationReason;
 }
 
@@ -622,7 +1014,12 @@ Eigen::MatrixXd, double, double >(
         const std::function< void( Eigen::MatrixXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::MatrixXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::MatrixXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::MatrixXd&, const Eigen::VectorXd& ) > finalStateFunction );
 
 
 extern template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
@@ -637,7 +1034,31 @@ Eigen::VectorXd, double, double >(
         const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
         const int saveFrequency,
         const double printInterval,
-        const std::chrono::steady_clock::time_point initialClockTime );
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > finalStateFunction );
+
+extern template std::shared_ptr< PropagationTerminationDetails > integrateEquationsFromIntegrator<
+Eigen::VectorXd, double, double >(
+        const std::shared_ptr< numerical_integrators::NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd, double > > integrator,
+        const double initialTimeStep,
+        const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
+        StateHistory< double, Eigen::VectorXd >& solutionHistory,
+        StateHistory< double, Eigen::VectorXd >& dependentVariableHistory,
+        StateHistory< double, double >& cumulativeComputationTimeHistory,
+        const std::function< Eigen::VectorXd( ) > dependentVariableFunction,
+        const std::function< void( Eigen::VectorXd& ) > statePostProcessingFunction,
+        const int saveFrequency,
+        const double printInterval,
+        const std::chrono::steady_clock::time_point initialClockTime,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > outputStreamingFunction,
+        const double denseOutputSaveInterval,
+        const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler,
+        const std::shared_ptr< PropagationEventDetector< Eigen::VectorXd, double > > eventDetector,
+        const std::function< void( const double, const Eigen::VectorXd&, const Eigen::VectorXd& ) > finalStateFunction );
 
 
 //! Interface class for integrating some state derivative function.
@@ -657,34 +1078,55 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map or StateHistory (time as key; returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map or StateHistory
      *  (time as key; returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map or StateHistory (time as key; returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param outputStreamingFunction Function to which the saved states and dependent variables are passed during the
+     *  propagation, after which they are removed from the histories. By default none.
+     *  \param inPlaceStateDerivativeFunction Function computing the same state derivative as stateDerivativeFunction,
+     *  but returning it by reference, used by the integrator to avoid allocations if set. By default none.
+     *  \param checkpointHandler Object with which checkpoints are written during the propagation, and with which the
+     *  propagation is resumed from a checkpoint, if required. By default none.
+     *  \param eventDetector Object with which events are detected after each step (and at which terminal events stop the
+     *  propagation). By default none.
+     *  \param finalStateFunction Function to which the time, state and dependent variables at the end of the propagation
+     *  are passed once it is finished (see integrateEquationsFromIntegrator). By default none.
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType, typename DependentVariableHistoryType, typename ComputationTimeHistoryType >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const TimeType, const StateType& ) > stateDerivativeFunction,
-            std::map< TimeType, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< TimeType, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const TimeType printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) );
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) > outputStreamingFunction =
+            std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) >( ),
+            const std::function< void( const TimeType, const StateType&, StateType& ) > inPlaceStateDerivativeFunction =
+            std::function< void( const TimeType, const StateType&, StateType& ) >( ),
+            const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler =
+            std::shared_ptr< PropagationCheckpointHandler >( ),
+            const std::shared_ptr< PropagationEventDetector< StateType, TimeType > > eventDetector =
+            std::shared_ptr< PropagationEventDetector< StateType, TimeType > >( ),
+            const std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) > finalStateFunction =
+            std::function< void( const TimeType, const StateType&, const Eigen::VectorXd& ) >( ) );
 
 };
 
@@ -699,34 +1141,55 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map or StateHistory (time as key; returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map or StateHistory
      *  (time as key; returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map or StateHistory (time as key; returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param outputStreamingFunction Function to which the saved states and dependent variables are passed during the
+     *  propagation, after which they are removed from the histories. By default none.
+     *  \param inPlaceStateDerivativeFunction Function computing the same state derivative as stateDerivativeFunction,
+     *  but returning it by reference, used by the integrator to avoid allocations if set. By default none.
+     *  \param checkpointHandler Object with which checkpoints are written during the propagation, and with which the
+     *  propagation is resumed from a checkpoint, if required. By default none.
+     *  \param eventDetector Object with which events are detected after each step (and at which terminal events stop the
+     *  propagation). By default none.
+     *  \param finalStateFunction Function to which the time, state and dependent variables at the end of the propagation
+     *  are passed once it is finished (see integrateEquationsFromIntegrator). By default none.
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType, typename DependentVariableHistoryType, typename ComputationTimeHistoryType >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const double, const StateType& ) > stateDerivativeFunction,
-            std::map< double, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< double, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< double, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const double printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::function< void( const double, const StateType&, const Eigen::VectorXd& ) > outputStreamingFunction =
+            std::function< void( const double, const StateType&, const Eigen::VectorXd& ) >( ),
+            const std::function< void( const double, const StateType&, StateType& ) > inPlaceStateDerivativeFunction =
+            std::function< void( const double, const StateType&, StateType& ) >( ),
+            const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler =
+            std::shared_ptr< PropagationCheckpointHandler >( ),
+            const std::shared_ptr< PropagationEventDetector< StateType, double > > eventDetector =
+            std::shared_ptr< PropagationEventDetector< StateType, double > >( ),
+            const std::function< void( const double, const StateType&, const Eigen::VectorXd& ) > finalStateFunction =
+            std::function< void( const double, const StateType&, const Eigen::VectorXd& ) >( ) )
     {
         std::function< bool( const double, const double ) > stopPropagationFunction =
                 std::bind( &PropagationTerminationCondition::checkStopCondition, propagationTerminationCondition, std::placeholders::_1, std::placeholders::_2 );
@@ -741,6 +1204,11 @@ public:
             integrator->setPropagationTerminationFunction( stopPropagationFunction );
         }
 
+        if( inPlaceStateDerivativeFunction != nullptr )
+        {
+            integrator->setInPlaceStateDerivativeFunction( inPlaceStateDerivativeFunction );
+        }
+
         return integrateEquationsFromIntegrator< StateType, double >(
                     integrator, integratorSettings->initialTimeStep_, propagationTerminationCondition, solutionHistory,
                     dependentVariableHistory,
@@ -749,7 +1217,12 @@ public:
                     statePostProcessingFunction,
                     integratorSettings->saveFrequency_,
                     printInterval,
-                    initialClockTime );
+                    initialClockTime,
+                    outputStreamingFunction,
+                    integratorSettings->denseOutputSaveInterval_,
+                    checkpointHandler,
+                    eventDetector,
+                    finalStateFunction );
     }
 
 };
@@ -765,34 +1238,55 @@ public:
      *  Function to numerically integrate a given first order differential equation, with the state derivative a function of
      *  a single independent variable and the current state
      *  \param stateDerivativeFunction Function returning the state derivative from current time and state.
-     *  \param solutionHistory History of numerical states given as map (time as key; returned by reference)
+     *  \param solutionHistory History of numerical states given as map or StateHistory (time as key; returned by reference)
      *  \param initialState Initial state
      *  \param integratorSettings Settings for numerical integrator.
      *  \param propagationTerminationCondition Object to determine when/how the propagation is to be stopped at the current time.
-     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map
+     *  \param dependentVariableHistory History of dependent variables that are to be saved given as map or StateHistory
      *  (time as key; returned by reference)
      *  \param cumulativeComputationTimeHistory History of cumulative computation times that are to be saved given
-     *  as map (time as key; returned by reference)
+     *  as map or StateHistory (time as key; returned by reference)
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param statePostProcessingFunction Function to post-process state after numerical integration (obtained from state derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
      *  \param initialClockTime Initial clock time from which to determine cumulative computation time.
      *  By default now(), i.e. the moment at which this function is called.
+     *  \param outputStreamingFunction Function to which the saved states and dependent variables are passed during the
+     *  propagation, after which they are removed from the histories. By default none.
+     *  \param inPlaceStateDerivativeFunction Function computing the same state derivative as stateDerivativeFunction,
+     *  but returning it by reference, used by the integrator to avoid allocations if set. By default none.
+     *  \param checkpointHandler Object with which checkpoints are written during the propagation, and with which the
+     *  propagation is resumed from a checkpoint, if required. By default none.
+     *  \param eventDetector Object with which events are detected after each step (and at which terminal events stop the
+     *  propagation). By default none.
+     *  \param finalStateFunction Function to which the time, state and dependent variables at the end of the propagation
+     *  are passed once it is finished (see integrateEquationsFromIntegrator). By default none.
      *  \return Event that triggered the termination of the propagation
      */
+    template< typename StateHistoryType, typename DependentVariableHistoryType, typename ComputationTimeHistoryType >
     static std::shared_ptr< PropagationTerminationDetails > integrateEquations(
             std::function< StateType( const Time, const StateType& ) > stateDerivativeFunction,
-            std::map< Time, StateType >& solutionHistory,
+            StateHistoryType& solutionHistory,
             const StateType initialState,
             const std::shared_ptr< numerical_integrators::IntegratorSettings< Time > > integratorSettings,
             const std::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition,
-            std::map< Time, Eigen::VectorXd >& dependentVariableHistory,
-            std::map< Time, double >& cumulativeComputationTimeHistory,
+            DependentVariableHistoryType& dependentVariableHistory,
+            ComputationTimeHistoryType& cumulativeComputationTimeHistory,
             const std::function< Eigen::VectorXd( ) > dependentVariableFunction = std::function< Eigen::VectorXd( ) >( ),
             const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ),
             const Time printInterval = TUDAT_NAN,
-            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ) )
+            const std::chrono::steady_clock::time_point initialClockTime = std::chrono::steady_clock::now( ),
+            const std::function< void( const Time, const StateType&, const Eigen::VectorXd& ) > outputStreamingFunction =
+            std::function< void( const Time, const StateType&, const Eigen::VectorXd& ) >( ),
+            const std::function< void( const Time, const StateType&, StateType& ) > inPlaceStateDerivativeFunction =
+            std::function< void( const Time, const StateType&, StateType& ) >( ),
+            const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler =
+            std::shared_ptr< PropagationCheckpointHandler >( ),
+            const std::shared_ptr< PropagationEventDetector< StateType, Time > > eventDetector =
+            std::shared_ptr< PropagationEventDetector< StateType, Time > >( ),
+            const std::function< void( const Time, const StateType&, const Eigen::VectorXd& ) > finalStateFunction =
+            std::function< void( const Time, const StateType&, const Eigen::VectorXd& ) >( ) )
     {
         std::function< bool( const double, const double ) > stopPropagationFunction =
                 std::bind( &PropagationTerminationCondition::checkStopCondition, propagationTerminationCondition, std::placeholders::_1, std::placeholders::_2 );
@@ -807,6 +1301,11 @@ public:
             integrator->setPropagationTerminationFunction( stopPropagationFunction );
         }
 
+        if( inPlaceStateDerivativeFunction != nullptr )
+        {
+            integrator->setInPlaceStateDerivativeFunction( inPlaceStateDerivativeFunction );
+        }
+
         return integrateEquationsFromIntegrator< StateType, Time, long double >(
                     integrator, integratorSettings->initialTimeStep_, propagationTerminationCondition, solutionHistory,
                     dependentVariableHistory,
@@ -815,7 +1314,12 @@ public:
                     statePostProcessingFunction,
                     integratorSettings->saveFrequency_,
                     printInterval,
-                    initialClockTime );
+                    initialClockTime,
+                    outputStreamingFunction,
+                    integratorSettings->denseOutputSaveInterval_,
+                    checkpointHandler,
+                    eventDetector,
+                    finalStateFunction );
     }
 
 };
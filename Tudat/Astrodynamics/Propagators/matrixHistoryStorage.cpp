@@ -0,0 +1,385 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "Tudat/Astrodynamics/Propagators/matrixHistoryStorage.h"
+#include "Tudat/Mathematics/Interpolators/chebyshevMatrixInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+#include "Tudat/Basics/utilities.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Constructor, writes the matrix history to file, and maps the file into memory.
+MemoryMappedMatrixHistory::MemoryMappedMatrixHistory(
+        std::map< double, Eigen::MatrixXd >& matrixHistory,
+        const std::string& fileName,
+        const bool storeAsFloatDeltas,
+        const bool clearMatrixHistory ):
+    fileName_( fileName ), storeAsFloatDeltas_( storeAsFloatDeltas ), doubleData_( nullptr ), floatData_( nullptr )
+{
+    if( matrixHistory.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when creating memory-mapped matrix history, no matrices provided." );
+    }
+
+    numberOfRows_ = matrixHistory.begin( )->second.rows( );
+    numberOfColumns_ = matrixHistory.begin( )->second.cols( );
+    const int matrixSize = numberOfRows_ * numberOfColumns_;
+    if( storeAsFloatDeltas_ )
+    {
+        referenceMatrix_ = matrixHistory.begin( )->second;
+    }
+
+    // Write matrices to file, one after the other
+    {
+        std::ofstream fileStream( fileName_.c_str( ), std::ios::binary | std::ios::trunc );
+        if( !fileStream.is_open( ) )
+        {
+            throw std::runtime_error( "Error when creating memory-mapped matrix history, could not open file " +
+                                      fileName_ );
+        }
+
+        epochs_.reserve( matrixHistory.size( ) );
+        Eigen::MatrixXf matrixDifference;
+        std::map< double, Eigen::MatrixXd >::iterator matrixIterator = matrixHistory.begin( );
+        while( matrixIterator != matrixHistory.end( ) )
+        {
+            if( matrixIterator->second.rows( ) != numberOfRows_ || matrixIterator->second.cols( ) != numberOfColumns_ )
+            {
+                fileStream.close( );
+                std::remove( fileName_.c_str( ) );
+                throw std::runtime_error( "Error when creating memory-mapped matrix history, matrix sizes are inconsistent." );
+            }
+
+            epochs_.push_back( matrixIterator->first );
+            if( storeAsFloatDeltas_ )
+            {
+                matrixDifference = ( matrixIterator->second - referenceMatrix_ ).cast< float >( );
+                fileStream.write( reinterpret_cast< const char* >( matrixDifference.data( ) ),
+                                  matrixSize * sizeof( float ) );
+            }
+            else
+            {
+                fileStream.write( reinterpret_cast< const char* >( matrixIterator->second.data( ) ),
+                                  matrixSize * sizeof( double ) );
+            }
+
+            if( clearMatrixHistory )
+            {
+                matrixHistory.erase( matrixIterator++ );
+            }
+            else
+            {
+                matrixIterator++;
+            }
+        }
+
+        if( !fileStream.good( ) )
+        {
+            fileStream.close( );
+            std::remove( fileName_.c_str( ) );
+            throw std::runtime_error( "Error when creating memory-mapped matrix history, could not write file " +
+                                      fileName_ );
+        }
+    }
+
+    // Map file into memory (an empty file cannot be mapped, no data needs to be read for empty matrices)
+    if( matrixSize > 0 )
+    {
+        try
+        {
+            mappedFile_.open( fileName_ );
+        }
+        catch( std::exception& caughtException )
+        {
+            std::remove( fileName_.c_str( ) );
+            throw std::runtime_error( "Error when creating memory-mapped matrix history, could not map file " +
+                                      fileName_ + ": " + caughtException.what( ) );
+        }
+
+        if( storeAsFloatDeltas_ )
+        {
+            floatData_ = reinterpret_cast< const float* >( mappedFile_.data( ) );
+        }
+        else
+        {
+            doubleData_ = reinterpret_cast< const double* >( mappedFile_.data( ) );
+        }
+    }
+}
+
+//! Destructor, unmaps and removes the file containing the matrices.
+MemoryMappedMatrixHistory::~MemoryMappedMatrixHistory( )
+{
+    if( mappedFile_.is_open( ) )
+    {
+        mappedFile_.close( );
+    }
+    std::remove( fileName_.c_str( ) );
+}
+
+//! Function to retrieve the matrix at a given epoch index.
+void MemoryMappedMatrixHistory::getMatrix( const int epochIndex, Eigen::MatrixXd& matrix ) const
+{
+    if( epochIndex < 0 || epochIndex >= getNumberOfEpochs( ) )
+    {
+        throw std::runtime_error( "Error when retrieving matrix from memory-mapped history, index " +
+                                  std::to_string( epochIndex ) + " is out of bounds." );
+    }
+
+    const std::ptrdiff_t matrixOffset =
+            static_cast< std::ptrdiff_t >( epochIndex ) * numberOfRows_ * numberOfColumns_;
+    if( storeAsFloatDeltas_ )
+    {
+        matrix = referenceMatrix_ + Eigen::Map< const Eigen::MatrixXf >(
+                    floatData_ + matrixOffset, numberOfRows_, numberOfColumns_ ).cast< double >( );
+    }
+    else if( numberOfRows_ * numberOfColumns_ > 0 )
+    {
+        matrix = Eigen::Map< const Eigen::MatrixXd >( doubleData_ + matrixOffset, numberOfRows_, numberOfColumns_ );
+    }
+    else
+    {
+        matrix.resize( numberOfRows_, numberOfColumns_ );
+    }
+}
+
+//! Function to retrieve the matrix history as a map (reading all matrices from file).
+std::map< double, Eigen::MatrixXd > MemoryMappedMatrixHistory::getMatrixHistory( ) const
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory;
+    for( int i = 0; i < getNumberOfEpochs( ); i++ )
+    {
+        getMatrix( i, matrixHistory[ epochs_.at( i ) ] );
+    }
+    return matrixHistory;
+}
+
+//! Constructor
+MemoryMappedLagrangeMatrixInterpolator::MemoryMappedLagrangeMatrixInterpolator(
+        const std::shared_ptr< MemoryMappedMatrixHistory > matrixHistory,
+        const int numberOfStages,
+        const interpolators::AvailableLookupScheme selectedLookupScheme,
+        const interpolators::BoundaryInterpolationType boundaryHandling ):
+    interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >( boundaryHandling ),
+    matrixHistory_( matrixHistory ), numberOfStages_( numberOfStages )
+{
+    if( boundaryHandling != interpolators::extrapolate_at_boundary &&
+            boundaryHandling != interpolators::throw_exception_at_boundary )
+    {
+        throw std::runtime_error( "Error when creating memory-mapped Lagrange interpolator, boundary handling type "
+                                  "not supported." );
+    }
+
+    if( numberOfStages_ % 2 != 0 || numberOfStages_ < 2 )
+    {
+        throw std::runtime_error( "Error when creating memory-mapped Lagrange interpolator, number of stages must be "
+                                  "even, and at least 2." );
+    }
+
+    independentValues_ = matrixHistory_->getEpochs( );
+    numberOfIndependentValues_ = matrixHistory_->getNumberOfEpochs( );
+    offsetEntries_ = numberOfStages_ / 2 - 1;
+    if( numberOfIndependentValues_ < std::max( numberOfStages_, 4 ) )
+    {
+        throw std::runtime_error( "Error when creating memory-mapped Lagrange interpolator, insufficient epochs." );
+    }
+
+    this->makeLookupScheme( selectedLookupScheme );
+
+    // Calculate denominators for each interval, as in the LagrangeInterpolator
+    denominators_.resize( numberOfIndependentValues_ );
+    for( int i = offsetEntries_; i < numberOfIndependentValues_ - offsetEntries_ - 1 ; i++ )
+    {
+        int currentIterationStart = i - offsetEntries_;
+        denominators_[ i ].resize( 2 * offsetEntries_ + 2 );
+        for( int j = 0; j < numberOfStages_; j++ )
+        {
+            denominators_[ i ][ j ] = 1.0;
+            for( int k = 0; k < numberOfStages_; k++ )
+            {
+                if( k != j )
+                {
+                    denominators_[ i ][ j ] *= independentValues_[ j + currentIterationStart ] -
+                            independentValues_[ k + currentIterationStart ];
+                }
+            }
+        }
+    }
+    independentVariableDifferenceCache_.resize( numberOfStages_ );
+
+    // Create cubic spline interpolators at the boundaries (only matrices at first and last few epochs are read)
+    if( numberOfStages_ > 2 )
+    {
+        int cubicSplineInputSize = std::max( offsetEntries_, 3 );
+        std::map< double, Eigen::MatrixXd > startMap;
+        for( int i = 0; i <= cubicSplineInputSize; i++ )
+        {
+            matrixHistory_->getMatrix( i, startMap[ independentValues_.at( i ) ] );
+        }
+        std::map< double, Eigen::MatrixXd > endMap;
+        for( int i = numberOfIndependentValues_ - cubicSplineInputSize - 1; i < numberOfIndependentValues_; i++ )
+        {
+            matrixHistory_->getMatrix( i, endMap[ independentValues_.at( i ) ] );
+        }
+
+        beginInterpolator_ = std::make_shared< interpolators::CubicSplineInterpolator< double, Eigen::MatrixXd > >(
+                    startMap );
+        endInterpolator_ = std::make_shared< interpolators::CubicSplineInterpolator< double, Eigen::MatrixXd > >(
+                    endMap );
+    }
+}
+
+//! Function interpolates the matrix at a given independent variable value.
+Eigen::MatrixXd MemoryMappedLagrangeMatrixInterpolator::interpolate( const double targetIndependentVariableValue )
+{
+    Eigen::MatrixXd interpolatedValue = Eigen::MatrixXd::Zero(
+                matrixHistory_->getNumberOfRows( ), matrixHistory_->getNumberOfColumns( ) );
+
+    // Check whether boundary handling needs to be applied
+    bool useValue = false;
+    this->checkBoundaryCase( interpolatedValue, useValue, targetIndependentVariableValue );
+
+    int lowerEntry = lookUpScheme_->findNearestLowerNeighbour( targetIndependentVariableValue );
+
+    // Use cubic spline interpolation at the boundaries of the domain
+    if( lowerEntry < offsetEntries_ )
+    {
+        if( numberOfStages_ > 2 )
+        {
+            interpolatedValue = beginInterpolator_->interpolate( targetIndependentVariableValue );
+        }
+    }
+    else if( lowerEntry >= numberOfIndependentValues_ - offsetEntries_ - 1 )
+    {
+        if( numberOfStages_ > 2 )
+        {
+            interpolatedValue = endInterpolator_->interpolate( targetIndependentVariableValue );
+        }
+    }
+    // Check if requested independent variable is equal to data point
+    else if( independentValues_[ lowerEntry ] == targetIndependentVariableValue )
+    {
+        matrixHistory_->getMatrix( lowerEntry, interpolatedValue );
+    }
+    else if( independentValues_[ lowerEntry + 1 ] == targetIndependentVariableValue )
+    {
+        matrixHistory_->getMatrix( lowerEntry + 1, interpolatedValue );
+    }
+    else if( independentValues_[ lowerEntry - 1 ] == targetIndependentVariableValue )
+    {
+        matrixHistory_->getMatrix( lowerEntry - 1, interpolatedValue );
+    }
+    else
+    {
+        // Compute repeated numerator of the interpolating polynomial
+        double repeatedNumerator = 1.0;
+        for( int i = 0; i < numberOfStages_; i++ )
+        {
+            independentVariableDifferenceCache_[ i ] =
+                    targetIndependentVariableValue - independentValues_[ i + lowerEntry - offsetEntries_ ];
+            repeatedNumerator *= independentVariableDifferenceCache_[ i ];
+        }
+
+        // Evaluate interpolating polynomial, reading only the matrices at its nodes
+        for( int i = 0; i < numberOfStages_; i++ )
+        {
+            matrixHistory_->getMatrix( i + lowerEntry - offsetEntries_, nodeMatrix_ );
+            interpolatedValue += nodeMatrix_ *
+                    ( repeatedNumerator / ( independentVariableDifferenceCache_[ i ] * denominators_[ lowerEntry ][ i ] ) );
+        }
+    }
+
+    return interpolatedValue;
+}
+
+//! Function to create an interpolator for a matrix history, using the requested type of storage.
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > createMatrixHistoryInterpolator(
+        std::map< double, Eigen::MatrixXd >& matrixHistory,
+        const int numberOfStages,
+        const std::shared_ptr< MatrixHistoryStorageSettings > storageSettings,
+        const bool clearMatrixHistory )
+{
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > matrixInterpolator;
+
+    MatrixHistoryStorageTypes storageType =
+            ( storageSettings == nullptr ) ? in_memory_matrix_history : storageSettings->storageType_;
+    switch( storageType )
+    {
+    case in_memory_matrix_history:
+    {
+        matrixInterpolator = std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::MatrixXd > >(
+                    utilities::createVectorFromMapKeys< Eigen::MatrixXd, double >( matrixHistory ),
+                    utilities::createVectorFromMapValues< Eigen::MatrixXd, double >( matrixHistory ), numberOfStages );
+        if( clearMatrixHistory )
+        {
+            matrixHistory.clear( );
+        }
+        break;
+    }
+    case memory_mapped_matrix_history:
+    case memory_mapped_float_delta_matrix_history:
+    {
+        // Create file with unique name in requested directory
+        boost::filesystem::path storageDirectory = storageSettings->storageDirectory_.empty( ) ?
+                    boost::filesystem::temp_directory_path( ) :
+                    boost::filesystem::path( storageSettings->storageDirectory_ );
+        boost::filesystem::create_directories( storageDirectory );
+        std::string fileName = ( storageDirectory / boost::filesystem::unique_path(
+                                     "tudatMatrixHistory-%%%%-%%%%-%%%%-%%%%.dat" ) ).string( );
+
+        matrixInterpolator = std::make_shared< MemoryMappedLagrangeMatrixInterpolator >(
+                    std::make_shared< MemoryMappedMatrixHistory >(
+                        matrixHistory, fileName, storageType == memory_mapped_float_delta_matrix_history,
+                        clearMatrixHistory ), numberOfStages );
+        break;
+    }
+    case chebyshev_matrix_history:
+    {
+        std::shared_ptr< ChebyshevMatrixHistoryStorageSettings > chebyshevStorageSettings =
+                std::dynamic_pointer_cast< ChebyshevMatrixHistoryStorageSettings >( storageSettings );
+        if( chebyshevStorageSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when creating matrix history interpolator, Chebyshev storage settings are "
+                                      "inconsistent with storage type." );
+        }
+
+        matrixInterpolator = std::make_shared< interpolators::ChebyshevMatrixInterpolator >(
+                    matrixHistory, chebyshevStorageSettings->polynomialDegree_,
+                    chebyshevStorageSettings->maximumNumberOfPointsPerSegment_,
+                    chebyshevStorageSettings->relativeFitTolerance_ );
+        if( clearMatrixHistory )
+        {
+            matrixHistory.clear( );
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error when creating matrix history interpolator, storage type not recognized." );
+    }
+
+    return matrixInterpolator;
+}
+
+} // namespace propagators
+
+} // namespace tudat
@@ -0,0 +1,378 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_MATRIXHISTORYSTORAGE_H
+#define TUDAT_MATRIXHISTORYSTORAGE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Enum listing the types of storage for the (interpolated) state transition and sensitivity matrix histories.
+enum MatrixHistoryStorageTypes
+{
+    in_memory_matrix_history,
+    memory_mapped_matrix_history,
+    memory_mapped_float_delta_matrix_history,
+    chebyshev_matrix_history
+};
+
+//! Class defining how the state transition and sensitivity matrix histories are stored after propagation.
+/*!
+ *  Class defining how the state transition and sensitivity matrix histories are stored after propagation. By default,
+ *  all matrices are kept in memory (in_memory_matrix_history). Alternatively, they are written to a binary file that is
+ *  memory-mapped (memory_mapped_matrix_history), so that only the epochs that are actually used in the interpolation
+ *  are paged into memory. With memory_mapped_float_delta_matrix_history, the matrices are stored in the file as single
+ *  precision differences w.r.t. the matrix at the first epoch, halving the file size at the expense of a relative
+ *  precision of about 1.0E-7 w.r.t. the change of the matrix entries since the first epoch. With
+ *  chebyshev_matrix_history, piecewise Chebyshev polynomials are fitted to the matrices, and only their coefficients
+ *  are retained (see ChebyshevMatrixHistoryStorageSettings).
+ */
+class MatrixHistoryStorageSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param storageType Type of storage for the matrix histories.
+     * \param storageDirectory Directory in which the files of the memory-mapped matrix histories are created (system
+     * temporary directory if empty). The files are removed when the associated history is no longer used.
+     */
+    MatrixHistoryStorageSettings( const MatrixHistoryStorageTypes storageType = in_memory_matrix_history,
+                                  const std::string& storageDirectory = "" ):
+        storageType_( storageType ), storageDirectory_( storageDirectory ){ }
+
+    //! Destructor
+    virtual ~MatrixHistoryStorageSettings( ){ }
+
+    //! Type of storage for the matrix histories.
+    MatrixHistoryStorageTypes storageType_;
+
+    //! Directory in which the files of the memory-mapped matrix histories are created (system temporary directory if empty)
+    std::string storageDirectory_;
+};
+
+//! Class defining the storage of the state transition and sensitivity matrix histories as Chebyshev polynomials.
+/*!
+ *  Class defining the storage of the state transition and sensitivity matrix histories as piecewise Chebyshev
+ *  polynomials, fitted to the matrices at the integration steps after propagation (see
+ *  interpolators::ChebyshevMatrixInterpolator). The raw matrices are discarded after the fit, and an interpolation
+ *  requires only a single polynomial evaluation per matrix entry, which can be written directly into a preallocated
+ *  matrix. The accuracy of the fit is controlled by the polynomial degree, the maximum number of integration steps per
+ *  polynomial segment, and the tolerance on the relative fit residuals (above which segments are split).
+ */
+class ChebyshevMatrixHistoryStorageSettings: public MatrixHistoryStorageSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param polynomialDegree Degree of the Chebyshev polynomials.
+     * \param maximumNumberOfPointsPerSegment Maximum number of integration steps in a single polynomial segment (at
+     * least twice the polynomial degree).
+     * \param relativeFitTolerance Tolerance on the largest residual of the fit of each segment, relative to the largest
+     * absolute value of each matrix column in the segment, above which the segment is split.
+     */
+    ChebyshevMatrixHistoryStorageSettings( const int polynomialDegree = 10,
+                                           const int maximumNumberOfPointsPerSegment = 40,
+                                           const double relativeFitTolerance = 1.0E-10 ):
+        MatrixHistoryStorageSettings( chebyshev_matrix_history ),
+        polynomialDegree_( polynomialDegree ), maximumNumberOfPointsPerSegment_( maximumNumberOfPointsPerSegment ),
+        relativeFitTolerance_( relativeFitTolerance ){ }
+
+    //! Destructor
+    ~ChebyshevMatrixHistoryStorageSettings( ){ }
+
+    //! Degree of the Chebyshev polynomials.
+    int polynomialDegree_;
+
+    //! Maximum number of integration steps in a single polynomial segment.
+    int maximumNumberOfPointsPerSegment_;
+
+    //! Tolerance on the largest relative residual of the fit of each segment.
+    double relativeFitTolerance_;
+};
+
+//! Class storing a history of equally sized matrices in a memory-mapped binary file.
+/*!
+ *  Class storing a history of equally sized matrices in a memory-mapped binary file. The epochs are kept in memory, the
+ *  matrices are written (column-major, one after the other) to a binary file on construction, which is then mapped
+ *  read-only into memory. Matrices are only read from the file when they are retrieved, so that the memory used by the
+ *  history is limited to the pages of the epochs that are actually accessed (which the operating system may release
+ *  again when memory is needed). Optionally, the matrices are stored as single precision differences w.r.t. the matrix
+ *  at the first epoch, which is kept in memory. The file is removed when the object is destroyed.
+ */
+class MemoryMappedMatrixHistory
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor, writes the matrix history to file, and maps the file into memory.
+     * \param matrixHistory History of matrices that is to be stored, as map with epochs as keys. All matrices must have
+     * the same size.
+     * \param fileName Name of the file to which the matrices are to be written (overwritten if it exists).
+     * \param storeAsFloatDeltas Boolean denoting whether the matrices are to be stored as single precision differences
+     * w.r.t. the matrix at the first epoch (instead of in double precision).
+     * \param clearMatrixHistory Boolean denoting whether the entries of matrixHistory are to be removed while they are
+     * written to file (limiting the peak memory use).
+     */
+    MemoryMappedMatrixHistory( std::map< double, Eigen::MatrixXd >& matrixHistory,
+                               const std::string& fileName,
+                               const bool storeAsFloatDeltas = false,
+                               const bool clearMatrixHistory = true );
+
+    //! Destructor, unmaps and removes the file containing the matrices.
+    ~MemoryMappedMatrixHistory( );
+
+    //! Function to retrieve the epochs at which the matrices are stored.
+    /*!
+     *  Function to retrieve the epochs at which the matrices are stored.
+     *  \return Epochs at which the matrices are stored, in ascending order.
+     */
+    const std::vector< double >& getEpochs( ) const
+    {
+        return epochs_;
+    }
+
+    //! Function to retrieve the number of epochs at which the matrices are stored.
+    /*!
+     *  Function to retrieve the number of epochs at which the matrices are stored.
+     *  \return Number of epochs at which the matrices are stored.
+     */
+    int getNumberOfEpochs( ) const
+    {
+        return static_cast< int >( epochs_.size( ) );
+    }
+
+    //! Function to retrieve the number of rows of the stored matrices.
+    /*!
+     *  Function to retrieve the number of rows of the stored matrices.
+     *  \return Number of rows of the stored matrices.
+     */
+    int getNumberOfRows( ) const
+    {
+        return numberOfRows_;
+    }
+
+    //! Function to retrieve the number of columns of the stored matrices.
+    /*!
+     *  Function to retrieve the number of columns of the stored matrices.
+     *  \return Number of columns of the stored matrices.
+     */
+    int getNumberOfColumns( ) const
+    {
+        return numberOfColumns_;
+    }
+
+    //! Function to retrieve whether the matrices are stored as single precision differences w.r.t. the first matrix.
+    /*!
+     *  Function to retrieve whether the matrices are stored as single precision differences w.r.t. the first matrix.
+     *  \return True if the matrices are stored as single precision differences w.r.t. the first matrix.
+     */
+    bool areMatricesStoredAsFloatDeltas( ) const
+    {
+        return storeAsFloatDeltas_;
+    }
+
+    //! Function to retrieve the name of the file containing the matrices.
+    /*!
+     *  Function to retrieve the name of the file containing the matrices.
+     *  \return Name of the file containing the matrices.
+     */
+    std::string getFileName( ) const
+    {
+        return fileName_;
+    }
+
+    //! Function to retrieve the matrix at a given epoch index.
+    /*!
+     *  Function to retrieve the matrix at a given epoch index (returned by reference, to prevent reallocation when
+     *  retrieving multiple matrices).
+     *  \param epochIndex Index of the epoch (in the vector returned by getEpochs) at which the matrix is to be retrieved.
+     *  \param matrix Matrix at the requested epoch index (returned by reference).
+     */
+    void getMatrix( const int epochIndex, Eigen::MatrixXd& matrix ) const;
+
+    //! Function to retrieve the matrix at a given epoch index.
+    /*!
+     *  Function to retrieve the matrix at a given epoch index.
+     *  \param epochIndex Index of the epoch (in the vector returned by getEpochs) at which the matrix is to be retrieved.
+     *  \return Matrix at the requested epoch index.
+     */
+    Eigen::MatrixXd getMatrix( const int epochIndex ) const
+    {
+        Eigen::MatrixXd matrix;
+        getMatrix( epochIndex, matrix );
+        return matrix;
+    }
+
+    //! Function to retrieve the matrix history as a map (reading all matrices from file).
+    /*!
+     *  Function to retrieve the matrix history as a map, reading all matrices from file.
+     *  \return Matrix history, with epochs as keys.
+     */
+    std::map< double, Eigen::MatrixXd > getMatrixHistory( ) const;
+
+private:
+
+    //! Copy constructor (deleted, as the object owns the file that is mapped).
+    MemoryMappedMatrixHistory( const MemoryMappedMatrixHistory& );
+
+    //! Assignment operator (deleted, as the object owns the file that is mapped).
+    MemoryMappedMatrixHistory& operator=( const MemoryMappedMatrixHistory& );
+
+    //! Epochs at which the matrices are stored, in ascending order.
+    std::vector< double > epochs_;
+
+    //! Number of rows of the stored matrices.
+    int numberOfRows_;
+
+    //! Number of columns of the stored matrices.
+    int numberOfColumns_;
+
+    //! Name of the file containing the matrices.
+    std::string fileName_;
+
+    //! Boolean denoting whether the matrices are stored as single precision differences w.r.t. referenceMatrix_.
+    bool storeAsFloatDeltas_;
+
+    //! Matrix at the first epoch, w.r.t. which the stored differences are defined (if storeAsFloatDeltas_ is true).
+    Eigen::MatrixXd referenceMatrix_;
+
+    //! Read-only memory-map of the file containing the matrices (not opened for empty matrices).
+    boost::iostreams::mapped_file_source mappedFile_;
+
+    //! Pointer to the mapped matrix data (if storeAsFloatDeltas_ is false).
+    const double* doubleData_;
+
+    //! Pointer to the mapped matrix differences (if storeAsFloatDeltas_ is true).
+    const float* floatData_;
+};
+
+//! Lagrange interpolator for a matrix history stored in a memory-mapped file.
+/*!
+ *  Lagrange interpolator for a matrix history stored in a memory-mapped file (see MemoryMappedMatrixHistory). The
+ *  interpolation is identical to that of the LagrangeInterpolator (with cubic spline interpolation at the boundaries of
+ *  the domain), but only the matrices at the nodes of the interpolating polynomial are read from the file for each
+ *  interpolation. Note that, since the matrices are not kept in memory, getDependentValues returns an empty vector,
+ *  and only extrapolate_at_boundary and throw_exception_at_boundary boundary handling are supported.
+ */
+class MemoryMappedLagrangeMatrixInterpolator: public interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >
+{
+public:
+
+    using interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >::interpolate;
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param matrixHistory Memory-mapped matrix history that is to be interpolated.
+     * \param numberOfStages Number of data points that are used to calculate the interpolating polynomial (must be even).
+     * \param selectedLookupScheme Identifier of lookupscheme that is used to find the nearest lower data point in the
+     * epochs when requesting interpolation.
+     * \param boundaryHandling Boundary handling method, in case the independent variable is outside the specified range.
+     */
+    MemoryMappedLagrangeMatrixInterpolator(
+            const std::shared_ptr< MemoryMappedMatrixHistory > matrixHistory,
+            const int numberOfStages,
+            const interpolators::AvailableLookupScheme selectedLookupScheme = interpolators::huntingAlgorithm,
+            const interpolators::BoundaryInterpolationType boundaryHandling = interpolators::extrapolate_at_boundary );
+
+    //! Destructor
+    ~MemoryMappedLagrangeMatrixInterpolator( ){ }
+
+    //! Function interpolates the matrix at a given independent variable value.
+    /*!
+     *  Function interpolates the matrix at a given independent variable value, reading only the matrices at the nodes
+     *  of the interpolating polynomial from the matrix history.
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation is to take place.
+     *  \return Interpolated matrix.
+     */
+    Eigen::MatrixXd interpolate( const double targetIndependentVariableValue );
+
+    //! Function to retrieve the memory-mapped matrix history that is interpolated.
+    /*!
+     *  Function to retrieve the memory-mapped matrix history that is interpolated.
+     *  \return Memory-mapped matrix history that is interpolated.
+     */
+    std::shared_ptr< MemoryMappedMatrixHistory > getMatrixHistory( )
+    {
+        return matrixHistory_;
+    }
+
+private:
+
+    //! Memory-mapped matrix history that is interpolated.
+    std::shared_ptr< MemoryMappedMatrixHistory > matrixHistory_;
+
+    //! Number of data points that are used to calculate the interpolating polynomial.
+    int numberOfStages_;
+
+    //! Number of entries at edges of domain where Lagrange interpolation is not used directly.
+    int offsetEntries_;
+
+    //! Number of epochs in the matrix history.
+    int numberOfIndependentValues_;
+
+    //! Pre-computed denominators of the interpolating polynomials, per interval.
+    std::vector< std::vector< double > > denominators_;
+
+    //! Differences between the current independent variable, and the nodes of the current interpolating polynomial.
+    std::vector< double > independentVariableDifferenceCache_;
+
+    //! Matrix to which the matrices at the nodes of the interpolating polynomial are read.
+    Eigen::MatrixXd nodeMatrix_;
+
+    //! Cubic spline interpolator to be used at beginning of domain (constructed from first few matrices)
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > beginInterpolator_;
+
+    //! Cubic spline interpolator to be used at end of domain (constructed from last few matrices)
+    std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > endInterpolator_;
+};
+
+//! Function to create an interpolator for a matrix history, using the requested type of storage.
+/*!
+ *  Function to create a Lagrange interpolator for a matrix history, using the requested type of storage. For
+ *  memory-mapped storage, a file with a unique name is created in the directory defined by the storage settings. For
+ *  chebyshev_matrix_history storage, a Chebyshev interpolator is created instead (for which numberOfStages is not used).
+ *  \param matrixHistory History of matrices that is to be interpolated, as map with epochs as keys.
+ *  \param numberOfStages Number of data points that are used to calculate the interpolating polynomial.
+ *  \param storageSettings Settings for the storage of the matrix history (in-memory storage if nullptr).
+ *  \param clearMatrixHistory Boolean denoting whether to clear the entries of matrixHistory after creation of the
+ *  interpolator.
+ *  \return Interpolator for the matrix history.
+ */
+std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > createMatrixHistoryInterpolator(
+        std::map< double, Eigen::MatrixXd >& matrixHistory,
+        const int numberOfStages,
+        const std::shared_ptr< MatrixHistoryStorageSettings > storageSettings = nullptr,
+        const bool clearMatrixHistory = true );
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_MATRIXHISTORYSTORAGE_H
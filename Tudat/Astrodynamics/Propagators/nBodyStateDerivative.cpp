@@ -8,6 +8,9 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 
+#include <algorithm>
+
+#include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
 #include "Tudat/Astrodynamics/Propagators/nBodyStateDerivative.h"
 
 namespace tudat
@@ -131,6 +134,151 @@ std::vector< std::function< double( ) > > removeCentralGravityAccelerations(
     return centralBodyGravitationalParameters;
 }
 
+//! Function to retrieve the objects that an acceleration model may modify when it is updated, and that may be shared
+//! with other acceleration models
+void getSharedAccelerationModelObjects(
+        const std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > accelerationModel,
+        std::vector< const void* >& sharedObjects )
+{
+    using namespace gravitation;
+
+    if( accelerationModel == nullptr )
+    {
+        return;
+    }
+    sharedObjects.push_back( accelerationModel.get( ) );
+
+    // Retrieve spherical harmonics caches (including the cache for batched evaluation, which is updated for all models
+    // sharing it by whichever model is updated first) and wrapped acceleration models
+    if( std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > sphericalHarmonicAcceleration =
+            std::dynamic_pointer_cast< SphericalHarmonicsGravitationalAccelerationModel >( accelerationModel ) )
+    {
+        sharedObjects.push_back( sphericalHarmonicAcceleration->getSphericalHarmonicsCache( ).get( ) );
+        if( sphericalHarmonicAcceleration->getBatchedGravityCache( ) != nullptr )
+        {
+            sharedObjects.push_back( sphericalHarmonicAcceleration->getBatchedGravityCache( ).get( ) );
+        }
+    }
+    else if( std::shared_ptr< MutualSphericalHarmonicsGravitationalAccelerationModel > mutualAcceleration =
+             std::dynamic_pointer_cast< MutualSphericalHarmonicsGravitationalAccelerationModel >( accelerationModel ) )
+    {
+        getSharedAccelerationModelObjects(
+                    mutualAcceleration->getAccelerationModelFromShExpansionOfBodyExertingAcceleration( ), sharedObjects );
+        getSharedAccelerationModelObjects(
+                    mutualAcceleration->getAccelerationModelFromShExpansionOfBodyUndergoingAcceleration( ), sharedObjects );
+    }
+    else if( std::shared_ptr< ThirdBodyCentralGravityAcceleration > thirdBodyAcceleration =
+             std::dynamic_pointer_cast< ThirdBodyCentralGravityAcceleration >( accelerationModel ) )
+    {
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForBodyUndergoingAcceleration( ), sharedObjects );
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForCentralBody( ), sharedObjects );
+    }
+    else if( std::shared_ptr< ThirdBodySphericalHarmonicsGravitationalAccelerationModel > thirdBodyAcceleration =
+             std::dynamic_pointer_cast< ThirdBodySphericalHarmonicsGravitationalAccelerationModel >( accelerationModel ) )
+    {
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForBodyUndergoingAcceleration( ), sharedObjects );
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForCentralBody( ), sharedObjects );
+    }
+    else if( std::shared_ptr< ThirdBodyMutualSphericalHarmonicsGravitationalAccelerationModel > thirdBodyAcceleration =
+             std::dynamic_pointer_cast< ThirdBodyMutualSphericalHarmonicsGravitationalAccelerationModel >(
+                 accelerationModel ) )
+    {
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForBodyUndergoingAcceleration( ), sharedObjects );
+        getSharedAccelerationModelObjects(
+                    thirdBodyAcceleration->getAccelerationModelForCentralBody( ), sharedObjects );
+    }
+}
+
+//! Function to retrieve the root of a set in a disjoint-set forest, compressing the path to the root.
+unsigned int getDisjointSetRoot( std::vector< unsigned int >& parentIndices, unsigned int index )
+{
+    while( parentIndices.at( index ) != index )
+    {
+        parentIndices[ index ] = parentIndices.at( parentIndices.at( index ) );
+        index = parentIndices.at( index );
+    }
+    return index;
+}
+
+//! Function to partition a list of acceleration models into groups that can be updated independently of one another.
+std::vector< std::vector< unsigned int > > getIndependentAccelerationModelGroups(
+        const std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >&
+        accelerationModelList,
+        const std::vector< std::string >& namesOfBodiesUndergoingAcceleration )
+{
+    if( accelerationModelList.size( ) != namesOfBodiesUndergoingAcceleration.size( ) )
+    {
+        throw std::runtime_error( "Error when grouping acceleration models, number of models (" +
+                                  std::to_string( accelerationModelList.size( ) ) + ") and bodies (" +
+                                  std::to_string( namesOfBodiesUndergoingAcceleration.size( ) ) + ") are inconsistent" );
+    }
+
+    // Join all models sharing a body undergoing acceleration, or any shared object, into a single set.
+    std::vector< unsigned int > parentIndices( accelerationModelList.size( ) );
+    std::map< std::string, unsigned int > firstModelPerBody;
+    std::map< const void*, unsigned int > firstModelPerObject;
+    std::vector< const void* > sharedObjects;
+    for( unsigned int i = 0; i < accelerationModelList.size( ); i++ )
+    {
+        parentIndices[ i ] = i;
+
+        std::vector< unsigned int > modelsToJoin;
+        if( firstModelPerBody.count( namesOfBodiesUndergoingAcceleration.at( i ) ) == 0 )
+        {
+            firstModelPerBody[ namesOfBodiesUndergoingAcceleration.at( i ) ] = i;
+        }
+        else
+        {
+            modelsToJoin.push_back( firstModelPerBody.at( namesOfBodiesUndergoingAcceleration.at( i ) ) );
+        }
+
+        sharedObjects.clear( );
+        getSharedAccelerationModelObjects( accelerationModelList.at( i ), sharedObjects );
+        for( unsigned int j = 0; j < sharedObjects.size( ); j++ )
+        {
+            if( firstModelPerObject.count( sharedObjects.at( j ) ) == 0 )
+            {
+                firstModelPerObject[ sharedObjects.at( j ) ] = i;
+            }
+            else
+            {
+                modelsToJoin.push_back( firstModelPerObject.at( sharedObjects.at( j ) ) );
+            }
+        }
+
+        // Always attach to the lowest root, so that each root is the lowest index in its set.
+        for( unsigned int j = 0; j < modelsToJoin.size( ); j++ )
+        {
+            unsigned int currentRoot = getDisjointSetRoot( parentIndices, i );
+            unsigned int otherRoot = getDisjointSetRoot( parentIndices, modelsToJoin.at( j ) );
+            if( currentRoot != otherRoot )
+            {
+                parentIndices[ std::max( currentRoot, otherRoot ) ] = std::min( currentRoot, otherRoot );
+            }
+        }
+    }
+
+    // Collect sets, ordered by lowest index
+    std::vector< std::vector< unsigned int > > accelerationModelGroups;
+    std::map< unsigned int, unsigned int > groupIndexPerRoot;
+    for( unsigned int i = 0; i < accelerationModelList.size( ); i++ )
+    {
+        unsigned int currentRoot = getDisjointSetRoot( parentIndices, i );
+        if( groupIndexPerRoot.count( currentRoot ) == 0 )
+        {
+            groupIndexPerRoot[ currentRoot ] = accelerationModelGroups.size( );
+            accelerationModelGroups.push_back( std::vector< unsigned int >( ) );
+        }
+        accelerationModelGroups[ groupIndexPerRoot.at( currentRoot ) ].push_back( i );
+    }
+    return accelerationModelGroups;
+}
+
 //! Function to determine in which order the ephemerides are to be updated
 std::vector< std::string > determineEphemerisUpdateorder( std::vector< std::string > integratedBodies,
                                                           std::vector< std::string > centralBodies,
@@ -18,6 +18,7 @@
 #include <memory>
 #include <functional>
 
+#include "Tudat/Basics/parallelExecution.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
@@ -63,6 +64,25 @@ std::vector< std::function< double( ) > > removeCentralGravityAccelerations(
         const std::vector< std::string >& centralBodies, const std::vector< std::string >& bodiesToIntegrate,
         basic_astrodynamics::AccelerationMap& accelerationModelsPerBody );
 
+//! Function to partition a list of acceleration models into groups that can be updated independently of one another.
+/*!
+ * Function to partition a list of acceleration models into groups that can be updated independently of one another (i.e.
+ * concurrently). Two acceleration models are put in the same group if they act on the same body (and may therefore share
+ * its flight conditions, radiation pressure interface, thrust guidance, mass, etc.), if they use the same spherical
+ * harmonics cache or batched spherical harmonic gravity cache (also when wrapped in a third-body or mutual spherical
+ * harmonic acceleration), or if they contain the same (sub-)acceleration model object. The indices in each group are
+ * sorted in ascending order, and the groups are sorted by their first index, so that the result does not depend on the
+ * memory layout of the models.
+ * \param accelerationModelList List of acceleration models
+ * \param namesOfBodiesUndergoingAcceleration Name of body undergoing the acceleration, per entry of accelerationModelList
+ * \return List of groups of indices (in accelerationModelList) of acceleration models that may be updated concurrently
+ * with the models in any other group.
+ */
+std::vector< std::vector< unsigned int > > getIndependentAccelerationModelGroups(
+        const std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >&
+        accelerationModelList,
+        const std::vector< std::string >& namesOfBodiesUndergoingAcceleration );
+
 //! Function to determine in which order the ephemerides are to be updated
 /*!
  * Function to determine in which order the ephemerides are to be updated. The order depends on the
@@ -117,7 +137,8 @@ public:
         accelerationModelsPerBody_( accelerationModelsPerBody ),
         centralBodyData_( centralBodyData ),
         propagatorType_( propagatorType ),
-        bodiesToBeIntegratedNumerically_( bodiesToIntegrate )
+        bodiesToBeIntegratedNumerically_( bodiesToIntegrate ),
+        numberOfAccelerationEvaluationThreads_( 1 )
     {
         // Add empty acceleration map if body is to be propagated with no accelerations.
         for( unsigned int i = 0; i < bodiesToBeIntegratedNumerically_.size( ); i++ )
@@ -187,12 +208,109 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
-        for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+        if( accelerationTaskExecutor_ == nullptr || independentAccelerationModelGroups_.size( ) < 2 )
+        {
+            for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+            {
+                updateAccelerationModel( i, currentTime );
+            }
+        }
+        else
+        {
+            // Update independent groups of acceleration models concurrently; the models in a single group are updated
+            // sequentially, in the same order as for the serial case.
+            accelerationTaskExecutor_->executeTasks(
+                        independentAccelerationModelGroups_.size( ),
+                        [ this, currentTime ]( const unsigned int groupIndex, const unsigned int )
+            {
+                const std::vector< unsigned int >& currentGroup = independentAccelerationModelGroups_[ groupIndex ];
+                for( unsigned int i = 0; i < currentGroup.size( ); i++ )
+                {
+                    updateAccelerationModel( currentGroup[ i ], currentTime );
+                }
+            } );
+        }
+    }
+
+    //! Function to set the object used to profile the computation time of the acceleration models.
+    /*!
+     * Function to set the object used to profile the computation time of the acceleration models. Each acceleration model
+     * is registered with the profiler by this function, identified by its type and the bodies exerting and undergoing it.
+     * \param profiler Object used to profile the computation time of the models (nullptr to stop profiling).
+     */
+    void setPropagationProfiler( const std::shared_ptr< PropagationProfiler > profiler )
+    {
+        propagationProfiler_ = profiler;
+        profiledAccelerationModelIndices_.clear( );
+        if( propagationProfiler_ != nullptr )
+        {
+            for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+            {
+                std::string accelerationName = "custom acceleration";
+                try
+                {
+                    accelerationName = basic_astrodynamics::getAccelerationModelName(
+                                basic_astrodynamics::getAccelerationModelType( accelerationModelList_.at( i ) ) );
+                    accelerationName.erase( accelerationName.find_last_not_of( ' ' ) + 1 );
+                }
+                catch( const std::runtime_error& ){ }
+
+                profiledAccelerationModelIndices_.push_back(
+                            propagationProfiler_->addProfiledFunction(
+                                acceleration_model_profile, accelerationName + " of " +
+                                accelerationModelBodies_.at( i ).second + " on " +
+                                accelerationModelBodies_.at( i ).first ) );
+            }
+        }
+    }
+
+    //! Function to set the number of threads used to update the acceleration models
+    /*!
+     * Function to set the number of threads used to update the acceleration models (in updateStateDerivativeModel). If
+     * more than one thread is used, the acceleration models are partitioned into independent groups (see
+     * getIndependentAccelerationModelGroups), which are updated concurrently. The accelerations are subsequently summed
+     * on the calling thread in a fixed order, so that the state derivative is identical to that obtained with a single
+     * thread. Note that this mode should only be used if custom acceleration models do not modify state shared with
+     * acceleration models acting on other bodies.
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    void setNumberOfAccelerationEvaluationThreads( const unsigned int numberOfThreads )
+    {
+        numberOfAccelerationEvaluationThreads_ =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        if( numberOfAccelerationEvaluationThreads_ > 1 )
+        {
+            accelerationTaskExecutor_ = std::make_shared< utilities::ParallelTaskExecutor >(
+                        numberOfAccelerationEvaluationThreads_ );
+        }
+        else
         {
-            accelerationModelList_.at( i )->updateMembers( currentTime );
+            accelerationTaskExecutor_ = nullptr;
         }
     }
 
+    //! Function to retrieve the number of threads used to update the acceleration models
+    /*!
+     * Function to retrieve the number of threads used to update the acceleration models
+     * \return Number of threads used to update the acceleration models
+     */
+    unsigned int getNumberOfAccelerationEvaluationThreads( )
+    {
+        return numberOfAccelerationEvaluationThreads_;
+    }
+
+    //! Function to retrieve the groups of acceleration models that are updated independently of one another.
+    /*!
+     * Function to retrieve the groups of acceleration models that are updated independently of one another, when using
+     * multiple threads
+     * \return Groups of indices (in list of acceleration models) of acceleration models that are updated concurrently.
+     */
+    std::vector< std::vector< unsigned int > > getIndependentAccelerationModelGroups( )
+    {
+        return independentAccelerationModelGroups_;
+    }
+
     //! Function to convert the propagator-specific form of the state to the conventional form in the global frame.
     /*!
      * Function to convert the propagator-specific form of the state to the conventional form in the
@@ -334,6 +452,8 @@ protected:
     {
         // Iterate over all accelerations and update their internal state.
         accelerationModelList_.clear( );
+        accelerationModelBodies_.clear( );
+        std::vector< std::string > namesOfBodiesUndergoingAcceleration;
         for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
              outerAccelerationIterator != accelerationModelsPerBody_.end( ); outerAccelerationIterator++ )
         {
@@ -346,9 +466,42 @@ protected:
                 for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
                 {
                     accelerationModelList_.push_back( innerAccelerationIterator->second.at( j ) );
+                    namesOfBodiesUndergoingAcceleration.push_back( outerAccelerationIterator->first );
+                    accelerationModelBodies_.push_back(
+                                std::make_pair( outerAccelerationIterator->first, innerAccelerationIterator->first ) );
                 }
             }
         }
+
+        independentAccelerationModelGroups_ = propagators::getIndependentAccelerationModelGroups(
+                    accelerationModelList_, namesOfBodiesUndergoingAcceleration );
+
+        // Re-register acceleration models with profiler, if any.
+        if( propagationProfiler_ != nullptr )
+        {
+            setPropagationProfiler( propagationProfiler_ );
+        }
+    }
+
+    //! Function to update a single acceleration model to the current time, recording its computation time if required.
+    /*!
+     * Function to update a single acceleration model to the current time, recording its computation time if a profiler
+     * has been set.
+     * \param modelIndex Index of acceleration model in accelerationModelList_
+     * \param currentTime Time to which the acceleration model is to be updated.
+     */
+    void updateAccelerationModel( const unsigned int modelIndex, const TimeType currentTime )
+    {
+        if( propagationProfiler_ == nullptr )
+        {
+            accelerationModelList_[ modelIndex ]->updateMembers( currentTime );
+        }
+        else
+        {
+            PropagationProfiler::ClockType::time_point startTime = PropagationProfiler::ClockType::now( );
+            accelerationModelList_[ modelIndex ]->updateMembers( currentTime );
+            propagationProfiler_->addFunctionCall( profiledAccelerationModelIndices_[ modelIndex ], startTime );
+        }
     }
 
     //! Function to get the state derivative of the system in Cartesian coordinates.
@@ -388,7 +541,7 @@ protected:
                 for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
                 {
                     // Calculate acceleration and add to state derivative.
-                    stateDerivative.block( currentBodyIndex * 6 + 3, 0, 3, 1 ) += (
+                    stateDerivative.template block< 3, 1 >( currentBodyIndex * 6 + 3, 0 ) += (
                                 innerAccelerationIterator->second[ j ]->getAcceleration( ) ).
                             template cast< StateScalarType >( );
                 }
@@ -397,8 +550,8 @@ protected:
             if( addPositionDerivatives )
             {
                 // Add body velocity as derivative of its position.
-                stateDerivative.block( currentBodyIndex * 6, 0, 3, 1 ) =
-                        ( stateOfSystemToBeIntegrated.segment( currentBodyIndex * 6 + 3, 3 ) );
+                stateDerivative.template block< 3, 1 >( currentBodyIndex * 6, 0 ) =
+                        ( stateOfSystemToBeIntegrated.template segment< 3 >( currentBodyIndex * 6 + 3 ) );
             }
             currentAccelerationIndex++;
         }
@@ -438,6 +591,9 @@ protected:
     //! Vector of acceleration models, containing all entries of accelerationModelsPerBody_.
     std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > accelerationModelList_;
 
+    //! Names of bodies undergoing and exerting acceleration (first and second), per entry of accelerationModelList_.
+    std::vector< std::pair< std::string, std::string > > accelerationModelBodies_;
+
     //! Object responsible for providing the current integration origins from the global origins.
     std::shared_ptr< CentralBodyData< StateScalarType, TimeType > > centralBodyData_;
 
@@ -449,6 +605,21 @@ protected:
 
     std::vector< int > bodyOrder_;
 
+    //! Groups of indices (in accelerationModelList_) of acceleration models that can be updated concurrently.
+    std::vector< std::vector< unsigned int > > independentAccelerationModelGroups_;
+
+    //! Number of threads used to update the acceleration models.
+    unsigned int numberOfAccelerationEvaluationThreads_;
+
+    //! Object used to update groups of acceleration models concurrently (nullptr if a single thread is used).
+    std::shared_ptr< utilities::ParallelTaskExecutor > accelerationTaskExecutor_;
+
+    //! Object used to profile the computation time of the acceleration models (nullptr if not profiled).
+    std::shared_ptr< PropagationProfiler > propagationProfiler_;
+
+    //! Index in propagationProfiler_ of each entry of accelerationModelList_.
+    std::vector< unsigned int > profiledAccelerationModelIndices_;
+
     //! Predefined iterator to save (de-)allocation time.
     std::unordered_map< std::string, std::vector<
     std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > >::iterator innerAccelerationIterator;
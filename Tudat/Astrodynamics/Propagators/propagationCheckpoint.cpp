@@ -0,0 +1,172 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Propagators/propagationCheckpoint.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Identifier written at the start of each checkpoint file.
+const std::string propagationCheckpointFileIdentifier = "TudatPropagationCheckpoint";
+
+//! Version of the checkpoint file format.
+const std::uint32_t propagationCheckpointFileVersion = 2;
+
+//! Function to check whether a checkpoint is to be written, to be called once after each integration step.
+bool PropagationCheckpointHandler::isCheckpointToBeWritten( )
+{
+    if( checkpointSettings_ == nullptr )
+    {
+        return false;
+    }
+
+    numberOfStepsSinceCheckpoint_++;
+    if( checkpointSettings_->numberOfStepsBetweenCheckpoints_ > 0 &&
+            numberOfStepsSinceCheckpoint_ >= checkpointSettings_->numberOfStepsBetweenCheckpoints_ )
+    {
+        return true;
+    }
+
+    if( checkpointSettings_->wallTimeBetweenCheckpoints_ == checkpointSettings_->wallTimeBetweenCheckpoints_ )
+    {
+        const double wallTimeSinceCheckpoint = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    std::chrono::steady_clock::now( ) - lastCheckpointClockTime_ ).count( ) * 1.0e-9;
+        if( wallTimeSinceCheckpoint >= checkpointSettings_->wallTimeBetweenCheckpoints_ )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! Function to write a checkpoint.
+void PropagationCheckpointHandler::writeCheckpoint(
+        const std::function< void( std::ostream& ) >& propagationDataWriteFunction,
+        const bool appendToCheckpointFile )
+{
+    if( checkpointSettings_ == nullptr )
+    {
+        throw std::runtime_error( "Error when writing propagation checkpoint, no checkpoint settings are defined." );
+    }
+
+    // Write checkpoint record to buffer, so that its size can be written before it
+    std::ostringstream recordStream( std::ios::binary );
+    propagationDataWriteFunction( recordStream );
+    if( additionalDataWriteFunction_ != nullptr )
+    {
+        additionalDataWriteFunction_( recordStream );
+    }
+    const std::string record = recordStream.str( );
+
+    // Append record to checkpoint file, or write it to temporary file (with file header) replacing the checkpoint file
+    const std::string outputFile = appendToCheckpointFile ?
+                checkpointSettings_->checkpointFile_ : checkpointSettings_->checkpointFile_ + ".tmp";
+    {
+        std::ofstream checkpointStream(
+                    outputFile, std::ios::binary | ( appendToCheckpointFile ? std::ios::app : std::ios::trunc ) );
+        if( !checkpointStream.is_open( ) )
+        {
+            throw std::runtime_error( "Error when opening propagation checkpoint file " + outputFile );
+        }
+
+        if( !appendToCheckpointFile )
+        {
+            serialization::writeBinaryIdentifier( checkpointStream, propagationCheckpointFileIdentifier );
+            serialization::writeBinaryValue( checkpointStream, propagationCheckpointFileVersion );
+        }
+        serialization::writeBinaryValue( checkpointStream, static_cast< std::uint64_t >( record.size( ) ) );
+        checkpointStream.write( record.data( ), record.size( ) );
+
+        checkpointStream.flush( );
+        if( !checkpointStream )
+        {
+            throw std::runtime_error( "Error when writing propagation checkpoint file " + outputFile );
+        }
+    }
+
+    if( !appendToCheckpointFile )
+    {
+        std::remove( checkpointSettings_->checkpointFile_.c_str( ) );
+        if( std::rename( outputFile.c_str( ), checkpointSettings_->checkpointFile_.c_str( ) ) != 0 )
+        {
+            throw std::runtime_error( "Error when moving propagation checkpoint file " + outputFile + " to " +
+                                      checkpointSettings_->checkpointFile_ );
+        }
+    }
+
+    numberOfStepsSinceCheckpoint_ = 0;
+    lastCheckpointClockTime_ = std::chrono::steady_clock::now( );
+    numberOfWrittenCheckpoints_++;
+}
+
+//! Function to read the checkpoint from which the propagation is to be resumed.
+void PropagationCheckpointHandler::readCheckpoint(
+        const std::function< void( std::istream& ) >& propagationDataReadFunction )
+{
+    std::ifstream checkpointStream( resumeCheckpointFile_, std::ios::binary );
+    if( !checkpointStream.is_open( ) )
+    {
+        throw std::runtime_error( "Error when opening propagation checkpoint file " + resumeCheckpointFile_ );
+    }
+
+    serialization::readAndCheckBinaryIdentifier( checkpointStream, propagationCheckpointFileIdentifier );
+    std::uint32_t fileVersion;
+    serialization::readBinaryValue( checkpointStream, fileVersion );
+    if( fileVersion != propagationCheckpointFileVersion )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint file " + resumeCheckpointFile_ +
+                                  ", file version " + std::to_string( fileVersion ) + " is not supported." );
+    }
+
+    // Read all complete records, in the order in which they were written (an incomplete last record, resulting from an
+    // interruption while it was appended, is ignored)
+    unsigned int numberOfReadRecords = 0;
+    std::uint64_t recordSize;
+    std::string record;
+    while( checkpointStream.read( reinterpret_cast< char* >( &recordSize ), sizeof( recordSize ) ) )
+    {
+        record.resize( recordSize );
+        if( !checkpointStream.read( &record[ 0 ], recordSize ) )
+        {
+            break;
+        }
+
+        std::istringstream recordStream( record, std::ios::binary );
+        propagationDataReadFunction( recordStream );
+        if( additionalDataReadFunction_ != nullptr )
+        {
+            additionalDataReadFunction_( recordStream );
+        }
+        numberOfReadRecords++;
+    }
+
+    if( numberOfReadRecords == 0 )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint file " + resumeCheckpointFile_ +
+                                  ", file contains no complete checkpoint." );
+    }
+
+    numberOfStepsSinceCheckpoint_ = 0;
+    lastCheckpointClockTime_ = std::chrono::steady_clock::now( );
+}
+
+} // namespace propagators
+
+} // namespace tudat
@@ -0,0 +1,269 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONCHECKPOINT_H
+#define TUDAT_PROPAGATIONCHECKPOINT_H
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "Tudat/Basics/binarySerialization.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Settings for the checkpoints that are to be written during a propagation.
+/*!
+ *  Settings for the checkpoints that are to be written during a propagation. A checkpoint contains all data required to
+ *  continue the propagation bit-identically (see PropagationCheckpointHandler), and is written after an integration step
+ *  once the given number of steps, or the given wall time, has passed since the previous checkpoint (or the start of the
+ *  propagation). The first checkpoint of a propagation replaces any existing checkpoint file, subsequent checkpoints are
+ *  appended to it.
+ */
+class PropagationCheckpointSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param checkpointFile Name of the file to which the checkpoints are written
+     * \param numberOfStepsBetweenCheckpoints Number of integration steps after which a checkpoint is written (0 if not
+     * used)
+     * \param wallTimeBetweenCheckpoints Wall time (in seconds) after which a checkpoint is written (NaN if not used)
+     */
+    PropagationCheckpointSettings( const std::string& checkpointFile,
+                                   const unsigned int numberOfStepsBetweenCheckpoints,
+                                   const double wallTimeBetweenCheckpoints = TUDAT_NAN ):
+        checkpointFile_( checkpointFile ), numberOfStepsBetweenCheckpoints_( numberOfStepsBetweenCheckpoints ),
+        wallTimeBetweenCheckpoints_( wallTimeBetweenCheckpoints )
+    {
+        if( numberOfStepsBetweenCheckpoints_ == 0 && !( wallTimeBetweenCheckpoints_ == wallTimeBetweenCheckpoints_ ) )
+        {
+            throw std::runtime_error( "Error in propagation checkpoint settings, neither number of steps nor wall time "
+                                      "between checkpoints is defined." );
+        }
+    }
+
+    //! Name of the file to which the checkpoints are written
+    std::string checkpointFile_;
+
+    //! Number of integration steps after which a checkpoint is written (0 if not used)
+    unsigned int numberOfStepsBetweenCheckpoints_;
+
+    //! Wall time (in seconds) after which a checkpoint is written (NaN if not used)
+    double wallTimeBetweenCheckpoints_;
+};
+
+//! Class to write checkpoints during a propagation, and to read the checkpoint from which a propagation is resumed.
+/*!
+ *  Class to write checkpoints during a propagation, and to read the checkpoint from which a propagation is resumed. The
+ *  propagation loop (integrateEquationsFromIntegrator) writes its own data (integrator state, current time and step
+ *  size, output saved so far, etc.), after which the additional data of the object that manages the propagation (e.g.
+ *  the function evaluation counters of the dynamics simulator) is written through the function set by
+ *  setAdditionalDataFunctions. To limit the cost of writing checkpoints during long propagations, the propagation loop
+ *  writes the saved output in full only in its first checkpoint, and subsequently only the output saved since the
+ *  previous checkpoint. Therefore, the first checkpoint is written to a temporary file, which replaces the checkpoint
+ *  file once complete, after which the subsequent checkpoints are appended to this file as records preceded by their
+ *  size. When resuming, all records are read in order, and an incomplete last record (from an interruption while it was
+ *  being appended) is ignored, so that the propagation is resumed from the last complete checkpoint.
+ */
+class PropagationCheckpointHandler
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param checkpointSettings Settings for the checkpoints that are to be written (nullptr if none)
+     * \param resumeCheckpointFile Name of the checkpoint file from which the propagation is to be resumed (empty if the
+     * propagation is to be started from its initial state)
+     */
+    PropagationCheckpointHandler( const std::shared_ptr< PropagationCheckpointSettings > checkpointSettings,
+                                  const std::string& resumeCheckpointFile = "" ):
+        checkpointSettings_( checkpointSettings ), resumeCheckpointFile_( resumeCheckpointFile ),
+        numberOfStepsSinceCheckpoint_( 0 ), lastCheckpointClockTime_( std::chrono::steady_clock::now( ) ),
+        numberOfWrittenCheckpoints_( 0 ){ }
+
+    //! Function to set the functions with which additional data is written to, and read from, the checkpoints.
+    /*!
+     * Function to set the functions with which additional data is written to, and read from, the checkpoints, called
+     * after the data of the propagation loop has been written/read.
+     * \param additionalDataWriteFunction Function to write additional data to a checkpoint
+     * \param additionalDataReadFunction Function to read the additional data from a checkpoint
+     */
+    void setAdditionalDataFunctions(
+            const std::function< void( std::ostream& ) > additionalDataWriteFunction,
+            const std::function< void( std::istream& ) > additionalDataReadFunction )
+    {
+        additionalDataWriteFunction_ = additionalDataWriteFunction;
+        additionalDataReadFunction_ = additionalDataReadFunction;
+    }
+
+    //! Function to check whether the propagation is to be resumed from a checkpoint.
+    bool isPropagationToBeResumed( ) const
+    {
+        return !resumeCheckpointFile_.empty( );
+    }
+
+    //! Function to check whether a checkpoint is to be written, to be called once after each integration step.
+    /*!
+     * Function to check whether a checkpoint is to be written, to be called once after each integration step, based on
+     * the number of steps and wall time since the last checkpoint.
+     * \return True if a checkpoint is to be written.
+     */
+    bool isCheckpointToBeWritten( );
+
+    //! Function to write a checkpoint.
+    /*!
+     * Function to write a checkpoint, as a record consisting of the data written by propagationDataWriteFunction and the
+     * additional data (see setAdditionalDataFunctions), which is either appended to the checkpoint file, or written
+     * (after a file header) to a new checkpoint file replacing the existing one.
+     * \param propagationDataWriteFunction Function writing the data of the propagation loop
+     * \param appendToCheckpointFile Boolean denoting whether the checkpoint is appended to the checkpoint file written
+     * previously during the same propagation (in which case the propagation data need only contain the data that has
+     * changed since the previous checkpoint)
+     */
+    void writeCheckpoint( const std::function< void( std::ostream& ) >& propagationDataWriteFunction,
+                          const bool appendToCheckpointFile = false );
+
+    //! Function to read the checkpoint from which the propagation is to be resumed.
+    /*!
+     * Function to read the checkpoint from which the propagation is to be resumed. For each (complete) record in the
+     * checkpoint file, in the order in which they were written, the data of the propagation loop is read by
+     * propagationDataReadFunction, after which the additional data is read (see setAdditionalDataFunctions).
+     * \param propagationDataReadFunction Function reading the data of the propagation loop from a single record
+     */
+    void readCheckpoint( const std::function< void( std::istream& ) >& propagationDataReadFunction );
+
+    //! Function to retrieve the number of checkpoints written since the creation of this object.
+    unsigned int getNumberOfWrittenCheckpoints( ) const
+    {
+        return numberOfWrittenCheckpoints_;
+    }
+
+private:
+
+    //! Settings for the checkpoints that are to be written (nullptr if none)
+    std::shared_ptr< PropagationCheckpointSettings > checkpointSettings_;
+
+    //! Name of the checkpoint file from which the propagation is to be resumed (empty if none)
+    std::string resumeCheckpointFile_;
+
+    //! Function to write additional data to a checkpoint (empty if none)
+    std::function< void( std::ostream& ) > additionalDataWriteFunction_;
+
+    //! Function to read additional data from a checkpoint (empty if none)
+    std::function< void( std::istream& ) > additionalDataReadFunction_;
+
+    //! Number of integration steps since the last checkpoint
+    unsigned int numberOfStepsSinceCheckpoint_;
+
+    //! Wall time at which the last checkpoint was written (or at which this object was created)
+    std::chrono::steady_clock::time_point lastCheckpointClockTime_;
+
+    //! Number of checkpoints written since the creation of this object
+    unsigned int numberOfWrittenCheckpoints_;
+};
+
+//! Function to write the entries added to a propagation history (map or StateHistory) to a binary stream.
+/*!
+ *  Function to write the entries added to a propagation history (map or StateHistory) since the previous checkpoint to a
+ *  binary stream, as the current number of entries in the history, followed by the number of added entries and the time
+ *  and entry of each added epoch. Since entries are only added to the history after the time of the previous checkpoint
+ *  (in the direction of propagation), and only removed from its start (when streaming the output), the history is
+ *  reconstructed from these increments by readHistoryIncrementFromBinaryStream.
+ *  \param stream Stream to which the entries are to be written
+ *  \param history History of which the added entries are to be written
+ *  \param isPropagationForward Boolean denoting whether the propagation is forward in time
+ *  \param isPreviousCheckpointWritten Boolean denoting whether a previous checkpoint was written (if false, the full
+ *  history is written)
+ *  \param previousCheckpointTime Time at which the previous checkpoint was written
+ */
+template< typename EntryType, typename HistoryType, typename TimeType >
+void writeHistoryIncrementToBinaryStream( std::ostream& stream, const HistoryType& history,
+                                          const bool isPropagationForward, const bool isPreviousCheckpointWritten,
+                                          const TimeType& previousCheckpointTime )
+{
+    auto firstEntryIterator = history.begin( );
+    auto endEntryIterator = history.end( );
+    if( isPreviousCheckpointWritten )
+    {
+        if( isPropagationForward )
+        {
+            firstEntryIterator = history.upper_bound( previousCheckpointTime );
+        }
+        else
+        {
+            endEntryIterator = history.lower_bound( previousCheckpointTime );
+        }
+    }
+
+    std::uint64_t numberOfAddedEntries = 0;
+    for( auto historyIterator = firstEntryIterator; historyIterator != endEntryIterator; historyIterator++ )
+    {
+        numberOfAddedEntries++;
+    }
+
+    serialization::writeBinaryValue( stream, static_cast< std::uint64_t >( history.size( ) ) );
+    serialization::writeBinaryValue( stream, numberOfAddedEntries );
+    for( auto historyIterator = firstEntryIterator; historyIterator != endEntryIterator; historyIterator++ )
+    {
+        const EntryType entry = historyIterator->second;
+        serialization::writeBinaryValue( stream, historyIterator->first );
+        serialization::writeBinaryValue( stream, entry );
+    }
+}
+
+//! Function to read the entries added to a propagation history (map or StateHistory) from a binary stream.
+/*!
+ *  Function to read the entries added to a propagation history (map or StateHistory) from a binary stream, as written by
+ *  writeHistoryIncrementToBinaryStream, and add them to the history. Subsequently, the earliest entries (in the
+ *  direction of propagation) are removed until the history has the size it had when the entries were written.
+ *  \param stream Stream from which the entries are to be read
+ *  \param history History to which the entries are added (returned by reference)
+ *  \param isPropagationForward Boolean denoting whether the propagation is forward in time
+ */
+template< typename TimeType, typename EntryType, typename HistoryType >
+void readHistoryIncrementFromBinaryStream( std::istream& stream, HistoryType& history,
+                                           const bool isPropagationForward )
+{
+    std::uint64_t numberOfEntries, numberOfAddedEntries;
+    serialization::readBinaryValue( stream, numberOfEntries );
+    serialization::readBinaryValue( stream, numberOfAddedEntries );
+
+    TimeType time;
+    EntryType entry;
+    for( std::uint64_t i = 0; i < numberOfAddedEntries; i++ )
+    {
+        serialization::readBinaryValue( stream, time );
+        serialization::readBinaryValue( stream, entry );
+        history[ time ] = entry;
+    }
+
+    while( history.size( ) > numberOfEntries )
+    {
+        history.erase( isPropagationForward ? history.begin( ) : std::prev( history.end( ) ) );
+    }
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONCHECKPOINT_H
@@ -0,0 +1,458 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONEVENTDETECTION_H
+#define TUDAT_PROPAGATIONEVENTDETECTION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/binarySerialization.h"
+#include "Tudat/Mathematics/BasicMathematics/functionProxy.h"
+#include "Tudat/Mathematics/NumericalIntegrators/numericalIntegrator.h"
+#include "Tudat/Mathematics/RootFinders/createRootFinder.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Enum listing the directions of zero crossings of an event function that are to be detected.
+enum PropagationEventCrossingDirection
+{
+    increasing_event_crossing,
+    decreasing_event_crossing,
+    any_event_crossing
+};
+
+//! Data of an event that was detected during a propagation.
+template< typename TimeType = double, typename StateType = Eigen::MatrixXd >
+struct DetectedPropagationEvent
+{
+    //! Index of the event (in the list of events given to PropagationEventDetector)
+    unsigned int eventIndex_;
+
+    //! Name of the event
+    std::string eventName_;
+
+    //! Time at which the event function crosses zero
+    TimeType eventTime_;
+
+    //! State at which the event function crosses zero
+    StateType eventState_;
+
+    //! Boolean denoting whether the event function is increasing (true) or decreasing (false) at the zero crossing
+    bool isIncreasing_;
+
+    //! Boolean denoting whether the event terminated the propagation
+    bool isTerminal_;
+};
+
+//! Class to detect zero crossings of event functions during a propagation, without re-integrating any steps.
+/*!
+ *  Class to detect zero crossings of event functions (e.g. altitude crossings, eclipse entry/exit) during a propagation,
+ *  without re-integrating any steps. After each accepted integration step, all event functions are evaluated once at the
+ *  end of the step (through a single call of the event function, which returns the values of all events), and compared to
+ *  their values at the start of the step. Only for the events with a sign change in the step (in the requested
+ *  direction), the zero crossing is located with a root finder, on an interpolant of the last step: the dense output of
+ *  the integrator if available, or a cubic Hermite interpolant through the states and state derivatives at the start and
+ *  end of the step otherwise. As a result, the cost of detecting (non-terminal) events is limited to one evaluation of the
+ *  event functions per step, as long as no event occurs. The state derivatives for the Hermite interpolant are only
+ *  computed for steps in which an event occurs, and the state derivative at the end of such a step is retained, so that
+ *  it is re-used if an event also occurs in the next step.
+ *  The events detected in a step are logged in chronological order. If one of them is terminal, the events after it are
+ *  discarded, and the propagation loop stops at the time and state of the terminal event.
+ */
+template< typename StateType = Eigen::MatrixXd, typename TimeType = double >
+class PropagationEventDetector
+{
+public:
+
+    //! Typedef for function computing the values of all events from the current time and (propagated) state.
+    typedef std::function< void( const TimeType, const StateType&, Eigen::VectorXd& ) > EventFunction;
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param eventFunction Function computing the values of all events (returned by reference) from the current time
+     * and (propagated) state. The zero crossings of these values are the events that are to be detected.
+     * \param eventNames Names of the events
+     * \param crossingDirections Directions of the zero crossings that are to be detected, per event
+     * \param areEventsTerminal Booleans denoting whether the propagation is to be stopped at the event, per event
+     * \param rootFinderSettings Settings of the root finder with which the zero crossings are located within a step (the
+     * tolerance is applied to the time since the start of the step).
+     */
+    PropagationEventDetector(
+            const EventFunction& eventFunction,
+            const std::vector< std::string >& eventNames,
+            const std::vector< PropagationEventCrossingDirection >& crossingDirections,
+            const std::vector< bool >& areEventsTerminal,
+            const std::shared_ptr< root_finders::RootFinderSettings > rootFinderSettings =
+            std::make_shared< root_finders::RootFinderSettings >( root_finders::bisection_root_finder, 1.0E-12, 100 ) ):
+        eventFunction_( eventFunction ), eventNames_( eventNames ), crossingDirections_( crossingDirections ),
+        areEventsTerminal_( areEventsTerminal ), rootFinderSettings_( rootFinderSettings ),
+        isCurrentStepStartStateDerivativeSet_( false ), isCurrentStepEndStateDerivativeSet_( false ),
+        isTerminalEventDetected_( false )
+    {
+        if( eventNames_.size( ) != crossingDirections_.size( ) || eventNames_.size( ) != areEventsTerminal_.size( ) )
+        {
+            throw std::runtime_error( "Error when creating propagation event detector, inconsistent number of event names ("
+                                      + std::to_string( eventNames_.size( ) ) + "), crossing directions (" +
+                                      std::to_string( crossingDirections_.size( ) ) + ") and terminal flags (" +
+                                      std::to_string( areEventsTerminal_.size( ) ) + ")." );
+        }
+        previousEventValues_.setZero( eventNames_.size( ) );
+        currentEventValues_.setZero( eventNames_.size( ) );
+    }
+
+    //! Function to initialize the event values at the start of the propagation, and clear the detected events.
+    /*!
+     * Function to initialize the event values at the start of the propagation, and clear the detected events. Events for
+     * which the event function is exactly zero at the initial time are not detected.
+     * \param initialTime Initial time of the propagation
+     * \param initialState Initial (propagated) state
+     */
+    void initialize( const TimeType initialTime, const StateType& initialState )
+    {
+        evaluateEventFunction( initialTime, initialState, currentEventValues_ );
+        previousEventValues_ = currentEventValues_;
+        currentStepEndState_ = initialState;
+        isCurrentStepStartStateDerivativeSet_ = false;
+        isCurrentStepEndStateDerivativeSet_ = false;
+        detectedEvents_.clear( );
+        isTerminalEventDetected_ = false;
+    }
+
+    //! Function to detect the events in the last step taken by the integrator.
+    /*!
+     * Function to detect the events in the last step taken by the integrator, and to log them. To be called once after
+     * each accepted step.
+     * \param integrator Integrator with which the last step was taken
+     * \param previousTime Time at the start of the last step
+     * \param currentTime Time at the end of the last step
+     * \param currentState (Post-processed) state at the end of the last step
+     * \param statePostProcessingFunction Function to post-process the states interpolated within the step (empty if none)
+     * \return True if a terminal event was detected in the last step (see getTerminalEvent).
+     */
+    template< typename TimeStepType >
+    bool detectEventsInLastStep(
+            const std::shared_ptr< numerical_integrators::NumericalIntegrator<
+            TimeType, StateType, StateType, TimeStepType > > integrator,
+            const TimeType previousTime,
+            const TimeType currentTime,
+            const StateType& currentState,
+            const std::function< void( StateType& ) > statePostProcessingFunction = std::function< void( StateType& ) >( ) )
+    {
+        // Evaluate events at end of step
+        previousEventValues_.swap( currentEventValues_ );
+        evaluateEventFunction( currentTime, currentState, currentEventValues_ );
+
+        // Retain states at start and end of step for interpolation, if the integrator provides no dense output (the
+        // previous state of the integrator is not used, as it does not denote the start of the step for all integrators).
+        // The state derivative at the end of the previous step (if computed) is retained for the start of this step.
+        const bool isDenseOutputAvailable = integrator->isDenseOutputAvailable( );
+        if( !isDenseOutputAvailable )
+        {
+            currentStepStartState_.swap( currentStepEndState_ );
+            currentStepEndState_ = currentState;
+
+            currentStepStartStateDerivative_.swap( currentStepEndStateDerivative_ );
+            isCurrentStepStartStateDerivativeSet_ = isCurrentStepEndStateDerivativeSet_;
+            isCurrentStepEndStateDerivativeSet_ = false;
+        }
+
+        // Find events for which the event function crosses zero in the requested direction
+        std::vector< unsigned int > crossedEventIndices;
+        for( unsigned int i = 0; i < eventNames_.size( ); i++ )
+        {
+            if( isEventCrossed( previousEventValues_( i ), currentEventValues_( i ), crossingDirections_.at( i ) ) )
+            {
+                crossedEventIndices.push_back( i );
+            }
+        }
+
+        if( crossedEventIndices.size( ) == 0 )
+        {
+            return false;
+        }
+
+        // Create function to interpolate the state within the last step
+        const double stepSize = static_cast< double >( currentTime - previousTime );
+        std::function< StateType( const double ) > stateInterpolationFunction;
+        if( isDenseOutputAvailable )
+        {
+            stateInterpolationFunction = [ = ]( const double timeSinceStepStart )
+            {
+                StateType interpolatedState = integrator->getDenseOutputState( previousTime + timeSinceStepStart );
+                if( statePostProcessingFunction != nullptr )
+                {
+                    statePostProcessingFunction( interpolatedState );
+                }
+                return interpolatedState;
+            };
+        }
+        else
+        {
+            // Cubic Hermite interpolant from states and state derivatives at start and end of step (state derivative at
+            // start of step only computed if not retained from the previous step)
+            if( !isCurrentStepStartStateDerivativeSet_ )
+            {
+                currentStepStartStateDerivative_ =
+                        integrator->getStateDerivativeFunction( )( previousTime, currentStepStartState_ );
+                isCurrentStepStartStateDerivativeSet_ = true;
+            }
+            currentStepEndStateDerivative_ = integrator->getStateDerivativeFunction( )( currentTime, currentState );
+            isCurrentStepEndStateDerivativeSet_ = true;
+
+            const StateType& previousState = currentStepStartState_;
+            const StateType& previousStateDerivative = currentStepStartStateDerivative_;
+            const StateType& currentStateDerivative = currentStepEndStateDerivative_;
+            stateInterpolationFunction = [ & ]( const double timeSinceStepStart )
+            {
+                typedef typename StateType::Scalar StateScalarType;
+                const StateScalarType tau = static_cast< StateScalarType >( timeSinceStepStart / stepSize );
+                const StateScalarType tau2 = tau * tau;
+                const StateScalarType tau3 = tau2 * tau;
+                const StateScalarType stepSizeScalar = static_cast< StateScalarType >( stepSize );
+                StateType interpolatedState =
+                        ( 2.0 * tau3 - 3.0 * tau2 + 1.0 ) * previousState +
+                        ( ( tau3 - 2.0 * tau2 + tau ) * stepSizeScalar ) * previousStateDerivative +
+                        ( -2.0 * tau3 + 3.0 * tau2 ) * currentState +
+                        ( ( tau3 - tau2 ) * stepSizeScalar ) * currentStateDerivative;
+                if( statePostProcessingFunction != nullptr )
+                {
+                    statePostProcessingFunction( interpolatedState );
+                }
+                return interpolatedState;
+            };
+        }
+
+        // Locate zero crossings within step
+        std::vector< DetectedPropagationEvent< TimeType, StateType > > eventsInStep;
+        Eigen::VectorXd interpolatedEventValues = Eigen::VectorXd::Zero( eventNames_.size( ) );
+        for( unsigned int i = 0; i < crossedEventIndices.size( ); i++ )
+        {
+            const unsigned int eventIndex = crossedEventIndices.at( i );
+
+            DetectedPropagationEvent< TimeType, StateType > detectedEvent;
+            detectedEvent.eventIndex_ = eventIndex;
+            detectedEvent.eventName_ = eventNames_.at( eventIndex );
+            detectedEvent.isIncreasing_ = ( currentEventValues_( eventIndex ) > previousEventValues_( eventIndex ) );
+            detectedEvent.isTerminal_ = areEventsTerminal_.at( eventIndex );
+
+            if( currentEventValues_( eventIndex ) == 0.0 )
+            {
+                detectedEvent.eventTime_ = currentTime;
+                detectedEvent.eventState_ = currentState;
+            }
+            else
+            {
+                std::function< double( const double ) > interpolatedEventFunction =
+                        [ & ]( const double timeSinceStepStart )
+                {
+                    evaluateEventFunction( previousTime + timeSinceStepStart,
+                                           stateInterpolationFunction( timeSinceStepStart ), interpolatedEventValues );
+                    return interpolatedEventValues( eventIndex );
+                };
+
+                std::shared_ptr< root_finders::RootFinderCore< double > > rootFinder =
+                        root_finders::createRootFinder< double >(
+                            rootFinderSettings_, std::min( 0.0, stepSize ), std::max( 0.0, stepSize ), stepSize / 2.0 );
+                const double timeSinceStepStart = rootFinder->execute(
+                            std::make_shared< basic_mathematics::FunctionProxy< double, double > >(
+                                interpolatedEventFunction ), stepSize / 2.0 );
+
+                detectedEvent.eventTime_ = previousTime + timeSinceStepStart;
+                detectedEvent.eventState_ = stateInterpolationFunction( timeSinceStepStart );
+            }
+            eventsInStep.push_back( detectedEvent );
+        }
+
+        // Log events in chronological order, up to and including the first terminal event
+        std::stable_sort( eventsInStep.begin( ), eventsInStep.end( ),
+                          [ & ]( const DetectedPropagationEvent< TimeType, StateType >& event1,
+                          const DetectedPropagationEvent< TimeType, StateType >& event2 )
+        {
+            return ( stepSize > 0.0 ) ? ( event1.eventTime_ < event2.eventTime_ ) :
+                                        ( event2.eventTime_ < event1.eventTime_ );
+        } );
+        for( unsigned int i = 0; i < eventsInStep.size( ); i++ )
+        {
+            detectedEvents_.push_back( eventsInStep.at( i ) );
+            if( eventsInStep.at( i ).isTerminal_ )
+            {
+                isTerminalEventDetected_ = true;
+                break;
+            }
+        }
+
+        return isTerminalEventDetected_;
+    }
+
+    //! Function to retrieve the events detected since the start of the propagation, in chronological order.
+    const std::vector< DetectedPropagationEvent< TimeType, StateType > >& getDetectedEvents( ) const
+    {
+        return detectedEvents_;
+    }
+
+    //! Function to check whether a terminal event was detected.
+    bool isTerminalEventDetected( ) const
+    {
+        return isTerminalEventDetected_;
+    }
+
+    //! Function to retrieve the terminal event at which the propagation was stopped.
+    const DetectedPropagationEvent< TimeType, StateType >& getTerminalEvent( ) const
+    {
+        if( !isTerminalEventDetected_ )
+        {
+            throw std::runtime_error( "Error when retrieving terminal propagation event, no terminal event was detected." );
+        }
+        return detectedEvents_.back( );
+    }
+
+    //! Function to retrieve the names of the events.
+    const std::vector< std::string >& getEventNames( ) const
+    {
+        return eventNames_;
+    }
+
+    //! Function to write the detected events to a binary stream (e.g. a propagation checkpoint).
+    void writeDetectedEvents( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "PropagationEvents" );
+        serialization::writeBinaryValue( stream, static_cast< std::uint64_t >( detectedEvents_.size( ) ) );
+        for( unsigned int i = 0; i < detectedEvents_.size( ); i++ )
+        {
+            serialization::writeBinaryValue( stream, detectedEvents_.at( i ).eventIndex_ );
+            serialization::writeBinaryValue( stream, detectedEvents_.at( i ).eventTime_ );
+            serialization::writeBinaryValue( stream, detectedEvents_.at( i ).eventState_ );
+            serialization::writeBinaryValue( stream, detectedEvents_.at( i ).isIncreasing_ );
+        }
+    }
+
+    //! Function to read the detected events from a binary stream, as written by writeDetectedEvents.
+    void readDetectedEvents( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "PropagationEvents" );
+        std::uint64_t numberOfEvents;
+        serialization::readBinaryValue( stream, numberOfEvents );
+
+        detectedEvents_.clear( );
+        for( std::uint64_t i = 0; i < numberOfEvents; i++ )
+        {
+            DetectedPropagationEvent< TimeType, StateType > detectedEvent;
+            serialization::readBinaryValue( stream, detectedEvent.eventIndex_ );
+            serialization::readBinaryValue( stream, detectedEvent.eventTime_ );
+            serialization::readBinaryValue( stream, detectedEvent.eventState_ );
+            serialization::readBinaryValue( stream, detectedEvent.isIncreasing_ );
+            if( detectedEvent.eventIndex_ >= eventNames_.size( ) )
+            {
+                throw std::runtime_error( "Error when reading propagation events, event index " +
+                                          std::to_string( detectedEvent.eventIndex_ ) + " is not defined." );
+            }
+            detectedEvent.eventName_ = eventNames_.at( detectedEvent.eventIndex_ );
+            detectedEvent.isTerminal_ = areEventsTerminal_.at( detectedEvent.eventIndex_ );
+            detectedEvents_.push_back( detectedEvent );
+        }
+    }
+
+private:
+
+    //! Function to evaluate the event function, and check the number of values it returns
+    void evaluateEventFunction( const TimeType time, const StateType& state, Eigen::VectorXd& eventValues )
+    {
+        eventFunction_( time, state, eventValues );
+        if( static_cast< unsigned int >( eventValues.rows( ) ) != eventNames_.size( ) )
+        {
+            throw std::runtime_error( "Error in propagation event function, returned " +
+                                      std::to_string( eventValues.rows( ) ) + " values, but " +
+                                      std::to_string( eventNames_.size( ) ) + " events are defined." );
+        }
+    }
+
+    //! Function to check whether the event function crosses zero (in the requested direction) between two values
+    static bool isEventCrossed( const double previousValue, const double currentValue,
+                                const PropagationEventCrossingDirection crossingDirection )
+    {
+        const bool isIncreasingCrossing = ( previousValue < 0.0 && currentValue >= 0.0 );
+        const bool isDecreasingCrossing = ( previousValue > 0.0 && currentValue <= 0.0 );
+        switch( crossingDirection )
+        {
+        case increasing_event_crossing:
+            return isIncreasingCrossing;
+        case decreasing_event_crossing:
+            return isDecreasingCrossing;
+        case any_event_crossing:
+            return isIncreasingCrossing || isDecreasingCrossing;
+        default:
+            throw std::runtime_error( "Error when detecting propagation event, crossing direction not recognized." );
+        }
+    }
+
+    //! Function computing the values of all events from the current time and (propagated) state
+    EventFunction eventFunction_;
+
+    //! Names of the events
+    std::vector< std::string > eventNames_;
+
+    //! Directions of the zero crossings that are to be detected, per event
+    std::vector< PropagationEventCrossingDirection > crossingDirections_;
+
+    //! Booleans denoting whether the propagation is to be stopped at the event, per event
+    std::vector< bool > areEventsTerminal_;
+
+    //! Settings of the root finder with which the zero crossings are located within a step
+    std::shared_ptr< root_finders::RootFinderSettings > rootFinderSettings_;
+
+    //! Values of the events at the start of the last step
+    Eigen::VectorXd previousEventValues_;
+
+    //! Values of the events at the end of the last step
+    Eigen::VectorXd currentEventValues_;
+
+    //! State at start of last step (only set if the integrator provides no dense output)
+    StateType currentStepStartState_;
+
+    //! State at end of last step (only set if the integrator provides no dense output)
+    StateType currentStepEndState_;
+
+    //! State derivative at start of last step (only set if an event occurred in the last or second to last step)
+    StateType currentStepStartStateDerivative_;
+
+    //! State derivative at end of last step (only set if an event occurred in the last step)
+    StateType currentStepEndStateDerivative_;
+
+    //! Boolean denoting whether currentStepStartStateDerivative_ is set for the state at the start of the last step
+    bool isCurrentStepStartStateDerivativeSet_;
+
+    //! Boolean denoting whether currentStepEndStateDerivative_ is set for the state at the end of the last step
+    bool isCurrentStepEndStateDerivativeSet_;
+
+    //! Events detected since the start of the propagation, in chronological order
+    std::vector< DetectedPropagationEvent< TimeType, StateType > > detectedEvents_;
+
+    //! Boolean denoting whether a terminal event was detected
+    bool isTerminalEventDetected_;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONEVENTDETECTION_H
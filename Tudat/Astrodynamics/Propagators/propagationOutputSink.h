@@ -0,0 +1,760 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONOUTPUTSINK_H
+#define TUDAT_PROPAGATIONOUTPUTSINK_H
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propagators/stateHistory.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Base class for objects that receive the propagation results while the propagation is running.
+/*!
+ *  Base class for objects that receive the propagation results while the propagation is running. This non-templated class
+ *  is used to store the sink in the propagator settings, the functional interface is defined in the derived
+ *  PropagationOutputSink class.
+ */
+class PropagationOutputSinkBase
+{
+public:
+
+    //! Virtual destructor
+    virtual ~PropagationOutputSinkBase( ){ }
+};
+
+//! Base class for objects that receive the propagation results while the propagation is running.
+/*!
+ *  Base class for objects that receive the propagation results while the propagation is running. If a sink is provided
+ *  to the propagator settings, each saved epoch (state in the 'conventional form' and dependent variables) is passed to
+ *  processOutput as soon as it is final, and the dynamics simulator only retains the final epoch. This allows the memory
+ *  usage of a propagation to be independent of its duration. Each epoch is passed exactly once, in the order in which
+ *  it was propagated (i.e. with decreasing time for backwards propagation).
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class PropagationOutputSink: public PropagationOutputSinkBase
+{
+public:
+
+    //! Virtual destructor
+    virtual ~PropagationOutputSink( ){ }
+
+    //! Function called at the start of each propagation.
+    virtual void startPropagation( ){ }
+
+    //! Function called at the start of a propagation that is resumed from a checkpoint.
+    /*!
+     * Function called (instead of startPropagation) at the start of a propagation that is resumed from a checkpoint
+     * (see PropagationCheckpointHandler). The sink is to discard any epochs it received after the first
+     * numberOfProcessedEpochs epochs (i.e. after the checkpoint was written), so that each epoch is processed exactly
+     * once. To be implemented in derived classes that support resuming; if not implemented, throws error.
+     * \param numberOfProcessedEpochs Number of epochs that were processed by the sink when the checkpoint was written
+     */
+    virtual void resumePropagation( const unsigned int numberOfProcessedEpochs )
+    {
+        throw std::runtime_error( "Error, propagation output sink does not support resuming a propagation from a "
+                                  "checkpoint (" + std::to_string( numberOfProcessedEpochs ) + " epochs processed)." );
+    }
+
+    //! Function to process the propagation results at a single epoch.
+    /*!
+     * Function to process the propagation results at a single epoch.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form' (\sa SingleStateTypeDerivative::convertToOutputSolution)
+     * \param dependentVariables Dependent variables at the current epoch (empty if none are saved)
+     */
+    virtual void processOutput( const TimeType time,
+                                const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                                const Eigen::VectorXd& dependentVariables ) = 0;
+
+    //! Function called at the end of each propagation, after the final epoch has been processed.
+    virtual void finalizePropagation( ){ }
+};
+
+//! Sink that stores the full propagation results in memory.
+/*!
+ *  Sink that stores the full propagation results in memory, equivalent to the (conventional) state and dependent
+ *  variable histories stored in the dynamics simulator when no sink is used. This class is primarily intended to be
+ *  combined with other sinks (see MultiplePropagationOutputSink). The dynamics simulator does not use this sink when no
+ *  sink is set, since it then also retains what a sink does not receive: the propagated state in its integrated
+ *  (e.g. Encke or Gauss) form, the cumulative computation time at each step, and the results saved before a checkpoint
+ *  from which the propagation is resumed. It also requires these histories to set the integrated results in the
+ *  environment.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class InMemoryPropagationOutputSink: public PropagationOutputSink< StateScalarType, TimeType >
+{
+public:
+
+    //! Function called at the start of each propagation, clears the histories.
+    void startPropagation( )
+    {
+        stateHistory_.clear( );
+        dependentVariableHistory_.clear( );
+    }
+
+    //! Function called at the start of a propagation that is resumed from a checkpoint.
+    /*!
+     * Function called at the start of a propagation that is resumed from a checkpoint, removes the epochs received after
+     * the first numberOfProcessedEpochs epochs. Note that, if the sink was created after the checkpoint was written
+     * (e.g. in a new process), the epochs before the checkpoint are not available.
+     * \param numberOfProcessedEpochs Number of epochs that were processed by the sink when the checkpoint was written
+     */
+    void resumePropagation( const unsigned int numberOfProcessedEpochs )
+    {
+        while( stateHistory_.size( ) > numberOfProcessedEpochs )
+        {
+            // Epochs were processed in propagation order, remove the last processed epoch
+            const bool isPropagationForward = !( stateHistory_.getTime( 0 ) < firstProcessedTime_ );
+            const TimeType lastTime = isPropagationForward ?
+                        stateHistory_.getTime( stateHistory_.size( ) - 1 ) : stateHistory_.getTime( 0 );
+            stateHistory_.erase( lastTime );
+            dependentVariableHistory_.erase( lastTime );
+        }
+    }
+
+    //! Function to store the propagation results at a single epoch.
+    /*!
+     * Function to store the propagation results at a single epoch.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form'
+     * \param dependentVariables Dependent variables at the current epoch (not stored if empty)
+     */
+    void processOutput( const TimeType time,
+                        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                        const Eigen::VectorXd& dependentVariables )
+    {
+        if( stateHistory_.empty( ) )
+        {
+            firstProcessedTime_ = time;
+        }
+        stateHistory_.insert( time, state );
+        if( dependentVariables.rows( ) > 0 )
+        {
+            dependentVariableHistory_.insert( time, dependentVariables );
+        }
+    }
+
+    //! Function to retrieve the state history of the last propagation
+    const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getStateHistory( )
+    {
+        return stateHistory_;
+    }
+
+    //! Function to retrieve the dependent variable history of the last propagation
+    const StateHistory< TimeType, Eigen::VectorXd >& getDependentVariableHistory( )
+    {
+        return dependentVariableHistory_;
+    }
+
+private:
+
+    //! State history of the last propagation
+    StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > stateHistory_;
+
+    //! Dependent variable history of the last propagation
+    StateHistory< TimeType, Eigen::VectorXd > dependentVariableHistory_;
+
+    //! Time of the first epoch processed in the last propagation (used to determine the propagation direction)
+    TimeType firstProcessedTime_ = TimeType( 0.0 );
+};
+
+//! Sink that writes the propagation results to a binary file.
+/*!
+ *  Sink that writes the propagation results to a binary file, without retaining them in memory. The file starts with
+ *  two unsigned 32-bit integers (size of state and size of dependent variable vector), followed by one record per
+ *  epoch, consisting of the time, state and dependent variables, all written as (native endian) double. The file may be
+ *  read with readBinaryPropagationOutputFile.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class BinaryFilePropagationOutputSink: public PropagationOutputSink< StateScalarType, TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param fileName Name of the file to which the results are written (overwritten at the start of each propagation)
+     */
+    BinaryFilePropagationOutputSink( const std::string& fileName ):
+        fileName_( fileName ), isHeaderWritten_( false ), stateSize_( 0 ), dependentVariableSize_( 0 ){ }
+
+    //! Destructor, closes file if still open.
+    ~BinaryFilePropagationOutputSink( )
+    {
+        if( outputFile_.is_open( ) )
+        {
+            outputFile_.close( );
+        }
+    }
+
+    //! Function called at the start of each propagation, (re)opens the output file.
+    void startPropagation( )
+    {
+        if( outputFile_.is_open( ) )
+        {
+            outputFile_.close( );
+        }
+        outputFile_.open( fileName_, std::ios::binary | std::ios::trunc );
+        if( !outputFile_.is_open( ) )
+        {
+            throw std::runtime_error( "Error when opening propagation output file " + fileName_ );
+        }
+        isHeaderWritten_ = false;
+        numberOfWrittenEpochs_ = 0;
+    }
+
+    //! Function called at the start of a propagation that is resumed from a checkpoint.
+    /*!
+     * Function called at the start of a propagation that is resumed from a checkpoint. The existing output file is
+     * truncated after the first numberOfProcessedEpochs records (removing any records written after the checkpoint), and
+     * subsequent records are appended to it.
+     * \param numberOfProcessedEpochs Number of epochs that were processed by the sink when the checkpoint was written
+     */
+    void resumePropagation( const unsigned int numberOfProcessedEpochs )
+    {
+        if( numberOfProcessedEpochs == 0 )
+        {
+            startPropagation( );
+            return;
+        }
+
+        if( outputFile_.is_open( ) )
+        {
+            outputFile_.close( );
+        }
+
+        // Read sizes of output from existing file
+        {
+            std::ifstream inputFile( fileName_, std::ios::binary );
+            inputFile.read( reinterpret_cast< char* >( &stateSize_ ), sizeof( std::uint32_t ) );
+            inputFile.read( reinterpret_cast< char* >( &dependentVariableSize_ ), sizeof( std::uint32_t ) );
+            if( !inputFile )
+            {
+                throw std::runtime_error( "Error when resuming propagation output to " + fileName_ +
+                                          ", could not read existing file" );
+            }
+        }
+
+        // Remove records written after checkpoint
+        const std::uintmax_t recordSize = ( 1 + stateSize_ + dependentVariableSize_ ) * sizeof( double );
+        const std::uintmax_t fileSize = 2 * sizeof( std::uint32_t ) + numberOfProcessedEpochs * recordSize;
+        if( boost::filesystem::file_size( fileName_ ) < fileSize )
+        {
+            throw std::runtime_error( "Error when resuming propagation output to " + fileName_ +
+                                      ", file contains fewer epochs than were written before checkpoint" );
+        }
+        boost::filesystem::resize_file( fileName_, fileSize );
+
+        outputFile_.open( fileName_, std::ios::binary | std::ios::app );
+        if( !outputFile_.is_open( ) )
+        {
+            throw std::runtime_error( "Error when opening propagation output file " + fileName_ );
+        }
+        recordBuffer_.resize( 1 + stateSize_ + dependentVariableSize_ );
+        isHeaderWritten_ = true;
+        numberOfWrittenEpochs_ = numberOfProcessedEpochs;
+    }
+
+    //! Function to write the propagation results at a single epoch to the file.
+    /*!
+     * Function to write the propagation results at a single epoch to the file.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form'
+     * \param dependentVariables Dependent variables at the current epoch
+     */
+    void processOutput( const TimeType time,
+                        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                        const Eigen::VectorXd& dependentVariables )
+    {
+        if( !outputFile_.is_open( ) )
+        {
+            throw std::runtime_error( "Error when writing propagation output to " + fileName_ + ", file is not open" );
+        }
+
+        // Write sizes of output upon first call, and check consistency afterwards
+        if( !isHeaderWritten_ )
+        {
+            stateSize_ = static_cast< std::uint32_t >( state.rows( ) );
+            dependentVariableSize_ = static_cast< std::uint32_t >( dependentVariables.rows( ) );
+            outputFile_.write( reinterpret_cast< const char* >( &stateSize_ ), sizeof( std::uint32_t ) );
+            outputFile_.write( reinterpret_cast< const char* >( &dependentVariableSize_ ), sizeof( std::uint32_t ) );
+            recordBuffer_.resize( 1 + stateSize_ + dependentVariableSize_ );
+            isHeaderWritten_ = true;
+        }
+        else if( state.rows( ) != static_cast< int >( stateSize_ ) ||
+                 dependentVariables.rows( ) != static_cast< int >( dependentVariableSize_ ) )
+        {
+            throw std::runtime_error( "Error when writing propagation output to " + fileName_ +
+                                      ", size of output is inconsistent with previous epochs" );
+        }
+
+        // Write record
+        recordBuffer_[ 0 ] = static_cast< double >( time );
+        for( unsigned int i = 0; i < stateSize_; i++ )
+        {
+            recordBuffer_[ 1 + i ] = static_cast< double >( state( i ) );
+        }
+        for( unsigned int i = 0; i < dependentVariableSize_; i++ )
+        {
+            recordBuffer_[ 1 + stateSize_ + i ] = dependentVariables( i );
+        }
+        outputFile_.write( reinterpret_cast< const char* >( recordBuffer_.data( ) ),
+                           static_cast< std::streamsize >( recordBuffer_.size( ) * sizeof( double ) ) );
+        numberOfWrittenEpochs_++;
+    }
+
+    //! Function called at the end of each propagation, closes the output file.
+    void finalizePropagation( )
+    {
+        if( outputFile_.is_open( ) )
+        {
+            outputFile_.close( );
+        }
+    }
+
+    //! Function to retrieve the number of epochs written during the last propagation
+    unsigned int getNumberOfWrittenEpochs( )
+    {
+        return numberOfWrittenEpochs_;
+    }
+
+private:
+
+    //! Name of the file to which the results are written
+    std::string fileName_;
+
+    //! Output file stream
+    std::ofstream outputFile_;
+
+    //! Boolean denoting whether the header (sizes of output) has been written to the current file
+    bool isHeaderWritten_;
+
+    //! Size of state vector
+    std::uint32_t stateSize_;
+
+    //! Size of dependent variable vector
+    std::uint32_t dependentVariableSize_;
+
+    //! Pre-allocated buffer for a single record
+    std::vector< double > recordBuffer_;
+
+    //! Number of epochs written during the last propagation
+    unsigned int numberOfWrittenEpochs_ = 0;
+};
+
+//! Function to read a file written by BinaryFilePropagationOutputSink.
+/*!
+ *  Function to read a file written by BinaryFilePropagationOutputSink.
+ *  \param fileName Name of the file that is to be read
+ *  \param stateHistory State history read from file (returned by reference)
+ *  \param dependentVariableHistory Dependent variable history read from file (returned by reference; empty if no
+ *  dependent variables were written)
+ */
+inline void readBinaryPropagationOutputFile(
+        const std::string& fileName,
+        std::map< double, Eigen::VectorXd >& stateHistory,
+        std::map< double, Eigen::VectorXd >& dependentVariableHistory )
+{
+    stateHistory.clear( );
+    dependentVariableHistory.clear( );
+
+    std::ifstream inputFile( fileName, std::ios::binary );
+    if( !inputFile.is_open( ) )
+    {
+        throw std::runtime_error( "Error when opening propagation output file " + fileName );
+    }
+
+    std::uint32_t stateSize = 0, dependentVariableSize = 0;
+    inputFile.read( reinterpret_cast< char* >( &stateSize ), sizeof( std::uint32_t ) );
+    inputFile.read( reinterpret_cast< char* >( &dependentVariableSize ), sizeof( std::uint32_t ) );
+    if( !inputFile )
+    {
+        // Empty file: no epochs were written
+        return;
+    }
+
+    std::vector< double > recordBuffer( 1 + stateSize + dependentVariableSize );
+    while( inputFile.read( reinterpret_cast< char* >( recordBuffer.data( ) ),
+                           static_cast< std::streamsize >( recordBuffer.size( ) * sizeof( double ) ) ) )
+    {
+        stateHistory[ recordBuffer[ 0 ] ] = Eigen::Map< Eigen::VectorXd >( recordBuffer.data( ) + 1, stateSize );
+        if( dependentVariableSize > 0 )
+        {
+            dependentVariableHistory[ recordBuffer[ 0 ] ] =
+                    Eigen::Map< Eigen::VectorXd >( recordBuffer.data( ) + 1 + stateSize, dependentVariableSize );
+        }
+    }
+}
+
+//! Sink that reduces the propagation results to a set of statistics per time window.
+/*!
+ *  Sink that reduces the propagation results to a set of statistics per time window. For each window, the results at the
+ *  first epoch of the window (decimated output) and the minimum, maximum and mean of each entry over the epochs in the
+ *  window are stored. The entries of the stored vectors are the state, followed by the dependent variables. A window
+ *  starts at the first epoch not contained in the previous window, and contains all subsequent epochs less than the
+ *  window duration away from its first epoch. The stored histories use the first epoch of each window as key.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class ReducingPropagationOutputSink: public PropagationOutputSink< StateScalarType, TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param windowDuration Duration of each window over which the statistics are computed
+     */
+    ReducingPropagationOutputSink( const double windowDuration ):
+        windowDuration_( windowDuration ), numberOfEpochsInWindow_( 0 )
+    {
+        if( !( windowDuration_ > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating reducing propagation output sink, window duration must be positive" );
+        }
+    }
+
+    //! Function called at the start of each propagation, clears the stored statistics.
+    void startPropagation( )
+    {
+        decimatedHistory_.clear( );
+        minimumHistory_.clear( );
+        maximumHistory_.clear( );
+        meanHistory_.clear( );
+        numberOfEpochsInWindow_ = 0;
+    }
+
+    //! Function to add the propagation results at a single epoch to the statistics of the current window.
+    /*!
+     * Function to add the propagation results at a single epoch to the statistics of the current window.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form'
+     * \param dependentVariables Dependent variables at the current epoch
+     */
+    void processOutput( const TimeType time,
+                        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                        const Eigen::VectorXd& dependentVariables )
+    {
+        // Close current window if epoch is outside of it
+        if( numberOfEpochsInWindow_ > 0 &&
+                !( std::fabs( static_cast< double >( time - windowStartTime_ ) ) < windowDuration_ ) )
+        {
+            saveCurrentWindow( );
+        }
+
+        currentOutput_.resize( state.rows( ) + dependentVariables.rows( ) );
+        currentOutput_.segment( 0, state.rows( ) ) = state.template cast< double >( );
+        currentOutput_.segment( state.rows( ), dependentVariables.rows( ) ) = dependentVariables;
+
+        if( numberOfEpochsInWindow_ == 0 )
+        {
+            windowStartTime_ = time;
+            windowFirstOutput_ = currentOutput_;
+            windowMinimum_ = currentOutput_;
+            windowMaximum_ = currentOutput_;
+            windowSum_ = currentOutput_;
+        }
+        else
+        {
+            if( currentOutput_.rows( ) != windowSum_.rows( ) )
+            {
+                throw std::runtime_error( "Error in reducing propagation output sink, size of output is inconsistent "
+                                          "with previous epochs" );
+            }
+            windowMinimum_ = windowMinimum_.cwiseMin( currentOutput_ );
+            windowMaximum_ = windowMaximum_.cwiseMax( currentOutput_ );
+            windowSum_ += currentOutput_;
+        }
+        numberOfEpochsInWindow_++;
+    }
+
+    //! Function called at the end of each propagation, saves the statistics of the last (partial) window.
+    void finalizePropagation( )
+    {
+        if( numberOfEpochsInWindow_ > 0 )
+        {
+            saveCurrentWindow( );
+        }
+    }
+
+    //! Function to retrieve the output at the first epoch of each window
+    const StateHistory< TimeType, Eigen::VectorXd >& getDecimatedHistory( )
+    {
+        return decimatedHistory_;
+    }
+
+    //! Function to retrieve the minimum of each output entry per window
+    const StateHistory< TimeType, Eigen::VectorXd >& getMinimumHistory( )
+    {
+        return minimumHistory_;
+    }
+
+    //! Function to retrieve the maximum of each output entry per window
+    const StateHistory< TimeType, Eigen::VectorXd >& getMaximumHistory( )
+    {
+        return maximumHistory_;
+    }
+
+    //! Function to retrieve the mean of each output entry per window
+    const StateHistory< TimeType, Eigen::VectorXd >& getMeanHistory( )
+    {
+        return meanHistory_;
+    }
+
+private:
+
+    //! Function to save the statistics of the current window, and start a new window
+    void saveCurrentWindow( )
+    {
+        decimatedHistory_.insert( windowStartTime_, windowFirstOutput_ );
+        minimumHistory_.insert( windowStartTime_, windowMinimum_ );
+        maximumHistory_.insert( windowStartTime_, windowMaximum_ );
+        meanHistory_.insert( windowStartTime_, windowSum_ / static_cast< double >( numberOfEpochsInWindow_ ) );
+        numberOfEpochsInWindow_ = 0;
+    }
+
+    //! Duration of each window over which the statistics are computed
+    double windowDuration_;
+
+    //! Number of epochs in the current window
+    unsigned int numberOfEpochsInWindow_;
+
+    //! First epoch of the current window
+    TimeType windowStartTime_;
+
+    //! Concatenated state and dependent variables at current epoch (pre-allocated)
+    Eigen::VectorXd currentOutput_;
+
+    //! Output at the first epoch of the current window
+    Eigen::VectorXd windowFirstOutput_;
+
+    //! Minimum of each output entry in current window
+    Eigen::VectorXd windowMinimum_;
+
+    //! Maximum of each output entry in current window
+    Eigen::VectorXd windowMaximum_;
+
+    //! Sum of each output entry in current window
+    Eigen::VectorXd windowSum_;
+
+    //! Output at the first epoch of each window
+    StateHistory< TimeType, Eigen::VectorXd > decimatedHistory_;
+
+    //! Minimum of each output entry per window
+    StateHistory< TimeType, Eigen::VectorXd > minimumHistory_;
+
+    //! Maximum of each output entry per window
+    StateHistory< TimeType, Eigen::VectorXd > maximumHistory_;
+
+    //! Mean of each output entry per window
+    StateHistory< TimeType, Eigen::VectorXd > meanHistory_;
+};
+
+//! Sink that retains only the propagation results at the last N processed epochs.
+/*!
+ *  Sink that retains only the propagation results at the last N processed epochs, in a pre-allocated ring buffer, so
+ *  that its memory use is fixed, regardless of the duration of the propagation.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class RingBufferPropagationOutputSink: public PropagationOutputSink< StateScalarType, TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param bufferSize Number of epochs N that are retained
+     */
+    RingBufferPropagationOutputSink( const unsigned int bufferSize ):
+        bufferSize_( bufferSize ), times_( bufferSize ), states_( bufferSize ), dependentVariables_( bufferSize ),
+        nextIndex_( 0 ), numberOfStoredEpochs_( 0 )
+    {
+        if( bufferSize_ == 0 )
+        {
+            throw std::runtime_error( "Error when creating ring buffer propagation output sink, buffer size must be positive" );
+        }
+    }
+
+    //! Function called at the start of each propagation, empties the buffer.
+    void startPropagation( )
+    {
+        nextIndex_ = 0;
+        numberOfStoredEpochs_ = 0;
+    }
+
+    //! Function to store the propagation results at a single epoch, overwriting the oldest epoch if the buffer is full.
+    /*!
+     * Function to store the propagation results at a single epoch, overwriting the oldest epoch if the buffer is full.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form'
+     * \param dependentVariables Dependent variables at the current epoch
+     */
+    void processOutput( const TimeType time,
+                        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                        const Eigen::VectorXd& dependentVariables )
+    {
+        times_[ nextIndex_ ] = time;
+        states_[ nextIndex_ ] = state;
+        dependentVariables_[ nextIndex_ ] = dependentVariables;
+
+        nextIndex_ = ( nextIndex_ + 1 ) % bufferSize_;
+        if( numberOfStoredEpochs_ < bufferSize_ )
+        {
+            numberOfStoredEpochs_++;
+        }
+    }
+
+    //! Function to retrieve the number of epochs currently stored in the buffer
+    unsigned int getNumberOfStoredEpochs( )
+    {
+        return numberOfStoredEpochs_;
+    }
+
+    //! Function to retrieve the stored state history
+    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > getStateHistory( )
+    {
+        std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > stateHistory;
+        for( unsigned int i = 0; i < numberOfStoredEpochs_; i++ )
+        {
+            unsigned int currentIndex = getBufferIndex( i );
+            stateHistory[ times_[ currentIndex ] ] = states_[ currentIndex ];
+        }
+        return stateHistory;
+    }
+
+    //! Function to retrieve the stored dependent variable history (empty if no dependent variables were provided)
+    std::map< TimeType, Eigen::VectorXd > getDependentVariableHistory( )
+    {
+        std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+        for( unsigned int i = 0; i < numberOfStoredEpochs_; i++ )
+        {
+            unsigned int currentIndex = getBufferIndex( i );
+            if( dependentVariables_[ currentIndex ].rows( ) > 0 )
+            {
+                dependentVariableHistory[ times_[ currentIndex ] ] = dependentVariables_[ currentIndex ];
+            }
+        }
+        return dependentVariableHistory;
+    }
+
+private:
+
+    //! Function to retrieve the index in the buffer of the i^th oldest stored epoch
+    unsigned int getBufferIndex( const unsigned int i )
+    {
+        return ( nextIndex_ + bufferSize_ - numberOfStoredEpochs_ + i ) % bufferSize_;
+    }
+
+    //! Number of epochs N that are retained
+    unsigned int bufferSize_;
+
+    //! Buffer of times
+    std::vector< TimeType > times_;
+
+    //! Buffer of states
+    std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > states_;
+
+    //! Buffer of dependent variables
+    std::vector< Eigen::VectorXd > dependentVariables_;
+
+    //! Index in buffers at which next epoch is to be stored
+    unsigned int nextIndex_;
+
+    //! Number of epochs currently stored in the buffer
+    unsigned int numberOfStoredEpochs_;
+};
+
+//! Sink that passes the propagation results to a list of other sinks.
+template< typename StateScalarType = double, typename TimeType = double >
+class MultiplePropagationOutputSink: public PropagationOutputSink< StateScalarType, TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param outputSinks List of sinks to which the propagation results are passed
+     */
+    MultiplePropagationOutputSink(
+            const std::vector< std::shared_ptr< PropagationOutputSink< StateScalarType, TimeType > > >& outputSinks ):
+        outputSinks_( outputSinks ){ }
+
+    //! Function called at the start of each propagation, calls startPropagation of all sinks.
+    void startPropagation( )
+    {
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->startPropagation( );
+        }
+    }
+
+    //! Function called at the start of a propagation that is resumed from a checkpoint, calls resumePropagation of all
+    //! sinks.
+    void resumePropagation( const unsigned int numberOfProcessedEpochs )
+    {
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->resumePropagation( numberOfProcessedEpochs );
+        }
+    }
+
+    //! Function to pass the propagation results at a single epoch to all sinks.
+    /*!
+     * Function to pass the propagation results at a single epoch to all sinks.
+     * \param time Epoch of the results
+     * \param state Propagated state in the 'conventional form'
+     * \param dependentVariables Dependent variables at the current epoch
+     */
+    void processOutput( const TimeType time,
+                        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& state,
+                        const Eigen::VectorXd& dependentVariables )
+    {
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->processOutput( time, state, dependentVariables );
+        }
+    }
+
+    //! Function called at the end of each propagation, calls finalizePropagation of all sinks.
+    void finalizePropagation( )
+    {
+        for( unsigned int i = 0; i < outputSinks_.size( ); i++ )
+        {
+            outputSinks_.at( i )->finalizePropagation( );
+        }
+    }
+
+private:
+
+    //! List of sinks to which the propagation results are passed
+    std::vector< std::shared_ptr< PropagationOutputSink< StateScalarType, TimeType > > > outputSinks_;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONOUTPUTSINK_H
@@ -0,0 +1,139 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/Propagators/propagationProfiler.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to get a string representing a profiled function type.
+std::string getProfiledFunctionTypeName( const ProfiledFunctionType functionType )
+{
+    std::string functionTypeName;
+    switch( functionType )
+    {
+    case acceleration_model_profile:
+        functionTypeName = "acceleration model";
+        break;
+    case torque_model_profile:
+        functionTypeName = "torque model";
+        break;
+    case mass_rate_model_profile:
+        functionTypeName = "mass rate model";
+        break;
+    case environment_update_profile:
+        functionTypeName = "environment update";
+        break;
+    case dependent_variable_profile:
+        functionTypeName = "dependent variable";
+        break;
+    default:
+        throw std::runtime_error( "Error, did not recognize profiled function type " +
+                                  std::to_string( functionType ) );
+    }
+    return functionTypeName;
+}
+
+//! Function to register a function of which the computation time is to be profiled.
+unsigned int PropagationProfiler::addProfiledFunction(
+        const ProfiledFunctionType functionType, const std::string& functionId )
+{
+    profiledFunctions_.push_back( ProfiledFunctionStatistics( functionType, functionId ) );
+    return profiledFunctions_.size( ) - 1;
+}
+
+//! Function to reset the statistics of all profiled functions to zero (retaining the registered functions).
+void PropagationProfiler::resetStatistics( )
+{
+    for( unsigned int i = 0; i < profiledFunctions_.size( ); i++ )
+    {
+        profiledFunctions_[ i ].cumulativeWallTime_ = 0.0;
+        profiledFunctions_[ i ].numberOfCalls_ = 0;
+    }
+}
+
+//! Function to set the statistics of all profiled functions to those recorded by another profiler.
+void PropagationProfiler::copyStatistics( const PropagationProfiler& otherProfiler )
+{
+    if( otherProfiler.profiledFunctions_.size( ) != profiledFunctions_.size( ) )
+    {
+        throw std::runtime_error( "Error when copying profiling statistics, profilers have different numbers of functions." );
+    }
+
+    for( unsigned int i = 0; i < profiledFunctions_.size( ); i++ )
+    {
+        if( otherProfiler.profiledFunctions_[ i ].functionType_ != profiledFunctions_[ i ].functionType_ ||
+                otherProfiler.profiledFunctions_[ i ].functionId_ != profiledFunctions_[ i ].functionId_ )
+        {
+            throw std::runtime_error( "Error when copying profiling statistics, profiled function " +
+                                      profiledFunctions_[ i ].functionId_ + " is inconsistent." );
+        }
+    }
+    profiledFunctions_ = otherProfiler.profiledFunctions_;
+}
+
+//! Function to retrieve the total wall time spent in all profiled functions of a given type.
+double PropagationProfiler::getCumulativeWallTime( const ProfiledFunctionType functionType ) const
+{
+    double cumulativeWallTime = 0.0;
+    for( unsigned int i = 0; i < profiledFunctions_.size( ); i++ )
+    {
+        if( profiledFunctions_.at( i ).functionType_ == functionType )
+        {
+            cumulativeWallTime += profiledFunctions_.at( i ).cumulativeWallTime_;
+        }
+    }
+    return cumulativeWallTime;
+}
+
+//! Function to retrieve the total number of calls to profiled functions of a given type.
+unsigned long long PropagationProfiler::getNumberOfCalls( const ProfiledFunctionType functionType ) const
+{
+    unsigned long long numberOfCalls = 0;
+    for( unsigned int i = 0; i < profiledFunctions_.size( ); i++ )
+    {
+        if( profiledFunctions_.at( i ).functionType_ == functionType )
+        {
+            numberOfCalls += profiledFunctions_.at( i ).numberOfCalls_;
+        }
+    }
+    return numberOfCalls;
+}
+
+//! Function to print the profiling report, sorted by decreasing cumulative wall time.
+void PropagationProfiler::printProfilingReport( std::ostream& outputStream ) const
+{
+    std::vector< ProfiledFunctionStatistics > sortedFunctions = profiledFunctions_;
+    std::stable_sort( sortedFunctions.begin( ), sortedFunctions.end( ),
+                      [ ]( const ProfiledFunctionStatistics& first, const ProfiledFunctionStatistics& second )
+    {
+        return first.cumulativeWallTime_ > second.cumulativeWallTime_;
+    } );
+
+    outputStream << "Wall time [s], Number of calls, Type, Function" << std::endl;
+    for( unsigned int i = 0; i < sortedFunctions.size( ); i++ )
+    {
+        outputStream << std::setprecision( 6 ) << sortedFunctions.at( i ).cumulativeWallTime_ << ", "
+                     << sortedFunctions.at( i ).numberOfCalls_ << ", "
+                     << getProfiledFunctionTypeName( sortedFunctions.at( i ).functionType_ ) << ", "
+                     << sortedFunctions.at( i ).functionId_ << std::endl;
+    }
+}
+
+} // namespace propagators
+
+} // namespace tudat
@@ -0,0 +1,192 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONPROFILER_H
+#define TUDAT_PROPAGATIONPROFILER_H
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Enum listing the types of functions of which the computation time can be profiled during a propagation.
+enum ProfiledFunctionType
+{
+    acceleration_model_profile = 0,
+    torque_model_profile = 1,
+    mass_rate_model_profile = 2,
+    environment_update_profile = 3,
+    dependent_variable_profile = 4
+};
+
+//! Function to get a string representing a profiled function type.
+/*!
+ * Function to get a string representing a profiled function type.
+ * \param functionType Type of profiled function.
+ * \return String with profiled function type.
+ */
+std::string getProfiledFunctionTypeName( const ProfiledFunctionType functionType );
+
+//! Computation time statistics of a single function, collected during a propagation.
+struct ProfiledFunctionStatistics
+{
+    //! Constructor
+    /*!
+     * Constructor, sets the identification of the function, and initializes the statistics to zero.
+     * \param functionType Type of profiled function.
+     * \param functionId Identifier of the profiled function (e.g. the names of the bodies involved and the model type).
+     */
+    ProfiledFunctionStatistics( const ProfiledFunctionType functionType, const std::string& functionId ):
+        functionType_( functionType ), functionId_( functionId ), cumulativeWallTime_( 0.0 ), numberOfCalls_( 0 ){ }
+
+    //! Type of profiled function.
+    ProfiledFunctionType functionType_;
+
+    //! Identifier of the profiled function.
+    std::string functionId_;
+
+    //! Total wall time (in seconds) spent in the function.
+    double cumulativeWallTime_;
+
+    //! Number of times the function was called.
+    unsigned long long numberOfCalls_;
+};
+
+//! Class used to collect the computation time spent in the individual models evaluated during a propagation.
+/*!
+ *  Class used to collect the computation time spent in the individual models evaluated during a propagation (acceleration,
+ *  torque and mass rate models, environment updates and dependent variables). Each function that is to be profiled is
+ *  registered once (addProfiledFunction) before the propagation, after which each call is recorded with
+ *  addFunctionCall. The classes evaluating the models only take the time of a call if a profiler has been provided to
+ *  them, so that there is no overhead if profiling is not used.
+ *
+ *  Functions must not be registered during a propagation. Calls to different functions may be recorded concurrently
+ *  (as is done when evaluating acceleration models in parallel), but calls to a single function may not.
+ */
+class PropagationProfiler
+{
+public:
+
+    //! Clock used to measure the computation time.
+    typedef std::chrono::steady_clock ClockType;
+
+    //! Constructor
+    PropagationProfiler( ){ }
+
+    //! Function to register a function of which the computation time is to be profiled.
+    /*!
+     * Function to register a function of which the computation time is to be profiled.
+     * \param functionType Type of profiled function.
+     * \param functionId Identifier of the profiled function.
+     * \return Index of the function, to be used as input to addFunctionCall.
+     */
+    unsigned int addProfiledFunction( const ProfiledFunctionType functionType, const std::string& functionId );
+
+    //! Function to record a single call to a profiled function, which was started at the given time and has just finished.
+    /*!
+     * Function to record a single call to a profiled function, which was started at the given time and has just finished.
+     * \param functionIndex Index of the profiled function, as returned by addProfiledFunction.
+     * \param startTime Clock time at which the call to the function was started.
+     */
+    void addFunctionCall( const unsigned int functionIndex, const ClockType::time_point& startTime )
+    {
+        ProfiledFunctionStatistics& currentStatistics = profiledFunctions_[ functionIndex ];
+        currentStatistics.cumulativeWallTime_ +=
+                std::chrono::duration< double >( ClockType::now( ) - startTime ).count( );
+        currentStatistics.numberOfCalls_++;
+    }
+
+    //! Function to create a function that is identical to the input function, but which records its computation time.
+    /*!
+     * Function to create a function that is identical to the input function, but which records its computation time in
+     * this object. The function is registered as a profiled function by this function.
+     * \param functionType Type of profiled function.
+     * \param functionId Identifier of the profiled function.
+     * \param functionToProfile Function of which the computation time is to be recorded
+     * \return Function that evaluates functionToProfile, and records its computation time
+     */
+    template< typename ReturnType >
+    std::function< ReturnType( ) > createProfiledFunction(
+            const ProfiledFunctionType functionType, const std::string& functionId,
+            const std::function< ReturnType( ) >& functionToProfile )
+    {
+        unsigned int functionIndex = addProfiledFunction( functionType, functionId );
+        return [ this, functionIndex, functionToProfile ]( )
+        {
+            ClockType::time_point startTime = ClockType::now( );
+            ReturnType returnValue = functionToProfile( );
+            addFunctionCall( functionIndex, startTime );
+            return returnValue;
+        };
+    }
+
+    //! Function to reset the statistics of all profiled functions to zero (retaining the registered functions).
+    void resetStatistics( );
+
+    //! Function to set the statistics of all profiled functions to those recorded by another profiler.
+    /*!
+     * Function to set the statistics of all profiled functions to those recorded by another profiler, in which the same
+     * functions must have been registered (e.g. the profiler of a simulator of the same dynamics on another thread).
+     * \param otherProfiler Profiler from which the statistics are to be copied.
+     */
+    void copyStatistics( const PropagationProfiler& otherProfiler );
+
+    //! Function to retrieve the statistics of all profiled functions, in the order in which they were registered.
+    /*!
+     * Function to retrieve the statistics of all profiled functions, in the order in which they were registered.
+     * \return Statistics of all profiled functions.
+     */
+    const std::vector< ProfiledFunctionStatistics >& getProfilingReport( ) const
+    {
+        return profiledFunctions_;
+    }
+
+    //! Function to retrieve the total wall time spent in all profiled functions of a given type.
+    /*!
+     * Function to retrieve the total wall time spent in all profiled functions of a given type.
+     * \param functionType Type of profiled function.
+     * \return Total wall time (in seconds) spent in all profiled functions of the given type.
+     */
+    double getCumulativeWallTime( const ProfiledFunctionType functionType ) const;
+
+    //! Function to retrieve the total number of calls to profiled functions of a given type.
+    /*!
+     * Function to retrieve the total number of calls to profiled functions of a given type.
+     * \param functionType Type of profiled function.
+     * \return Total number of calls to profiled functions of the given type.
+     */
+    unsigned long long getNumberOfCalls( const ProfiledFunctionType functionType ) const;
+
+    //! Function to print the profiling report, sorted by decreasing cumulative wall time.
+    /*!
+     * Function to print the profiling report, sorted by decreasing cumulative wall time.
+     * \param outputStream Stream to which the report is to be written.
+     */
+    void printProfilingReport( std::ostream& outputStream = std::cout ) const;
+
+private:
+
+    //! Statistics of all profiled functions, in the order in which they were registered.
+    std::vector< ProfiledFunctionStatistics > profiledFunctions_;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONPROFILER_H
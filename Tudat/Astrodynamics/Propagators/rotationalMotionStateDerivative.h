@@ -20,6 +20,7 @@
 #include <functional>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/torqueModel.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/torqueModelTypes.h"
 
 #include "Tudat/Astrodynamics/Propagators/singleStateTypeDerivative.h"
 #include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
@@ -175,6 +176,7 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
+        unsigned int currentTorqueIndex = 0;
         for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
              torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
         {
@@ -183,7 +185,57 @@ public:
             {
                 for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
                 {
-                    innerTorqueIterator->second[ j ]->updateMembers( currentTime );
+                    if( propagationProfiler_ == nullptr )
+                    {
+                        innerTorqueIterator->second[ j ]->updateMembers( currentTime );
+                    }
+                    else
+                    {
+                        PropagationProfiler::ClockType::time_point startTime = PropagationProfiler::ClockType::now( );
+                        innerTorqueIterator->second[ j ]->updateMembers( currentTime );
+                        propagationProfiler_->addFunctionCall(
+                                    profiledTorqueModelIndices_[ currentTorqueIndex ], startTime );
+                        currentTorqueIndex++;
+                    }
+                }
+            }
+        }
+    }
+
+    //! Function to set the object used to profile the computation time of the torque models.
+    /*!
+     * Function to set the object used to profile the computation time of the torque models. Each torque model
+     * is registered with the profiler by this function, identified by its type and the bodies exerting and undergoing it.
+     * \param profiler Object used to profile the computation time of the models (nullptr to stop profiling).
+     */
+    void setPropagationProfiler( const std::shared_ptr< PropagationProfiler > profiler )
+    {
+        propagationProfiler_ = profiler;
+        profiledTorqueModelIndices_.clear( );
+        if( propagationProfiler_ != nullptr )
+        {
+            for( torqueModelMapIterator = torqueModelsPerBody_.begin( );
+                 torqueModelMapIterator != torqueModelsPerBody_.end( ); torqueModelMapIterator++ )
+            {
+                for( innerTorqueIterator = torqueModelMapIterator->second.begin( ); innerTorqueIterator !=
+                     torqueModelMapIterator->second.end( ); innerTorqueIterator++ )
+                {
+                    for( unsigned int j = 0; j < innerTorqueIterator->second.size( ); j++ )
+                    {
+                        std::string torqueName = "custom torque";
+                        try
+                        {
+                            torqueName = basic_astrodynamics::getTorqueModelName(
+                                        basic_astrodynamics::getTorqueModelType( innerTorqueIterator->second[ j ] ) );
+                            torqueName.erase( torqueName.find_last_not_of( ' ' ) + 1 );
+                        }
+                        catch( const std::runtime_error& ){ }
+
+                        profiledTorqueModelIndices_.push_back(
+                                    propagationProfiler_->addProfiledFunction(
+                                        torque_model_profile, torqueName + " of " + innerTorqueIterator->first +
+                                        " on " + torqueModelMapIterator->first ) );
+                    }
                 }
             }
         }
@@ -354,6 +406,12 @@ protected:
     //! Predefined iterator to save (de-)allocation time.
     basic_astrodynamics::SingleBodyTorqueModelMap::iterator innerTorqueIterator;
 
+    //! Object used to profile the computation time of the torque models (nullptr if not profiled).
+    std::shared_ptr< PropagationProfiler > propagationProfiler_;
+
+    //! Index in propagationProfiler_ of each torque model, in the order in which they are updated.
+    std::vector< unsigned int > profiledTorqueModelIndices_;
+
 };
 
 
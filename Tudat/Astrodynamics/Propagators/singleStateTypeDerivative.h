@@ -16,6 +16,7 @@
 #include <Eigen/Core>
 
 #include "Tudat/Basics/timeType.h"
+#include "Tudat/Astrodynamics/Propagators/propagationProfiler.h"
 #include <Tudat/Basics/utilityMacros.h>
 
 namespace tudat
@@ -123,6 +124,15 @@ public:
      */
     virtual void updateStateDerivativeModel( const TimeType currentTime ) = 0;
 
+    //! Function to set the object used to profile the computation time of the models used by this object.
+    /*!
+     * Function to set the object used to profile the computation time of the models (i.e. acceleration, torque, etc.
+     * models) used by this object. Each model is registered with the profiler by this function, and its computation time
+     * is recorded at each call of updateStateDerivativeModel. Default implementation is empty (no models are profiled).
+     * \param profiler Object used to profile the computation time of the models (nullptr to stop profiling).
+     */
+    virtual void setPropagationProfiler( const std::shared_ptr< PropagationProfiler > profiler ){ }
+
     //! Function to convert the propagator-specific form of the state to the conventional form in
     //! the global frame.
     /*!
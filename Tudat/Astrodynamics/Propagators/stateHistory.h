@@ -0,0 +1,781 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_STATEHISTORY_H
+#define TUDAT_STATEHISTORY_H
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Traits class defining how a single entry of a StateHistory is stored, for Eigen matrix (or vector) entries.
+template< typename StateType >
+struct StateHistoryEntryTraits
+{
+    //! Type of the scalars of which an entry consists.
+    typedef typename StateType::Scalar ScalarType;
+
+    //! Type through which an entry is (read-only) accessed, without copying it out of the history.
+    typedef Eigen::Map< const StateType > ConstReferenceType;
+
+    //! Type through which an entry is (writably) accessed, without copying it out of the history.
+    typedef Eigen::Map< StateType > ReferenceType;
+
+    //! Function to retrieve the number of rows of an entry.
+    static int getNumberOfRows( const StateType& state ){ return state.rows( ); }
+
+    //! Function to retrieve the number of columns of an entry.
+    static int getNumberOfColumns( const StateType& state ){ return state.cols( ); }
+
+    //! Function to copy an entry into contiguous (column-major) memory.
+    static void copyToBuffer( const StateType& state, ScalarType* buffer )
+    {
+        Eigen::Map< StateType >( buffer, state.rows( ), state.cols( ) ) = state;
+    }
+
+    //! Function to create a read-only view of an entry stored in contiguous memory.
+    static ConstReferenceType getConstReference( const ScalarType* buffer, const int rows, const int columns )
+    {
+        return ConstReferenceType( buffer, rows, columns );
+    }
+
+    //! Function to create a writable view of an entry stored in contiguous memory.
+    static ReferenceType getReference( ScalarType* buffer, const int rows, const int columns )
+    {
+        return ReferenceType( buffer, rows, columns );
+    }
+};
+
+//! Traits class defining how a single entry of a StateHistory is stored, for scalar entries.
+template< typename ScalarStateType >
+struct StateHistoryScalarEntryTraits
+{
+    typedef ScalarStateType ScalarType;
+
+    typedef const ScalarStateType& ConstReferenceType;
+
+    typedef ScalarStateType& ReferenceType;
+
+    static int getNumberOfRows( const ScalarStateType ){ return 1; }
+
+    static int getNumberOfColumns( const ScalarStateType ){ return 1; }
+
+    static void copyToBuffer( const ScalarStateType state, ScalarType* buffer ){ *buffer = state; }
+
+    static ConstReferenceType getConstReference( const ScalarType* buffer, const int, const int ){ return *buffer; }
+
+    static ReferenceType getReference( ScalarType* buffer, const int, const int ){ return *buffer; }
+};
+
+//! Traits class defining how a single entry of a StateHistory is stored, for double entries.
+template< >
+struct StateHistoryEntryTraits< double >: public StateHistoryScalarEntryTraits< double > { };
+
+//! Traits class defining how a single entry of a StateHistory is stored, for long double entries.
+template< >
+struct StateHistoryEntryTraits< long double >: public StateHistoryScalarEntryTraits< long double > { };
+
+//! Class for storing the time history of a (vector, matrix or scalar) quantity in contiguous memory.
+/*!
+ *  Class for storing the time history of a (vector, matrix or scalar) quantity in contiguous memory, as an alternative to a
+ *  std::map< TimeType, StateType >, which requires a tree node and (for Eigen types) a separate heap allocation for each
+ *  entry. The epochs are stored in a single buffer, and the entries are stored in a single column-major buffer (with the
+ *  entry at each epoch occupying a single contiguous block of rows x columns scalars). All entries must have the same size,
+ *  which is set by the first entry that is added to the history.
+ *
+ *  The entries are always stored in ascending order of time. Appending entries at the end (forward propagation) or the
+ *  start (backward propagation) of the history is done in amortized constant time. Memory freed by removing entries from
+ *  the other end (e.g. when streaming propagation results) is reused, so that the memory use is bounded by (a multiple
+ *  of) the maximum number of entries. Inserting entries at other epochs is supported, but requires the subsequent entries
+ *  to be moved.
+ *
+ *  The class provides a subset of the std::map interface (iteration in ascending order of time with ->first/->second,
+ *  find, count, at, lower_bound, operator[], erase, clear, size), so that it can be used as a drop-in replacement for the
+ *  map in most algorithms. The entries are accessed through Eigen::Map objects (or references for scalar entries), so that
+ *  no data is copied when accessing them. The full history can be retrieved (without copying) as a single matrix, for
+ *  instance to pass it to output routines, or converted to a std::map or to a pair of vectors (e.g. to create an
+ *  interpolator).
+ */
+template< typename TimeType, typename StateType >
+class StateHistory
+{
+public:
+
+    //! Typedef for traits of history entries
+    typedef StateHistoryEntryTraits< StateType > EntryTraits;
+
+    //! Typedef for scalars of which entries consist.
+    typedef typename EntryTraits::ScalarType ScalarType;
+
+    //! Typedef for object through which entries are read.
+    typedef typename EntryTraits::ConstReferenceType ConstReferenceType;
+
+    //! Typedef for object through which entries are modified.
+    typedef typename EntryTraits::ReferenceType ReferenceType;
+
+    //! Typedef for (read-only) view of the full history, with one column per epoch.
+    typedef Eigen::Map< const Eigen::Matrix< ScalarType, Eigen::Dynamic, Eigen::Dynamic > > ConstStateBlockType;
+
+    //! Typedef for pair of time and entry, as returned when dereferencing an iterator.
+    typedef std::pair< TimeType, ConstReferenceType > value_type;
+
+    //! Iterator over entries of the history, ordered by time.
+    /*!
+     *  Iterator over entries of the history, ordered by time. Dereferencing returns (by value) a pair of the time and an
+     *  object providing read-only access to the entry, without copying it. The iterator is invalidated when an entry is
+     *  added to or removed from the history.
+     */
+    class const_iterator
+    {
+    public:
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename StateHistory::value_type value_type;
+        typedef int difference_type;
+        typedef value_type reference;
+
+        //! Helper class, allowing -> to be used on the iterator, even though dereferencing it returns by value.
+        class pointer
+        {
+        public:
+            pointer( const value_type& value ): value_( value ){ }
+
+            const value_type* operator->( ) const { return &value_; }
+
+        private:
+            value_type value_;
+        };
+
+        const_iterator( ): history_( nullptr ), index_( 0 ){ }
+
+        const_iterator( const StateHistory* history, const int index ): history_( history ), index_( index ){ }
+
+        value_type operator*( ) const
+        {
+            return value_type( history_->getTime( index_ ), history_->getState( index_ ) );
+        }
+
+        pointer operator->( ) const
+        {
+            return pointer( **this );
+        }
+
+        value_type operator[]( const difference_type offset ) const
+        {
+            return *( *this + offset );
+        }
+
+        const_iterator& operator++( ){ index_++; return *this; }
+        const_iterator operator++( int ){ const_iterator previous = *this; index_++; return previous; }
+        const_iterator& operator--( ){ index_--; return *this; }
+        const_iterator operator--( int ){ const_iterator previous = *this; index_--; return previous; }
+        const_iterator& operator+=( const difference_type offset ){ index_ += offset; return *this; }
+        const_iterator& operator-=( const difference_type offset ){ index_ -= offset; return *this; }
+        const_iterator operator+( const difference_type offset ) const { return const_iterator( history_, index_ + offset ); }
+        const_iterator operator-( const difference_type offset ) const { return const_iterator( history_, index_ - offset ); }
+        difference_type operator-( const const_iterator& other ) const { return index_ - other.index_; }
+
+        bool operator==( const const_iterator& other ) const { return index_ == other.index_ && history_ == other.history_; }
+        bool operator!=( const const_iterator& other ) const { return !( *this == other ); }
+        bool operator<( const const_iterator& other ) const { return index_ < other.index_; }
+        bool operator>( const const_iterator& other ) const { return index_ > other.index_; }
+        bool operator<=( const const_iterator& other ) const { return index_ <= other.index_; }
+        bool operator>=( const const_iterator& other ) const { return index_ >= other.index_; }
+
+        //! Function to retrieve the index (in order of time) of the entry to which the iterator points.
+        int getIndex( ) const { return index_; }
+
+    private:
+
+        //! History over which the iterator iterates
+        const StateHistory* history_;
+
+        //! Index (in order of time) of the entry to which the iterator points.
+        int index_;
+    };
+
+    //! Typedef for iterator (entries can only be modified through operator[] or insert).
+    typedef const_iterator iterator;
+
+    //! Iterator over entries of the history, in reverse order of time.
+    /*!
+     *  Iterator over entries of the history, in reverse order of time (defined separately from std::reverse_iterator, which
+     *  does not support operator-> for iterators that are dereferenced by value in all standard library versions).
+     */
+    class const_reverse_iterator
+    {
+    public:
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename const_iterator::value_type value_type;
+        typedef typename const_iterator::difference_type difference_type;
+        typedef typename const_iterator::reference reference;
+        typedef typename const_iterator::pointer pointer;
+
+        const_reverse_iterator( ){ }
+
+        explicit const_reverse_iterator( const const_iterator& baseIterator ): baseIterator_( baseIterator ){ }
+
+        value_type operator*( ) const { return *( baseIterator_ - 1 ); }
+
+        pointer operator->( ) const { return ( baseIterator_ - 1 ).operator->( ); }
+
+        const_reverse_iterator& operator++( ){ --baseIterator_; return *this; }
+        const_reverse_iterator operator++( int ){ const_reverse_iterator previous = *this; --baseIterator_; return previous; }
+        const_reverse_iterator& operator--( ){ ++baseIterator_; return *this; }
+        const_reverse_iterator operator--( int ){ const_reverse_iterator previous = *this; ++baseIterator_; return previous; }
+        const_reverse_iterator operator+( const difference_type offset ) const
+        {
+            return const_reverse_iterator( baseIterator_ - offset );
+        }
+        const_reverse_iterator operator-( const difference_type offset ) const
+        {
+            return const_reverse_iterator( baseIterator_ + offset );
+        }
+        difference_type operator-( const const_reverse_iterator& other ) const { return other.baseIterator_ - baseIterator_; }
+
+        bool operator==( const const_reverse_iterator& other ) const { return baseIterator_ == other.baseIterator_; }
+        bool operator!=( const const_reverse_iterator& other ) const { return baseIterator_ != other.baseIterator_; }
+
+        //! Function to retrieve the forward iterator pointing to the entry after the one pointed to by this iterator.
+        const_iterator base( ) const { return baseIterator_; }
+
+    private:
+
+        //! Forward iterator pointing to the entry after the one pointed to by this iterator.
+        const_iterator baseIterator_;
+    };
+
+    //! Typedef for reverse iterator.
+    typedef const_reverse_iterator reverse_iterator;
+
+    //! Helper class returned by non-const operator[], to allow entries to be set with map-like syntax.
+    class EntrySetter
+    {
+    public:
+
+        EntrySetter( StateHistory* history, const TimeType& time ): history_( history ), time_( time ){ }
+
+        //! Function to set the entry at the epoch of this object
+        EntrySetter& operator=( const StateType& state )
+        {
+            history_->insert( time_, state );
+            return *this;
+        }
+
+        //! Function to set the entry at the epoch of this object, from a type that can be converted to StateType
+        template< typename InputStateType >
+        EntrySetter& operator=( const InputStateType& state )
+        {
+            history_->insert( time_, StateType( state ) );
+            return *this;
+        }
+
+        //! Function to retrieve the entry at the epoch of this object (throws if it does not exist)
+        operator StateType( ) const
+        {
+            return StateType( history_->at( time_ ) );
+        }
+
+    private:
+
+        StateHistory* history_;
+
+        TimeType time_;
+    };
+
+    //! Constructor, creates an empty history
+    StateHistory( ):
+        firstIndex_( 0 ), numberOfEntries_( 0 ), numberOfRows_( 0 ), numberOfColumns_( 0 ){ }
+
+    //! Constructor, creates a history from the contents of a map.
+    /*!
+     *  Constructor, creates a history from the contents of a map.
+     *  \param stateMap Map from which history is to be created (time as key)
+     */
+    StateHistory( const std::map< TimeType, StateType >& stateMap ):
+        firstIndex_( 0 ), numberOfEntries_( 0 ), numberOfRows_( 0 ), numberOfColumns_( 0 )
+    {
+        reserve( stateMap.size( ) );
+        for( auto mapIterator : stateMap )
+        {
+            insert( mapIterator.first, mapIterator.second );
+        }
+    }
+
+    //! Function to retrieve the number of epochs in the history
+    unsigned int size( ) const { return numberOfEntries_; }
+
+    //! Function to check whether the history is empty
+    bool empty( ) const { return numberOfEntries_ == 0; }
+
+    //! Function to retrieve the number of rows of each entry (0 if the history has never contained an entry)
+    int getNumberOfRows( ) const { return numberOfRows_; }
+
+    //! Function to retrieve the number of columns of each entry (0 if the history has never contained an entry)
+    int getNumberOfColumns( ) const { return numberOfColumns_; }
+
+    //! Function to remove all entries from the history (memory is retained for subsequent use).
+    /*!
+     *  Function to remove all entries from the history. The memory that was allocated is retained, so that reusing the
+     *  object (e.g. for repeated propagations) does not require new allocations. The size of the entries is reset, so that
+     *  entries of a different size may be added after calling this function.
+     */
+    void clear( )
+    {
+        firstIndex_ = 0;
+        numberOfEntries_ = 0;
+        numberOfRows_ = 0;
+        numberOfColumns_ = 0;
+    }
+
+    //! Function to exchange the contents (and allocated memory) of this history with those of another history.
+    /*!
+     *  Function to exchange the contents (and allocated memory) of this history with those of another history, without
+     *  copying any entries (e.g. to hand over the results of a propagation to another object).
+     *  \param otherHistory History with which the contents are to be exchanged.
+     */
+    void swap( StateHistory& otherHistory )
+    {
+        timeBuffer_.swap( otherHistory.timeBuffer_ );
+        dataBuffer_.swap( otherHistory.dataBuffer_ );
+        std::swap( firstIndex_, otherHistory.firstIndex_ );
+        std::swap( numberOfEntries_, otherHistory.numberOfEntries_ );
+        std::swap( numberOfRows_, otherHistory.numberOfRows_ );
+        std::swap( numberOfColumns_, otherHistory.numberOfColumns_ );
+    }
+
+    //! Function to release all memory allocated by this object.
+    void shrinkToFit( )
+    {
+        reallocate( numberOfEntries_, 0 );
+    }
+
+    //! Function to reserve memory for a given number of epochs, avoiding reallocation while the history grows to that size
+    /*!
+     *  Function to reserve memory for a given number of epochs, avoiding reallocation while the history grows to that size
+     *  (by appending entries). Memory for the entries themselves can only be reserved once the entry size is known.
+     *  \param numberOfEpochs Number of epochs for which memory is to be reserved.
+     */
+    void reserve( const unsigned int numberOfEpochs )
+    {
+        if( static_cast< int >( numberOfEpochs ) > getCapacity( ) - firstIndex_ )
+        {
+            reallocate( numberOfEpochs, firstIndex_ );
+        }
+    }
+
+    //! Function to set the entry at a given time (replacing existing entry at this time, if any).
+    /*!
+     *  Function to set the entry at a given time (replacing existing entry at this time, if any).
+     *  \param time Time at which entry is to be set.
+     *  \param state Entry that is to be set. Must be of the same size as existing entries.
+     */
+    void insert( const TimeType& time, const StateType& state )
+    {
+        if( numberOfEntries_ == 0 )
+        {
+            numberOfRows_ = EntryTraits::getNumberOfRows( state );
+            numberOfColumns_ = EntryTraits::getNumberOfColumns( state );
+            if( getEntrySize( ) == 0 )
+            {
+                throw std::runtime_error( "Error when adding entry to state history, entry is empty." );
+            }
+            if( static_cast< int >( dataBuffer_.size( ) ) < getCapacity( ) * getEntrySize( ) )
+            {
+                dataBuffer_.resize( getCapacity( ) * getEntrySize( ) );
+            }
+        }
+        else if( EntryTraits::getNumberOfRows( state ) != numberOfRows_ ||
+                 EntryTraits::getNumberOfColumns( state ) != numberOfColumns_ )
+        {
+            throw std::runtime_error( "Error when adding entry to state history, entry size is inconsistent." );
+        }
+
+        int storageIndex;
+        if( numberOfEntries_ == 0 || getTime( numberOfEntries_ - 1 ) < time )
+        {
+            // Append entry at end
+            prepareForEntryAtEnd( );
+            storageIndex = firstIndex_ + numberOfEntries_;
+            numberOfEntries_++;
+        }
+        else if( time < getTime( 0 ) )
+        {
+            // Prepend entry at start, reserving free space in front of the data if needed
+            if( firstIndex_ == 0 )
+            {
+                // Move entries to end of buffers if at least half of the memory is unused after them (e.g. when the
+                // history is streamed backwards in time, with old entries removed from the end), reallocate otherwise
+                const int numberOfUnusedEpochs = getCapacity( ) - static_cast< int >( numberOfEntries_ );
+                if( numberOfUnusedEpochs > 0 && 2 * numberOfUnusedEpochs >= getCapacity( ) )
+                {
+                    moveEntries( numberOfUnusedEpochs );
+                }
+                else
+                {
+                    reallocate( 2 * numberOfEntries_ + 1, numberOfEntries_ + 1 );
+                }
+            }
+            firstIndex_--;
+            numberOfEntries_++;
+            storageIndex = firstIndex_;
+        }
+        else
+        {
+            int index = getLowerBoundIndex( time );
+            if( getTime( index ) == time )
+            {
+                // Replace existing entry
+                storageIndex = firstIndex_ + index;
+            }
+            else
+            {
+                // Insert entry in the middle, moving subsequent entries
+                prepareForEntryAtEnd( );
+                storageIndex = firstIndex_ + index;
+                std::move_backward( timeBuffer_.begin( ) + storageIndex, timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_,
+                                    timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_ + 1 );
+                std::move_backward( dataBuffer_.begin( ) + storageIndex * getEntrySize( ),
+                                    dataBuffer_.begin( ) + ( firstIndex_ + numberOfEntries_ ) * getEntrySize( ),
+                                    dataBuffer_.begin( ) + ( firstIndex_ + numberOfEntries_ + 1 ) * getEntrySize( ) );
+                numberOfEntries_++;
+            }
+        }
+
+        timeBuffer_[ storageIndex ] = time;
+        EntryTraits::copyToBuffer( state, dataBuffer_.data( ) + storageIndex * getEntrySize( ) );
+    }
+
+    //! Function to set an entry, using map-like syntax (e.g. history[ time ] = state).
+    EntrySetter operator[]( const TimeType& time )
+    {
+        return EntrySetter( this, time );
+    }
+
+    //! Function to remove the entry to which an iterator points.
+    /*!
+     *  Function to remove the entry to which an iterator points. Removing the first or last entry is done in constant time.
+     *  \param entryIterator Iterator pointing to entry that is to be removed.
+     *  \return Iterator to the entry after the removed entry.
+     */
+    const_iterator erase( const const_iterator& entryIterator )
+    {
+        int index = entryIterator.getIndex( );
+        if( index < 0 || index >= static_cast< int >( numberOfEntries_ ) )
+        {
+            throw std::runtime_error( "Error when removing entry from state history, iterator is out of range." );
+        }
+
+        if( index == 0 )
+        {
+            firstIndex_++;
+        }
+        else if( index < static_cast< int >( numberOfEntries_ ) - 1 )
+        {
+            int storageIndex = firstIndex_ + index;
+            std::move( timeBuffer_.begin( ) + storageIndex + 1, timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_,
+                       timeBuffer_.begin( ) + storageIndex );
+            std::move( dataBuffer_.begin( ) + ( storageIndex + 1 ) * getEntrySize( ),
+                       dataBuffer_.begin( ) + ( firstIndex_ + numberOfEntries_ ) * getEntrySize( ),
+                       dataBuffer_.begin( ) + storageIndex * getEntrySize( ) );
+        }
+        numberOfEntries_--;
+
+        return const_iterator( this, index );
+    }
+
+    //! Function to remove the entry at a given time (if any)
+    /*!
+     *  Function to remove the entry at a given time (if any)
+     *  \param time Time of entry that is to be removed
+     *  \return Number of removed entries (0 or 1)
+     */
+    unsigned int erase( const TimeType& time )
+    {
+        const_iterator entryIterator = find( time );
+        if( entryIterator == end( ) )
+        {
+            return 0;
+        }
+        erase( entryIterator );
+        return 1;
+    }
+
+    //! Function to retrieve the time of the entry with given index (in order of time)
+    const TimeType& getTime( const int index ) const
+    {
+        return timeBuffer_[ firstIndex_ + index ];
+    }
+
+    //! Function to retrieve the entry with given index (in order of time), without copying it
+    ConstReferenceType getState( const int index ) const
+    {
+        return EntryTraits::getConstReference(
+                    dataBuffer_.data( ) + ( firstIndex_ + index ) * getEntrySize( ), numberOfRows_, numberOfColumns_ );
+    }
+
+    //! Function to retrieve the entry with given index (in order of time), allowing it to be modified in place
+    ReferenceType getState( const int index )
+    {
+        return EntryTraits::getReference(
+                    dataBuffer_.data( ) + ( firstIndex_ + index ) * getEntrySize( ), numberOfRows_, numberOfColumns_ );
+    }
+
+    //! Function to retrieve the entry at a given time (throws std::out_of_range if there is no such entry)
+    ConstReferenceType at( const TimeType& time ) const
+    {
+        const_iterator entryIterator = find( time );
+        if( entryIterator == end( ) )
+        {
+            throw std::out_of_range( "Error when retrieving entry from state history, no entry at requested time." );
+        }
+        return getState( entryIterator.getIndex( ) );
+    }
+
+    //! Function to retrieve an iterator to the entry at a given time (end() if there is no such entry)
+    const_iterator find( const TimeType& time ) const
+    {
+        int index = getLowerBoundIndex( time );
+        if( index < static_cast< int >( numberOfEntries_ ) && getTime( index ) == time )
+        {
+            return const_iterator( this, index );
+        }
+        return end( );
+    }
+
+    //! Function to retrieve the number of entries at a given time (0 or 1)
+    unsigned int count( const TimeType& time ) const
+    {
+        return ( find( time ) == end( ) ) ? 0 : 1;
+    }
+
+    //! Function to retrieve an iterator to the first entry at or after a given time
+    const_iterator lower_bound( const TimeType& time ) const
+    {
+        return const_iterator( this, getLowerBoundIndex( time ) );
+    }
+
+    //! Function to retrieve an iterator to the first entry after a given time
+    const_iterator upper_bound( const TimeType& time ) const
+    {
+        return const_iterator(
+                    this, std::upper_bound( timeBuffer_.begin( ) + firstIndex_,
+                                            timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_, time ) -
+                    ( timeBuffer_.begin( ) + firstIndex_ ) );
+    }
+
+    const_iterator begin( ) const { return const_iterator( this, 0 ); }
+
+    const_iterator end( ) const { return const_iterator( this, numberOfEntries_ ); }
+
+    const_reverse_iterator rbegin( ) const { return const_reverse_iterator( end( ) ); }
+
+    const_reverse_iterator rend( ) const { return const_reverse_iterator( begin( ) ); }
+
+    //! Function to retrieve a pointer to the (contiguous) times of all entries, in ascending order.
+    const TimeType* getTimesData( ) const
+    {
+        return timeBuffer_.data( ) + firstIndex_;
+    }
+
+    //! Function to retrieve a pointer to the (contiguous, column-major) data of all entries, in ascending order of time.
+    const ScalarType* getStatesData( ) const
+    {
+        return dataBuffer_.data( ) + firstIndex_ * getEntrySize( );
+    }
+
+    //! Function to retrieve a view of the full history, without copying it.
+    /*!
+     *  Function to retrieve a view of the full history, without copying it, as a matrix with one column per epoch (in
+     *  ascending order of time). Each column contains the (column-major) data of the entry at that epoch.
+     *  \return View of the full history.
+     */
+    ConstStateBlockType getStateBlock( ) const
+    {
+        return ConstStateBlockType( getStatesData( ), getEntrySize( ), numberOfEntries_ );
+    }
+
+    //! Function to retrieve the times of all entries as a vector (e.g. for creating an interpolator)
+    std::vector< TimeType > getTimeVector( ) const
+    {
+        return std::vector< TimeType >( getTimesData( ), getTimesData( ) + numberOfEntries_ );
+    }
+
+    //! Function to retrieve all entries as a vector (e.g. for creating an interpolator)
+    std::vector< StateType > getStateVector( ) const
+    {
+        std::vector< StateType > stateVector;
+        stateVector.reserve( numberOfEntries_ );
+        for( unsigned int i = 0; i < numberOfEntries_; i++ )
+        {
+            stateVector.push_back( StateType( getState( i ) ) );
+        }
+        return stateVector;
+    }
+
+    //! Function to convert the history to a map.
+    std::map< TimeType, StateType > toMap( ) const
+    {
+        std::map< TimeType, StateType > stateMap;
+        for( unsigned int i = 0; i < numberOfEntries_; i++ )
+        {
+            stateMap.emplace_hint( stateMap.end( ), getTime( i ), StateType( getState( i ) ) );
+        }
+        return stateMap;
+    }
+
+    //! Conversion operator to map, to allow the history to be passed to functions requiring a map.
+    operator std::map< TimeType, StateType >( ) const
+    {
+        return toMap( );
+    }
+
+    //! Function to retrieve the number of epochs for which memory is allocated.
+    /*!
+     *  Function to retrieve the number of epochs for which memory is allocated, which may exceed the number of entries.
+     *  Memory that is freed by removing entries from the start or end of the history is reused when adding entries
+     *  at the other end, so that the capacity remains bounded when entries are continuously added and removed (e.g.
+     *  when streaming propagation results).
+     *  \return Number of epochs for which memory is allocated.
+     */
+    int getCapacity( ) const
+    {
+        return timeBuffer_.size( );
+    }
+
+private:
+
+    //! Function to retrieve number of scalars in a single entry.
+    int getEntrySize( ) const
+    {
+        return numberOfRows_ * numberOfColumns_;
+    }
+
+    //! Function to retrieve the index of the first entry at or after a given time
+    int getLowerBoundIndex( const TimeType& time ) const
+    {
+        return std::lower_bound( timeBuffer_.begin( ) + firstIndex_,
+                                 timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_, time ) -
+                ( timeBuffer_.begin( ) + firstIndex_ );
+    }
+
+    //! Function to ensure that memory is available for an entry after the last entry.
+    /*!
+     *  Function to ensure that memory is available for an entry after the last entry. If the end of the buffers is reached,
+     *  the entries are moved to the start of the buffers if at least half of the memory is unused in front of them (e.g.
+     *  when the history is streamed, with old entries removed from the start), and the memory is reallocated otherwise.
+     *  In both cases, the amortized cost of adding an entry is constant.
+     */
+    void prepareForEntryAtEnd( )
+    {
+        if( firstIndex_ + static_cast< int >( numberOfEntries_ ) == getCapacity( ) )
+        {
+            if( firstIndex_ > 0 && 2 * firstIndex_ >= getCapacity( ) )
+            {
+                moveEntries( 0 );
+            }
+            else
+            {
+                reallocate( 2 * numberOfEntries_ + 1, firstIndex_ );
+            }
+        }
+    }
+
+    //! Function to move the current entries to a new location in the existing buffers (without reallocating memory).
+    /*!
+     *  Function to move the current entries to a new location in the existing buffers (without reallocating memory).
+     *  \param newFirstIndex Index in the buffers at which the first entry is to be stored (entries must fit in buffers).
+     */
+    void moveEntries( const int newFirstIndex )
+    {
+        const int entrySize = getEntrySize( );
+        const int lastIndex = firstIndex_ + static_cast< int >( numberOfEntries_ );
+        if( newFirstIndex < firstIndex_ )
+        {
+            std::copy( timeBuffer_.begin( ) + firstIndex_, timeBuffer_.begin( ) + lastIndex,
+                       timeBuffer_.begin( ) + newFirstIndex );
+            std::copy( dataBuffer_.begin( ) + firstIndex_ * entrySize, dataBuffer_.begin( ) + lastIndex * entrySize,
+                       dataBuffer_.begin( ) + newFirstIndex * entrySize );
+        }
+        else if( newFirstIndex > firstIndex_ )
+        {
+            const int newLastIndex = newFirstIndex + static_cast< int >( numberOfEntries_ );
+            std::copy_backward( timeBuffer_.begin( ) + firstIndex_, timeBuffer_.begin( ) + lastIndex,
+                                timeBuffer_.begin( ) + newLastIndex );
+            std::copy_backward( dataBuffer_.begin( ) + firstIndex_ * entrySize, dataBuffer_.begin( ) + lastIndex * entrySize,
+                                dataBuffer_.begin( ) + newLastIndex * entrySize );
+        }
+        firstIndex_ = newFirstIndex;
+    }
+
+    //! Function to reallocate memory, moving the current entries to a new location in the buffers.
+    /*!
+     *  Function to reallocate memory, moving the current entries to a new location in the buffers.
+     *  \param minimumNumberOfEpochsAfterStart Minimum number of epochs for which memory is to be available, starting at
+     *  newFirstIndex
+     *  \param newFirstIndex Index in the new buffers at which the first entry is to be stored.
+     */
+    void reallocate( const int minimumNumberOfEpochsAfterStart, const int newFirstIndex )
+    {
+        int newCapacity = newFirstIndex + std::max( minimumNumberOfEpochsAfterStart, static_cast< int >( numberOfEntries_ ) );
+
+        std::vector< TimeType > newTimeBuffer( newCapacity );
+        std::vector< ScalarType > newDataBuffer( newCapacity * getEntrySize( ) );
+
+        std::copy( timeBuffer_.begin( ) + firstIndex_, timeBuffer_.begin( ) + firstIndex_ + numberOfEntries_,
+                   newTimeBuffer.begin( ) + newFirstIndex );
+        if( getEntrySize( ) > 0 )
+        {
+            std::copy( dataBuffer_.begin( ) + firstIndex_ * getEntrySize( ),
+                       dataBuffer_.begin( ) + ( firstIndex_ + numberOfEntries_ ) * getEntrySize( ),
+                       newDataBuffer.begin( ) + newFirstIndex * getEntrySize( ) );
+        }
+
+        timeBuffer_.swap( newTimeBuffer );
+        dataBuffer_.swap( newDataBuffer );
+        firstIndex_ = newFirstIndex;
+    }
+
+    //! Buffer containing the times of the entries (valid from firstIndex_ to firstIndex_ + numberOfEntries_).
+    std::vector< TimeType > timeBuffer_;
+
+    //! Buffer containing the data of the entries, with each entry occupying numberOfRows_ x numberOfColumns_ scalars.
+    std::vector< ScalarType > dataBuffer_;
+
+    //! Index (in buffers) of first entry
+    int firstIndex_;
+
+    //! Number of entries in history
+    unsigned int numberOfEntries_;
+
+    //! Number of rows of each entry
+    int numberOfRows_;
+
+    //! Number of columns of each entry
+    int numberOfColumns_;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_STATEHISTORY_H
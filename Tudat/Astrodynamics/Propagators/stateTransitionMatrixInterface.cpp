@@ -11,6 +11,7 @@
 #include <boost/make_shared.hpp>
 
 #include "Tudat/Astrodynamics/Propagators/stateTransitionMatrixInterface.h"
+#include "Tudat/Mathematics/Interpolators/chebyshevMatrixInterpolator.h"
 
 namespace tudat
 {
@@ -18,6 +19,24 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to interpolate a state transition or sensitivity matrix into a block of a (preallocated) matrix.
+void interpolateMatrixIntoBlock(
+        const std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >& matrixInterpolator,
+        const double evaluationTime,
+        Eigen::Block< Eigen::MatrixXd > matrixBlock )
+{
+    interpolators::ChebyshevMatrixInterpolator* chebyshevInterpolator =
+            dynamic_cast< interpolators::ChebyshevMatrixInterpolator* >( matrixInterpolator.get( ) );
+    if( chebyshevInterpolator != nullptr )
+    {
+        chebyshevInterpolator->interpolate( evaluationTime, matrixBlock );
+    }
+    else
+    {
+        matrixBlock = matrixInterpolator->interpolate( evaluationTime );
+    }
+}
+
 //! Function to reset the state transition and sensitivity matrix interpolators
 void SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::updateMatrixInterpolators(
         const std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >
@@ -39,13 +58,16 @@ Eigen::MatrixXd SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::g
 
 
     // Set Phi and S matrices.
-    combinedStateTransitionMatrix_.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
-            stateTransitionMatrixInterpolator_->interpolate( evaluationTime );
+    interpolateMatrixIntoBlock(
+                stateTransitionMatrixInterpolator_, evaluationTime,
+                combinedStateTransitionMatrix_.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) );
 
     if( sensitivityMatrixSize_ > 0 )
     {
-        combinedStateTransitionMatrix_.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
-                sensitivityMatrixInterpolator_->interpolate( evaluationTime );
+        interpolateMatrixIntoBlock(
+                    sensitivityMatrixInterpolator_, evaluationTime,
+                    combinedStateTransitionMatrix_.block(
+                        0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) );
     }
 
     for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
@@ -140,10 +162,13 @@ Eigen::MatrixXd MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::ge
     // Set Phi and S matrices.
     if( currentArc >= 0 )
     {
-        combinedStateTransitionMatrix.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
-                stateTransitionMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
-        combinedStateTransitionMatrix.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
-                sensitivityMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+        interpolateMatrixIntoBlock(
+                    stateTransitionMatrixInterpolators_.at( currentArc ), evaluationTime,
+                    combinedStateTransitionMatrix.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) );
+        interpolateMatrixIntoBlock(
+                    sensitivityMatrixInterpolators_.at( currentArc ), evaluationTime,
+                    combinedStateTransitionMatrix.block(
+                        0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) );
 
         for( unsigned int i = 0; i < statePartialAdditionIndices_.at( currentArc ).size( ); i++ )
         {
@@ -180,9 +205,10 @@ Eigen::MatrixXd MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::ge
     // Set Phi and S matrices of current arc.
     if( currentArc >= 0 )
     {
-        fullCombinedStateTransitionMatrix.block(
-                    0, currentArc * stateTransitionMatrixSize_, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
-                stateTransitionMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+        interpolateMatrixIntoBlock(
+                    stateTransitionMatrixInterpolators_.at( currentArc ), evaluationTime,
+                    fullCombinedStateTransitionMatrix.block(
+                        0, currentArc * stateTransitionMatrixSize_, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) );
         fullCombinedStateTransitionMatrix.block(
                     0, numberOfStateArcs_ * stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
                 combinedStateTransitionMatrix.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ );
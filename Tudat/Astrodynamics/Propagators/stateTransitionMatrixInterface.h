@@ -26,6 +26,20 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to interpolate a state transition or sensitivity matrix into a block of a (preallocated) matrix.
+/*!
+ *  Function to interpolate a state transition or sensitivity matrix into a block of a (preallocated) matrix. For
+ *  interpolators that support it (i.e. interpolators::ChebyshevMatrixInterpolator), the result is written directly into
+ *  the block, without allocating memory for an intermediate matrix.
+ *  \param matrixInterpolator Interpolator for the matrix history.
+ *  \param evaluationTime Time at which the matrix is to be interpolated.
+ *  \param matrixBlock Block of matrix to which the interpolated matrix is written.
+ */
+void interpolateMatrixIntoBlock(
+        const std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >& matrixInterpolator,
+        const double evaluationTime,
+        Eigen::Block< Eigen::MatrixXd > matrixBlock );
+
 //! Base class for interface object of interpolation of numerically propagated state transition and sensitivity matrices.
 /*!
  *  Base class for interface object of interpolation of numerically propagated state transition and sensitivity matrices.
@@ -7,7 +7,9 @@
  *    a copy of the license with this file. If not, please or visit:
  *    http://tudat.tudelft.nl/LICENSE.
  */
+#include <algorithm>
 #include <map>
+#include <set>
 
 
 #include <functional>
@@ -26,6 +28,33 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to compute the product of the state partial matrix and a block of columns of the state transition matrix
+template< typename StateScalarType >
+void VariationalEquations::multiplyStatePartialMatrix(
+        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+        Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative,
+        const int startColumn, const int numberOfColumns )
+{
+    for( unsigned int i = 0; i < variationalMatrixBlocks_.size( ); i++ )
+    {
+        currentMatrixDerivative.block(
+                    stateBlockIndices_[ i ].first, startColumn, stateBlockIndices_[ i ].second, numberOfColumns ).setZero( );
+
+        // Add contribution of each non-zero block in current block row
+        for( auto blockIterator = variationalMatrixBlocks_[ i ].begin( );
+             blockIterator != variationalMatrixBlocks_[ i ].end( ); blockIterator++ )
+        {
+            currentMatrixDerivative.block(
+                        stateBlockIndices_[ i ].first, startColumn,
+                        stateBlockIndices_[ i ].second, numberOfColumns ).noalias( ) +=
+                    blockIterator->second.template cast< StateScalarType >( ) *
+                    stateTransitionAndSensitivityMatrices.block(
+                        stateBlockIndices_[ blockIterator->first ].first, startColumn,
+                        stateBlockIndices_[ blockIterator->first ].second, numberOfColumns );
+        }
+    }
+}
+
 template< typename StateScalarType >
 void VariationalEquations::getBodyInitialStatePartialMatrix(
         const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
@@ -34,35 +63,87 @@ void VariationalEquations::getBodyInitialStatePartialMatrix(
     setBodyStatePartialMatrix( );
 
     // Add partials of body positions and velocities.
-    currentMatrixDerivative.block( 0, 0, totalDynamicalStateSize_, numberOfParameterValues_ ) =
-            ( variationalMatrix_.template cast< StateScalarType >( ) * stateTransitionAndSensitivityMatrices );
+    const int numberOfColumnBlocks = getNumberOfColumnBlocks( );
+    if( numberOfColumnBlocks < 2 )
+    {
+        multiplyStatePartialMatrix( stateTransitionAndSensitivityMatrices, currentMatrixDerivative,
+                                    0, numberOfParameterValues_ );
+    }
+    else
+    {
+        // Compute contiguous blocks of columns concurrently, all using the same (single) evaluation of the partials.
+        const int columnsPerBlock = ( numberOfParameterValues_ + numberOfColumnBlocks - 1 ) / numberOfColumnBlocks;
+        columnBlockTaskExecutor_->executeTasks(
+                    numberOfColumnBlocks, [ & ]( const unsigned int blockIndex, const unsigned int )
+        {
+            const int startColumn = blockIndex * columnsPerBlock;
+            const int numberOfColumns = std::min( columnsPerBlock, numberOfParameterValues_ - startColumn );
+            if( numberOfColumns > 0 )
+            {
+                multiplyStatePartialMatrix( stateTransitionAndSensitivityMatrices, currentMatrixDerivative,
+                                            startColumn, numberOfColumns );
+            }
+        } );
+    }
 
     if( couplingEntriesToSuppress_ > 0 )
     {
         int numberOfStaticParameters = numberOfParameterValues_ - totalDynamicalStateSize_;
-        int numberOfUncoupledEntries = totalDynamicalStateSize_ - couplingEntriesToSuppress_;
 
-        currentMatrixDerivative.block( couplingEntriesToSuppress_, totalDynamicalStateSize_, numberOfUncoupledEntries, numberOfStaticParameters ) =
-                variationalMatrix_.template cast< StateScalarType >( ).block(
-                    couplingEntriesToSuppress_, couplingEntriesToSuppress_,
-                    numberOfUncoupledEntries, numberOfUncoupledEntries ) *
-                stateTransitionAndSensitivityMatrices.block(
-                    couplingEntriesToSuppress_, totalDynamicalStateSize_, numberOfUncoupledEntries, numberOfStaticParameters );
+        // Recompute sensitivity of uncoupled entries, using only the partials w.r.t. uncoupled entries
+        currentMatrixDerivative.block( couplingEntriesToSuppress_, totalDynamicalStateSize_,
+                                       totalDynamicalStateSize_ - couplingEntriesToSuppress_,
+                                       numberOfStaticParameters ).setZero( );
+        for( unsigned int i = 0; i < variationalMatrixBlocks_.size( ); i++ )
+        {
+            const int startRow = std::max( stateBlockIndices_[ i ].first, couplingEntriesToSuppress_ );
+            const int numberOfRows = stateBlockIndices_[ i ].first + stateBlockIndices_[ i ].second - startRow;
+            if( numberOfRows <= 0 )
+            {
+                continue;
+            }
+
+            for( auto blockIterator = variationalMatrixBlocks_[ i ].begin( );
+                 blockIterator != variationalMatrixBlocks_[ i ].end( ); blockIterator++ )
+            {
+                const std::pair< int, int >& columnBlock = stateBlockIndices_[ blockIterator->first ];
+                const int startColumn = std::max( columnBlock.first, couplingEntriesToSuppress_ );
+                const int numberOfColumns = columnBlock.first + columnBlock.second - startColumn;
+                if( numberOfColumns > 0 )
+                {
+                    currentMatrixDerivative.block( startRow, totalDynamicalStateSize_,
+                                                   numberOfRows, numberOfStaticParameters ).noalias( ) +=
+                            blockIterator->second.block(
+                                startRow - stateBlockIndices_[ i ].first, startColumn - columnBlock.first,
+                                numberOfRows, numberOfColumns ).template cast< StateScalarType >( ) *
+                            stateTransitionAndSensitivityMatrices.block(
+                                startColumn, totalDynamicalStateSize_, numberOfColumns, numberOfStaticParameters );
+                }
+            }
+        }
     }
 }
 
 //! Calculates matrix containing partial derivatives of state derivatives w.r.t. body state.
 void VariationalEquations::setBodyStatePartialMatrix( )
 {
-    // Initialize partial matrix
-    variationalMatrix_.setZero( );
+    // Initialize (non-zero blocks of) partial matrix
+    for( unsigned int i = 0; i < variationalMatrixBlocks_.size( ); i++ )
+    {
+        for( auto blockIterator = variationalMatrixBlocks_[ i ].begin( );
+             blockIterator != variationalMatrixBlocks_[ i ].end( ); blockIterator++ )
+        {
+            blockIterator->second.setZero( );
+        }
+    }
 
     if( dynamicalStatesToEstimate_.count( propagators::translational_state ) > 0 )
     {
         int startIndex = stateTypeStartIndices_.at( propagators::translational_state );
         for( unsigned int i = 0; i < dynamicalStatesToEstimate_.at( propagators::translational_state ).size( ); i++ )
         {
-            variationalMatrix_.block( startIndex + i * 6, startIndex + i * 6 + 3, 3, 3 ).setIdentity( );
+            int blockIndex = getStateBlockIndex( startIndex + i * 6 );
+            variationalMatrixBlocks_[ blockIndex ].at( blockIndex ).block( 0, 3, 3, 3 ).setIdentity( );
         }
     }
 
@@ -74,9 +155,10 @@ void VariationalEquations::setBodyStatePartialMatrix( )
         int startIndex = stateTypeStartIndices_.at( propagators::rotational_state );
         for( unsigned int i = 0; i < dynamicalStatesToEstimate_.at( propagators::rotational_state ).size( ); i++ )
         {
-            variationalMatrix_.block( startIndex + i * 7, startIndex + i * 7 , 4, 4 ) =
+            int blockIndex = getStateBlockIndex( startIndex + i * 7 );
+            variationalMatrixBlocks_[ blockIndex ].at( blockIndex ).block( 0, 0, 4, 4 ) =
                     getQuaterionToQuaternionRateMatrix( rotationalStates.segment( 7 * i + 4, 3 ) );
-            variationalMatrix_.block( startIndex + i * 7, startIndex + i * 7 + 4, 4, 3 ) =
+            variationalMatrixBlocks_[ blockIndex ].at( blockIndex ).block( 0, 4, 4, 3 ) =
                     getAngularVelocityToQuaternionRateMatrix( rotationalStates.segment( 7 * i, 4 ) );
         }
     }
@@ -92,14 +174,17 @@ void VariationalEquations::setBodyStatePartialMatrix( )
 
         for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
         {
+            std::map< int, Eigen::MatrixXd >& currentBodyBlocks =
+                    variationalMatrixBlocks_[ getStateBlockIndex( startIndex + i * currentStateSize ) ];
+
             // Iterate over all bodies exerting an acceleration on this body.
             for( statePartialIterator_ = typeIterator->second.at( i ).begin( );
                  statePartialIterator_ != typeIterator->second.at( i ).end( );
                  statePartialIterator_++ )
             {
                 statePartialIterator_->second(
-                            variationalMatrix_.block(
-                                startIndex + entriesToSkipPerEntry + i* currentStateSize, statePartialIterator_->first.first,
+                            currentBodyBlocks.at( getStateBlockIndex( statePartialIterator_->first.first ) ).block(
+                                entriesToSkipPerEntry, 0,
                                 currentStateSize - entriesToSkipPerEntry, statePartialIterator_->first.second ) );
 
             }
@@ -108,17 +193,137 @@ void VariationalEquations::setBodyStatePartialMatrix( )
 
     for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
     {
-        variationalMatrix_.block( 0, statePartialAdditionIndices_.at( i ).second, totalDynamicalStateSize_, 3 ) +=
-                variationalMatrix_.block( 0, statePartialAdditionIndices_.at( i ).first, totalDynamicalStateSize_, 3 );
+        int blockToAddFrom = getStateBlockIndex( statePartialAdditionIndices_.at( i ).first );
+        int blockToAddTo = getStateBlockIndex( statePartialAdditionIndices_.at( i ).second );
+        int columnToAddFrom = statePartialAdditionIndices_.at( i ).first - stateBlockIndices_.at( blockToAddFrom ).first;
+        int columnToAddTo = statePartialAdditionIndices_.at( i ).second - stateBlockIndices_.at( blockToAddTo ).first;
+
+        for( unsigned int j = 0; j < variationalMatrixBlocks_.size( ); j++ )
+        {
+            if( variationalMatrixBlocks_[ j ].count( blockToAddFrom ) > 0 )
+            {
+                variationalMatrixBlocks_[ j ].at( blockToAddTo ).block( 0, columnToAddTo, stateBlockIndices_[ j ].second, 3 ) +=
+                        variationalMatrixBlocks_[ j ].at( blockToAddFrom ).block(
+                            0, columnToAddFrom, stateBlockIndices_[ j ].second, 3 );
+            }
+        }
     }
 
     for( unsigned int i = 0; i < inertiaTensorsForMultiplication_.size( ); i++ )
     {
-        variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ ) =
-                ( inertiaTensorsForMultiplication_.at( i ).second( ).inverse( ) ) *
-                variationalMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3, totalDynamicalStateSize_ ).eval( );
+        int blockIndex = getStateBlockIndex( inertiaTensorsForMultiplication_.at( i ).first );
+        int rowInBlock = inertiaTensorsForMultiplication_.at( i ).first - stateBlockIndices_.at( blockIndex ).first;
+        Eigen::Matrix3d inverseInertiaTensor = inertiaTensorsForMultiplication_.at( i ).second( ).inverse( );
+        for( auto blockIterator = variationalMatrixBlocks_[ blockIndex ].begin( );
+             blockIterator != variationalMatrixBlocks_[ blockIndex ].end( ); blockIterator++ )
+        {
+            blockIterator->second.block( rowInBlock, 0, 3, blockIterator->second.cols( ) ) =
+                    inverseInertiaTensor *
+                    blockIterator->second.block( rowInBlock, 0, 3, blockIterator->second.cols( ) ).eval( );
+        }
+    }
+
+}
+
+//! Function (called by constructor) to set the blocks of the state vector of the individual estimated bodies
+void VariationalEquations::setStateBlockIndices( )
+{
+    stateBlockIndices_.clear( );
+    stateBlockIndexPerStartIndex_.clear( );
+    for( std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap >::iterator
+         partialTypeIterator = stateDerivativePartialList_.begin( );
+         partialTypeIterator != stateDerivativePartialList_.end( ); partialTypeIterator++ )
+    {
+        int startIndex = stateTypeStartIndices_.at( partialTypeIterator->first );
+        int currentStateSize = getSingleIntegrationSize( partialTypeIterator->first );
+        for( unsigned int i = 0; i < partialTypeIterator->second.size( ); i++ )
+        {
+            stateBlockIndexPerStartIndex_[ startIndex + i * currentStateSize ] = stateBlockIndices_.size( );
+            stateBlockIndices_.push_back( std::make_pair( startIndex + i * currentStateSize, currentStateSize ) );
+        }
+    }
+}
+
+//! Function (called by constructor) to determine and initialize the non-zero blocks of the partial matrices
+void VariationalEquations::setVariationalMatrixBlockStructure( )
+{
+    // Blocks on diagonal are always non-zero, due to kinematic relations.
+    std::vector< std::set< int > > nonZeroStateBlocks( stateBlockIndices_.size( ) );
+    for( unsigned int i = 0; i < stateBlockIndices_.size( ); i++ )
+    {
+        nonZeroStateBlocks[ i ].insert( i );
+    }
+
+    // Add blocks for which state derivative partials exist, and retrieve non-zero parameter blocks
+    std::vector< std::set< std::pair< int, int > > > nonZeroParameterBlocks( stateBlockIndices_.size( ) );
+    for( auto typeIterator = statePartialList_.begin( ); typeIterator != statePartialList_.end( ); typeIterator++ )
+    {
+        int startIndex = stateTypeStartIndices_.at( typeIterator->first );
+        int currentStateSize = getSingleIntegrationSize( typeIterator->first );
+        for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
+        {
+            int blockIndex = getStateBlockIndex( startIndex + i * currentStateSize );
+            for( auto partialIterator = typeIterator->second.at( i ).begin( );
+                 partialIterator != typeIterator->second.at( i ).end( ); partialIterator++ )
+            {
+                nonZeroStateBlocks[ blockIndex ].insert( getStateBlockIndex( partialIterator->first.first ) );
+            }
+        }
     }
 
+    for( auto typeIterator = parameterPartialList_.begin( ); typeIterator != parameterPartialList_.end( ); typeIterator++ )
+    {
+        int startIndex = stateTypeStartIndices_.at( typeIterator->first );
+        int currentStateSize = getSingleIntegrationSize( typeIterator->first );
+        for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
+        {
+            int blockIndex = getStateBlockIndex( startIndex + i * currentStateSize );
+            for( auto partialIterator = typeIterator->second.at( i ).begin( );
+                 partialIterator != typeIterator->second.at( i ).end( ); partialIterator++ )
+            {
+                nonZeroParameterBlocks[ blockIndex ].insert( partialIterator->first );
+            }
+        }
+    }
+
+    // Add blocks to which partials are added for hierarchical estimation of dynamics (in the order in which they are added)
+    for( unsigned int i = 0; i < statePartialAdditionIndices_.size( ); i++ )
+    {
+        int blockToAddFrom = getStateBlockIndex( statePartialAdditionIndices_.at( i ).first );
+        int blockToAddTo = getStateBlockIndex( statePartialAdditionIndices_.at( i ).second );
+        for( unsigned int j = 0; j < nonZeroStateBlocks.size( ); j++ )
+        {
+            if( nonZeroStateBlocks[ j ].count( blockToAddFrom ) > 0 )
+            {
+                nonZeroStateBlocks[ j ].insert( blockToAddTo );
+            }
+        }
+    }
+
+    // Initialize non-zero blocks
+    variationalMatrixBlocks_.clear( );
+    variationalMatrixBlocks_.resize( stateBlockIndices_.size( ) );
+    variationalParameterMatrixBlocks_.clear( );
+    variationalParameterMatrixBlocks_.resize( stateBlockIndices_.size( ) );
+    numberOfMultiplicationsPerColumn_ = 0.0;
+    for( unsigned int i = 0; i < stateBlockIndices_.size( ); i++ )
+    {
+        for( auto blockIterator = nonZeroStateBlocks[ i ].begin( ); blockIterator != nonZeroStateBlocks[ i ].end( );
+             blockIterator++ )
+        {
+            variationalMatrixBlocks_[ i ][ *blockIterator ] = Eigen::MatrixXd::Zero(
+                        stateBlockIndices_[ i ].second, stateBlockIndices_[ *blockIterator ].second );
+            numberOfMultiplicationsPerColumn_ +=
+                    stateBlockIndices_[ i ].second * stateBlockIndices_[ *blockIterator ].second;
+        }
+
+        for( auto blockIterator = nonZeroParameterBlocks[ i ].begin( ); blockIterator != nonZeroParameterBlocks[ i ].end( );
+             blockIterator++ )
+        {
+            variationalParameterMatrixBlocks_[ i ][ *blockIterator ] = Eigen::MatrixXd::Zero(
+                        stateBlockIndices_[ i ].second, blockIterator->second );
+        }
+    }
 }
 
 //! Function to clear reference/cached values of state derivative partials.
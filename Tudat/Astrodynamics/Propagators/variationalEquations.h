@@ -10,12 +10,15 @@
 #ifndef TUDAT_VARIATIONALEQUATIONS_H
 #define TUDAT_VARIATIONALEQUATIONS_H
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <memory>
 
+#include "Tudat/Basics/parallelExecution.h"
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebra.h"
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
@@ -65,7 +68,8 @@ public:
             const std::map< IntegratedStateType, int >& stateTypeStartIndices,
             const int currentArcIndex = -1 ):
         stateDerivativePartialList_( stateDerivativePartialList ), stateTypeStartIndices_( stateTypeStartIndices ),
-        couplingEntriesToSuppress_( -1 )
+        couplingEntriesToSuppress_( -1 ), numberOfEvaluationThreads_( 1 ),
+        minimumMultiplicationsPerColumnBlock_( 1.0E5 )
     {
         dynamicalStatesToEstimate_ =
                 estimatable_parameters::getListOfInitialDynamicalStateParametersEstimate< ParameterType >(
@@ -97,23 +101,22 @@ public:
                     getSingleIntegrationSize( partialTypeIterator->first ) * partialTypeIterator->second.size( );
         }
 
-        // Initialize matrices.
-        variationalMatrix_ = Eigen::MatrixXd::Zero( totalDynamicalStateSize_, totalDynamicalStateSize_ );
-        variationalParameterMatrix_ =
-                Eigen::MatrixXd::Zero( totalDynamicalStateSize_, numberOfParameterValues_ - totalDynamicalStateSize_ );
-
         // Set parameter partial functions.
+        setStateBlockIndices( );
         setStatePartialFunctionList( );
         setTranslationalStatePartialFrameScalingFunctions( parametersToEstimate, currentArcIndex );
         setRotationalStatePartialScalingFunctions( parametersToEstimate );
         setParameterPartialFunctionList( parametersToEstimate );
+
+        // Initialize (non-zero blocks of) partial matrices.
+        setVariationalMatrixBlockStructure( );
     }
 
     //! Calculates matrix containing partial derivatives of state derivatives w.r.t. body state.
     /*!
      *  Calculates matrix containing partial derivatives of state derivatives w.r.t. body state, i.e.
-     *  first matrix in right hand side of Eq. (7.45) in (Montenbruck & Gill, 2000).
-     *  \return Matrix containing partial derivatives of state derivative w.r.t. body state
+     *  first matrix in right hand side of Eq. (7.45) in (Montenbruck & Gill, 2000). Only the blocks of this matrix that
+     *  may be non-zero are computed (see setVariationalMatrixBlockStructure), and are stored in variationalMatrixBlocks_
      */
     void setBodyStatePartialMatrix( );
 
@@ -141,8 +144,15 @@ public:
     void getParameterPartialMatrix(
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative )
     {
-        // Initialize matrix to zeros
-        variationalParameterMatrix_.setZero( );
+        // Initialize (non-zero blocks of) matrix to zeros
+        for( unsigned int i = 0; i < variationalParameterMatrixBlocks_.size( ); i++ )
+        {
+            for( auto blockIterator = variationalParameterMatrixBlocks_[ i ].begin( );
+                 blockIterator != variationalParameterMatrixBlocks_[ i ].end( ); blockIterator++ )
+            {
+                blockIterator->second.setZero( );
+            }
+        }
 
         // Iterate over all bodies undergoing accelerations for which initial condition is to be estimated.
         for( std::map< IntegratedStateType, std::vector< std::multimap< std::pair< int, int >,
@@ -156,16 +166,17 @@ public:
             // Iterate over all bodies being estimated.
             for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
             {
+                std::map< std::pair< int, int >, Eigen::MatrixXd >& currentBodyBlocks =
+                        variationalParameterMatrixBlocks_[ getStateBlockIndex( startIndex + currentStateSize * i ) ];
+
                 // Iterate over all parameter partial functions determined by setParameterPartialFunctionList( )
                 for( functionIterator = typeIterator->second[ i ].begin( );
                      functionIterator != typeIterator->second[ i ].end( );
                      functionIterator++ )
                 {
                     functionIterator->second(
-                                variationalParameterMatrix_.block(
-                                    startIndex + entriesToSkipPerEntry + currentStateSize * i,
-                                    functionIterator->first.first - totalDynamicalStateSize_,
-                                    currentStateSize - entriesToSkipPerEntry,
+                                currentBodyBlocks.at( functionIterator->first ).block(
+                                    entriesToSkipPerEntry, 0, currentStateSize - entriesToSkipPerEntry,
                                     functionIterator->first.second ) );
                 }
             }
@@ -173,21 +184,29 @@ public:
 
         for( unsigned int i = 0; i < inertiaTensorsForMultiplication_.size( ); i++ )
         {
-            variationalParameterMatrix_.block( inertiaTensorsForMultiplication_.at( i ).first, 0, 3,
-                                               numberOfParameterValues_ - totalDynamicalStateSize_ ) =
-                    ( inertiaTensorsForMultiplication_.at( i ).second( ).inverse( ) ) *
-                    variationalParameterMatrix_.block(
-                        inertiaTensorsForMultiplication_.at( i ).first, 0, 3,
-                        numberOfParameterValues_ - totalDynamicalStateSize_ ).eval( );
+            int blockIndex = getStateBlockIndex( inertiaTensorsForMultiplication_.at( i ).first );
+            int rowInBlock = inertiaTensorsForMultiplication_.at( i ).first - stateBlockIndices_.at( blockIndex ).first;
+            Eigen::Matrix3d inverseInertiaTensor = inertiaTensorsForMultiplication_.at( i ).second( ).inverse( );
+            for( auto blockIterator = variationalParameterMatrixBlocks_[ blockIndex ].begin( );
+                 blockIterator != variationalParameterMatrixBlocks_[ blockIndex ].end( ); blockIterator++ )
+            {
+                blockIterator->second.block( rowInBlock, 0, 3, blockIterator->second.cols( ) ) =
+                        inverseInertiaTensor * blockIterator->second.block(
+                            rowInBlock, 0, 3, blockIterator->second.cols( ) ).eval( );
+            }
         }
 
-        currentMatrixDerivative.block( 0, totalDynamicalStateSize_, totalDynamicalStateSize_,
-                                       numberOfParameterValues_ - totalDynamicalStateSize_ ) +=
-                variationalParameterMatrix_.template cast< StateScalarType >( );
-
-
-
-
+        // Add non-zero blocks to variational equations
+        for( unsigned int i = 0; i < variationalParameterMatrixBlocks_.size( ); i++ )
+        {
+            for( auto blockIterator = variationalParameterMatrixBlocks_[ i ].begin( );
+                 blockIterator != variationalParameterMatrixBlocks_[ i ].end( ); blockIterator++ )
+            {
+                currentMatrixDerivative.block( stateBlockIndices_.at( i ).first, blockIterator->first.first,
+                                               stateBlockIndices_.at( i ).second, blockIterator->first.second ) +=
+                        blockIterator->second.template cast< StateScalarType >( );
+            }
+        }
     }
     
     //! Evaluates the complete variational equations.
@@ -232,7 +251,7 @@ public:
      */
     template< typename StateScalarType >
     void updatePartials( const double currentTime,
-                         const std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
+                         const std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&
                          currentStatesPerTypeInConventionalRepresentation )
     {
         for( auto stateIterator = currentStatesPerTypeInConventionalRepresentation.begin( );
@@ -294,9 +313,205 @@ public:
         couplingEntriesToSuppress_ = couplingEntriesToSuppress;
     }
 
+    //! Function to set the number of threads used to evaluate the variational equations
+    /*!
+     * Function to set the number of threads used to evaluate the variational equations. If more than one thread is used,
+     * the product of the state partial matrix and the state transition/sensitivity matrix (see
+     * getBodyInitialStatePartialMatrix) is split into contiguous blocks of columns, which are computed concurrently. The
+     * state and parameter partials themselves are evaluated only once per call, on the calling thread. Since each column
+     * of the product is computed independently, the result is identical to that obtained with a single thread. Splitting
+     * is only done when the product is sufficiently large (see setMinimumMultiplicationsPerColumnBlock), so that for e.g.
+     * a single propagated body with few parameters the evaluation remains serial.
+     * NOTE: the speedup of the concurrent evaluation has not yet been verified on a multi-core machine. Only the overhead
+     * of distributing the column blocks over the threads (on the order of 10 microseconds per evaluation) has been
+     * measured, on a single core. The benefit for a given case should be checked before enabling this option, e.g. with
+     * benchmark_VariationalEquations (built with the BUILD_WITH_BENCHMARKS option).
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    void setNumberOfEvaluationThreads( const unsigned int numberOfThreads )
+    {
+        numberOfEvaluationThreads_ =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        if( numberOfEvaluationThreads_ > 1 )
+        {
+            columnBlockTaskExecutor_ = std::make_shared< utilities::ParallelTaskExecutor >(
+                        numberOfEvaluationThreads_ );
+        }
+        else
+        {
+            columnBlockTaskExecutor_ = nullptr;
+        }
+    }
+
+    //! Function to set the object used to evaluate the variational equations concurrently
+    /*!
+     * Function to set the object used to evaluate the variational equations concurrently, allowing a single set of
+     * worker threads to be shared by multiple objects of this type (e.g. the arcs of a multi-arc estimation, which are
+     * propagated sequentially). The object must not be used concurrently by different threads.
+     * \param columnBlockTaskExecutor Object used to evaluate the variational equations concurrently (nullptr for serial
+     * evaluation)
+     */
+    void setEvaluationTaskExecutor(
+            const std::shared_ptr< utilities::ParallelTaskExecutor > columnBlockTaskExecutor )
+    {
+        columnBlockTaskExecutor_ = columnBlockTaskExecutor;
+        numberOfEvaluationThreads_ =
+                ( columnBlockTaskExecutor == nullptr ) ? 1 : columnBlockTaskExecutor->getNumberOfThreads( );
+    }
+
+    //! Function to retrieve the number of threads used to evaluate the variational equations
+    /*!
+     * Function to retrieve the number of threads used to evaluate the variational equations
+     * \return Number of threads used to evaluate the variational equations
+     */
+    unsigned int getNumberOfEvaluationThreads( )
+    {
+        return numberOfEvaluationThreads_;
+    }
+
+    //! Function to set the minimum number of multiplications in a single column block
+    /*!
+     * Function to set the minimum number of multiplications in a single column block of the variational equations, when
+     * evaluating them concurrently (see setNumberOfEvaluationThreads). Below this value (default 1.0E5, for which the
+     * product takes on the order of 50 microseconds), the overhead of distributing the work over the threads dominates.
+     * \param minimumMultiplicationsPerColumnBlock Minimum number of multiplications in a single column block
+     */
+    void setMinimumMultiplicationsPerColumnBlock( const double minimumMultiplicationsPerColumnBlock )
+    {
+        minimumMultiplicationsPerColumnBlock_ = minimumMultiplicationsPerColumnBlock;
+    }
+
+    //! Function to retrieve the start indices and sizes of the blocks of the state vector of the individual bodies
+    /*!
+     * Function to retrieve the start indices and sizes of the blocks of the (single-arc) state vector of the individual
+     * estimated bodies, which define the blocks in which the partials w.r.t. the current state are stored.
+     * \return Start indices (first) and sizes (second) of the blocks of the state vector of the individual bodies
+     */
+    std::vector< std::pair< int, int > > getStateBlockIndices( )
+    {
+        return stateBlockIndices_;
+    }
+
+    //! Function to retrieve the indices of the non-zero blocks of the state partial matrix
+    /*!
+     * Function to retrieve the indices of the non-zero blocks of the matrix of partial derivatives of the state
+     * derivatives w.r.t. current states (see setVariationalMatrixBlockStructure).
+     * \return Indices (in getStateBlockIndices) of the non-zero block columns, for each block row
+     */
+    std::vector< std::vector< int > > getNonZeroStatePartialBlocks( )
+    {
+        std::vector< std::vector< int > > nonZeroBlocks( variationalMatrixBlocks_.size( ) );
+        for( unsigned int i = 0; i < variationalMatrixBlocks_.size( ); i++ )
+        {
+            for( auto blockIterator = variationalMatrixBlocks_[ i ].begin( );
+                 blockIterator != variationalMatrixBlocks_[ i ].end( ); blockIterator++ )
+            {
+                nonZeroBlocks[ i ].push_back( blockIterator->first );
+            }
+        }
+        return nonZeroBlocks;
+    }
+
+    //! Function to retrieve the non-zero blocks of the parameter partial matrix
+    /*!
+     * Function to retrieve the non-zero blocks of the matrix of partial derivatives of the state derivatives w.r.t.
+     * parameters (see setVariationalMatrixBlockStructure).
+     * \return Start column in sensitivity matrix and number of columns of the non-zero blocks, for each block row
+     */
+    std::vector< std::vector< std::pair< int, int > > > getNonZeroParameterPartialBlocks( )
+    {
+        std::vector< std::vector< std::pair< int, int > > > nonZeroBlocks( variationalParameterMatrixBlocks_.size( ) );
+        for( unsigned int i = 0; i < variationalParameterMatrixBlocks_.size( ); i++ )
+        {
+            for( auto blockIterator = variationalParameterMatrixBlocks_[ i ].begin( );
+                 blockIterator != variationalParameterMatrixBlocks_[ i ].end( ); blockIterator++ )
+            {
+                nonZeroBlocks[ i ].push_back( blockIterator->first );
+            }
+        }
+        return nonZeroBlocks;
+    }
+
+    //! Function to retrieve the number of column blocks into which the variational equations are split
+    /*!
+     * Function to retrieve the number of column blocks into which the product of the state partial matrix and the state
+     * transition/sensitivity matrix is split, for concurrent evaluation. The number of blocks is limited by the number
+     * of threads, and such that each block requires at least minimumMultiplicationsPerColumnBlock_ multiplications.
+     * \return Number of column blocks into which the variational equations are split (1 for serial evaluation)
+     */
+    int getNumberOfColumnBlocks( )
+    {
+        if( columnBlockTaskExecutor_ == nullptr || numberOfParameterValues_ < 2 )
+        {
+            return 1;
+        }
+
+        const double maximumNumberOfBlocks =
+                numberOfMultiplicationsPerColumn_ * numberOfParameterValues_ /
+                std::max( minimumMultiplicationsPerColumnBlock_, 1.0 );
+        return std::max( 1, std::min( { static_cast< int >( numberOfEvaluationThreads_ ), numberOfParameterValues_,
+                                        static_cast< int >( std::min( maximumNumberOfBlocks, 1.0E9 ) ) } ) );
+    }
+
 protected:
     
 private:
+
+    //! Function to compute the product of the state partial matrix and a block of columns of the state transition matrix
+    /*!
+     *  Function to compute the product of the state partial matrix and a block of columns of the combined state
+     *  transition and sensitivity matrix, using only the non-zero blocks of the state partial matrix.
+     *  \param stateTransitionAndSensitivityMatrices Current combined state transition and sensitivity matrix
+     *  \param currentMatrixDerivative Matrix block in which the product is to be set (returned by reference).
+     *  \param startColumn First column of the block of columns for which the product is to be computed
+     *  \param numberOfColumns Number of columns in the block of columns for which the product is to be computed
+     */
+    template< typename StateScalarType >
+    void multiplyStatePartialMatrix(
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& stateTransitionAndSensitivityMatrices,
+            Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > > currentMatrixDerivative,
+            const int startColumn, const int numberOfColumns );
+
+    //! Function (called by constructor) to set the blocks of the state vector of the individual estimated bodies
+    void setStateBlockIndices( );
+
+    //! Function to retrieve the index of the block of the state vector in which a given state entry is located
+    /*!
+     *  Function to retrieve the index of the block of the state vector (i.e. entry of stateBlockIndices_) in which a given
+     *  entry of the (single-arc) state vector is located.
+     *  \param stateIndex Index of entry in (single-arc) state vector
+     *  \return Index of the block of the state vector in which the given state entry is located
+     */
+    int getStateBlockIndex( const int stateIndex )
+    {
+        std::map< int, int >::const_iterator blockIterator = stateBlockIndexPerStartIndex_.upper_bound( stateIndex );
+        if( blockIterator == stateBlockIndexPerStartIndex_.begin( ) )
+        {
+            throw std::runtime_error( "Error in variational equations, could not find state block of entry " +
+                                      std::to_string( stateIndex ) );
+        }
+        blockIterator--;
+        if( stateIndex >= blockIterator->first + stateBlockIndices_.at( blockIterator->second ).second )
+        {
+            throw std::runtime_error( "Error in variational equations, could not find state block of entry " +
+                                      std::to_string( stateIndex ) );
+        }
+        return blockIterator->second;
+    }
+
+    //! Function (called by constructor) to determine and initialize the non-zero blocks of the partial matrices
+    /*!
+     *  Function (called by constructor) to determine and initialize the non-zero blocks of the partial matrices. For the
+     *  partials w.r.t. the current state, a block (body i, body j) is non-zero if i = j (kinematic relations), if a state
+     *  derivative partial of body i w.r.t. the state of body j exists, or if such a block is added to it due to the
+     *  hierarchical estimation of dynamics (see statePartialAdditionIndices_). For the partials w.r.t. parameters, a block
+     *  (body i, parameter k) is non-zero if a state derivative partial of body i w.r.t. parameter k exists. All other blocks
+     *  are zero, and are neither stored nor used in the evaluation of the variational equations, so that the computational
+     *  cost of the variational equations scales with the number of couplings between bodies, and between bodies and
+     *  parameters, instead of with the square of the state size.
+     */
+    void setVariationalMatrixBlockStructure( );
     
     //! Function (called by constructor) to set up the statePartialList_ member from the state derivative partials
     /*!
@@ -595,11 +810,38 @@ private:
 
     int couplingEntriesToSuppress_;
 
-    //! Total matrix of partial derivatives of state derivatives w.r.t. current states.
-    Eigen::MatrixXd variationalMatrix_;
+    //! Number of threads used to evaluate the variational equations.
+    unsigned int numberOfEvaluationThreads_;
+
+    //! Object used to compute blocks of columns of the variational equations concurrently (nullptr if serial).
+    std::shared_ptr< utilities::ParallelTaskExecutor > columnBlockTaskExecutor_;
+
+    //! Minimum number of multiplications in a single column block (to prevent threading overhead from dominating).
+    double minimumMultiplicationsPerColumnBlock_;
+
+    //! Start indices (first) and sizes (second) of the blocks of the state vector of the individual estimated bodies.
+    std::vector< std::pair< int, int > > stateBlockIndices_;
+
+    //! Index in stateBlockIndices_ (map value) of the block of the state vector starting at a given index (map key).
+    std::map< int, int > stateBlockIndexPerStartIndex_;
+
+    //! Non-zero blocks of matrix of partial derivatives of state derivatives w.r.t. current states.
+    /*!
+     *  Non-zero blocks of matrix of partial derivatives of state derivatives w.r.t. current states. Vector entries denote
+     *  the block rows, map keys the block columns (both as entries of stateBlockIndices_).
+     */
+    std::vector< std::map< int, Eigen::MatrixXd > > variationalMatrixBlocks_;
+
+    //! Non-zero blocks of matrix of partial derivatives of state derivatives w.r.t. parameter vectors.
+    /*!
+     *  Non-zero blocks of matrix of partial derivatives of state derivatives w.r.t. parameter vectors. Vector entries
+     *  denote the block rows (as entries of stateBlockIndices_), map keys the start column in the combined state transition
+     *  and sensitivity matrix and the number of columns of the parameter.
+     */
+    std::vector< std::map< std::pair< int, int >, Eigen::MatrixXd > > variationalParameterMatrixBlocks_;
 
-    //! Total matrix of partial derivatives of state derivatives w.r.t. parameter vectors.
-    Eigen::MatrixXd variationalParameterMatrix_;
+    //! Number of multiplications needed to multiply the non-zero blocks of the state partials with a single column.
+    double numberOfMultiplicationsPerColumn_;
 
     //! Current states, in conventional representation (e.g. transformed from specific propagator) sorted per state type.
     std::unordered_map< IntegratedStateType, Eigen::VectorXd > currentStatesPerTypeInConventionalRepresentation_;
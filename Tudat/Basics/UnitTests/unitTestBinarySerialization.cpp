@@ -0,0 +1,155 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/binarySerialization.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_binary_serialization )
+
+using namespace serialization;
+
+//! Test whether values written to a binary stream are read back bit-identically
+BOOST_AUTO_TEST_CASE( testBinarySerializationRoundTrip )
+{
+    const double doubleValue = mathematical_constants::PI / 3.0;
+    const long double longDoubleValue = mathematical_constants::LONG_PI / 7.0L;
+    const int intValue = -42;
+    const bool boolValue = true;
+    const Time timeValue( 12, 1234.56789L );
+    const std::string stringValue = "binary serialization";
+    const Eigen::Vector3d fixedSizeVector = ( Eigen::Vector3d( ) << 1.0 / 3.0, -2.0E-9, 4.5E12 ).finished( );
+    const Eigen::MatrixXd dynamicMatrix = Eigen::MatrixXd::Random( 4, 3 );
+    const Eigen::Matrix< long double, Eigen::Dynamic, 1 > longDoubleVector =
+            Eigen::Matrix< long double, Eigen::Dynamic, 1 >::Constant( 5, 1.0L / 3.0L );
+    const std::vector< Eigen::VectorXd > vectorOfVectors = { Eigen::VectorXd::Random( 2 ), Eigen::VectorXd::Random( 6 ) };
+    const std::deque< double > dequeValue = { 1.0, 2.0 / 3.0, -7.0 };
+    const std::map< double, unsigned int > mapValue = { { 0.5, 3 }, { 10.0 / 3.0, 7 } };
+    const std::map< Time, Eigen::VectorXd > timeMapValue = { { Time( 1, 0.25L ), Eigen::VectorXd::Random( 3 ) } };
+
+    // Write all values to stream
+    std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+    writeBinaryIdentifier( stream, "TestData" );
+    writeBinaryValue( stream, doubleValue );
+    writeBinaryValue( stream, longDoubleValue );
+    writeBinaryValue( stream, intValue );
+    writeBinaryValue( stream, boolValue );
+    writeBinaryValue( stream, timeValue );
+    writeBinaryValue( stream, stringValue );
+    writeBinaryValue( stream, fixedSizeVector );
+    writeBinaryValue( stream, dynamicMatrix );
+    writeBinaryValue( stream, longDoubleVector );
+    writeBinaryValue( stream, vectorOfVectors );
+    writeBinaryValue( stream, dequeValue );
+    writeBinaryValue( stream, mapValue );
+    writeBinaryValue( stream, timeMapValue );
+
+    // Read all values from stream
+    double readDoubleValue;
+    long double readLongDoubleValue;
+    int readIntValue;
+    bool readBoolValue;
+    Time readTimeValue;
+    std::string readStringValue;
+    Eigen::Vector3d readFixedSizeVector;
+    Eigen::MatrixXd readDynamicMatrix;
+    Eigen::Matrix< long double, Eigen::Dynamic, 1 > readLongDoubleVector;
+    std::vector< Eigen::VectorXd > readVectorOfVectors;
+    std::deque< double > readDequeValue;
+    std::map< double, unsigned int > readMapValue;
+    std::map< Time, Eigen::VectorXd > readTimeMapValue;
+
+    readAndCheckBinaryIdentifier( stream, "TestData" );
+    readBinaryValue( stream, readDoubleValue );
+    readBinaryValue( stream, readLongDoubleValue );
+    readBinaryValue( stream, readIntValue );
+    readBinaryValue( stream, readBoolValue );
+    readBinaryValue( stream, readTimeValue );
+    readBinaryValue( stream, readStringValue );
+    readBinaryValue( stream, readFixedSizeVector );
+    readBinaryValue( stream, readDynamicMatrix );
+    readBinaryValue( stream, readLongDoubleVector );
+    readBinaryValue( stream, readVectorOfVectors );
+    readBinaryValue( stream, readDequeValue );
+    readBinaryValue( stream, readMapValue );
+    readBinaryValue( stream, readTimeMapValue );
+
+    // Check whether values are bit-identical
+    BOOST_CHECK_EQUAL( readDoubleValue, doubleValue );
+    BOOST_CHECK( readLongDoubleValue == longDoubleValue );
+    BOOST_CHECK_EQUAL( readIntValue, intValue );
+    BOOST_CHECK_EQUAL( readBoolValue, boolValue );
+    BOOST_CHECK_EQUAL( readTimeValue.getFullPeriods( ), timeValue.getFullPeriods( ) );
+    BOOST_CHECK( readTimeValue.getSecondsIntoFullPeriod( ) == timeValue.getSecondsIntoFullPeriod( ) );
+    BOOST_CHECK_EQUAL( readStringValue, stringValue );
+    BOOST_CHECK( readFixedSizeVector == fixedSizeVector );
+    BOOST_CHECK_EQUAL( readDynamicMatrix.rows( ), 4 );
+    BOOST_CHECK_EQUAL( readDynamicMatrix.cols( ), 3 );
+    BOOST_CHECK( readDynamicMatrix == dynamicMatrix );
+    BOOST_CHECK( readLongDoubleVector == longDoubleVector );
+    BOOST_CHECK_EQUAL( readVectorOfVectors.size( ), vectorOfVectors.size( ) );
+    for( unsigned int i = 0; i < vectorOfVectors.size( ); i++ )
+    {
+        BOOST_CHECK( readVectorOfVectors.at( i ) == vectorOfVectors.at( i ) );
+    }
+    BOOST_CHECK( readDequeValue == dequeValue );
+    BOOST_CHECK( readMapValue == mapValue );
+    BOOST_CHECK_EQUAL( readTimeMapValue.size( ), 1 );
+    BOOST_CHECK( readTimeMapValue.begin( )->first == timeMapValue.begin( )->first );
+    BOOST_CHECK( readTimeMapValue.begin( )->second == timeMapValue.begin( )->second );
+
+    // Check whether reading beyond the end of the stream is detected
+    double additionalValue;
+    BOOST_CHECK_THROW( readBinaryValue( stream, additionalValue ), std::runtime_error );
+}
+
+//! Test whether inconsistent binary data is detected
+BOOST_AUTO_TEST_CASE( testBinarySerializationErrors )
+{
+    // Check inconsistent identifier
+    {
+        std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+        writeBinaryIdentifier( stream, "FirstIdentifier" );
+        BOOST_CHECK_THROW( readAndCheckBinaryIdentifier( stream, "SecondIdentifier" ), std::runtime_error );
+    }
+
+    // Check inconsistent size of fixed-size matrix
+    {
+        std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+        writeBinaryValue( stream, Eigen::VectorXd::Zero( 4 ).eval( ) );
+        Eigen::Vector3d readVector;
+        BOOST_CHECK_THROW( readBinaryValue( stream, readVector ), std::runtime_error );
+    }
+
+    // Check truncated data
+    {
+        std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+        writeBinaryValue( stream, std::string( "truncated" ) );
+        std::string truncatedData = stream.str( ).substr( 0, stream.str( ).size( ) - 2 );
+        std::stringstream truncatedStream( truncatedData, std::ios::in | std::ios::binary );
+        std::string readString;
+        BOOST_CHECK_THROW( readBinaryValue( truncatedStream, readString ), std::runtime_error );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
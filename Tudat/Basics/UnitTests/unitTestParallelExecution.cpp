@@ -0,0 +1,156 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/parallelExecution.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_parallel_execution )
+
+//! Test whether all tasks are executed exactly once, on the expected thread.
+BOOST_AUTO_TEST_CASE( testParallelTaskExecution )
+{
+    BOOST_CHECK( utilities::getNumberOfAvailableThreads( ) >= 1 );
+
+    unsigned int numberOfTasks = 103;
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 6; numberOfThreads++ )
+    {
+        for( unsigned int distributionType = 0; distributionType < 2; distributionType++ )
+        {
+            bool distributeStatically = ( distributionType == 0 );
+
+            std::vector< int > numberOfTaskCalls( numberOfTasks, 0 );
+            std::vector< unsigned int > taskThreadIndices( numberOfTasks, 0 );
+            std::vector< double > taskResults( numberOfTasks, 0.0 );
+
+            utilities::executeTasksInParallel(
+                        numberOfTasks, numberOfThreads,
+                        [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+            {
+                numberOfTaskCalls[ taskIndex ]++;
+                taskThreadIndices[ taskIndex ] = threadIndex;
+                taskResults[ taskIndex ] = static_cast< double >( taskIndex * taskIndex );
+            }, distributeStatically );
+
+            for( unsigned int i = 0; i < numberOfTasks; i++ )
+            {
+                BOOST_CHECK_EQUAL( numberOfTaskCalls.at( i ), 1 );
+                BOOST_CHECK_EQUAL( taskResults.at( i ), static_cast< double >( i * i ) );
+                BOOST_CHECK( taskThreadIndices.at( i ) < numberOfThreads );
+
+                // Check round-robin distribution for static case
+                if( distributeStatically )
+                {
+                    BOOST_CHECK_EQUAL( taskThreadIndices.at( i ), i % numberOfThreads );
+                }
+            }
+        }
+    }
+}
+
+//! Test whether exceptions thrown in tasks are propagated to the caller.
+BOOST_AUTO_TEST_CASE( testParallelTaskExceptions )
+{
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 4; numberOfThreads++ )
+    {
+        bool isExceptionCaught = false;
+        try
+        {
+            utilities::executeTasksInParallel(
+                        20, numberOfThreads,
+                        [ & ]( const unsigned int taskIndex, const unsigned int )
+            {
+                if( taskIndex == 7 )
+                {
+                    throw std::runtime_error( "Test exception" );
+                }
+            } );
+        }
+        catch( const std::runtime_error& )
+        {
+            isExceptionCaught = true;
+        }
+        BOOST_CHECK_EQUAL( isExceptionCaught, true );
+    }
+}
+
+//! Test whether a persistent task executor executes each set of tasks exactly once, on the expected thread.
+BOOST_AUTO_TEST_CASE( testPersistentTaskExecutor )
+{
+    for( unsigned int numberOfThreads = 1; numberOfThreads < 6; numberOfThreads++ )
+    {
+        utilities::ParallelTaskExecutor taskExecutor( numberOfThreads );
+        BOOST_CHECK_EQUAL( taskExecutor.getNumberOfThreads( ), numberOfThreads );
+
+        // Re-use executor for many sets of tasks, of varying size
+        for( unsigned int taskSet = 0; taskSet < 200; taskSet++ )
+        {
+            unsigned int numberOfTasks = taskSet % 13;
+            std::vector< int > numberOfTaskCalls( numberOfTasks, 0 );
+            std::vector< unsigned int > taskThreadIndices( numberOfTasks, 0 );
+
+            taskExecutor.executeTasks(
+                        numberOfTasks, [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+            {
+                numberOfTaskCalls[ taskIndex ]++;
+                taskThreadIndices[ taskIndex ] = threadIndex;
+            } );
+
+            for( unsigned int i = 0; i < numberOfTasks; i++ )
+            {
+                BOOST_CHECK_EQUAL( numberOfTaskCalls.at( i ), 1 );
+                if( numberOfTasks > 1 )
+                {
+                    BOOST_CHECK_EQUAL( taskThreadIndices.at( i ), i % numberOfThreads );
+                }
+            }
+        }
+
+        // Check exception propagation, and subsequent re-use of executor
+        BOOST_CHECK_THROW( taskExecutor.executeTasks(
+                               10, [ & ]( const unsigned int taskIndex, const unsigned int )
+        {
+            if( taskIndex == 3 )
+            {
+                throw std::runtime_error( "Test exception" );
+            }
+        } ), std::runtime_error );
+
+        std::vector< int > numberOfTaskCalls( 10, 0 );
+        taskExecutor.executeTasks( 10, [ & ]( const unsigned int taskIndex, const unsigned int )
+        {
+            numberOfTaskCalls[ taskIndex ]++;
+        } );
+        for( unsigned int i = 0; i < 10; i++ )
+        {
+            BOOST_CHECK_EQUAL( numberOfTaskCalls.at( i ), 1 );
+        }
+    }
+
+    // Check default number of threads
+    utilities::ParallelTaskExecutor defaultTaskExecutor( 0 );
+    BOOST_CHECK_EQUAL( defaultTaskExecutor.getNumberOfThreads( ), utilities::getNumberOfAvailableThreads( ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,291 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BINARYSERIALIZATION_H
+#define TUDAT_BINARYSERIALIZATION_H
+
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/timeType.h"
+
+namespace tudat
+{
+
+namespace serialization
+{
+
+//! Function to check whether a stream from which binary data was read is still valid
+/*!
+ *  Function to check whether a stream from which binary data was read is still valid, throws an exception if it is not
+ *  (i.e. if the stream ended before all data could be read).
+ *  \param stream Stream that is to be checked
+ */
+inline void checkBinaryInputStream( const std::istream& stream )
+{
+    if( !stream )
+    {
+        throw std::runtime_error( "Error when reading binary data, stream ended unexpectedly." );
+    }
+}
+
+//! Function to write an arithmetic value (e.g. double, int, bool) to a binary stream
+/*!
+ *  Function to write an arithmetic value (e.g. double, int, bool) to a binary stream, using its native (in-memory)
+ *  representation, so that it is read back bit-identically (on the same platform) by readBinaryValue.
+ *  \param stream Stream to which the value is to be written
+ *  \param value Value that is to be written
+ */
+template< typename ValueType,
+          typename std::enable_if< std::is_arithmetic< ValueType >::value, int >::type = 0 >
+void writeBinaryValue( std::ostream& stream, const ValueType value )
+{
+    stream.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+}
+
+//! Function to read an arithmetic value (e.g. double, int, bool) from a binary stream
+/*!
+ *  Function to read an arithmetic value (e.g. double, int, bool) from a binary stream, as written by writeBinaryValue.
+ *  \param stream Stream from which the value is to be read
+ *  \param value Value that is read (returned by reference)
+ */
+template< typename ValueType,
+          typename std::enable_if< std::is_arithmetic< ValueType >::value, int >::type = 0 >
+void readBinaryValue( std::istream& stream, ValueType& value )
+{
+    stream.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) );
+    checkBinaryInputStream( stream );
+}
+
+//! Function to write a Time object to a binary stream (full periods and seconds into full period).
+void writeBinaryValue( std::ostream& stream, const Time& value );
+
+//! Function to read a Time object from a binary stream.
+void readBinaryValue( std::istream& stream, Time& value );
+
+//! Function to write a string to a binary stream (size, followed by characters).
+void writeBinaryValue( std::ostream& stream, const std::string& value );
+
+//! Function to read a string from a binary stream.
+void readBinaryValue( std::istream& stream, std::string& value );
+
+//! Function to write an Eigen matrix to a binary stream (number of rows and columns, followed by entries).
+template< typename ScalarType, int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+void writeBinaryValue( std::ostream& stream,
+                       const Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns >& value );
+
+//! Function to read an Eigen matrix from a binary stream (resized if dynamic, size checked if fixed).
+template< typename ScalarType, int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+void readBinaryValue( std::istream& stream,
+                      Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns >& value );
+
+//! Function to write a vector to a binary stream (size, followed by entries).
+template< typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::vector< ValueType >& value );
+
+//! Function to read a vector from a binary stream.
+template< typename ValueType >
+void readBinaryValue( std::istream& stream, std::vector< ValueType >& value );
+
+//! Function to write a deque to a binary stream (size, followed by entries).
+template< typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::deque< ValueType >& value );
+
+//! Function to read a deque from a binary stream.
+template< typename ValueType >
+void readBinaryValue( std::istream& stream, std::deque< ValueType >& value );
+
+//! Function to write a map to a binary stream (size, followed by key-value pairs).
+template< typename KeyType, typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::map< KeyType, ValueType >& value );
+
+//! Function to read a map from a binary stream.
+template< typename KeyType, typename ValueType >
+void readBinaryValue( std::istream& stream, std::map< KeyType, ValueType >& value );
+
+inline void writeBinaryValue( std::ostream& stream, const Time& value )
+{
+    writeBinaryValue( stream, value.getFullPeriods( ) );
+    writeBinaryValue( stream, value.getSecondsIntoFullPeriod( ) );
+}
+
+inline void readBinaryValue( std::istream& stream, Time& value )
+{
+    int fullPeriods;
+    long double secondsIntoFullPeriod;
+    readBinaryValue( stream, fullPeriods );
+    readBinaryValue( stream, secondsIntoFullPeriod );
+    value = Time( fullPeriods, secondsIntoFullPeriod );
+}
+
+inline void writeBinaryValue( std::ostream& stream, const std::string& value )
+{
+    writeBinaryValue( stream, static_cast< std::uint64_t >( value.size( ) ) );
+    stream.write( value.data( ), static_cast< std::streamsize >( value.size( ) ) );
+}
+
+inline void readBinaryValue( std::istream& stream, std::string& value )
+{
+    std::uint64_t size;
+    readBinaryValue( stream, size );
+    value.resize( size );
+    if( size > 0 )
+    {
+        stream.read( &value[ 0 ], static_cast< std::streamsize >( size ) );
+        checkBinaryInputStream( stream );
+    }
+}
+
+template< typename ScalarType, int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+void writeBinaryValue( std::ostream& stream,
+                       const Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns >& value )
+{
+    writeBinaryValue( stream, static_cast< std::int64_t >( value.rows( ) ) );
+    writeBinaryValue( stream, static_cast< std::int64_t >( value.cols( ) ) );
+    stream.write( reinterpret_cast< const char* >( value.data( ) ),
+                  static_cast< std::streamsize >( value.size( ) * sizeof( ScalarType ) ) );
+}
+
+template< typename ScalarType, int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+void readBinaryValue( std::istream& stream,
+                      Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns >& value )
+{
+    std::int64_t numberOfRows, numberOfColumns;
+    readBinaryValue( stream, numberOfRows );
+    readBinaryValue( stream, numberOfColumns );
+    if( ( Rows != Eigen::Dynamic && numberOfRows != Rows ) ||
+            ( Columns != Eigen::Dynamic && numberOfColumns != Columns ) )
+    {
+        throw std::runtime_error( "Error when reading binary data, size of matrix (" + std::to_string( numberOfRows ) +
+                                  "x" + std::to_string( numberOfColumns ) + ") is inconsistent with its type." );
+    }
+    value.resize( numberOfRows, numberOfColumns );
+    stream.read( reinterpret_cast< char* >( value.data( ) ),
+                 static_cast< std::streamsize >( value.size( ) * sizeof( ScalarType ) ) );
+    checkBinaryInputStream( stream );
+}
+
+template< typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::vector< ValueType >& value )
+{
+    writeBinaryValue( stream, static_cast< std::uint64_t >( value.size( ) ) );
+    for( unsigned int i = 0; i < value.size( ); i++ )
+    {
+        writeBinaryValue( stream, static_cast< const ValueType& >( value[ i ] ) );
+    }
+}
+
+template< typename ValueType >
+void readBinaryValue( std::istream& stream, std::vector< ValueType >& value )
+{
+    std::uint64_t size;
+    readBinaryValue( stream, size );
+    value.clear( );
+    value.reserve( size );
+    for( std::uint64_t i = 0; i < size; i++ )
+    {
+        ValueType entry;
+        readBinaryValue( stream, entry );
+        value.push_back( entry );
+    }
+}
+
+template< typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::deque< ValueType >& value )
+{
+    writeBinaryValue( stream, static_cast< std::uint64_t >( value.size( ) ) );
+    for( unsigned int i = 0; i < value.size( ); i++ )
+    {
+        writeBinaryValue( stream, value[ i ] );
+    }
+}
+
+template< typename ValueType >
+void readBinaryValue( std::istream& stream, std::deque< ValueType >& value )
+{
+    std::uint64_t size;
+    readBinaryValue( stream, size );
+    value.clear( );
+    for( std::uint64_t i = 0; i < size; i++ )
+    {
+        ValueType entry;
+        readBinaryValue( stream, entry );
+        value.push_back( entry );
+    }
+}
+
+template< typename KeyType, typename ValueType >
+void writeBinaryValue( std::ostream& stream, const std::map< KeyType, ValueType >& value )
+{
+    writeBinaryValue( stream, static_cast< std::uint64_t >( value.size( ) ) );
+    for( auto mapIterator = value.begin( ); mapIterator != value.end( ); mapIterator++ )
+    {
+        writeBinaryValue( stream, mapIterator->first );
+        writeBinaryValue( stream, mapIterator->second );
+    }
+}
+
+template< typename KeyType, typename ValueType >
+void readBinaryValue( std::istream& stream, std::map< KeyType, ValueType >& value )
+{
+    std::uint64_t size;
+    readBinaryValue( stream, size );
+    value.clear( );
+    for( std::uint64_t i = 0; i < size; i++ )
+    {
+        KeyType key;
+        readBinaryValue( stream, key );
+        readBinaryValue( stream, value[ key ] );
+    }
+}
+
+//! Function to write an identifier of a block of binary data to a stream.
+/*!
+ *  Function to write an identifier of a block of binary data to a stream, which is checked when reading the data with
+ *  readAndCheckBinaryIdentifier, so that inconsistent data (e.g. written by a different integrator) is detected.
+ *  \param stream Stream to which the identifier is to be written
+ *  \param identifier Identifier that is to be written
+ */
+inline void writeBinaryIdentifier( std::ostream& stream, const std::string& identifier )
+{
+    writeBinaryValue( stream, identifier );
+}
+
+//! Function to read an identifier of a block of binary data from a stream, and check it against the expected identifier.
+/*!
+ *  Function to read an identifier of a block of binary data from a stream, written by writeBinaryIdentifier, and check it
+ *  against the expected identifier. An exception is thrown if the identifiers are not equal.
+ *  \param stream Stream from which the identifier is to be read
+ *  \param expectedIdentifier Expected value of identifier
+ */
+inline void readAndCheckBinaryIdentifier( std::istream& stream, const std::string& expectedIdentifier )
+{
+    std::string identifier;
+    readBinaryValue( stream, identifier );
+    if( identifier != expectedIdentifier )
+    {
+        throw std::runtime_error( "Error when reading binary data, expected " + expectedIdentifier + ", but found " +
+                                  identifier + "." );
+    }
+}
+
+} // namespace serialization
+
+} // namespace tudat
+
+#endif // TUDAT_BINARYSERIALIZATION_H
@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "Tudat/Basics/parallelExecution.h"
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of threads that can run concurrently on the current machine.
+unsigned int getNumberOfAvailableThreads( )
+{
+    unsigned int numberOfThreads = std::thread::hardware_concurrency( );
+    return ( numberOfThreads > 0 ) ? numberOfThreads : 1;
+}
+
+//! Function to execute a set of mutually independent tasks, distributed over a number of threads.
+void executeTasksInParallel(
+        const unsigned int numberOfTasks,
+        const unsigned int numberOfThreads,
+        const std::function< void( const unsigned int, const unsigned int ) >& taskFunction,
+        const bool distributeTasksStatically )
+{
+    if( numberOfTasks == 0 )
+    {
+        return;
+    }
+
+    unsigned int numberOfUsedThreads =
+            std::min( ( numberOfThreads == 0 ) ? getNumberOfAvailableThreads( ) : numberOfThreads, numberOfTasks );
+
+    // Index of next task to be processed (used for dynamic distribution only), and flag to stop after a task has failed.
+    std::atomic< unsigned int > nextTaskIndex( 0 );
+    std::atomic< bool > hasTaskFailed( false );
+    std::vector< std::exception_ptr > threadExceptions( numberOfUsedThreads );
+
+    // Define function executing all tasks of a single thread
+    auto threadFunction = [ & ]( const unsigned int threadIndex )
+    {
+        try
+        {
+            if( distributeTasksStatically )
+            {
+                for( unsigned int taskIndex = threadIndex; taskIndex < numberOfTasks; taskIndex += numberOfUsedThreads )
+                {
+                    if( hasTaskFailed )
+                    {
+                        break;
+                    }
+                    taskFunction( taskIndex, threadIndex );
+                }
+            }
+            else
+            {
+                unsigned int taskIndex;
+                while( !hasTaskFailed && ( ( taskIndex = nextTaskIndex++ ) < numberOfTasks ) )
+                {
+                    taskFunction( taskIndex, threadIndex );
+                }
+            }
+        }
+        catch( ... )
+        {
+            threadExceptions[ threadIndex ] = std::current_exception( );
+            hasTaskFailed = true;
+        }
+    };
+
+    // Start additional threads, and use calling thread as thread 0.
+    std::vector< std::thread > threads;
+    threads.reserve( numberOfUsedThreads - 1 );
+    for( unsigned int i = 1; i < numberOfUsedThreads; i++ )
+    {
+        threads.push_back( std::thread( threadFunction, i ) );
+    }
+    threadFunction( 0 );
+
+    for( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads.at( i ).join( );
+    }
+
+    // Propagate first exception (if any) to caller.
+    for( unsigned int i = 0; i < threadExceptions.size( ); i++ )
+    {
+        if( threadExceptions.at( i ) != nullptr )
+        {
+            std::rethrow_exception( threadExceptions.at( i ) );
+        }
+    }
+}
+
+//! Constructor
+ParallelTaskExecutor::ParallelTaskExecutor( const unsigned int numberOfThreads ):
+    numberOfThreads_( ( numberOfThreads == 0 ) ? getNumberOfAvailableThreads( ) : numberOfThreads ),
+    currentTaskFunction_( nullptr ), currentNumberOfTasks_( 0 ), taskSetIndex_( 0 ),
+    numberOfBusyWorkerThreads_( 0 ), stopWorkerThreads_( false )
+{
+    threadExceptions_.resize( numberOfThreads_ );
+    workerThreads_.reserve( numberOfThreads_ - 1 );
+    for( unsigned int i = 1; i < numberOfThreads_; i++ )
+    {
+        workerThreads_.push_back( std::thread( &ParallelTaskExecutor::runWorkerThread, this, i ) );
+    }
+}
+
+//! Destructor, stops and joins the worker threads.
+ParallelTaskExecutor::~ParallelTaskExecutor( )
+{
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        stopWorkerThreads_ = true;
+    }
+    startCondition_.notify_all( );
+
+    for( unsigned int i = 0; i < workerThreads_.size( ); i++ )
+    {
+        workerThreads_.at( i ).join( );
+    }
+}
+
+//! Function to execute a set of mutually independent tasks, distributed over the threads.
+void ParallelTaskExecutor::executeTasks(
+        const unsigned int numberOfTasks,
+        const std::function< void( const unsigned int, const unsigned int ) >& taskFunction )
+{
+    // Execute tasks on calling thread only, if no parallelization is possible
+    if( numberOfThreads_ == 1 || numberOfTasks < 2 )
+    {
+        for( unsigned int taskIndex = 0; taskIndex < numberOfTasks; taskIndex++ )
+        {
+            taskFunction( taskIndex, 0 );
+        }
+        return;
+    }
+
+    // Signal worker threads to start new set of tasks
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        currentTaskFunction_ = &taskFunction;
+        currentNumberOfTasks_ = numberOfTasks;
+        numberOfBusyWorkerThreads_ = static_cast< unsigned int >( workerThreads_.size( ) );
+        taskSetIndex_++;
+    }
+    startCondition_.notify_all( );
+
+    // Use calling thread as thread 0, and wait for worker threads to finish.
+    executeTasksOfThread( 0 );
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        finishCondition_.wait( lock, [ this ]( ){ return numberOfBusyWorkerThreads_ == 0; } );
+        currentTaskFunction_ = nullptr;
+    }
+
+    // Propagate first exception (if any) to caller.
+    for( unsigned int i = 0; i < threadExceptions_.size( ); i++ )
+    {
+        if( threadExceptions_.at( i ) != nullptr )
+        {
+            std::exception_ptr thrownException = threadExceptions_.at( i );
+            std::fill( threadExceptions_.begin( ), threadExceptions_.end( ), nullptr );
+            std::rethrow_exception( thrownException );
+        }
+    }
+}
+
+//! Function executing the tasks assigned to a single thread for the current set of tasks.
+void ParallelTaskExecutor::executeTasksOfThread( const unsigned int threadIndex )
+{
+    try
+    {
+        for( unsigned int taskIndex = threadIndex; taskIndex < currentNumberOfTasks_; taskIndex += numberOfThreads_ )
+        {
+            ( *currentTaskFunction_ )( taskIndex, threadIndex );
+        }
+    }
+    catch( ... )
+    {
+        threadExceptions_[ threadIndex ] = std::current_exception( );
+    }
+}
+
+//! Function run by each of the worker threads, waiting for and executing sets of tasks until the object is destroyed.
+void ParallelTaskExecutor::runWorkerThread( const unsigned int threadIndex )
+{
+    unsigned long long lastTaskSetIndex = 0;
+    while( true )
+    {
+        // Wait for new set of tasks (or stop signal)
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            startCondition_.wait( lock, [ & ]( ){ return stopWorkerThreads_ || taskSetIndex_ != lastTaskSetIndex; } );
+            if( stopWorkerThreads_ )
+            {
+                return;
+            }
+            lastTaskSetIndex = taskSetIndex_;
+        }
+
+        executeTasksOfThread( threadIndex );
+
+        // Signal calling thread if all worker threads are done
+        bool isLastFinishedThread;
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            numberOfBusyWorkerThreads_--;
+            isLastFinishedThread = ( numberOfBusyWorkerThreads_ == 0 );
+        }
+        if( isLastFinishedThread )
+        {
+            finishCondition_.notify_one( );
+        }
+    }
+}
+
+} // namespace utilities
+
+} // namespace tudat
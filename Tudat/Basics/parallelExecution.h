@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PARALLELEXECUTION_H
+#define TUDAT_PARALLELEXECUTION_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of threads that can run concurrently on the current machine.
+/*!
+ *  Function to retrieve the number of threads that can run concurrently on the current machine. If this number cannot be
+ *  determined, a value of 1 is returned.
+ *  \return Number of threads that can run concurrently on the current machine.
+ */
+unsigned int getNumberOfAvailableThreads( );
+
+//! Function to execute a set of mutually independent tasks, distributed over a number of threads.
+/*!
+ *  Function to execute a set of mutually independent tasks, distributed over a number of threads. The taskFunction is
+ *  called once for each task index in [0, numberOfTasks), with as second argument the index (in [0, numberOfThreads)) of the
+ *  thread on which it is executed. Thread 0 is always the calling thread, so that objects owned by the caller may safely
+ *  be used for the tasks executed with thread index 0. Tasks executed by the same thread never run concurrently, so that
+ *  the thread index can be used to select data (e.g. a copy of the environment) that is private to a single thread.
+ *
+ *  If distributeTasksStatically is true, task i is executed by thread ( i % numberOfThreads ), and each thread processes its
+ *  tasks in ascending order, so that the mapping of tasks to threads is reproducible. Otherwise, each thread retrieves the
+ *  next unprocessed task when it finishes its current one, which gives better load balancing for tasks of unequal duration.
+ *
+ *  If any of the tasks throws an exception, no new tasks are started, and the exception is rethrown by this function once
+ *  all threads have finished (if multiple tasks throw, the exception of the task with the lowest thread index is rethrown).
+ *  \param numberOfTasks Number of tasks that are to be executed.
+ *  \param numberOfThreads Number of threads over which the tasks are to be distributed (capped at numberOfTasks). A value
+ *  of 0 denotes that the value returned by getNumberOfAvailableThreads is to be used.
+ *  \param taskFunction Function executing a single task, with task index and thread index as input.
+ *  \param distributeTasksStatically Boolean denoting whether tasks are assigned to threads in a fixed (round-robin) order
+ *  (default true).
+ */
+void executeTasksInParallel(
+        const unsigned int numberOfTasks,
+        const unsigned int numberOfThreads,
+        const std::function< void( const unsigned int, const unsigned int ) >& taskFunction,
+        const bool distributeTasksStatically = true );
+
+//! Class to repeatedly execute sets of mutually independent tasks on a fixed set of worker threads.
+/*!
+ *  Class to repeatedly execute sets of mutually independent tasks on a fixed set of worker threads. It provides the same
+ *  functionality as executeTasksInParallel (with static task distribution), but the worker threads are created once, when
+ *  constructing the object, and are re-used for each call to executeTasks. This avoids the cost of starting new threads for
+ *  each set of tasks, and is intended for sets of short tasks that are executed many times, such as the evaluation of
+ *  acceleration models at each function evaluation of a numerical integrator.
+ *
+ *  Task i is executed by thread ( i % numberOfThreads ), in ascending order per thread, and thread 0 is the thread calling
+ *  executeTasks. A single object must not be used by multiple threads at the same time.
+ */
+class ParallelTaskExecutor
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, starts the worker threads.
+     *  \param numberOfThreads Number of threads over which tasks are distributed, including the calling thread. A value of 0
+     *  denotes that the value returned by getNumberOfAvailableThreads is to be used.
+     */
+    ParallelTaskExecutor( const unsigned int numberOfThreads );
+
+    //! Destructor, stops and joins the worker threads.
+    ~ParallelTaskExecutor( );
+
+    //! Function to execute a set of mutually independent tasks, distributed over the threads.
+    /*!
+     *  Function to execute a set of mutually independent tasks, distributed over the threads, returning once all tasks
+     *  have been executed. The taskFunction is called once for each task index in [0, numberOfTasks), with as second
+     *  argument the index of the thread on which it is executed. If any of the tasks throws an exception, the remaining
+     *  tasks of that thread are skipped, and the exception is rethrown by this function once all threads have finished.
+     *  \param numberOfTasks Number of tasks that are to be executed.
+     *  \param taskFunction Function executing a single task, with task index and thread index as input.
+     */
+    void executeTasks( const unsigned int numberOfTasks,
+                       const std::function< void( const unsigned int, const unsigned int ) >& taskFunction );
+
+    //! Function to retrieve the number of threads over which tasks are distributed (including the calling thread).
+    /*!
+     *  Function to retrieve the number of threads over which tasks are distributed (including the calling thread).
+     *  \return Number of threads over which tasks are distributed.
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return numberOfThreads_;
+    }
+
+private:
+
+    //! Copying is not allowed, since the worker threads refer to this object.
+    ParallelTaskExecutor( const ParallelTaskExecutor& );
+
+    //! Assignment is not allowed, since the worker threads refer to this object.
+    ParallelTaskExecutor& operator=( const ParallelTaskExecutor& );
+
+    //! Function executing the tasks assigned to a single thread for the current set of tasks.
+    /*!
+     *  Function executing the tasks assigned to a single thread for the current set of tasks, storing any thrown exception.
+     *  \param threadIndex Index of thread for which tasks are to be executed.
+     */
+    void executeTasksOfThread( const unsigned int threadIndex );
+
+    //! Function run by each of the worker threads, waiting for and executing sets of tasks until the object is destroyed.
+    /*!
+     *  Function run by each of the worker threads, waiting for and executing sets of tasks until the object is destroyed.
+     *  \param threadIndex Index of the worker thread (1 or higher).
+     */
+    void runWorkerThread( const unsigned int threadIndex );
+
+    //! Number of threads over which tasks are distributed (including the calling thread).
+    unsigned int numberOfThreads_;
+
+    //! Worker threads (thread indices 1 and higher).
+    std::vector< std::thread > workerThreads_;
+
+    //! Mutex protecting the variables used to communicate with the worker threads.
+    std::mutex mutex_;
+
+    //! Condition variable used to signal the worker threads that a new set of tasks is to be executed.
+    std::condition_variable startCondition_;
+
+    //! Condition variable used to signal the calling thread that a worker thread has finished its tasks.
+    std::condition_variable finishCondition_;
+
+    //! Function executing a single task for the current set of tasks.
+    const std::function< void( const unsigned int, const unsigned int ) >* currentTaskFunction_;
+
+    //! Number of tasks in the current set of tasks.
+    unsigned int currentNumberOfTasks_;
+
+    //! Counter that is incremented for each new set of tasks, used by the worker threads to detect a new set.
+    unsigned long long taskSetIndex_;
+
+    //! Number of worker threads that have not yet finished the current set of tasks.
+    unsigned int numberOfBusyWorkerThreads_;
+
+    //! Boolean denoting whether the worker threads are to stop.
+    bool stopWorkerThreads_;
+
+    //! Exceptions thrown by the tasks in the current set, per thread.
+    std::vector< std::exception_ptr > threadExceptions_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_PARALLELEXECUTION_H
@@ -46,6 +46,8 @@ endif()
   list(APPEND TUDAT_EXTERNAL_LIBRARIES gsl)
  endif()
 
+ list(APPEND TUDAT_EXTERNAL_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+
 # # Find PaGMO library on local system.
 # if( USE_PAGMO )
 #   list(APPEND TUDAT_EXTERNAL_LIBRARIES pthread)
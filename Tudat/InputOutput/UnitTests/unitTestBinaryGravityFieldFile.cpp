@@ -0,0 +1,194 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/InputOutput/binaryGravityFieldFile.h"
+
+namespace tudat
+{
+
+namespace unit_tests
+{
+
+using namespace input_output;
+
+BOOST_AUTO_TEST_SUITE( test_binary_gravity_field_file )
+
+//! Test writing and (truncated) loading of binary gravity field files.
+BOOST_AUTO_TEST_CASE( testBinaryGravityFieldFileLoading )
+{
+    const std::string fileName = ( boost::filesystem::temp_directory_path( ) /
+                                   boost::filesystem::unique_path( "testGravityField-%%%%-%%%%.bin" ) ).string( );
+
+    // Create coefficients with maximum order lower than maximum degree (only lower triangle is stored).
+    const int maximumDegree = 20;
+    const int maximumOrder = 12;
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumOrder + 1 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumOrder + 1 );
+    for( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        for( int order = degree + 1; order <= maximumOrder; order++ )
+        {
+            cosineCoefficients( degree, order ) = 0.0;
+            sineCoefficients( degree, order ) = 0.0;
+        }
+    }
+    const double gravitationalParameter = 3.986004418E14;
+    const double referenceRadius = 6378137.0;
+
+    writeBinaryGravityFieldFile( fileName, cosineCoefficients, sineCoefficients,
+                                 gravitationalParameter, referenceRadius );
+    BOOST_CHECK_EQUAL( isBinaryGravityFieldFile( fileName ), true );
+
+    // Check file size: header and one pair of coefficients per stored degree and order.
+    int numberOfCoefficients = 0;
+    for( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        numberOfCoefficients += std::min( degree, maximumOrder ) + 1;
+    }
+    BOOST_CHECK_EQUAL( boost::filesystem::file_size( fileName ), 64 + 2 * 8 * numberOfCoefficients );
+
+    {
+        MemoryMappedGravityFieldFile binaryFile( fileName );
+        BOOST_CHECK_EQUAL( binaryFile.getMaximumDegree( ), maximumDegree );
+        BOOST_CHECK_EQUAL( binaryFile.getMaximumOrder( ), maximumOrder );
+        BOOST_CHECK_EQUAL( binaryFile.getGravitationalParameter( ), gravitationalParameter );
+        BOOST_CHECK_EQUAL( binaryFile.getReferenceRadius( ), referenceRadius );
+
+        // Check full, truncated and extended sets of coefficients (coefficients are stored exactly).
+        Eigen::MatrixXd loadedCosineCoefficients, loadedSineCoefficients;
+        for( int test = 0; test < 4; test++ )
+        {
+            const int testDegree = ( test == 0 ) ? maximumDegree : ( ( test == 1 ) ? 10 : ( ( test == 2 ) ? 15 : 25 ) );
+            const int testOrder = ( test == 0 ) ? maximumOrder : ( ( test == 1 ) ? 5 : ( ( test == 2 ) ? 15 : 18 ) );
+            binaryFile.getCoefficients( testDegree, testOrder, loadedCosineCoefficients, loadedSineCoefficients );
+
+            BOOST_CHECK_EQUAL( loadedCosineCoefficients.rows( ), testDegree + 1 );
+            BOOST_CHECK_EQUAL( loadedCosineCoefficients.cols( ), testOrder + 1 );
+            BOOST_CHECK_EQUAL( loadedSineCoefficients.rows( ), testDegree + 1 );
+            BOOST_CHECK_EQUAL( loadedSineCoefficients.cols( ), testOrder + 1 );
+            for( int degree = 0; degree <= testDegree; degree++ )
+            {
+                for( int order = 0; order <= testOrder; order++ )
+                {
+                    if( degree <= maximumDegree && order <= maximumOrder )
+                    {
+                        BOOST_CHECK_EQUAL( loadedCosineCoefficients( degree, order ),
+                                           cosineCoefficients( degree, order ) );
+                        BOOST_CHECK_EQUAL( loadedSineCoefficients( degree, order ),
+                                           sineCoefficients( degree, order ) );
+                    }
+                    else
+                    {
+                        BOOST_CHECK_EQUAL( loadedCosineCoefficients( degree, order ), 0.0 );
+                        BOOST_CHECK_EQUAL( loadedSineCoefficients( degree, order ), 0.0 );
+                    }
+                }
+            }
+        }
+    }
+
+    // Overwrite all coefficients above degree 10 with NaN, and check that they are not used for a truncated field.
+    {
+        int numberOfRetainedCoefficients = 0;
+        for( int degree = 0; degree <= 10; degree++ )
+        {
+            numberOfRetainedCoefficients += std::min( degree, maximumOrder ) + 1;
+        }
+
+        std::fstream fileStream( fileName.c_str( ), std::ios::in | std::ios::out | std::ios::binary );
+        fileStream.seekp( 64 + 2 * 8 * numberOfRetainedCoefficients );
+        const double nanValue = std::numeric_limits< double >::quiet_NaN( );
+        for( int i = 0; i < 2 * ( numberOfCoefficients - numberOfRetainedCoefficients ); i++ )
+        {
+            fileStream.write( reinterpret_cast< const char* >( &nanValue ), sizeof( double ) );
+        }
+        fileStream.close( );
+
+        Eigen::MatrixXd loadedCosineCoefficients, loadedSineCoefficients;
+        MemoryMappedGravityFieldFile binaryFile( fileName );
+        binaryFile.getCoefficients( 10, 10, loadedCosineCoefficients, loadedSineCoefficients );
+        BOOST_CHECK_EQUAL( loadedCosineCoefficients.hasNaN( ), false );
+        BOOST_CHECK_EQUAL( loadedSineCoefficients.hasNaN( ), false );
+        BOOST_CHECK_EQUAL( loadedCosineCoefficients( 10, 10 ), cosineCoefficients( 10, 10 ) );
+
+        binaryFile.getCoefficients( 11, 0, loadedCosineCoefficients, loadedSineCoefficients );
+        BOOST_CHECK_EQUAL( std::isnan( loadedCosineCoefficients( 11, 0 ) ), true );
+    }
+
+    // Check that gravitational parameter and reference radius are NaN if not provided.
+    writeBinaryGravityFieldFile( fileName, cosineCoefficients, sineCoefficients );
+    {
+        MemoryMappedGravityFieldFile binaryFile( fileName );
+        BOOST_CHECK_EQUAL( std::isnan( binaryFile.getGravitationalParameter( ) ), true );
+        BOOST_CHECK_EQUAL( std::isnan( binaryFile.getReferenceRadius( ) ), true );
+    }
+
+    boost::filesystem::remove( fileName );
+}
+
+//! Test error handling of binary gravity field files.
+BOOST_AUTO_TEST_CASE( testBinaryGravityFieldFileErrors )
+{
+    const std::string fileName = ( boost::filesystem::temp_directory_path( ) /
+                                   boost::filesystem::unique_path( "testGravityField-%%%%-%%%%.bin" ) ).string( );
+
+    // Check that inconsistent or empty coefficients are not written.
+    BOOST_CHECK_THROW( writeBinaryGravityFieldFile( fileName, Eigen::MatrixXd::Zero( 5, 5 ), Eigen::MatrixXd::Zero( 5, 4 ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( writeBinaryGravityFieldFile( fileName, Eigen::MatrixXd::Zero( 0, 0 ), Eigen::MatrixXd::Zero( 0, 0 ) ),
+                       std::runtime_error );
+
+    // Check that non-existing files and text files are not recognized.
+    BOOST_CHECK_EQUAL( isBinaryGravityFieldFile( fileName ), false );
+    BOOST_CHECK_THROW( MemoryMappedGravityFieldFile binaryFile( fileName ), std::runtime_error );
+    {
+        std::ofstream fileStream( fileName.c_str( ) );
+        fileStream << "0.3986004418E15  6378137.0" << std::endl;
+        fileStream << "   2   0 -0.484165371736E-03  0.000000000000E+00" << std::endl;
+    }
+    BOOST_CHECK_EQUAL( isBinaryGravityFieldFile( fileName ), false );
+    BOOST_CHECK_THROW( MemoryMappedGravityFieldFile binaryFile( fileName ), std::runtime_error );
+
+    // Check that truncated files and files of unknown version are rejected.
+    writeBinaryGravityFieldFile( fileName, Eigen::MatrixXd::Ones( 11, 11 ), Eigen::MatrixXd::Ones( 11, 11 ) );
+    boost::filesystem::resize_file( fileName, boost::filesystem::file_size( fileName ) - 8 );
+    BOOST_CHECK_EQUAL( isBinaryGravityFieldFile( fileName ), true );
+    BOOST_CHECK_THROW( MemoryMappedGravityFieldFile binaryFile( fileName ), std::runtime_error );
+
+    writeBinaryGravityFieldFile( fileName, Eigen::MatrixXd::Ones( 11, 11 ), Eigen::MatrixXd::Ones( 11, 11 ) );
+    {
+        std::fstream fileStream( fileName.c_str( ), std::ios::in | std::ios::out | std::ios::binary );
+        fileStream.seekp( 8 );
+        fileStream.put( 2 );
+    }
+    BOOST_CHECK_THROW( MemoryMappedGravityFieldFile binaryFile( fileName ), std::runtime_error );
+
+    boost::filesystem::remove( fileName );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
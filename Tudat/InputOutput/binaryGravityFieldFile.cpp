@@ -0,0 +1,236 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Tudat/InputOutput/binaryGravityFieldFile.h"
+
+namespace tudat
+{
+
+namespace input_output
+{
+
+//! Identifier at the start of a binary gravity field file.
+static const char binaryGravityFieldFileIdentifier[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'S', 'H', 'G' };
+
+//! Version of the binary gravity field file format.
+static const std::uint32_t binaryGravityFieldFileVersion = 1;
+
+//! Byte order mark of a binary gravity field file (used to detect files written on a machine of different endianness).
+static const std::uint32_t binaryGravityFieldFileByteOrderMark = 0x01020304;
+
+//! Size of the header of a binary gravity field file, in bytes.
+static const std::size_t binaryGravityFieldFileHeaderSize = 64;
+
+//! Byte offsets of the entries in the header of a binary gravity field file.
+enum BinaryGravityFieldFileHeaderOffsets
+{
+    version_offset = 8,
+    byte_order_mark_offset = 12,
+    maximum_degree_offset = 16,
+    maximum_order_offset = 20,
+    gravitational_parameter_offset = 24,
+    reference_radius_offset = 32
+};
+
+//! Function to write spherical harmonic gravity field coefficients to a binary file.
+void writeBinaryGravityFieldFile(
+        const std::string& fileName,
+        const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients,
+        const double gravitationalParameter,
+        const double referenceRadius )
+{
+    if( cosineCoefficients.rows( ) != sineCoefficients.rows( ) ||
+            cosineCoefficients.cols( ) != sineCoefficients.cols( ) )
+    {
+        throw std::runtime_error( "Error when writing binary gravity field file " + fileName +
+                                  ", cosine and sine coefficients are of unequal size." );
+    }
+    else if( cosineCoefficients.rows( ) == 0 || cosineCoefficients.cols( ) == 0 )
+    {
+        throw std::runtime_error( "Error when writing binary gravity field file " + fileName +
+                                  ", no coefficients provided." );
+    }
+
+    const std::int32_t maximumDegree = static_cast< std::int32_t >( cosineCoefficients.rows( ) ) - 1;
+    const std::int32_t maximumOrder = std::min(
+                static_cast< std::int32_t >( cosineCoefficients.cols( ) ) - 1, maximumDegree );
+
+    // Set header.
+    char header[ binaryGravityFieldFileHeaderSize ];
+    std::memset( header, 0, binaryGravityFieldFileHeaderSize );
+    std::memcpy( header, binaryGravityFieldFileIdentifier, sizeof( binaryGravityFieldFileIdentifier ) );
+    std::memcpy( header + version_offset, &binaryGravityFieldFileVersion, sizeof( std::uint32_t ) );
+    std::memcpy( header + byte_order_mark_offset, &binaryGravityFieldFileByteOrderMark, sizeof( std::uint32_t ) );
+    std::memcpy( header + maximum_degree_offset, &maximumDegree, sizeof( std::int32_t ) );
+    std::memcpy( header + maximum_order_offset, &maximumOrder, sizeof( std::int32_t ) );
+    std::memcpy( header + gravitational_parameter_offset, &gravitationalParameter, sizeof( double ) );
+    std::memcpy( header + reference_radius_offset, &referenceRadius, sizeof( double ) );
+
+    std::ofstream fileStream( fileName.c_str( ), std::ios::binary | std::ios::trunc );
+    if( !fileStream.is_open( ) )
+    {
+        throw std::runtime_error( "Error when writing binary gravity field file, could not open file " + fileName );
+    }
+    fileStream.write( header, binaryGravityFieldFileHeaderSize );
+
+    // Write coefficients degree by degree, as interleaved cosine and sine coefficients.
+    std::vector< double > degreeCoefficients( 2 * ( maximumOrder + 1 ) );
+    for( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        const int numberOfOrders = std::min( degree, static_cast< int >( maximumOrder ) ) + 1;
+        for( int order = 0; order < numberOfOrders; order++ )
+        {
+            degreeCoefficients[ 2 * order ] = cosineCoefficients( degree, order );
+            degreeCoefficients[ 2 * order + 1 ] = sineCoefficients( degree, order );
+        }
+        fileStream.write( reinterpret_cast< const char* >( degreeCoefficients.data( ) ),
+                          2 * numberOfOrders * sizeof( double ) );
+    }
+
+    if( !fileStream.good( ) )
+    {
+        fileStream.close( );
+        std::remove( fileName.c_str( ) );
+        throw std::runtime_error( "Error when writing binary gravity field file, could not write file " + fileName );
+    }
+}
+
+//! Function to check whether a file is a binary gravity field file.
+bool isBinaryGravityFieldFile( const std::string& fileName )
+{
+    std::ifstream fileStream( fileName.c_str( ), std::ios::binary );
+    if( !fileStream.is_open( ) )
+    {
+        return false;
+    }
+
+    char identifier[ sizeof( binaryGravityFieldFileIdentifier ) ];
+    fileStream.read( identifier, sizeof( identifier ) );
+    return ( fileStream.gcount( ) == sizeof( identifier ) ) &&
+            ( std::memcmp( identifier, binaryGravityFieldFileIdentifier, sizeof( identifier ) ) == 0 );
+}
+
+//! Constructor, maps the file into memory and reads its header.
+MemoryMappedGravityFieldFile::MemoryMappedGravityFieldFile( const std::string& fileName ):
+    fileName_( fileName ), coefficientData_( nullptr )
+{
+    try
+    {
+        mappedFile_.open( fileName_ );
+    }
+    catch( std::exception& caughtException )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file, could not map file " +
+                                  fileName_ + ": " + caughtException.what( ) );
+    }
+
+    // Check and read header.
+    const char* fileData = mappedFile_.data( );
+    if( mappedFile_.size( ) < binaryGravityFieldFileHeaderSize ||
+            std::memcmp( fileData, binaryGravityFieldFileIdentifier, sizeof( binaryGravityFieldFileIdentifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file, " + fileName_ +
+                                  " is not a binary gravity field file." );
+    }
+
+    std::uint32_t version, byteOrderMark;
+    std::memcpy( &version, fileData + version_offset, sizeof( std::uint32_t ) );
+    std::memcpy( &byteOrderMark, fileData + byte_order_mark_offset, sizeof( std::uint32_t ) );
+    if( byteOrderMark != binaryGravityFieldFileByteOrderMark )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file " + fileName_ +
+                                  ", file was written with a different byte order." );
+    }
+    else if( version != binaryGravityFieldFileVersion )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file " + fileName_ +
+                                  ", format version " + std::to_string( version ) + " is not supported." );
+    }
+
+    std::int32_t maximumDegree, maximumOrder;
+    std::memcpy( &maximumDegree, fileData + maximum_degree_offset, sizeof( std::int32_t ) );
+    std::memcpy( &maximumOrder, fileData + maximum_order_offset, sizeof( std::int32_t ) );
+    std::memcpy( &gravitationalParameter_, fileData + gravitational_parameter_offset, sizeof( double ) );
+    std::memcpy( &referenceRadius_, fileData + reference_radius_offset, sizeof( double ) );
+    maximumDegree_ = maximumDegree;
+    maximumOrder_ = maximumOrder;
+
+    if( maximumDegree_ < 0 || maximumOrder_ < 0 || maximumOrder_ > maximumDegree_ )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file " + fileName_ +
+                                  ", maximum degree and order are inconsistent." );
+    }
+    else if( mappedFile_.size( ) <
+             binaryGravityFieldFileHeaderSize + 2 * sizeof( double ) * getIndexOfDegree( maximumDegree_ + 1 ) )
+    {
+        throw std::runtime_error( "Error when loading binary gravity field file " + fileName_ +
+                                  ", file is truncated." );
+    }
+
+    coefficientData_ = reinterpret_cast< const double* >( fileData + binaryGravityFieldFileHeaderSize );
+}
+
+//! Destructor, unmaps the file.
+MemoryMappedGravityFieldFile::~MemoryMappedGravityFieldFile( )
+{
+    if( mappedFile_.is_open( ) )
+    {
+        mappedFile_.close( );
+    }
+}
+
+//! Function to retrieve the coefficients, truncated to a given degree and order.
+void MemoryMappedGravityFieldFile::getCoefficients(
+        const int maximumDegree, const int maximumOrder,
+        Eigen::MatrixXd& cosineCoefficients, Eigen::MatrixXd& sineCoefficients ) const
+{
+    if( maximumDegree < 0 || maximumOrder < 0 )
+    {
+        throw std::runtime_error( "Error when retrieving coefficients from binary gravity field file " + fileName_ +
+                                  ", requested maximum degree and order must be non-negative." );
+    }
+
+    cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+    sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+
+    // Copy only the coefficients of the requested degrees and orders (data of higher degrees is not accessed).
+    const int highestOrder = std::min( maximumOrder, maximumOrder_ );
+    for( int degree = 0; degree <= std::min( maximumDegree, maximumDegree_ ); degree++ )
+    {
+        const double* degreeCoefficients = coefficientData_ + 2 * getIndexOfDegree( degree );
+        for( int order = 0; order <= std::min( degree, highestOrder ); order++ )
+        {
+            cosineCoefficients( degree, order ) = degreeCoefficients[ 2 * order ];
+            sineCoefficients( degree, order ) = degreeCoefficients[ 2 * order + 1 ];
+        }
+    }
+}
+
+//! Function to compute the index of the first coefficient of a given degree in the data of the file.
+long long MemoryMappedGravityFieldFile::getIndexOfDegree( const int degree ) const
+{
+    // Up to degree maximumOrder_ + 1, degree n contains n + 1 orders, above it maximumOrder_ + 1 orders.
+    const long long numberOfFullDegrees = std::min( degree, maximumOrder_ + 1 );
+    return numberOfFullDegrees * ( numberOfFullDegrees + 1 ) / 2 +
+            static_cast< long long >( degree - numberOfFullDegrees ) * ( maximumOrder_ + 1 );
+}
+
+} // namespace input_output
+
+} // namespace tudat
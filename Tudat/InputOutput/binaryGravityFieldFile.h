@@ -0,0 +1,180 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BINARYGRAVITYFIELDFILE_H
+#define TUDAT_BINARYGRAVITYFIELDFILE_H
+
+#include <string>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace input_output
+{
+
+//! Function to write spherical harmonic gravity field coefficients to a binary file.
+/*!
+ *  Function to write spherical harmonic gravity field coefficients to a binary file, which can be loaded (truncated to
+ *  any degree and order) by a MemoryMappedGravityFieldFile. The file consists of a header of 64 bytes, containing the
+ *  identifier "TUDATSHG", the format version and a byte order mark (32-bit unsigned integers), the maximum degree and
+ *  order (32-bit integers), the gravitational parameter and reference radius (doubles, NaN if not available), padded
+ *  with zeros. The header is followed by the coefficients, stored degree by degree and, for each degree n, order by
+ *  order (up to the minimum of n and the maximum order) as pairs of cosine and sine coefficient. All data is stored in
+ *  the native byte order of the machine on which the file is written.
+ *  \param fileName Name of the binary file that is to be written.
+ *  \param cosineCoefficients Cosine coefficients (rows: degree, columns: order) that are to be written.
+ *  \param sineCoefficients Sine coefficients (rows: degree, columns: order) that are to be written.
+ *  \param gravitationalParameter Gravitational parameter of the gravity field (NaN if not available).
+ *  \param referenceRadius Reference radius of the gravity field (NaN if not available).
+ */
+void writeBinaryGravityFieldFile(
+        const std::string& fileName,
+        const Eigen::MatrixXd& cosineCoefficients,
+        const Eigen::MatrixXd& sineCoefficients,
+        const double gravitationalParameter = TUDAT_NAN,
+        const double referenceRadius = TUDAT_NAN );
+
+//! Function to check whether a file is a binary gravity field file.
+/*!
+ *  Function to check whether a file is a binary gravity field file, as written by writeBinaryGravityFieldFile, by
+ *  comparing the start of the file with the identifier of the format.
+ *  \param fileName Name of the file that is to be checked.
+ *  \return True if the file exists and starts with the identifier of the binary gravity field file format.
+ */
+bool isBinaryGravityFieldFile( const std::string& fileName );
+
+//! Class for loading spherical harmonic gravity field coefficients from a memory-mapped binary file.
+/*!
+ *  Class for loading spherical harmonic gravity field coefficients from a binary file, as written by
+ *  writeBinaryGravityFieldFile. The file is mapped read-only into memory, so that processes loading the same file
+ *  share the physical pages. Since the coefficients are stored degree by degree, only the parts of the file containing
+ *  the coefficients up to the requested degree and order are accessed (and therefore paged in) when retrieving a
+ *  truncated set of coefficients.
+ */
+class MemoryMappedGravityFieldFile
+{
+public:
+
+    //! Constructor, maps the file into memory and reads its header.
+    /*!
+     *  Constructor, maps the file into memory and reads its header.
+     *  \param fileName Name of the binary gravity field file.
+     */
+    MemoryMappedGravityFieldFile( const std::string& fileName );
+
+    //! Destructor, unmaps the file.
+    ~MemoryMappedGravityFieldFile( );
+
+    //! Function to retrieve the coefficients, truncated to a given degree and order.
+    /*!
+     *  Function to retrieve the coefficients, truncated to a given degree and order. Coefficients of degree and/or order
+     *  higher than those in the file are set to zero.
+     *  \param maximumDegree Maximum degree of the coefficients that are to be retrieved.
+     *  \param maximumOrder Maximum order of the coefficients that are to be retrieved.
+     *  \param cosineCoefficients Cosine coefficients, up to the requested degree and order (returned by reference).
+     *  \param sineCoefficients Sine coefficients, up to the requested degree and order (returned by reference).
+     */
+    void getCoefficients( const int maximumDegree, const int maximumOrder,
+                          Eigen::MatrixXd& cosineCoefficients, Eigen::MatrixXd& sineCoefficients ) const;
+
+    //! Function to retrieve the name of the binary gravity field file.
+    /*!
+     *  Function to retrieve the name of the binary gravity field file.
+     *  \return Name of the binary gravity field file.
+     */
+    std::string getFileName( ) const
+    {
+        return fileName_;
+    }
+
+    //! Function to retrieve the maximum degree of the coefficients in the file.
+    /*!
+     *  Function to retrieve the maximum degree of the coefficients in the file.
+     *  \return Maximum degree of the coefficients in the file.
+     */
+    int getMaximumDegree( ) const
+    {
+        return maximumDegree_;
+    }
+
+    //! Function to retrieve the maximum order of the coefficients in the file.
+    /*!
+     *  Function to retrieve the maximum order of the coefficients in the file.
+     *  \return Maximum order of the coefficients in the file.
+     */
+    int getMaximumOrder( ) const
+    {
+        return maximumOrder_;
+    }
+
+    //! Function to retrieve the gravitational parameter stored in the file.
+    /*!
+     *  Function to retrieve the gravitational parameter stored in the file.
+     *  \return Gravitational parameter stored in the file (NaN if not available).
+     */
+    double getGravitationalParameter( ) const
+    {
+        return gravitationalParameter_;
+    }
+
+    //! Function to retrieve the reference radius stored in the file.
+    /*!
+     *  Function to retrieve the reference radius stored in the file.
+     *  \return Reference radius stored in the file (NaN if not available).
+     */
+    double getReferenceRadius( ) const
+    {
+        return referenceRadius_;
+    }
+
+private:
+
+    //! Function to compute the index of the first coefficient of a given degree in the data of the file.
+    /*!
+     *  Function to compute the index (in number of cosine/sine coefficient pairs) of the first coefficient of a given
+     *  degree in the data of the file.
+     *  \param degree Degree of which the index of the first coefficient is to be computed.
+     *  \return Index of the first coefficient of the given degree.
+     */
+    long long getIndexOfDegree( const int degree ) const;
+
+    //! Name of the binary gravity field file.
+    std::string fileName_;
+
+    //! Memory-mapped binary gravity field file.
+    boost::iostreams::mapped_file_source mappedFile_;
+
+    //! Pointer to the (interleaved cosine and sine) coefficients in the mapped file.
+    const double* coefficientData_;
+
+    //! Maximum degree of the coefficients in the file.
+    int maximumDegree_;
+
+    //! Maximum order of the coefficients in the file.
+    int maximumOrder_;
+
+    //! Gravitational parameter stored in the file.
+    double gravitationalParameter_;
+
+    //! Reference radius stored in the file.
+    double referenceRadius_;
+};
+
+} // namespace input_output
+
+} // namespace tudat
+
+#endif // TUDAT_BINARYGRAVITYFIELDFILE_H
@@ -29,6 +29,8 @@ static std::map< AvailableIntegrators, std::string > integratorTypes =
     { rungeKuttaVariableStepSize, "rungeKuttaVariableStepSize" },
     { adamsBashforthMoulton, "adamsBashforthMoulton" },
     { bulirschStoer, "bulirschStoer" },
+    { gaussJackson, "gaussJackson" },
+    { rungeKuttaNystromVariableStepSize, "rungeKuttaNystromVariableStepSize" },
 };
 
 //! `AvailableIntegrators` not supported by `json_interface`.
@@ -53,7 +55,8 @@ static std::map< RungeKuttaCoefficients::CoefficientSets, std::string > rungeKut
     { RungeKuttaCoefficients::rungeKuttaFehlberg45, "rungeKuttaFehlberg45" },
     { RungeKuttaCoefficients::rungeKuttaFehlberg56, "rungeKuttaFehlberg56" },
     { RungeKuttaCoefficients::rungeKuttaFehlberg78, "rungeKuttaFehlberg78" },
-    { RungeKuttaCoefficients::rungeKutta87DormandPrince, "rungeKutta87DormandPrince" }
+    { RungeKuttaCoefficients::rungeKutta87DormandPrince, "rungeKutta87DormandPrince" },
+    { RungeKuttaCoefficients::rungeKutta54DormandPrince, "rungeKutta54DormandPrince" }
 };
 
 //! `RungeKuttaCoefficients::CoefficientSets` not supported by `json_interface`.
@@ -73,6 +76,31 @@ inline void from_json( const nlohmann::json& jsonObject, RungeKuttaCoefficients:
 }
 
 
+//! Map of `RungeKuttaNystromCoefficients::CoefficientSets` string representations.
+static std::map< RungeKuttaNystromCoefficients::CoefficientSets, std::string > rungeKuttaNystromCoefficientSets =
+{
+    { RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince, "rungeKuttaNystrom64DormandElMikkawyPrince" }
+};
+
+//! `RungeKuttaNystromCoefficients::CoefficientSets` not supported by `json_interface`.
+static std::vector< RungeKuttaNystromCoefficients::CoefficientSets > unsupportedRungeKuttaNystromCoefficientSets = { };
+
+//! Convert `RungeKuttaNystromCoefficients::CoefficientSets` to `json`.
+inline void to_json( nlohmann::json& jsonObject,
+                     const RungeKuttaNystromCoefficients::CoefficientSets& rungeKuttaNystromCoefficientSet )
+{
+    jsonObject = json_interface::stringFromEnum( rungeKuttaNystromCoefficientSet, rungeKuttaNystromCoefficientSets );
+}
+
+//! Convert `json` to `RungeKuttaNystromCoefficients::CoefficientSets`.
+inline void from_json( const nlohmann::json& jsonObject,
+                       RungeKuttaNystromCoefficients::CoefficientSets& rungeKuttaNystromCoefficientSet )
+{
+    rungeKuttaNystromCoefficientSet =
+            json_interface::enumFromString( jsonObject, rungeKuttaNystromCoefficientSets );
+}
+
+
 //! Create a `json` object from a shared pointer to an `IntegratorSettings` object.
 template< typename TimeType >
 void to_json( nlohmann::json& jsonObject, const std::shared_ptr< IntegratorSettings< TimeType > >& integratorSettings )
@@ -125,6 +153,11 @@ void to_json( nlohmann::json& jsonObject, const std::shared_ptr< IntegratorSetti
                     scalarTolerancesIntegratorSettings->maximumFactorIncreaseForNextStepSize_;
             jsonObject[ K::minimumFactorDecreaseForNextStepSize ] =
                     scalarTolerancesIntegratorSettings->minimumFactorDecreaseForNextStepSize_;
+            if ( scalarTolerancesIntegratorSettings->denseOutputSaveInterval_ ==
+                 scalarTolerancesIntegratorSettings->denseOutputSaveInterval_ )
+            {
+                jsonObject[ K::denseOutputSaveInterval ] = scalarTolerancesIntegratorSettings->denseOutputSaveInterval_;
+            }
         }
         else
         {
@@ -169,6 +202,53 @@ void to_json( nlohmann::json& jsonObject, const std::shared_ptr< IntegratorSetti
 
         return;
     }
+    case gaussJackson:
+    {
+        std::shared_ptr< GaussJacksonSettings< TimeType > > gaussJacksonSettings =
+                std::dynamic_pointer_cast< GaussJacksonSettings< TimeType > >( integratorSettings );
+        assertNonnullptrPointer( gaussJacksonSettings );
+        jsonObject[ K::correctorConvergenceTolerance ] = gaussJacksonSettings->correctorConvergenceTolerance_;
+        jsonObject[ K::maximumNumberOfCorrectorIterations ] = gaussJacksonSettings->maximumNumberOfCorrectorIterations_;
+
+        // Variable step size settings are identified by the presence of the minimum step size
+        std::shared_ptr< GaussJacksonVariableStepSizeSettings< TimeType > > variableStepSizeSettings =
+                std::dynamic_pointer_cast< GaussJacksonVariableStepSizeSettings< TimeType > >( integratorSettings );
+        if ( variableStepSizeSettings )
+        {
+            jsonObject[ K::initialStepSize ] = variableStepSizeSettings->initialTimeStep_;
+            jsonObject[ K::minimumStepSize ] = variableStepSizeSettings->minimumStepSize_;
+            jsonObject[ K::maximumStepSize ] = variableStepSizeSettings->maximumStepSize_;
+            jsonObject[ K::relativeErrorTolerance ] = variableStepSizeSettings->relativeErrorTolerance_;
+            jsonObject[ K::absoluteErrorTolerance ] = variableStepSizeSettings->absoluteErrorTolerance_;
+            jsonObject[ K::bandwidth ] = variableStepSizeSettings->bandwidth_;
+        }
+        else
+        {
+            jsonObject[ K::stepSize ] = gaussJacksonSettings->initialTimeStep_;
+        }
+        return;
+    }
+    case rungeKuttaNystromVariableStepSize:
+    {
+        std::shared_ptr< RungeKuttaNystromVariableStepSizeSettings< TimeType > > rungeKuttaNystromSettings =
+                std::dynamic_pointer_cast< RungeKuttaNystromVariableStepSizeSettings< TimeType > >( integratorSettings );
+        assertNonnullptrPointer( rungeKuttaNystromSettings );
+        jsonObject[ K::rungeKuttaNystromCoefficientSet ] =
+                stringFromEnum( rungeKuttaNystromSettings->coefficientSet_, rungeKuttaNystromCoefficientSets );
+        jsonObject[ K::initialStepSize ] = rungeKuttaNystromSettings->initialTimeStep_;
+        jsonObject[ K::minimumStepSize ] = rungeKuttaNystromSettings->minimumStepSize_;
+        jsonObject[ K::maximumStepSize ] = rungeKuttaNystromSettings->maximumStepSize_;
+        jsonObject[ K::relativeErrorTolerance ] = rungeKuttaNystromSettings->relativeErrorTolerance_;
+        jsonObject[ K::absoluteErrorTolerance ] = rungeKuttaNystromSettings->absoluteErrorTolerance_;
+        jsonObject[ K::safetyFactorForNextStepSize ] = rungeKuttaNystromSettings->safetyFactorForNextStepSize_;
+        jsonObject[ K::maximumFactorIncreaseForNextStepSize ] =
+                rungeKuttaNystromSettings->maximumFactorIncreaseForNextStepSize_;
+        jsonObject[ K::minimumFactorDecreaseForNextStepSize ] =
+                rungeKuttaNystromSettings->minimumFactorDecreaseForNextStepSize_;
+        jsonObject[ K::areAccelerationsVelocityIndependent ] =
+                rungeKuttaNystromSettings->areAccelerationsVelocityIndependent_;
+        return;
+    }
     default:
         handleUnimplementedEnumValue( integratorType, integratorTypes, unsupportedIntegratorTypes );
     }
@@ -229,6 +309,8 @@ void from_json( const nlohmann::json& jsonObject, std::shared_ptr< IntegratorSet
                                   defaults.maximumFactorIncreaseForNextStepSize_ ),
                         getValue( jsonObject, K::minimumFactorDecreaseForNextStepSize,
                                   defaults.minimumFactorDecreaseForNextStepSize_ ) );
+            integratorSettings->denseOutputSaveInterval_ =
+                    getValue( jsonObject, K::denseOutputSaveInterval, defaults.denseOutputSaveInterval_ );
         }
         else
         {
@@ -284,6 +366,72 @@ void from_json( const nlohmann::json& jsonObject, std::shared_ptr< IntegratorSet
                               defaults.minimumFactorDecreaseForNextStepSize_ ) );
         return;
     }
+    case gaussJackson:
+    {
+        // Variable step size settings are identified by the presence of the minimum step size
+        if ( isDefined( jsonObject, K::minimumStepSize ) )
+        {
+            GaussJacksonVariableStepSizeSettings< TimeType > defaults( 0.0, 0.0, 0.0, 0.0 );
+
+            integratorSettings = std::make_shared< GaussJacksonVariableStepSizeSettings< TimeType > >(
+                        initialTime,
+                        getValue< TimeType >( jsonObject, K::initialStepSize ),
+                        getValue< TimeType >( jsonObject, K::minimumStepSize ),
+                        getValue< TimeType >( jsonObject, K::maximumStepSize ),
+                        getValue( jsonObject, K::relativeErrorTolerance, defaults.relativeErrorTolerance_ ),
+                        getValue( jsonObject, K::absoluteErrorTolerance, defaults.absoluteErrorTolerance_ ),
+                        getValue( jsonObject, K::saveFrequency, defaults.saveFrequency_ ),
+                        getValue( jsonObject, K::assessPropagationTerminationConditionDuringIntegrationSubsteps,
+                                  defaults.assessPropagationTerminationConditionDuringIntegrationSubsteps_ ),
+                        getValue( jsonObject, K::bandwidth, defaults.bandwidth_ ),
+                        getValue( jsonObject, K::correctorConvergenceTolerance,
+                                  defaults.correctorConvergenceTolerance_ ),
+                        getValue( jsonObject, K::maximumNumberOfCorrectorIterations,
+                                  defaults.maximumNumberOfCorrectorIterations_ ) );
+        }
+        else
+        {
+            GaussJacksonSettings< TimeType > defaults( 0.0, 0.0 );
+
+            integratorSettings = std::make_shared< GaussJacksonSettings< TimeType > >(
+                        initialTime,
+                        getValue< TimeType >( jsonObject, K::stepSize ),
+                        getValue( jsonObject, K::saveFrequency, defaults.saveFrequency_ ),
+                        getValue( jsonObject, K::assessPropagationTerminationConditionDuringIntegrationSubsteps,
+                                  defaults.assessPropagationTerminationConditionDuringIntegrationSubsteps_ ),
+                        getValue( jsonObject, K::correctorConvergenceTolerance,
+                                  defaults.correctorConvergenceTolerance_ ),
+                        getValue( jsonObject, K::maximumNumberOfCorrectorIterations,
+                                  defaults.maximumNumberOfCorrectorIterations_ ) );
+        }
+        return;
+    }
+    case rungeKuttaNystromVariableStepSize:
+    {
+        RungeKuttaNystromVariableStepSizeSettings< TimeType > defaults(
+                    0.0, 0.0, RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince, 0.0, 0.0 );
+
+        integratorSettings = std::make_shared< RungeKuttaNystromVariableStepSizeSettings< TimeType > >(
+                    initialTime,
+                    getValue< TimeType >( jsonObject, K::initialStepSize ),
+                    getValue( jsonObject, K::rungeKuttaNystromCoefficientSet, defaults.coefficientSet_ ),
+                    getValue< TimeType >( jsonObject, K::minimumStepSize ),
+                    getValue< TimeType >( jsonObject, K::maximumStepSize ),
+                    getValue( jsonObject, K::relativeErrorTolerance, defaults.relativeErrorTolerance_ ),
+                    getValue( jsonObject, K::absoluteErrorTolerance, defaults.absoluteErrorTolerance_ ),
+                    getValue( jsonObject, K::saveFrequency, defaults.saveFrequency_ ),
+                    getValue( jsonObject, K::assessPropagationTerminationConditionDuringIntegrationSubsteps,
+                              defaults.assessPropagationTerminationConditionDuringIntegrationSubsteps_ ),
+                    getValue( jsonObject, K::safetyFactorForNextStepSize,
+                              defaults.safetyFactorForNextStepSize_ ),
+                    getValue( jsonObject, K::maximumFactorIncreaseForNextStepSize,
+                              defaults.maximumFactorIncreaseForNextStepSize_ ),
+                    getValue( jsonObject, K::minimumFactorDecreaseForNextStepSize,
+                              defaults.minimumFactorDecreaseForNextStepSize_ ),
+                    getValue( jsonObject, K::areAccelerationsVelocityIndependent,
+                              defaults.areAccelerationsVelocityIndependent_ ) );
+        return;
+    }
     default:
         handleUnimplementedEnumValue( integratorType, integratorTypes, unsupportedIntegratorTypes );
     }
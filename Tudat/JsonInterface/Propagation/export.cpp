@@ -14,6 +14,22 @@
 namespace tudat
 {
 
+namespace propagators
+{
+
+//! Create a `json` object from a `ProfiledFunctionStatistics` object.
+void to_json( nlohmann::json& jsonObject, const ProfiledFunctionStatistics& profiledFunctionStatistics )
+{
+    using K = json_interface::Keys::ProfiledFunction;
+
+    jsonObject[ K::type ] = getProfiledFunctionTypeName( profiledFunctionStatistics.functionType_ );
+    jsonObject[ K::id ] = profiledFunctionStatistics.functionId_;
+    jsonObject[ K::wallTime ] = profiledFunctionStatistics.cumulativeWallTime_;
+    jsonObject[ K::numberOfCalls ] = profiledFunctionStatistics.numberOfCalls_;
+}
+
+} // namespace propagators
+
 namespace json_interface
 {
 
@@ -54,6 +70,22 @@ void from_json( const nlohmann::json& jsonObject, std::shared_ptr< ExportSetting
 
 }
 
+//! Export the computation time statistics of the models evaluated during a propagation to a JSON file.
+void exportPropagationProfilingReport(
+        const std::vector< propagators::ProfiledFunctionStatistics >& profilingReport,
+        const boost::filesystem::path& exportPath )
+{
+    if ( ! exportPath.parent_path( ).empty( ) && ! boost::filesystem::exists( exportPath.parent_path( ) ) )
+    {
+        boost::filesystem::create_directories( exportPath.parent_path( ) );
+    }
+
+    nlohmann::json jsonObject = profilingReport;
+    std::ofstream outputFile( exportPath.string( ) );
+    outputFile << jsonObject.dump( 2 );
+    outputFile.close( );
+}
+
 } // namespace simulation_setup
 
 } // namespace tudat
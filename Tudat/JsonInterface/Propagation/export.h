@@ -21,6 +21,14 @@
 namespace tudat
 {
 
+namespace propagators
+{
+
+//! Create a `json` object from a `ProfiledFunctionStatistics` object.
+void to_json( nlohmann::json& jsonObject, const ProfiledFunctionStatistics& profiledFunctionStatistics );
+
+} // namespace propagators
+
 namespace json_interface
 {
 
@@ -358,6 +366,16 @@ void exportResultsOfVariationalEquations(
     }
 }
 
+//! Export the computation time statistics of the models evaluated during a propagation to a JSON file.
+/*!
+ * @copybrief exportPropagationProfilingReport
+ * \param profilingReport Computation time statistics of the models evaluated during the propagation, as retrieved
+ * from SingleArcDynamicsSimulator::getPropagationProfilingReport.
+ * \param exportPath Path to which the report is to be exported.
+ */
+void exportPropagationProfilingReport(
+        const std::vector< propagators::ProfiledFunctionStatistics >& profilingReport,
+        const boost::filesystem::path& exportPath );
 
 } // namespace json_interface
 
@@ -429,7 +429,9 @@ const std::string Keys::Integrator::stepSize = "stepSize";
 const std::string Keys::Integrator::initialStepSize = "initialStepSize";
 const std::string Keys::Integrator::saveFrequency = "saveFrequency";
 const std::string Keys::Integrator::assessPropagationTerminationConditionDuringIntegrationSubsteps = "assessPropagationTerminationConditionDuringIntegrationSubsteps";
+const std::string Keys::Integrator::denseOutputSaveInterval = "denseOutputSaveInterval";
 const std::string Keys::Integrator::rungeKuttaCoefficientSet = "rungeKuttaCoefficientSet";
+const std::string Keys::Integrator::rungeKuttaNystromCoefficientSet = "rungeKuttaNystromCoefficientSet";
 const std::string Keys::Integrator::minimumStepSize = "minimumStepSize";
 const std::string Keys::Integrator::maximumStepSize = "maximumStepSize";
 const std::string Keys::Integrator::relativeErrorTolerance = "relativeErrorTolerance";
@@ -443,6 +445,9 @@ const std::string Keys::Integrator::extrapolationSequence = "extrapolationSequen
 const std::string Keys::Integrator::maximumNumberOfSteps = "maximumNumberOfSteps";
 const std::string Keys::Integrator::maximumOrder = "maximumOrder";
 const std::string Keys::Integrator::minimumOrder = "minimumOrder";
+const std::string Keys::Integrator::correctorConvergenceTolerance = "correctorConvergenceTolerance";
+const std::string Keys::Integrator::maximumNumberOfCorrectorIterations = "maximumNumberOfCorrectorIterations";
+const std::string Keys::Integrator::areAccelerationsVelocityIndependent = "areAccelerationsVelocityIndependent";
 
 //  Interpolation
 
@@ -482,6 +487,10 @@ const std::string Keys::Export::onlyInitialStep = "onlyInitialStep";
 const std::string Keys::Export::onlyFinalStep = "onlyFinalStep";
 const std::string Keys::Export::numericalPrecision = "numericalPrecision";
 const std::string Keys::Export::printVariableIndicesToTerminal = "printVariableIndicesToTerminal";
+const std::string Keys::ProfiledFunction::type = "type";
+const std::string Keys::ProfiledFunction::id = "id";
+const std::string Keys::ProfiledFunction::wallTime = "wallTime";
+const std::string Keys::ProfiledFunction::numberOfCalls = "numberOfCalls";
 
 //  Options
 const std::string Keys::options = "options";
@@ -492,6 +501,7 @@ const std::string Keys::Options::defaultValueUsedForMissingKey = "defaultValueUs
 const std::string Keys::Options::unusedKey = "unusedKey";
 const std::string Keys::Options::fullSettingsFile = "fullSettingsFile";
 const std::string Keys::Options::tagOutputFilesIfPropagationFails = "tagOutputFilesIfPropagationFails";
+const std::string Keys::Options::profilingReportFile = "profilingReportFile";
 
 
 // KEYPATH
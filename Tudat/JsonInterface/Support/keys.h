@@ -457,7 +457,9 @@ struct Keys
         static const std::string initialStepSize;
         static const std::string saveFrequency;
         static const std::string assessPropagationTerminationConditionDuringIntegrationSubsteps;
+        static const std::string denseOutputSaveInterval;
         static const std::string rungeKuttaCoefficientSet;
+        static const std::string rungeKuttaNystromCoefficientSet;
         static const std::string minimumStepSize;
         static const std::string maximumStepSize;
         static const std::string relativeErrorTolerance;
@@ -471,6 +473,9 @@ struct Keys
         static const std::string maximumNumberOfSteps;
         static const std::string minimumOrder;
         static const std::string maximumOrder;
+        static const std::string correctorConvergenceTolerance;
+        static const std::string maximumNumberOfCorrectorIterations;
+        static const std::string areAccelerationsVelocityIndependent;
     };
 
     struct Interpolation
@@ -522,6 +527,14 @@ struct Keys
         static const std::string printVariableIndicesToTerminal;
     };
 
+    struct ProfiledFunction
+    {
+        static const std::string type;
+        static const std::string id;
+        static const std::string wallTime;
+        static const std::string numberOfCalls;
+    };
+
     static const std::string options;
     struct Options
     {
@@ -532,6 +545,7 @@ struct Keys
         static const std::string unusedKey;
         static const std::string fullSettingsFile;
         static const std::string tagOutputFilesIfPropagationFails;
+        static const std::string profilingReportFile;
     };
 };
 
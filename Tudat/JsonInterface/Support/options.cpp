@@ -32,6 +32,7 @@ void to_json( nlohmann::json& jsonObject, const std::shared_ptr< ApplicationOpti
     jsonObject[ K::unusedKey ] = applicationOptions->unusedKey_;
     assignIfNotEmpty( jsonObject, K::fullSettingsFile, applicationOptions->fullSettingsFile_ );
     jsonObject[ K::tagOutputFilesIfPropagationFails ] = applicationOptions->tagOutputFilesIfPropagationFails_;
+    assignIfNotEmpty( jsonObject, K::profilingReportFile, applicationOptions->profilingReportFile_ );
 }
 
 //! Create a shared pointer to a `ApplicationOptions` object from a `json` object.
@@ -55,6 +56,8 @@ void from_json( const nlohmann::json& jsonObject, std::shared_ptr< ApplicationOp
 
     updateFromJSONIfDefined( applicationOptions->tagOutputFilesIfPropagationFails_,
                              jsonObject, K::tagOutputFilesIfPropagationFails );
+
+    updateFromJSONIfDefined( applicationOptions->profilingReportFile_, jsonObject, K::profilingReportFile );
 }
 
 } // namespace json_interface
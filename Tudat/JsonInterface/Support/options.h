@@ -71,6 +71,10 @@ public:
     //! Whether the generated output files should contain the line "FAILURE" if the propagation terminates before
     //! reaching the termination condition.
     bool tagOutputFilesIfPropagationFails_ = true;
+
+    //! Path where the profiling report (containing the computation time spent in each of the models evaluated during
+    //! the propagation) is going to be saved. Empty string if the propagation should not be profiled.
+    boost::filesystem::path profilingReportFile_ = "";
 };
 
 //! Create a `json` object from a shared pointer to a `ApplicationOptions` object.
@@ -200,6 +200,91 @@ BOOST_AUTO_TEST_CASE( test_json_integrator_bulirschStoer )
     BOOST_CHECK_EQUAL_JSON( fromFileSettings, manualSettings );
 }
 
+// Test 7: gaussJackson (fixed step size)
+BOOST_AUTO_TEST_CASE( test_json_integrator_gaussJackson )
+{
+    using namespace tudat::numerical_integrators;
+    using namespace tudat::json_interface;
+
+    // Create IntegratorSettings from JSON file
+    const std::shared_ptr< IntegratorSettings< double > > fromFileSettings =
+            parseJSONFile< std::shared_ptr< IntegratorSettings< double > > >( INPUT( "gaussJackson" ) );
+
+    // Create IntegratorSettings manually
+    const double initialTime = -0.3;
+    const double stepSize = 1.4;
+    const unsigned int maximumNumberOfCorrectorIterations = 3;
+    const std::shared_ptr< IntegratorSettings< double > > manualSettings =
+            std::make_shared< GaussJacksonSettings< double > >(
+                initialTime, stepSize, 1, false, 1.0E-13, maximumNumberOfCorrectorIterations );
+
+    // Compare
+    BOOST_CHECK_EQUAL_JSON( fromFileSettings, manualSettings );
+}
+
+// Test 8: gaussJackson (variable step size)
+BOOST_AUTO_TEST_CASE( test_json_integrator_gaussJacksonVariableStepSize )
+{
+    using namespace tudat::numerical_integrators;
+    using namespace tudat::json_interface;
+
+    // Create IntegratorSettings from JSON file
+    const std::shared_ptr< IntegratorSettings< double > > fromFileSettings =
+            parseJSONFile< std::shared_ptr< IntegratorSettings< double > > >( INPUT( "gaussJacksonVariableStepSize" ) );
+
+    // Create IntegratorSettings manually
+    const double initialTime = -0.3;
+    const double initialStepSize = 1.4;
+    const double minimumStepSize = 0.4;
+    const double maximumStepSize = 2.4;
+    const double relativeErrorTolerance = 1.0E-4;
+    const double absoluteErrorTolerance = 1.0E-2;
+    const double correctorConvergenceTolerance = 1.0E-10;
+    const std::shared_ptr< IntegratorSettings< double > > manualSettings =
+            std::make_shared< GaussJacksonVariableStepSizeSettings< double > >(
+                initialTime, initialStepSize, minimumStepSize, maximumStepSize,
+                relativeErrorTolerance, absoluteErrorTolerance, 1, false, 1024.0, correctorConvergenceTolerance );
+
+    // Compare
+    BOOST_CHECK_EQUAL_JSON( fromFileSettings, manualSettings );
+}
+
+// Test 9: Runge-Kutta-Nystrom coefficient sets
+BOOST_AUTO_TEST_CASE( test_json_integrator_rknsets )
+{
+    BOOST_CHECK_EQUAL_ENUM( INPUT( "rknsets" ),
+                            numerical_integrators::rungeKuttaNystromCoefficientSets,
+                            numerical_integrators::unsupportedRungeKuttaNystromCoefficientSets );
+}
+
+// Test 10: rungeKuttaNystromVariableStepSize
+BOOST_AUTO_TEST_CASE( test_json_integrator_rungeKuttaNystromVariableStepSize )
+{
+    using namespace tudat::numerical_integrators;
+    using namespace tudat::json_interface;
+
+    // Create IntegratorSettings from JSON file
+    const std::shared_ptr< IntegratorSettings< double > > fromFileSettings =
+            parseJSONFile< std::shared_ptr< IntegratorSettings< double > > >( INPUT( "rungeKuttaNystromVariableStepSize" ) );
+
+    // Create IntegratorSettings manually
+    const double initialTime = -0.3;
+    const double initialStepSize = 1.4;
+    const double minimumStepSize = 0.4;
+    const double maximumStepSize = 2.4;
+    const double relativeErrorTolerance = 1.0E-4;
+    const double absoluteErrorTolerance = 1.0E-2;
+    const double maximumFactorIncreaseForNextStepSize = 3.0;
+    const std::shared_ptr< IntegratorSettings< double > > manualSettings =
+            std::make_shared< RungeKuttaNystromVariableStepSizeSettings< double > >(
+                initialTime, initialStepSize, RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince,
+                minimumStepSize, maximumStepSize, relativeErrorTolerance, absoluteErrorTolerance, 1, false, 0.8,
+                maximumFactorIncreaseForNextStepSize, 0.1, true );
+
+    // Compare
+    BOOST_CHECK_EQUAL_JSON( fromFileSettings, manualSettings );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -130,6 +130,9 @@ public:
 
     virtual void createSimulationObjects( )
     {
+        // Record computation time of models during propagation, if profiling report is to be exported
+        propagatorSettings_->setProfilePropagation( ! applicationOptions_->profilingReportFile_.empty( ) );
+
         resetDynamicsSimulator( );
     }
 
@@ -240,6 +243,13 @@ public:
         exportResultsOfDynamicsSimulator( dynamicsSimulator_, exportSettingsVector_,
                                           !( simulationType_ == equations_of_motion_propagation ) );
 
+        // Export profiling report if requested
+        if ( ! applicationOptions_->profilingReportFile_.empty( ) )
+        {
+            exportPropagationProfilingReport( dynamicsSimulator_->getPropagationProfilingReport( ),
+                                              applicationOptions_->profilingReportFile_ );
+        }
+
         if ( profiling )
         {
             std::cout << "exportResults: " << std::chrono::duration_cast< std::chrono::milliseconds >(
@@ -21,6 +21,9 @@
 
 #define BOOST_TEST_MAIN
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -274,6 +277,130 @@ BOOST_AUTO_TEST_CASE( test_Legendre_GeodesyLegendrePolynomialDerivative )
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedValues, computedTestValues, 1.0e-14 );
 }
 
+//! Test Legendre cache (computed for all orders of a degree at once) against element-wise computation.
+BOOST_AUTO_TEST_CASE( test_LegendreCacheColumnRecursion )
+{
+    using namespace basic_mathematics;
+
+    for( bool useGeodesyNormalization : { true, false } )
+    {
+        // Test full and truncated (in order) caches, at various latitudes (including close to the pole)
+        for( std::pair< int, int > degreeAndOrder : { std::make_pair( 2, 2 ), std::make_pair( 30, 30 ),
+                                                      std::make_pair( 40, 7 ), std::make_pair( 12, 0 ) } )
+        {
+            int maximumDegree = degreeAndOrder.first;
+            int maximumOrder = degreeAndOrder.second;
+
+            LegendreCache legendreCache( maximumDegree, maximumOrder, useGeodesyNormalization );
+            legendreCache.setComputeSecondDerivatives( true );
+
+            for( double polynomialParameter : { 0.5, -0.83, 0.0, 0.999, 1.0E-3 } )
+            {
+                legendreCache.update( polynomialParameter );
+
+                // Compute Legendre polynomials element-wise, up to two orders above maximum order
+                Eigen::MatrixXd expectedPolynomials = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 3 );
+                for( int n = 0; n <= maximumDegree; n++ )
+                {
+                    for( int m = 0; m <= n; m++ )
+                    {
+                        if( n <= 1 )
+                        {
+                            expectedPolynomials( n, m ) = useGeodesyNormalization ?
+                                        computeGeodesyLegendrePolynomialExplicit( n, m, polynomialParameter ) :
+                                        computeLegendrePolynomialExplicit( n, m, polynomialParameter );
+                        }
+                        else if( n == m )
+                        {
+                            expectedPolynomials( n, m ) = useGeodesyNormalization ?
+                                        computeGeodesyLegendrePolynomialDiagonal(
+                                            n, expectedPolynomials( 1, 1 ), expectedPolynomials( n - 1, m - 1 ) ) :
+                                        computeLegendrePolynomialDiagonal(
+                                            n, expectedPolynomials( 1, 1 ), expectedPolynomials( n - 1, m - 1 ) );
+                        }
+                        else
+                        {
+                            expectedPolynomials( n, m ) = useGeodesyNormalization ?
+                                        computeGeodesyLegendrePolynomialVertical(
+                                            n, m, polynomialParameter, expectedPolynomials( n - 1, m ),
+                                            expectedPolynomials( n - 2, m ) ) :
+                                        computeLegendrePolynomialVertical(
+                                            n, m, polynomialParameter, expectedPolynomials( n - 1, m ),
+                                            expectedPolynomials( n - 2, m ) );
+                        }
+                    }
+                }
+
+                // Compute first derivatives element-wise, up to one order above maximum order
+                Eigen::MatrixXd expectedDerivatives = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 2 );
+                for( int n = 0; n <= maximumDegree; n++ )
+                {
+                    for( int m = 0; m <= n; m++ )
+                    {
+                        expectedDerivatives( n, m ) = useGeodesyNormalization ?
+                                    computeGeodesyLegendrePolynomialDerivative(
+                                        n, m, polynomialParameter, expectedPolynomials( n, m ),
+                                        expectedPolynomials( n, m + 1 ) ) :
+                                    computeLegendrePolynomialDerivative(
+                                        m, polynomialParameter, expectedPolynomials( n, m ),
+                                        expectedPolynomials( n, m + 1 ) );
+                    }
+                }
+
+                // Compare values from cache to element-wise values (including derivatives at maximum order)
+                for( int n = 0; n <= maximumDegree; n++ )
+                {
+                    for( int m = 0; m <= std::min( n, maximumOrder ); m++ )
+                    {
+                        // Define tolerances relative to magnitude of terms (large for unnormalized polynomials)
+                        double polynomialMagnitude = std::max(
+                                    { 1.0, std::fabs( expectedPolynomials( n, m ) ),
+                                      std::fabs( expectedPolynomials( n, m + 1 ) ) } );
+                        double derivativeMagnitude = std::max(
+                                    { polynomialMagnitude, std::fabs( expectedDerivatives( n, m ) ),
+                                      std::fabs( expectedDerivatives( n, m + 1 ) ) } );
+
+                        BOOST_CHECK_SMALL( legendreCache.getLegendrePolynomial( n, m ) - expectedPolynomials( n, m ),
+                                           1.0E-11 * polynomialMagnitude );
+                        BOOST_CHECK_SMALL( legendreCache.getLegendrePolynomialDerivative( n, m ) -
+                                           expectedDerivatives( n, m ), 1.0E-11 * derivativeMagnitude );
+
+                        double normalizationCorrection = 1.0;
+                        if( useGeodesyNormalization )
+                        {
+                            normalizationCorrection = std::sqrt( static_cast< double >( ( n + m + 1 ) * ( n - m ) ) ) *
+                                    ( ( m == 0 ) ? std::sqrt( 0.5 ) : 1.0 );
+                        }
+                        double expectedSecondDerivative = computeGeodesyLegendrePolynomialSecondDerivative(
+                                    n, m, polynomialParameter, expectedPolynomials( n, m ),
+                                    expectedPolynomials( n, m + 1 ), expectedDerivatives( n, m ),
+                                    expectedDerivatives( n, m + 1 ), normalizationCorrection );
+                        BOOST_CHECK_SMALL( legendreCache.getLegendrePolynomialSecondDerivative( n, m ) -
+                                           expectedSecondDerivative,
+                                           1.0E-10 * std::max( derivativeMagnitude, std::fabs( expectedSecondDerivative ) ) );
+                    }
+                }
+            }
+        }
+    }
+
+    // Check that geodesy-normalized polynomials remain finite at high degree close to the pole, where the
+    // polynomials divided by the m-th power of the cosine of latitude are used in the recursion
+    LegendreCache legendreCache( 1000, 1000, true );
+    legendreCache.update( std::sin( 89.9 * mathematical_constants::PI / 180.0 ) );
+    for( int n = 990; n <= 1000; n++ )
+    {
+        for( int m = 0; m <= n; m++ )
+        {
+            BOOST_CHECK_EQUAL( std::isfinite( legendreCache.getLegendrePolynomial( n, m ) ), true );
+        }
+    }
+    BOOST_CHECK_EQUAL( legendreCache.getLegendrePolynomial( 1000, 1000 ), 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( legendreCache.getLegendrePolynomial( 1000, 0 ),
+                                computeGeodesyLegendrePolynomial( 1000, 0, legendreCache.getCurrentPolynomialParameter( ) ),
+                                1.0E-10 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
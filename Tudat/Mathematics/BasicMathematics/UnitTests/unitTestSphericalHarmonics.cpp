@@ -11,6 +11,8 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -212,6 +214,27 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_PotentialGradient )
 
 }
 
+//! Test sines and cosines of multiples of longitude, computed by recurrence in spherical harmonics cache.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_CacheMultipleLongitudes )
+{
+    basic_mathematics::SphericalHarmonicsCache sphericalHarmonicsCache( 360, 360 );
+
+    // Compute reference values in extended precision, to prevent rounding errors in order times longitude
+    for( double longitude : { 0.0, 1.0E-8, 0.3, -2.1, 3.14159, 7.5 } )
+    {
+        sphericalHarmonicsCache.update( 7.0E6, 0.2, longitude, 6.378E6 );
+        for( int m = 0; m <= 360; m++ )
+        {
+            BOOST_CHECK_SMALL( sphericalHarmonicsCache.getSineOfMultipleLongitude( m ) -
+                               static_cast< double >(
+                                   std::sin( static_cast< long double >( m ) * longitude ) ), 1.0E-13 );
+            BOOST_CHECK_SMALL( sphericalHarmonicsCache.getCosineOfMultipleLongitude( m ) -
+                               static_cast< double >(
+                                   std::cos( static_cast< long double >( m ) * longitude ) ), 1.0E-13 );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -9,6 +9,7 @@
  *
  */
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -25,19 +26,51 @@ namespace basic_mathematics
 
 
 
-//! Default constructor, initializes cache object with 0 maximum degree and order.
-LegendreCache::LegendreCache( const bool useGeodesyNormalization )
+//! Compute Legendre polynomials up to given degree and order by column recursion, for all orders of a degree at once.
+void computeLegendrePolynomialsByColumnRecursion(
+        const int maximumDegree, const int highestComputedOrder, const int numberOfStoredOrders,
+        const double polynomialParameter, const double sectoralMultiplier,
+        const double* firstRecursionCoefficients, const double* secondRecursionCoefficients,
+        const double* sectoralRecursionCoefficients, double* legendrePolynomials )
 {
-    useGeodesyNormalization_  = useGeodesyNormalization;
+    typedef Eigen::Map< Eigen::ArrayXd > DegreeSegment;
+    typedef Eigen::Map< const Eigen::ArrayXd > ConstantDegreeSegment;
 
-    if( useGeodesyNormalization_ )
+    const int stride = numberOfStoredOrders;
+
+    legendrePolynomials[ 0 ] = 1.0;
+    if( maximumDegree > 0 )
     {
-        legendrePolynomialFunction_ = geodesyNormalizedLegendrePolynomialFunction;
+        legendrePolynomials[ stride ] = firstRecursionCoefficients[ stride ] * polynomialParameter;
+        if( highestComputedOrder > 0 )
+        {
+            legendrePolynomials[ stride + 1 ] = sectoralRecursionCoefficients[ 1 ] * sectoralMultiplier;
+        }
     }
-    else
+
+    for( int n = 2; n <= maximumDegree; n++ )
     {
-        legendrePolynomialFunction_ = regularLegendrePolynomialFunction;
+        // Compute all non-sectoral polynomials of current degree at once (entries for degree n - 2 and order n - 1 are 0)
+        const int numberOfOrders = std::min( n - 1, highestComputedOrder ) + 1;
+        DegreeSegment( legendrePolynomials + n * stride, numberOfOrders ) =
+                ConstantDegreeSegment( firstRecursionCoefficients + n * stride, numberOfOrders ) * polynomialParameter *
+                ConstantDegreeSegment( legendrePolynomials + ( n - 1 ) * stride, numberOfOrders ) -
+                ConstantDegreeSegment( secondRecursionCoefficients + n * stride, numberOfOrders ) *
+                ConstantDegreeSegment( legendrePolynomials + ( n - 2 ) * stride, numberOfOrders );
+
+        // Compute sectoral polynomial
+        if( n <= highestComputedOrder )
+        {
+            legendrePolynomials[ n * stride + n ] = sectoralRecursionCoefficients[ n ] * sectoralMultiplier *
+                    legendrePolynomials[ ( n - 1 ) * stride + n - 1 ];
+        }
     }
+}
+
+//! Default constructor, initializes cache object with 0 maximum degree and order.
+LegendreCache::LegendreCache( const bool useGeodesyNormalization )
+{
+    useGeodesyNormalization_  = useGeodesyNormalization;
 
     resetMaximumDegreeAndOrder( 1, 1 );
 
@@ -50,15 +83,6 @@ LegendreCache::LegendreCache( const int maximumDegree, const int maximumOrder, c
 {
     useGeodesyNormalization_  = useGeodesyNormalization;
 
-    if( useGeodesyNormalization_ )
-    {
-        legendrePolynomialFunction_ = geodesyNormalizedLegendrePolynomialFunction;
-    }
-    else
-    {
-        legendrePolynomialFunction_ = regularLegendrePolynomialFunction;
-    }
-
     resetMaximumDegreeAndOrder( maximumDegree, maximumOrder );
     computeSecondDerivatives_ = 0;
 }
@@ -74,121 +98,61 @@ void LegendreCache::update( const double polynomialParameter  )
         // Set complement of argument (assuming it to be sine of latitude) cosine of latitude is always positive.
         currentPolynomialParameterComplement_ = std::sqrt( 1.0 - polynomialParameter * polynomialParameter );
 
-        LegendreCache& thisReference = *this;
+        // For geodesy-normalized polynomials, perform recursion on polynomials divided by complement to power m,
+        // which are subsequently scaled (Holmes & Featherstone, 2002). Otherwise, perform recursion directly.
+        double* recursionPolynomials = useGeodesyNormalization_ ? scaledLegendreValues_.data( ) :
+                                                                  legendreValues_.data( );
+        double sectoralMultiplier = useGeodesyNormalization_ ? 1.0 : currentPolynomialParameterComplement_;
 
-        int jMax = -1;
-        for( int i = 0; i <= maximumDegree_; i++ )
-        {
-            jMax = std::min( i, maximumOrder_ );
-            for( int j = 0; j <= jMax ; j++ )
-            {
-                // Compute legendre polynomial
-                legendreValues_[ i * ( maximumOrder_ + 1 ) + j ] = legendrePolynomialFunction_( i, j, thisReference );
+        // Compute polynomials of all degrees, for all orders of a single degree at once.
+        computeLegendrePolynomialsByColumnRecursion(
+                    maximumDegree_, highestComputedOrder_, numberOfStoredOrders_, polynomialParameter, sectoralMultiplier,
+                    firstRecursionCoefficients_.data( ), secondRecursionCoefficients_.data( ),
+                    sectoralRecursionCoefficients_.data( ), recursionPolynomials );
 
-                if( j != 0 )
-                {
-                    // Compute legendre polynomial derivative
-                    if( useGeodesyNormalization_ )
-                    {
-                        legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] =
-                                computeGeodesyLegendrePolynomialDerivative(
-                                    i, j - 1, currentPolynomialParameter_,
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                legendreValues_[ i * ( maximumOrder_ + 1 ) + j ],
-                                derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] );
-                    }
-                    else
-                    {
-                        legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] =
-                                computeLegendrePolynomialDerivative(
-                                    j - 1, currentPolynomialParameter_,
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                legendreValues_[ i * ( maximumOrder_ + 1 ) + j ] );
-                    }
+        typedef Eigen::Map< Eigen::ArrayXd > CacheArray;
+        typedef Eigen::Map< Eigen::ArrayXXd > CacheMatrix;
+        const int numberOfEntries = ( maximumDegree_ + 1 ) * numberOfStoredOrders_;
 
-                }
-            }
-
-            // Compute legendre polynomial derivative for i = j  (if needed)
-            if( jMax == i )
+        CacheArray values( legendreValues_.data( ), numberOfEntries );
+        if( useGeodesyNormalization_ )
+        {
+            complementPowers_[ 0 ] = 1.0;
+            for( int m = 1; m < numberOfStoredOrders_; m++ )
             {
-                if( useGeodesyNormalization_ )
-                {
-                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) +  jMax ] =
-                            computeGeodesyLegendrePolynomialDerivative(
-                                i, jMax, currentPolynomialParameter_,
-                                legendreValues_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0,
-                            derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + jMax ] );
-                }
-                else
-                {
-                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + jMax ] =
-                            computeLegendrePolynomialDerivative(
-                                jMax, currentPolynomialParameter_,
-                                legendreValues_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0 );
-                }
+                complementPowers_[ m ] = complementPowers_[ m - 1 ] * currentPolynomialParameterComplement_;
             }
+
+            // Scale polynomials of each degree (stored contiguously) with powers of complement.
+            CacheMatrix( legendreValues_.data( ), numberOfStoredOrders_, maximumDegree_ + 1 ) =
+                    CacheMatrix( scaledLegendreValues_.data( ), numberOfStoredOrders_, maximumDegree_ + 1 ).colwise( ) *
+                    Eigen::Map< Eigen::ArrayXd >( complementPowers_.data( ), numberOfStoredOrders_ );
         }
 
+        // Compute derivatives for all degrees and orders at once (entries beyond order + 1 have zero normalization)
+        const double inverseComplement = 1.0 / currentPolynomialParameterComplement_;
+        const double orderTermMultiplier = polynomialParameter * inverseComplement * inverseComplement;
+        CacheArray normalizations( derivativeNormalizations_.data( ), numberOfEntries - 1 );
+        CacheArray orders( derivativeOrders_.data( ), numberOfEntries - 1 );
+        CacheArray derivatives( legendreDerivatives_.data( ), numberOfEntries );
+        derivatives.head( numberOfEntries - 1 ) =
+                normalizations * values.tail( numberOfEntries - 1 ) * inverseComplement -
+                orders * orderTermMultiplier * values.head( numberOfEntries - 1 );
+
         // Compute second derivatives of Legendre polynomials if needed
         if( computeSecondDerivatives_ )
         {
-            for( int i = 0; i <= maximumDegree_; i++ )
-            {
-                jMax = std::min( i, maximumOrder_ );
-                for( int j = 0; j <= jMax ; j++ )
-                {
-                    if( j != 0 )
-                    {
-                        // Compute legendre polynomial second derivatives
-                        if( useGeodesyNormalization_ )
-                        {
-                            legendreSecondDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] =
-                                    computeGeodesyLegendrePolynomialSecondDerivative(
-                                        i, j - 1, currentPolynomialParameter_,
-                                        legendreValues_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + j ],
-                                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + j ],
-                                    derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] );
-                        }
-                        else
-                        {
-                            legendreSecondDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ] =
-                                    computeGeodesyLegendrePolynomialSecondDerivative(
-                                        i, j - 1, currentPolynomialParameter_,
-                                        legendreValues_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + j ],
-                                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + ( j - 1 ) ],
-                                    legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + j ], 1.0 );
-                        }
-
-                    }
-                }
-                // Compute legendre polynomial second derivative for i = j  (if needed)
-                if( jMax == i )
-                {
-                    if( useGeodesyNormalization_ )
-                    {
-                        legendreSecondDerivatives_[ i * ( maximumOrder_ + 1 ) +  jMax ] =
-                                computeGeodesyLegendrePolynomialSecondDerivative(
-                                    i, jMax, currentPolynomialParameter_,
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0,
-                                legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0,
-                                derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + jMax ] );
-                    }
-                    else
-                    {
-                        legendreSecondDerivatives_[ i * ( maximumOrder_ + 1 ) +  jMax ] =
-                                computeGeodesyLegendrePolynomialSecondDerivative(
-                                    i, jMax, currentPolynomialParameter_,
-                                    legendreValues_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0,
-                                legendreDerivatives_[ i * ( maximumOrder_ + 1 ) + jMax ], 0.0,
-                                1.0 );
-                    }
-                }
-
-            }
+            const double polynomialParameterSquare = polynomialParameter * polynomialParameter;
+            const double inverseComplementSquare = inverseComplement * inverseComplement;
+            CacheArray secondDerivatives( legendreSecondDerivatives_.data( ), numberOfEntries );
+            secondDerivatives.head( numberOfEntries - 1 ) =
+                    normalizations * (
+                        derivatives.tail( numberOfEntries - 1 ) * inverseComplement +
+                        values.tail( numberOfEntries - 1 ) * polynomialParameter * inverseComplement *
+                        inverseComplementSquare ) -
+                    orders * ( derivatives.head( numberOfEntries - 1 ) * orderTermMultiplier +
+                               values.head( numberOfEntries - 1 ) * ( 1.0 + polynomialParameterSquare ) *
+                               inverseComplementSquare * inverseComplementSquare );
         }
     }
 }
@@ -204,25 +168,84 @@ void LegendreCache::resetMaximumDegreeAndOrder( const int maximumDegree, const i
         maximumOrder_ = maximumDegree_;
     }
 
-    legendreValues_.resize( ( maximumDegree_ + 1 ) * ( maximumOrder_ + 1 ) );
-    legendreDerivatives_.resize( ( maximumDegree_ + 1 ) * ( maximumOrder_ + 1 ) );
-    legendreSecondDerivatives_.resize( ( maximumDegree_ + 1 ) * ( maximumOrder_ + 1 ) );
+    // Polynomials are computed up to two orders higher than maximum order, for use in derivatives. Entries for one order
+    // higher still are stored (and remain zero), so that derivatives are computed identically for all entries
+    highestComputedOrder_ = std::min( maximumOrder_ + 2, maximumDegree_ );
+    numberOfStoredOrders_ = maximumOrder_ + 3;
+    const int numberOfEntries = ( maximumDegree_ + 1 ) * numberOfStoredOrders_;
 
-    derivativeNormalizations_.resize( ( maximumDegree_ + 1 ) * ( maximumOrder_ + 1 ) );
+    legendreValues_.assign( numberOfEntries, 0.0 );
+    scaledLegendreValues_.assign( numberOfEntries, 0.0 );
+    legendreDerivatives_.assign( numberOfEntries, 0.0 );
+    legendreSecondDerivatives_.assign( numberOfEntries, 0.0 );
+
+    derivativeNormalizations_.assign( numberOfEntries, 0.0 );
+    derivativeOrders_.assign( numberOfEntries, 0.0 );
+    firstRecursionCoefficients_.assign( numberOfEntries, 0.0 );
+    secondRecursionCoefficients_.assign( numberOfEntries, 0.0 );
+    sectoralRecursionCoefficients_.assign( maximumDegree_ + 1, 0.0 );
+    complementPowers_.assign( numberOfStoredOrders_, 0.0 );
 
     for( int i = 0; i <= maximumDegree_; i++ )
     {
-        for( int j = 0; ( ( j <= i ) && ( j <= maximumOrder_ ) ) ; j++ )
+        double degree = static_cast< double >( i );
+        for( int j = 0; ( ( j <= i ) && ( j <= highestComputedOrder_ ) ) ; j++ )
         {
-            // Compute normalization correction factor.
-            derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + j ] = std::sqrt(
-                        ( static_cast< double >( i + j + 1 ) )
-                        * ( static_cast< double >( i - j ) ) );
+            double order = static_cast< double >( j );
+            int index = i * numberOfStoredOrders_ + j;
+
+            derivativeOrders_[ index ] = order;
 
-            // If order is zero apply multiplication factor.
-            if ( j == 0 )
+            // Compute normalization correction factor (if polynomial of one order higher is computed and non-zero).
+            if( j < i && j < highestComputedOrder_ )
+            {
+                if( useGeodesyNormalization_ )
+                {
+                    derivativeNormalizations_[ index ] = std::sqrt( ( degree + order + 1.0 ) * ( degree - order ) );
+
+                    // If order is zero apply multiplication factor.
+                    if ( j == 0 )
+                    {
+                        derivativeNormalizations_[ index ] *= std::sqrt( 0.5 );
+                    }
+                }
+                else
+                {
+                    derivativeNormalizations_[ index ] = 1.0;
+                }
+            }
+
+            // Compute coefficients of degree recursion
+            if( j < i )
+            {
+                if( useGeodesyNormalization_ )
+                {
+                    firstRecursionCoefficients_[ index ] = std::sqrt(
+                                ( 2.0 * degree - 1.0 ) * ( 2.0 * degree + 1.0 ) /
+                                ( ( degree - order ) * ( degree + order ) ) );
+                    secondRecursionCoefficients_[ index ] = ( i < 2 ) ? 0.0 : std::sqrt(
+                                ( 2.0 * degree + 1.0 ) * ( degree + order - 1.0 ) * ( degree - order - 1.0 ) /
+                                ( ( 2.0 * degree - 3.0 ) * ( degree + order ) * ( degree - order ) ) );
+                }
+                else
+                {
+                    firstRecursionCoefficients_[ index ] = ( 2.0 * degree - 1.0 ) / ( degree - order );
+                    secondRecursionCoefficients_[ index ] = ( degree + order - 1.0 ) / ( degree - order );
+                }
+            }
+        }
+
+        // Compute coefficients of sectoral recursion
+        if( i > 0 )
+        {
+            if( useGeodesyNormalization_ )
+            {
+                sectoralRecursionCoefficients_[ i ] = ( i == 1 ) ? std::sqrt( 3.0 ) :
+                                                                   std::sqrt( ( 2.0 * degree + 1.0 ) / ( 2.0 * degree ) );
+            }
+            else
             {
-                derivativeNormalizations_[ i * ( maximumOrder_ + 1 ) + j ] *= std::sqrt( 0.5 );
+                sectoralRecursionCoefficients_[ i ] = 2.0 * degree - 1.0;
             }
         }
     }
@@ -252,7 +275,7 @@ double LegendreCache::getLegendrePolynomial(
     }
     else
     {
-        return legendreValues_[ degree * ( maximumOrder_ + 1  ) + order ];
+        return legendreValues_[ degree * numberOfStoredOrders_ + order ];
     };
 }
 
@@ -276,7 +299,7 @@ double LegendreCache::getLegendrePolynomialDerivative(
     }
     else
     {
-        return legendreDerivatives_[ degree * ( maximumOrder_ + 1  ) + order ];
+        return legendreDerivatives_[ degree * numberOfStoredOrders_ + order ];
     };
 }
 
@@ -304,7 +327,7 @@ double LegendreCache::getLegendrePolynomialSecondDerivative(
     }
     else
     {
-        return legendreSecondDerivatives_[ degree * ( maximumOrder_ + 1  ) + order ];
+        return legendreSecondDerivatives_[ degree * numberOfStoredOrders_ + order ];
     };
 }
 
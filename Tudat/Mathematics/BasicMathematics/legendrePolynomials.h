@@ -38,6 +38,7 @@
 #include <boost/circular_buffer.hpp>
 #include <functional>
 #include <memory>
+#include <vector>
 #include <boost/unordered_map.hpp>
 #include <boost/enable_shared_from_this.hpp>
 
@@ -49,6 +50,16 @@ namespace basic_mathematics
 {
 
 //! Class for creating and accessing a back-end cache of Legendre polynomials.
+/*!
+ *  Class for creating and accessing a back-end cache of Legendre polynomials, and their first and (optionally) second
+ *  derivatives. The polynomials of all orders of a given degree are stored contiguously, and are computed for all
+ *  orders of a degree at once (which allows the compiler to use SIMD instructions), using the column (i.e. degree)
+ *  recursion. For geodesy-normalized polynomials, the modified forward column method of Holmes & Featherstone [2002] is
+ *  used, in which the recursion is performed on the polynomials divided by the m-th power of the complement of the
+ *  polynomial parameter (cosine of latitude), which is stable up to very high degree and order, also close to the poles.
+ *  The derivatives are computed from the polynomials of one order higher, which are computed by the cache (up to two
+ *  orders above the maximum order) for this purpose.
+ */
 class LegendreCache
 {
 
@@ -199,26 +210,52 @@ private:
     //! List of current values of Legendre polynomials at degree and order (n,m)
     /*!
      * List of current values of Legendre polynomials at degree and order (n,m). The corresponding polynomial is at entry
-     * n * ( maximumOrder_ + 1 ) + m.
+     * n * numberOfStoredOrders_ + m.
      */
     std::vector< double > legendreValues_;
 
     //! List of current values of first derivatives of Legendre polynomials at degree and order (n,m)
     /*!
      * List of current values of first derivatives of Legendre polynomials at degree and order (n,m).
-     * The corresponding polynomial is at entry n * ( maximumOrder_ + 1 ) + m.
+     * The corresponding polynomial is at entry n * numberOfStoredOrders_ + m.
      */
     std::vector< double > legendreDerivatives_;
 
     //! List of current values of second derivatives of Legendre polynomials at degree and order (n,m)
     /*!
      * List of current values of second derivatives of Legendre polynomials at degree and order (n,m).
-     * The corresponding polynomial is at entry n * ( maximumOrder_ + 1 ) + m.
+     * The corresponding polynomial is at entry n * numberOfStoredOrders_ + m.
      */
     std::vector< double > legendreSecondDerivatives_;
 
-    //! Function from which to compute the Legendre polynomials.
-    LegendrePolynomialFunction legendrePolynomialFunction_;
+    //! Highest order up to which the Legendre polynomials are computed (maximum order plus two, limited to maximum degree)
+    int highestComputedOrder_;
+
+    //! Number of entries per degree in the lists of polynomials and their derivatives (maximum order plus three).
+    int numberOfStoredOrders_;
+
+    //! List of current values of Legendre polynomials, divided by polynomial parameter complement to the power m.
+    /*!
+     * List of current values of Legendre polynomials at degree and order (n,m) (only used for geodesy-normalized
+     * polynomials), divided by the m-th power of the polynomial parameter complement (cosine of latitude), as used in
+     * the recursion of Holmes & Featherstone [2002]. Stored in the same manner as legendreValues_.
+     */
+    std::vector< double > scaledLegendreValues_;
+
+    //! Coefficients of polynomial of degree n-1 (times polynomial parameter) in recursion for degree n.
+    std::vector< double > firstRecursionCoefficients_;
+
+    //! Coefficients of polynomial of degree n-2 in recursion for degree n.
+    std::vector< double > secondRecursionCoefficients_;
+
+    //! Coefficients of sectoral polynomial of degree n-1 in recursion for sectoral polynomial of degree n.
+    std::vector< double > sectoralRecursionCoefficients_;
+
+    //! Order m at each entry of the lists of polynomials (zero for entries with order larger than degree).
+    std::vector< double > derivativeOrders_;
+
+    //! Current values of polynomial parameter complement (cosine of latitude) to the power m, with m the entry.
+    std::vector< double > complementPowers_;
 
     //! Boolean denoting whether the Legendre polynomials are geodesy-normalized or unnormalized
     bool useGeodesyNormalization_;
@@ -226,7 +263,12 @@ private:
     //! Vector of ratio of reference radius over current radius to power i, with i the entry in the vector.
     std::vector< double > referenceRadiusRatioPowers_;
 
-    //! Prec-computed normalization factors that are to be used for computation fo Legendre polynomial derivative
+    //! Pre-computed normalization factors that are to be used for computation of Legendre polynomial derivative
+    /*!
+     * Pre-computed normalization factors that are to be used for computation of Legendre polynomial derivative, stored
+     * in the same manner as legendreValues_. Entries for which the polynomial of one order higher is not computed, or
+     * zero, are set to zero.
+     */
     std::vector< double > derivativeNormalizations_;
 
     //! Boolean denoting whether the second derivatives of the Legendre polynomials are to be computed when calling
@@ -238,6 +280,33 @@ private:
 
 
 
+//! Compute Legendre polynomials up to given degree and order by column recursion, for all orders of a degree at once.
+/*!
+ * Compute Legendre polynomials up to given degree and order by column recursion, in which the polynomials of all orders
+ * of a single degree are computed at once from those of the two preceding degrees:
+ * \f[
+ *     P_{ n, m } = a_{ n, m } u P_{ n - 1, m } - b_{ n, m } P_{ n - 2, m }, \hspace{1cm} m < n
+ * \f]
+ * and the sectoral polynomials are computed from \f$ P_{ n, n } = s_{ n } c P_{ n - 1, n - 1 } \f$, with \f$ c \f$
+ * the sectoral multiplier. The polynomials of degree n and order m are stored at entry n * numberOfStoredOrders + m,
+ * where all entries for which m > n must be zero on input.
+ * \param maximumDegree Maximum degree up to which polynomials are to be computed.
+ * \param highestComputedOrder Maximum order up to which polynomials are to be computed.
+ * \param numberOfStoredOrders Number of entries per degree in the lists of coefficients and polynomials.
+ * \param polynomialParameter Free variable \f$ u \f$ of Legendre polynomials.
+ * \param sectoralMultiplier Multiplier \f$ c \f$ in sectoral recursion (complement of polynomial parameter for
+ * unnormalized polynomials, 1.0 for the scaled geodesy-normalized polynomials of Holmes & Featherstone [2002]).
+ * \param firstRecursionCoefficients Coefficients \f$ a_{ n, m } \f$, stored in same manner as polynomials.
+ * \param secondRecursionCoefficients Coefficients \f$ b_{ n, m } \f$, stored in same manner as polynomials.
+ * \param sectoralRecursionCoefficients Coefficients \f$ s_{ n } \f$, with n the entry of the list.
+ * \param legendrePolynomials Computed Legendre polynomials (returned by pointer).
+ */
+void computeLegendrePolynomialsByColumnRecursion(
+        const int maximumDegree, const int highestComputedOrder, const int numberOfStoredOrders,
+        const double polynomialParameter, const double sectoralMultiplier,
+        const double* firstRecursionCoefficients, const double* secondRecursionCoefficients,
+        const double* sectoralRecursionCoefficients, double* legendrePolynomials );
+
 //! Compute unnormalized associated Legendre polynomial.
 /*!
  * This function returns an unnormalized associated Legendre polynomial \f$ P _{ n, m }( u ) \f$
@@ -170,7 +170,9 @@ private:
 
     //! Update cached values of sines and cosines of longitude/
     /*!
-     * Update cached values of sines and cosines of longitude/
+     * Update cached values of sines and cosines of longitude. Only the sine and cosine of the longitude itself are
+     * evaluated directly, those of the multiples of the longitude are computed from the angle addition formulas. To
+     * limit the accumulation of rounding errors, the sine and cosine are evaluated directly every 32 orders.
      * \param longitude Current longitude.
      */
     void updateSines( const double longitude )
@@ -179,10 +181,26 @@ private:
         if( !( currentLongitude_ == longitude ) )
         {
             currentLongitude_ = longitude;
-            for( unsigned int i = 0; i < sinesOfLongitude_.size( ); i++ )
+
+            const double sineOfLongitude = std::sin( longitude );
+            const double cosineOfLongitude = std::cos( longitude );
+
+            sinesOfLongitude_[ 0 ] = 0.0;
+            cosinesOfLongitude_[ 0 ] = 1.0;
+            for( unsigned int i = 1; i < sinesOfLongitude_.size( ); i++ )
             {
-                sinesOfLongitude_[ i ] = std::sin( static_cast< double >( i ) * longitude );
-                cosinesOfLongitude_[ i ] = std::cos( static_cast< double >( i ) * longitude );
+                if( i % 32 == 0 )
+                {
+                    sinesOfLongitude_[ i ] = std::sin( static_cast< double >( i ) * longitude );
+                    cosinesOfLongitude_[ i ] = std::cos( static_cast< double >( i ) * longitude );
+                }
+                else
+                {
+                    sinesOfLongitude_[ i ] = sinesOfLongitude_[ i - 1 ] * cosineOfLongitude +
+                            cosinesOfLongitude_[ i - 1 ] * sineOfLongitude;
+                    cosinesOfLongitude_[ i ] = cosinesOfLongitude_[ i - 1 ] * cosineOfLongitude -
+                            sinesOfLongitude_[ i - 1 ] * sineOfLongitude;
+                }
             }
         }
     }
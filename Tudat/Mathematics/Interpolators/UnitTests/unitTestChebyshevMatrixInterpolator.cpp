@@ -0,0 +1,195 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/Interpolators/chebyshevMatrixInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to compute a smooth 3x4 test matrix, with entries of strongly varying magnitude.
+Eigen::MatrixXd computeTestMatrix( const double independentVariable )
+{
+    Eigen::MatrixXd testMatrix = Eigen::MatrixXd( 3, 4 );
+    for( int j = 0; j < 3; j++ )
+    {
+        for( int k = 0; k < 4; k++ )
+        {
+            testMatrix( j, k ) = std::pow( 10.0, 2 * ( j - k ) ) *
+                    std::sin( 1.0E-3 * ( j + 1 ) * independentVariable + k ) + ( j == k ? 1.0 : 0.0 );
+        }
+    }
+    return testMatrix;
+}
+
+//! Function to create history of test matrices, on an irregular grid.
+std::map< double, Eigen::MatrixXd > createChebyshevTestMatrixHistory( const int numberOfDataPoints )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory;
+    double currentTime = 0.0;
+    for( int i = 0; i < numberOfDataPoints; i++ )
+    {
+        matrixHistory[ currentTime ] = computeTestMatrix( currentTime );
+        currentTime += 50.0 + 10.0 * std::sin( static_cast< double >( i ) );
+    }
+    return matrixHistory;
+}
+
+BOOST_AUTO_TEST_SUITE( test_chebyshev_matrix_interpolator )
+
+//! Test accuracy of interpolation of smooth data, and consistency of fit residuals.
+BOOST_AUTO_TEST_CASE( testChebyshevMatrixInterpolatorAccuracy )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory = createChebyshevTestMatrixHistory( 203 );
+    double startTime = matrixHistory.begin( )->first;
+    double endTime = matrixHistory.rbegin( )->first;
+
+    interpolators::ChebyshevMatrixInterpolator interpolator( matrixHistory, 10, 40, 1.0E-8 );
+
+    // Check that fit is within tolerance, and that all data is covered
+    BOOST_CHECK( interpolator.getMaximumRelativeFitResidual( ) < 1.0E-8 );
+    BOOST_CHECK_EQUAL( interpolator.getSegmentStartTimes( ).front( ), startTime );
+    BOOST_CHECK_EQUAL( interpolator.getRelativeFitResiduals( ).size( ), interpolator.getNumberOfSegments( ) );
+
+    // Compute largest absolute value of each matrix column over full history
+    Eigen::VectorXd columnMagnitudes = Eigen::VectorXd::Zero( 4 );
+    for( auto matrixIterator : matrixHistory )
+    {
+        for( int k = 0; k < 4; k++ )
+        {
+            columnMagnitudes( k ) = std::max(
+                        columnMagnitudes( k ), matrixIterator.second.col( k ).cwiseAbs( ).maxCoeff( ) );
+        }
+    }
+
+    // Check interpolated values at and in between data points, relative to magnitude of matrix column
+    for( int i = 0; i <= 1000; i++ )
+    {
+        double currentTime = startTime + static_cast< double >( i ) / 1000.0 * ( endTime - startTime );
+        Eigen::MatrixXd expectedMatrix = computeTestMatrix( currentTime );
+        Eigen::MatrixXd interpolatedMatrix = interpolator.interpolate( currentTime );
+        for( int k = 0; k < 4; k++ )
+        {
+            BOOST_CHECK_SMALL( ( interpolatedMatrix - expectedMatrix ).col( k ).cwiseAbs( ).maxCoeff( ),
+                               1.0E-7 * columnMagnitudes( k ) );
+        }
+    }
+
+    // Check that a lower polynomial degree requires more segments to reach the same tolerance
+    interpolators::ChebyshevMatrixInterpolator lowDegreeInterpolator( matrixHistory, 9, 40, 1.0E-8 );
+    BOOST_CHECK( lowDegreeInterpolator.getMaximumRelativeFitResidual( ) < 1.0E-8 );
+    BOOST_CHECK( lowDegreeInterpolator.getNumberOfSegments( ) > interpolator.getNumberOfSegments( ) );
+
+    // Check that a looser tolerance does not split segments, and results in larger residuals
+    interpolators::ChebyshevMatrixInterpolator looseInterpolator( matrixHistory, 10, 40, 1.0 );
+    BOOST_CHECK_EQUAL( looseInterpolator.getNumberOfSegments( ), 6 );
+    BOOST_CHECK( looseInterpolator.getMaximumRelativeFitResidual( ) > 1.0E-8 );
+}
+
+//! Test that polynomial data is reproduced exactly (to within rounding errors), including extrapolation.
+BOOST_AUTO_TEST_CASE( testChebyshevMatrixInterpolatorPolynomialData )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory;
+    Eigen::MatrixXd coefficients = Eigen::MatrixXd::Random( 6, 4 );
+    for( int i = 0; i < 37; i++ )
+    {
+        double currentTime = 1.0E3 + 25.0 * i + std::cos( static_cast< double >( i ) );
+        Eigen::MatrixXd currentMatrix = Eigen::MatrixXd::Zero( 6, 1 );
+        for( int k = 0; k < 4; k++ )
+        {
+            currentMatrix += coefficients.col( k ) * std::pow( ( currentTime - 1.0E3 ) / 1.0E3, k );
+        }
+        matrixHistory[ currentTime ] = currentMatrix;
+    }
+
+    // Last segment overlaps with preceding segment, as too few data points remain
+    interpolators::ChebyshevMatrixInterpolator interpolator( matrixHistory, 3, 6, 1.0E-12 );
+    BOOST_CHECK( interpolator.getMaximumRelativeFitResidual( ) < 1.0E-12 );
+    BOOST_CHECK_EQUAL( interpolator.getNumberOfSegments( ), 8 );
+
+    for( int i = -20; i < 960; i++ )
+    {
+        double currentTime = 1.0E3 + static_cast< double >( i );
+        Eigen::MatrixXd expectedMatrix = Eigen::MatrixXd::Zero( 6, 1 );
+        for( int k = 0; k < 4; k++ )
+        {
+            expectedMatrix += coefficients.col( k ) * std::pow( ( currentTime - 1.0E3 ) / 1.0E3, k );
+        }
+        BOOST_CHECK_SMALL( ( interpolator.interpolate( currentTime ) - expectedMatrix ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-13 );
+    }
+
+    // Check that two data points result in linear interpolation
+    std::map< double, Eigen::MatrixXd > linearMatrixHistory;
+    linearMatrixHistory[ 0.0 ] = Eigen::MatrixXd::Constant( 2, 2, 1.0 );
+    linearMatrixHistory[ 2.0 ] = Eigen::MatrixXd::Constant( 2, 2, 3.0 );
+    interpolators::ChebyshevMatrixInterpolator linearInterpolator( linearMatrixHistory, 3, 6 );
+    BOOST_CHECK_SMALL( ( linearInterpolator.interpolate( 0.5 ) -
+                         Eigen::MatrixXd::Constant( 2, 2, 1.5 ) ).cwiseAbs( ).maxCoeff( ), 1.0E-15 );
+}
+
+//! Test interpolation into preallocated matrices, and error handling.
+BOOST_AUTO_TEST_CASE( testChebyshevMatrixInterpolatorOutputBuffer )
+{
+    std::map< double, Eigen::MatrixXd > matrixHistory = createChebyshevTestMatrixHistory( 50 );
+    double startTime = matrixHistory.begin( )->first;
+    double endTime = matrixHistory.rbegin( )->first;
+
+    interpolators::ChebyshevMatrixInterpolator interpolator(
+                matrixHistory, 8, 20, 1.0E-10, interpolators::throw_exception_at_boundary );
+
+    // Interpolate into full matrix, and into block of larger matrix, and compare to returned matrix
+    Eigen::MatrixXd outputMatrix = Eigen::MatrixXd( 3, 4 );
+    Eigen::MatrixXd largeOutputMatrix = Eigen::MatrixXd::Zero( 5, 7 );
+    for( int i = 0; i <= 100; i++ )
+    {
+        double currentTime = startTime + static_cast< double >( i ) / 100.0 * ( endTime - startTime );
+        Eigen::MatrixXd interpolatedMatrix = interpolator.interpolate( currentTime );
+
+        interpolator.interpolate( currentTime, outputMatrix );
+        BOOST_CHECK_EQUAL( ( outputMatrix - interpolatedMatrix ).cwiseAbs( ).maxCoeff( ), 0.0 );
+
+        interpolator.interpolate( currentTime, largeOutputMatrix.block( 1, 2, 3, 4 ) );
+        BOOST_CHECK_EQUAL( ( largeOutputMatrix.block( 1, 2, 3, 4 ) - interpolatedMatrix ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        BOOST_CHECK_EQUAL( largeOutputMatrix.row( 0 ).norm( ) + largeOutputMatrix.row( 4 ).norm( ) +
+                           largeOutputMatrix.leftCols( 2 ).norm( ) + largeOutputMatrix.rightCols( 1 ).norm( ), 0.0 );
+    }
+
+    // Check exceptions for incorrect output size, and out-of-range independent variable
+    Eigen::MatrixXd wrongOutputMatrix = Eigen::MatrixXd( 4, 3 );
+    BOOST_CHECK_THROW( interpolator.interpolate( startTime, wrongOutputMatrix ), std::runtime_error );
+    BOOST_CHECK_THROW( interpolator.interpolate( endTime + 1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( interpolator.interpolate( startTime - 1.0 ), std::runtime_error );
+
+    // Check exceptions for invalid settings
+    BOOST_CHECK_THROW( interpolators::ChebyshevMatrixInterpolator( matrixHistory, 8, 9 ), std::runtime_error );
+    BOOST_CHECK_THROW( interpolators::ChebyshevMatrixInterpolator(
+                           matrixHistory, 8, 20, 1.0E-10, interpolators::use_boundary_value ), std::runtime_error );
+    std::map< double, Eigen::MatrixXd > singlePointHistory;
+    singlePointHistory[ 0.0 ] = Eigen::MatrixXd::Zero( 3, 4 );
+    BOOST_CHECK_THROW( interpolators::ChebyshevMatrixInterpolator( singlePointHistory, 3, 5 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,223 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/QR>
+
+#include "Tudat/Mathematics/Interpolators/chebyshevMatrixInterpolator.h"
+
+namespace tudat
+{
+
+namespace interpolators
+{
+
+//! Constructor
+ChebyshevMatrixInterpolator::ChebyshevMatrixInterpolator(
+        const std::map< double, Eigen::MatrixXd >& dataMap,
+        const int polynomialDegree,
+        const int maximumNumberOfPointsPerSegment,
+        const double relativeFitTolerance,
+        const BoundaryInterpolationType boundaryHandling ):
+    OneDimensionalInterpolator< double, Eigen::MatrixXd >( boundaryHandling, Eigen::MatrixXd::Zero( 0, 0 ) ),
+    polynomialDegree_( polynomialDegree )
+{
+    if( dataMap.size( ) < 2 )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev matrix interpolator, at least two data points are required." );
+    }
+
+    if( polynomialDegree_ < 1 )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev matrix interpolator, polynomial degree must be at least 1." );
+    }
+
+    const int minimumNumberOfPointsPerSegment = 2 * polynomialDegree_;
+    if( maximumNumberOfPointsPerSegment < minimumNumberOfPointsPerSegment )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev matrix interpolator, maximum number of points per segment (" +
+                                  std::to_string( maximumNumberOfPointsPerSegment ) +
+                                  ") must be at least twice the polynomial degree (" +
+                                  std::to_string( minimumNumberOfPointsPerSegment ) + ")." );
+    }
+
+    if( boundaryHandling_ != extrapolate_at_boundary && boundaryHandling_ != throw_exception_at_boundary )
+    {
+        throw std::runtime_error( "Error when creating Chebyshev matrix interpolator, only extrapolation or exception are "
+                                  "supported as boundary handling." );
+    }
+
+    // Retrieve data points; only the independent variables are retained.
+    numberOfRows_ = dataMap.begin( )->second.rows( );
+    numberOfColumns_ = dataMap.begin( )->second.cols( );
+    std::vector< const Eigen::MatrixXd* > dataPoints;
+    dataPoints.reserve( dataMap.size( ) );
+    independentValues_.reserve( dataMap.size( ) );
+    for( auto dataIterator = dataMap.begin( ); dataIterator != dataMap.end( ); dataIterator++ )
+    {
+        if( dataIterator->second.rows( ) != numberOfRows_ || dataIterator->second.cols( ) != numberOfColumns_ )
+        {
+            throw std::runtime_error( "Error when creating Chebyshev matrix interpolator, matrices are not of equal size." );
+        }
+        independentValues_.push_back( dataIterator->first );
+        dataPoints.push_back( &( dataIterator->second ) );
+    }
+
+    // Divide data into segments, splitting each segment until the fit is within tolerance.
+    const int numberOfDataPoints = static_cast< int >( dataPoints.size( ) );
+    int startIndex = 0;
+    int numberOfPointsInSegment = maximumNumberOfPointsPerSegment;
+    Eigen::MatrixXd currentCoefficients;
+    while( startIndex < numberOfDataPoints - 1 )
+    {
+        // Let last segment overlap with previous one (using the same number of data points), if insufficient data
+        // points remain.
+        if( numberOfDataPoints - startIndex < minimumNumberOfPointsPerSegment )
+        {
+            startIndex = std::max( 0, numberOfDataPoints - numberOfPointsInSegment );
+        }
+
+        numberOfPointsInSegment = std::min( maximumNumberOfPointsPerSegment, numberOfDataPoints - startIndex );
+        double currentResidual = fitSegment(
+                    dataPoints, startIndex, startIndex + numberOfPointsInSegment - 1, currentCoefficients );
+        while( currentResidual > relativeFitTolerance && numberOfPointsInSegment > minimumNumberOfPointsPerSegment )
+        {
+            numberOfPointsInSegment = std::max( minimumNumberOfPointsPerSegment, numberOfPointsInSegment / 2 );
+            currentResidual = fitSegment(
+                        dataPoints, startIndex, startIndex + numberOfPointsInSegment - 1, currentCoefficients );
+        }
+
+        const int endIndex = startIndex + numberOfPointsInSegment - 1;
+        segmentStartTimes_.push_back( independentValues_.at( startIndex ) );
+        segmentEndTimes_.push_back( independentValues_.at( endIndex ) );
+        segmentCoefficients_.push_back( currentCoefficients );
+        relativeFitResiduals_.push_back( currentResidual );
+
+        startIndex = endIndex;
+    }
+
+    chebyshevPolynomialValues_ = Eigen::VectorXd::Zero( polynomialDegree_ + 1 );
+}
+
+//! Function to interpolate the matrix at a given independent variable value.
+Eigen::MatrixXd ChebyshevMatrixInterpolator::interpolate( const double targetIndependentVariableValue )
+{
+    Eigen::MatrixXd interpolatedValue = Eigen::MatrixXd( numberOfRows_, numberOfColumns_ );
+    interpolate( targetIndependentVariableValue, interpolatedValue );
+    return interpolatedValue;
+}
+
+//! Function to interpolate the matrix at a given independent variable value, into a preallocated matrix.
+void ChebyshevMatrixInterpolator::interpolate(
+        const double targetIndependentVariableValue, Eigen::Ref< Eigen::MatrixXd > interpolatedValue )
+{
+    if( interpolatedValue.rows( ) != numberOfRows_ || interpolatedValue.cols( ) != numberOfColumns_ )
+    {
+        throw std::runtime_error( "Error in Chebyshev matrix interpolator, output matrix has incorrect size." );
+    }
+
+    // Check boundary case (only exception is supported, extrapolation uses outermost segments).
+    Eigen::MatrixXd dummyValue;
+    bool useBoundaryValue = false;
+    checkBoundaryCase( dummyValue, useBoundaryValue, targetIndependentVariableValue );
+
+    // Find segment with largest start time below target value.
+    int segmentIndex = static_cast< int >(
+                std::upper_bound( segmentStartTimes_.begin( ), segmentStartTimes_.end( ),
+                                  targetIndependentVariableValue ) - segmentStartTimes_.begin( ) ) - 1;
+    segmentIndex = std::max( segmentIndex, 0 );
+
+    // Evaluate Chebyshev polynomials at scaled independent variable.
+    const double segmentStartTime = segmentStartTimes_[ segmentIndex ];
+    const double segmentEndTime = segmentEndTimes_[ segmentIndex ];
+    const double scaledIndependentVariable =
+            ( 2.0 * targetIndependentVariableValue - ( segmentStartTime + segmentEndTime ) ) /
+            ( segmentEndTime - segmentStartTime );
+
+    chebyshevPolynomialValues_( 0 ) = 1.0;
+    chebyshevPolynomialValues_( 1 ) = scaledIndependentVariable;
+    for( int i = 2; i <= polynomialDegree_; i++ )
+    {
+        chebyshevPolynomialValues_( i ) = 2.0 * scaledIndependentVariable * chebyshevPolynomialValues_( i - 1 ) -
+                chebyshevPolynomialValues_( i - 2 );
+    }
+
+    // Evaluate polynomial series for each matrix column.
+    const Eigen::MatrixXd& currentCoefficients = segmentCoefficients_[ segmentIndex ];
+    for( int j = 0; j < numberOfColumns_; j++ )
+    {
+        interpolatedValue.col( j ).noalias( ) =
+                currentCoefficients.middleRows( j * numberOfRows_, numberOfRows_ ) * chebyshevPolynomialValues_;
+    }
+}
+
+//! Function to retrieve the largest relative residual of the fit over all segments.
+double ChebyshevMatrixInterpolator::getMaximumRelativeFitResidual( )
+{
+    return *std::max_element( relativeFitResiduals_.begin( ), relativeFitResiduals_.end( ) );
+}
+
+//! Function to fit the Chebyshev polynomials of a single segment.
+double ChebyshevMatrixInterpolator::fitSegment(
+        const std::vector< const Eigen::MatrixXd* >& dataPoints, const int startIndex,
+        const int endIndex, Eigen::MatrixXd& coefficients )
+{
+    const int numberOfPoints = endIndex - startIndex + 1;
+    const int numberOfEntries = numberOfRows_ * numberOfColumns_;
+    const int currentDegree = std::min( polynomialDegree_, numberOfPoints - 1 );
+
+    // Set up Chebyshev Vandermonde matrix and data matrix (one flattened matrix per row).
+    const double segmentStartTime = independentValues_.at( startIndex );
+    const double segmentEndTime = independentValues_.at( endIndex );
+    Eigen::MatrixXd informationMatrix = Eigen::MatrixXd( numberOfPoints, currentDegree + 1 );
+    Eigen::MatrixXd dataMatrix = Eigen::MatrixXd( numberOfPoints, numberOfEntries );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        const double scaledIndependentVariable =
+                ( 2.0 * independentValues_.at( startIndex + i ) - ( segmentStartTime + segmentEndTime ) ) /
+                ( segmentEndTime - segmentStartTime );
+        informationMatrix( i, 0 ) = 1.0;
+        informationMatrix( i, 1 ) = scaledIndependentVariable;
+        for( int k = 2; k <= currentDegree; k++ )
+        {
+            informationMatrix( i, k ) = 2.0 * scaledIndependentVariable * informationMatrix( i, k - 1 ) -
+                    informationMatrix( i, k - 2 );
+        }
+        dataMatrix.row( i ) = Eigen::Map< const Eigen::RowVectorXd >(
+                    dataPoints.at( startIndex + i )->data( ), numberOfEntries );
+    }
+
+    // Perform least-squares fit, and pad coefficients of unused polynomials with zeros.
+    Eigen::MatrixXd fittedCoefficients = informationMatrix.colPivHouseholderQr( ).solve( dataMatrix );
+    coefficients = Eigen::MatrixXd::Zero( numberOfEntries, polynomialDegree_ + 1 );
+    coefficients.leftCols( currentDegree + 1 ) = fittedCoefficients.transpose( );
+
+    // Compute largest residual, relative to largest absolute value of each matrix column.
+    Eigen::MatrixXd residuals = informationMatrix * fittedCoefficients - dataMatrix;
+    double maximumRelativeResidual = 0.0;
+    for( int j = 0; j < numberOfColumns_; j++ )
+    {
+        double columnScale = dataMatrix.middleCols( j * numberOfRows_, numberOfRows_ ).cwiseAbs( ).maxCoeff( );
+        double columnResidual = residuals.middleCols( j * numberOfRows_, numberOfRows_ ).cwiseAbs( ).maxCoeff( );
+        if( columnScale > 0.0 )
+        {
+            maximumRelativeResidual = std::max( maximumRelativeResidual, columnResidual / columnScale );
+        }
+    }
+    return maximumRelativeResidual;
+}
+
+} // namespace interpolators
+
+} // namespace tudat
@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_CHEBYSHEVMATRIXINTERPOLATOR_H
+#define TUDAT_CHEBYSHEVMATRIXINTERPOLATOR_H
+
+#include <map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+
+namespace interpolators
+{
+
+//! Interpolator for a matrix history, using piecewise Chebyshev polynomials fitted to the data.
+/*!
+ *  Interpolator for a matrix history (e.g. state transition matrices from a numerical integration), using piecewise
+ *  Chebyshev polynomials. On construction, the data points are divided into segments of consecutive data points (with
+ *  the last data point of each segment being the first data point of the next, and the last segment overlapping with
+ *  the preceding one if too few data points remain). For each segment, the Chebyshev
+ *  coefficients of all matrix entries are fitted, in a least-squares sense, to the data points in the segment. If the
+ *  largest residual of the fit, relative to the largest absolute value of the matrix column in the segment, exceeds the
+ *  given tolerance, the segment is split into smaller segments (down to a minimum of twice the polynomial degree in
+ *  data points, so that the residuals remain an indication of the quality of the fit in between the data points).
+ *
+ *  An interpolation consists of a binary search for the segment, the evaluation of the Chebyshev polynomials at the
+ *  independent variable, and a single matrix-vector product per matrix column. The result can be written directly into
+ *  a preallocated matrix (or a block thereof), in which case no memory is allocated. Outside the domain of the data,
+ *  the polynomials of the first and last segment are used for extrapolation.
+ */
+class ChebyshevMatrixInterpolator: public OneDimensionalInterpolator< double, Eigen::MatrixXd >
+{
+public:
+
+    using OneDimensionalInterpolator< double, Eigen::MatrixXd >::interpolate;
+
+    //! Constructor
+    /*!
+     * Constructor, fits the Chebyshev polynomials to the data.
+     * \param dataMap Map with the independent variables as keys, and the (equally sized) matrices as values. At least two
+     * data points are required.
+     * \param polynomialDegree Degree of the Chebyshev polynomials (reduced for segments with insufficient data points).
+     * \param maximumNumberOfPointsPerSegment Maximum number of data points in a single segment (at least
+     * twice the polynomial degree).
+     * \param relativeFitTolerance Tolerance on the largest residual of the fit of each segment, relative to the largest
+     * absolute value of each matrix column in the segment, above which the segment is split.
+     * \param boundaryHandling Boundary handling method, in case the independent variable is outside the specified range
+     * (only extrapolate_at_boundary and throw_exception_at_boundary are supported).
+     */
+    ChebyshevMatrixInterpolator(
+            const std::map< double, Eigen::MatrixXd >& dataMap,
+            const int polynomialDegree = 10,
+            const int maximumNumberOfPointsPerSegment = 40,
+            const double relativeFitTolerance = 1.0E-10,
+            const BoundaryInterpolationType boundaryHandling = extrapolate_at_boundary );
+
+    //! Destructor
+    ~ChebyshevMatrixInterpolator( ){ }
+
+    //! Function to interpolate the matrix at a given independent variable value.
+    /*!
+     *  Function to interpolate the matrix at a given independent variable value.
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation is to take place.
+     *  \return Interpolated matrix.
+     */
+    Eigen::MatrixXd interpolate( const double targetIndependentVariableValue );
+
+    //! Function to interpolate the matrix at a given independent variable value, into a preallocated matrix.
+    /*!
+     *  Function to interpolate the matrix at a given independent variable value, writing the result into a preallocated
+     *  matrix (or block of a matrix) of the correct size, without allocating memory.
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation is to take place.
+     *  \param interpolatedValue Matrix (block) to which the interpolated matrix is written.
+     */
+    void interpolate( const double targetIndependentVariableValue, Eigen::Ref< Eigen::MatrixXd > interpolatedValue );
+
+    //! Function to retrieve the number of segments into which the data is divided.
+    /*!
+     *  Function to retrieve the number of segments into which the data is divided.
+     *  \return Number of segments into which the data is divided.
+     */
+    int getNumberOfSegments( )
+    {
+        return static_cast< int >( segmentStartTimes_.size( ) );
+    }
+
+    //! Function to retrieve the independent variable values at the start of each segment.
+    /*!
+     *  Function to retrieve the independent variable values at the start of each segment.
+     *  \return Independent variable values at the start of each segment.
+     */
+    std::vector< double > getSegmentStartTimes( )
+    {
+        return segmentStartTimes_;
+    }
+
+    //! Function to retrieve the largest relative residual of the fit of each segment.
+    /*!
+     *  Function to retrieve the largest residual of the fit of each segment, relative to the largest absolute value of
+     *  each matrix column in the segment.
+     *  \return Largest relative residual of the fit of each segment.
+     */
+    std::vector< double > getRelativeFitResiduals( )
+    {
+        return relativeFitResiduals_;
+    }
+
+    //! Function to retrieve the largest relative residual of the fit over all segments.
+    /*!
+     *  Function to retrieve the largest relative residual of the fit over all segments.
+     *  \return Largest relative residual of the fit over all segments.
+     */
+    double getMaximumRelativeFitResidual( );
+
+private:
+
+    //! Function to fit the Chebyshev polynomials of a single segment.
+    /*!
+     *  Function to fit the Chebyshev polynomials of a single segment, between two data point indices.
+     *  \param dataPoints Pointers to the matrices at the data points.
+     *  \param startIndex Index of the first data point in the segment.
+     *  \param endIndex Index of the last data point in the segment.
+     *  \param coefficients Fitted coefficients (one column per Chebyshev polynomial, returned by reference).
+     *  \return Largest residual of the fit, relative to the largest absolute value of each matrix column in the segment.
+     */
+    double fitSegment( const std::vector< const Eigen::MatrixXd* >& dataPoints, const int startIndex,
+                       const int endIndex, Eigen::MatrixXd& coefficients );
+
+    //! Degree of the Chebyshev polynomials.
+    int polynomialDegree_;
+
+    //! Number of rows of the interpolated matrices.
+    int numberOfRows_;
+
+    //! Number of columns of the interpolated matrices.
+    int numberOfColumns_;
+
+    //! Independent variable values at the start of each segment.
+    std::vector< double > segmentStartTimes_;
+
+    //! Independent variable values at the end of each segment.
+    std::vector< double > segmentEndTimes_;
+
+    //! Chebyshev coefficients of each segment (one column per polynomial, one row per (column-major) matrix entry).
+    std::vector< Eigen::MatrixXd > segmentCoefficients_;
+
+    //! Largest residual of the fit of each segment, relative to the largest absolute value of each matrix column.
+    std::vector< double > relativeFitResiduals_;
+
+    //! Values of the Chebyshev polynomials at the current independent variable (pre-allocated).
+    Eigen::VectorXd chebyshevPolynomialValues_;
+};
+
+} // namespace interpolators
+
+} // namespace tudat
+
+#endif // TUDAT_CHEBYSHEVMATRIXINTERPOLATOR_H
@@ -0,0 +1,394 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Berry, M.M. and Healy, L.M., Implementation of Gauss-Jackson Integration for Orbit Propagation,
+ *          The Journal of the Astronautical Sciences, 52(3), 2004.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Mathematics/NumericalIntegrators/adamsBashforthMoultonIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/gaussJacksonIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+using namespace orbital_element_conversions;
+
+//! Gravitational parameter of the Earth used in the tests.
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Equatorial radius of the Earth used in the tests.
+const double earthEquatorialRadius = 6378137.0;
+
+//! Class to compute the (Cowell) state derivative of bodies orbiting the Earth, counting the number of evaluations.
+class OrbitStateDerivative
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param j2Coefficient Unnormalized J2 coefficient of the Earth (0 for a point-mass Earth).
+     */
+    OrbitStateDerivative( const double j2Coefficient = 0.0 ):
+        j2Coefficient_( j2Coefficient ), numberOfEvaluations_( 0 ){ }
+
+    //! Function to compute the state derivative of one or more bodies (one or more columns).
+    Eigen::MatrixXd computeStateDerivative( const double time, const Eigen::MatrixXd& state )
+    {
+        numberOfEvaluations_++;
+        Eigen::MatrixXd stateDerivative = Eigen::MatrixXd::Zero( state.rows( ), state.cols( ) );
+        for( int i = 0; i < state.rows( ) / 6; i++ )
+        {
+            for( int j = 0; j < state.cols( ); j++ )
+            {
+                const Eigen::Vector3d position = state.block( 6 * i, j, 3, 1 );
+                const double distance = position.norm( );
+                Eigen::Vector3d acceleration =
+                        -earthGravitationalParameter / ( distance * distance * distance ) * position;
+                if( j2Coefficient_ != 0.0 )
+                {
+                    const double squaredSineOfLatitude = position.z( ) * position.z( ) / ( distance * distance );
+                    const double factor = -1.5 * j2Coefficient_ * earthGravitationalParameter *
+                            earthEquatorialRadius * earthEquatorialRadius / std::pow( distance, 5.0 );
+                    acceleration.x( ) += factor * position.x( ) * ( 1.0 - 5.0 * squaredSineOfLatitude );
+                    acceleration.y( ) += factor * position.y( ) * ( 1.0 - 5.0 * squaredSineOfLatitude );
+                    acceleration.z( ) += factor * position.z( ) * ( 3.0 - 5.0 * squaredSineOfLatitude );
+                }
+                stateDerivative.block( 6 * i, j, 3, 1 ) = state.block( 6 * i + 3, j, 3, 1 );
+                stateDerivative.block( 6 * i + 3, j, 3, 1 ) = acceleration;
+            }
+        }
+        return stateDerivative;
+    }
+
+    //! Function to compute the state derivative of one or more bodies (vector state).
+    Eigen::VectorXd computeVectorStateDerivative( const double time, const Eigen::VectorXd& state )
+    {
+        return computeStateDerivative( time, state );
+    }
+
+    //! Unnormalized J2 coefficient of the Earth.
+    double j2Coefficient_;
+
+    //! Number of state derivative evaluations.
+    int numberOfEvaluations_;
+};
+
+//! Function to compute the state derivative for an acceleration that is a polynomial of degree six in time.
+Eigen::VectorXd computePolynomialAccelerationStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative = Eigen::VectorXd::Zero( 6 );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative( 3 ) = 1.0 - 0.5 * time + 0.02 * std::pow( time, 6 );
+    stateDerivative( 4 ) = 0.1 * std::pow( time, 3 ) - 0.3 * std::pow( time, 5 );
+    stateDerivative( 5 ) = -2.0 + 0.05 * std::pow( time, 4 );
+    return stateDerivative;
+}
+
+//! Function to compute the analytical state for the polynomial acceleration (zero initial position and velocity).
+Eigen::VectorXd computePolynomialAccelerationState( const double time )
+{
+    Eigen::VectorXd state = Eigen::VectorXd::Zero( 6 );
+    state( 0 ) = time * time / 2.0 - 0.5 * std::pow( time, 3 ) / 6.0 + 0.02 * std::pow( time, 8 ) / 56.0;
+    state( 1 ) = 0.1 * std::pow( time, 5 ) / 20.0 - 0.3 * std::pow( time, 7 ) / 42.0;
+    state( 2 ) = -time * time + 0.05 * std::pow( time, 6 ) / 30.0;
+    state( 3 ) = time - 0.5 * time * time / 2.0 + 0.02 * std::pow( time, 7 ) / 7.0;
+    state( 4 ) = 0.1 * std::pow( time, 4 ) / 4.0 - 0.3 * std::pow( time, 6 ) / 6.0;
+    state( 5 ) = -2.0 * time + 0.05 * std::pow( time, 5 ) / 5.0;
+    return state;
+}
+
+//! Function to retrieve the initial state, and the analytical final state, of the (Keplerian) test orbit.
+void getKeplerOrbitStates( const double propagationTime, Eigen::VectorXd& initialState, Eigen::VectorXd& finalState )
+{
+    Eigen::Vector6d keplerianElements;
+    keplerianElements << 7000.0E3, 0.05, 1.2, 0.4, 0.3, 0.1;
+    initialState = convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter );
+    finalState = convertKeplerianToCartesianElements(
+                propagateKeplerOrbit( keplerianElements, propagationTime, earthGravitationalParameter ),
+                earthGravitationalParameter );
+}
+
+BOOST_AUTO_TEST_SUITE( test_gauss_jackson_integrator )
+
+//! Test the coefficients against the (ordinate form) values of Berry and Healy (2004), Tables 5 and 6.
+BOOST_AUTO_TEST_CASE( testGaussJacksonCoefficients )
+{
+    const GaussJacksonCoefficients& coefficients = GaussJacksonCoefficients::get( );
+
+    // Coefficients of the first back-point for the first start-up point
+    BOOST_CHECK_CLOSE_FRACTION( static_cast< double >( coefficients.positionCoefficients( 0, 0 ) ),
+                                3250433.0 / 53222400.0, 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION( static_cast< double >( coefficients.velocityCoefficients( 0, 0 ) ),
+                                19087.0 / 89600.0, 1.0E-14 );
+
+    // Coefficients at the center of the back-point window (symmetric)
+    for( int m = 0; m < GaussJacksonCoefficients::numberOfBackPoints; m++ )
+    {
+        BOOST_CHECK_SMALL( static_cast< double >(
+                               coefficients.positionCoefficients( 4, m ) - coefficients.positionCoefficients( 4, 8 - m ) ),
+                           1.0E-16 );
+        BOOST_CHECK_SMALL( static_cast< double >(
+                               coefficients.velocityCoefficients( 4, m ) + coefficients.velocityCoefficients( 4, 8 - m ) ),
+                           1.0E-16 );
+    }
+
+    // For a constant acceleration, the position and velocity differ from the second and first sum by 1/12 and 0
+    for( int row = 0; row < GaussJacksonCoefficients::numberOfBackPoints; row++ )
+    {
+        BOOST_CHECK_SMALL( static_cast< double >( coefficients.positionCoefficients.row( row ).sum( ) - 1.0L / 12.0L ),
+                           1.0E-15 );
+        BOOST_CHECK_SMALL( static_cast< double >( coefficients.velocityCoefficients.row( row ).sum( ) ), 1.0E-15 );
+    }
+
+    // Interpolation weights reproduce the nodes, and the value at the center of a linear function
+    for( int m = 0; m < GaussJacksonCoefficients::numberOfBackPoints; m++ )
+    {
+        const Eigen::Matrix< long double, 1, 9 > weights =
+                computeGaussJacksonInterpolationWeights( static_cast< long double >( m ) );
+        for( int i = 0; i < GaussJacksonCoefficients::numberOfBackPoints; i++ )
+        {
+            BOOST_CHECK_SMALL( static_cast< double >( weights( i ) - ( ( i == m ) ? 1.0L : 0.0L ) ), 1.0E-15 );
+        }
+    }
+    BOOST_CHECK_SMALL( static_cast< double >(
+                           computeGaussJacksonInterpolationWeights( 3.5L ).dot(
+                               Eigen::Matrix< long double, 9, 1 >::LinSpaced( 9, 0.0L, 8.0L ) ) - 3.5L ), 1.0E-15 );
+
+    BOOST_CHECK( coefficients.positionErrorFactor > 0.0L && coefficients.positionErrorFactor < 1.0L );
+}
+
+//! Test that polynomial accelerations (of degree below the order) are integrated exactly.
+BOOST_AUTO_TEST_CASE( testGaussJacksonPolynomialAcceleration )
+{
+    GaussJacksonIntegratorXd integrator(
+                &computePolynomialAccelerationStateDerivative, 0.0, Eigen::VectorXd::Zero( 6 ) );
+    for( int i = 0; i < 40; i++ )
+    {
+        const Eigen::VectorXd state = integrator.performIntegrationStep( 0.25 );
+        const Eigen::VectorXd analyticalState =
+                computePolynomialAccelerationState( integrator.getCurrentIndependentVariable( ) );
+        for( int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_SMALL( state( j ) - analyticalState( j ),
+                               1.0E-13 * std::max( analyticalState.cwiseAbs( ).maxCoeff( ), 1.0 ) );
+        }
+    }
+    BOOST_CHECK_EQUAL( integrator.getNumberOfStartUps( ), 1 );
+    BOOST_CHECK_EQUAL( integrator.getNumberOfGaussJacksonSteps( ), 32 );
+}
+
+//! Test fixed step size integration of a Keplerian orbit, including the convergence order.
+BOOST_AUTO_TEST_CASE( testGaussJacksonFixedStepSizeKeplerOrbit )
+{
+    const double propagationTime = 86400.0;
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( propagationTime, initialState, analyticalFinalState );
+
+    std::vector< double > positionErrors;
+    for( double stepSize : { 120.0, 60.0 } )
+    {
+        OrbitStateDerivative stateDerivative;
+        GaussJacksonIntegratorXd integrator(
+                    std::bind( &OrbitStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                               std::placeholders::_1, std::placeholders::_2 ), 0.0, initialState );
+        const Eigen::VectorXd finalState = integrator.integrateTo( propagationTime, stepSize );
+
+        BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), propagationTime );
+        positionErrors.push_back( ( finalState - analyticalFinalState ).segment( 0, 3 ).norm( ) );
+
+        // Single state derivative evaluation per step (after start-up)
+        const int numberOfSteps = static_cast< int >( propagationTime / stepSize );
+        BOOST_CHECK_EQUAL( integrator.getNumberOfGaussJacksonSteps( ), numberOfSteps - 8 );
+        BOOST_CHECK( stateDerivative.numberOfEvaluations_ < numberOfSteps + 200 );
+    }
+
+    // Check accuracy, and (approximately) 8th-order convergence
+    BOOST_CHECK_SMALL( positionErrors.at( 1 ), 1.0E-2 );
+    BOOST_CHECK( positionErrors.at( 0 ) / positionErrors.at( 1 ) > 64.0 );
+}
+
+//! Test that a matrix state is integrated column-by-column identically to a vector state.
+BOOST_AUTO_TEST_CASE( testGaussJacksonMatrixState )
+{
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( 0.0, initialState, analyticalFinalState );
+
+    // Two bodies in a single (twelve-row) vector state, and as two columns of a matrix state
+    Eigen::VectorXd secondInitialState = initialState;
+    secondInitialState.segment( 0, 3 ) *= 1.1;
+    Eigen::VectorXd vectorInitialState = Eigen::VectorXd::Zero( 12 );
+    vectorInitialState << initialState, secondInitialState;
+    Eigen::MatrixXd matrixInitialState = Eigen::MatrixXd::Zero( 6, 2 );
+    matrixInitialState << initialState, secondInitialState;
+
+    OrbitStateDerivative stateDerivative( 1.0826E-3 );
+    GaussJacksonIntegratorXd vectorIntegrator(
+                std::bind( &OrbitStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 ), 0.0, vectorInitialState );
+    GaussJacksonIntegrator< double, Eigen::MatrixXd, Eigen::MatrixXd > matrixIntegrator(
+                std::bind( &OrbitStateDerivative::computeStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 ), 0.0, matrixInitialState );
+
+    const Eigen::VectorXd vectorFinalState = vectorIntegrator.integrateTo( 3600.0, 30.0 );
+    const Eigen::MatrixXd matrixFinalState = matrixIntegrator.integrateTo( 3600.0, 30.0 );
+    for( int i = 0; i < 6; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( vectorFinalState( i ), matrixFinalState( i, 0 ), 1.0E-12 );
+        BOOST_CHECK_CLOSE_FRACTION( vectorFinalState( i + 6 ), matrixFinalState( i, 1 ), 1.0E-12 );
+    }
+
+    // Check that a state of which the size is not a multiple of six is rejected
+    bool isExceptionCaught = false;
+    try
+    {
+        GaussJacksonIntegratorXd invalidIntegrator(
+                    &computePolynomialAccelerationStateDerivative, 0.0, Eigen::VectorXd::Zero( 7 ) );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
+//! Test rollback, state modification and step size changes.
+BOOST_AUTO_TEST_CASE( testGaussJacksonRollbackAndStepSizeChange )
+{
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( 3000.0, initialState, analyticalFinalState );
+
+    OrbitStateDerivative stateDerivative;
+    GaussJacksonIntegratorXd integrator(
+                std::bind( &OrbitStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 ), 0.0, initialState );
+
+    // Rollback during start-up and after start-up
+    for( int i = 0; i < 20; i++ )
+    {
+        const Eigen::VectorXd state = integrator.performIntegrationStep( 20.0 );
+        if( i == 3 || i == 15 )
+        {
+            BOOST_CHECK( integrator.rollbackToPreviousState( ) );
+            BOOST_CHECK( !integrator.rollbackToPreviousState( ) );
+            BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), 20.0 * static_cast< double >( i ) );
+            const Eigen::VectorXd repeatedState = integrator.performIntegrationStep( 20.0 );
+            for( int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( state( j ), repeatedState( j ) );
+            }
+        }
+    }
+
+    // Modification of the state without change does not restart the integrator
+    integrator.modifyCurrentState( integrator.getCurrentState( ) );
+    integrator.performIntegrationStep( 20.0 );
+    BOOST_CHECK_EQUAL( integrator.getNumberOfStartUps( ), 1 );
+
+    // Halving and doubling of the step size is done by interpolation (without restart)
+    for( int i = 0; i < 20; i++ )
+    {
+        integrator.performIntegrationStep( 10.0 );
+    }
+    for( int i = 0; i < 20; i++ )
+    {
+        integrator.performIntegrationStep( 20.0 );
+    }
+    BOOST_CHECK_EQUAL( integrator.getNumberOfStartUps( ), 1 );
+
+    // Integrate to final time, which requires a shorter final step (restart)
+    const Eigen::VectorXd finalState = integrator.integrateTo( 3000.0, 20.0 * 7.0 / 3.0 );
+    BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), 3000.0 );
+    BOOST_CHECK_SMALL( ( finalState - analyticalFinalState ).segment( 0, 3 ).norm( ), 1.0E-4 );
+
+    // Modification of the state restarts the integrator
+    Eigen::VectorXd modifiedState = integrator.getCurrentState( );
+    modifiedState( 3 ) += 1.0;
+    const unsigned int numberOfStartUps = integrator.getNumberOfStartUps( );
+    integrator.modifyCurrentState( modifiedState );
+    integrator.performIntegrationStep( 20.0 );
+    BOOST_CHECK_EQUAL( integrator.getNumberOfStartUps( ), numberOfStartUps + 1 );
+}
+
+//! Test variable step size integration of a low Earth orbit, compared to Runge-Kutta-Fehlberg 7(8) and
+//! Adams-Bashforth-Moulton integration, in terms of accuracy and number of state derivative evaluations.
+BOOST_AUTO_TEST_CASE( testGaussJacksonVariableStepSizeBenchmark )
+{
+    const double propagationTime = 86400.0;
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( propagationTime, initialState, analyticalFinalState );
+
+    // A looser tolerance is used for Adams-Bashforth-Moulton, which requires a very large number of evaluations for
+    // tighter tolerances
+    const std::vector< double > tolerances = { 1.0E-13, 1.0E-13, 1.0E-11 };
+    std::vector< double > positionErrors;
+    std::vector< int > numberOfEvaluations;
+    for( unsigned int integratorType = 0; integratorType < 3; integratorType++ )
+    {
+        const double tolerance = tolerances.at( integratorType );
+        OrbitStateDerivative stateDerivative;
+        std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+                std::bind( &OrbitStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 );
+
+        std::shared_ptr< IntegratorSettings< > > integratorSettings;
+        if( integratorType == 0 )
+        {
+            integratorSettings = std::make_shared< GaussJacksonVariableStepSizeSettings< > >(
+                        0.0, 10.0, 1.0E-3, 1000.0, tolerance, tolerance );
+        }
+        else if( integratorType == 1 )
+        {
+            integratorSettings = std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                        0.0, 10.0, RungeKuttaCoefficients::rungeKuttaFehlberg78, 1.0E-3, 1000.0, tolerance, tolerance );
+        }
+        else
+        {
+            integratorSettings = std::make_shared< AdamsBashforthMoultonSettings< > >(
+                        0.0, 10.0, 1.0E-3, 1000.0, tolerance, tolerance );
+        }
+
+        std::shared_ptr< NumericalIntegrator< > > integrator =
+                createIntegrator< double, Eigen::VectorXd >( stateDerivativeFunction, initialState, integratorSettings );
+        const Eigen::VectorXd finalState = integrator->integrateTo( propagationTime, 10.0 );
+        BOOST_CHECK_CLOSE_FRACTION( integrator->getCurrentIndependentVariable( ), propagationTime, 1.0E-15 );
+
+        positionErrors.push_back( ( finalState - analyticalFinalState ).segment( 0, 3 ).norm( ) );
+        numberOfEvaluations.push_back( stateDerivative.numberOfEvaluations_ );
+    }
+
+    // Gauss-Jackson is more accurate than the other integrators, with far fewer evaluations
+    BOOST_CHECK_SMALL( positionErrors.at( 0 ), 1.0E-3 );
+    BOOST_CHECK( positionErrors.at( 0 ) < positionErrors.at( 1 ) );
+    BOOST_CHECK( positionErrors.at( 0 ) < positionErrors.at( 2 ) );
+    BOOST_CHECK( 5 * numberOfEvaluations.at( 0 ) < numberOfEvaluations.at( 1 ) );
+    BOOST_CHECK( 5 * numberOfEvaluations.at( 0 ) < numberOfEvaluations.at( 2 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
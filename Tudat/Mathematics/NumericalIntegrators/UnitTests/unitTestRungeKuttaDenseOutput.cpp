@@ -0,0 +1,262 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Fehlberg, E. Classical Fifth-, Sixth-, Seventh-, and Eighth-Order Runge-Kutta Formulas With
+ *          Stepsize Control, Marshall Spaceflight Center, NASA TR R-278, 1968.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/UnitTests/numericalIntegratorTestFunctions.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using numerical_integrators::RungeKuttaCoefficients;
+using numerical_integrators::RungeKuttaVariableStepSizeIntegratorXd;
+using numerical_integrator_test_functions::computeFehlbergLogirithmicTestODEStateDerivative;
+using numerical_integrator_test_functions::computeAnalyticalStateFehlbergODE;
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_dense_output )
+
+//! Test the consistency of the dense output coefficients of the coefficient sets.
+BOOST_AUTO_TEST_CASE( testDenseOutputCoefficients )
+{
+    // Check which coefficient sets provide dense output
+    BOOST_CHECK_EQUAL( RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 ).
+                       isDenseOutputAvailable( ), false );
+    BOOST_CHECK_EQUAL( RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg56 ).
+                       isDenseOutputAvailable( ), false );
+
+    std::vector< RungeKuttaCoefficients::CoefficientSets > denseOutputCoefficientSets =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg78, RungeKuttaCoefficients::rungeKutta87DormandPrince,
+      RungeKuttaCoefficients::rungeKutta54DormandPrince };
+    for( unsigned int i = 0; i < denseOutputCoefficientSets.size( ); i++ )
+    {
+        const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( denseOutputCoefficientSets.at( i ) );
+        BOOST_CHECK_EQUAL( coefficients.isDenseOutputAvailable( ), true );
+        BOOST_CHECK_EQUAL( coefficients.denseOutputCoefficients.rows( ), coefficients.cCoefficients.rows( ) );
+
+        // At the end of the step, the stage weights must be equal to the b-coefficients of the integrated order estimate
+        Eigen::VectorXd integratedBCoefficients = coefficients.bCoefficients.row(
+                    ( coefficients.orderEstimateToIntegrate == RungeKuttaCoefficients::lower ) ? 0 : 1 ).transpose( );
+        Eigen::VectorXd stageWeightsAtEndOfStep = coefficients.denseOutputCoefficients.rowwise( ).sum( );
+        for( int j = 0; j < integratedBCoefficients.rows( ); j++ )
+        {
+            BOOST_CHECK_SMALL( stageWeightsAtEndOfStep( j ) - integratedBCoefficients( j ), 1.0E-14 );
+        }
+
+        // Derivative of interpolant must be equal to stage derivatives at start of step (stage weights d/dtheta)
+        for( int j = 0; j < integratedBCoefficients.rows( ); j++ )
+        {
+            BOOST_CHECK_SMALL( coefficients.denseOutputCoefficients( j, 0 ) - ( ( j == 0 ) ? 1.0 : 0.0 ), 1.0E-13 );
+        }
+    }
+
+    // Check that singular conditions are rejected (Simpson's rule is exact for the cubic derivative of a quartic)
+    RungeKuttaCoefficients rungeKuttaFehlberg78Coefficients =
+            RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 );
+    bool isExceptionCaught = false;
+    try
+    {
+        numerical_integrators::setDenseOutputCoefficients( rungeKuttaFehlberg78Coefficients, { 0, 5, 12 } );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
+
+//! Test the accuracy of the dense output, using benchmark ODE of Fehlberg (1968), and check that no state derivatives
+//! are evaluated to compute it.
+BOOST_AUTO_TEST_CASE( testDenseOutputAccuracy )
+{
+    std::vector< RungeKuttaCoefficients::CoefficientSets > denseOutputCoefficientSets =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg78, RungeKuttaCoefficients::rungeKutta87DormandPrince };
+
+    // Maximum interpolation errors (the continuous extensions are of lower order than the integrators)
+    std::vector< double > interpolationTolerances = { 1.5E-9, 1.0E-10 };
+
+    for( unsigned int i = 0; i < denseOutputCoefficientSets.size( ); i++ )
+    {
+        // Wrap state derivative function to count the number of evaluations
+        unsigned int numberOfStateDerivativeEvaluations = 0;
+        std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+                [ & ]( const double time, const Eigen::VectorXd& state )
+        {
+            numberOfStateDerivativeEvaluations++;
+            return computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+        };
+
+        const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+        RungeKuttaVariableStepSizeIntegratorXd integrator(
+                    RungeKuttaCoefficients::get( denseOutputCoefficientSets.at( i ) ), stateDerivativeFunction,
+                    0.0, initialState, 1.0E-12, 0.1, 1.0E-13, 1.0E-13 );
+        BOOST_CHECK_EQUAL( integrator.isDenseOutputAvailable( ), true );
+
+        // Dense output is not available before first step is taken
+        bool isExceptionCaught = false;
+        try
+        {
+            integrator.getDenseOutputState( 0.0 );
+        }
+        catch( std::runtime_error& )
+        {
+            isExceptionCaught = true;
+        }
+        BOOST_CHECK_EQUAL( isExceptionCaught, true );
+
+        double stepSize = 1.0E-3;
+        double maximumInterpolationError = 0.0;
+        double maximumIntegrationError = 0.0;
+        while( integrator.getCurrentIndependentVariable( ) < 3.0 )
+        {
+            integrator.performIntegrationStep( stepSize );
+            stepSize = integrator.getNextStepSize( );
+
+            const double previousTime = integrator.getPreviousIndependentVariable( );
+            const double currentTime = integrator.getCurrentIndependentVariable( );
+            const unsigned int numberOfEvaluationsAfterStep = numberOfStateDerivativeEvaluations;
+
+            // Dense output at ends of step must match integrated states
+            Eigen::VectorXd stateAtStartOfStep = integrator.getDenseOutputState( previousTime );
+            Eigen::VectorXd stateAtEndOfStep = integrator.getDenseOutputState( currentTime );
+            for( int j = 0; j < 2; j++ )
+            {
+                BOOST_CHECK_CLOSE_FRACTION( stateAtStartOfStep( j ), integrator.getPreviousState( )( j ),
+                                            std::numeric_limits< double >::epsilon( ) );
+                BOOST_CHECK_CLOSE_FRACTION( stateAtEndOfStep( j ), integrator.getCurrentState( )( j ),
+                                            1.0E-14 );
+            }
+
+            // Compare integrated state and dense output within step to analytical solution
+            maximumIntegrationError = std::max(
+                        maximumIntegrationError, ( integrator.getCurrentState( ) -
+                                                   computeAnalyticalStateFehlbergODE( currentTime, initialState ) ).
+                        cwiseAbs( ).maxCoeff( ) );
+            for( unsigned int k = 1; k < 10; k++ )
+            {
+                const double interpolationTime = previousTime + static_cast< double >( k ) / 10.0 *
+                        ( currentTime - previousTime );
+                Eigen::VectorXd interpolationError = integrator.getDenseOutputState( interpolationTime ) -
+                        computeAnalyticalStateFehlbergODE( interpolationTime, initialState );
+                maximumInterpolationError = std::max( maximumInterpolationError, interpolationError.cwiseAbs( ).maxCoeff( ) );
+            }
+
+            // Check that dense output did not require any state derivative evaluations
+            BOOST_CHECK_EQUAL( numberOfStateDerivativeEvaluations, numberOfEvaluationsAfterStep );
+        }
+        BOOST_CHECK_SMALL( maximumIntegrationError, 1.0E-11 );
+        BOOST_CHECK_SMALL( maximumInterpolationError, interpolationTolerances.at( i ) );
+
+        // Dense output is not available outside of last step
+        isExceptionCaught = false;
+        try
+        {
+            integrator.getDenseOutputState(
+                        integrator.getCurrentIndependentVariable( ) + 0.01 * integrator.getNextStepSize( ) );
+        }
+        catch( std::runtime_error& )
+        {
+            isExceptionCaught = true;
+        }
+        BOOST_CHECK_EQUAL( isExceptionCaught, true );
+
+        // Dense output is not available after rolling back the last step
+        integrator.rollbackToPreviousState( );
+        isExceptionCaught = false;
+        try
+        {
+            integrator.getDenseOutputState( integrator.getCurrentIndependentVariable( ) );
+        }
+        catch( std::runtime_error& )
+        {
+            isExceptionCaught = true;
+        }
+        BOOST_CHECK_EQUAL( isExceptionCaught, true );
+    }
+}
+
+//! Test the order of the dense output, by halving the (fixed) step size.
+BOOST_AUTO_TEST_CASE( testDenseOutputOrder )
+{
+    std::vector< RungeKuttaCoefficients::CoefficientSets > denseOutputCoefficientSets =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg78, RungeKuttaCoefficients::rungeKutta87DormandPrince };
+
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+    for( unsigned int i = 0; i < denseOutputCoefficientSets.size( ); i++ )
+    {
+        std::vector< double > interpolationErrors;
+        for( double stepSize = 0.2; stepSize > 0.02; stepSize /= 2.0 )
+        {
+            // Take single step without step size control, starting from exact solution
+            const double initialTime = 1.0;
+            RungeKuttaVariableStepSizeIntegratorXd integrator(
+                        RungeKuttaCoefficients::get( denseOutputCoefficientSets.at( i ) ),
+                        &computeFehlbergLogirithmicTestODEStateDerivative,
+                        initialTime, computeAnalyticalStateFehlbergODE( initialTime, initialState ),
+                        1.0E-12, 1.0, 1.0E-13, 1.0E-13 );
+            integrator.setStepSizeControl( false );
+            integrator.performIntegrationStep( stepSize );
+
+            const double interpolationTime = initialTime + 0.5 * stepSize;
+            interpolationErrors.push_back(
+                        ( integrator.getDenseOutputState( interpolationTime ) -
+                          computeAnalyticalStateFehlbergODE( interpolationTime, initialState ) ).cwiseAbs( ).maxCoeff( ) );
+        }
+
+        // Local error of fifth-order continuous extension must decrease by a factor 2^6 when halving the step size
+        // (allowing for a margin)
+        for( unsigned int j = 1; j < interpolationErrors.size( ); j++ )
+        {
+            BOOST_CHECK_GT( interpolationErrors.at( j - 1 ) / interpolationErrors.at( j ), 40.0 );
+        }
+    }
+}
+
+//! Test that dense output is refused by integrators for which it is not available.
+BOOST_AUTO_TEST_CASE( testDenseOutputUnavailable )
+{
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+    RungeKuttaVariableStepSizeIntegratorXd integrator(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 ),
+                &computeFehlbergLogirithmicTestODEStateDerivative,
+                0.0, initialState, 1.0E-12, 0.1, 1.0E-13, 1.0E-13 );
+    BOOST_CHECK_EQUAL( integrator.isDenseOutputAvailable( ), false );
+
+    integrator.performIntegrationStep( 1.0E-3 );
+    bool isExceptionCaught = false;
+    try
+    {
+        integrator.getDenseOutputState( integrator.getCurrentIndependentVariable( ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,479 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Dormand, J.R., El-Mikkawy, M.E.A., Prince, P.J. Families of Runge-Kutta-Nystrom formulae, IMA Journal of
+ *          Numerical Analysis, 7(2), 1987.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaNystromIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+using namespace orbital_element_conversions;
+
+//! Gravitational parameter of the Earth used in the tests.
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Class to compute the (Cowell) state derivative of bodies orbiting a point-mass Earth, counting the evaluations.
+class KeplerStateDerivative
+{
+public:
+
+    //! Constructor.
+    KeplerStateDerivative( ): numberOfEvaluations_( 0 ){ }
+
+    //! Function to compute the state derivative of one or more bodies (one or more columns).
+    Eigen::MatrixXd computeStateDerivative( const double time, const Eigen::MatrixXd& state )
+    {
+        numberOfEvaluations_++;
+        Eigen::MatrixXd stateDerivative = Eigen::MatrixXd::Zero( state.rows( ), state.cols( ) );
+        for( int i = 0; i < state.rows( ) / 6; i++ )
+        {
+            for( int j = 0; j < state.cols( ); j++ )
+            {
+                const Eigen::Vector3d position = state.block( 6 * i, j, 3, 1 );
+                const double distance = position.norm( );
+                stateDerivative.block( 6 * i, j, 3, 1 ) = state.block( 6 * i + 3, j, 3, 1 );
+                stateDerivative.block( 6 * i + 3, j, 3, 1 ) =
+                        -earthGravitationalParameter / ( distance * distance * distance ) * position;
+            }
+        }
+        return stateDerivative;
+    }
+
+    //! Function to compute the state derivative of one or more bodies (vector state).
+    Eigen::VectorXd computeVectorStateDerivative( const double time, const Eigen::VectorXd& state )
+    {
+        return computeStateDerivative( time, state );
+    }
+
+    //! Number of state derivative evaluations.
+    int numberOfEvaluations_;
+};
+
+//! Function to compute the state derivative for an acceleration that is a polynomial of degree four in time.
+Eigen::VectorXd computePolynomialAccelerationStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative = Eigen::VectorXd::Zero( 6 );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative( 3 ) = 1.0 - 0.5 * time + 0.02 * std::pow( time, 4 );
+    stateDerivative( 4 ) = 0.1 * std::pow( time, 3 );
+    stateDerivative( 5 ) = -2.0 + 0.05 * std::pow( time, 2 );
+    return stateDerivative;
+}
+
+//! Function to compute the analytical state for the polynomial acceleration (zero initial position and velocity).
+Eigen::VectorXd computePolynomialAccelerationState( const double time )
+{
+    Eigen::VectorXd state = Eigen::VectorXd::Zero( 6 );
+    state( 0 ) = time * time / 2.0 - 0.5 * std::pow( time, 3 ) / 6.0 + 0.02 * std::pow( time, 6 ) / 30.0;
+    state( 1 ) = 0.1 * std::pow( time, 5 ) / 20.0;
+    state( 2 ) = -time * time + 0.05 * std::pow( time, 4 ) / 12.0;
+    state( 3 ) = time - 0.5 * time * time / 2.0 + 0.02 * std::pow( time, 5 ) / 5.0;
+    state( 4 ) = 0.1 * std::pow( time, 4 ) / 4.0;
+    state( 5 ) = -2.0 * time + 0.05 * std::pow( time, 3 ) / 3.0;
+    return state;
+}
+
+//! Function to compute the state derivative of a damped harmonic oscillator (velocity-dependent acceleration).
+Eigen::VectorXd computeDampedOscillatorStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative = Eigen::VectorXd::Zero( 6 );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -state.segment( 0, 3 ) - 0.2 * state.segment( 3, 3 );
+    return stateDerivative;
+}
+
+//! Function to retrieve the initial state, and the analytical final state, of the (Keplerian) test orbit.
+void getKeplerOrbitStates( const double propagationTime, Eigen::VectorXd& initialState, Eigen::VectorXd& finalState )
+{
+    Eigen::Vector6d keplerianElements;
+    keplerianElements << 7000.0E3, 0.05, 1.2, 0.4, 0.3, 0.1;
+    initialState = convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter );
+    finalState = convertKeplerianToCartesianElements(
+                propagateKeplerOrbit( keplerianElements, propagationTime, earthGravitationalParameter ),
+                earthGravitationalParameter );
+}
+
+//! Function to create a Runge-Kutta-Nystrom 6(4) integrator for a Keplerian orbit (velocity-independent acceleration).
+RungeKuttaNystromIntegratorXd createKeplerOrbitIntegrator(
+        KeplerStateDerivative& stateDerivative, const Eigen::VectorXd& initialState, const double tolerance = 1.0E-12 )
+{
+    return RungeKuttaNystromIntegratorXd(
+                RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince ),
+                std::bind( &KeplerStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 ),
+                0.0, initialState, 1.0E-3, 1000.0, tolerance, tolerance, 0.8, 4.0, 0.1, true );
+}
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_nystrom_integrator )
+
+//! Test the coefficients against the order conditions (Dormand et al., 1987).
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromCoefficients )
+{
+    const RungeKuttaNystromCoefficients& coefficients =
+            RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince );
+    const Eigen::VectorXd& c = coefficients.cCoefficients;
+    const int numberOfStages = c.rows( );
+    BOOST_CHECK_EQUAL( numberOfStages, 6 );
+    BOOST_CHECK_EQUAL( coefficients.higherOrder, 6 );
+    BOOST_CHECK_EQUAL( coefficients.lowerOrder, 4 );
+
+    // Stage positions are exact for constant accelerations, and stage velocities for polynomials of degree i - 1
+    for( int i = 0; i < numberOfStages; i++ )
+    {
+        BOOST_CHECK_SMALL( coefficients.aCoefficients.row( i ).sum( ) - c( i ) * c( i ) / 2.0, 1.0E-15 );
+        for( int k = 0; k < i; k++ )
+        {
+            BOOST_CHECK_SMALL( coefficients.stageVelocityCoefficients.row( i ).dot( c.array( ).pow( k ).matrix( ) ) -
+                               std::pow( c( i ), k + 1 ) / static_cast< double >( k + 1 ), 1.0E-14 );
+        }
+    }
+
+    // Quadrature conditions of the velocity and position weights of the higher (o = 1) and lower (o = 0) order
+    for( int o = 0; o < 2; o++ )
+    {
+        const int order = ( o == 0 ) ? 4 : 6;
+        for( int k = 0; k < order; k++ )
+        {
+            BOOST_CHECK_SMALL( coefficients.bVelocityCoefficients.row( o ).dot( c.array( ).pow( k ).matrix( ) ) -
+                               1.0 / static_cast< double >( k + 1 ), 1.0E-14 );
+            if( k < order - 1 )
+            {
+                BOOST_CHECK_SMALL( coefficients.bPositionCoefficients.row( o ).dot( c.array( ).pow( k ).matrix( ) ) -
+                                   1.0 / static_cast< double >( ( k + 1 ) * ( k + 2 ) ), 1.0E-14 );
+            }
+        }
+
+        // Non-quadrature condition sum_{i} b_{i} sum_{j} a_{ij} c_{j} = 1/24
+        BOOST_CHECK_SMALL( coefficients.bVelocityCoefficients.row( o ).dot( coefficients.aCoefficients * c ) - 1.0 / 24.0,
+                           1.0E-14 );
+    }
+
+    // Last stage is evaluated at the higher order position at the end of the step
+    BOOST_CHECK( coefficients.isFirstSameAsLast );
+    BOOST_CHECK_EQUAL( c( numberOfStages - 1 ), 1.0 );
+    for( int j = 0; j < numberOfStages; j++ )
+    {
+        BOOST_CHECK_EQUAL( coefficients.aCoefficients( numberOfStages - 1, j ), coefficients.bPositionCoefficients( 1, j ) );
+    }
+
+    // Check that an undefined coefficient set is rejected
+    bool isExceptionCaught = false;
+    try
+    {
+        RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::undefinedCoefficientSet );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
+//! Test that polynomial accelerations (of degree below the order) are integrated exactly.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromPolynomialAcceleration )
+{
+    RungeKuttaNystromIntegratorXd integrator(
+                RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince ),
+                &computePolynomialAccelerationStateDerivative, 0.0, Eigen::VectorXd::Zero( 6 ), 1.0E-3, 10.0,
+                1.0E-12, 1.0E-12, 0.8, 4.0, 0.1, true );
+    integrator.setStepSizeControl( false );
+    for( int i = 0; i < 40; i++ )
+    {
+        const Eigen::VectorXd state = integrator.performIntegrationStep( 0.25 );
+        const Eigen::VectorXd analyticalState =
+                computePolynomialAccelerationState( integrator.getCurrentIndependentVariable( ) );
+        for( int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_SMALL( state( j ) - analyticalState( j ),
+                               1.0E-13 * std::max( analyticalState.cwiseAbs( ).maxCoeff( ), 1.0 ) );
+        }
+    }
+
+    // Five evaluations per step, and one at the initial state
+    BOOST_CHECK_EQUAL( integrator.getNumberOfAccelerationEvaluations( ), 5 * 40 + 1 );
+}
+
+//! Test fixed step size integration of a Keplerian orbit, including the convergence order.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromFixedStepSizeKeplerOrbit )
+{
+    const double propagationTime = 86400.0;
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( propagationTime, initialState, analyticalFinalState );
+
+    std::vector< double > positionErrors, velocityErrors;
+    for( double stepSize : { 60.0, 30.0 } )
+    {
+        KeplerStateDerivative stateDerivative;
+        RungeKuttaNystromIntegratorXd integrator = createKeplerOrbitIntegrator( stateDerivative, initialState );
+        integrator.setStepSizeControl( false );
+        const Eigen::VectorXd finalState = integrator.integrateTo( propagationTime, stepSize );
+
+        BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), propagationTime );
+        positionErrors.push_back( ( finalState - analyticalFinalState ).segment( 0, 3 ).norm( ) );
+        velocityErrors.push_back( ( finalState - analyticalFinalState ).segment( 3, 3 ).norm( ) );
+
+        const int numberOfSteps = static_cast< int >( propagationTime / stepSize );
+        BOOST_CHECK_EQUAL( stateDerivative.numberOfEvaluations_, 5 * numberOfSteps + 1 );
+    }
+
+    // Check accuracy, and (approximately) 6th-order convergence
+    BOOST_CHECK_SMALL( positionErrors.at( 1 ), 1.0E-2 );
+    BOOST_CHECK( positionErrors.at( 0 ) / positionErrors.at( 1 ) > 48.0 );
+    BOOST_CHECK( velocityErrors.at( 0 ) / velocityErrors.at( 1 ) > 48.0 );
+}
+
+//! Test that a matrix state is integrated column-by-column identically to a vector state.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromMatrixState )
+{
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( 0.0, initialState, analyticalFinalState );
+
+    // Two bodies in a single (twelve-row) vector state, and as two columns of a matrix state
+    Eigen::VectorXd secondInitialState = initialState;
+    secondInitialState.segment( 0, 3 ) *= 1.1;
+    Eigen::VectorXd vectorInitialState = Eigen::VectorXd::Zero( 12 );
+    vectorInitialState << initialState, secondInitialState;
+    Eigen::MatrixXd matrixInitialState = Eigen::MatrixXd::Zero( 6, 2 );
+    matrixInitialState << initialState, secondInitialState;
+
+    KeplerStateDerivative stateDerivative;
+    RungeKuttaNystromIntegratorXd vectorIntegrator = createKeplerOrbitIntegrator( stateDerivative, vectorInitialState );
+    RungeKuttaNystromIntegrator< double, Eigen::MatrixXd, Eigen::MatrixXd > matrixIntegrator(
+                RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince ),
+                std::bind( &KeplerStateDerivative::computeStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 ),
+                0.0, matrixInitialState, 1.0E-3, 1000.0, 1.0E-12, 1.0E-12, 0.8, 4.0, 0.1, true );
+    vectorIntegrator.setStepSizeControl( false );
+    matrixIntegrator.setStepSizeControl( false );
+
+    const Eigen::VectorXd vectorFinalState = vectorIntegrator.integrateTo( 3600.0, 30.0 );
+    const Eigen::MatrixXd matrixFinalState = matrixIntegrator.integrateTo( 3600.0, 30.0 );
+    for( int i = 0; i < 6; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( vectorFinalState( i ), matrixFinalState( i, 0 ), 1.0E-14 );
+        BOOST_CHECK_CLOSE_FRACTION( vectorFinalState( i + 6 ), matrixFinalState( i, 1 ), 1.0E-14 );
+    }
+
+    // Check that a state of which the size is not a multiple of six is rejected
+    bool isExceptionCaught = false;
+    try
+    {
+        createKeplerOrbitIntegrator( stateDerivative, Eigen::VectorXd::Zero( 7 ) );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
+//! Test rollback and state modification.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromRollbackAndStateModification )
+{
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( 0.0, initialState, analyticalFinalState );
+
+    KeplerStateDerivative stateDerivative;
+    RungeKuttaNystromIntegratorXd integrator = createKeplerOrbitIntegrator( stateDerivative, initialState );
+
+    // Rollback, after which the step is repeated identically
+    double time = 0.0;
+    for( int i = 0; i < 10; i++ )
+    {
+        const double stepSize = ( i == 0 ) ? 20.0 : integrator.getNextStepSize( );
+        const Eigen::VectorXd state = integrator.performIntegrationStep( stepSize );
+        const double newTime = integrator.getCurrentIndependentVariable( );
+        if( i == 5 )
+        {
+            BOOST_CHECK( integrator.rollbackToPreviousState( ) );
+            BOOST_CHECK( !integrator.rollbackToPreviousState( ) );
+            BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), time );
+            const Eigen::VectorXd repeatedState = integrator.performIntegrationStep( stepSize );
+            BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), newTime );
+            for( int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_EQUAL( state( j ), repeatedState( j ) );
+            }
+        }
+        time = newTime;
+    }
+
+    // Modification of the state without change re-uses the last stage acceleration
+    integrator.setStepSizeControl( false );
+    integrator.modifyCurrentState( integrator.getCurrentState( ) );
+    int numberOfEvaluations = stateDerivative.numberOfEvaluations_;
+    integrator.performIntegrationStep( 20.0 );
+    BOOST_CHECK_EQUAL( stateDerivative.numberOfEvaluations_, numberOfEvaluations + 5 );
+
+    // Modification of the state requires a new evaluation at the start of the step
+    Eigen::VectorXd modifiedState = integrator.getCurrentState( );
+    modifiedState( 3 ) += 1.0;
+    integrator.modifyCurrentState( modifiedState );
+    numberOfEvaluations = stateDerivative.numberOfEvaluations_;
+    integrator.performIntegrationStep( 20.0 );
+    BOOST_CHECK_EQUAL( stateDerivative.numberOfEvaluations_, numberOfEvaluations + 6 );
+}
+
+//! Test variable step size integration with a velocity-dependent acceleration (damped harmonic oscillator).
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromVelocityDependentAcceleration )
+{
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 );
+    initialState << 1.0, 0.0, -0.5, 0.0, 1.0, 0.3;
+
+    RungeKuttaNystromIntegratorXd integrator(
+                RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince ),
+                &computeDampedOscillatorStateDerivative, 0.0, initialState, 1.0E-6, 1.0, 1.0E-10, 1.0E-10 );
+    const double finalTime = 10.0;
+    const Eigen::VectorXd finalState = integrator.integrateTo( finalTime, 0.1 );
+
+    // Analytical solution (order of the method is reduced for velocity-dependent accelerations, see
+    // RungeKuttaNystromCoefficients::stageVelocityCoefficients), x( t ) = exp( -t / 10 ) ( x0 cos( w t ) + ( v0 + x0 / 10 ) / w sin( w t ) )
+    const double dampingRate = 0.1;
+    const double frequency = std::sqrt( 1.0 - dampingRate * dampingRate );
+    for( int i = 0; i < 3; i++ )
+    {
+        const double cosineCoefficient = initialState( i );
+        const double sineCoefficient = ( initialState( i + 3 ) + dampingRate * initialState( i ) ) / frequency;
+        const double decay = std::exp( -dampingRate * finalTime );
+        const double position = decay * ( cosineCoefficient * std::cos( frequency * finalTime ) +
+                                          sineCoefficient * std::sin( frequency * finalTime ) );
+        const double velocity = decay * (
+                    ( sineCoefficient * frequency - dampingRate * cosineCoefficient ) * std::cos( frequency * finalTime ) -
+                    ( cosineCoefficient * frequency + dampingRate * sineCoefficient ) * std::sin( frequency * finalTime ) );
+        BOOST_CHECK_SMALL( finalState( i ) - position, 1.0E-7 );
+        BOOST_CHECK_SMALL( finalState( i + 3 ) - velocity, 1.0E-7 );
+    }
+}
+
+//! Test that, for a velocity-dependent acceleration (damped harmonic oscillator), each step only depends on the accepted
+//! state at its start, i.e. that the acceleration of the last stage (evaluated at the stage velocity) is not re-used as
+//! first stage of the next step, unless the accelerations are specified to be velocity-independent.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromFirstStageForVelocityDependentAcceleration )
+{
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 6 );
+    initialState << 1.0, 0.0, -0.5, 0.0, 1.0, 0.3;
+    const RungeKuttaNystromCoefficients coefficients =
+            RungeKuttaNystromCoefficients::get( RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince );
+
+    const int numberOfSteps = 20;
+    const double stepSize = 0.1;
+    for( bool areAccelerationsVelocityIndependent : { false, true } )
+    {
+        RungeKuttaNystromIntegratorXd integrator(
+                    coefficients, &computeDampedOscillatorStateDerivative, 0.0, initialState, 1.0E-6, 1.0,
+                    1.0E-10, 1.0E-10, 0.8, 4.0, 0.1, areAccelerationsVelocityIndependent );
+        integrator.setStepSizeControl( false );
+
+        double maximumDifference = 0.0;
+        for( int i = 0; i < numberOfSteps; i++ )
+        {
+            // Take step with new integrator, starting from current state
+            RungeKuttaNystromIntegratorXd newIntegrator(
+                        coefficients, &computeDampedOscillatorStateDerivative,
+                        integrator.getCurrentIndependentVariable( ), integrator.getCurrentState( ), 1.0E-6, 1.0,
+                        1.0E-10, 1.0E-10, 0.8, 4.0, 0.1, areAccelerationsVelocityIndependent );
+            newIntegrator.setStepSizeControl( false );
+            const Eigen::VectorXd newIntegratorState = newIntegrator.performIntegrationStep( stepSize );
+
+            const Eigen::VectorXd state = integrator.performIntegrationStep( stepSize );
+            maximumDifference = std::max( maximumDifference, ( state - newIntegratorState ).cwiseAbs( ).maxCoeff( ) );
+        }
+
+        if( !areAccelerationsVelocityIndependent )
+        {
+            // Six evaluations per step, and steps identical to those started from the accepted state
+            BOOST_CHECK_EQUAL( integrator.getNumberOfAccelerationEvaluations( ), 6 * numberOfSteps );
+            BOOST_CHECK_EQUAL( maximumDifference, 0.0 );
+        }
+        else
+        {
+            // Five evaluations per step (and one at the initial state), with the first stage acceleration evaluated
+            // at the velocity of the last stage of the previous step
+            BOOST_CHECK_EQUAL( integrator.getNumberOfAccelerationEvaluations( ), 5 * numberOfSteps + 1 );
+            BOOST_CHECK( maximumDifference > 1.0E-12 );
+        }
+    }
+}
+
+//! Test variable step size integration of a low Earth orbit, compared to first-order Runge-Kutta integrators of similar
+//! order, in terms of accuracy and number of state derivative evaluations. The Runge-Kutta-Nystrom integrator is run
+//! with a much looser tolerance, and should still be more accurate with far fewer evaluations.
+BOOST_AUTO_TEST_CASE( testRungeKuttaNystromVariableStepSizeBenchmark )
+{
+    const double propagationTime = 86400.0;
+    const std::vector< double > tolerances = { 1.0E-9, 1.0E-12, 1.0E-12 };
+    Eigen::VectorXd initialState, analyticalFinalState;
+    getKeplerOrbitStates( propagationTime, initialState, analyticalFinalState );
+
+    std::vector< double > positionErrors;
+    std::vector< int > numberOfEvaluations;
+    for( unsigned int integratorType = 0; integratorType < 3; integratorType++ )
+    {
+        KeplerStateDerivative stateDerivative;
+        std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+                std::bind( &KeplerStateDerivative::computeVectorStateDerivative, &stateDerivative,
+                           std::placeholders::_1, std::placeholders::_2 );
+
+        std::shared_ptr< IntegratorSettings< > > integratorSettings;
+        if( integratorType == 0 )
+        {
+            integratorSettings = std::make_shared< RungeKuttaNystromVariableStepSizeSettings< > >(
+                        0.0, 10.0, RungeKuttaNystromCoefficients::rungeKuttaNystrom64DormandElMikkawyPrince,
+                        1.0E-3, 1000.0, tolerances.at( integratorType ), tolerances.at( integratorType ),
+                        1, false, 0.8, 4.0, 0.1, true );
+        }
+        else
+        {
+            integratorSettings = std::make_shared< RungeKuttaVariableStepSizeSettings< > >(
+                        0.0, 10.0, ( integratorType == 1 ) ? RungeKuttaCoefficients::rungeKuttaFehlberg56 :
+                                                             RungeKuttaCoefficients::rungeKutta54DormandPrince,
+                        1.0E-3, 1000.0, tolerances.at( integratorType ), tolerances.at( integratorType ) );
+        }
+
+        std::shared_ptr< NumericalIntegrator< > > integrator =
+                createIntegrator< double, Eigen::VectorXd >( stateDerivativeFunction, initialState, integratorSettings );
+        const Eigen::VectorXd finalState = integrator->integrateTo( propagationTime, 10.0 );
+        BOOST_CHECK_CLOSE_FRACTION( integrator->getCurrentIndependentVariable( ), propagationTime, 1.0E-15 );
+
+        positionErrors.push_back( ( finalState - analyticalFinalState ).segment( 0, 3 ).norm( ) );
+        numberOfEvaluations.push_back( stateDerivative.numberOfEvaluations_ );
+    }
+
+    // Check accuracy and number of evaluations w.r.t. Runge-Kutta-Fehlberg 5(6) and Dormand-Prince 5(4)
+    BOOST_CHECK_SMALL( positionErrors.at( 0 ), 1.0E-2 );
+    for( unsigned int i = 1; i < 3; i++ )
+    {
+        BOOST_CHECK( positionErrors.at( 0 ) < positionErrors.at( i ) );
+        BOOST_CHECK( 3 * numberOfEvaluations.at( 0 ) < numberOfEvaluations.at( i ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,251 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Fehlberg, E. Classical Fifth-, Sixth-, Seventh-, and Eighth-Order Runge-Kutta Formulas With
+ *          Stepsize Control, Marshall Spaceflight Center, NASA TR R-278, 1968.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaTableauIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaTableaux.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/UnitTests/numericalIntegratorTestFunctions.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+using numerical_integrator_test_functions::computeFehlbergLogirithmicTestODEStateDerivative;
+using numerical_integrator_test_functions::computeAnalyticalStateFehlbergODE;
+
+//! Function to check the consistency of a compile-time Butcher tableau, and of the run-time coefficients created from it.
+template< typename TableauType >
+void checkTableauConsistency( const bool expectedFirstSameAsLast )
+{
+    const RungeKuttaCoefficients& coefficients = RungeKuttaCoefficients::get( TableauType::coefficientSet );
+    BOOST_CHECK_EQUAL( coefficients.cCoefficients.rows( ), TableauType::numberOfStages );
+    BOOST_CHECK_EQUAL( coefficients.lowerOrder, TableauType::lowerOrder );
+    BOOST_CHECK_EQUAL( coefficients.higherOrder, TableauType::higherOrder );
+    BOOST_CHECK_EQUAL( coefficients.orderEstimateToIntegrate, TableauType::orderEstimateToIntegrate );
+
+    for( unsigned int stage = 0; stage < TableauType::numberOfStages; stage++ )
+    {
+        // Check that run-time coefficients are identical to tableau
+        for( unsigned int column = 0; column < stage; column++ )
+        {
+            BOOST_CHECK_EQUAL( coefficients.aCoefficients( stage, column ), TableauType::aCoefficients[ stage ][ column ] );
+        }
+        BOOST_CHECK_EQUAL( coefficients.bCoefficients( 0, stage ), TableauType::bCoefficients[ 0 ][ stage ] );
+        BOOST_CHECK_EQUAL( coefficients.bCoefficients( 1, stage ), TableauType::bCoefficients[ 1 ][ stage ] );
+        BOOST_CHECK_EQUAL( coefficients.cCoefficients( stage ), TableauType::cCoefficients[ stage ] );
+
+        // Check that the nodes are consistent with the a-coefficients (c_i = sum_j a_ij)
+        double aCoefficientsSum = 0.0;
+        for( unsigned int column = 0; column < stage; column++ )
+        {
+            aCoefficientsSum += TableauType::aCoefficients[ stage ][ column ];
+        }
+        BOOST_CHECK_SMALL( aCoefficientsSum - TableauType::cCoefficients[ stage ], 1.0E-12 );
+    }
+
+    // Check that both order estimates are consistent (sum_i b_i = 1)
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        double bCoefficientsSum = 0.0;
+        for( unsigned int stage = 0; stage < TableauType::numberOfStages; stage++ )
+        {
+            bCoefficientsSum += TableauType::bCoefficients[ i ][ stage ];
+        }
+        BOOST_CHECK_SMALL( bCoefficientsSum - 1.0, 1.0E-14 );
+    }
+
+    BOOST_CHECK_EQUAL( isTableauFirstSameAsLast< TableauType >( ), expectedFirstSameAsLast );
+}
+
+//! Function to integrate the benchmark ODE of Fehlberg (1968) with both the run-time and compile-time coefficients,
+//! and check that the results are identical, and that the number of state derivative evaluations is as expected.
+template< typename TableauType >
+void compareWithRunTimeCoefficients( )
+{
+    const double initialTime = 0.0;
+    const double finalTime = 3.0;
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+
+    // Wrap state derivative functions to count the number of evaluations
+    unsigned int numberOfRunTimeEvaluations = 0;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > runTimeStateDerivativeFunction =
+            [ & ]( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfRunTimeEvaluations++;
+        return computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+    };
+    unsigned int numberOfTableauEvaluations = 0;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > tableauStateDerivativeFunction =
+            [ & ]( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfTableauEvaluations++;
+        return computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+    };
+
+    RungeKuttaVariableStepSizeIntegratorXd runTimeIntegrator(
+                RungeKuttaCoefficients::get( TableauType::coefficientSet ), runTimeStateDerivativeFunction,
+                initialTime, initialState, 1.0E-12, 0.5, 1.0E-10, 1.0E-10 );
+    RungeKuttaTableauIntegrator< TableauType > tableauIntegrator(
+                tableauStateDerivativeFunction, initialTime, initialState, 1.0E-12, 0.5, 1.0E-10, 1.0E-10 );
+
+    // Integrate with both integrators, starting with a step size that is too large (so that steps are rejected)
+    double stepSize = 0.5;
+    unsigned int numberOfSteps = 0;
+    while( runTimeIntegrator.getCurrentIndependentVariable( ) < finalTime )
+    {
+        stepSize = std::min( stepSize, finalTime - runTimeIntegrator.getCurrentIndependentVariable( ) );
+        Eigen::VectorXd runTimeState = runTimeIntegrator.performIntegrationStep( stepSize );
+        Eigen::VectorXd tableauState = tableauIntegrator.performIntegrationStep( stepSize );
+        numberOfSteps++;
+
+        // Check that states and step sizes are identical (to the bit)
+        BOOST_CHECK_EQUAL( runTimeIntegrator.getCurrentIndependentVariable( ),
+                           tableauIntegrator.getCurrentIndependentVariable( ) );
+        BOOST_CHECK_EQUAL( runTimeIntegrator.getNextStepSize( ), tableauIntegrator.getNextStepSize( ) );
+        for( int i = 0; i < 2; i++ )
+        {
+            BOOST_CHECK_EQUAL( runTimeState( i ), tableauState( i ) );
+        }
+        stepSize = runTimeIntegrator.getNextStepSize( );
+    }
+
+    // Check accuracy of result
+    const Eigen::VectorXd finalStateError = tableauIntegrator.getCurrentState( ) -
+            computeAnalyticalStateFehlbergODE( finalTime, initialState );
+    BOOST_CHECK_SMALL( finalStateError.cwiseAbs( ).maxCoeff( ), 1.0E-7 );
+
+    // The run-time integrator evaluates all stages for each attempted step. The compile-time integrator evaluates the
+    // first stage once per step, and (for FSAL tableaux) only for the first step.
+    const unsigned int numberOfAttemptedSteps = numberOfRunTimeEvaluations / TableauType::numberOfStages;
+    BOOST_CHECK_EQUAL( numberOfRunTimeEvaluations % TableauType::numberOfStages, 0 );
+    BOOST_CHECK_GT( numberOfAttemptedSteps, numberOfSteps );
+
+    unsigned int expectedNumberOfTableauEvaluations =
+            numberOfRunTimeEvaluations - ( numberOfAttemptedSteps - numberOfSteps );
+    if( tableauIntegrator.isFirstSameAsLast( ) )
+    {
+        expectedNumberOfTableauEvaluations -= ( numberOfSteps - 1 );
+    }
+    BOOST_CHECK_EQUAL( numberOfTableauEvaluations, expectedNumberOfTableauEvaluations );
+}
+
+BOOST_AUTO_TEST_SUITE( test_runge_kutta_tableau_integrator )
+
+//! Test the consistency of the compile-time Butcher tableaux.
+BOOST_AUTO_TEST_CASE( testRungeKuttaTableaux )
+{
+    checkTableauConsistency< RungeKuttaFehlberg45Tableau >( false );
+    checkTableauConsistency< RungeKuttaFehlberg56Tableau >( false );
+    checkTableauConsistency< RungeKuttaFehlberg78Tableau >( false );
+    checkTableauConsistency< RungeKutta87DormandPrinceTableau >( false );
+    checkTableauConsistency< RungeKutta54DormandPrinceTableau >( true );
+}
+
+//! Test that the compile-time tableau integrators reproduce the run-time coefficient integrators, with fewer
+//! state derivative evaluations.
+BOOST_AUTO_TEST_CASE( testRungeKuttaTableauIntegrators )
+{
+    compareWithRunTimeCoefficients< RungeKuttaFehlberg45Tableau >( );
+    compareWithRunTimeCoefficients< RungeKuttaFehlberg56Tableau >( );
+    compareWithRunTimeCoefficients< RungeKuttaFehlberg78Tableau >( );
+    compareWithRunTimeCoefficients< RungeKutta87DormandPrinceTableau >( );
+    compareWithRunTimeCoefficients< RungeKutta54DormandPrinceTableau >( );
+}
+
+//! Test that the re-used last stage of an FSAL tableau is discarded when the state is modified.
+BOOST_AUTO_TEST_CASE( testFirstSameAsLastStateModification )
+{
+    unsigned int numberOfEvaluations = 0;
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            [ & ]( const double time, const Eigen::VectorXd& state )
+    {
+        numberOfEvaluations++;
+        return computeFehlbergLogirithmicTestODEStateDerivative( time, state );
+    };
+
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+    RungeKuttaTableauIntegrator< RungeKutta54DormandPrinceTableau > integrator(
+                stateDerivativeFunction, 0.0, initialState, 1.0E-12, 1.0, 1.0E-10, 1.0E-10 );
+    integrator.setStepSizeControl( false );
+
+    // Subsequent steps re-use the last stage
+    integrator.performIntegrationStep( 0.01 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 7 );
+    integrator.performIntegrationStep( 0.01 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 13 );
+
+    // After modifying the state, the first stage is recomputed, and the step must be identical to that of a new integrator
+    const Eigen::VectorXd modifiedState = 1.01 * integrator.getCurrentState( );
+    integrator.modifyCurrentState( modifiedState );
+    Eigen::VectorXd stateAfterModification = integrator.performIntegrationStep( 0.01 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 20 );
+
+    RungeKuttaTableauIntegrator< RungeKutta54DormandPrinceTableau > newIntegrator(
+                stateDerivativeFunction, integrator.getPreviousIndependentVariable( ), modifiedState,
+                1.0E-12, 1.0, 1.0E-10, 1.0E-10 );
+    newIntegrator.setStepSizeControl( false );
+    Eigen::VectorXd newIntegratorState = newIntegrator.performIntegrationStep( 0.01 );
+    for( int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( stateAfterModification( i ), newIntegratorState( i ) );
+    }
+
+    // After rolling back, the first stage is recomputed
+    numberOfEvaluations = 0;
+    integrator.rollbackToPreviousState( );
+    Eigen::VectorXd stateAfterRollback = integrator.performIntegrationStep( 0.01 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 7 );
+    for( int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( stateAfterRollback( i ), newIntegratorState( i ) );
+    }
+}
+
+//! Test that the integrator creation function uses the compile-time tableaux.
+BOOST_AUTO_TEST_CASE( testRungeKuttaTableauIntegratorCreation )
+{
+    const Eigen::VectorXd initialState = ( Eigen::VectorXd( 2 ) << std::exp( 1.0 ), 1.0 ).finished( );
+    std::function< Eigen::VectorXd( const double, const Eigen::VectorXd& ) > stateDerivativeFunction =
+            &computeFehlbergLogirithmicTestODEStateDerivative;
+
+    std::shared_ptr< IntegratorSettings< double > > integratorSettings =
+            std::make_shared< RungeKuttaVariableStepSizeSettingsScalarTolerances< double > >(
+                0.0, 1.0E-3, RungeKuttaCoefficients::rungeKutta54DormandPrince, 1.0E-12, 1.0, 1.0E-10, 1.0E-10 );
+    std::shared_ptr< NumericalIntegrator< double, Eigen::VectorXd, Eigen::VectorXd > > integrator =
+            createIntegrator< double, Eigen::VectorXd >( stateDerivativeFunction, initialState, integratorSettings );
+
+    std::shared_ptr< RungeKuttaTableauIntegrator< RungeKutta54DormandPrinceTableau > > tableauIntegrator =
+            std::dynamic_pointer_cast< RungeKuttaTableauIntegrator< RungeKutta54DormandPrinceTableau > >( integrator );
+    BOOST_CHECK( tableauIntegrator != nullptr );
+    BOOST_CHECK_EQUAL( tableauIntegrator->isFirstSameAsLast( ), true );
+    BOOST_CHECK_EQUAL( integrator->isDenseOutputAvailable( ), true );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -629,6 +629,75 @@ public:
         return lastState_;
     }
 
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator to a binary stream, see
+     * NumericalIntegrator::writeIntegratorState. In addition to the current and previous state, this includes the
+     * current order and step size, the order and step size control settings, and the state and derivative histories.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "AdamsBashforthMoultonIntegrator" );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, lastStepSize_ );
+        serialization::writeBinaryValue( stream, minimumStepSize_ );
+        serialization::writeBinaryValue( stream, maximumStepSize_ );
+        serialization::writeBinaryValue( stream, relativeErrorTolerance_ );
+        serialization::writeBinaryValue( stream, absoluteErrorTolerance_ );
+        serialization::writeBinaryValue( stream, fixedStepSize_ );
+        serialization::writeBinaryValue( stream, strictCompare_ );
+        serialization::writeBinaryValue( stream, fixedOrder_ );
+        serialization::writeBinaryValue( stream, fixedSingleStep_ );
+        serialization::writeBinaryValue( stream, minimumOrder_ );
+        serialization::writeBinaryValue( stream, maximumOrder_ );
+        serialization::writeBinaryValue( stream, order_ );
+        serialization::writeBinaryValue( stream, absoluteError_ );
+        serialization::writeBinaryValue( stream, relativeError_ );
+        serialization::writeBinaryValue( stream, predictedDerivative_ );
+        serialization::writeBinaryValue( stream, lastDerivative_ );
+        serialization::writeBinaryValue( stream, stateHistory_ );
+        serialization::writeBinaryValue( stream, derivHistory_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "AdamsBashforthMoultonIntegrator" );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, lastStepSize_ );
+        serialization::readBinaryValue( stream, minimumStepSize_ );
+        serialization::readBinaryValue( stream, maximumStepSize_ );
+        serialization::readBinaryValue( stream, relativeErrorTolerance_ );
+        serialization::readBinaryValue( stream, absoluteErrorTolerance_ );
+        serialization::readBinaryValue( stream, fixedStepSize_ );
+        serialization::readBinaryValue( stream, strictCompare_ );
+        serialization::readBinaryValue( stream, fixedOrder_ );
+        serialization::readBinaryValue( stream, fixedSingleStep_ );
+        serialization::readBinaryValue( stream, minimumOrder_ );
+        serialization::readBinaryValue( stream, maximumOrder_ );
+        serialization::readBinaryValue( stream, order_ );
+        serialization::readBinaryValue( stream, absoluteError_ );
+        serialization::readBinaryValue( stream, relativeError_ );
+        serialization::readBinaryValue( stream, predictedDerivative_ );
+        serialization::readBinaryValue( stream, lastDerivative_ );
+        serialization::readBinaryValue( stream, stateHistory_ );
+        serialization::readBinaryValue( stream, derivHistory_ );
+    }
+
 protected:
 
 
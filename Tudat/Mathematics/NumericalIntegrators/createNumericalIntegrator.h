@@ -21,7 +21,10 @@
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
 #include "Tudat/Mathematics/NumericalIntegrators/euler.h"
 #include "Tudat/Mathematics/NumericalIntegrators/adamsBashforthMoultonIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/gaussJacksonIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaNystromIntegrator.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaTableauIntegrator.h"
 
 namespace tudat
 {
@@ -36,7 +39,9 @@ enum AvailableIntegrators
     rungeKutta4,
     rungeKuttaVariableStepSize,
     bulirschStoer,
-    adamsBashforthMoulton
+    adamsBashforthMoulton,
+    gaussJackson,
+    rungeKuttaNystromVariableStepSize
 };
 
 //! Class to define settings of numerical integrator
@@ -69,7 +74,8 @@ public:
                         const bool assessPropagationTerminationConditionDuringIntegrationSubsteps = false ) :
         integratorType_( integratorType ), initialTime_( initialTime ),
         initialTimeStep_( initialTimeStep ), saveFrequency_( saveFrequency ),
-        assessPropagationTerminationConditionDuringIntegrationSubsteps_( assessPropagationTerminationConditionDuringIntegrationSubsteps )
+        assessPropagationTerminationConditionDuringIntegrationSubsteps_( assessPropagationTerminationConditionDuringIntegrationSubsteps ),
+        denseOutputSaveInterval_( TUDAT_NAN )
     { }
     
     //! Virtual destructor.
@@ -113,6 +119,16 @@ public:
      */
     bool assessPropagationTerminationConditionDuringIntegrationSubsteps_;
 
+    //! Fixed interval at which to save the numerical integration result, using the dense output of the integrator.
+    /*!
+     * Fixed interval at which to save the numerical integration result (at the initial time plus integer multiples of
+     * this interval), instead of saving the result at the end of (each saveFrequency-th) integration step. The states
+     * at these epochs are interpolated within the integration steps by the dense output of the integrator, without
+     * additional state derivative evaluations. Only supported by integrators that provide dense output (variable step
+     * size Runge-Kutta integrators with the RKF78 or RKDP87 coefficient sets). NaN (default) if not used.
+     */
+    double denseOutputSaveInterval_;
+
 };
 
 //! Base class to define settings of variable step RK numerical integrator.
@@ -552,6 +568,268 @@ public:
 
 };
 
+//! Class to define settings of the fixed step size Gauss-Jackson numerical integrator.
+/*!
+ *  Class to define settings of the fixed step size 8th-order Gauss-Jackson numerical integrator, for the integration
+ *  of translational (Cowell) equations of motion/variational equations (see GaussJacksonIntegrator).
+ */
+template< typename IndependentVariableType = double >
+class GaussJacksonSettings: public IntegratorSettings< IndependentVariableType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor for fixed step size Gauss-Jackson integrator settings.
+     *  \param initialTime Start time (independent variable) of numerical integration.
+     *  \param stepSize Step size used in numerical integration.
+     *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration
+     *      time steps, with n = saveFrequency).
+     *  \param assessPropagationTerminationConditionDuringIntegrationSubsteps Whether the propagation termination
+     *      conditions should be evaluated during the intermediate sub-steps of the integrator (`true`) or only at the end of
+     *      each integration step (`false`).
+     *  \param correctorConvergenceTolerance Relative tolerance on the change in state between two corrector iterations.
+     *  \param maximumNumberOfCorrectorIterations Maximum number of corrector iterations (state derivative evaluations) per
+     *      step (default 1, i.e. a single evaluation per step).
+     */
+    GaussJacksonSettings(
+            const IndependentVariableType initialTime,
+            const IndependentVariableType stepSize,
+            const int saveFrequency = 1,
+            const bool assessPropagationTerminationConditionDuringIntegrationSubsteps = false,
+            const double correctorConvergenceTolerance = 1.0E-13,
+            const unsigned int maximumNumberOfCorrectorIterations = 1 ):
+        IntegratorSettings< IndependentVariableType >(
+            gaussJackson, initialTime, stepSize, saveFrequency,
+            assessPropagationTerminationConditionDuringIntegrationSubsteps ),
+        correctorConvergenceTolerance_( correctorConvergenceTolerance ),
+        maximumNumberOfCorrectorIterations_( maximumNumberOfCorrectorIterations ) { }
+
+    //! Destructor
+    /*!
+     *  Destructor
+     */
+    virtual ~GaussJacksonSettings( ){ }
+
+    //! Relative tolerance on the change in state between two corrector iterations.
+    double correctorConvergenceTolerance_;
+
+    //! Maximum number of corrector iterations (state derivative evaluations) per step.
+    unsigned int maximumNumberOfCorrectorIterations_;
+
+};
+
+//! Class to define settings of the variable step size Gauss-Jackson numerical integrator.
+/*!
+ *  Class to define settings of the variable step size 8th-order Gauss-Jackson numerical integrator, for which the step
+ *  size is halved and doubled based on the estimated local error (see GaussJacksonIntegrator).
+ */
+template< typename IndependentVariableType = double >
+class GaussJacksonVariableStepSizeSettings: public GaussJacksonSettings< IndependentVariableType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor for variable step size Gauss-Jackson integrator settings.
+     *  \param initialTime Start time (independent variable) of numerical integration.
+     *  \param initialTimeStep Initial time (independent variable) step used in numerical integration. Adapted during integration.
+     *  \param minimumStepSize Minimum step size for integration. Integration stops (exception thrown) if time step
+     *      comes below this value.
+     *  \param maximumStepSize Maximum step size for integration.
+     *  \param relativeErrorTolerance Relative error tolerance for step size control (w.r.t. the norm of each position).
+     *  \param absoluteErrorTolerance Absolute error tolerance for step size control (on the norm of each position error).
+     *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration
+     *      time steps, with n = saveFrequency).
+     *  \param assessPropagationTerminationConditionDuringIntegrationSubsteps Whether the propagation termination
+     *      conditions should be evaluated during the intermediate sub-steps of the integrator (`true`) or only at the end of
+     *      each integration step (`false`).
+     *  \param bandwidth Maximum error factor for doubling the stepsize (default: 1024).
+     *  \param correctorConvergenceTolerance Relative tolerance on the change in state between two corrector iterations.
+     *  \param maximumNumberOfCorrectorIterations Maximum number of corrector iterations (state derivative evaluations) per
+     *      step (default 1, i.e. a single evaluation per step).
+     */
+    GaussJacksonVariableStepSizeSettings(
+            const IndependentVariableType initialTime,
+            const IndependentVariableType initialTimeStep,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const double relativeErrorTolerance = 1.0E-12,
+            const double absoluteErrorTolerance = 1.0E-12,
+            const int saveFrequency = 1,
+            const bool assessPropagationTerminationConditionDuringIntegrationSubsteps = false,
+            const IndependentVariableType bandwidth = 1024.0,
+            const double correctorConvergenceTolerance = 1.0E-13,
+            const unsigned int maximumNumberOfCorrectorIterations = 1 ):
+        GaussJacksonSettings< IndependentVariableType >(
+            initialTime, initialTimeStep, saveFrequency, assessPropagationTerminationConditionDuringIntegrationSubsteps,
+            correctorConvergenceTolerance, maximumNumberOfCorrectorIterations ),
+        minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        bandwidth_( bandwidth ) { }
+
+    //! Destructor
+    /*!
+     *  Destructor
+     */
+    ~GaussJacksonVariableStepSizeSettings( ){ }
+
+    //! Minimum step size for integration.
+    /*!
+     *  Minimum step size for integration. Integration stops (exception thrown) if time step comes below this value.
+     */
+    IndependentVariableType minimumStepSize_;
+
+    //! Maximum step size for integration.
+    IndependentVariableType maximumStepSize_;
+
+    //! Relative error tolerance for step size control
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance for step size control
+    double absoluteErrorTolerance_;
+
+    //! Maximum error factor for doubling the stepsize
+    IndependentVariableType bandwidth_;
+
+};
+
+//! Class to define settings of the variable step size Runge-Kutta-Nystrom numerical integrator.
+/*!
+ *  Class to define settings of the variable step size embedded Runge-Kutta-Nystrom numerical integrator, for the
+ *  integration of translational (Cowell) equations of motion/variational equations (see RungeKuttaNystromIntegrator).
+ */
+template< typename IndependentVariableType = double >
+class RungeKuttaNystromVariableStepSizeSettings: public IntegratorSettings< IndependentVariableType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor for variable step size Runge-Kutta-Nystrom integrator settings.
+     *  \param initialTime Start time (independent variable) of numerical integration.
+     *  \param initialTimeStep Initial time (independent variable) step used in numerical integration. Adapted during integration.
+     *  \param coefficientSet Coefficient set to use in integration.
+     *  \param minimumStepSize Minimum step size for integration. Integration stops (exception thrown) if time step
+     *      comes below this value.
+     *  \param maximumStepSize Maximum step size for integration.
+     *  \param relativeErrorTolerance Relative error tolerance for step size control, for each position and velocity element.
+     *  \param absoluteErrorTolerance Absolute error tolerance for step size control, for each position and velocity element.
+     *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration
+     *      time steps, with n = saveFrequency).
+     *  \param assessPropagationTerminationConditionDuringIntegrationSubsteps Whether the propagation termination
+     *      conditions should be evaluated during the intermediate sub-steps of the integrator (`true`) or only at the end of
+     *      each integration step (`false`).
+     *  \param safetyFactorForNextStepSize Safety factor for step size control.
+     *  \param maximumFactorIncreaseForNextStepSize Maximum increase factor in time step in subsequent iterations.
+     *  \param minimumFactorDecreaseForNextStepSize Minimum decrease factor in time step in subsequent iterations.
+     *  \param areAccelerationsVelocityIndependent Boolean denoting whether the accelerations are independent of the
+     *      velocity, in which case the acceleration of the last stage of a step may be re-used as the first stage of the
+     *      next step.
+     */
+    RungeKuttaNystromVariableStepSizeSettings(
+            const IndependentVariableType initialTime,
+            const IndependentVariableType initialTimeStep,
+            const RungeKuttaNystromCoefficients::CoefficientSets coefficientSet,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const double relativeErrorTolerance = 1.0E-12,
+            const double absoluteErrorTolerance = 1.0E-12,
+            const int saveFrequency = 1,
+            const bool assessPropagationTerminationConditionDuringIntegrationSubsteps = false,
+            const IndependentVariableType safetyFactorForNextStepSize = 0.8,
+            const IndependentVariableType maximumFactorIncreaseForNextStepSize = 4.0,
+            const IndependentVariableType minimumFactorDecreaseForNextStepSize = 0.1,
+            const bool areAccelerationsVelocityIndependent = false ):
+        IntegratorSettings< IndependentVariableType >(
+            rungeKuttaNystromVariableStepSize, initialTime, initialTimeStep, saveFrequency,
+            assessPropagationTerminationConditionDuringIntegrationSubsteps ),
+        coefficientSet_( coefficientSet ),
+        minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        safetyFactorForNextStepSize_( safetyFactorForNextStepSize ),
+        maximumFactorIncreaseForNextStepSize_( maximumFactorIncreaseForNextStepSize ),
+        minimumFactorDecreaseForNextStepSize_( minimumFactorDecreaseForNextStepSize ),
+        areAccelerationsVelocityIndependent_( areAccelerationsVelocityIndependent ) { }
+
+    //! Destructor
+    /*!
+     *  Destructor
+     */
+    ~RungeKuttaNystromVariableStepSizeSettings( ){ }
+
+    //! Coefficient set to use in integration.
+    RungeKuttaNystromCoefficients::CoefficientSets coefficientSet_;
+
+    //! Minimum step size for integration.
+    /*!
+     *  Minimum step size for integration. Integration stops (exception thrown) if time step comes below this value.
+     */
+    IndependentVariableType minimumStepSize_;
+
+    //! Maximum step size for integration.
+    IndependentVariableType maximumStepSize_;
+
+    //! Relative error tolerance for step size control
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance for step size control
+    double absoluteErrorTolerance_;
+
+    //! Safety factor for step size control
+    IndependentVariableType safetyFactorForNextStepSize_;
+
+    //! Maximum increase factor in time step in subsequent iterations.
+    IndependentVariableType maximumFactorIncreaseForNextStepSize_;
+
+    //! Minimum decrease factor in time step in subsequent iterations.
+    IndependentVariableType minimumFactorDecreaseForNextStepSize_;
+
+    //! Boolean denoting whether the accelerations are independent of the velocity.
+    bool areAccelerationsVelocityIndependent_;
+
+};
+
+//! Function to create a variable step-size Runge-Kutta integrator for a given coefficient set.
+/*!
+ *  Function to create a variable step-size Runge-Kutta integrator for a given coefficient set. For the coefficient sets
+ *  that are defined by a compile-time Butcher tableau, a RungeKuttaTableauIntegrator is created, otherwise a
+ *  RungeKuttaVariableStepSizeIntegrator.
+ *  \param coefficientSet Coefficient set of the integrator.
+ *  \param integratorArguments Input to the integrator constructor, after the coefficient set (see
+ *  RungeKuttaVariableStepSizeIntegrator constructors).
+ *  \return Numerical integrator object.
+ */
+template< typename IndependentVariableType, typename StateType, typename TimeStepType, typename... ArgumentTypes >
+std::shared_ptr< numerical_integrators::NumericalIntegrator< IndependentVariableType, StateType, StateType, TimeStepType > >
+createRungeKuttaVariableStepSizeIntegrator(
+        const RungeKuttaCoefficients::CoefficientSets coefficientSet,
+        const ArgumentTypes&... integratorArguments )
+{
+    switch( coefficientSet )
+    {
+    case RungeKuttaCoefficients::rungeKuttaFehlberg45:
+        return std::make_shared< RungeKuttaTableauIntegrator< RungeKuttaFehlberg45Tableau,
+                IndependentVariableType, StateType, StateType, TimeStepType > >( integratorArguments... );
+    case RungeKuttaCoefficients::rungeKuttaFehlberg56:
+        return std::make_shared< RungeKuttaTableauIntegrator< RungeKuttaFehlberg56Tableau,
+                IndependentVariableType, StateType, StateType, TimeStepType > >( integratorArguments... );
+    case RungeKuttaCoefficients::rungeKuttaFehlberg78:
+        return std::make_shared< RungeKuttaTableauIntegrator< RungeKuttaFehlberg78Tableau,
+                IndependentVariableType, StateType, StateType, TimeStepType > >( integratorArguments... );
+    case RungeKuttaCoefficients::rungeKutta87DormandPrince:
+        return std::make_shared< RungeKuttaTableauIntegrator< RungeKutta87DormandPrinceTableau,
+                IndependentVariableType, StateType, StateType, TimeStepType > >( integratorArguments... );
+    case RungeKuttaCoefficients::rungeKutta54DormandPrince:
+        return std::make_shared< RungeKuttaTableauIntegrator< RungeKutta54DormandPrinceTableau,
+                IndependentVariableType, StateType, StateType, TimeStepType > >( integratorArguments... );
+    default:
+        return std::make_shared< RungeKuttaVariableStepSizeIntegrator<
+                IndependentVariableType, StateType, StateType, TimeStepType > >(
+                    RungeKuttaCoefficients::get( coefficientSet ), integratorArguments... );
+    }
+}
+
 //! Function to create a numerical integrator.
 /*!
  *  Function to create a numerical integrator from given integrator settings, state derivative function and initial state.
@@ -607,9 +885,6 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
                                       "RungeKuttaVariableStepSizeBaseSettings for this type)." );
         }
 
-        // Get requested RK coefficients
-        RungeKuttaCoefficients coefficients = RungeKuttaCoefficients::get( variableStepIntegratorSettings->coefficientSet_ );
-
         // Check which constructor is being used
         if ( variableStepIntegratorSettings->areTolerancesDefinedAsScalar_ )
         {
@@ -626,16 +901,17 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
             }
 
             // Create Runge-Kutta integrator with scalar tolerances
-            integrator = std::make_shared< RungeKuttaVariableStepSizeIntegrator
-                    < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
-                    ( coefficients, stateDerivativeFunction, integratorSettings->initialTime_, initialState,
-                      static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->minimumStepSize_ ),
-                      static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->maximumStepSize_ ),
-                      static_cast< typename DependentVariableType::Scalar >( scalarTolerancesIntegratorSettings->relativeErrorTolerance_ ),
-                      static_cast< typename DependentVariableType::Scalar >( scalarTolerancesIntegratorSettings->absoluteErrorTolerance_ ),
-                      static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->safetyFactorForNextStepSize_ ),
-                      static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->maximumFactorIncreaseForNextStepSize_ ),
-                      static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->minimumFactorDecreaseForNextStepSize_ ) );
+            integrator = createRungeKuttaVariableStepSizeIntegrator<
+                    IndependentVariableType, DependentVariableType, IndependentVariableStepType >(
+                        variableStepIntegratorSettings->coefficientSet_,
+                        stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                        static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->minimumStepSize_ ),
+                        static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->maximumStepSize_ ),
+                        static_cast< typename DependentVariableType::Scalar >( scalarTolerancesIntegratorSettings->relativeErrorTolerance_ ),
+                        static_cast< typename DependentVariableType::Scalar >( scalarTolerancesIntegratorSettings->absoluteErrorTolerance_ ),
+                        static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->safetyFactorForNextStepSize_ ),
+                        static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->maximumFactorIncreaseForNextStepSize_ ),
+                        static_cast< IndependentVariableStepType >( scalarTolerancesIntegratorSettings->minimumFactorDecreaseForNextStepSize_ ) );
         }
         else
         {
@@ -669,15 +945,16 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
             }
 
             // Create Runge-Kutta integrator with vector tolerances
-            integrator = std::make_shared< RungeKuttaVariableStepSizeIntegrator
-                    < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
-                    ( coefficients, stateDerivativeFunction, integratorSettings->initialTime_, initialState,
-                      static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->minimumStepSize_ ),
-                      static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->maximumStepSize_ ),
-                      relativeErrorTolerance, absoluteErrorTolerance,
-                      static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->safetyFactorForNextStepSize_ ),
-                      static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->maximumFactorIncreaseForNextStepSize_ ),
-                      static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->minimumFactorDecreaseForNextStepSize_ ) );
+            integrator = createRungeKuttaVariableStepSizeIntegrator<
+                    IndependentVariableType, DependentVariableType, IndependentVariableStepType >(
+                        variableStepIntegratorSettings->coefficientSet_,
+                        stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                        static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->minimumStepSize_ ),
+                        static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->maximumStepSize_ ),
+                        relativeErrorTolerance, absoluteErrorTolerance,
+                        static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->safetyFactorForNextStepSize_ ),
+                        static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->maximumFactorIncreaseForNextStepSize_ ),
+                        static_cast< IndependentVariableStepType >( vectorTolerancesIntegratorSettings->minimumFactorDecreaseForNextStepSize_ ) );
         }
         break;
     }
@@ -762,6 +1039,77 @@ DependentVariableType, IndependentVariableStepType > > createIntegrator(
         }
         break;
     }
+    case gaussJackson:
+    {
+        // Check input consistency
+        std::shared_ptr< GaussJacksonSettings< IndependentVariableType > > gaussJacksonSettings =
+                std::dynamic_pointer_cast< GaussJacksonSettings< IndependentVariableType > >( integratorSettings );
+        if ( gaussJacksonSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, type of integrator settings (gaussJackson) not compatible with "
+                                      "selected integrator (derived class of IntegratorSettings must be GaussJacksonSettings "
+                                      "for this type)." );
+        }
+
+        // Create variable or fixed step size integrator
+        std::shared_ptr< GaussJacksonVariableStepSizeSettings< IndependentVariableType > > variableStepSizeSettings =
+                std::dynamic_pointer_cast< GaussJacksonVariableStepSizeSettings< IndependentVariableType > >(
+                    integratorSettings );
+        if ( variableStepSizeSettings != nullptr )
+        {
+            integrator = std::make_shared< GaussJacksonIntegrator
+                    < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
+                    ( stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                      static_cast< IndependentVariableStepType >( variableStepSizeSettings->minimumStepSize_ ),
+                      static_cast< IndependentVariableStepType >( variableStepSizeSettings->maximumStepSize_ ),
+                      static_cast< typename DependentVariableType::Scalar >( variableStepSizeSettings->relativeErrorTolerance_ ),
+                      static_cast< typename DependentVariableType::Scalar >( variableStepSizeSettings->absoluteErrorTolerance_ ),
+                      static_cast< IndependentVariableStepType >( variableStepSizeSettings->bandwidth_ ),
+                      static_cast< typename DependentVariableType::Scalar >(
+                          gaussJacksonSettings->correctorConvergenceTolerance_ ),
+                      gaussJacksonSettings->maximumNumberOfCorrectorIterations_ );
+        }
+        else
+        {
+            integrator = std::make_shared< GaussJacksonIntegrator
+                    < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
+                    ( stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                      static_cast< typename DependentVariableType::Scalar >(
+                          gaussJacksonSettings->correctorConvergenceTolerance_ ),
+                      gaussJacksonSettings->maximumNumberOfCorrectorIterations_ );
+        }
+        break;
+    }
+    case rungeKuttaNystromVariableStepSize:
+    {
+        // Check input consistency
+        std::shared_ptr< RungeKuttaNystromVariableStepSizeSettings< IndependentVariableType > > rungeKuttaNystromSettings =
+                std::dynamic_pointer_cast< RungeKuttaNystromVariableStepSizeSettings< IndependentVariableType > >(
+                    integratorSettings );
+        if ( rungeKuttaNystromSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, type of integrator settings (rungeKuttaNystromVariableStepSize) not compatible "
+                                      "with selected integrator (derived class of IntegratorSettings must be "
+                                      "RungeKuttaNystromVariableStepSizeSettings for this type)." );
+        }
+
+        // Create Runge-Kutta-Nystrom integrator
+        integrator = std::make_shared< RungeKuttaNystromIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, IndependentVariableStepType > >
+                ( RungeKuttaNystromCoefficients::get( rungeKuttaNystromSettings->coefficientSet_ ),
+                  stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                  static_cast< IndependentVariableStepType >( rungeKuttaNystromSettings->minimumStepSize_ ),
+                  static_cast< IndependentVariableStepType >( rungeKuttaNystromSettings->maximumStepSize_ ),
+                  static_cast< typename DependentVariableType::Scalar >( rungeKuttaNystromSettings->relativeErrorTolerance_ ),
+                  static_cast< typename DependentVariableType::Scalar >( rungeKuttaNystromSettings->absoluteErrorTolerance_ ),
+                  static_cast< IndependentVariableStepType >( rungeKuttaNystromSettings->safetyFactorForNextStepSize_ ),
+                  static_cast< IndependentVariableStepType >(
+                      rungeKuttaNystromSettings->maximumFactorIncreaseForNextStepSize_ ),
+                  static_cast< IndependentVariableStepType >(
+                      rungeKuttaNystromSettings->minimumFactorDecreaseForNextStepSize_ ),
+                  rungeKuttaNystromSettings->areAccelerationsVelocityIndependent_ );
+        break;
+    }
     default:
         throw std::runtime_error( "Error, integrator " +  std::to_string( integratorSettings->integratorType_ ) + " not found." );
     }
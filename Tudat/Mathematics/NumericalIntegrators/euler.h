@@ -201,6 +201,38 @@ public:
         }
     }
 
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator (current and previous state and independent variable, and
+     * step size) to a binary stream, see NumericalIntegrator::writeIntegratorState.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "EulerIntegrator" );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "EulerIntegrator" );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+    }
+
 protected:
 
     //! Last used step size.
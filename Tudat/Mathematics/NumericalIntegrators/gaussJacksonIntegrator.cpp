@@ -0,0 +1,153 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include "Tudat/Mathematics/NumericalIntegrators/gaussJacksonIntegrator.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Function to evaluate a derivative of a polynomial.
+long double evaluatePolynomialDerivative( const Eigen::Matrix< long double, 1, Eigen::Dynamic >& polynomialCoefficients,
+                                          const int derivativeOrder, const long double independentVariable )
+{
+    long double value = 0.0L;
+    for( int power = polynomialCoefficients.cols( ) - 1; power >= derivativeOrder; power-- )
+    {
+        long double factor = 1.0L;
+        for( int i = 0; i < derivativeOrder; i++ )
+        {
+            factor *= static_cast< long double >( power - i );
+        }
+        value = value * independentVariable + factor * polynomialCoefficients( power );
+    }
+    return value;
+}
+
+//! Constructor, computes the coefficients.
+GaussJacksonCoefficients::GaussJacksonCoefficients( )
+{
+    // Compute (monomial) coefficients of the Lagrange basis polynomials of the back-points, located at x = m - 8
+    Eigen::Matrix< long double, numberOfBackPoints, numberOfBackPoints > basisPolynomials =
+            Eigen::Matrix< long double, numberOfBackPoints, numberOfBackPoints >::Zero( );
+    for( int m = 0; m < numberOfBackPoints; m++ )
+    {
+        basisPolynomials( m, 0 ) = 1.0L;
+        long double denominator = 1.0L;
+        for( int i = 0; i < numberOfBackPoints; i++ )
+        {
+            if( i != m )
+            {
+                // Multiply by ( x - x_{i} )
+                const long double node = static_cast< long double >( i - numberOfBackPoints + 1 );
+                for( int power = numberOfBackPoints - 1; power > 0; power-- )
+                {
+                    basisPolynomials( m, power ) = basisPolynomials( m, power - 1 ) - node * basisPolynomials( m, power );
+                }
+                basisPolynomials( m, 0 ) *= -node;
+                denominator *= static_cast< long double >( m - i );
+            }
+        }
+        basisPolynomials.row( m ) /= denominator;
+    }
+
+    // Series expansions (in terms of the derivative operator D, in units of steps) of the difference between the first
+    // sum and the first integral (-D/12 + D^3/720 - D^5/30240 + D^7/1209600), and between the second sum and the
+    // second integral (1/12 - D^2/240 + D^4/6048 - D^6/172800 + D^8/5322240), truncated where they are exact for
+    // polynomials of degree 8.
+    const std::vector< long double > firstSumSeries =
+    { 0.0L, -1.0L / 12.0L, 0.0L, 1.0L / 720.0L, 0.0L, -1.0L / 30240.0L, 0.0L, 1.0L / 1209600.0L };
+    const std::vector< long double > secondSumSeries =
+    { 1.0L / 12.0L, 0.0L, -1.0L / 240.0L, 0.0L, 1.0L / 6048.0L, 0.0L, -1.0L / 172800.0L, 0.0L, 1.0L / 5322240.0L };
+
+    for( int row = 0; row < numberOfBackPoints + 1; row++ )
+    {
+        const long double evaluationPoint = static_cast< long double >( row - numberOfBackPoints + 1 );
+        for( int m = 0; m < numberOfBackPoints; m++ )
+        {
+            const Eigen::Matrix< long double, 1, Eigen::Dynamic > basisPolynomial = basisPolynomials.row( m );
+
+            velocityCoefficients( row, m ) = 0.0L;
+            for( unsigned int order = 0; order < firstSumSeries.size( ); order++ )
+            {
+                velocityCoefficients( row, m ) += firstSumSeries.at( order ) * evaluatePolynomialDerivative(
+                            basisPolynomial, order, evaluationPoint );
+            }
+
+            positionCoefficients( row, m ) = 0.0L;
+            for( unsigned int order = 0; order < secondSumSeries.size( ); order++ )
+            {
+                positionCoefficients( row, m ) += secondSumSeries.at( order ) * evaluatePolynomialDerivative(
+                            basisPolynomial, order, evaluationPoint );
+            }
+        }
+    }
+
+    // Include extrapolated contribution of new acceleration to first sum in predictor
+    velocityCoefficients.row( numberOfBackPoints ) += 0.5L * computeGaussJacksonInterpolationWeights(
+                static_cast< long double >( numberOfBackPoints ) );
+
+    // Compute error factor (Milne's device) from the local errors of the predictor and corrector for a(x) = x^9, for
+    // which the exact position (in units of steps) is x^11 / 110.
+    Eigen::Matrix< long double, numberOfBackPoints, 1 > predictorAccelerations, correctorAccelerations;
+    for( int m = 0; m < numberOfBackPoints; m++ )
+    {
+        predictorAccelerations( m ) = std::pow( static_cast< long double >( m - numberOfBackPoints + 1 ), 9 );
+        correctorAccelerations( m ) = std::pow( static_cast< long double >( m - numberOfBackPoints + 2 ), 9 );
+    }
+    const long double firstSum = -velocityCoefficients.row( numberOfBackPoints - 1 ).dot( predictorAccelerations );
+    const long double secondSum = -positionCoefficients.row( numberOfBackPoints - 1 ).dot( predictorAccelerations );
+    const long double nextSecondSum = secondSum + firstSum;
+
+    const long double predictorPositionError = 1.0L / 110.0L - (
+                nextSecondSum + positionCoefficients.row( numberOfBackPoints ).dot( predictorAccelerations ) );
+    const long double correctorPositionError = 1.0L / 110.0L - (
+                nextSecondSum + positionCoefficients.row( numberOfBackPoints - 1 ).dot( correctorAccelerations ) );
+
+    positionErrorFactor = std::fabs( correctorPositionError / ( predictorPositionError - correctorPositionError ) );
+}
+
+//! Get coefficients of the 8th-order Gauss-Jackson integrator.
+const GaussJacksonCoefficients& GaussJacksonCoefficients::get( )
+{
+    static const GaussJacksonCoefficients coefficients;
+    return coefficients;
+}
+
+//! Function to compute the Lagrange interpolation weights of the Gauss-Jackson back-points.
+Eigen::Matrix< long double, 1, GaussJacksonCoefficients::numberOfBackPoints > computeGaussJacksonInterpolationWeights(
+        const long double nodeCoordinate )
+{
+    Eigen::Matrix< long double, 1, GaussJacksonCoefficients::numberOfBackPoints > weights;
+    for( int m = 0; m < GaussJacksonCoefficients::numberOfBackPoints; m++ )
+    {
+        weights( m ) = 1.0L;
+        for( int i = 0; i < GaussJacksonCoefficients::numberOfBackPoints; i++ )
+        {
+            if( i != m )
+            {
+                weights( m ) *= ( nodeCoordinate - static_cast< long double >( i ) ) /
+                        static_cast< long double >( m - i );
+            }
+        }
+    }
+    return weights;
+}
+
+template class GaussJacksonIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
+template class GaussJacksonIntegrator < double, Eigen::Vector6d, Eigen::Vector6d >;
+template class GaussJacksonIntegrator < double, Eigen::MatrixXd, Eigen::MatrixXd >;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
@@ -0,0 +1,1086 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Berry, M.M. and Healy, L.M., Implementation of Gauss-Jackson Integration for Orbit Propagation,
+ *          The Journal of the Astronautical Sciences, 52(3), 2004.
+ *      Montenbruck, O. and Gill, E., Satellite Orbits, Springer, 2000.
+ *
+ */
+
+#ifndef TUDAT_GAUSS_JACKSON_INTEGRATOR_H
+#define TUDAT_GAUSS_JACKSON_INTEGRATOR_H
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Class that contains the coefficients of the 8th-order Gauss-Jackson integrator, in ordinate form.
+/*!
+ * Class that contains the coefficients of the 8th-order Gauss-Jackson (position) and summed Adams (velocity) formulas,
+ * in ordinate form. With h the step size, a_{m} the accelerations at the nine back-points (m = 0, ..., 8, where m = 8
+ * is the most recent point), and s and S the first and second sum of the accelerations at a given point, the velocity
+ * and position at the point x (in units of steps w.r.t. the most recent back-point) are
+ * v = h ( s + sum_{m} velocityCoefficients( x + 8, m ) a_{m} ) and
+ * r = h^2 ( S + sum_{m} positionCoefficients( x + 8, m ) a_{m} ). The sums are updated from one point to the next as
+ * s_{n+1} = s_{n} + ( a_{n} + a_{n+1} ) / 2 and S_{n+1} = S_{n} + s_{n} + a_{n} / 2. Rows 0 to 8 are used for the
+ * points of the back-point window itself (start-up and corrector), row 9 for the point one step beyond the most
+ * recent back-point (predictor). For the predictor velocity, the (extrapolated) contribution of the unknown new
+ * acceleration to the first sum is included in the coefficients, so that v = h ( s_{n} + a_{n} / 2 + sum_{m} ... ).
+ * The coefficients are computed from the series expansions of the summation operators in terms of derivatives of the
+ * acceleration (Euler-Maclaurin), applied to the Lagrange interpolating polynomial through the back-points.
+ */
+class GaussJacksonCoefficients
+{
+public:
+
+    //! Number of back-points (accelerations) used by the 8th-order Gauss-Jackson integrator.
+    static const int numberOfBackPoints = 9;
+
+    //! Get coefficients of the 8th-order Gauss-Jackson integrator.
+    /*!
+     * Returns the coefficients of the 8th-order Gauss-Jackson integrator, which are computed once (on first call).
+     * \return Coefficients of the 8th-order Gauss-Jackson integrator.
+     */
+    static const GaussJacksonCoefficients& get( );
+
+    //! Coefficients of the (second-sum) Gauss-Jackson formula for the position.
+    Eigen::Matrix< long double, numberOfBackPoints + 1, numberOfBackPoints > positionCoefficients;
+
+    //! Coefficients of the (first-sum) summed Adams formula for the velocity.
+    Eigen::Matrix< long double, numberOfBackPoints + 1, numberOfBackPoints > velocityCoefficients;
+
+    //! Factor with which the difference between corrected and predicted position is multiplied to estimate the error.
+    long double positionErrorFactor;
+
+private:
+
+    //! Constructor, computes the coefficients.
+    GaussJacksonCoefficients( );
+};
+
+//! Function to compute the Lagrange interpolation weights of the Gauss-Jackson back-points.
+/*!
+ * Function to compute the weights with which the values at the nine equidistant nodes 0, 1, ..., 8 are to be
+ * multiplied to obtain the value of the interpolating polynomial at a given point.
+ * \param nodeCoordinate Point at which the interpolating polynomial is to be evaluated, in units of the node spacing.
+ * \return Interpolation weights of the nine nodes.
+ */
+Eigen::Matrix< long double, 1, GaussJacksonCoefficients::numberOfBackPoints > computeGaussJacksonInterpolationWeights(
+        const long double nodeCoordinate );
+
+//! Gauss-Jackson (summed Stormer-Cowell) integrator, 8th order, with fixed or variable step size.
+/*!
+ * Class that implements the 8th-order Gauss-Jackson integrator, a multistep method that integrates the second-order
+ * (translational) equations of motion directly, using only the accelerations. The state must be in the Cartesian
+ * (Cowell) layout: it consists of blocks of six rows, in which the first three rows are the position(-like) rows and
+ * the last three the velocity(-like) rows, of which the derivatives are the velocity rows and acceleration rows,
+ * respectively (e.g. the Cartesian states of one or more bodies, or the associated state transition matrix). Only the
+ * acceleration rows of the state derivative are used. The integrator is started with a fixed-step Runge-Kutta-Fehlberg
+ * 7(8) integrator, after which the start-up states are iterated with the Gauss-Jackson formulas until convergence.
+ * Each subsequent step consists of a predictor, an evaluation of the state derivative at the predicted state and a
+ * corrector. By default, this is done once per step (PEC mode), so that only a single state derivative evaluation per
+ * step is required. Optionally, the evaluation and correction are iterated until the change in state is below a given
+ * tolerance. If error tolerances are provided, the step size is controlled by halving and doubling the step size based
+ * on the difference between the predicted and corrected positions. A change in step size (also when requested
+ * explicitly, e.g. to reach a given final time) is performed by interpolation of the acceleration back-points, without
+ * restarting the integrator, as long as sufficient back-points are available.
+ * \tparam IndependentVariableType The type of the independent variable.
+ * \tparam StateType The type of the state.
+ * \tparam StateDerivativeType The type of the state derivative.
+ * \tparam TimeStepType The type of the time step.
+ * \sa NumericalIntegrator.
+ */
+template< typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename StateDerivativeType = Eigen::VectorXd, typename TimeStepType = IndependentVariableType >
+class GaussJacksonIntegrator
+        : public ReinitializableNumericalIntegrator<
+        IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+{
+public:
+
+    //! Typedef for the base class.
+    /*!
+     * Typedef of the base class with all template parameters filled in.
+     */
+    typedef ReinitializableNumericalIntegrator< IndependentVariableType, StateType,
+    StateDerivativeType, TimeStepType > ReinitializableNumericalIntegratorBase;
+
+    //! Typedef for the state derivative function.
+    /*!
+     * Typedef to the state derivative function inherited from the base class.
+     * \sa NumericalIntegrator::StateDerivativeFunction.
+     */
+    typedef typename ReinitializableNumericalIntegratorBase::NumericalIntegratorBase::
+    StateDerivativeFunction StateDerivativeFunction;
+
+    //! Typedef for the scalar type of the state.
+    typedef typename StateType::Scalar StateScalarType;
+
+    //! Typedef for the position, velocity and acceleration rows of the state (or state derivative).
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > SecondOrderStateType;
+
+    //! Constructor for the fixed step size integrator.
+    /*!
+     * Constructor for the fixed step size integrator. The step size is set by the step size that is passed to
+     * performIntegrationStep (a change in step size between subsequent steps is supported).
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state (number of rows must be a multiple of six).
+     * \param correctorConvergenceTolerance Relative tolerance on the change in position and velocity between two
+     *          corrector iterations, below which the corrector is considered to have converged (only used if more
+     *          than one corrector iteration is allowed, and for the start-up iterations).
+     * \param maximumNumberOfCorrectorIterations Maximum number of corrector iterations (state derivative evaluations)
+     *          per step.
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    GaussJacksonIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const StateScalarType correctorConvergenceTolerance = 1.0E-13,
+            const unsigned int maximumNumberOfCorrectorIterations = 1 ) :
+        ReinitializableNumericalIntegratorBase( stateDerivativeFunction ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
+        stepSize_( TUDAT_NAN ),
+        nextStepSize_( TUDAT_NAN ),
+        useStepSizeControl_( false ),
+        minimumStepSize_( 0.0 ),
+        maximumStepSize_( std::numeric_limits< TimeStepType >::infinity( ) ),
+        relativeErrorTolerance_( 0.0 ),
+        absoluteErrorTolerance_( 0.0 ),
+        bandwidth_( 1024.0 ),
+        correctorConvergenceTolerance_( correctorConvergenceTolerance ),
+        maximumNumberOfCorrectorIterations_( std::max( maximumNumberOfCorrectorIterations, 1u ) )
+    {
+        initialize( );
+    }
+
+    //! Constructor for the variable step size integrator.
+    /*!
+     * Constructor for the variable step size integrator, where the step size is halved (and the step is repeated) if
+     * the estimated error exceeds the tolerances, and doubled if the estimated error is below the tolerances divided
+     * by the bandwidth (and sufficient back-points are available).
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state (number of rows must be a multiple of six).
+     * \param minimumStepSize The minimum step size to take. If the step size needs to be reduced below this value to
+     *          meet the tolerances, an exception is thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, w.r.t. the norm of the position of each body (or of
+     *          each column of the position rows of each block, for a matrix state).
+     * \param absoluteErrorTolerance The absolute error tolerance on the norm of the position error of each body.
+     * \param bandwidth Factor between the tolerance and the error below which the step size is doubled. Since the
+     *          local error of the 8th-order method scales with the step size to the 10th power, values below 2^10
+     *          result in the step size being alternately doubled and halved.
+     * \param correctorConvergenceTolerance Relative tolerance on the change in position and velocity between two
+     *          corrector iterations, below which the corrector is considered to have converged (only used if more
+     *          than one corrector iteration is allowed, and for the start-up iterations).
+     * \param maximumNumberOfCorrectorIterations Maximum number of corrector iterations (state derivative evaluations)
+     *          per step.
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    GaussJacksonIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const TimeStepType minimumStepSize,
+            const TimeStepType maximumStepSize,
+            const StateScalarType relativeErrorTolerance,
+            const StateScalarType absoluteErrorTolerance,
+            const TimeStepType bandwidth = 1024.0,
+            const StateScalarType correctorConvergenceTolerance = 1.0E-13,
+            const unsigned int maximumNumberOfCorrectorIterations = 1 ) :
+        ReinitializableNumericalIntegratorBase( stateDerivativeFunction ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
+        stepSize_( TUDAT_NAN ),
+        nextStepSize_( TUDAT_NAN ),
+        useStepSizeControl_( true ),
+        minimumStepSize_( std::fabs( minimumStepSize ) ),
+        maximumStepSize_( std::fabs( maximumStepSize ) ),
+        relativeErrorTolerance_( std::fabs( relativeErrorTolerance ) ),
+        absoluteErrorTolerance_( std::fabs( absoluteErrorTolerance ) ),
+        bandwidth_( std::fabs( bandwidth ) ),
+        correctorConvergenceTolerance_( correctorConvergenceTolerance ),
+        maximumNumberOfCorrectorIterations_( std::max( maximumNumberOfCorrectorIterations, 1u ) )
+    {
+        initialize( );
+    }
+
+    //! Get step size of the next step.
+    /*!
+     * Returns the step size of the next step.
+     * \return Step size to be used for the next step.
+     */
+    TimeStepType getNextStepSize( ) const { return nextStepSize_; }
+
+    //! Get current state.
+    /*!
+     * Returns the current state of the integrator.
+     * \return Current integrated state.
+     */
+    StateType getCurrentState( ) const { return currentState_; }
+
+    //! Returns the current independent variable.
+    /*!
+     * Returns the current value of the independent variable of the integrator.
+     * \return Current independent variable.
+     */
+    IndependentVariableType getCurrentIndependentVariable( ) const { return currentIndependentVariable_; }
+
+    //! Get previous independent variable.
+    /*!
+     * Returns the previous value of the independent variable of the integrator.
+     * \return Previous independent variable.
+     */
+    IndependentVariableType getPreviousIndependentVariable( ) { return lastIndependentVariable_; }
+
+    //! Get previous state value.
+    /*!
+     * Returns the previous value of the state.
+     * \return Previous state.
+     */
+    StateType getPreviousState( ) { return lastState_; }
+
+    //! Perform a single integration step.
+    /*!
+     * Perform a single integration step. If the history of back-points has not yet been initialized (or has been
+     * invalidated by a modification of the state), the integrator is (re)started, and the start-up states are
+     * returned by the subsequent calls to this function. If the step size differs from that of the previous step, the
+     * back-points are interpolated to the new step size. For the variable step size integrator, the step size is
+     * halved until the error is within tolerances, so that the step actually taken may be smaller than stepSize.
+     * \param stepSize The step size to take.
+     * \return The state at the end of the step.
+     */
+    StateType performIntegrationStep( const TimeStepType stepSize )
+    {
+        lastIndependentVariable_ = currentIndependentVariable_;
+        lastState_ = currentState_;
+
+        // (Re)start integrator if necessary, or change step size w.r.t. the previous step
+        if( !isHistoryInitialized_ || ( stepSize != stepSize_ && isStartUpInProgress( ) ) )
+        {
+            performStartUp( stepSize );
+        }
+        else if( stepSize != stepSize_ )
+        {
+            changeStepSize( stepSize );
+        }
+
+        // During start-up, return start-up states
+        if( isStartUpInProgress( ) )
+        {
+            lastStepType_ = start_up_step;
+            currentIndependentVariable_ = startUpIndependentVariables_.at( numberOfUsedStartUpStates_ );
+            currentState_ = startUpStates_.at( numberOfUsedStartUpStates_ );
+            numberOfUsedStartUpStates_++;
+            nextStepSize_ = stepSize_;
+            return currentState_;
+        }
+
+        // Perform Gauss-Jackson step, reducing the step size until the error is within tolerances
+        while( !performGaussJacksonStep( ) )
+        {
+            if( std::fabs( stepSize_ / 2.0 ) < minimumStepSize_ )
+            {
+                throw std::runtime_error( "Error in Gauss-Jackson integrator, minimum step size exceeded." );
+            }
+            changeStepSize( stepSize_ / 2.0 );
+            numberOfStepsSinceRejection_ = 0;
+        }
+
+        return currentState_;
+    }
+
+    //! Rollback internal state to the last state.
+    /*!
+     * Performs rollback of internal state to the last state. This function can only be called once after calling
+     * integrateTo() or performIntegrationStep() unless specified otherwise by implementations, and can not be called
+     * before any of these functions have been called. Will return true if the rollback was successful, and false
+     * otherwise.
+     * \return True if the rollback was successful.
+     */
+    bool rollbackToPreviousState( )
+    {
+        if( currentIndependentVariable_ == lastIndependentVariable_ )
+        {
+            return false;
+        }
+
+        currentIndependentVariable_ = lastIndependentVariable_;
+        currentState_ = lastState_;
+
+        // Restore history to that at the last state
+        if( lastStepType_ == start_up_step )
+        {
+            numberOfUsedStartUpStates_--;
+        }
+        else if( lastStepType_ == gauss_jackson_step )
+        {
+            accelerationHistory_.pop_back( );
+            if( isAccelerationRemovedFromHistory_ )
+            {
+                accelerationHistory_.push_front( lastRemovedAcceleration_ );
+            }
+            firstSum_ = lastFirstSum_;
+            secondSum_ = lastSecondSum_;
+        }
+        else
+        {
+            isHistoryInitialized_ = false;
+        }
+        lastStepType_ = no_step;
+        nextStepSize_ = stepSize_;
+
+        return true;
+    }
+
+    //! Replace the state with a new value.
+    /*!
+     * Replace the state with a new value. This allows for discrete jumps in the state, often used in simulations of
+     * discrete events. If the new state differs from the current state, the history of back-points is invalidated, so
+     * that the integrator is restarted at the next step.
+     * \param newState The value of the new state.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentState( const StateType& newState, const bool allowRollback = false )
+    {
+        if( newState != currentState_ )
+        {
+            currentState_ = newState;
+            isHistoryInitialized_ = false;
+            lastStepType_ = no_step;
+        }
+
+        if( !allowRollback )
+        {
+            lastIndependentVariable_ = currentIndependentVariable_;
+        }
+    }
+
+    //! Modify the state and time for the current step.
+    /*!
+     * Modify the state and time for the current step. The history of back-points is invalidated, so that the
+     * integrator is restarted at the next step.
+     * \param newState The new state to set the current state to.
+     * \param newTime The time to set the current time to.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentIntegrationVariables( const StateType& newState, const IndependentVariableType newTime,
+                                            const bool allowRollback = false )
+    {
+        currentState_ = newState;
+        currentIndependentVariable_ = newTime;
+        isHistoryInitialized_ = false;
+        lastStepType_ = no_step;
+
+        if( !allowRollback )
+        {
+            lastIndependentVariable_ = currentIndependentVariable_;
+        }
+    }
+
+    //! Function to toggle the use of step-size control
+    /*!
+     * Function to toggle the use of step-size control. Only has an effect if the integrator was created with error
+     * tolerances.
+     * \param useStepSizeControl Boolean denoting whether step size control is to be used
+     */
+    void setStepSizeControl( const bool useStepSizeControl )
+    {
+        useStepSizeControl_ = useStepSizeControl && ( relativeErrorTolerance_ > 0.0 || absoluteErrorTolerance_ > 0.0 );
+    }
+
+    //! Function to retrieve the number of Gauss-Jackson steps performed so far (excluding start-up).
+    /*!
+     * Function to retrieve the number of Gauss-Jackson steps performed so far, excluding the start-up steps.
+     * \return Number of Gauss-Jackson steps performed so far.
+     */
+    unsigned int getNumberOfGaussJacksonSteps( ) const { return numberOfGaussJacksonSteps_; }
+
+    //! Function to retrieve the number of times the integrator has been (re)started.
+    /*!
+     * Function to retrieve the number of times the integrator has been (re)started, with a Runge-Kutta integrator.
+     * \return Number of times the integrator has been (re)started.
+     */
+    unsigned int getNumberOfStartUps( ) const { return numberOfStartUps_; }
+
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator to a binary stream, see
+     * NumericalIntegrator::writeIntegratorState. In addition to the current and previous state, this includes the
+     * acceleration history and summed accelerations, the start-up states, and the data required to roll back the last
+     * step or to restore the history of the previous step size.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "GaussJacksonIntegrator" );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, nextStepSize_ );
+        serialization::writeBinaryValue( stream, useStepSizeControl_ );
+        serialization::writeBinaryValue( stream, isHistoryInitialized_ );
+        serialization::writeBinaryValue( stream, accelerationHistory_ );
+        serialization::writeBinaryValue( stream, firstSum_ );
+        serialization::writeBinaryValue( stream, secondSum_ );
+        serialization::writeBinaryValue( stream, startUpIndependentVariables_ );
+        serialization::writeBinaryValue( stream, startUpStates_ );
+        serialization::writeBinaryValue( stream, numberOfUsedStartUpStates_ );
+        serialization::writeBinaryValue( stream, static_cast< int >( lastStepType_ ) );
+        serialization::writeBinaryValue( stream, lastFirstSum_ );
+        serialization::writeBinaryValue( stream, lastSecondSum_ );
+        serialization::writeBinaryValue( stream, isAccelerationRemovedFromHistory_ );
+        serialization::writeBinaryValue( stream, lastRemovedAcceleration_ );
+        serialization::writeBinaryValue( stream, isPreviousStepSizeHistoryAvailable_ );
+        serialization::writeBinaryValue( stream, previousStepSize_ );
+        serialization::writeBinaryValue( stream, previousStepSizeAccelerationHistory_ );
+        serialization::writeBinaryValue( stream, numberOfStepsSinceRejection_ );
+        serialization::writeBinaryValue( stream, numberOfGaussJacksonSteps_ );
+        serialization::writeBinaryValue( stream, numberOfStartUps_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "GaussJacksonIntegrator" );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, nextStepSize_ );
+        serialization::readBinaryValue( stream, useStepSizeControl_ );
+        serialization::readBinaryValue( stream, isHistoryInitialized_ );
+        serialization::readBinaryValue( stream, accelerationHistory_ );
+        serialization::readBinaryValue( stream, firstSum_ );
+        serialization::readBinaryValue( stream, secondSum_ );
+        serialization::readBinaryValue( stream, startUpIndependentVariables_ );
+        serialization::readBinaryValue( stream, startUpStates_ );
+        serialization::readBinaryValue( stream, numberOfUsedStartUpStates_ );
+        int lastStepType;
+        serialization::readBinaryValue( stream, lastStepType );
+        lastStepType_ = static_cast< StepType >( lastStepType );
+        serialization::readBinaryValue( stream, lastFirstSum_ );
+        serialization::readBinaryValue( stream, lastSecondSum_ );
+        serialization::readBinaryValue( stream, isAccelerationRemovedFromHistory_ );
+        serialization::readBinaryValue( stream, lastRemovedAcceleration_ );
+        serialization::readBinaryValue( stream, isPreviousStepSizeHistoryAvailable_ );
+        serialization::readBinaryValue( stream, previousStepSize_ );
+        serialization::readBinaryValue( stream, previousStepSizeAccelerationHistory_ );
+        serialization::readBinaryValue( stream, numberOfStepsSinceRejection_ );
+        serialization::readBinaryValue( stream, numberOfGaussJacksonSteps_ );
+        serialization::readBinaryValue( stream, numberOfStartUps_ );
+    }
+
+protected:
+
+    //! Enum to denote the type of the last step (used for rollback).
+    enum StepType
+    {
+        no_step,
+        start_up_step,
+        gauss_jackson_step
+    };
+
+    //! Function to check the input and pre-allocate the variables used during integration.
+    void initialize( )
+    {
+        if( currentState_.rows( ) % 6 != 0 || currentState_.rows( ) == 0 )
+        {
+            throw std::runtime_error( "Error in Gauss-Jackson integrator, the number of rows of the state (" +
+                                      std::to_string( currentState_.rows( ) ) + ") is not a multiple of six." );
+        }
+        numberOfBlocks_ = currentState_.rows( ) / 6;
+
+        const GaussJacksonCoefficients& coefficients = GaussJacksonCoefficients::get( );
+        positionCoefficients_ = coefficients.positionCoefficients.template cast< StateScalarType >( );
+        velocityCoefficients_ = coefficients.velocityCoefficients.template cast< StateScalarType >( );
+        positionErrorFactor_ = static_cast< StateScalarType >( coefficients.positionErrorFactor );
+
+        isHistoryInitialized_ = false;
+        numberOfUsedStartUpStates_ = 0;
+        lastStepType_ = no_step;
+        isAccelerationRemovedFromHistory_ = false;
+        isPreviousStepSizeHistoryAvailable_ = false;
+        numberOfStepsSinceRejection_ = 0;
+        numberOfGaussJacksonSteps_ = 0;
+        numberOfStartUps_ = 0;
+    }
+
+    //! Function to check whether start-up states are still to be returned.
+    bool isStartUpInProgress( ) const
+    {
+        return numberOfUsedStartUpStates_ < startUpStates_.size( );
+    }
+
+    //! Function to retrieve the position or velocity rows from a state.
+    /*!
+     * Function to retrieve the position (or velocity) rows from a state (or the velocity (or acceleration) rows from
+     * a state derivative).
+     * \param state State from which the rows are to be retrieved.
+     * \param rowOffset Offset w.r.t. the start of each block of six rows (0 for position, 3 for velocity rows).
+     * \param secondOrderState Position or velocity rows (returned by reference).
+     */
+    template< typename InputType >
+    void getSecondOrderState( const InputType& state, const int rowOffset, SecondOrderStateType& secondOrderState ) const
+    {
+        secondOrderState.resize( 3 * numberOfBlocks_, state.cols( ) );
+        for( int i = 0; i < numberOfBlocks_; i++ )
+        {
+            secondOrderState.block( 3 * i, 0, 3, state.cols( ) ) = state.block( 6 * i + rowOffset, 0, 3, state.cols( ) );
+        }
+    }
+
+    //! Function to set the state from given position and velocity rows.
+    /*!
+     * Function to set the state from given position and velocity rows.
+     * \param positions Position rows.
+     * \param velocities Velocity rows.
+     * \param state State (returned by reference, must already have the correct size).
+     */
+    void setState( const SecondOrderStateType& positions, const SecondOrderStateType& velocities, StateType& state ) const
+    {
+        for( int i = 0; i < numberOfBlocks_; i++ )
+        {
+            state.block( 6 * i, 0, 3, state.cols( ) ) = positions.block( 3 * i, 0, 3, state.cols( ) );
+            state.block( 6 * i + 3, 0, 3, state.cols( ) ) = velocities.block( 3 * i, 0, 3, state.cols( ) );
+        }
+    }
+
+    //! Function to compute the acceleration at a given state.
+    /*!
+     * Function to compute the acceleration rows of the state derivative at a given state.
+     * \param independentVariable Independent variable at which the state derivative is to be evaluated.
+     * \param state State at which the state derivative is to be evaluated.
+     * \param acceleration Acceleration rows of the state derivative (returned by reference).
+     */
+    void computeAcceleration( const IndependentVariableType independentVariable, const StateType& state,
+                              SecondOrderStateType& acceleration )
+    {
+        this->evaluateStateDerivative( independentVariable, state, stateDerivative_ );
+        getSecondOrderState( stateDerivative_, 3, acceleration );
+    }
+
+    //! Function to compute the weighted sum of (a subset of) the acceleration back-points.
+    /*!
+     * Function to compute the weighted sum of the acceleration history entries firstEntry, ...,
+     * firstEntry + numberOfTerms - 1, with the first numberOfTerms coefficients of a given row of coefficients.
+     * \param coefficients Row of coefficients.
+     * \param firstEntry Index of the first acceleration history entry.
+     * \param numberOfTerms Number of terms in the sum.
+     * \param weightedSum Weighted sum (returned by reference).
+     */
+    template< typename CoefficientsType >
+    void computeWeightedAccelerationSum( const CoefficientsType& coefficients, const int firstEntry,
+                                         const int numberOfTerms, SecondOrderStateType& weightedSum ) const
+    {
+        weightedSum = coefficients( 0 ) * accelerationHistory_.at( firstEntry );
+        for( int m = 1; m < numberOfTerms; m++ )
+        {
+            weightedSum += coefficients( m ) * accelerationHistory_.at( firstEntry + m );
+        }
+    }
+
+    //! Function to set the first and second sum at the most recent back-point from the current state.
+    void initializeSums( )
+    {
+        const StateScalarType stepSize = static_cast< StateScalarType >( stepSize_ );
+        const int firstEntry = accelerationHistory_.size( ) - GaussJacksonCoefficients::numberOfBackPoints;
+
+        getSecondOrderState( currentState_, 0, positions_ );
+        getSecondOrderState( currentState_, 3, velocities_ );
+        computeWeightedAccelerationSum( velocityCoefficients_.row( 8 ), firstEntry, 9, weightedSum_ );
+        firstSum_ = velocities_ / stepSize - weightedSum_;
+        computeWeightedAccelerationSum( positionCoefficients_.row( 8 ), firstEntry, 9, weightedSum_ );
+        secondSum_ = positions_ / ( stepSize * stepSize ) - weightedSum_;
+    }
+
+    //! Function to (re)start the integrator from the current state.
+    /*!
+     * Function to (re)start the integrator from the current state, by computing the states at the next eight steps
+     * with a fixed-step Runge-Kutta-Fehlberg 7(8) integrator, and iterating these states with the Gauss-Jackson
+     * formulas until convergence. The start-up states are stored, to be returned by the next calls to
+     * performIntegrationStep.
+     * \param stepSize Step size to use.
+     */
+    void performStartUp( const TimeStepType stepSize )
+    {
+        const int numberOfBackPoints = GaussJacksonCoefficients::numberOfBackPoints;
+        const StateScalarType scalarStepSize = static_cast< StateScalarType >( stepSize );
+        stepSize_ = stepSize;
+        numberOfStartUps_++;
+
+        // Compute initial guess of start-up states with Runge-Kutta integrator
+        RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+                startUpIntegrator( RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                                   this->stateDerivativeFunction_, currentIndependentVariable_, currentState_,
+                                   std::fabs( stepSize ), std::fabs( stepSize ), 1.0, 1.0 );
+        startUpIntegrator.setStepSizeControl( false );
+
+        startUpIndependentVariables_.resize( numberOfBackPoints );
+        startUpStates_.resize( numberOfBackPoints );
+        accelerationHistory_.resize( numberOfBackPoints );
+        startUpIndependentVariables_[ 0 ] = currentIndependentVariable_;
+        startUpStates_[ 0 ] = currentState_;
+        for( int k = 1; k < numberOfBackPoints; k++ )
+        {
+            startUpStates_[ k ] = startUpIntegrator.performIntegrationStep( stepSize );
+            startUpIndependentVariables_[ k ] = startUpIndependentVariables_[ k - 1 ] + stepSize;
+        }
+
+        for( int k = 0; k < numberOfBackPoints; k++ )
+        {
+            computeAcceleration( startUpIndependentVariables_[ k ], startUpStates_[ k ], accelerationHistory_[ k ] );
+        }
+
+        // Iterate start-up states with Gauss-Jackson formulas, keeping the current state fixed
+        bool isConverged = false;
+        for( unsigned int iteration = 0; iteration < 10 * maximumNumberOfCorrectorIterations_; iteration++ )
+        {
+            computeStartUpSums( 0 );
+            StateScalarType maximumPositionChange = 0.0, maximumVelocityChange = 0.0;
+            StateScalarType maximumPosition = 0.0, maximumVelocity = 0.0;
+            for( int k = 1; k < numberOfBackPoints; k++ )
+            {
+                computeStartUpSums( k );
+                computeWeightedAccelerationSum( positionCoefficients_.row( k ), 0, numberOfBackPoints, weightedSum_ );
+                correctedPositions_ = scalarStepSize * scalarStepSize * ( secondSum_ + weightedSum_ );
+                computeWeightedAccelerationSum( velocityCoefficients_.row( k ), 0, numberOfBackPoints, weightedSum_ );
+                correctedVelocities_ = scalarStepSize * ( firstSum_ + weightedSum_ );
+
+                getSecondOrderState( startUpStates_[ k ], 0, positions_ );
+                getSecondOrderState( startUpStates_[ k ], 3, velocities_ );
+                maximumPositionChange = std::max(
+                            maximumPositionChange, ( correctedPositions_ - positions_ ).cwiseAbs( ).maxCoeff( ) );
+                maximumVelocityChange = std::max(
+                            maximumVelocityChange, ( correctedVelocities_ - velocities_ ).cwiseAbs( ).maxCoeff( ) );
+                maximumPosition = std::max( maximumPosition, correctedPositions_.cwiseAbs( ).maxCoeff( ) );
+                maximumVelocity = std::max( maximumVelocity, correctedVelocities_.cwiseAbs( ).maxCoeff( ) );
+
+                setState( correctedPositions_, correctedVelocities_, startUpStates_[ k ] );
+            }
+
+            for( int k = 1; k < numberOfBackPoints; k++ )
+            {
+                computeAcceleration( startUpIndependentVariables_[ k ], startUpStates_[ k ], accelerationHistory_[ k ] );
+            }
+
+            if( maximumPositionChange <= correctorConvergenceTolerance_ * maximumPosition &&
+                    maximumVelocityChange <= correctorConvergenceTolerance_ * maximumVelocity )
+            {
+                isConverged = true;
+                break;
+            }
+        }
+
+        if( !isConverged )
+        {
+            std::cerr << "Warning in Gauss-Jackson integrator, start-up iteration did not converge to within tolerance "
+                      << correctorConvergenceTolerance_ << " at t = " << currentIndependentVariable_ << std::endl;
+        }
+
+        // Set sums at most recent back-point
+        computeStartUpSums( 0 );
+        for( int k = 1; k < numberOfBackPoints; k++ )
+        {
+            computeStartUpSums( k );
+        }
+
+        numberOfUsedStartUpStates_ = 1;
+        isHistoryInitialized_ = true;
+        isPreviousStepSizeHistoryAvailable_ = false;
+        lastStepType_ = no_step;
+        nextStepSize_ = stepSize_;
+    }
+
+    //! Function to compute the first and second sum at a given start-up point.
+    /*!
+     * Function to compute the first and second sum at a given start-up point, from the sums at the previous start-up
+     * point (for index 0, the sums are computed from the current state).
+     * \param index Index of the start-up point.
+     */
+    void computeStartUpSums( const int index )
+    {
+        if( index == 0 )
+        {
+            const StateScalarType stepSize = static_cast< StateScalarType >( stepSize_ );
+            getSecondOrderState( currentState_, 0, positions_ );
+            getSecondOrderState( currentState_, 3, velocities_ );
+            computeWeightedAccelerationSum( velocityCoefficients_.row( 0 ), 0, 9, weightedSum_ );
+            firstSum_ = velocities_ / stepSize - weightedSum_;
+            computeWeightedAccelerationSum( positionCoefficients_.row( 0 ), 0, 9, weightedSum_ );
+            secondSum_ = positions_ / ( stepSize * stepSize ) - weightedSum_;
+        }
+        else
+        {
+            secondSum_ += firstSum_ + 0.5 * accelerationHistory_.at( index - 1 );
+            firstSum_ += 0.5 * ( accelerationHistory_.at( index - 1 ) + accelerationHistory_.at( index ) );
+        }
+    }
+
+    //! Function to change the step size, by interpolating the acceleration back-points.
+    /*!
+     * Function to change the step size, by interpolating the acceleration history to back-points separated by the
+     * new step size (using the interpolating polynomial through the nine nearest back-points). If the history does
+     * not cover the nine back-points required for the new step size, the integrator is restarted. If the step size is
+     * changed back to its previous value before any step has been taken (e.g. when a step with a doubled step size is
+     * rejected), the original history is restored instead.
+     * \param newStepSize New step size.
+     */
+    void changeStepSize( const TimeStepType newStepSize )
+    {
+        const int numberOfBackPoints = GaussJacksonCoefficients::numberOfBackPoints;
+
+        // Restore history of previous step size, if possible
+        if( isPreviousStepSizeHistoryAvailable_ && newStepSize == previousStepSize_ )
+        {
+            accelerationHistory_.swap( previousStepSizeAccelerationHistory_ );
+            std::swap( stepSize_, previousStepSize_ );
+            nextStepSize_ = stepSize_;
+            initializeSums( );
+            if( lastStepType_ == gauss_jackson_step )
+            {
+                lastStepType_ = no_step;
+            }
+            return;
+        }
+
+        const long double stepSizeRatio = static_cast< long double >( newStepSize ) /
+                static_cast< long double >( stepSize_ );
+        const int oldHistorySize = accelerationHistory_.size( );
+
+        // Determine number of back-points for new step size that are covered by the current history
+        int newHistorySize = 0;
+        if( stepSizeRatio > 0.0L )
+        {
+            newHistorySize = std::min(
+                        static_cast< int >( std::floor( ( oldHistorySize - 1 ) / stepSizeRatio + 1.0E-9L ) ) + 1,
+                        2 * numberOfBackPoints - 1 );
+        }
+
+        if( newHistorySize < numberOfBackPoints )
+        {
+            performStartUp( newStepSize );
+            return;
+        }
+
+        // Interpolate acceleration history
+        std::deque< SecondOrderStateType > newAccelerationHistory( newHistorySize );
+        for( int j = 0; j < newHistorySize; j++ )
+        {
+            const long double oldHistoryCoordinate =
+                    static_cast< long double >( oldHistorySize - 1 ) - stepSizeRatio * static_cast< long double >( j );
+            const int firstEntry = std::max(
+                        0, std::min( static_cast< int >( std::lround( oldHistoryCoordinate ) ) - 4,
+                                     oldHistorySize - numberOfBackPoints ) );
+            computeWeightedAccelerationSum(
+                        computeGaussJacksonInterpolationWeights(
+                            oldHistoryCoordinate - static_cast< long double >( firstEntry ) ).template cast< StateScalarType >( ),
+                        firstEntry, numberOfBackPoints, newAccelerationHistory[ newHistorySize - 1 - j ] );
+        }
+        previousStepSizeAccelerationHistory_.swap( accelerationHistory_ );
+        accelerationHistory_.swap( newAccelerationHistory );
+        previousStepSize_ = stepSize_;
+        isPreviousStepSizeHistoryAvailable_ = true;
+
+        stepSize_ = newStepSize;
+        nextStepSize_ = stepSize_;
+        initializeSums( );
+
+        // Step type can no longer be rolled back using the history
+        if( lastStepType_ == gauss_jackson_step )
+        {
+            lastStepType_ = no_step;
+        }
+    }
+
+    //! Function to perform a single Gauss-Jackson step with the current step size.
+    /*!
+     * Function to perform a single Gauss-Jackson (predict-evaluate-correct) step with the current step size, where the
+     * corrector is iterated until convergence. If step size control is used, and the estimated error exceeds the
+     * tolerances, the step is rejected.
+     * \return True if the step is accepted, false if it is rejected.
+     */
+    bool performGaussJacksonStep( )
+    {
+        const int numberOfBackPoints = GaussJacksonCoefficients::numberOfBackPoints;
+        const StateScalarType stepSize = static_cast< StateScalarType >( stepSize_ );
+        const StateScalarType squaredStepSize = stepSize * stepSize;
+        const int firstEntry = accelerationHistory_.size( ) - numberOfBackPoints;
+        const IndependentVariableType newIndependentVariable = currentIndependentVariable_ + stepSize_;
+
+        // Predict position and velocity at the next point
+        nextSecondSum_ = secondSum_ + firstSum_ + 0.5 * accelerationHistory_.back( );
+        computeWeightedAccelerationSum( positionCoefficients_.row( 9 ), firstEntry, numberOfBackPoints, weightedSum_ );
+        predictedPositions_ = squaredStepSize * ( nextSecondSum_ + weightedSum_ );
+        computeWeightedAccelerationSum( velocityCoefficients_.row( 9 ), firstEntry, numberOfBackPoints, weightedSum_ );
+        predictedVelocities_ = stepSize * ( firstSum_ + 0.5 * accelerationHistory_.back( ) + weightedSum_ );
+
+        // Compute the contributions of the known back-points to the corrector
+        computeWeightedAccelerationSum( positionCoefficients_.row( 8 ), firstEntry + 1, numberOfBackPoints - 1,
+                                        correctorPositionSum_ );
+        correctorPositionSum_ += nextSecondSum_;
+        computeWeightedAccelerationSum( velocityCoefficients_.row( 8 ), firstEntry + 1, numberOfBackPoints - 1,
+                                        correctorVelocitySum_ );
+        correctorVelocitySum_ += firstSum_ + 0.5 * accelerationHistory_.back( );
+
+        // Evaluate and correct, until converged
+        const StateScalarType newPointPositionCoefficient = positionCoefficients_( 8, numberOfBackPoints - 1 );
+        const StateScalarType newPointVelocityCoefficient = velocityCoefficients_( 8, numberOfBackPoints - 1 ) + 0.5;
+        correctedPositions_ = predictedPositions_;
+        correctedVelocities_ = predictedVelocities_;
+        nextState_ = currentState_;
+        for( unsigned int iteration = 0; iteration < maximumNumberOfCorrectorIterations_; iteration++ )
+        {
+            setState( correctedPositions_, correctedVelocities_, nextState_ );
+            computeAcceleration( newIndependentVariable, nextState_, newAcceleration_ );
+
+            positions_ = squaredStepSize * ( correctorPositionSum_ + newPointPositionCoefficient * newAcceleration_ );
+            velocities_ = stepSize * ( correctorVelocitySum_ + newPointVelocityCoefficient * newAcceleration_ );
+
+            const bool isConverged =
+                    ( positions_ - correctedPositions_ ).cwiseAbs( ).maxCoeff( ) <=
+                    correctorConvergenceTolerance_ * positions_.cwiseAbs( ).maxCoeff( ) &&
+                    ( velocities_ - correctedVelocities_ ).cwiseAbs( ).maxCoeff( ) <=
+                    correctorConvergenceTolerance_ * velocities_.cwiseAbs( ).maxCoeff( );
+            correctedPositions_.swap( positions_ );
+            correctedVelocities_.swap( velocities_ );
+            if( isConverged )
+            {
+                break;
+            }
+        }
+        setState( correctedPositions_, correctedVelocities_, nextState_ );
+
+        // Estimate error, and check whether step is to be accepted, and step size can be doubled (which, to prevent
+        // repeated doubling and halving, requires a number of accepted steps since the last rejected step)
+        bool isStepSizeToBeDoubled = false;
+        if( useStepSizeControl_ )
+        {
+            // The error is evaluated for the position of each body (rather than each element), to prevent the
+            // tolerance from becoming unattainable when a single position element passes through zero
+            bool isErrorTooLarge = false;
+            bool isErrorTooSmall = true;
+            for( int i = 0; i < numberOfBlocks_; i++ )
+            {
+                for( int k = 0; k < nextState_.cols( ); k++ )
+                {
+                    const StateScalarType positionError = positionErrorFactor_ * (
+                                correctedPositions_.block( 3 * i, k, 3, 1 ) -
+                                predictedPositions_.block( 3 * i, k, 3, 1 ) ).norm( );
+                    const StateScalarType positionTolerance = absoluteErrorTolerance_ + relativeErrorTolerance_ *
+                            correctedPositions_.block( 3 * i, k, 3, 1 ).norm( );
+
+                    isErrorTooLarge = isErrorTooLarge || ( positionError > positionTolerance );
+                    isErrorTooSmall = isErrorTooSmall && ( positionError * bandwidth_ < positionTolerance );
+                }
+            }
+
+            if( isErrorTooLarge )
+            {
+                return false;
+            }
+
+            isStepSizeToBeDoubled = isErrorTooSmall &&
+                    ( static_cast< int >( accelerationHistory_.size( ) ) == 2 * numberOfBackPoints - 1 ) &&
+                    ( numberOfStepsSinceRejection_ >= numberOfBackPoints - 1 ) &&
+                    ( std::fabs( 2.0 * stepSize_ ) <= maximumStepSize_ );
+        }
+
+        // Update history
+        lastFirstSum_ = firstSum_;
+        lastSecondSum_ = secondSum_;
+        firstSum_ += 0.5 * ( accelerationHistory_.back( ) + newAcceleration_ );
+        secondSum_ = nextSecondSum_;
+        accelerationHistory_.push_back( newAcceleration_ );
+        isPreviousStepSizeHistoryAvailable_ = false;
+        numberOfStepsSinceRejection_++;
+        isAccelerationRemovedFromHistory_ =
+                ( static_cast< int >( accelerationHistory_.size( ) ) > 2 * numberOfBackPoints - 1 );
+        if( isAccelerationRemovedFromHistory_ )
+        {
+            lastRemovedAcceleration_.swap( accelerationHistory_.front( ) );
+            accelerationHistory_.pop_front( );
+        }
+
+        currentIndependentVariable_ = newIndependentVariable;
+        currentState_ = nextState_;
+        nextStepSize_ = isStepSizeToBeDoubled ? ( 2.0 * stepSize_ ) : stepSize_;
+        lastStepType_ = gauss_jackson_step;
+        numberOfGaussJacksonSteps_++;
+
+        return true;
+    }
+
+    //! Current independent variable.
+    IndependentVariableType currentIndependentVariable_;
+
+    //! Current state.
+    StateType currentState_;
+
+    //! Last independent variable.
+    IndependentVariableType lastIndependentVariable_;
+
+    //! Last state.
+    StateType lastState_;
+
+    //! Step size of the current back-point history.
+    TimeStepType stepSize_;
+
+    //! Step size to be used for the next step.
+    TimeStepType nextStepSize_;
+
+    //! Boolean denoting whether the step size is controlled.
+    bool useStepSizeControl_;
+
+    //! Minimum step size.
+    TimeStepType minimumStepSize_;
+
+    //! Maximum step size.
+    TimeStepType maximumStepSize_;
+
+    //! Relative error tolerance.
+    StateScalarType relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    StateScalarType absoluteErrorTolerance_;
+
+    //! Factor between the tolerance and the error below which the step size is doubled.
+    TimeStepType bandwidth_;
+
+    //! Relative tolerance on the change in position and velocity between two corrector iterations.
+    StateScalarType correctorConvergenceTolerance_;
+
+    //! Maximum number of corrector iterations (state derivative evaluations) per step.
+    unsigned int maximumNumberOfCorrectorIterations_;
+
+    //! Number of blocks of six rows in the state.
+    int numberOfBlocks_;
+
+    //! Gauss-Jackson coefficients for the position (see GaussJacksonCoefficients).
+    Eigen::Matrix< StateScalarType, GaussJacksonCoefficients::numberOfBackPoints + 1,
+    GaussJacksonCoefficients::numberOfBackPoints > positionCoefficients_;
+
+    //! Summed Adams coefficients for the velocity (see GaussJacksonCoefficients).
+    Eigen::Matrix< StateScalarType, GaussJacksonCoefficients::numberOfBackPoints + 1,
+    GaussJacksonCoefficients::numberOfBackPoints > velocityCoefficients_;
+
+    //! Factor with which the difference between corrected and predicted position is multiplied to estimate the error.
+    StateScalarType positionErrorFactor_;
+
+    //! Boolean denoting whether the back-point history has been initialized.
+    bool isHistoryInitialized_;
+
+    //! History of accelerations at the back-points (most recent last), at most 17 entries to allow step doubling.
+    std::deque< SecondOrderStateType > accelerationHistory_;
+
+    //! First sum of the accelerations at the most recent back-point.
+    SecondOrderStateType firstSum_;
+
+    //! Second sum of the accelerations at the most recent back-point.
+    SecondOrderStateType secondSum_;
+
+    //! Values of the independent variable at the start-up points.
+    std::vector< IndependentVariableType > startUpIndependentVariables_;
+
+    //! States at the start-up points.
+    std::vector< StateType > startUpStates_;
+
+    //! Number of start-up states that have been returned by performIntegrationStep.
+    unsigned int numberOfUsedStartUpStates_;
+
+    //! Type of the last step (used for rollback).
+    StepType lastStepType_;
+
+    //! First sum before the last Gauss-Jackson step (used for rollback).
+    SecondOrderStateType lastFirstSum_;
+
+    //! Second sum before the last Gauss-Jackson step (used for rollback).
+    SecondOrderStateType lastSecondSum_;
+
+    //! Boolean denoting whether an acceleration was removed from the history in the last step (used for rollback).
+    bool isAccelerationRemovedFromHistory_;
+
+    //! Acceleration removed from the history in the last step (used for rollback).
+    SecondOrderStateType lastRemovedAcceleration_;
+
+    //! Boolean denoting whether the history before the last change in step size is available (no step taken since).
+    bool isPreviousStepSizeHistoryAvailable_;
+
+    //! Step size before the last change in step size.
+    TimeStepType previousStepSize_;
+
+    //! Acceleration history before the last change in step size.
+    std::deque< SecondOrderStateType > previousStepSizeAccelerationHistory_;
+
+    //! Number of Gauss-Jackson steps accepted since the last rejected step.
+    int numberOfStepsSinceRejection_;
+
+    //! Number of Gauss-Jackson steps performed so far (excluding start-up).
+    unsigned int numberOfGaussJacksonSteps_;
+
+    //! Number of times the integrator has been (re)started.
+    unsigned int numberOfStartUps_;
+
+    //! Pre-allocated state derivative.
+    StateDerivativeType stateDerivative_;
+
+    //! Pre-allocated state at the next point.
+    StateType nextState_;
+
+    //! Pre-allocated position and velocity rows, and (weighted) sums of accelerations, used during a step.
+    SecondOrderStateType positions_, velocities_, predictedPositions_, predictedVelocities_,
+    correctedPositions_, correctedVelocities_, newAcceleration_, weightedSum_, nextSecondSum_,
+    correctorPositionSum_, correctorVelocitySum_;
+
+};
+
+extern template class GaussJacksonIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
+extern template class GaussJacksonIntegrator < double, Eigen::Vector6d, Eigen::Vector6d >;
+extern template class GaussJacksonIntegrator < double, Eigen::MatrixXd, Eigen::MatrixXd >;
+
+//! Typedef of Gauss-Jackson integrator (state/state derivative = VectorXd, independent variable = double).
+typedef GaussJacksonIntegrator< > GaussJacksonIntegratorXd;
+
+//! Typedef of pointer to default Gauss-Jackson integrator.
+typedef std::shared_ptr< GaussJacksonIntegratorXd > GaussJacksonIntegratorXdPointer;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_GAUSS_JACKSON_INTEGRATOR_H
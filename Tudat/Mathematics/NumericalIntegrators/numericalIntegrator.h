@@ -21,6 +21,7 @@
 #include <Eigen/Core>
 
 #include "Tudat/Basics/basicTypedefs.h"
+#include "Tudat/Basics/binarySerialization.h"
 #include "Tudat/Basics/timeType.h"
 #include "Tudat/Basics/utilityMacros.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
@@ -54,6 +55,14 @@ public:
     typedef std::function< StateDerivativeType(
             const IndependentVariableType, const StateType& ) > StateDerivativeFunction;
 
+    //! Typedef to the state derivative function that returns the state derivative by reference.
+    /*!
+     * Typedef to the state derivative function that returns the state derivative by reference (as the final argument),
+     * allowing the state derivative to be computed without allocating a new object.
+     */
+    typedef std::function< void(
+            const IndependentVariableType, const StateType&, StateDerivativeType& ) > InPlaceStateDerivativeFunction;
+
     //! Default constructor.
     /*!
      * Default constructor, taking a state derivative function as argument.
@@ -168,6 +177,19 @@ public:
         return stateDerivativeFunction_;
     }
 
+    //! Function to set a state derivative function that returns the state derivative by reference
+    /*!
+     * Function to set a state derivative function that returns the state derivative by reference. If set, this function
+     * is used instead of the function passed to the constructor by integrators that support it (currently the
+     * Runge-Kutta integrators), so that the state derivatives can be written into pre-allocated buffers. The function
+     * must compute the same state derivative as the function passed to the constructor.
+     * \param inPlaceStateDerivativeFunction State derivative function that returns the state derivative by reference.
+     */
+    void setInPlaceStateDerivativeFunction( const InPlaceStateDerivativeFunction& inPlaceStateDerivativeFunction )
+    {
+        inPlaceStateDerivativeFunction_ = inPlaceStateDerivativeFunction;
+    }
+
     //! Function to return the termination condition was reached during the current step
     /*!
      *  Function to return the termination condition was reached during the current step
@@ -197,6 +219,33 @@ public:
      */
     virtual void setStepSizeControl( const bool useStepSizeControl ) { }
 
+    //! Function to check whether the integrator can provide dense output.
+    /*!
+     * Function to check whether the integrator can provide dense output, i.e. whether the state at any value of the
+     * independent variable within the last accepted step can be computed with getDenseOutputState, without evaluating
+     * the state derivative. To be implemented in derived classes that provide dense output.
+     * \return True if the integrator can provide dense output.
+     */
+    virtual bool isDenseOutputAvailable( ) const
+    {
+        return false;
+    }
+
+    //! Function to compute the state at a given value of the independent variable within the last accepted step.
+    /*!
+     * Function to compute the state at a given value of the independent variable within the last accepted step (i.e.
+     * between getPreviousIndependentVariable and getCurrentIndependentVariable), by evaluating the continuous extension
+     * (dense output) of the integrator. No state derivatives are evaluated. To be implemented in derived classes that
+     * provide dense output (see isDenseOutputAvailable). If not implemented, throws error.
+     * \param independentVariable Value of the independent variable at which the state is to be computed.
+     * \return State at the requested value of the independent variable.
+     */
+    virtual StateType getDenseOutputState( const IndependentVariableType independentVariable )
+    {
+        TUDAT_UNUSED_PARAMETER( independentVariable );
+        throw std::runtime_error( "Function getDenseOutputState not implemented in this integrator" );
+    }
+
     //! Replace the state with a new value.
     /*!
      * Replace the state with a new value. This allows for discrete jumps in the state, often
@@ -233,6 +282,35 @@ public:
                                   "been implemented in this integrator." );
     }
 
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator (current and previous state and independent variable, step
+     * size control state, and method-specific data such as the history of a multistep method) to a binary stream, so that
+     * an integrator created with the same settings can continue bit-identically after calling readIntegratorState. To be
+     * implemented in derived classes that support checkpointing. If not implemented, throws error.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    virtual void writeIntegratorState( std::ostream& stream ) const
+    {
+        TUDAT_UNUSED_PARAMETER( stream );
+        throw std::runtime_error( "Error in numerical integrator. Writing the integrator state (for checkpointing) has "
+                                  "not been implemented in this integrator." );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, as written by writeIntegratorState of
+     * an integrator of the same type, created with the same settings. To be implemented in derived classes that support
+     * checkpointing. If not implemented, throws error.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    virtual void readIntegratorState( std::istream& stream )
+    {
+        TUDAT_UNUSED_PARAMETER( stream );
+        throw std::runtime_error( "Error in numerical integrator. Reading the integrator state (for checkpointing) has "
+                                  "not been implemented in this integrator." );
+    }
+
 protected:
 
     //! Function that returns the state derivative.
@@ -241,6 +319,33 @@ protected:
      */
     StateDerivativeFunction stateDerivativeFunction_;
 
+    //! Function that returns the state derivative by reference (empty if not set).
+    /*!
+     * Function that returns the state derivative by reference (empty if not set), see setInPlaceStateDerivativeFunction.
+     */
+    InPlaceStateDerivativeFunction inPlaceStateDerivativeFunction_;
+
+    //! Function to compute the state derivative, and return it by reference
+    /*!
+     * Function to compute the state derivative, and return it by reference. Uses inPlaceStateDerivativeFunction_ if it has
+     * been set, and stateDerivativeFunction_ otherwise.
+     * \param independentVariable Independent variable at which the state derivative is to be evaluated.
+     * \param state State at which the state derivative is to be evaluated.
+     * \param stateDerivative State derivative (returned by reference).
+     */
+    void evaluateStateDerivative( const IndependentVariableType independentVariable, const StateType& state,
+                                  StateDerivativeType& stateDerivative )
+    {
+        if( inPlaceStateDerivativeFunction_ )
+        {
+            inPlaceStateDerivativeFunction_( independentVariable, state, stateDerivative );
+        }
+        else
+        {
+            stateDerivative = stateDerivativeFunction_( independentVariable, state );
+        }
+    }
+
     //! Boolean to denote whether the propagation termination condition was reached during the evaluation of one of the sub-steps
     /*!
      *  Boolean to denote whether the propagation termination condition was reached during the evaluation of one of the sub-steps
@@ -109,33 +109,34 @@ public:
         lastIndependentVariable_ = currentIndependentVariable_;
         lastState_ = currentState_;
 
-        // Calculate k1-k4.
-        StateDerivativeType k1, k2, k3, k4;
+        // Calculate k1-k4 (stored in pre-allocated members).
         for ( unsigned int i = 1; i <= 4; i++ )
         {
             IndependentVariableType time;
-            StateType state;
             switch ( i )
             {
             case 1:
                 time = currentIndependentVariable_;
-                state = currentState_;
-                k1 = stepSize * this->stateDerivativeFunction_( time, state );
+                this->evaluateStateDerivative( time, currentState_, k1_ );
+                k1_ *= stepSize;
                 break;
             case 2:
                 time = currentIndependentVariable_ + stepSize / 2.0;
-                state = static_cast< StateType >( currentState_ + k1 / 2.0 );
-                k2 = stepSize * this->stateDerivativeFunction_( time, state );
+                intermediateState_ = currentState_ + k1_ / 2.0;
+                this->evaluateStateDerivative( time, intermediateState_, k2_ );
+                k2_ *= stepSize;
                 break;
             case 3:
                 time = currentIndependentVariable_ + stepSize / 2.0;
-                state = static_cast< StateType >( currentState_ + k2 / 2.0 );
-                k3 = stepSize * this->stateDerivativeFunction_( time, state );
+                intermediateState_ = currentState_ + k2_ / 2.0;
+                this->evaluateStateDerivative( time, intermediateState_, k3_ );
+                k3_ *= stepSize;
                 break;
             case 4:
                 time = currentIndependentVariable_ + stepSize;
-                state = static_cast< StateType >( currentState_ + k3 );
-                k4 = stepSize * this->stateDerivativeFunction_( time, state );
+                intermediateState_ = currentState_ + k3_;
+                this->evaluateStateDerivative( time, intermediateState_, k4_ );
+                k4_ *= stepSize;
                 break;
             }
 
@@ -151,7 +152,7 @@ public:
 
         stepSize_ = stepSize;
         currentIndependentVariable_ += stepSize_;
-        currentState_ += ( k1 + 2.0 * k2 + 2.0 * k3 + k4 ) / 6.0;
+        currentState_ += ( k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_ ) / 6.0;
 
         // Return the integration result.
         return currentState_;
@@ -234,6 +235,38 @@ public:
         }
     }
 
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator (current and previous state and independent variable, and
+     * step size) to a binary stream, see NumericalIntegrator::writeIntegratorState.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "RungeKutta4Integrator" );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "RungeKutta4Integrator" );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+    }
+
 protected:
 
     //! Last used step size.
@@ -266,6 +299,12 @@ protected:
      */
     StateType lastState_;
 
+    //! Intermediate state at which the state derivative is evaluated in the current step.
+    StateType intermediateState_;
+
+    //! Step size times the state derivative at the four stages of the current step (k1-k4).
+    StateDerivativeType k1_, k2_, k3_, k4_;
+
 };
 
 extern template class RungeKutta4Integrator < double, Eigen::VectorXd, Eigen::VectorXd >;
@@ -16,6 +16,7 @@
 #define TUDAT_RUNGE_KUTTA_COEFFICIENTS_H
 
 #include <memory>
+#include <vector>
 
 #include <Eigen/Core>
 
@@ -51,6 +52,16 @@ struct RungeKuttaCoefficients
     //! Order estimate to integrate.
     OrderEstimateToIntegrate orderEstimateToIntegrate;
 
+    //! Coefficients of the continuous extension (dense output) of the integrated order estimate.
+    /*!
+     * Coefficients of the continuous extension (dense output) of the integrated order estimate, with which the state at
+     * t_{0} + theta * h (with 0 <= theta <= 1) is computed from the stage derivatives k_{i} of an accepted step as
+     * y( t_{0} + theta * h ) = y_{0} + h * sum_{i} b_{i}( theta ) k_{i}, with
+     * b_{i}( theta ) = sum_{j} denseOutputCoefficients( i, j ) theta^{j + 1}. Empty if no dense output is
+     * available for the coefficient set.
+     */
+    Eigen::MatrixXd denseOutputCoefficients;
+
     //! Default constructor.
     /*!
      * Default constructor that initializes coefficients to 0.
@@ -61,7 +72,8 @@ struct RungeKuttaCoefficients
         cCoefficients( ),
         higherOrder( 0 ),
         lowerOrder( 0 ),
-        orderEstimateToIntegrate( lower )
+        orderEstimateToIntegrate( lower ),
+        denseOutputCoefficients( )
     { }
 
     //! Constructor.
@@ -86,7 +98,8 @@ struct RungeKuttaCoefficients
         cCoefficients( cCoefficients_ ),
         higherOrder( higherOrder_ ),
         lowerOrder( lowerOrder_ ),
-        orderEstimateToIntegrate( order )
+        orderEstimateToIntegrate( order ),
+        denseOutputCoefficients( )
     { }
 
     //! Enum of predefined coefficient sets.
@@ -96,7 +109,8 @@ struct RungeKuttaCoefficients
         rungeKuttaFehlberg45,
         rungeKuttaFehlberg56,
         rungeKuttaFehlberg78,
-        rungeKutta87DormandPrince
+        rungeKutta87DormandPrince,
+        rungeKutta54DormandPrince
     };
 
     //! Get coefficients for a specified coefficient set.
@@ -106,8 +120,33 @@ struct RungeKuttaCoefficients
      * \return The requested coefficient set.
      */
     static const RungeKuttaCoefficients& get( CoefficientSets coefficientSet );
+
+    //! Function to check whether a continuous extension (dense output) is available for this coefficient set.
+    /*!
+     * Function to check whether a continuous extension (dense output) is available for this coefficient set.
+     * \return True if dense output coefficients have been set.
+     */
+    bool isDenseOutputAvailable( ) const
+    {
+        return ( denseOutputCoefficients.rows( ) > 0 );
+    }
 };
 
+//! Function to compute the coefficients of the continuous extension (dense output) of a Runge-Kutta method.
+/*!
+ * Function to compute the coefficients of the continuous extension (dense output) of a Runge-Kutta method, and set
+ * them in the denseOutputCoefficients member of the coefficient set. The continuous extension is the polynomial
+ * u( theta ) (with u( 0 ) = y_{0}) that matches the integrated state at the end of the step (u( 1 ) = y_{1}), and
+ * of which the derivative matches the stage derivatives of the given stages (u'( c_{i} ) = h k_{i}). No additional
+ * state derivative evaluations are required to evaluate it. The degree of the polynomial is equal to the number of
+ * stages that are used, plus one. The stages should be chosen such that their stage derivatives are accurate approximations
+ * of the state derivative at t_{0} + c_{i} h, and their c-coefficients are distinct.
+ * \param coefficients Coefficient set for which the dense output coefficients are to be set (modified by reference).
+ * \param denseOutputStages Indices of the stages of which the derivatives are used by the continuous extension.
+ */
+void setDenseOutputCoefficients( RungeKuttaCoefficients& coefficients,
+                                 const std::vector< unsigned int >& denseOutputStages );
+
 //! Typedef for shared-pointer to RungeKuttaCoefficients object.
 typedef std::shared_ptr< RungeKuttaCoefficients > RungeKuttaCoefficientsPointer;
 
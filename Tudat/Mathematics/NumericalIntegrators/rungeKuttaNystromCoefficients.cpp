@@ -0,0 +1,143 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Dormand, J.R., El-Mikkawy, M.E.A., Prince, P.J. Families of Runge-Kutta-Nystrom formulae, IMA Journal of
+ *          Numerical Analysis, 7(2), 1987.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaNystromCoefficients.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+//! Initialize RKN6(4) coefficients.
+/*!
+ * Initialize the coefficients of the 6th-order formula of the RKN6(4)6FM pair of (Dormand et al., 1987), which has six
+ * stages, of which the last is evaluated at the end of the step (so that five accelerations are evaluated per
+ * step). The embedded 4th-order formula uses the same stages, with weights that satisfy the 4th-order conditions of
+ * the position and velocity (including the non-quadrature condition sum_{i} b_{i} sum_{j} a_{ij} c_{j} = 1/24).
+ */
+void initializeRungeKuttaNystrom64Coefficients( RungeKuttaNystromCoefficients& rungeKuttaNystrom64Coefficients )
+{
+    rungeKuttaNystrom64Coefficients.higherOrder = 6;
+    rungeKuttaNystrom64Coefficients.lowerOrder = 4;
+    rungeKuttaNystrom64Coefficients.isFirstSameAsLast = true;
+
+    rungeKuttaNystrom64Coefficients.aCoefficients = Eigen::MatrixXd::Zero( 6, 6 );
+    rungeKuttaNystrom64Coefficients.aCoefficients( 1, 0 ) = 1.0 / 200.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 2, 0 ) = -1.0 / 2200.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 2, 1 ) = 1.0 / 22.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 3, 0 ) = 637.0 / 6600.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 3, 1 ) = -7.0 / 110.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 3, 2 ) = 7.0 / 33.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 4, 0 ) = 225437.0 / 1968750.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 4, 1 ) = -30073.0 / 281250.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 4, 2 ) = 65569.0 / 281250.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 4, 3 ) = -9367.0 / 984375.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 5, 0 ) = 151.0 / 2142.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 5, 1 ) = 5.0 / 116.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 5, 2 ) = 385.0 / 1368.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 5, 3 ) = 55.0 / 168.0;
+    rungeKuttaNystrom64Coefficients.aCoefficients( 5, 4 ) = -6250.0 / 28101.0;
+
+    rungeKuttaNystrom64Coefficients.bPositionCoefficients = Eigen::MatrixXd::Zero( 2, 6 );
+    rungeKuttaNystrom64Coefficients.bPositionCoefficients( 0, 0 ) = 13.0 / 126.0;
+    rungeKuttaNystrom64Coefficients.bPositionCoefficients( 0, 2 ) = 5.0 / 18.0;
+    rungeKuttaNystrom64Coefficients.bPositionCoefficients( 0, 3 ) = 5.0 / 42.0;
+    rungeKuttaNystrom64Coefficients.bPositionCoefficients.block( 1, 0, 1, 5 ) =
+            rungeKuttaNystrom64Coefficients.aCoefficients.block( 5, 0, 1, 5 );
+
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients = Eigen::MatrixXd::Zero( 2, 6 );
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 0, 0 ) = 67.0 / 714.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 0, 2 ) = 25.0 / 57.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 0, 3 ) = 25.0 / 21.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 0, 4 ) = -3125.0 / 3876.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 0, 5 ) = 1.0 / 12.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 0 ) = 151.0 / 2142.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 1 ) = 25.0 / 522.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 2 ) = 275.0 / 684.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 3 ) = 275.0 / 252.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 4 ) = -78125.0 / 112404.0;
+    rungeKuttaNystrom64Coefficients.bVelocityCoefficients( 1, 5 ) = 1.0 / 12.0;
+
+    rungeKuttaNystrom64Coefficients.cCoefficients = Eigen::VectorXd::Zero( 6 );
+    rungeKuttaNystrom64Coefficients.cCoefficients( 1 ) = 1.0 / 10.0;
+    rungeKuttaNystrom64Coefficients.cCoefficients( 2 ) = 3.0 / 10.0;
+    rungeKuttaNystrom64Coefficients.cCoefficients( 3 ) = 7.0 / 10.0;
+    rungeKuttaNystrom64Coefficients.cCoefficients( 4 ) = 17.0 / 25.0;
+    rungeKuttaNystrom64Coefficients.cCoefficients( 5 ) = 1.0;
+
+    setRungeKuttaNystromStageVelocityCoefficients( rungeKuttaNystrom64Coefficients );
+}
+
+//! Function to compute the stage velocity coefficients of a Runge-Kutta-Nystrom method.
+void setRungeKuttaNystromStageVelocityCoefficients( RungeKuttaNystromCoefficients& coefficients )
+{
+    const int numberOfStages = coefficients.cCoefficients.rows( );
+    coefficients.stageVelocityCoefficients = Eigen::MatrixXd::Zero( numberOfStages, numberOfStages );
+
+    for( int stage = 1; stage < numberOfStages; stage++ )
+    {
+        // Require sum_{j} w_{j} c_{j}^{k} = c_{i}^{k+1} / ( k + 1 ) for k = 0, ..., i - 1.
+        Eigen::MatrixXd conditionMatrix( stage, stage );
+        Eigen::VectorXd conditionVector( stage );
+        for( int k = 0; k < stage; k++ )
+        {
+            for( int j = 0; j < stage; j++ )
+            {
+                conditionMatrix( k, j ) = std::pow( coefficients.cCoefficients( j ), k );
+            }
+            conditionVector( k ) = std::pow( coefficients.cCoefficients( stage ), k + 1 ) / static_cast< double >( k + 1 );
+        }
+
+        Eigen::FullPivLU< Eigen::MatrixXd > conditionMatrixDecomposition( conditionMatrix );
+        if( !conditionMatrixDecomposition.isInvertible( ) )
+        {
+            throw std::runtime_error( "Error when setting Runge-Kutta-Nystrom stage velocity coefficients, nodes are not "
+                                      "distinct." );
+        }
+        coefficients.stageVelocityCoefficients.block( stage, 0, 1, stage ) =
+                conditionMatrixDecomposition.solve( conditionVector ).transpose( );
+    }
+}
+
+//! Get coefficients for a specified coefficient set
+const RungeKuttaNystromCoefficients& RungeKuttaNystromCoefficients::get(
+        RungeKuttaNystromCoefficients::CoefficientSets coefficientSet )
+{
+    static RungeKuttaNystromCoefficients rungeKuttaNystrom64Coefficients;
+
+    switch ( coefficientSet )
+    {
+    case rungeKuttaNystrom64DormandElMikkawyPrince:
+        if ( rungeKuttaNystrom64Coefficients.higherOrder != 6 )
+        {
+            initializeRungeKuttaNystrom64Coefficients( rungeKuttaNystrom64Coefficients );
+        }
+        return rungeKuttaNystrom64Coefficients;
+
+    default:
+        throw std::runtime_error( "Error, Runge-Kutta-Nystrom coefficient set " + std::to_string( coefficientSet ) +
+                                  " not found." );
+    }
+}
+
+} // namespace numerical_integrators
+} // namespace tudat
@@ -0,0 +1,117 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Dormand, J.R., El-Mikkawy, M.E.A., Prince, P.J. Families of Runge-Kutta-Nystrom formulae, IMA Journal of
+ *          Numerical Analysis, 7(2), 1987.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition, Springer, 1993.
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_NYSTROM_COEFFICIENTS_H
+#define TUDAT_RUNGE_KUTTA_NYSTROM_COEFFICIENTS_H
+
+#include <memory>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+//! Struct that defines the coefficients of an embedded Runge-Kutta-Nystrom integrator
+/*!
+ * Struct that defines the coefficients of an embedded Runge-Kutta-Nystrom integrator, for second-order differential
+ * equations r'' = a( t, r ). With h the step size and k_{i} the accelerations at the stages, the stage positions, and
+ * the position and velocity at the end of the step are:
+ * r_{i} = r_{0} + c_{i} h v_{0} + h^2 sum_{j} aCoefficients( i, j ) k_{j},
+ * r_{1} = r_{0} + h v_{0} + h^2 sum_{i} bPositionCoefficients( o, i ) k_{i} and
+ * v_{1} = v_{0} + h sum_{i} bVelocityCoefficients( o, i ) k_{i},
+ * where o = 0 for the lower and o = 1 for the higher order estimate.
+ */
+struct RungeKuttaNystromCoefficients
+{
+    //! Stage position coefficients (strictly lower-triangular).
+    Eigen::MatrixXd aCoefficients;
+
+    //! Stage velocity coefficients (strictly lower-triangular).
+    /*!
+     * Stage velocity coefficients, with which the velocity at the stages is computed as
+     * v_{i} = v_{0} + h sum_{j} stageVelocityCoefficients( i, j ) k_{j}. The stage velocities are only used if the
+     * acceleration depends on the velocity. The coefficients of each stage are those of the interpolatory quadrature
+     * rule over the nodes of the preceding stages (see setRungeKuttaNystromStageVelocityCoefficients).
+     */
+    Eigen::MatrixXd stageVelocityCoefficients;
+
+    //! Weights of the position rows (first row: lower order, second row: higher order estimate).
+    Eigen::MatrixXd bPositionCoefficients;
+
+    //! Weights of the velocity rows (first row: lower order, second row: higher order estimate).
+    Eigen::MatrixXd bVelocityCoefficients;
+
+    //! Nodes of the stages, as fraction of the step.
+    Eigen::VectorXd cCoefficients;
+
+    //! Order of the higher order estimate.
+    unsigned int higherOrder;
+
+    //! Order of the lower order estimate.
+    unsigned int lowerOrder;
+
+    //! Boolean denoting whether the last stage is evaluated at the (higher order) state at the end of the step.
+    /*!
+     * Boolean denoting whether the last stage is evaluated at the (higher order) position at the end of the step (First
+     * Same As Last), so that its acceleration can be re-used as the acceleration of the first stage of the next step.
+     */
+    bool isFirstSameAsLast;
+
+    //! Default constructor.
+    /*!
+     * Default constructor that initializes coefficients to 0.
+     */
+    RungeKuttaNystromCoefficients( ) :
+        higherOrder( 0 ),
+        lowerOrder( 0 ),
+        isFirstSameAsLast( false )
+    { }
+
+    //! Enum of predefined coefficient sets.
+    enum CoefficientSets
+    {
+        undefinedCoefficientSet = -1,
+        rungeKuttaNystrom64DormandElMikkawyPrince
+    };
+
+    //! Get coefficients for a specified coefficient set.
+    /*!
+     * Returns coefficients for a specified coefficient set.
+     * \param coefficientSet The set to get the coefficients for.
+     * \return The requested coefficient set.
+     */
+    static const RungeKuttaNystromCoefficients& get( CoefficientSets coefficientSet );
+};
+
+//! Function to compute the stage velocity coefficients of a Runge-Kutta-Nystrom method.
+/*!
+ * Function to compute the stage velocity coefficients of a Runge-Kutta-Nystrom method, and set them in the
+ * stageVelocityCoefficients member of the coefficient set. The coefficients of stage i are the weights of the
+ * interpolatory quadrature rule over the nodes c_{0}, ..., c_{i-1}, i.e. the velocity at stage i is exact for
+ * accelerations that are polynomials of degree i - 1 in time. The nodes must be distinct.
+ * \param coefficients Coefficient set for which the stage velocity coefficients are to be set (modified by reference).
+ */
+void setRungeKuttaNystromStageVelocityCoefficients( RungeKuttaNystromCoefficients& coefficients );
+
+//! Typedef for shared-pointer to RungeKuttaNystromCoefficients object.
+typedef std::shared_ptr< RungeKuttaNystromCoefficients > RungeKuttaNystromCoefficientsPointer;
+
+} // namespace numerical_integrators
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_NYSTROM_COEFFICIENTS_H
@@ -0,0 +1,26 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaNystromIntegrator.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+template class RungeKuttaNystromIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
+template class RungeKuttaNystromIntegrator < double, Eigen::Vector6d, Eigen::Vector6d >;
+template class RungeKuttaNystromIntegrator < double, Eigen::MatrixXd, Eigen::MatrixXd >;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
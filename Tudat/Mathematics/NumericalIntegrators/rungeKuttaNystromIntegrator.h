@@ -0,0 +1,629 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Dormand, J.R., El-Mikkawy, M.E.A., Prince, P.J. Families of Runge-Kutta-Nystrom formulae, IMA Journal of
+ *          Numerical Analysis, 7(2), 1987.
+ *      Montenbruck, O. and Gill, E., Satellite Orbits, Springer, 2000.
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_NYSTROM_INTEGRATOR_H
+#define TUDAT_RUNGE_KUTTA_NYSTROM_INTEGRATOR_H
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaNystromCoefficients.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Embedded Runge-Kutta-Nystrom integrator, with variable step size.
+/*!
+ * Class that implements an embedded Runge-Kutta-Nystrom integrator, which integrates the second-order (translational)
+ * equations of motion directly, using only the accelerations. Compared to a Runge-Kutta integrator applied to the
+ * equivalent first-order system, only the accelerations are carried through the stages, and fewer stages are needed
+ * for the same order. The state must be in the Cartesian (Cowell) layout: it consists of blocks of six rows, in which
+ * the first three rows are the position(-like) rows and the last three the velocity(-like) rows, of which the
+ * derivatives are the velocity rows and acceleration rows, respectively (e.g. the Cartesian states of one or more
+ * bodies, or the associated state transition matrix). Only the acceleration rows of the state derivative are used.
+ * The higher order estimate is integrated, and the difference w.r.t. the lower order estimate (in both position and
+ * velocity) is used to control the step size, as in RungeKuttaVariableStepSizeIntegrator.
+ * The method is designed for accelerations that do not depend on the velocity. If they do (e.g. for aerodynamic
+ * accelerations), the velocity at each stage is approximated by a quadrature over the preceding stages (see
+ * RungeKuttaNystromCoefficients::stageVelocityCoefficients), which reduces the order of the method. For coefficient sets
+ * of which the last stage is evaluated at the end of the step, its acceleration is only re-used as the first stage of
+ * the next step if the accelerations are explicitly specified to be velocity-independent, since the velocity of the last
+ * stage differs from the velocity at the end of the step.
+ * \tparam IndependentVariableType The type of the independent variable.
+ * \tparam StateType The type of the state.
+ * \tparam StateDerivativeType The type of the state derivative.
+ * \tparam TimeStepType The type of the time step.
+ * \sa NumericalIntegrator.
+ */
+template< typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename StateDerivativeType = Eigen::VectorXd, typename TimeStepType = IndependentVariableType >
+class RungeKuttaNystromIntegrator
+        : public ReinitializableNumericalIntegrator<
+        IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+{
+public:
+
+    //! Typedef for the base class.
+    /*!
+     * Typedef of the base class with all template parameters filled in.
+     */
+    typedef ReinitializableNumericalIntegrator< IndependentVariableType, StateType,
+    StateDerivativeType, TimeStepType > ReinitializableNumericalIntegratorBase;
+
+    //! Typedef for the state derivative function.
+    /*!
+     * Typedef to the state derivative function inherited from the base class.
+     * \sa NumericalIntegrator::StateDerivativeFunction.
+     */
+    typedef typename ReinitializableNumericalIntegratorBase::NumericalIntegratorBase::
+    StateDerivativeFunction StateDerivativeFunction;
+
+    //! Typedef for the scalar type of the state.
+    typedef typename StateType::Scalar StateScalarType;
+
+    //! Typedef for the position, velocity and acceleration rows of the state (or state derivative).
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > SecondOrderStateType;
+
+    //! Constructor.
+    /*!
+     * Constructor, taking coefficients, a state derivative function, initial conditions, minimum & maximum step size
+     * and relative & absolute error tolerance for all elements of the state as argument.
+     * \param coefficients Coefficients to use with this integrator.
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state (number of rows must be a multiple of six).
+     * \param minimumStepSize The minimum step size to take. If the step size needs to be reduced below this value to
+     *          meet the tolerances, an exception is thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, for each individual position and velocity element.
+     * \param absoluteErrorTolerance The absolute error tolerance, for each individual position and velocity element.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Maximum factor decrease for next step size.
+     * \param areAccelerationsVelocityIndependent Boolean denoting whether the accelerations are independent of the
+     *          velocity, in which case the acceleration of the last stage may be re-used as the first stage of the next
+     *          step (for coefficient sets of which the last stage is evaluated at the end of the step).
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    RungeKuttaNystromIntegrator(
+            const RungeKuttaNystromCoefficients& coefficients,
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const TimeStepType minimumStepSize,
+            const TimeStepType maximumStepSize,
+            const StateScalarType relativeErrorTolerance,
+            const StateScalarType absoluteErrorTolerance,
+            const TimeStepType safetyFactorForNextStepSize = 0.8,
+            const TimeStepType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeStepType minimumFactorDecreaseForNextStepSize = 0.1,
+            const bool areAccelerationsVelocityIndependent = false ) :
+        ReinitializableNumericalIntegratorBase( stateDerivativeFunction ),
+        coefficients_( coefficients ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
+        stepSize_( TUDAT_NAN ),
+        useStepSizeControl_( true ),
+        minimumStepSize_( std::fabs( minimumStepSize ) ),
+        maximumStepSize_( std::fabs( maximumStepSize ) ),
+        relativeErrorTolerance_( std::fabs( relativeErrorTolerance ) ),
+        absoluteErrorTolerance_( std::fabs( absoluteErrorTolerance ) ),
+        safetyFactorForNextStepSize_( std::fabs( safetyFactorForNextStepSize ) ),
+        maximumFactorIncreaseForNextStepSize_( std::fabs( maximumFactorIncreaseForNextStepSize ) ),
+        minimumFactorDecreaseForNextStepSize_( std::fabs( minimumFactorDecreaseForNextStepSize ) ),
+        reuseLastStageAcceleration_( coefficients.isFirstSameAsLast && areAccelerationsVelocityIndependent ),
+        isFirstStageAccelerationAvailable_( false ),
+        numberOfAccelerationEvaluations_( 0 )
+    {
+        if( currentState_.rows( ) % 6 != 0 || currentState_.rows( ) == 0 )
+        {
+            throw std::runtime_error( "Error in Runge-Kutta-Nystrom integrator, the number of rows of the state (" +
+                                      std::to_string( currentState_.rows( ) ) + ") is not a multiple of six." );
+        }
+        numberOfBlocks_ = currentState_.rows( ) / 6;
+        stageAccelerations_.resize( coefficients_.cCoefficients.rows( ) );
+    }
+
+    //! Get step size of the next step.
+    /*!
+     * Returns the step size of the next step.
+     * \return Step size to be used for the next step.
+     */
+    TimeStepType getNextStepSize( ) const { return stepSize_; }
+
+    //! Get current state.
+    /*!
+     * Returns the current state of the integrator.
+     * \return Current integrated state.
+     */
+    StateType getCurrentState( ) const { return currentState_; }
+
+    //! Returns the current independent variable.
+    /*!
+     * Returns the current value of the independent variable of the integrator.
+     * \return Current independent variable.
+     */
+    IndependentVariableType getCurrentIndependentVariable( ) const { return currentIndependentVariable_; }
+
+    //! Get previous independent variable.
+    /*!
+     * Returns the previous value of the independent variable of the integrator.
+     * \return Previous independent variable.
+     */
+    IndependentVariableType getPreviousIndependentVariable( ) { return lastIndependentVariable_; }
+
+    //! Get previous state value.
+    /*!
+     * Returns the previous value of the state.
+     * \return Previous state.
+     */
+    StateType getPreviousState( ) { return lastState_; }
+
+    //! Perform a single integration step.
+    /*!
+     * Perform a single integration step. If step size control is used, and the estimated error exceeds the
+     * tolerances, the step is repeated with the reduced step size, so that the step actually taken may be smaller than
+     * stepSize. The step size for the next step is computed from the estimated error of the accepted step.
+     * \param stepSize The step size to take.
+     * \return The state at the end of the step.
+     */
+    StateType performIntegrationStep( const TimeStepType stepSize )
+    {
+        getSecondOrderState( currentState_, 0, positions_ );
+        getSecondOrderState( currentState_, 3, velocities_ );
+        intermediateState_ = currentState_;
+
+        // Evaluate acceleration at the start of the step, unless available from the last stage of the previous step
+        if( !isFirstStageAccelerationAvailable_ )
+        {
+            computeAcceleration( currentIndependentVariable_, currentState_, stageAccelerations_[ 0 ] );
+        }
+        else
+        {
+            stageAccelerations_[ 0 ] = firstStageAcceleration_;
+        }
+
+        // Perform the step, and repeat it with the step size computed by the step size control until it is accepted
+        TimeStepType currentStepSize = stepSize;
+        while( true )
+        {
+            const StateScalarType scalarStepSize = static_cast< StateScalarType >( currentStepSize );
+
+            // Compute the accelerations per stage
+            for( int stage = 1; stage < coefficients_.cCoefficients.rows( ); stage++ )
+            {
+                const StateScalarType stageNode = static_cast< StateScalarType >( coefficients_.cCoefficients( stage ) );
+                stagePositions_ = positions_ + ( stageNode * scalarStepSize ) * velocities_;
+                stageVelocities_ = velocities_;
+                for( int column = 0; column < stage; column++ )
+                {
+                    stagePositions_ += ( scalarStepSize * scalarStepSize * static_cast< StateScalarType >(
+                                             coefficients_.aCoefficients( stage, column ) ) ) *
+                            stageAccelerations_[ column ];
+                    stageVelocities_ += ( scalarStepSize * static_cast< StateScalarType >(
+                                              coefficients_.stageVelocityCoefficients( stage, column ) ) ) *
+                            stageAccelerations_[ column ];
+                }
+                setState( stagePositions_, stageVelocities_, intermediateState_ );
+
+                const IndependentVariableType time = currentIndependentVariable_ +
+                        coefficients_.cCoefficients( stage ) * currentStepSize;
+                computeAcceleration( time, intermediateState_, stageAccelerations_[ stage ] );
+
+                // Check if propagation should terminate because the propagation termination condition has been
+                // reached while computing the intermediate state. If so, return the current state, which will be
+                // discarded.
+                if( this->propagationTerminationFunction_( static_cast< double >( time ), TUDAT_NAN ) )
+                {
+                    this->propagationTerminationConditionReachedDuringStep_ = true;
+                    return currentState_;
+                }
+            }
+
+            // Compute lower and higher order estimates
+            higherOrderPositions_ = positions_ + scalarStepSize * velocities_;
+            higherOrderVelocities_ = velocities_;
+            lowerOrderPositions_ = higherOrderPositions_;
+            lowerOrderVelocities_ = velocities_;
+            for( int stage = 0; stage < coefficients_.cCoefficients.rows( ); stage++ )
+            {
+                addWeightedAcceleration( scalarStepSize * scalarStepSize, coefficients_.bPositionCoefficients( 1, stage ),
+                                         stage, higherOrderPositions_ );
+                addWeightedAcceleration( scalarStepSize * scalarStepSize, coefficients_.bPositionCoefficients( 0, stage ),
+                                         stage, lowerOrderPositions_ );
+                addWeightedAcceleration( scalarStepSize, coefficients_.bVelocityCoefficients( 1, stage ),
+                                         stage, higherOrderVelocities_ );
+                addWeightedAcceleration( scalarStepSize, coefficients_.bVelocityCoefficients( 0, stage ),
+                                         stage, lowerOrderVelocities_ );
+            }
+
+            if( computeNextStepSizeAndValidateResult( currentStepSize ) )
+            {
+                break;
+            }
+
+            // Reject current step, and retry with new step size
+            currentStepSize = stepSize_;
+        }
+
+        // Accept the current step
+        lastIndependentVariable_ = currentIndependentVariable_;
+        lastState_ = currentState_;
+        currentIndependentVariable_ += currentStepSize;
+        setState( higherOrderPositions_, higherOrderVelocities_, currentState_ );
+
+        isFirstStageAccelerationAvailable_ = reuseLastStageAcceleration_;
+        if( isFirstStageAccelerationAvailable_ )
+        {
+            firstStageAcceleration_ = stageAccelerations_.back( );
+        }
+
+        return currentState_;
+    }
+
+    //! Rollback internal state to the last state.
+    /*!
+     * Performs rollback of internal state to the last state. This function can only be called once after calling
+     * integrateTo() or performIntegrationStep() unless specified otherwise by implementations, and can not be called
+     * before any of these functions have been called. Will return true if the rollback was successful, and false
+     * otherwise.
+     * \return True if the rollback was successful.
+     */
+    bool rollbackToPreviousState( )
+    {
+        if( currentIndependentVariable_ == lastIndependentVariable_ )
+        {
+            return false;
+        }
+
+        currentIndependentVariable_ = lastIndependentVariable_;
+        currentState_ = lastState_;
+        isFirstStageAccelerationAvailable_ = false;
+        return true;
+    }
+
+    //! Replace the state with a new value.
+    /*!
+     * Replace the state with a new value. This allows for discrete jumps in the state, often used in simulations of
+     * discrete events. If the new state differs from the current state, the acceleration of the last stage is not
+     * re-used in the next step.
+     * \param newState The value of the new state.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentState( const StateType& newState, const bool allowRollback = false )
+    {
+        if( newState != currentState_ )
+        {
+            currentState_ = newState;
+            isFirstStageAccelerationAvailable_ = false;
+        }
+
+        if( !allowRollback )
+        {
+            lastIndependentVariable_ = currentIndependentVariable_;
+        }
+    }
+
+    //! Modify the state and time for the current step.
+    /*!
+     * Modify the state and time for the current step. The acceleration of the last stage is not re-used in the next
+     * step.
+     * \param newState The new state to set the current state to.
+     * \param newTime The time to set the current time to.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentIntegrationVariables( const StateType& newState, const IndependentVariableType newTime,
+                                            const bool allowRollback = false )
+    {
+        currentState_ = newState;
+        currentIndependentVariable_ = newTime;
+        isFirstStageAccelerationAvailable_ = false;
+
+        if( !allowRollback )
+        {
+            lastIndependentVariable_ = currentIndependentVariable_;
+        }
+    }
+
+    //! Function to toggle the use of step-size control
+    /*!
+     * Function to toggle the use of step-size control
+     * \param useStepSizeControl Boolean denoting whether step size control is to be used
+     */
+    void setStepSizeControl( const bool useStepSizeControl )
+    {
+        useStepSizeControl_ = useStepSizeControl;
+    }
+
+    //! Function to retrieve the number of evaluations of the state derivative function.
+    /*!
+     * Function to retrieve the number of evaluations of the state derivative function performed so far (including those
+     * of rejected steps).
+     * \return Number of evaluations of the state derivative function.
+     */
+    unsigned int getNumberOfAccelerationEvaluations( ) const { return numberOfAccelerationEvaluations_; }
+
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator (current and previous state and independent variable, step
+     * size, and the acceleration to be re-used as first stage of the next step) to a binary stream, see
+     * NumericalIntegrator::writeIntegratorState.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "RungeKuttaNystromIntegrator" );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+        serialization::writeBinaryValue( stream, useStepSizeControl_ );
+        serialization::writeBinaryValue( stream, numberOfAccelerationEvaluations_ );
+        serialization::writeBinaryValue( stream, isFirstStageAccelerationAvailable_ );
+        serialization::writeBinaryValue( stream, firstStageAcceleration_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "RungeKuttaNystromIntegrator" );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+        serialization::readBinaryValue( stream, useStepSizeControl_ );
+        serialization::readBinaryValue( stream, numberOfAccelerationEvaluations_ );
+        serialization::readBinaryValue( stream, isFirstStageAccelerationAvailable_ );
+        serialization::readBinaryValue( stream, firstStageAcceleration_ );
+    }
+
+protected:
+
+    //! Function to retrieve the position or velocity rows from a state.
+    /*!
+     * Function to retrieve the position (or velocity) rows from a state (or the velocity (or acceleration) rows from
+     * a state derivative).
+     * \param state State from which the rows are to be retrieved.
+     * \param rowOffset Offset w.r.t. the start of each block of six rows (0 for position, 3 for velocity rows).
+     * \param secondOrderState Position or velocity rows (returned by reference).
+     */
+    template< typename InputType >
+    void getSecondOrderState( const InputType& state, const int rowOffset, SecondOrderStateType& secondOrderState ) const
+    {
+        secondOrderState.resize( 3 * numberOfBlocks_, state.cols( ) );
+        for( int i = 0; i < numberOfBlocks_; i++ )
+        {
+            secondOrderState.block( 3 * i, 0, 3, state.cols( ) ) = state.block( 6 * i + rowOffset, 0, 3, state.cols( ) );
+        }
+    }
+
+    //! Function to set the state from given position and velocity rows.
+    /*!
+     * Function to set the state from given position and velocity rows.
+     * \param positions Position rows.
+     * \param velocities Velocity rows.
+     * \param state State (returned by reference, must already have the correct size).
+     */
+    void setState( const SecondOrderStateType& positions, const SecondOrderStateType& velocities, StateType& state ) const
+    {
+        for( int i = 0; i < numberOfBlocks_; i++ )
+        {
+            state.block( 6 * i, 0, 3, state.cols( ) ) = positions.block( 3 * i, 0, 3, state.cols( ) );
+            state.block( 6 * i + 3, 0, 3, state.cols( ) ) = velocities.block( 3 * i, 0, 3, state.cols( ) );
+        }
+    }
+
+    //! Function to compute the acceleration at a given state.
+    /*!
+     * Function to compute the acceleration rows of the state derivative at a given state.
+     * \param independentVariable Independent variable at which the state derivative is to be evaluated.
+     * \param state State at which the state derivative is to be evaluated.
+     * \param acceleration Acceleration rows of the state derivative (returned by reference).
+     */
+    void computeAcceleration( const IndependentVariableType independentVariable, const StateType& state,
+                              SecondOrderStateType& acceleration )
+    {
+        this->evaluateStateDerivative( independentVariable, state, stateDerivative_ );
+        getSecondOrderState( stateDerivative_, 3, acceleration );
+        numberOfAccelerationEvaluations_++;
+    }
+
+    //! Function to add a weighted stage acceleration to an estimate (if the weight is non-zero).
+    /*!
+     * Function to add a weighted stage acceleration to an estimate of the position or velocity (if the weight is
+     * non-zero).
+     * \param stepSizeFactor Power of the step size with which the stage acceleration is multiplied.
+     * \param weight Weight of the stage.
+     * \param stage Index of the stage.
+     * \param estimate Estimate to which the weighted acceleration is added (modified by reference).
+     */
+    void addWeightedAcceleration( const StateScalarType stepSizeFactor, const double weight, const int stage,
+                                  SecondOrderStateType& estimate ) const
+    {
+        if( weight != 0.0 )
+        {
+            estimate += ( stepSizeFactor * static_cast< StateScalarType >( weight ) ) * stageAccelerations_[ stage ];
+        }
+    }
+
+    //! Compute the next step size and validate the result.
+    /*!
+     * Computes the next step size from the difference between the higher and lower order estimates of the position and
+     * velocity, and determines whether the error is within the tolerances. The new step size is computed as in
+     * RungeKuttaVariableStepSizeIntegrator, with the exponent based on the order of the local error of the lower order
+     * estimate.
+     * \param stepSize The step size used to obtain the estimates.
+     * \return True if the error was within bounds, false otherwise.
+     */
+    bool computeNextStepSizeAndValidateResult( const TimeStepType stepSize )
+    {
+        if( !useStepSizeControl_ )
+        {
+            stepSize_ = stepSize;
+            return true;
+        }
+
+        // Compute the largest ratio of truncation error (difference between higher and lower order estimate) and
+        // tolerance, evaluated coefficient-wise.
+        const StateScalarType maximumErrorInState = std::max(
+                    ( ( higherOrderPositions_ - lowerOrderPositions_ ).array( ).abs( ) /
+                      ( higherOrderPositions_.array( ).abs( ) * relativeErrorTolerance_ + absoluteErrorTolerance_ ) ).maxCoeff( ),
+                    ( ( higherOrderVelocities_ - lowerOrderVelocities_ ).array( ).abs( ) /
+                      ( higherOrderVelocities_.array( ).abs( ) * relativeErrorTolerance_ + absoluteErrorTolerance_ ) ).maxCoeff( ) );
+
+        if( std::isnan( maximumErrorInState ) )
+        {
+            throw std::runtime_error( "Error in Runge-Kutta-Nystrom integrator, estimated error is NaN." );
+        }
+
+        // Compute new step size (Montenbruck and Gill, 2000), limited by the maximum factors of increase and decrease
+        TimeStepType stepSizeFactor = safetyFactorForNextStepSize_ * static_cast< TimeStepType >(
+                    std::pow( static_cast< StateScalarType >( 1.0 ) / maximumErrorInState,
+                              static_cast< StateScalarType >( 1.0 ) /
+                              static_cast< StateScalarType >( coefficients_.lowerOrder + 1 ) ) );
+        if( !( stepSizeFactor <= maximumFactorIncreaseForNextStepSize_ ) )
+        {
+            stepSizeFactor = maximumFactorIncreaseForNextStepSize_;
+        }
+        else if( stepSizeFactor < minimumFactorDecreaseForNextStepSize_ )
+        {
+            stepSizeFactor = minimumFactorDecreaseForNextStepSize_;
+        }
+        stepSize_ = stepSizeFactor * stepSize;
+
+        // Check minimum and maximum step size
+        if( std::fabs( stepSize_ ) < minimumStepSize_ )
+        {
+            throw std::runtime_error( "Error in Runge-Kutta-Nystrom integrator, minimum step size exceeded." );
+        }
+        else if( std::fabs( stepSize_ ) > maximumStepSize_ )
+        {
+            stepSize_ = ( stepSize < 0.0 ? -1.0 : 1.0 ) * maximumStepSize_;
+        }
+
+        return ( maximumErrorInState <= 1.0 );
+    }
+
+    //! Coefficients for the integrator.
+    RungeKuttaNystromCoefficients coefficients_;
+
+    //! Current independent variable.
+    IndependentVariableType currentIndependentVariable_;
+
+    //! Current state.
+    StateType currentState_;
+
+    //! Last independent variable.
+    IndependentVariableType lastIndependentVariable_;
+
+    //! Last state.
+    StateType lastState_;
+
+    //! Step size to be used for the next step.
+    TimeStepType stepSize_;
+
+    //! Boolean denoting whether step size control is to be used.
+    bool useStepSizeControl_;
+
+    //! Minimum step size.
+    TimeStepType minimumStepSize_;
+
+    //! Maximum step size.
+    TimeStepType maximumStepSize_;
+
+    //! Relative error tolerance.
+    StateScalarType relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    StateScalarType absoluteErrorTolerance_;
+
+    //! Safety factor for next step size.
+    TimeStepType safetyFactorForNextStepSize_;
+
+    //! Maximum factor increase for next step size.
+    TimeStepType maximumFactorIncreaseForNextStepSize_;
+
+    //! Minimum factor decrease for next step size.
+    TimeStepType minimumFactorDecreaseForNextStepSize_;
+
+    //! Number of blocks of six rows in the state.
+    int numberOfBlocks_;
+
+    //! Boolean denoting whether the acceleration of the last stage is re-used as the first stage of the next step.
+    /*!
+     * Boolean denoting whether the acceleration of the last stage is re-used as the first stage of the next step, which
+     * is only the case if the last stage is evaluated at the end of the step, and the accelerations are
+     * velocity-independent.
+     */
+    bool reuseLastStageAcceleration_;
+
+    //! Boolean denoting whether the acceleration at the current state is available from the last stage of the last step.
+    bool isFirstStageAccelerationAvailable_;
+
+    //! Acceleration at the current state, from the last stage of the last step.
+    SecondOrderStateType firstStageAcceleration_;
+
+    //! Number of evaluations of the state derivative function.
+    unsigned int numberOfAccelerationEvaluations_;
+
+    //! Accelerations at the stages of the current step.
+    std::vector< SecondOrderStateType > stageAccelerations_;
+
+    //! Pre-allocated state derivative.
+    StateDerivativeType stateDerivative_;
+
+    //! Pre-allocated state at which the state derivative is evaluated in the current stage.
+    StateType intermediateState_;
+
+    //! Pre-allocated position and velocity rows, used during a step.
+    SecondOrderStateType positions_, velocities_, stagePositions_, stageVelocities_,
+    lowerOrderPositions_, lowerOrderVelocities_, higherOrderPositions_, higherOrderVelocities_;
+
+};
+
+extern template class RungeKuttaNystromIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
+extern template class RungeKuttaNystromIntegrator < double, Eigen::Vector6d, Eigen::Vector6d >;
+extern template class RungeKuttaNystromIntegrator < double, Eigen::MatrixXd, Eigen::MatrixXd >;
+
+//! Typedef of Runge-Kutta-Nystrom integrator (state/state derivative = VectorXd, independent variable = double).
+typedef RungeKuttaNystromIntegrator< > RungeKuttaNystromIntegratorXd;
+
+//! Typedef of pointer to default Runge-Kutta-Nystrom integrator.
+typedef std::shared_ptr< RungeKuttaNystromIntegratorXd > RungeKuttaNystromIntegratorXdPointer;
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_NYSTROM_INTEGRATOR_H
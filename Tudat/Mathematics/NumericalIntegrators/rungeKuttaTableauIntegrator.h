@@ -0,0 +1,376 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition,
+ *          Springer, 1993.
+ *
+ */
+
+#ifndef TUDAT_RUNGE_KUTTA_TABLEAU_INTEGRATOR_H
+#define TUDAT_RUNGE_KUTTA_TABLEAU_INTEGRATOR_H
+
+#include <memory>
+#include <utility>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaTableaux.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Class that implements the Runge-Kutta variable step size integrator for a Butcher tableau known at compile time.
+/*!
+ * Class that implements the Runge-Kutta variable step size integrator for a Butcher tableau known at compile time
+ * (see rungeKuttaTableaux.h). Compared to the base class, which uses a coefficient set defined at run time, the
+ * integration step loops over the stages with bounds known at compile time, and the zero entries of the tableau are
+ * skipped. The stage derivatives are allocated once, and are only re-sized on the first step (for dynamic-size state
+ * types). When a step is rejected, the first stage is not re-evaluated (it does not depend on the step size), and for
+ * tableaux with the first same as last (FSAL) property (e.g. RungeKutta54DormandPrinceTableau), the last stage of an
+ * accepted step is re-used as the first stage of the next step, saving one state derivative evaluation per step.
+ * Step size control and dense output are inherited from the base class, and produce results identical to those
+ * obtained with the base class for the same coefficient set.
+ *
+ * Re-using the last stage requires the state derivative to depend only on the independent variable and state. It is
+ * discarded whenever the integrator state is modified or rolled back.
+ * \tparam TableauType Compile-time Butcher tableau (e.g. RungeKuttaFehlberg78Tableau).
+ * \tparam IndependentVariableType The type of the independent variable.
+ * \tparam StateType The type of the state. This type should be an Eigen::Matrix derived type.
+ * \tparam StateDerivativeType The type of the state derivative. This type should be an Eigen::Matrix derived type.
+ * \tparam TimeStepType The type of the time step.
+ */
+template< typename TableauType, typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+          typename StateDerivativeType = StateType, typename TimeStepType = IndependentVariableType >
+class RungeKuttaTableauIntegrator :
+        public RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+{
+public:
+
+    //! Typedef of the base class.
+    typedef RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+    RungeKuttaVariableStepSizeIntegratorBase;
+
+    //! Typedef to the state derivative function.
+    typedef typename RungeKuttaVariableStepSizeIntegratorBase::StateDerivativeFunction StateDerivativeFunction;
+
+    //! Typedef to the function used to compute the new step size.
+    typedef typename RungeKuttaVariableStepSizeIntegratorBase::NewStepSizeFunction NewStepSizeFunction;
+
+    //! Constructor with tolerances per element of the state.
+    /*!
+     * Constructor with relative and absolute error tolerances per element of the state. The input is identical to that
+     * of the corresponding RungeKuttaVariableStepSizeIntegrator constructor, without the coefficient set.
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state.
+     * \param minimumStepSize The minimum step size to take.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, for each individual state vector element.
+     * \param absoluteErrorTolerance The absolute error tolerance, for each individual state vector element.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Maximum factor decrease for next step size.
+     * \param newStepSizeFunction Function that returns the new step size computed (default computeNewStepSize).
+     */
+    RungeKuttaTableauIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const IndependentVariableType minimumStepSize,
+            const IndependentVariableType maximumStepSize,
+            const StateType& relativeErrorTolerance,
+            const StateType& absoluteErrorTolerance,
+            const TimeStepType safetyFactorForNextStepSize = 0.8,
+            const TimeStepType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeStepType minimumFactorDecreaseForNextStepSize = 0.1,
+            const NewStepSizeFunction& newStepSizeFunction = 0 ) :
+        RungeKuttaVariableStepSizeIntegratorBase(
+            RungeKuttaCoefficients::get( TableauType::coefficientSet ), stateDerivativeFunction, intervalStart,
+            initialState, minimumStepSize, maximumStepSize, relativeErrorTolerance, absoluteErrorTolerance,
+            safetyFactorForNextStepSize, maximumFactorIncreaseForNextStepSize, minimumFactorDecreaseForNextStepSize,
+            newStepSizeFunction ),
+        isFirstSameAsLast_( isTableauFirstSameAsLast< TableauType >( ) ),
+        isFirstStageDerivativeAvailable_( false ), isLastStageDerivativeReusable_( false )
+    {
+        this->currentStateDerivatives_.resize( TableauType::numberOfStages );
+    }
+
+    //! Constructor with tolerances equal for all elements of the state.
+    /*!
+     * Constructor with relative and absolute error tolerances equal for all elements of the state. The input is
+     * identical to that of the corresponding RungeKuttaVariableStepSizeIntegrator constructor, without the
+     * coefficient set.
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state.
+     * \param minimumStepSize The minimum step size to take.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, equal for all individual state vector elements.
+     * \param absoluteErrorTolerance The absolute error tolerance, equal for all individual state vector elements.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Maximum factor decrease for next step size.
+     * \param newStepSizeFunction Function that returns the new step size computed (default computeNewStepSize).
+     */
+    RungeKuttaTableauIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const TimeStepType minimumStepSize,
+            const TimeStepType maximumStepSize,
+            const typename StateType::Scalar relativeErrorTolerance,
+            const typename StateType::Scalar absoluteErrorTolerance,
+            const TimeStepType safetyFactorForNextStepSize = 0.8,
+            const TimeStepType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeStepType minimumFactorDecreaseForNextStepSize = 0.1,
+            const NewStepSizeFunction& newStepSizeFunction = 0 ) :
+        RungeKuttaVariableStepSizeIntegratorBase(
+            RungeKuttaCoefficients::get( TableauType::coefficientSet ), stateDerivativeFunction, intervalStart,
+            initialState, minimumStepSize, maximumStepSize, relativeErrorTolerance, absoluteErrorTolerance,
+            safetyFactorForNextStepSize, maximumFactorIncreaseForNextStepSize, minimumFactorDecreaseForNextStepSize,
+            newStepSizeFunction ),
+        isFirstSameAsLast_( isTableauFirstSameAsLast< TableauType >( ) ),
+        isFirstStageDerivativeAvailable_( false ), isLastStageDerivativeReusable_( false )
+    {
+        this->currentStateDerivatives_.resize( TableauType::numberOfStages );
+    }
+
+    //! Perform a single integration step.
+    /*!
+     * Perform a single integration step and compute a new step size.
+     * \param stepSize The step size to take. If the time step is too large to satisfy the error
+     *          constraints, the step is redone until the error constraint is satisfied.
+     * \return The state at the end of the interval.
+     */
+    StateType performIntegrationStep( const TimeStepType stepSize );
+
+    //! Rollback internal state to the last state.
+    /*!
+     * Performs rollback of the internal state to the last state (see base class), and discards the re-usable stage
+     * derivatives.
+     * \return True if the rollback was successful.
+     */
+    bool rollbackToPreviousState( )
+    {
+        resetReusableStageDerivatives( );
+        return RungeKuttaVariableStepSizeIntegratorBase::rollbackToPreviousState( );
+    }
+
+    //! Replace the state with a new value.
+    /*!
+     * Replace the state with a new value (see base class), and discards the re-usable stage derivatives.
+     * \param newState The value of the new state.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentState( const StateType& newState, const bool allowRollback = false )
+    {
+        resetReusableStageDerivatives( );
+        RungeKuttaVariableStepSizeIntegratorBase::modifyCurrentState( newState, allowRollback );
+    }
+
+    //! Modify the state and time for the current step.
+    /*!
+     * Modify the state and time for the current step (see base class), and discards the re-usable stage derivatives.
+     * \param newState The new state to set the current state to.
+     * \param newTime The time to set the current time to.
+     * \param allowRollback Boolean denoting whether roll-back should be allowed.
+     */
+    void modifyCurrentIntegrationVariables( const StateType& newState, const IndependentVariableType newTime,
+                                            const bool allowRollback = false )
+    {
+        resetReusableStageDerivatives( );
+        RungeKuttaVariableStepSizeIntegratorBase::modifyCurrentIntegrationVariables( newState, newTime, allowRollback );
+    }
+
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator to a binary stream (see base class), including whether the
+     * stage derivatives are to be re-used in the next step.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        RungeKuttaVariableStepSizeIntegratorBase::writeIntegratorState( stream );
+        serialization::writeBinaryIdentifier( stream, "RungeKuttaTableauIntegrator" );
+        serialization::writeBinaryValue( stream, isFirstStageDerivativeAvailable_ );
+        serialization::writeBinaryValue( stream, isLastStageDerivativeReusable_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream (see base class), including whether
+     * the stage derivatives are to be re-used in the next step.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        RungeKuttaVariableStepSizeIntegratorBase::readIntegratorState( stream );
+        serialization::readAndCheckBinaryIdentifier( stream, "RungeKuttaTableauIntegrator" );
+        serialization::readBinaryValue( stream, isFirstStageDerivativeAvailable_ );
+        serialization::readBinaryValue( stream, isLastStageDerivativeReusable_ );
+    }
+
+    //! Function to check whether the last stage of an accepted step is re-used as the first stage of the next step.
+    /*!
+     * Function to check whether the last stage of an accepted step is re-used as the first stage of the next step.
+     * \return True if the tableau has the first same as last (FSAL) property.
+     */
+    bool isFirstSameAsLast( ) const
+    {
+        return isFirstSameAsLast_;
+    }
+
+protected:
+
+    //! Function to discard the stage derivatives that would otherwise be re-used in the next step.
+    void resetReusableStageDerivatives( )
+    {
+        isFirstStageDerivativeAvailable_ = false;
+        isLastStageDerivativeReusable_ = false;
+    }
+
+    //! Boolean denoting whether the tableau has the first same as last (FSAL) property.
+    bool isFirstSameAsLast_;
+
+    //! Boolean denoting whether the first entry of currentStateDerivatives_ is the derivative at the current state.
+    bool isFirstStageDerivativeAvailable_;
+
+    //! Boolean denoting whether the last entry of currentStateDerivatives_ is the derivative at the current state.
+    bool isLastStageDerivativeReusable_;
+
+};
+
+//! Perform a single integration step.
+template< typename TableauType, typename IndependentVariableType, typename StateType, typename StateDerivativeType,
+          typename TimeStepType >
+StateType
+RungeKuttaTableauIntegrator< TableauType, IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+::performIntegrationStep( const TimeStepType stepSize )
+{
+    const unsigned int numberOfStages = TableauType::numberOfStages;
+
+    // Stage derivatives of the last accepted step are overwritten by this step.
+    this->isLastStepDenseOutputValid_ = false;
+
+    // Re-use last stage of previous step as the first stage of this step (FSAL).
+    if( isLastStageDerivativeReusable_ )
+    {
+        std::swap( this->currentStateDerivatives_[ 0 ], this->currentStateDerivatives_[ numberOfStages - 1 ] );
+        isLastStageDerivativeReusable_ = false;
+        isFirstStageDerivativeAvailable_ = true;
+    }
+
+    // Perform the step, and repeat it with the step size computed by the step size control until it is accepted.
+    TimeStepType currentStepSize = stepSize;
+    while( true )
+    {
+        // Compute the first stage, unless it is available from a rejected attempt or the previous step.
+        if( !isFirstStageDerivativeAvailable_ )
+        {
+            this->evaluateStateDerivative( this->currentIndependentVariable_, this->currentState_,
+                                           this->currentStateDerivatives_[ 0 ] );
+            if ( this->propagationTerminationFunction_(
+                     static_cast< double >( this->currentIndependentVariable_ ), TUDAT_NAN ) )
+            {
+                this->propagationTerminationConditionReachedDuringStep_ = true;
+                return this->currentState_;
+            }
+            isFirstStageDerivativeAvailable_ = true;
+        }
+
+        // Initialize lower and higher order estimates.
+        this->lowerOrderEstimate_ = this->currentState_;
+        this->higherOrderEstimate_ = this->currentState_;
+
+        // Compute the k_i state derivatives per stage, skipping zero entries of the tableau.
+        for ( unsigned int stage = 0; stage < numberOfStages; stage++ )
+        {
+            if( stage > 0 )
+            {
+                // Compute the intermediate state to pass to the state derivative for this stage.
+                this->intermediateState_ = this->currentState_;
+                for ( unsigned int column = 0; column < stage; column++ )
+                {
+                    if( TableauType::aCoefficients[ stage ][ column ] != 0.0 )
+                    {
+                        this->intermediateState_ += currentStepSize * TableauType::aCoefficients[ stage ][ column ] *
+                                this->currentStateDerivatives_[ column ];
+                    }
+                }
+
+                // Compute the state derivative.
+                const IndependentVariableType time = this->currentIndependentVariable_ +
+                        TableauType::cCoefficients[ stage ] * currentStepSize;
+                this->evaluateStateDerivative( time, this->intermediateState_, this->currentStateDerivatives_[ stage ] );
+
+                // Check if propagation should terminate because the propagation termination condition has been
+                // reached while computing the intermediate state.
+                // If so, return immediately the current state (not recomputed yet), which will be discarded.
+                if ( this->propagationTerminationFunction_( static_cast< double >( time ), TUDAT_NAN ) )
+                {
+                    this->propagationTerminationConditionReachedDuringStep_ = true;
+                    return this->currentState_;
+                }
+            }
+
+            // Update the estimates.
+            if( TableauType::bCoefficients[ 0 ][ stage ] != 0.0 )
+            {
+                this->lowerOrderEstimate_ += TableauType::bCoefficients[ 0 ][ stage ] * currentStepSize *
+                        this->currentStateDerivatives_[ stage ];
+            }
+            if( TableauType::bCoefficients[ 1 ][ stage ] != 0.0 )
+            {
+                this->higherOrderEstimate_ += TableauType::bCoefficients[ 1 ][ stage ] * currentStepSize *
+                        this->currentStateDerivatives_[ stage ];
+            }
+        }
+
+        // Determine if the error was within bounds and compute a new step size.
+        if ( this->computeNextStepSizeAndValidateResult(
+                 this->lowerOrderEstimate_, this->higherOrderEstimate_, currentStepSize ) )
+        {
+            // Accept the current step.
+            this->lastIndependentVariable_ = this->currentIndependentVariable_;
+            this->lastState_ = this->currentState_;
+            this->currentIndependentVariable_ += currentStepSize;
+            this->lastStepSize_ = currentStepSize;
+            this->isLastStepDenseOutputValid_ = true;
+
+            if( TableauType::orderEstimateToIntegrate == RungeKuttaCoefficients::lower )
+            {
+                this->currentState_ = this->lowerOrderEstimate_;
+            }
+            else
+            {
+                this->currentState_ = this->higherOrderEstimate_;
+            }
+
+            // The first stage of the next step is only known for FSAL tableaux (as the last stage of this step).
+            isFirstStageDerivativeAvailable_ = false;
+            isLastStageDerivativeReusable_ = isFirstSameAsLast_;
+
+            return this->currentState_;
+        }
+
+        // Reject current step, and retry with new step size (the first stage remains valid).
+        currentStepSize = this->stepSize_;
+    }
+}
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDAT_RUNGE_KUTTA_TABLEAU_INTEGRATOR_H
@@ -0,0 +1,67 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaTableaux.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+// Namespace-scope definitions of the static members of the tableaux, which are required when the coefficients are
+// indexed at run time.
+
+constexpr unsigned int RungeKuttaFehlberg45Tableau::numberOfStages;
+constexpr unsigned int RungeKuttaFehlberg45Tableau::lowerOrder;
+constexpr unsigned int RungeKuttaFehlberg45Tableau::higherOrder;
+constexpr RungeKuttaCoefficients::OrderEstimateToIntegrate RungeKuttaFehlberg45Tableau::orderEstimateToIntegrate;
+constexpr RungeKuttaCoefficients::CoefficientSets RungeKuttaFehlberg45Tableau::coefficientSet;
+constexpr double RungeKuttaFehlberg45Tableau::aCoefficients[ numberOfStages ][ numberOfStages - 1 ];
+constexpr double RungeKuttaFehlberg45Tableau::bCoefficients[ 2 ][ numberOfStages ];
+constexpr double RungeKuttaFehlberg45Tableau::cCoefficients[ numberOfStages ];
+
+constexpr unsigned int RungeKuttaFehlberg56Tableau::numberOfStages;
+constexpr unsigned int RungeKuttaFehlberg56Tableau::lowerOrder;
+constexpr unsigned int RungeKuttaFehlberg56Tableau::higherOrder;
+constexpr RungeKuttaCoefficients::OrderEstimateToIntegrate RungeKuttaFehlberg56Tableau::orderEstimateToIntegrate;
+constexpr RungeKuttaCoefficients::CoefficientSets RungeKuttaFehlberg56Tableau::coefficientSet;
+constexpr double RungeKuttaFehlberg56Tableau::aCoefficients[ numberOfStages ][ numberOfStages - 1 ];
+constexpr double RungeKuttaFehlberg56Tableau::bCoefficients[ 2 ][ numberOfStages ];
+constexpr double RungeKuttaFehlberg56Tableau::cCoefficients[ numberOfStages ];
+
+constexpr unsigned int RungeKuttaFehlberg78Tableau::numberOfStages;
+constexpr unsigned int RungeKuttaFehlberg78Tableau::lowerOrder;
+constexpr unsigned int RungeKuttaFehlberg78Tableau::higherOrder;
+constexpr RungeKuttaCoefficients::OrderEstimateToIntegrate RungeKuttaFehlberg78Tableau::orderEstimateToIntegrate;
+constexpr RungeKuttaCoefficients::CoefficientSets RungeKuttaFehlberg78Tableau::coefficientSet;
+constexpr double RungeKuttaFehlberg78Tableau::aCoefficients[ numberOfStages ][ numberOfStages - 1 ];
+constexpr double RungeKuttaFehlberg78Tableau::bCoefficients[ 2 ][ numberOfStages ];
+constexpr double RungeKuttaFehlberg78Tableau::cCoefficients[ numberOfStages ];
+
+constexpr unsigned int RungeKutta87DormandPrinceTableau::numberOfStages;
+constexpr unsigned int RungeKutta87DormandPrinceTableau::lowerOrder;
+constexpr unsigned int RungeKutta87DormandPrinceTableau::higherOrder;
+constexpr RungeKuttaCoefficients::OrderEstimateToIntegrate RungeKutta87DormandPrinceTableau::orderEstimateToIntegrate;
+constexpr RungeKuttaCoefficients::CoefficientSets RungeKutta87DormandPrinceTableau::coefficientSet;
+constexpr double RungeKutta87DormandPrinceTableau::aCoefficients[ numberOfStages ][ numberOfStages - 1 ];
+constexpr double RungeKutta87DormandPrinceTableau::bCoefficients[ 2 ][ numberOfStages ];
+constexpr double RungeKutta87DormandPrinceTableau::cCoefficients[ numberOfStages ];
+
+constexpr unsigned int RungeKutta54DormandPrinceTableau::numberOfStages;
+constexpr unsigned int RungeKutta54DormandPrinceTableau::lowerOrder;
+constexpr unsigned int RungeKutta54DormandPrinceTableau::higherOrder;
+constexpr RungeKuttaCoefficients::OrderEstimateToIntegrate RungeKutta54DormandPrinceTableau::orderEstimateToIntegrate;
+constexpr RungeKuttaCoefficients::CoefficientSets RungeKutta54DormandPrinceTableau::coefficientSet;
+constexpr double RungeKutta54DormandPrinceTableau::aCoefficients[ numberOfStages ][ numberOfStages - 1 ];
+constexpr double RungeKutta54DormandPrinceTableau::bCoefficients[ 2 ][ numberOfStages ];
+constexpr double RungeKutta54DormandPrinceTableau::cCoefficients[ numberOfStages ];
+
+} // namespace numerical_integrators
+} // namespace tudat
@@ -23,6 +23,8 @@
 #include <Eigen/Core>
 
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "Tudat/Basics/utilityMacros.h"
@@ -35,6 +37,9 @@ namespace tudat
 namespace numerical_integrators
 {
 
+//! Tolerance on the fraction of the last step outside of which dense output of a Runge-Kutta integrator is refused.
+static const double denseOutputStepFractionTolerance = 1.0E-12;
+
 //! Class that implements the Runge-Kutta variable stepsize integrator.
 /*!
  * Class that implements the Runge-Kutta variable step size integrator.
@@ -135,7 +140,8 @@ public:
         safetyFactorForNextStepSize_( std::fabs( static_cast< double >( safetyFactorForNextStepSize ) ) ),
         maximumFactorIncreaseForNextStepSize_( std::fabs( static_cast< double >( maximumFactorIncreaseForNextStepSize ) ) ),
         minimumFactorDecreaseForNextStepSize_( std::fabs( static_cast< double >( minimumFactorDecreaseForNextStepSize ) ) ),
-        newStepSizeFunction_( newStepSizeFunction ), useStepSizeControl_( true )
+        newStepSizeFunction_( newStepSizeFunction ), useStepSizeControl_( true ),
+        lastStepSize_( 0.0 ), isLastStepDenseOutputValid_( false )
     {
         // Set default newStepSizeFunction_ to the class method.
         if ( this->newStepSizeFunction_ == 0 )
@@ -198,7 +204,8 @@ public:
         safetyFactorForNextStepSize_( std::fabs( static_cast< double >( safetyFactorForNextStepSize ) ) ),
         maximumFactorIncreaseForNextStepSize_( std::fabs( static_cast< double >( maximumFactorIncreaseForNextStepSize ) ) ),
         minimumFactorDecreaseForNextStepSize_( std::fabs( static_cast< double >( minimumFactorDecreaseForNextStepSize ) ) ),
-        newStepSizeFunction_( newStepSizeFunction ), useStepSizeControl_( true )
+        newStepSizeFunction_( newStepSizeFunction ), useStepSizeControl_( true ),
+        lastStepSize_( 0.0 ), isLastStepDenseOutputValid_( false )
     {
         // Set default newStepSizeFunction_ to the class method.
         if ( newStepSizeFunction_ == 0 )
@@ -271,6 +278,7 @@ public:
 
         this->currentIndependentVariable_ = this->lastIndependentVariable_;
         this->currentState_ = this->lastState_;
+        isLastStepDenseOutputValid_ = false;
         return true;
     }
 
@@ -310,6 +318,7 @@ public:
         if ( !allowRollback )
         {
             this->lastIndependentVariable_ = currentIndependentVariable_;
+            isLastStepDenseOutputValid_ = false;
         }
     }
 
@@ -325,6 +334,7 @@ public:
     {
         currentState_ = newState;
         currentIndependentVariable_ = newTime;
+        isLastStepDenseOutputValid_ = false;
         if ( !allowRollback )
         {
             this->lastIndependentVariable_ = currentIndependentVariable_;
@@ -341,6 +351,75 @@ public:
         useStepSizeControl_ = useStepSizeControl;
     }
 
+    //! Function to check whether the integrator can provide dense output.
+    /*!
+     * Function to check whether the integrator can provide dense output, which is the case if the coefficient set
+     * defines a continuous extension (currently RKF78 and RKDP87).
+     * \return True if the integrator can provide dense output.
+     */
+    bool isDenseOutputAvailable( ) const
+    {
+        return coefficients_.isDenseOutputAvailable( );
+    }
+
+    //! Function to compute the state at a given value of the independent variable within the last accepted step.
+    /*!
+     * Function to compute the state at a given value of the independent variable within the last accepted step, by
+     * evaluating the continuous extension of the coefficient set using the stage derivatives of the step (see
+     * RungeKuttaCoefficients::denseOutputCoefficients). No state derivatives are evaluated. The interpolated state
+     * matches the integrated state at both ends of the step. Throws an error if the independent variable is outside
+     * the last accepted step, or if the step has been rolled back or its end state modified without allowing rollback.
+     * \param independentVariable Value of the independent variable at which the state is to be computed.
+     * \return State at the requested value of the independent variable.
+     */
+    StateType getDenseOutputState( const IndependentVariableType independentVariable );
+
+    //! Function to write the internal state of the integrator to a binary stream.
+    /*!
+     * Function to write the internal state of the integrator (current and previous state and independent variable, step
+     * size control state, and stage derivatives of the last step, used for dense output) to a binary stream, see
+     * NumericalIntegrator::writeIntegratorState.
+     * \param stream Binary stream to which the state of the integrator is to be written.
+     */
+    void writeIntegratorState( std::ostream& stream ) const
+    {
+        serialization::writeBinaryIdentifier( stream, "RungeKuttaVariableStepSizeIntegrator" );
+        serialization::writeBinaryValue( stream, stepSize_ );
+        serialization::writeBinaryValue( stream, currentIndependentVariable_ );
+        serialization::writeBinaryValue( stream, currentState_ );
+        serialization::writeBinaryValue( stream, lastIndependentVariable_ );
+        serialization::writeBinaryValue( stream, lastState_ );
+        serialization::writeBinaryValue( stream, useStepSizeControl_ );
+        serialization::writeBinaryValue( stream, lastStepSize_ );
+        serialization::writeBinaryValue( stream, isLastStepDenseOutputValid_ );
+        serialization::writeBinaryValue( stream, currentStateDerivatives_ );
+    }
+
+    //! Function to read the internal state of the integrator from a binary stream.
+    /*!
+     * Function to read the internal state of the integrator from a binary stream, see
+     * NumericalIntegrator::readIntegratorState.
+     * \param stream Binary stream from which the state of the integrator is to be read.
+     */
+    void readIntegratorState( std::istream& stream )
+    {
+        serialization::readAndCheckBinaryIdentifier( stream, "RungeKuttaVariableStepSizeIntegrator" );
+        serialization::readBinaryValue( stream, stepSize_ );
+        serialization::readBinaryValue( stream, currentIndependentVariable_ );
+        serialization::readBinaryValue( stream, currentState_ );
+        serialization::readBinaryValue( stream, lastIndependentVariable_ );
+        serialization::readBinaryValue( stream, lastState_ );
+        serialization::readBinaryValue( stream, useStepSizeControl_ );
+        serialization::readBinaryValue( stream, lastStepSize_ );
+        serialization::readBinaryValue( stream, isLastStepDenseOutputValid_ );
+        serialization::readBinaryValue( stream, currentStateDerivatives_ );
+        if( currentStateDerivatives_.size( ) != static_cast< unsigned int >( coefficients_.cCoefficients.rows( ) ) )
+        {
+            throw std::runtime_error( "Error when reading Runge-Kutta integrator state, number of stages is inconsistent "
+                                      "with coefficient set." );
+        }
+    }
+
 protected:
 
     //! Computes the next step size and validates the result.
@@ -480,9 +559,24 @@ protected:
      */
     std::vector< StateDerivativeType > currentStateDerivatives_;
 
+    //! Lower order estimate of the state at the end of the current step.
+    StateType lowerOrderEstimate_;
+
+    //! Higher order estimate of the state at the end of the current step.
+    StateType higherOrderEstimate_;
+
+    //! Intermediate state at which the state derivative is evaluated in the current stage.
+    StateType intermediateState_;
+
     //! Boolean denoting whether step size control is to be used
     bool useStepSizeControl_;
 
+    //! Step size of the last accepted step.
+    TimeStepType lastStepSize_;
+
+    //! Boolean denoting whether the stage derivatives of the last accepted step are available for dense output.
+    bool isLastStepDenseOutputValid_;
+
 };
 
 extern template class RungeKuttaVariableStepSizeIntegrator < double, Eigen::VectorXd, Eigen::VectorXd >;
@@ -496,75 +590,125 @@ StateType
 RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
 ::performIntegrationStep( const TimeStepType stepSize )
 {
-    // Define and allocated vector for the number of stages.
-    currentStateDerivatives_.clear( );
-    currentStateDerivatives_.reserve( this->coefficients_.cCoefficients.rows( ) );
+    // Size vector of state derivatives for the number of stages (entries are re-used between steps).
+    currentStateDerivatives_.resize( this->coefficients_.cCoefficients.rows( ) );
 
-    // Define lower and higher order estimates.
-    StateType lowerOrderEstimate( this->currentState_ ), higherOrderEstimate( this->currentState_ );
+    // Stage derivatives of the last accepted step are overwritten by this step.
+    isLastStepDenseOutputValid_ = false;
 
-    // Compute the k_i state derivatives per stage.
-    for ( int stage = 0; stage < this->coefficients_.cCoefficients.rows( ); stage++ )
+    // Perform the step, and repeat it with the step size computed by the step size control until it is accepted.
+    TimeStepType currentStepSize = stepSize;
+    while( true )
     {
-        // Compute the intermediate state to pass to the state derivative for this stage.
-        StateType intermediateState( this->currentState_ );
+        // Initialize lower and higher order estimates.
+        lowerOrderEstimate_ = this->currentState_;
+        higherOrderEstimate_ = this->currentState_;
 
-        // Compute the intermediate state.
-        for ( int column = 0; column < stage; column++ )
+        // Compute the k_i state derivatives per stage.
+        for ( int stage = 0; stage < this->coefficients_.cCoefficients.rows( ); stage++ )
         {
-            intermediateState += stepSize * this->coefficients_.aCoefficients( stage, column ) *
-                    currentStateDerivatives_[ column ];
+            // Compute the intermediate state to pass to the state derivative for this stage.
+            intermediateState_ = this->currentState_;
+            for ( int column = 0; column < stage; column++ )
+            {
+                intermediateState_ += currentStepSize * this->coefficients_.aCoefficients( stage, column ) *
+                        currentStateDerivatives_[ column ];
+            }
+
+            // Compute the state derivative.
+            const IndependentVariableType time = this->currentIndependentVariable_ +
+                    this->coefficients_.cCoefficients( stage ) * currentStepSize;
+            this->evaluateStateDerivative( time, intermediateState_, currentStateDerivatives_[ stage ] );
+
+            // Check if propagation should terminate because the propagation termination condition has been reached
+            // while computing the intermediate state.
+            // If so, return immediately the current state (not recomputed yet), which will be discarded.
+            if ( this->propagationTerminationFunction_( static_cast< double >( time ), TUDAT_NAN ) )
+            {
+                this->propagationTerminationConditionReachedDuringStep_ = true;
+                return this->currentState_;
+            }
+
+            // Update the estimate.
+            lowerOrderEstimate_ += this->coefficients_.bCoefficients( 0, stage ) * currentStepSize *
+                    currentStateDerivatives_[ stage ];
+            higherOrderEstimate_ += this->coefficients_.bCoefficients( 1, stage ) * currentStepSize *
+                    currentStateDerivatives_[ stage ];
         }
 
-        // Compute the state derivative.
-        const IndependentVariableType time = this->currentIndependentVariable_ +
-                this->coefficients_.cCoefficients( stage ) * stepSize;
-        currentStateDerivatives_.push_back( this->stateDerivativeFunction_( time, intermediateState ) );
-
-        // Check if propagation should terminate because the propagation termination condition has been reached
-        // while computing the intermediate state.
-        // If so, return immediately the current state (not recomputed yet), which will be discarded.
-        if ( this->propagationTerminationFunction_( static_cast< double >( time ), TUDAT_NAN ) )
+        // Determine if the error was within bounds and compute a new step size.
+        if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate_,
+                                                   higherOrderEstimate_, currentStepSize ) )
         {
-            this->propagationTerminationConditionReachedDuringStep_ = true;
-            return this->currentState_;
+            // Accept the current step.
+            this->lastIndependentVariable_ = this->currentIndependentVariable_;
+            this->lastState_ = this->currentState_;
+            this->currentIndependentVariable_ += currentStepSize;
+            lastStepSize_ = currentStepSize;
+            isLastStepDenseOutputValid_ = true;
+
+            switch ( this->coefficients_.orderEstimateToIntegrate )
+            {
+            case RungeKuttaCoefficients::lower:
+                this->currentState_ = lowerOrderEstimate_;
+                return this->currentState_;
+
+            case RungeKuttaCoefficients::higher:
+                this->currentState_ = higherOrderEstimate_;
+                return this->currentState_;
+
+            default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
+                throw std::runtime_error( "Order estimate to integrate is invalid." );
+            }
         }
 
-        // Update the estimate.
-        lowerOrderEstimate += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
-                currentStateDerivatives_[ stage ];
-        higherOrderEstimate += this->coefficients_.bCoefficients( 1, stage ) * stepSize *
-                currentStateDerivatives_[ stage ];
+        // Reject current step, and retry with new step size.
+        currentStepSize = this->stepSize_;
     }
+}
 
-    // Determine if the error was within bounds and compute a new step size.
-    if ( computeNextStepSizeAndValidateResult( lowerOrderEstimate,
-                                               higherOrderEstimate, stepSize ) )
+//! Function to compute the state at a given value of the independent variable within the last accepted step.
+template< typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
+StateType
+RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+::getDenseOutputState( const IndependentVariableType independentVariable )
+{
+    if( !coefficients_.isDenseOutputAvailable( ) )
+    {
+        throw std::runtime_error( "Error when computing dense output of Runge-Kutta integrator, no continuous extension "
+                                  "is available for the coefficient set." );
+    }
+    else if( !isLastStepDenseOutputValid_ )
     {
-        // Accept the current step.
-        this->lastIndependentVariable_ = this->currentIndependentVariable_;
-        this->lastState_ = this->currentState_;
-        this->currentIndependentVariable_ += stepSize;
+        throw std::runtime_error( "Error when computing dense output of Runge-Kutta integrator, no valid accepted step." );
+    }
 
-        switch ( this->coefficients_.orderEstimateToIntegrate )
-        {
-        case RungeKuttaCoefficients::lower:
-            this->currentState_ = lowerOrderEstimate;
-            return this->currentState_;
+    // Compute fraction of the last step at which the state is to be computed (allowing for rounding errors at the ends).
+    const TimeStepType stepFraction =
+            static_cast< TimeStepType >( independentVariable - this->lastIndependentVariable_ ) / lastStepSize_;
+    if( stepFraction < -denseOutputStepFractionTolerance || stepFraction > 1.0 + denseOutputStepFractionTolerance )
+    {
+        throw std::runtime_error( "Error when computing dense output of Runge-Kutta integrator, requested independent "
+                                  "variable is outside the last accepted step (step fraction " +
+                                  std::to_string( static_cast< double >( stepFraction ) ) + ")." );
+    }
 
-        case RungeKuttaCoefficients::higher:
-            this->currentState_ = higherOrderEstimate;
-            return this->currentState_;
+    // Evaluate the continuous extension: the weight of each stage derivative is a polynomial in the step fraction.
+    StateType interpolatedState = this->lastState_;
+    for ( unsigned int stage = 0; stage < currentStateDerivatives_.size( ); stage++ )
+    {
+        TimeStepType stageWeight = 0.0;
+        for ( int power = this->coefficients_.denseOutputCoefficients.cols( ) - 1; power >= 0; power-- )
+        {
+            stageWeight = ( stageWeight + this->coefficients_.denseOutputCoefficients( stage, power ) ) * stepFraction;
+        }
 
-        default: // The default case will never occur because OrderEstimateToIntegrate is an enum.
-            throw std::runtime_error( "Order estimate to integrate is invalid." );
+        if( stageWeight != 0.0 )
+        {
+            interpolatedState += ( lastStepSize_ * stageWeight ) * currentStateDerivatives_[ stage ];
         }
     }
-    else
-    {
-        // Reject current step.
-        return performIntegrationStep( this->stepSize_ );
-    }
+    return interpolatedState;
 }
 
 //! Compute the next step size and validate the result.
@@ -652,25 +796,15 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
 {
     TUDAT_UNUSED_PARAMETER( minimumAndMaximumFactorsForNextStepSize );
 
-    // Compute the truncation error based on the higher and lower order estimates.
-    const StateType truncationError_ =
-            ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( );
-
-    // Compute error tolerance based on relative and absolute error tolerances.
-    const StateType errorTolerance_ =
-            ( higherOrderEstimate.array( ).abs( ) *
-              relativeErrorTolerance.array( ) ).matrix( )
-            + absoluteErrorTolerance;
-
-    // Compute relative truncation error. This will indicate if the current step satisfies the
-    // required tolerances.
-    const StateType relativeTruncationError_ = truncationError_.array( ) /
-            errorTolerance_.array( );
-
     // Compute the maximum error based on the largest coefficient in the relative truncation error
-    // matrix.
-    const typename StateType::Scalar maximumErrorInState_
-            = relativeTruncationError_.array( ).abs( ).maxCoeff( );
+    // matrix, i.e. the truncation error (difference between the higher and lower order estimates) divided
+    // by the error tolerance (based on relative and absolute error tolerances). This will indicate if the
+    // current step satisfies the required tolerances. The expression is evaluated coefficient-wise,
+    // without creating intermediate matrices.
+    const typename StateType::Scalar maximumErrorInState_ =
+            ( ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( ) /
+              ( higherOrderEstimate.array( ).abs( ) * relativeErrorTolerance.array( ) +
+                absoluteErrorTolerance.array( ) ) ).maxCoeff( );
 
     // Compute the new step size. This is based off of the equation given in
     // (Montenbruck and Gill, 2005).
@@ -84,6 +84,37 @@ BOOST_AUTO_TEST_CASE( testSampleVariance )
                                 std::numeric_limits< double >::epsilon( ) );
 }
 
+//! Test if sample covariance is computed correctly.
+BOOST_AUTO_TEST_CASE( testSampleCovariance )
+{
+    // Declare vector of sample data.
+    std::vector< Eigen::VectorXd > sampleData;
+    sampleData.push_back( ( Eigen::VectorXd( 2 ) << 1.0, 2.0 ).finished( ) );
+    sampleData.push_back( ( Eigen::VectorXd( 2 ) << 3.0, 5.0 ).finished( ) );
+    sampleData.push_back( ( Eigen::VectorXd( 2 ) << 5.0, 11.0 ).finished( ) );
+
+    // Declare expected sample covariance (computed manually).
+    Eigen::MatrixXd expectedSampleCovariance = ( Eigen::MatrixXd( 2, 2 ) << 4.0, 9.0, 9.0, 21.0 ).finished( );
+
+    // Compute sample covariance, and check against expected values and sample variance.
+    Eigen::MatrixXd computedSampleCovariance = statistics::computeSampleCovariance( sampleData );
+    Eigen::VectorXd computedSampleVariance = statistics::computeSampleVariance( sampleData );
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        for( unsigned int j = 0; j < 2; j++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( computedSampleCovariance( i, j ), expectedSampleCovariance( i, j ),
+                                        4.0 * std::numeric_limits< double >::epsilon( ) );
+        }
+        BOOST_CHECK_CLOSE_FRACTION( computedSampleCovariance( i, i ), computedSampleVariance( i ),
+                                    4.0 * std::numeric_limits< double >::epsilon( ) );
+    }
+
+    // Check that single sample is rejected
+    sampleData.resize( 1 );
+    BOOST_CHECK_THROW( statistics::computeSampleCovariance( sampleData ), std::runtime_error );
+}
+
 //! Test if moving average is computed correctly. Results compared with MATLAB movmean function.
 BOOST_AUTO_TEST_CASE( testMovingAverage )
 {
@@ -134,6 +134,28 @@ Eigen::VectorXd computeSampleVariance( const std::vector< Eigen::VectorXd >& sam
     return 1.0 / ( static_cast< double >( sampleData.size( ) ) - 1.0 ) * sumOfResidualsSquared;
 }
 
+//! Compute sample covariance.
+Eigen::MatrixXd computeSampleCovariance( const std::vector< Eigen::VectorXd >& sampleData )
+{
+    if( sampleData.size( ) < 2 )
+    {
+        throw std::runtime_error( "Error when computing sample covariance, at least two samples are required." );
+    }
+
+    // Declare and compute sample mean.
+    Eigen::VectorXd sampleMean = computeSampleMean( sampleData );
+
+    // Compute sum of outer products of residuals of sample data.
+    Eigen::MatrixXd sumOfResidualProducts = Eigen::MatrixXd::Zero( sampleMean.rows( ), sampleMean.rows( ) );
+    for ( unsigned int i = 0; i < sampleData.size( ); i++ )
+    {
+        sumOfResidualProducts += ( sampleData.at( i ) - sampleMean ) * ( sampleData.at( i ) - sampleMean ).transpose( );
+    }
+
+    // Return sample covariance.
+    return 1.0 / ( static_cast< double >( sampleData.size( ) ) - 1.0 ) * sumOfResidualProducts;
+}
+
 //! Compute moving average of an Eigen vector.
 Eigen::VectorXd computeMovingAverage( const Eigen::VectorXd& sampleData, const unsigned int numberOfAveragingPoints )
 {
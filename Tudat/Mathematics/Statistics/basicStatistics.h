@@ -109,6 +109,19 @@ double computeSampleMedian( std::vector< double > sampleData );
  */
 Eigen::VectorXd computeSampleVariance( const std::vector< Eigen::VectorXd >& sampleData );
 
+//! Compute sample covariance.
+/*!
+ * Computes sample covariance matrix for a sample of VectorXd based on the following unbiased estimator:
+ * \f[
+ *      C = \frac{ 1 }{ N - 1 } * \sum_{i=1}^{N} ( X_{i} - \bar{ X } )( X_{i} - \bar{ X } )^{ T }
+ * \f]
+ * where \f$ C \f$ is the unbiased estimate of the sample covariance, \f$ N \f$ is the number of samples,
+ * \f$ X \f$ is the sample value, and \f$ \bar{ X } \f$ is the sample mean.
+ * \param sampleData Vector containing sample data.
+ * \return Sample covariance.
+ */
+Eigen::MatrixXd computeSampleCovariance( const std::vector< Eigen::VectorXd >& sampleData );
+
 //! Compute moving average of vector.
 /*!
  *  Compute moving average of vector, where the moving average is computed by sliding a window of
@@ -8,6 +8,10 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 
+#include <algorithm>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
 
 #if USE_CSPICE
@@ -18,6 +22,7 @@
 #include "Tudat/Astrodynamics/Gravitation/triAxialEllipsoidGravity.h"
 #include "Tudat/SimulationSetup/EnvironmentSetup/createGravityField.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/binaryGravityFieldFile.h"
 
 namespace tudat
 {
@@ -68,6 +73,13 @@ std::string getReferenceFrameForSphericalHarmonicsModel( const SphericalHarmonic
     }
 }
 
+//! Get the path of the binary SH file for a SH model.
+std::string getBinaryPathForSphericalHarmonicsModel( const SphericalHarmonicsModel sphericalHarmonicsModel )
+{
+    return boost::filesystem::path( getPathForSphericalHarmonicsModel( sphericalHarmonicsModel ) ).
+            replace_extension( ".bin" ).string( );
+}
+
 //! Constructor with custom model.
 FromFileSphericalHarmonicsGravityFieldSettings::FromFileSphericalHarmonicsGravityFieldSettings(
         const std::string& filePath, const std::string& associatedReferenceFrame,
@@ -95,7 +107,10 @@ FromFileSphericalHarmonicsGravityFieldSettings::FromFileSphericalHarmonicsGravit
 //! Constructor with model included in Tudat.
 FromFileSphericalHarmonicsGravityFieldSettings::FromFileSphericalHarmonicsGravityFieldSettings(
         const SphericalHarmonicsModel sphericalHarmonicsModel ) :
-    FromFileSphericalHarmonicsGravityFieldSettings( getPathForSphericalHarmonicsModel( sphericalHarmonicsModel ),
+    FromFileSphericalHarmonicsGravityFieldSettings(
+        boost::filesystem::exists( getBinaryPathForSphericalHarmonicsModel( sphericalHarmonicsModel ) ) ?
+            getBinaryPathForSphericalHarmonicsModel( sphericalHarmonicsModel ) :
+            getPathForSphericalHarmonicsModel( sphericalHarmonicsModel ),
                                                     getReferenceFrameForSphericalHarmonicsModel( sphericalHarmonicsModel ),
                                                     50, 50, 0, 1 )
 {
@@ -109,6 +124,32 @@ std::pair< double, double  > readGravityFieldFile(
         std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients,
         const int gravitationalParameterIndex, const int referenceRadiusIndex )
 {
+    // Load coefficients up to required maximum degree and order directly from memory-mapped file, if binary.
+    if( input_output::isBinaryGravityFieldFile( fileName ) )
+    {
+        input_output::MemoryMappedGravityFieldFile binaryFile( fileName );
+        binaryFile.getCoefficients( maximumDegree, maximumOrder, coefficients.first, coefficients.second );
+        coefficients.first( 0, 0 ) = 1.0;
+
+        if( ( gravitationalParameterIndex >= 0 ) != ( referenceRadiusIndex >= 0 ) )
+        {
+            throw std::runtime_error( "Error when reading gravity field file, must retrieve either both or neither of Re and mu" );
+        }
+        else if( gravitationalParameterIndex >= 0 )
+        {
+            if( std::isnan( binaryFile.getGravitationalParameter( ) ) || std::isnan( binaryFile.getReferenceRadius( ) ) )
+            {
+                throw std::runtime_error( "Error when reading binary gravity field file " + fileName +
+                                          ", file contains no gravitational parameter and reference radius" );
+            }
+            return std::make_pair( binaryFile.getGravitationalParameter( ), binaryFile.getReferenceRadius( ) );
+        }
+        else
+        {
+            return std::make_pair( TUDAT_NAN, TUDAT_NAN );
+        }
+    }
+
     // Attempt to open gravity file.
     std::fstream stream( fileName.c_str( ), std::ios::in );
     if( stream.fail( ) )
@@ -162,9 +203,9 @@ std::pair< double, double  > readGravityFieldFile(
     Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd( maximumDegree + 1, maximumOrder + 1 );
     sineCoefficients.setZero( );
 
-    // Read coefficients up to required maximum degree and order.
+    // Read coefficients up to required maximum degree and order (all orders of degrees below the maximum degree).
     while ( !stream.fail( ) && !stream.eof( ) &&
-            ( currentDegree <= maximumDegree && currentOrder < maximumOrder )  )
+            ( currentDegree < maximumDegree || ( currentDegree == maximumDegree && currentOrder < maximumOrder ) ) )
     {
         // Read current line
         std::getline( stream, line );
@@ -213,6 +254,75 @@ std::pair< double, double  > readGravityFieldFile(
     return std::make_pair( gravitationalParameter, referenceRadius );
 }
 
+//! Function to determine the maximum degree and order of the coefficients in a spherical harmonic gravity field file
+std::pair< int, int > getMaximumDegreeAndOrderOfGravityFieldFile(
+        const std::string& fileName, const bool fileHasHeader )
+{
+    std::ifstream stream( fileName.c_str( ) );
+    if( stream.fail( ) )
+    {
+        throw std::runtime_error( "Pds gravity field data file could not be opened: " + fileName );
+    }
+
+    std::string line;
+    if( fileHasHeader )
+    {
+        std::getline( stream, line );
+    }
+
+    // Read degree and order from each line.
+    int maximumDegree = 0, maximumOrder = 0;
+    int currentDegree, currentOrder;
+    while( std::getline( stream, line ) )
+    {
+        std::replace( line.begin( ), line.end( ), ',', ' ' );
+        std::istringstream lineStream( line );
+        if( lineStream >> currentDegree >> currentOrder )
+        {
+            maximumDegree = std::max( maximumDegree, currentDegree );
+            maximumOrder = std::max( maximumOrder, currentOrder );
+        }
+    }
+
+    return std::make_pair( maximumDegree, maximumOrder );
+}
+
+//! Function to convert a spherical harmonic gravity field text file to a binary gravity field file
+void convertGravityFieldFileToBinary(
+        const std::string& textFileName, const std::string& binaryFileName,
+        const int gravitationalParameterIndex, const int referenceRadiusIndex,
+        const double gravitationalParameter, const double referenceRadius )
+{
+    if( input_output::isBinaryGravityFieldFile( textFileName ) )
+    {
+        throw std::runtime_error( "Error when converting gravity field file, " + textFileName +
+                                  " is already a binary gravity field file" );
+    }
+
+    // Read all coefficients from text file.
+    std::pair< int, int > maximumDegreeAndOrder = getMaximumDegreeAndOrderOfGravityFieldFile(
+                textFileName, gravitationalParameterIndex >= 0 );
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > coefficients;
+    std::pair< double, double > referenceData =
+            readGravityFieldFile( textFileName, maximumDegreeAndOrder.first, maximumDegreeAndOrder.second, coefficients,
+                                  gravitationalParameterIndex, referenceRadiusIndex );
+
+    input_output::writeBinaryGravityFieldFile(
+                binaryFileName, coefficients.first, coefficients.second,
+                gravitationalParameterIndex >= 0 ? referenceData.first : gravitationalParameter,
+                referenceRadiusIndex >= 0 ? referenceData.second : referenceRadius );
+}
+
+//! Function to convert the file of a spherical harmonics model included in Tudat to a binary gravity field file
+void convertSphericalHarmonicsModelToBinary( const SphericalHarmonicsModel sphericalHarmonicsModel,
+                                             const std::string& binaryFileName )
+{
+    convertGravityFieldFileToBinary(
+                getPathForSphericalHarmonicsModel( sphericalHarmonicsModel ),
+                binaryFileName.empty( ) ? getBinaryPathForSphericalHarmonicsModel( sphericalHarmonicsModel ) :
+                                          binaryFileName, 0, 1 );
+}
+
 //! Function to create a gravity field model.
 std::shared_ptr< gravitation::GravityFieldModel > createGravityFieldModel(
         const std::shared_ptr< GravityFieldSettings > gravityFieldSettings,
@@ -263,6 +263,15 @@ std::string getPathForSphericalHarmonicsModel( const SphericalHarmonicsModel sph
  */
 std::string getReferenceFrameForSphericalHarmonicsModel( const SphericalHarmonicsModel sphericalHarmonicsModel );
 
+//! Get the path of the binary SH file for a SH model.
+/*!
+ * Get the path of the binary SH file for a SH model, as created by convertSphericalHarmonicsModelToBinary (the path of
+ * the text file, with extension .bin instead of .txt).
+ * \param sphericalHarmonicsModel The spherical harmonics model.
+ * \return The path of the binary SH file for a SH model.
+ */
+std::string getBinaryPathForSphericalHarmonicsModel( const SphericalHarmonicsModel sphericalHarmonicsModel );
+
 //! Derived class of SphericalHarmonicsGravityFieldSettings defining settings of spherical harmonic gravity
 //! field representation to be loaded from a spherical harmonics model file.
 class FromFileSphericalHarmonicsGravityFieldSettings: public SphericalHarmonicsGravityFieldSettings
@@ -292,7 +301,8 @@ public:
                                                     const double referenceRadius = TUDAT_NAN );
     //! Constructor with model included in Tudat.
     /*!
-     * Constructor with model included in Tudat.
+     * Constructor with model included in Tudat. If the binary version of the model file exists (see
+     * convertSphericalHarmonicsModelToBinary), it is loaded instead of the text file.
      * \param sphericalHarmonicsModel Spherical harmonics model to be used.
      */
     FromFileSphericalHarmonicsGravityFieldSettings( const SphericalHarmonicsModel sphericalHarmonicsModel );
@@ -411,6 +421,10 @@ std::shared_ptr< SphericalHarmonicsGravityFieldSettings > createHomogeneousTriAx
  *  Degree, Order, Cosine Coefficient, Sine Coefficients
  *  Subsequent columns may be present in the file, but are ignored when parsing.
  *  All coefficients not defined in the file are set to zero (except C(0,0) which is always 1.0)
+ *  Alternatively, the file may be a binary gravity field file (see input_output::writeBinaryGravityFieldFile), which is
+ *  memory-mapped, and from which only the coefficients up to the requested degree and order are read. In that case, the
+ *  gravitational parameter and reference radius are taken from the binary file if gravitationalParameterIndex and
+ *  referenceRadiusIndex are >=0 (the values of the indices are then irrelevant).
  *  \param fileName Name of PDS gravity field file to be loaded.
  *  \param maximumDegree Maximum degree of gravity field to be loaded.
  *  \param maximumOrder Maximum order of gravity field to be loaded.
@@ -425,6 +439,48 @@ std::pair< double, double > readGravityFieldFile(
         std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients,
         const int gravitationalParameterIndex = -1, const int referenceRadiusIndex = -1 );
 
+//! Function to determine the maximum degree and order of the coefficients in a spherical harmonic gravity field file
+/*!
+ *  Function to determine the maximum degree and order of the coefficients in a spherical harmonic gravity field text
+ *  file (with the structure described for readGravityFieldFile), by reading the degree and order of each line.
+ *  \param fileName Name of PDS gravity field file.
+ *  \param fileHasHeader Boolean denoting whether the first line of the file is a header with metadata.
+ *  \return Pair of maximum degree and maximum order of the coefficients in the file.
+ */
+std::pair< int, int > getMaximumDegreeAndOrderOfGravityFieldFile(
+        const std::string& fileName, const bool fileHasHeader );
+
+//! Function to convert a spherical harmonic gravity field text file to a binary gravity field file
+/*!
+ *  Function to convert a spherical harmonic gravity field text file (with the structure described for
+ *  readGravityFieldFile) to a binary gravity field file (see input_output::writeBinaryGravityFieldFile), containing
+ *  all coefficients of the text file. The binary file can be loaded directly by readGravityFieldFile and
+ *  FromFileSphericalHarmonicsGravityFieldSettings.
+ *  \param textFileName Name of PDS gravity field file that is to be converted.
+ *  \param binaryFileName Name of the binary gravity field file that is to be written.
+ *  \param gravitationalParameterIndex Index at which the gravitational parameter can be found in the header
+ *  (first line of the file). Set to -1 if the file has no header.
+ *  \param referenceRadiusIndex Index at which the reference radius can be found in the header
+ *  (first line of the file). Set to -1 if the file has no header.
+ *  \param gravitationalParameter Gravitational parameter to be stored in the binary file if file has no header.
+ *  \param referenceRadius Reference radius to be stored in the binary file if file has no header.
+ */
+void convertGravityFieldFileToBinary(
+        const std::string& textFileName, const std::string& binaryFileName,
+        const int gravitationalParameterIndex, const int referenceRadiusIndex,
+        const double gravitationalParameter = TUDAT_NAN, const double referenceRadius = TUDAT_NAN );
+
+//! Function to convert the file of a spherical harmonics model included in Tudat to a binary gravity field file
+/*!
+ *  Function to convert the file of a spherical harmonics model included in Tudat to a binary gravity field file. By
+ *  default, the binary file is written next to the text file (see getBinaryPathForSphericalHarmonicsModel), from
+ *  where it is subsequently loaded by FromFileSphericalHarmonicsGravityFieldSettings.
+ *  \param sphericalHarmonicsModel Spherical harmonics model that is to be converted.
+ *  \param binaryFileName Name of the binary gravity field file that is to be written (default if empty).
+ */
+void convertSphericalHarmonicsModelToBinary( const SphericalHarmonicsModel sphericalHarmonicsModel,
+                                             const std::string& binaryFileName = "" );
+
 //! Function to create a gravity field model.
 /*!
  *  Function to create a gravity field model based on model-specific settings for the gravity field.
@@ -36,34 +36,16 @@ void createStateTransitionAndSensitivityMatrixInterpolator(
         std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >& stateTransitionMatrixInterpolator,
         std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >& sensitivityMatrixInterpolator,
         std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution,
-        const bool clearRawSolution )
+        const bool clearRawSolution,
+        const std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings )
 {
     // Create interpolator for state transition matrix.
-    stateTransitionMatrixInterpolator=
-            std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::MatrixXd > >(
-                utilities::createVectorFromMapKeys< Eigen::MatrixXd, double >( variationalEquationsSolution[ 0 ] ),
-                utilities::createVectorFromMapValues< Eigen::MatrixXd, double >( variationalEquationsSolution[ 0 ] ), 4 );
-    if( clearRawSolution )
-    {
-        variationalEquationsSolution[ 0 ].clear( );
-    }
-
-//    std::cout<<"State trans. size "<<variationalEquationsSolution[ 0 ].size( )<<std::endl;
-//    std::cout<<"State trans. matrix "<<variationalEquationsSolution[ 0 ].begin( )->second<<std::endl;
+    stateTransitionMatrixInterpolator = createMatrixHistoryInterpolator(
+                variationalEquationsSolution[ 0 ], 4, matrixHistoryStorageSettings, clearRawSolution );
 
     // Create interpolator for sensitivity matrix.
-    sensitivityMatrixInterpolator =
-            std::make_shared< interpolators::LagrangeInterpolator< double, Eigen::MatrixXd > >(
-                utilities::createVectorFromMapKeys< Eigen::MatrixXd, double >( variationalEquationsSolution[ 1 ] ),
-                utilities::createVectorFromMapValues< Eigen::MatrixXd, double >( variationalEquationsSolution[ 1 ] ), 4 );
-
-    //std::cout<<"State trans "<<stateTransitionMatrixInterpolator->interpolate( 20000.0 )<<std::endl;
-
-    if( clearRawSolution )
-    {
-        variationalEquationsSolution[ 1 ].clear( );
-    }
-
+    sensitivityMatrixInterpolator = createMatrixHistoryInterpolator(
+                variationalEquationsSolution[ 1 ], 4, matrixHistoryStorageSettings, clearRawSolution );
 }
 
 template class VariationalEquationsSolver< double, double >;
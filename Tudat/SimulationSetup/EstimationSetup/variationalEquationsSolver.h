@@ -11,6 +11,8 @@
 #ifndef TUDAT_VARIATIONALEQUATIONSSOLVER_H
 #define TUDAT_VARIATIONALEQUATIONSSOLVER_H
 
+#include <mutex>
+
 #include <boost/make_shared.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_comparison.hpp>
@@ -24,6 +26,7 @@
 
 #include "Tudat/Astrodynamics/OrbitDetermination/EstimatableParameters/estimatableParameter.h"
 #include "Tudat/Astrodynamics/Propagators/stateTransitionMatrixInterface.h"
+#include "Tudat/Astrodynamics/Propagators/matrixHistoryStorage.h"
 #include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
 #include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
 #include "Tudat/SimulationSetup/EstimationSetup/createStateDerivativePartials.h"
@@ -136,7 +139,39 @@ public:
      */
     virtual std::shared_ptr< DynamicsSimulator< StateScalarType, TimeType > > getDynamicsSimulatorBase( ) = 0;
 
+    //! Pure virtual function to set the number of threads used to evaluate the variational equations
+    /*!
+     * Pure virtual function to set the number of threads used to evaluate the variational equations, over which blocks
+     * of columns of the state transition and sensitivity matrix derivatives are distributed (see
+     * VariationalEquations::setNumberOfEvaluationThreads)
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    virtual void setNumberOfVariationalEquationsThreads( const unsigned int numberOfThreads ) = 0;
 
+    //! Function to set the type of storage of the state transition and sensitivity matrix histories
+    /*!
+     * Function to set the type of storage of the state transition and sensitivity matrix histories, from which the state
+     * transition matrix interface interpolates (see MatrixHistoryStorageSettings). Memory-mapped storage limits the
+     * memory used by long (multi-arc) propagations with many parameters to the epochs that are actually used. The
+     * settings are applied the next time the variational equations are integrated.
+     * \param matrixHistoryStorageSettings Settings for the storage of the matrix histories (in-memory if nullptr).
+     */
+    virtual void setMatrixHistoryStorageSettings(
+            const std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings )
+    {
+        matrixHistoryStorageSettings_ = matrixHistoryStorageSettings;
+    }
+
+    //! Function to retrieve the settings for the storage of the state transition and sensitivity matrix histories
+    /*!
+     * Function to retrieve the settings for the storage of the state transition and sensitivity matrix histories
+     * \return Settings for the storage of the matrix histories (in-memory if nullptr).
+     */
+    std::shared_ptr< MatrixHistoryStorageSettings > getMatrixHistoryStorageSettings( )
+    {
+        return matrixHistoryStorageSettings_;
+    }
 
 protected:
 
@@ -209,6 +244,9 @@ protected:
 
     //! Object used for interpolating numerical results of state transition and sensitivity matrix.
     std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface_;
+
+    //! Settings for the storage of the state transition and sensitivity matrix histories (in-memory if nullptr).
+    std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings_;
 };
 
 //! Function to separate the time histories of the sensitivity and state transition matrices from a full numerical solution.
@@ -269,6 +307,7 @@ void setVariationalEquationsSolution(
  *  is state transition matrix history, second entry is sensitivity matrix history.
  * \param clearRawSolution Boolean denoting whether to clear entries of variationalEquationsSolution after creation
  * of interpolators.
+ * \param matrixHistoryStorageSettings Settings for the storage of the matrix histories (in-memory if nullptr).
  */
 void createStateTransitionAndSensitivityMatrixInterpolator(
         std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >&
@@ -276,7 +315,8 @@ void createStateTransitionAndSensitivityMatrixInterpolator(
         std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >&
         sensitivityMatrixInterpolator,
         std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution,
-        const bool clearRawSolution = 1 );
+        const bool clearRawSolution = 1,
+        const std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings = nullptr );
 
 //! Function to check the consistency between propagation settings of equations of motion, and estimated parameters.
 /*!
@@ -830,6 +870,18 @@ public:
         return getDynamicsSimulator( );
     }
 
+    //! Function to set the number of threads used to evaluate the variational equations
+    /*!
+     * Function to set the number of threads used to evaluate the variational equations (see
+     * VariationalEquations::setNumberOfEvaluationThreads)
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    void setNumberOfVariationalEquationsThreads( const unsigned int numberOfThreads )
+    {
+        variationalEquationsObject_->setNumberOfEvaluationThreads( numberOfThreads );
+    }
+
     //! Function to reset parameter estimate and re-integrate equations of motion and, if desired, variational equations.
     /*!
      *  Function to reset parameter estimate and re-integrate equations of motion and, if desired, variational equations
@@ -888,7 +940,7 @@ private:
                 sensitivityMatrixInterpolator;
         createStateTransitionAndSensitivityMatrixInterpolator(
                     stateTransitionMatrixInterpolator, sensitivityMatrixInterpolator, variationalEquationsSolution_,
-                    this->clearNumericalSolution_ );
+                    this->clearNumericalSolution_, this->matrixHistoryStorageSettings_ );
 
         // Create (if non-existent) or reset state transition matrix interface
         if( stateTransitionInterface_ == nullptr )
@@ -1143,10 +1195,7 @@ public:
     void integrateDynamicalEquationsOfMotionOnly(
             const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialStateEstimate )
     {
-        for( int i = 0; i < numberOfArcs_; i++ )
-        {
-            dynamicsStateDerivatives_.at( i )->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 0 );
-        }
+        setDynamicsOnlyPropagationSettings( );
 
         dynamicsSimulator_->integrateEquationsOfMotion( initialStateEstimate );
     }
@@ -1161,10 +1210,7 @@ public:
     void integrateDynamicalEquationsOfMotionOnly(
             const std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& initialStateEstimate )
     {
-        for( int i = 0; i < numberOfArcs_; i++ )
-        {
-            dynamicsStateDerivatives_.at( i )->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 0 );
-        }
+        setDynamicsOnlyPropagationSettings( );
 
         dynamicsSimulator_->integrateEquationsOfMotion( initialStateEstimate );
     }
@@ -1233,8 +1279,6 @@ public:
         if( integrateEquationsConcurrently )
         {
             // Allocate maps that stored numerical solution for equations of motion
-            std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
-                    currentEquationsOfMotionNumericalSolutionsRaw;
             std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
                     equationsOfMotionNumericalSolutions;
             std::vector< std::map< TimeType, Eigen::Matrix< double, Eigen::Dynamic, 1 > > >
@@ -1245,84 +1289,41 @@ public:
 
             dependentVariableHistorySolutions.resize( numberOfArcs_ );
             cumulativeComputationTimeHistorySolutions.resize( numberOfArcs_ );
+            arcInitialStates.resize( numberOfArcs_ );
 
-            // Integrate equations for all arcs.
+            // If initial state is NaN, this signals that the initial state is to be taken from previous arc. Arcs for which
+            // this is not the case start a new sequence of arcs that have to be propagated one after the other.
+            std::vector< std::vector< unsigned int > > arcSequences;
             for( int i = 0; i < numberOfArcs_; i++ )
             {
-                std::cout<<"Integrating arc "<<i<<" of "<<numberOfArcs_<<std::endl;
-
-                // Retrieve integrator settings, and ensure correct initial time.
-                std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings =
-                        singleArcDynamicsSimulators.at( i )->getIntegratorSettings( );
-                integratorSettings->initialTime_ = arcStartTimes_.at( i );
-
-                // Set state derivative model to propagate both variational equations and equations of motion
-                singleArcDynamicsSimulators.at( i )->getDynamicsStateDerivative( )->setPropagationSettings(
-                            std::vector< IntegratedStateType >( ), 1, 1 );
-
-
-                // Get arc initial state. If initial state is NaN, this signals that the initial state is to be taken from
-                // previous arc
-                VectorType currentArcInitialState;
-
                 if( ( i == 0 ) || ( !linear_algebra::doesMatrixHaveNanEntries( initialStateEstimate.at( i ) ) ) )
                 {
-                    currentArcInitialState = initialStateEstimate.at( i );
+                    arcSequences.push_back( std::vector< unsigned int >( ) );
                 }
                 else
                 {
-                    currentArcInitialState = getArcInitialStateFromPreviousArcResult(
-                                equationsOfMotionNumericalSolutions.at( i - 1 ), arcStartTimes_.at( i ) );
                     updateInitialStates = true;
                 }
-                arcInitialStates.push_back( currentArcInitialState );
-
-                // Update state derivative model to (possible) update in state.
-                singleArcDynamicsSimulators.at( i )->getDynamicsStateDerivative( )->
-                        updateStateDerivativeModelSettings( currentArcInitialState );
-
-                // Create initial state for combined variational/equations of motion.
-                MatrixType initialVariationalState = this->createInitialConditions(
-                            currentArcInitialState );
-
-
-                // Integrate variational and state equations.
-                dynamicsSimulator_->getDynamicsStateDerivative( ).at( i )->resetFunctionEvaluationCounter( );
-                simulation_setup::setAreBodiesInPropagation( bodyMap_, true );
-                std::map< TimeType, MatrixType > rawNumericalSolution;
-                EquationIntegrationInterface< MatrixType, TimeType >::integrateEquations(
-                            singleArcDynamicsSimulators.at( i )->getStateDerivativeFunction( ),
-                            rawNumericalSolution,
-                            initialVariationalState, integratorSettings,
-                            singleArcDynamicsSimulators.at( i )->getPropagationTerminationCondition( ),
-                            dependentVariableHistorySolutions.at( i ),
-                            cumulativeComputationTimeHistorySolutions.at( i ),
-                            singleArcDynamicsSimulators.at( i )->getDependentVariablesFunctions( ),
-                            std::bind(
-                                &DynamicsStateDerivativeModel< TimeType, StateScalarType >::postProcessStateAndVariationalEquations,
-                                singleArcDynamicsSimulators.at( i )->getDynamicsStateDerivative( ), std::placeholders::_1 ) );
-                simulation_setup::setAreBodiesInPropagation( bodyMap_, false );
-
-                // Extract solution of equations of motion.
-                utilities::createVectorBlockMatrixHistory(
-                            rawNumericalSolution, currentEquationsOfMotionNumericalSolutionsRaw,
-                            std::make_pair( 0, parameterVectorSize_ ), stateTransitionMatrixSize_ );
-
-
-                // Transform equations of motion solution to output formulation
-                convertNumericalStateSolutionsToOutputSolutions(
-                            equationsOfMotionNumericalSolutions[ i ], currentEquationsOfMotionNumericalSolutionsRaw,
-                            dynamicsStateDerivatives_.at( i ) );
-                arcStartTimes_[ i ] = equationsOfMotionNumericalSolutions[ i ].begin( )->first;
-
-                // Save state transition and sensitivity matrix solutions for current arc.
-                setVariationalEquationsSolution(
-                            rawNumericalSolution, variationalEquationsSolution_[ i ],
-                            std::make_pair( 0, 0 ), std::make_pair( 0, stateTransitionMatrixSize_ ),
-                            stateTransitionMatrixSize_, parameterVectorSize_ );
-
+                arcSequences.back( ).push_back( i );
             }
 
+            // Integrate equations for all arcs, with independent sequences of arcs distributed over the available threads
+            // (if parallel arc propagation is used). Each thread only uses the solver (and environment) assigned to it.
+            synchronizeWorkerParameterValues( );
+            utilities::executeTasksInParallel(
+                        arcSequences.size( ), workerVariationalEquationsSolvers_.size( ) + 1,
+                        [ & ]( const unsigned int sequenceIndex, const unsigned int threadIndex )
+            {
+                for( unsigned int arcIndex: arcSequences.at( sequenceIndex ) )
+                {
+                    integrateSingleArcVariationalAndDynamicalEquations(
+                                arcIndex, threadIndex, initialStateEstimate.at( arcIndex ),
+                                arcInitialStates.at( arcIndex ), equationsOfMotionNumericalSolutions,
+                                dependentVariableHistorySolutions.at( arcIndex ),
+                                cumulativeComputationTimeHistorySolutions.at( arcIndex ) );
+                }
+            } );
+
             // Process numerical solution of equations of motion
             dynamicsSimulator_->manuallySetAndProcessRawNumericalEquationsOfMotionSolution(
                         equationsOfMotionNumericalSolutions, dependentVariableHistorySolutions,
@@ -1433,6 +1434,108 @@ public:
         return getDynamicsSimulator( );
     }
 
+    //! Function to set up the concurrent propagation of independent arcs.
+    /*!
+     *  Function to set up the concurrent propagation of independent arcs, for both the combined propagation of the
+     *  dynamics and variational equations, and the propagation of the dynamics only (see
+     *  MultiArcDynamicsSimulator::setParallelArcPropagation). Each arc for which an initial state is provided starts a
+     *  sequence of arcs that is propagated independently of the other sequences, and these sequences are distributed
+     *  over the requested number of threads. The first thread uses this object. For each additional thread, the
+     *  workerSolverCreationFunction is called (once, when calling this function), which must return a multi-arc
+     *  variational equations solver with the same arcs, settings and estimated parameters as this object, but created from
+     *  a newly created body map, acceleration models, integrator settings and parameter set. Before each propagation,
+     *  the current parameter values of this object are set in the worker solvers. The interpolators of the state
+     *  transition and sensitivity matrices are then created concurrently on the same number of threads. Since the
+     *  propagation of each arc is fully determined by its environment and settings, the results are identical to those of
+     *  the serial propagation, which is used by default.
+     *  \param numberOfThreads Number of threads to use (1 to disable parallel arc propagation; 0 to use all threads
+     *  available on the current machine).
+     *  \param workerSolverCreationFunction Function creating a multi-arc variational equations solver, with its own
+     *  environment, to be used by a single additional thread.
+     */
+    void setParallelArcPropagation(
+            const unsigned int numberOfThreads,
+            const std::function< std::shared_ptr< MultiArcVariationalEquationsSolver< StateScalarType, TimeType > >( ) >&
+            workerSolverCreationFunction = nullptr )
+    {
+        workerVariationalEquationsSolvers_.clear( );
+
+        unsigned int numberOfUsedThreads =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        if( numberOfUsedThreads > 1 && workerSolverCreationFunction == nullptr )
+        {
+            throw std::runtime_error( "Error when setting parallel multi-arc variational equations propagation, no function "
+                                      "to create environment for additional threads provided." );
+        }
+
+        // Create worker solvers, and check consistency of estimated parameters
+        std::vector< std::shared_ptr< MultiArcVariationalEquationsSolver< StateScalarType, TimeType > > > workerSolvers;
+        for( unsigned int i = 1; i < numberOfUsedThreads; i++ )
+        {
+            std::shared_ptr< MultiArcVariationalEquationsSolver< StateScalarType, TimeType > > workerSolver =
+                    workerSolverCreationFunction( );
+            if( workerSolver == nullptr )
+            {
+                throw std::runtime_error( "Error when setting parallel multi-arc variational equations propagation, worker "
+                                          "solver is not defined." );
+            }
+
+            if( workerSolver->getParametersToEstimate( ) == parametersToEstimate_ ||
+                    workerSolver->getParametersToEstimate( )->getParameterSetSize( ) !=
+                    parametersToEstimate_->getParameterSetSize( ) )
+            {
+                throw std::runtime_error( "Error when setting parallel multi-arc variational equations propagation, "
+                                          "estimated parameters of worker solver are shared or inconsistent." );
+            }
+            workerSolvers.push_back( workerSolver );
+        }
+
+        // Set up parallel propagation of dynamics only (which checks the consistency of the arcs and environment)
+        unsigned int currentWorkerIndex = 0;
+        dynamicsSimulator_->setParallelArcPropagation(
+                    numberOfUsedThreads, [ & ]( )
+        {
+            return workerSolvers.at( currentWorkerIndex++ )->getDynamicsSimulator( );
+        } );
+
+        workerVariationalEquationsSolvers_ = workerSolvers;
+    }
+
+    //! Function to retrieve the number of threads used for propagating independent arcs
+    /*!
+     * Function to retrieve the number of threads used for propagating independent arcs
+     * \return Number of threads used for propagating independent arcs
+     */
+    unsigned int getNumberOfArcPropagationThreads( )
+    {
+        return workerVariationalEquationsSolvers_.size( ) + 1;
+    }
+
+    //! Function to set the number of threads used to evaluate the variational equations
+    /*!
+     * Function to set the number of threads used to evaluate the variational equations (see
+     * VariationalEquations::setNumberOfEvaluationThreads). Since the arcs are propagated one after the other, a single
+     * set of worker threads is shared by the variational equations of all arcs.
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    void setNumberOfVariationalEquationsThreads( const unsigned int numberOfThreads )
+    {
+        const unsigned int numberOfUsedThreads =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        std::shared_ptr< utilities::ParallelTaskExecutor > columnBlockTaskExecutor;
+        if( numberOfUsedThreads > 1 )
+        {
+            columnBlockTaskExecutor = std::make_shared< utilities::ParallelTaskExecutor >( numberOfUsedThreads );
+        }
+
+        for( unsigned int i = 0; i < dynamicsStateDerivatives_.size( ); i++ )
+        {
+            dynamicsStateDerivatives_.at( i )->getVariationalEquationsCalculator( )->setEvaluationTaskExecutor(
+                        columnBlockTaskExecutor );
+        }
+    }
+
 
 
     //! Function to reset parameter estimate and re-integrate equations of motion and, if desired, variational equations.
@@ -1518,11 +1621,15 @@ private:
         stateTransitionMatrixInterpolators.resize( variationalEquationsSolution_.size( ) );
         sensitivityMatrixInterpolators.resize( variationalEquationsSolution_.size( ) );
 
-        // Create interpolators.
+        // Create interpolators (distributed over the threads used for arc propagation, as arcs are independent).
         arcEndTimes_.resize( variationalEquationsSolution_.size( ) );
-        for( unsigned int i = 0; i < variationalEquationsSolution_.size( ); i++ )
+        std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > singleArcDynamicsSimulators =
+                dynamicsSimulator_->getSingleArcDynamicsSimulators( );
+        utilities::executeTasksInParallel(
+                    variationalEquationsSolution_.size( ), workerVariationalEquationsSolvers_.size( ) + 1,
+                    [ & ]( const unsigned int i, const unsigned int )
         {
-            if( dynamicsSimulator_->getSingleArcDynamicsSimulators( ).at( i )->getIntegratorSettings( )->initialTimeStep_ > 0.0 )
+            if( singleArcDynamicsSimulators.at( i )->getIntegratorSettings( )->initialTimeStep_ > 0.0 )
             {
                 arcEndTimes_[ i ] = variationalEquationsSolution_[ i ][ 0 ].rbegin( )->first;
             }
@@ -1535,8 +1642,8 @@ private:
                         stateTransitionMatrixInterpolators[ i ],
                         sensitivityMatrixInterpolators[ i ],
                         variationalEquationsSolution_[ i ],
-                        this->clearNumericalSolution_ );
-        }
+                        this->clearNumericalSolution_, this->matrixHistoryStorageSettings_ );
+        } );
 
         // Create stare transition matrix interface if needed, reset otherwise.
         if( stateTransitionInterface_ == nullptr )
@@ -1557,6 +1664,142 @@ private:
         }
     }
 
+    //! Function to integrate the variational equations and equations of motion of a single arc.
+    /*!
+     *  Function to integrate the variational equations and equations of motion of a single arc, and store the solution of
+     *  the variational equations in this object. If the arc's initial state is to be taken from the previous arc, the
+     *  previous arc must have been propagated before calling this function.
+     *  \param arcIndex Index of the arc that is to be propagated.
+     *  \param threadIndex Index of the thread on which the arc is propagated (0 for the thread using this object), which
+     *  determines the solver (and environment) that is used for the propagation.
+     *  \param inputInitialState Initial state of arc, as provided by the user (NaN to take initial state from previous arc).
+     *  \param arcInitialState Initial state with which the arc was propagated (returned by reference).
+     *  \param equationsOfMotionNumericalSolutions Numerical solution of the equations of motion of all arcs, in which the
+     *  solution of the current arc is set.
+     *  \param dependentVariableHistory Dependent variable history of the current arc (returned by reference).
+     *  \param cumulativeComputationTimeHistory Cumulative computation time history of the current arc (returned by
+     *  reference).
+     */
+    void integrateSingleArcVariationalAndDynamicalEquations(
+            const unsigned int arcIndex,
+            const unsigned int threadIndex,
+            const VectorType& inputInitialState,
+            VectorType& arcInitialState,
+            std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
+            equationsOfMotionNumericalSolutions,
+            std::map< TimeType, Eigen::Matrix< double, Eigen::Dynamic, 1 > >& dependentVariableHistory,
+            std::map< TimeType, double >& cumulativeComputationTimeHistory )
+    {
+        // Print progress (serialized, as arcs may be propagated on several threads concurrently).
+        {
+            static std::mutex outputMutex;
+            std::lock_guard< std::mutex > outputLock( outputMutex );
+            std::cout<<"Integrating arc "<<arcIndex<<" of "<<numberOfArcs_<<std::endl;
+        }
+
+        // Retrieve solver (and environment) that is to be used on current thread
+        MultiArcVariationalEquationsSolver< StateScalarType, TimeType >* threadSolver =
+                ( threadIndex == 0 ) ? this : workerVariationalEquationsSolvers_.at( threadIndex - 1 ).get( );
+        std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > singleArcDynamicsSimulator =
+                threadSolver->dynamicsSimulator_->getSingleArcDynamicsSimulators( ).at( arcIndex );
+
+        // Retrieve integrator settings, and ensure correct initial time.
+        std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings =
+                singleArcDynamicsSimulator->getIntegratorSettings( );
+        integratorSettings->initialTime_ = arcStartTimes_.at( arcIndex );
+
+        // Set state derivative model to propagate both variational equations and equations of motion
+        singleArcDynamicsSimulator->getDynamicsStateDerivative( )->setPropagationSettings(
+                    std::vector< IntegratedStateType >( ), 1, 1 );
+
+        // Get arc initial state. If initial state is NaN, this signals that the initial state is to be taken from
+        // previous arc
+        if( ( arcIndex == 0 ) || ( !linear_algebra::doesMatrixHaveNanEntries( inputInitialState ) ) )
+        {
+            arcInitialState = inputInitialState;
+        }
+        else
+        {
+            arcInitialState = getArcInitialStateFromPreviousArcResult(
+                        equationsOfMotionNumericalSolutions.at( arcIndex - 1 ), arcStartTimes_.at( arcIndex ) );
+        }
+
+        // Update state derivative model to (possible) update in state.
+        singleArcDynamicsSimulator->getDynamicsStateDerivative( )->updateStateDerivativeModelSettings( arcInitialState );
+
+        // Create initial state for combined variational/equations of motion.
+        MatrixType initialVariationalState = this->createInitialConditions( arcInitialState );
+
+        // Integrate variational and state equations.
+        threadSolver->dynamicsSimulator_->getDynamicsStateDerivative( ).at( arcIndex )->resetFunctionEvaluationCounter( );
+        simulation_setup::setAreBodiesInPropagation( threadSolver->bodyMap_, true );
+        std::map< TimeType, MatrixType > rawNumericalSolution;
+        EquationIntegrationInterface< MatrixType, TimeType >::integrateEquations(
+                    singleArcDynamicsSimulator->getStateDerivativeFunction( ),
+                    rawNumericalSolution,
+                    initialVariationalState, integratorSettings,
+                    singleArcDynamicsSimulator->getPropagationTerminationCondition( ),
+                    dependentVariableHistory,
+                    cumulativeComputationTimeHistory,
+                    singleArcDynamicsSimulator->getDependentVariablesFunctions( ),
+                    std::bind(
+                        &DynamicsStateDerivativeModel< TimeType, StateScalarType >::postProcessStateAndVariationalEquations,
+                        singleArcDynamicsSimulator->getDynamicsStateDerivative( ), std::placeholders::_1 ) );
+        simulation_setup::setAreBodiesInPropagation( threadSolver->bodyMap_, false );
+
+        // Extract solution of equations of motion.
+        std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > currentEquationsOfMotionNumericalSolutionsRaw;
+        utilities::createVectorBlockMatrixHistory(
+                    rawNumericalSolution, currentEquationsOfMotionNumericalSolutionsRaw,
+                    std::make_pair( 0, parameterVectorSize_ ), stateTransitionMatrixSize_ );
+
+        // Transform equations of motion solution to output formulation
+        convertNumericalStateSolutionsToOutputSolutions(
+                    equationsOfMotionNumericalSolutions[ arcIndex ], currentEquationsOfMotionNumericalSolutionsRaw,
+                    threadSolver->dynamicsStateDerivatives_.at( arcIndex ) );
+        arcStartTimes_[ arcIndex ] = equationsOfMotionNumericalSolutions[ arcIndex ].begin( )->first;
+
+        // Save state transition and sensitivity matrix solutions for current arc.
+        setVariationalEquationsSolution(
+                    rawNumericalSolution, variationalEquationsSolution_[ arcIndex ],
+                    std::make_pair( 0, 0 ), std::make_pair( 0, stateTransitionMatrixSize_ ),
+                    stateTransitionMatrixSize_, parameterVectorSize_ );
+    }
+
+    //! Function to set the values of the estimated parameters of the worker solvers equal to those of this object.
+    void synchronizeWorkerParameterValues( )
+    {
+        if( workerVariationalEquationsSolvers_.size( ) > 0 )
+        {
+            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > parameterValues =
+                    parametersToEstimate_->template getFullParameterValues< StateScalarType >( );
+            for( unsigned int i = 0; i < workerVariationalEquationsSolvers_.size( ); i++ )
+            {
+                workerVariationalEquationsSolvers_.at( i )->getParametersToEstimate( )->template
+                        resetParameterValues< StateScalarType >( parameterValues );
+            }
+        }
+    }
+
+    //! Function to set the state derivative models of all arcs (on all threads) to propagate the dynamics only.
+    void setDynamicsOnlyPropagationSettings( )
+    {
+        for( int i = 0; i < numberOfArcs_; i++ )
+        {
+            dynamicsStateDerivatives_.at( i )->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 0 );
+        }
+
+        for( unsigned int i = 0; i < workerVariationalEquationsSolvers_.size( ); i++ )
+        {
+            for( int j = 0; j < numberOfArcs_; j++ )
+            {
+                workerVariationalEquationsSolvers_.at( i )->dynamicsStateDerivatives_.at( j )->setPropagationSettings(
+                            std::vector< IntegratedStateType >( ), 1, 0 );
+            }
+        }
+        synchronizeWorkerParameterValues( );
+    }
+
     std::vector< std::vector< std::pair< int, int > > > getArcWiseStatePartialAdditionIndices( )
     {
         std::vector< std::vector< std::pair< int, int > > > partialIndices;
@@ -1597,6 +1840,14 @@ private:
     //! Boolean denoting whether to reset the multi-arc dynamics after propagation.
     const bool resetMultiArcDynamicsAfterPropagation_;
 
+    //! Solvers (each with their own environment) used by additional threads for parallel arc propagation.
+    /*!
+     *  Solvers (each with their own environment) used by additional threads for parallel arc propagation. Entry i is
+     *  used by thread i + 1. Empty if arcs are propagated serially (default).
+     */
+    std::vector< std::shared_ptr< MultiArcVariationalEquationsSolver< StateScalarType, TimeType > > >
+    workerVariationalEquationsSolvers_;
+
 };
 
 //! Class to manage and execute the numerical integration of variational equations of a dynamical system in a combination
@@ -1950,6 +2201,33 @@ public:
         throw std::runtime_error( "Error, getDynamicsSimulatorBase not implemented in hyrbid arc propagator" );
     }
 
+    //! Function to set the number of threads used to evaluate the variational equations
+    /*!
+     * Function to set the number of threads used to evaluate the variational equations, for both the single- and
+     * multi-arc variational equations (see VariationalEquations::setNumberOfEvaluationThreads)
+     * \param numberOfThreads Number of threads to use. A value of 1 (default) denotes serial evaluation, a value of 0
+     * denotes that all available threads are to be used.
+     */
+    void setNumberOfVariationalEquationsThreads( const unsigned int numberOfThreads )
+    {
+        singleArcSolver_->setNumberOfVariationalEquationsThreads( numberOfThreads );
+        multiArcSolver_->setNumberOfVariationalEquationsThreads( numberOfThreads );
+    }
+
+    //! Function to set the type of storage of the state transition and sensitivity matrix histories
+    /*!
+     * Function to set the type of storage of the state transition and sensitivity matrix histories, for both the single-
+     * and multi-arc variational equations solvers.
+     * \param matrixHistoryStorageSettings Settings for the storage of the matrix histories (in-memory if nullptr).
+     */
+    void setMatrixHistoryStorageSettings(
+            const std::shared_ptr< MatrixHistoryStorageSettings > matrixHistoryStorageSettings )
+    {
+        this->matrixHistoryStorageSettings_ = matrixHistoryStorageSettings;
+        singleArcSolver_->setMatrixHistoryStorageSettings( matrixHistoryStorageSettings );
+        multiArcSolver_->setMatrixHistoryStorageSettings( matrixHistoryStorageSettings );
+    }
+
 
     std::shared_ptr< MultiArcVariationalEquationsSolver< StateScalarType, TimeType > > getMultiArcSolver( )
     {
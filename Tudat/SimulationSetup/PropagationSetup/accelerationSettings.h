@@ -16,6 +16,7 @@
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/solarSailAcceleration.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/griddedSphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicAcceleration.h"
@@ -75,17 +76,24 @@ public:
      *  Constructor to set maximum degree and order that is to be taken into account.
      *  \param maximumDegree Maximum degree
      *  \param maximumOrder Maximum order
+     *  \param evaluationAlgorithm Algorithm with which the acceleration is to be evaluated (in spherical coordinates by
+     *  default, or using Cartesian recursion, which is faster for higher degrees and free of polar singularities).
      */
     SphericalHarmonicAccelerationSettings( const int maximumDegree,
-                                           const int maximumOrder ):
+                                           const int maximumOrder,
+                                           const gravitation::SphericalHarmonicsEvaluationAlgorithm evaluationAlgorithm =
+            gravitation::spherical_coordinates_evaluation ):
         AccelerationSettings( basic_astrodynamics::spherical_harmonic_gravity ),
-        maximumDegree_( maximumDegree ), maximumOrder_( maximumOrder ){ }
+        maximumDegree_( maximumDegree ), maximumOrder_( maximumOrder ), evaluationAlgorithm_( evaluationAlgorithm ){ }
 
     //! Maximum degree that is to be used for spherical harmonic acceleration
     int maximumDegree_;
 
     //! Maximum order that is to be used for spherical harmonic acceleration
     int maximumOrder_;
+
+    //! Algorithm with which the spherical harmonic acceleration is to be evaluated
+    gravitation::SphericalHarmonicsEvaluationAlgorithm evaluationAlgorithm_;
 };
 
 //! Class for providing acceleration settings for mutual spherical harmonics acceleration model.
@@ -141,6 +149,101 @@ public:
 
 };
 
+//! Class for providing settings for spherical harmonics acceleration model interpolated from a precomputed grid.
+/*!
+ *  Class for providing settings for spherical harmonics acceleration model interpolated from a precomputed grid of
+ *  accelerations over a spherical shell around the body exerting the acceleration (see
+ *  gravitation::SphericalHarmonicsAccelerationGrid). The grid is either computed from the spherical harmonic gravity
+ *  field of the body exerting the acceleration (and optionally written to a file, from which it is loaded when the
+ *  file exists), or loaded from a file. The grid is created once per settings object, and reused for all acceleration
+ *  models created from the same settings object.
+ */
+class GriddedSphericalHarmonicAccelerationSettings: public AccelerationSettings
+{
+public:
+
+    //! Constructor to set the degree and order of the gravity field and the dimensions of the grid.
+    /*!
+     *  Constructor to set the degree and order of the gravity field and the dimensions of the grid.
+     *  \param maximumDegree Maximum degree of the gravity field that is to be used.
+     *  \param maximumOrder Maximum order of the gravity field that is to be used.
+     *  \param minimumRadius Inner radius of the spherical shell covered by the grid.
+     *  \param maximumRadius Outer radius of the spherical shell covered by the grid.
+     *  \param numberOfRadii Number of grid nodes in radial direction.
+     *  \param numberOfLatitudes Number of grid nodes in latitude, including both poles.
+     *  \param numberOfLongitudes Number of grid nodes in longitude.
+     *  \param gridFileName Name of the file from which the grid is loaded if it exists (in which case its degree, order
+     *  and dimensions must match the settings), and to which the computed grid is written otherwise (not used if empty).
+     *  \param useDirectEvaluationOutsideGrid Boolean denoting whether the acceleration is evaluated directly from the
+     *  spherical harmonic gravity field outside of the grid (if false, an exception is thrown outside of the grid).
+     *  \param numberOfThreads Number of threads used to compute the grid (0 to use all available threads).
+     */
+    GriddedSphericalHarmonicAccelerationSettings( const int maximumDegree,
+                                                  const int maximumOrder,
+                                                  const double minimumRadius,
+                                                  const double maximumRadius,
+                                                  const int numberOfRadii,
+                                                  const int numberOfLatitudes,
+                                                  const int numberOfLongitudes,
+                                                  const std::string& gridFileName = "",
+                                                  const bool useDirectEvaluationOutsideGrid = true,
+                                                  const unsigned int numberOfThreads = 0 ):
+        AccelerationSettings( basic_astrodynamics::gridded_spherical_harmonic_gravity ),
+        maximumDegree_( maximumDegree ), maximumOrder_( maximumOrder ),
+        minimumRadius_( minimumRadius ), maximumRadius_( maximumRadius ),
+        numberOfRadii_( numberOfRadii ), numberOfLatitudes_( numberOfLatitudes ),
+        numberOfLongitudes_( numberOfLongitudes ), gridFileName_( gridFileName ),
+        useDirectEvaluationOutsideGrid_( useDirectEvaluationOutsideGrid ), numberOfThreads_( numberOfThreads ){ }
+
+    //! Constructor to load the grid from a file.
+    /*!
+     *  Constructor to load the grid from a file, written by gravitation::SphericalHarmonicsAccelerationGrid::writeToFile
+     *  (the degree, order and dimensions of the grid are taken from the file).
+     *  \param gridFileName Name of the file from which the grid is to be loaded.
+     *  \param useDirectEvaluationOutsideGrid Boolean denoting whether the acceleration is evaluated directly from the
+     *  spherical harmonic gravity field outside of the grid (if false, an exception is thrown outside of the grid).
+     */
+    GriddedSphericalHarmonicAccelerationSettings( const std::string& gridFileName,
+                                                  const bool useDirectEvaluationOutsideGrid = true ):
+        AccelerationSettings( basic_astrodynamics::gridded_spherical_harmonic_gravity ),
+        maximumDegree_( -1 ), maximumOrder_( -1 ), minimumRadius_( TUDAT_NAN ), maximumRadius_( TUDAT_NAN ),
+        numberOfRadii_( -1 ), numberOfLatitudes_( -1 ), numberOfLongitudes_( -1 ), gridFileName_( gridFileName ),
+        useDirectEvaluationOutsideGrid_( useDirectEvaluationOutsideGrid ), numberOfThreads_( 0 ){ }
+
+    //! Maximum degree of the gravity field that is to be used (-1 if taken from grid file).
+    int maximumDegree_;
+
+    //! Maximum order of the gravity field that is to be used (-1 if taken from grid file).
+    int maximumOrder_;
+
+    //! Inner radius of the spherical shell covered by the grid (NaN if taken from grid file).
+    double minimumRadius_;
+
+    //! Outer radius of the spherical shell covered by the grid (NaN if taken from grid file).
+    double maximumRadius_;
+
+    //! Number of grid nodes in radial direction (-1 if taken from grid file).
+    int numberOfRadii_;
+
+    //! Number of grid nodes in latitude (-1 if taken from grid file).
+    int numberOfLatitudes_;
+
+    //! Number of grid nodes in longitude (-1 if taken from grid file).
+    int numberOfLongitudes_;
+
+    //! Name of the file from which the grid is loaded, or to which it is written (not used if empty).
+    std::string gridFileName_;
+
+    //! Boolean denoting whether the acceleration is evaluated directly outside of the grid.
+    bool useDirectEvaluationOutsideGrid_;
+
+    //! Number of threads used to compute the grid (0 to use all available threads).
+    unsigned int numberOfThreads_;
+
+    //! Grid created from these settings (set when creating the first acceleration model from these settings).
+    std::shared_ptr< gravitation::SphericalHarmonicsAccelerationGrid > accelerationGrid_;
+};
+
 //! Class to proivide settings for typical relativistic corrections to the dynamics of an orbiter.
 /*!
  *  Class to proivide settings for typical relativistic corrections to the dynamics of an orbiter: the
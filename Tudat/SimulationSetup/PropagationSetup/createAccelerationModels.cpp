@@ -10,13 +10,16 @@
 
 #include <algorithm>
 #include <functional>
+#include <iostream>
 #include <memory>
 
+#include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/bind.hpp>
 #include "Tudat/Astrodynamics/Aerodynamics/flightConditions.h"
 #include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
+#include "Tudat/Astrodynamics/Gravitation/timeDependentSphericalHarmonicsGravityField.h"
 #include "Tudat/Astrodynamics/Propulsion/thrustMagnitudeWrapper.h"
 #include "Tudat/Astrodynamics/ReferenceFrames/aerodynamicAngleCalculator.h"
 #include "Tudat/Astrodynamics/ReferenceFrames/referenceFrameTransformations.h"
@@ -89,6 +92,15 @@ std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > cre
                     sumGravitationalParameters,
                     isCentralBody );
         break;
+    case gridded_spherical_harmonic_gravity:
+        accelerationModel = createGriddedSphericalHarmonicsGravityAcceleration(
+                    bodyUndergoingAcceleration,
+                    bodyExertingAcceleration,
+                    nameOfBodyUndergoingAcceleration,
+                    nameOfBodyExertingAcceleration,
+                    accelerationSettings,
+                    sumGravitationalParameters );
+        break;
     default:
 
         std::string errorMessage = "Error when making gravitional acceleration model, cannot parse type " +
@@ -149,6 +161,10 @@ std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > cre
                             centralBody, bodyExertingAcceleration, nameOfCentralBody, nameOfBodyExertingAcceleration,
                             accelerationSettings, "", 1 ) ), nameOfCentralBody );
         break;
+    case gridded_spherical_harmonic_gravity:
+        throw std::runtime_error( "Error when making third-body gravitional acceleration model of " +
+                                  nameOfBodyExertingAcceleration + " on " + nameOfBodyUndergoingAcceleration +
+                                  ", gridded spherical harmonic gravity is only supported as a direct acceleration." );
     default:
 
         std::string errorMessage = "Error when making third-body gravitional acceleration model, cannot parse type " +
@@ -172,7 +188,8 @@ std::shared_ptr< AccelerationModel< Eigen::Vector3d > > createGravitationalAccel
     std::shared_ptr< AccelerationModel< Eigen::Vector3d > > accelerationModelPointer;
     if( accelerationSettings->accelerationType_ != central_gravity &&
             accelerationSettings->accelerationType_ != spherical_harmonic_gravity &&
-            accelerationSettings->accelerationType_ != mutual_spherical_harmonic_gravity )
+            accelerationSettings->accelerationType_ != mutual_spherical_harmonic_gravity &&
+            accelerationSettings->accelerationType_ != gridded_spherical_harmonic_gravity )
     {
         throw std::runtime_error( "Error when making gravitational acceleration, type is inconsistent" );
     }
@@ -376,11 +393,169 @@ createSphericalHarmonicsGravityAcceleration(
                       std::bind( &Body::getPosition, bodyExertingAcceleration ),
                       std::bind( &Body::getCurrentRotationToGlobalFrame,
                                  bodyExertingAcceleration ), useCentralBodyFixedFrame );
+            accelerationModel->setEvaluationAlgorithm( sphericalHarmonicsSettings->evaluationAlgorithm_ );
         }
     }
     return accelerationModel;
 }
 
+//! Function to create spherical harmonic gravity acceleration model interpolated from a precomputed grid.
+std::shared_ptr< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel >
+createGriddedSphericalHarmonicsGravityAcceleration(
+        const std::shared_ptr< Body > bodyUndergoingAcceleration,
+        const std::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration,
+        const std::shared_ptr< AccelerationSettings > accelerationSettings,
+        const bool useCentralBodyFixedFrame )
+{
+    // Dynamic cast acceleration settings to required type and check consistency.
+    std::shared_ptr< GriddedSphericalHarmonicAccelerationSettings > griddedSettings =
+            std::dynamic_pointer_cast< GriddedSphericalHarmonicAccelerationSettings >( accelerationSettings );
+    if( griddedSettings == nullptr )
+    {
+        throw std::runtime_error(
+                    std::string( "Error, acceleration settings inconsistent ") +
+                    " making gridded sh gravitational acceleration of " + nameOfBodyExertingAcceleration +
+                    " on " + nameOfBodyUndergoingAcceleration );
+    }
+
+    // Get pointer to gravity field of central body and cast to required type.
+    std::shared_ptr< SphericalHarmonicsGravityField > sphericalHarmonicsGravityField =
+            std::dynamic_pointer_cast< SphericalHarmonicsGravityField >(
+                bodyExertingAcceleration->getGravityFieldModel( ) );
+    std::shared_ptr< RotationalEphemeris> rotationalEphemeris =
+            bodyExertingAcceleration->getRotationalEphemeris( );
+    if( sphericalHarmonicsGravityField == nullptr )
+    {
+        throw std::runtime_error(
+                    std::string( "Error, spherical harmonic gravity field model not set when ")
+                    + " making gridded sh gravitational acceleration of " +
+                    nameOfBodyExertingAcceleration +
+                    " on " + nameOfBodyUndergoingAcceleration );
+    }
+    else if( rotationalEphemeris == nullptr )
+    {
+        throw std::runtime_error( "Warning when making gridded spherical harmonic acceleration on body " +
+                                  nameOfBodyUndergoingAcceleration + ", no rotation model found for " +
+                                  nameOfBodyExertingAcceleration );
+    }
+    else if( rotationalEphemeris->getTargetFrameOrientation( ) !=
+             sphericalHarmonicsGravityField->getFixedReferenceFrame( ) )
+    {
+        throw std::runtime_error( "Warning when making gridded spherical harmonic acceleration on body " +
+                                  nameOfBodyUndergoingAcceleration + ", rotation model found for " +
+                                  nameOfBodyExertingAcceleration + " is incompatible, frames are: " +
+                                  rotationalEphemeris->getTargetFrameOrientation( ) + " and " +
+                                  sphericalHarmonicsGravityField->getFixedReferenceFrame( ) );
+    }
+
+    // Create (or load) grid, if not yet created from these settings.
+    const bool gridIsSpecified = ( griddedSettings->maximumDegree_ >= 0 );
+    if( griddedSettings->accelerationGrid_ == nullptr )
+    {
+        if( griddedSettings->gridFileName_ != "" && boost::filesystem::exists( griddedSettings->gridFileName_ ) )
+        {
+            griddedSettings->accelerationGrid_ = std::make_shared< SphericalHarmonicsAccelerationGrid >(
+                        griddedSettings->gridFileName_ );
+        }
+        else if( !gridIsSpecified )
+        {
+            throw std::runtime_error( "Error when making gridded spherical harmonic acceleration of " +
+                                      nameOfBodyExertingAcceleration + " on " + nameOfBodyUndergoingAcceleration +
+                                      ", grid file " + griddedSettings->gridFileName_ + " does not exist." );
+        }
+        else
+        {
+            if( std::dynamic_pointer_cast< TimeDependentSphericalHarmonicsGravityField >(
+                        sphericalHarmonicsGravityField ) != nullptr )
+            {
+                std::cerr << "Warning when making gridded spherical harmonic acceleration of " <<
+                             nameOfBodyExertingAcceleration << " on " << nameOfBodyUndergoingAcceleration <<
+                             ", gravity field variations are not included in grid" << std::endl;
+            }
+
+            griddedSettings->accelerationGrid_ = std::make_shared< SphericalHarmonicsAccelerationGrid >(
+                        sphericalHarmonicsGravityField, griddedSettings->maximumDegree_,
+                        griddedSettings->maximumOrder_, griddedSettings->minimumRadius_,
+                        griddedSettings->maximumRadius_, griddedSettings->numberOfRadii_,
+                        griddedSettings->numberOfLatitudes_, griddedSettings->numberOfLongitudes_,
+                        griddedSettings->numberOfThreads_ );
+            if( griddedSettings->gridFileName_ != "" )
+            {
+                griddedSettings->accelerationGrid_->writeToFile( griddedSettings->gridFileName_ );
+            }
+        }
+    }
+    std::shared_ptr< SphericalHarmonicsAccelerationGrid > accelerationGrid = griddedSettings->accelerationGrid_;
+
+    // Check consistency of grid with settings and gravity field.
+    if( accelerationGrid->getReferenceRadius( ) != sphericalHarmonicsGravityField->getReferenceRadius( ) )
+    {
+        throw std::runtime_error( "Error when making gridded spherical harmonic acceleration of " +
+                                  nameOfBodyExertingAcceleration + " on " + nameOfBodyUndergoingAcceleration +
+                                  ", reference radius of grid is inconsistent with gravity field." );
+    }
+    else if( gridIsSpecified && (
+                 accelerationGrid->getMaximumDegree( ) != griddedSettings->maximumDegree_ ||
+                 accelerationGrid->getMaximumOrder( ) != griddedSettings->maximumOrder_ ||
+                 accelerationGrid->getMinimumRadius( ) != griddedSettings->minimumRadius_ ||
+                 accelerationGrid->getMaximumRadius( ) != griddedSettings->maximumRadius_ ||
+                 accelerationGrid->getNumberOfRadii( ) != griddedSettings->numberOfRadii_ ||
+                 accelerationGrid->getNumberOfLatitudes( ) != griddedSettings->numberOfLatitudes_ ||
+                 accelerationGrid->getNumberOfLongitudes( ) != griddedSettings->numberOfLongitudes_ ) )
+    {
+        throw std::runtime_error( "Error when making gridded spherical harmonic acceleration of " +
+                                  nameOfBodyExertingAcceleration + " on " + nameOfBodyUndergoingAcceleration +
+                                  ", grid (file) is inconsistent with acceleration settings." );
+    }
+
+    std::function< double( ) > gravitationalParameterFunction;
+
+    // Check if mutual acceleration is to be used.
+    if( useCentralBodyFixedFrame == false ||
+            bodyUndergoingAcceleration->getGravityFieldModel( ) == nullptr )
+    {
+        gravitationalParameterFunction =
+                std::bind( &SphericalHarmonicsGravityField::getGravitationalParameter,
+                           sphericalHarmonicsGravityField );
+    }
+    else
+    {
+        // Create function returning summed gravitational parameter of the two bodies.
+        std::function< double( ) > gravitationalParameterOfBodyExertingAcceleration =
+                std::bind( &gravitation::GravityFieldModel::getGravitationalParameter,
+                           sphericalHarmonicsGravityField );
+        std::function< double( ) > gravitationalParameterOfBodyUndergoingAcceleration =
+                std::bind( &gravitation::GravityFieldModel::getGravitationalParameter,
+                           bodyUndergoingAcceleration->getGravityFieldModel( ) );
+        gravitationalParameterFunction =
+                std::bind( &utilities::sumFunctionReturn< double >,
+                           gravitationalParameterOfBodyExertingAcceleration,
+                           gravitationalParameterOfBodyUndergoingAcceleration );
+    }
+
+    // Create spherical harmonic acceleration model that is used outside of the grid.
+    std::shared_ptr< SphericalHarmonicsGravitationalAccelerationModel > directAccelerationModel;
+    if( griddedSettings->useDirectEvaluationOutsideGrid_ )
+    {
+        directAccelerationModel = createSphericalHarmonicsGravityAcceleration(
+                    bodyUndergoingAcceleration, bodyExertingAcceleration,
+                    nameOfBodyUndergoingAcceleration, nameOfBodyExertingAcceleration,
+                    std::make_shared< SphericalHarmonicAccelerationSettings >(
+                        accelerationGrid->getMaximumDegree( ), accelerationGrid->getMaximumOrder( ),
+                        cartesian_recursion_evaluation ), useCentralBodyFixedFrame );
+    }
+
+    // Create acceleration object.
+    return std::make_shared< GriddedSphericalHarmonicsGravitationalAccelerationModel >(
+                std::bind( &Body::getPosition, bodyUndergoingAcceleration ),
+                gravitationalParameterFunction, accelerationGrid,
+                std::bind( &Body::getPosition, bodyExertingAcceleration ),
+                std::bind( &Body::getCurrentRotationToGlobalFrame, bodyExertingAcceleration ),
+                useCentralBodyFixedFrame, directAccelerationModel );
+}
+
 //! Function to create mutual spherical harmonic gravity acceleration model.
 std::shared_ptr< gravitation::MutualSphericalHarmonicsGravitationalAccelerationModel >
 createMutualSphericalHarmonicsGravityAcceleration(
@@ -1321,6 +1496,12 @@ std::shared_ptr< AccelerationModel< Eigen::Vector3d > > createAccelerationModel(
                     nameOfBodyUndergoingAcceleration, nameOfBodyExertingAcceleration,
                     centralBody, nameOfCentralBody );
         break;
+    case gridded_spherical_harmonic_gravity:
+        accelerationModelPointer = createGravitationalAccelerationModel(
+                    bodyUndergoingAcceleration, bodyExertingAcceleration, accelerationSettings,
+                    nameOfBodyUndergoingAcceleration, nameOfBodyExertingAcceleration,
+                    centralBody, nameOfCentralBody );
+        break;
     case aerodynamic:
         accelerationModelPointer = createAerodynamicAcceleratioModel(
                     bodyUndergoingAcceleration,
@@ -1649,6 +1830,43 @@ basic_astrodynamics::AccelerationMap createAccelerationModelsMap(
     return createAccelerationModelsMap( bodyMap, selectedAccelerationPerBody, centralBodyMap );
 }
 
+//! Function to set up the batched evaluation of all spherical harmonic accelerations exerted by a single body.
+std::shared_ptr< gravitation::BatchedSphericalHarmonicsGravityCache > setBatchedSphericalHarmonicsGravityEvaluation(
+        const basic_astrodynamics::AccelerationMap& accelerationModelMap,
+        const std::string& bodyExertingAcceleration,
+        const unsigned int numberOfThreads )
+{
+    // Retrieve all spherical harmonic accelerations exerted by requested body.
+    std::vector< std::shared_ptr< gravitation::SphericalHarmonicsGravitationalAccelerationModel > > accelerationModels;
+    for( auto accelerationIterator = accelerationModelMap.begin( ); accelerationIterator != accelerationModelMap.end( );
+         accelerationIterator++ )
+    {
+        if( accelerationIterator->second.count( bodyExertingAcceleration ) > 0 )
+        {
+            const std::vector< std::shared_ptr< basic_astrodynamics::AccelerationModel3d > >& currentAccelerations =
+                    accelerationIterator->second.at( bodyExertingAcceleration );
+            for( unsigned int i = 0; i < currentAccelerations.size( ); i++ )
+            {
+                std::shared_ptr< gravitation::SphericalHarmonicsGravitationalAccelerationModel > sphericalHarmonicAcceleration =
+                        std::dynamic_pointer_cast< gravitation::SphericalHarmonicsGravitationalAccelerationModel >(
+                            currentAccelerations.at( i ) );
+                if( sphericalHarmonicAcceleration != nullptr )
+                {
+                    accelerationModels.push_back( sphericalHarmonicAcceleration );
+                }
+            }
+        }
+    }
+
+    std::shared_ptr< gravitation::BatchedSphericalHarmonicsGravityCache > batchedGravityCache;
+    if( accelerationModels.size( ) > 1 )
+    {
+        batchedGravityCache = gravitation::createBatchedSphericalHarmonicsGravityCache(
+                    accelerationModels, numberOfThreads );
+    }
+    return batchedGravityCache;
+}
+
 } // namespace simulation_setup
 
 } // namespace tudat
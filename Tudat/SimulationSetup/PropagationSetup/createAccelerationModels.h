@@ -162,6 +162,33 @@ createSphericalHarmonicsGravityAcceleration(
         const bool useCentralBodyFixedFrame,
         const bool useDegreeZeroTerm = true );
 
+//! Function to create spherical harmonic gravity acceleration model interpolated from a precomputed grid.
+/*!
+ *  Function to create spherical harmonic gravity acceleration model interpolated from a precomputed grid, from bodies
+ *  exerting and undergoing acceleration. The grid is taken from the acceleration settings if it was created before,
+ *  loaded from the grid file in the settings if it exists, and computed from the spherical harmonic gravity field of
+ *  the body exerting the acceleration otherwise (in which case it is written to the grid file, if one is provided).
+ *  \param bodyUndergoingAcceleration Pointer to object of body that is being accelerated.
+ *  \param bodyExertingAcceleration Pointer to object of body that is exerting the spherical
+ *  harmonic gravity acceleration.
+ *  \param nameOfBodyUndergoingAcceleration Name of body that is being accelerated.
+ *  \param nameOfBodyExertingAcceleration Name of body that is exerting the spherical harmonic
+ *  gravity acceleration.
+ *  \param accelerationSettings Settings for acceleration model that is to be created (should
+ *  be of type GriddedSphericalHarmonicAccelerationSettings).
+ *  \param useCentralBodyFixedFrame Boolean setting whether the central attraction of body
+ *  undergoing acceleration on body exerting acceleration is to be included in acceleration model.
+ *  \return Gridded spherical harmonic gravity acceleration model pointer.
+ */
+std::shared_ptr< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel >
+createGriddedSphericalHarmonicsGravityAcceleration(
+        const std::shared_ptr< Body > bodyUndergoingAcceleration,
+        const std::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration,
+        const std::shared_ptr< AccelerationSettings > accelerationSettings,
+        const bool useCentralBodyFixedFrame );
+
 //! Function to create mutual spherical harmonic gravity acceleration model.
 /*!
  *  Function to create mutual spherical harmonic gravity acceleration model from bodies exerting and
@@ -504,6 +531,21 @@ basic_astrodynamics::AccelerationMap createAccelerationModelsMap(
         const std::vector< std::string >& propagatedBodies,
         const std::vector< std::string >& centralBodies );
 
+//! Function to set up the batched evaluation of all spherical harmonic accelerations exerted by a single body.
+/*!
+ *  Function to set up the batched evaluation of all (direct) spherical harmonic gravitational accelerations exerted by a
+ *  single body in a list of acceleration models, so that the accelerations acting on all bodies (e.g. a constellation of
+ *  spacecraft orbiting the same body) are evaluated at once (see createBatchedSphericalHarmonicsGravityCache).
+ *  \param accelerationModelMap List of acceleration models (typically created by createAccelerationModelsMap).
+ *  \param bodyExertingAcceleration Name of body exerting the spherical harmonic accelerations.
+ *  \param numberOfThreads Number of threads over which the evaluation is to be distributed.
+ *  \return Cache with which the accelerations are evaluated (nullptr if less than two such accelerations are found, in
+ *  which case no batched evaluation is set up).
+ */
+std::shared_ptr< gravitation::BatchedSphericalHarmonicsGravityCache > setBatchedSphericalHarmonicsGravityEvaluation(
+        const basic_astrodynamics::AccelerationMap& accelerationModelMap,
+        const std::string& bodyExertingAcceleration,
+        const unsigned int numberOfThreads = 1 );
 
 } // namespace simulation_setup
 
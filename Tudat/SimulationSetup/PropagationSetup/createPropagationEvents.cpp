@@ -0,0 +1,189 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Tudat/SimulationSetup/PropagationSetup/createPropagationEvents.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to compute the eclipse event function from the positions of the light source and occulting body.
+double computeEclipseEventFunction( const Eigen::Vector3d& lightSourcePosition,
+                                    const Eigen::Vector3d& occultingBodyPosition,
+                                    const double lightSourceRadius,
+                                    const double occultingBodyRadius )
+{
+    const double lightSourceDistance = lightSourcePosition.norm( );
+    const double occultingBodyDistance = occultingBodyPosition.norm( );
+
+    double cosineOfSeparation = lightSourcePosition.dot( occultingBodyPosition ) /
+            ( lightSourceDistance * occultingBodyDistance );
+    cosineOfSeparation = std::max( -1.0, std::min( 1.0, cosineOfSeparation ) );
+
+    return std::acos( cosineOfSeparation ) -
+            std::asin( std::min( 1.0, lightSourceRadius / lightSourceDistance ) ) -
+            std::asin( std::min( 1.0, occultingBodyRadius / occultingBodyDistance ) );
+}
+
+//! Function to retrieve the position of a body w.r.t. a central body from their ephemerides.
+Eigen::Vector3d getPositionWithRespectToCentralBody(
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const std::string& bodyName,
+        const std::string& centralBody,
+        const double time )
+{
+    if( bodyName == centralBody )
+    {
+        return Eigen::Vector3d::Zero( );
+    }
+
+    // Central bodies that are not in the body map (e.g. SSB) are taken to be at the global frame origin
+    Eigen::Vector3d position = bodyMap.at( bodyName )->getStateInBaseFrameFromEphemeris< double, double >(
+                time ).segment( 0, 3 );
+    if( bodyMap.count( centralBody ) > 0 )
+    {
+        position -= bodyMap.at( centralBody )->getStateInBaseFrameFromEphemeris< double, double >( time ).segment( 0, 3 );
+    }
+    return position;
+}
+
+//! Function to retrieve the shape model of a body for a propagation event.
+std::shared_ptr< basic_astrodynamics::BodyShapeModel > getShapeModelForPropagationEvent(
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const std::string& bodyName,
+        const std::string& eventName )
+{
+    if( bodyMap.count( bodyName ) == 0 )
+    {
+        throw std::runtime_error( "Error when creating propagation event " + eventName + ", body " + bodyName +
+                                  " not found." );
+    }
+    else if( bodyMap.at( bodyName )->getShapeModel( ) == nullptr )
+    {
+        throw std::runtime_error( "Error when creating propagation event " + eventName + ", body " + bodyName +
+                                  " has no shape model." );
+    }
+    return bodyMap.at( bodyName )->getShapeModel( );
+}
+
+//! Function to create the event function of a single propagation event.
+std::function< double( const double, const Eigen::VectorXd& ) > createPropagationEventFunction(
+        const std::shared_ptr< PropagationEventSettings > eventSettings,
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const int translationalStateStartIndex,
+        const std::string& centralBody )
+{
+    std::function< double( const double, const Eigen::VectorXd& ) > eventFunction;
+    switch( eventSettings->eventType_ )
+    {
+    case custom_propagation_event:
+    {
+        std::shared_ptr< CustomPropagationEventSettings > customEventSettings =
+                std::dynamic_pointer_cast< CustomPropagationEventSettings >( eventSettings );
+        if( customEventSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, expected custom propagation event settings for " +
+                                      eventSettings->eventName_ );
+        }
+        eventFunction = customEventSettings->eventFunction_;
+        break;
+    }
+    case altitude_crossing_event:
+    {
+        std::shared_ptr< AltitudeCrossingEventSettings > altitudeEventSettings =
+                std::dynamic_pointer_cast< AltitudeCrossingEventSettings >( eventSettings );
+        if( altitudeEventSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, expected altitude crossing event settings for " +
+                                      eventSettings->eventName_ );
+        }
+
+        const std::shared_ptr< basic_astrodynamics::BodyShapeModel > shapeModel =
+                getShapeModelForPropagationEvent( bodyMap, centralBody, eventSettings->eventName_ );
+        const std::shared_ptr< ephemerides::RotationalEphemeris > rotationModel =
+                bodyMap.at( centralBody )->getRotationalEphemeris( );
+        const double altitude = altitudeEventSettings->altitude_;
+        if( rotationModel != nullptr )
+        {
+            eventFunction = [ = ]( const double time, const Eigen::VectorXd& state )
+            {
+                const Eigen::Vector3d bodyFixedPosition =
+                        rotationModel->getRotationToTargetFrame( time ) *
+                        Eigen::Vector3d( state.segment( translationalStateStartIndex, 3 ) );
+                return shapeModel->getAltitude( bodyFixedPosition ) - altitude;
+            };
+        }
+        else
+        {
+            eventFunction = [ = ]( const double, const Eigen::VectorXd& state )
+            {
+                return state.segment( translationalStateStartIndex, 3 ).norm( ) - shapeModel->getAverageRadius( ) -
+                        altitude;
+            };
+        }
+        break;
+    }
+    case eclipse_event:
+    {
+        std::shared_ptr< EclipseEventSettings > eclipseEventSettings =
+                std::dynamic_pointer_cast< EclipseEventSettings >( eventSettings );
+        if( eclipseEventSettings == nullptr )
+        {
+            throw std::runtime_error( "Error, expected eclipse event settings for " + eventSettings->eventName_ );
+        }
+
+        const std::string lightSource = eclipseEventSettings->lightSource_;
+        const std::string occultingBody = eclipseEventSettings->occultingBody_;
+        const double lightSourceRadius = getShapeModelForPropagationEvent(
+                    bodyMap, lightSource, eventSettings->eventName_ )->getAverageRadius( );
+        const double occultingBodyRadius = getShapeModelForPropagationEvent(
+                    bodyMap, occultingBody, eventSettings->eventName_ )->getAverageRadius( );
+        eventFunction = [ = ]( const double time, const Eigen::VectorXd& state )
+        {
+            const Eigen::Vector3d position = state.segment( translationalStateStartIndex, 3 );
+            return computeEclipseEventFunction(
+                        getPositionWithRespectToCentralBody( bodyMap, lightSource, centralBody, time ) - position,
+                        getPositionWithRespectToCentralBody( bodyMap, occultingBody, centralBody, time ) - position,
+                        lightSourceRadius, occultingBodyRadius );
+        };
+        break;
+    }
+    case node_crossing_event:
+    {
+        eventFunction = [ = ]( const double, const Eigen::VectorXd& state )
+        {
+            return state( translationalStateStartIndex + 2 );
+        };
+        break;
+    }
+    case apsis_event:
+    {
+        eventFunction = [ = ]( const double, const Eigen::VectorXd& state )
+        {
+            return state.segment( translationalStateStartIndex, 3 ).dot(
+                        state.segment( translationalStateStartIndex + 3, 3 ) );
+        };
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error when creating propagation event " + eventSettings->eventName_ +
+                                  ", event type not recognized." );
+    }
+    return eventFunction;
+}
+
+} // namespace propagators
+
+} // namespace tudat
@@ -0,0 +1,149 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_CREATEPROPAGATIONEVENTS_H
+#define TUDAT_CREATEPROPAGATIONEVENTS_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propagators/dynamicsStateDerivativeModel.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationEventSettings.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to compute the eclipse event function from the positions of the light source and occulting body.
+/*!
+ *  Function to compute the eclipse event function from the positions of the light source and occulting body, as the
+ *  angular separation between their centers minus the sum of their apparent angular radii (see EclipseEventSettings).
+ *  \param lightSourcePosition Position of the light source w.r.t. the body for which eclipses are detected
+ *  \param occultingBodyPosition Position of the occulting body w.r.t. the body for which eclipses are detected
+ *  \param lightSourceRadius Radius of the light source
+ *  \param occultingBodyRadius Radius of the occulting body
+ *  \return Eclipse event function (negative if the light source is (partially) occulted)
+ */
+double computeEclipseEventFunction( const Eigen::Vector3d& lightSourcePosition,
+                                    const Eigen::Vector3d& occultingBodyPosition,
+                                    const double lightSourceRadius,
+                                    const double occultingBodyRadius );
+
+//! Function to create the event function of a single propagation event.
+/*!
+ *  Function to create the event function of a single propagation event, as a function of time and full propagated state
+ *  in conventional form.
+ *  \param eventSettings Settings for the event
+ *  \param bodyMap List of body objects in the simulation
+ *  \param translationalStateStartIndex Index of the translational state of the associated body in the full
+ *  conventional state (not used for custom events)
+ *  \param centralBody Central body w.r.t. which the associated body is propagated (not used for custom events)
+ *  \return Event function of time and full propagated state in conventional form
+ */
+std::function< double( const double, const Eigen::VectorXd& ) > createPropagationEventFunction(
+        const std::shared_ptr< PropagationEventSettings > eventSettings,
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const int translationalStateStartIndex,
+        const std::string& centralBody );
+
+//! Function to retrieve the index in the conventional state, and the central body, of a translationally propagated body.
+/*!
+ *  Function to retrieve the index in the full conventional state, and the central body, of a translationally propagated
+ *  body.
+ *  \param bodyName Name of the propagated body
+ *  \param dynamicsStateDerivative Model computing the state derivative of the propagated dynamics
+ *  \return Pair of index of the Cartesian state of the body in the full conventional state, and its central body
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::pair< int, std::string > getTranslationalStateStartIndexAndCentralBody(
+        const std::string& bodyName,
+        const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative )
+{
+    if( dynamicsStateDerivative->getStateDerivativeModels( ).count( translational_state ) == 0 )
+    {
+        throw std::runtime_error( "Error when retrieving translational state of " + bodyName +
+                                  " for propagation event, no translational dynamics is propagated." );
+    }
+
+    int stateStartIndex = dynamicsStateDerivative->getStateTypeStartIndices( ).at( translational_state );
+    std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > translationalModels =
+            dynamicsStateDerivative->getStateDerivativeModels( ).at( translational_state );
+    for( unsigned int i = 0; i < translationalModels.size( ); i++ )
+    {
+        std::shared_ptr< NBodyStateDerivative< StateScalarType, TimeType > > nBodyModel =
+                std::dynamic_pointer_cast< NBodyStateDerivative< StateScalarType, TimeType > >(
+                    translationalModels.at( i ) );
+        std::vector< std::string > propagatedBodies = nBodyModel->getBodiesToBeIntegratedNumerically( );
+        for( unsigned int j = 0; j < propagatedBodies.size( ); j++ )
+        {
+            if( propagatedBodies.at( j ) == bodyName )
+            {
+                return std::make_pair( stateStartIndex + 6 * j,
+                                       nBodyModel->getCentralBodyData( )->getCentralBodies( ).at( j ) );
+            }
+        }
+        stateStartIndex += translationalModels.at( i )->getConventionalStateSize( );
+    }
+
+    throw std::runtime_error( "Error when retrieving translational state of " + bodyName +
+                              " for propagation event, body is not propagated." );
+}
+
+//! Function to create the function computing the values of all propagation events.
+/*!
+ *  Function to create the function computing the values of all propagation events (returned by reference), from the
+ *  time and full propagated state in conventional form.
+ *  \param eventSettings Settings for the events
+ *  \param bodyMap List of body objects in the simulation
+ *  \param dynamicsStateDerivative Model computing the state derivative of the propagated dynamics
+ *  \return Function computing the values of all events from the time and full propagated state in conventional form
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) > createPropagationEventFunctions(
+        const std::vector< std::shared_ptr< PropagationEventSettings > >& eventSettings,
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative )
+{
+    std::vector< std::function< double( const double, const Eigen::VectorXd& ) > > eventFunctions;
+    for( unsigned int i = 0; i < eventSettings.size( ); i++ )
+    {
+        std::pair< int, std::string > stateStartIndexAndCentralBody = std::make_pair( -1, "" );
+        if( eventSettings.at( i )->eventType_ != custom_propagation_event )
+        {
+            stateStartIndexAndCentralBody = getTranslationalStateStartIndexAndCentralBody< StateScalarType, TimeType >(
+                        eventSettings.at( i )->associatedBody_, dynamicsStateDerivative );
+        }
+        eventFunctions.push_back( createPropagationEventFunction(
+                                      eventSettings.at( i ), bodyMap, stateStartIndexAndCentralBody.first,
+                                      stateStartIndexAndCentralBody.second ) );
+    }
+
+    return [ = ]( const double time, const Eigen::VectorXd& conventionalState, Eigen::VectorXd& eventValues )
+    {
+        eventValues.resize( eventFunctions.size( ) );
+        for( unsigned int i = 0; i < eventFunctions.size( ); i++ )
+        {
+            eventValues( i ) = eventFunctions.at( i )( time, conventionalState );
+        }
+    };
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_CREATEPROPAGATIONEVENTS_H
@@ -248,6 +248,13 @@ createTranslationalStateDerivativeModel(
         throw std::runtime_error( "Error, did not recognize translational state propagation type: " +
                                   std::to_string( translationPropagatorSettings->propagator_ ) );
     }
+
+    // Set (optional) parallel evaluation of acceleration models
+    if( translationPropagatorSettings->numberOfAccelerationEvaluationThreads_ != 1 )
+    {
+        std::dynamic_pointer_cast< NBodyStateDerivative< StateScalarType, TimeType > >( stateDerivativeModel )->
+                setNumberOfAccelerationEvaluationThreads( translationPropagatorSettings->numberOfAccelerationEvaluationThreads_ );
+    }
     return stateDerivativeModel;
 }
 
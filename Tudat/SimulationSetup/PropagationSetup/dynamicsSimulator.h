@@ -12,6 +12,7 @@
 #define TUDAT_DYNAMICSSIMULATOR_H
 
 #include <vector>
+#include <set>
 #include <string>
 #include <chrono>
 
@@ -19,6 +20,7 @@
 
 #include "Tudat/Basics/tudatTypeTraits.h"
 #include "Tudat/Basics/utilities.h"
+#include "Tudat/Basics/parallelExecution.h"
 #include "Tudat/Astrodynamics/Propagators/nBodyStateDerivative.h"
 #include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationSettings.h"
@@ -26,6 +28,7 @@
 #include "Tudat/Astrodynamics/Propagators/integrateEquations.h"
 #include "Tudat/SimulationSetup/PropagationSetup/createStateDerivativeModel.h"
 #include "Tudat/SimulationSetup/PropagationSetup/createEnvironmentUpdater.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createPropagationEvents.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationTermination.h"
 #include "Tudat/Astrodynamics/Propagators/dynamicsStateDerivativeModel.h"
 #include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
@@ -228,6 +231,74 @@ Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getInitialArcWiseStateOfBody
     return initialStates;
 }
 
+//! Function to check whether the propagated dynamics can be integrated with the selected numerical integrator
+/*!
+* Function to check whether the propagated dynamics can be integrated with the selected numerical integrator. Integrators
+* for second-order systems interpret the state as blocks of six entries, of which the last three are the time derivatives
+* of the first three. This only holds for the translational state propagated with the Cowell propagator, so an exception
+* is thrown if such an integrator is used for any other (part of the) propagated state.
+* \param integratorSettings Settings for numerical integrator.
+* \param propagatorSettings Settings for propagator.
+*/
+template< typename StateScalarType = double, typename TimeType = double >
+void checkIntegratorCompatibilityWithPropagatedDynamics(
+        const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+        const std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > propagatorSettings )
+{
+    // Identify integrators for second-order systems
+    std::string integratorName;
+    switch( integratorSettings->integratorType_ )
+    {
+    case numerical_integrators::gaussJackson:
+        integratorName = "Gauss-Jackson";
+        break;
+    case numerical_integrators::rungeKuttaNystromVariableStepSize:
+        integratorName = "Runge-Kutta-Nystrom";
+        break;
+    default:
+        return;
+    }
+
+    // Retrieve settings for each propagated state type
+    std::vector< std::shared_ptr< SingleArcPropagatorSettings< StateScalarType > > > singleTypePropagatorSettings;
+    if( propagatorSettings->getStateType( ) == hybrid )
+    {
+        std::shared_ptr< MultiTypePropagatorSettings< StateScalarType > > multiTypePropagatorSettings =
+                std::dynamic_pointer_cast< MultiTypePropagatorSettings< StateScalarType > >( propagatorSettings );
+        for( auto typeIterator : multiTypePropagatorSettings->propagatorSettingsMap_ )
+        {
+            singleTypePropagatorSettings.insert( singleTypePropagatorSettings.end( ),
+                                                 typeIterator.second.begin( ), typeIterator.second.end( ) );
+        }
+    }
+    else
+    {
+        singleTypePropagatorSettings.push_back( propagatorSettings );
+    }
+
+    // Check that only translational dynamics in Cowell formulation are propagated
+    for( unsigned int i = 0; i < singleTypePropagatorSettings.size( ); i++ )
+    {
+        std::shared_ptr< TranslationalStatePropagatorSettings< StateScalarType > > translationalPropagatorSettings =
+                std::dynamic_pointer_cast< TranslationalStatePropagatorSettings< StateScalarType > >(
+                    singleTypePropagatorSettings.at( i ) );
+        if( singleTypePropagatorSettings.at( i )->getStateType( ) != translational_state ||
+                translationalPropagatorSettings == nullptr )
+        {
+            throw std::runtime_error( "Error in dynamics simulator, the " + integratorName + " integrator can only be "
+                                      "used for translational dynamics, but state type " +
+                                      std::to_string( singleTypePropagatorSettings.at( i )->getStateType( ) ) +
+                                      " is propagated." );
+        }
+        else if( translationalPropagatorSettings->propagator_ != cowell )
+        {
+            throw std::runtime_error( "Error in dynamics simulator, the " + integratorName + " integrator can only be "
+                                      "used with the Cowell propagator, but translational propagator " +
+                                      std::to_string( translationalPropagatorSettings->propagator_ ) + " is selected." );
+        }
+    }
+}
+
 //! Base class for performing full numerical integration of a dynamical system.
 /*!
  *  Base class for performing full numerical integration of a dynamical system. Governing equations are set once,
@@ -422,6 +493,7 @@ public:
         {
             throw std::runtime_error( "Error in dynamics simulator, integrator settings not defined." );
         }
+        checkIntegratorCompatibilityWithPropagatedDynamics( integratorSettings_, propagatorSettings_ );
 
         if( setIntegratedResult_ )
         {
@@ -452,12 +524,26 @@ public:
         propagationTerminationCondition_ = createPropagationTerminationConditions(
                     propagatorSettings_->getTerminationSettings( ), bodyMap_, integratorSettings->initialTimeStep_ );
 
+        // Register models with profiler, if computation time of models is to be recorded
+        if( propagatorSettings_->getProfilePropagation( ) )
+        {
+            propagationProfiler_ = std::make_shared< PropagationProfiler >( );
+            environmentUpdater_->setPropagationProfiler( propagationProfiler_ );
+            for( auto stateDerivativeIterator : dynamicsStateDerivative_->getStateDerivativeModels( ) )
+            {
+                for( unsigned int i = 0; i < stateDerivativeIterator.second.size( ); i++ )
+                {
+                    stateDerivativeIterator.second.at( i )->setPropagationProfiler( propagationProfiler_ );
+                }
+            }
+        }
+
         if( propagatorSettings_->getDependentVariablesToSave( ) != nullptr )
         {
             std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::string > > dependentVariableData =
                     createDependentVariableListFunction< TimeType, StateScalarType >(
                         propagatorSettings_->getDependentVariablesToSave( ), bodyMap_,
-                        dynamicsStateDerivative_->getStateDerivativeModels( ) );
+                        dynamicsStateDerivative_->getStateDerivativeModels( ), propagationProfiler_ );
             dependentVariablesFunctions_ = dependentVariableData.first;
             dependentVariableIds_ = dependentVariableData.second;
 
@@ -503,35 +589,149 @@ public:
             const Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic >& initialStates )
     {
 
-        // Empty solution maps
+        // Empty solution histories
         equationsOfMotionNumericalSolution_.clear( );
         equationsOfMotionNumericalSolutionRaw_.clear( );
+        resetHistoryMaps( );
 
         // Reset functions
         dynamicsStateDerivative_->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 0 );
         dynamicsStateDerivative_->resetFunctionEvaluationCounter( );
         dynamicsStateDerivative_->resetCumulativeFunctionEvaluationCounter( );
+        if( propagationProfiler_ != nullptr )
+        {
+            propagationProfiler_->resetStatistics( );
+        }
 
         // Reset initial time to ensure consistency with multi-arc propagation.
         integratorSettings_->initialTime_ = this->initialPropagationTime_;
 
-        // Integrate equations of motion numerically.
+        // Create function to stream results to output sink, if required
+        const bool isPropagationResumed = !resumeCheckpointFile_.empty( );
+        std::shared_ptr< PropagationOutputSink< StateScalarType, TimeType > > outputSink = getOutputSink( );
+        std::function< void( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                             const Eigen::VectorXd& ) > outputStreamingFunction;
+        numberOfStreamedEpochs_ = 0;
+        if( outputSink != nullptr )
+        {
+            if( !isPropagationResumed )
+            {
+                outputSink->startPropagation( );
+            }
+            outputStreamingFunction = [ this, outputSink ]( const TimeType time,
+                    const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& rawState,
+                    const Eigen::VectorXd& dependentVariables )
+            {
+                outputSink->processOutput(
+                            time, dynamicsStateDerivative_->convertToOutputSolution( rawState, time ), dependentVariables );
+                numberOfStreamedEpochs_++;
+            };
+        }
+
+        // Create function to retrieve the time, state and dependent variables at the end of the propagation
+        finalPropagationTime_ = TUDAT_NAN;
+        finalPropagatedState_.resize( 0 );
+        finalDependentVariables_.resize( 0 );
+        std::function< void( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                             const Eigen::VectorXd& ) > finalStateFunction =
+                [ this ]( const TimeType time, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& rawState,
+                const Eigen::VectorXd& dependentVariables )
+        {
+            finalPropagationTime_ = time;
+            finalPropagatedState_ = dynamicsStateDerivative_->convertToOutputSolution( rawState, time );
+            finalDependentVariables_ = dependentVariables;
+        };
+
+        // Create object to write checkpoints, and/or to resume the propagation from a checkpoint, if required
+        checkpointHandler_ = nullptr;
+        if( propagatorSettings_->getCheckpointSettings( ) != nullptr || isPropagationResumed )
+        {
+            checkpointHandler_ = std::make_shared< PropagationCheckpointHandler >(
+                        propagatorSettings_->getCheckpointSettings( ), resumeCheckpointFile_ );
+            checkpointHandler_->setAdditionalDataFunctions(
+                        [ this ]( std::ostream& checkpointStream )
+            {
+                serialization::writeBinaryIdentifier( checkpointStream, "SingleArcDynamicsSimulator" );
+                serialization::writeBinaryValue( checkpointStream,
+                                                 dynamicsStateDerivative_->getNumberOfFunctionEvaluations( ) );
+                serialization::writeBinaryValue( checkpointStream,
+                                                 dynamicsStateDerivative_->getCumulativeNumberOfFunctionEvaluations( ) );
+                serialization::writeBinaryValue( checkpointStream, numberOfStreamedEpochs_ );
+            },
+            [ this, outputSink ]( std::istream& checkpointStream )
+            {
+                unsigned int functionEvaluationCounter;
+                std::map< TimeType, unsigned int > cumulativeFunctionEvaluationCounter;
+                serialization::readAndCheckBinaryIdentifier( checkpointStream, "SingleArcDynamicsSimulator" );
+                serialization::readBinaryValue( checkpointStream, functionEvaluationCounter );
+                serialization::readBinaryValue( checkpointStream, cumulativeFunctionEvaluationCounter );
+                serialization::readBinaryValue( checkpointStream, numberOfStreamedEpochs_ );
+                dynamicsStateDerivative_->setFunctionEvaluationCounters(
+                            functionEvaluationCounter, cumulativeFunctionEvaluationCounter );
+
+                // Discard output streamed after the checkpoint was written
+                if( outputSink != nullptr )
+                {
+                    outputSink->resumePropagation( numberOfStreamedEpochs_ );
+                }
+            } );
+        }
+
+        // Integrate equations of motion numerically, using a fixed-size state vector if only a single body is propagated
         resetPropagationTerminationConditions( );
         simulation_setup::setAreBodiesInPropagation( bodyMap_, true );
-        propagationTerminationReason_ =
-                EquationIntegrationInterface< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >, TimeType >::integrateEquations(
-                    stateDerivativeFunction_, equationsOfMotionNumericalSolutionRaw_,
-                    dynamicsStateDerivative_->convertFromOutputSolution(
-                        initialStates, this->initialPropagationTime_ ), integratorSettings_,
-                    propagationTerminationCondition_,
-                    dependentVariableHistory_,
-                    cumulativeComputationTimeHistory_,
-                    dependentVariablesFunctions_,
-                    statePostProcessingFunction_,
-                    propagatorSettings_->getPrintInterval( ),
-                    initialClockTime_ );
+        const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > initialPropagatedState =
+                dynamicsStateDerivative_->convertFromOutputSolution( initialStates, this->initialPropagationTime_ );
+        const int fixedPropagatedStateSize = useFixedSizeStatePropagation_ ? getFixedSizePropagatedStateSize( ) : 0;
+        isFixedSizeStatePropagationUsed_ = ( fixedPropagatedStateSize > 0 );
+        detectedEvents_.clear( );
+        if( fixedPropagatedStateSize == 6 )
+        {
+            propagationTerminationReason_ = integrateEquationsOfMotionWithFixedSizeState< 6 >(
+                        initialPropagatedState, outputStreamingFunction, finalStateFunction, checkpointHandler_ );
+        }
+        else if( fixedPropagatedStateSize == 7 )
+        {
+            propagationTerminationReason_ = integrateEquationsOfMotionWithFixedSizeState< 7 >(
+                        initialPropagatedState, outputStreamingFunction, finalStateFunction, checkpointHandler_ );
+        }
+        else
+        {
+            std::shared_ptr< PropagationEventDetector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >, TimeType > >
+                    eventDetector = createPropagationEventDetector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( );
+
+            // Create function to compute state derivative in pre-allocated memory
+            std::function< void( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                                 Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& ) > inPlaceStateDerivativeFunction =
+                    std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::template computeStateDerivativeInPlace<
+                               Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >,
+                               dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3 );
+
+            propagationTerminationReason_ =
+                    EquationIntegrationInterface< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >, TimeType >::integrateEquations(
+                        stateDerivativeFunction_, equationsOfMotionNumericalSolutionRaw_,
+                        initialPropagatedState, integratorSettings_,
+                        propagationTerminationCondition_,
+                        dependentVariableHistory_,
+                        cumulativeComputationTimeHistory_,
+                        dependentVariablesFunctions_,
+                        statePostProcessingFunction_,
+                        propagatorSettings_->getPrintInterval( ),
+                        initialClockTime_,
+                        outputStreamingFunction,
+                        inPlaceStateDerivativeFunction,
+                        checkpointHandler_,
+                        eventDetector,
+                        finalStateFunction );
+            setDetectedEvents( eventDetector );
+        }
         simulation_setup::setAreBodiesInPropagation( bodyMap_, false );
 
+        if( outputSink != nullptr )
+        {
+            outputSink->finalizePropagation( );
+        }
+
         // Convert numerical solution to conventional state
         dynamicsStateDerivative_->convertNumericalStateSolutionsToOutputSolutions(
                     equationsOfMotionNumericalSolution_, equationsOfMotionNumericalSolutionRaw_ );
@@ -552,34 +752,96 @@ public:
         }
     }
 
+    //! This function resumes the numerical integration of the equations of motion from a checkpoint.
+    /*!
+     *  This function resumes the numerical integration of the equations of motion from a checkpoint, written during a
+     *  previous (interrupted) call to integrateEquationsOfMotion, for which checkpoint settings were defined in the
+     *  propagator settings (see SingleArcPropagatorSettings::resetCheckpointSettings). The integrator state, current
+     *  time and state, function evaluation counters and the results saved up to the checkpoint are restored, and the
+     *  propagation is continued, producing results that are bit-identical to those of an uninterrupted propagation. The
+     *  simulator must have been created with the same settings as the simulator that wrote the checkpoint. Output written
+     *  to the output sink (if any) after the checkpoint is discarded. New checkpoints are written during the resumed
+     *  propagation if checkpoint settings are defined.
+     *  \param checkpointFile Name of the checkpoint file from which the propagation is to be resumed
+     */
+    void resumeEquationsOfMotionIntegrationFromCheckpoint( const std::string& checkpointFile )
+    {
+        resumeCheckpointFile_ = checkpointFile;
+        try
+        {
+            integrateEquationsOfMotion( propagatorSettings_->getInitialStates( ) );
+        }
+        catch( ... )
+        {
+            resumeCheckpointFile_.clear( );
+            throw;
+        }
+        resumeCheckpointFile_.clear( );
+    }
+
+    //! Function to retrieve the number of checkpoints written during the last numerical integration.
+    /*!
+     * Function to retrieve the number of checkpoints written during the last numerical integration (see
+     * SingleArcPropagatorSettings::resetCheckpointSettings).
+     * \return Number of checkpoints written during the last numerical integration.
+     */
+    unsigned int getNumberOfWrittenCheckpoints( )
+    {
+        return ( checkpointHandler_ == nullptr ) ? 0 : checkpointHandler_->getNumberOfWrittenCheckpoints( );
+    }
+
+    //! Function to retrieve the events detected during the last numerical integration.
+    /*!
+     * Function to retrieve the events detected during the last numerical integration (see
+     * SingleArcPropagatorSettings::resetEventSettings), in chronological order. The states of the events are given in
+     * conventional form (i.e. as the entries of getEquationsOfMotionNumericalSolution).
+     * \return Events detected during the last numerical integration.
+     */
+    std::vector< DetectedPropagationEvent< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    getDetectedEvents( )
+    {
+        return detectedEvents_;
+    }
+
     //! Function to return the map of state history of numerically integrated bodies.
     /*!
-     * Function to return the map of state history of numerically integrated bodies.
+     * Function to return the map of state history of numerically integrated bodies. The map is created from the
+     * (contiguously stored) state history upon the first call after the propagation, and retained until the next
+     * propagation. Use getEquationsOfMotionNumericalSolutionHistory to access the results without creating the map.
      * \return Map of state history of numerically integrated bodies.
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolution( )
     {
-        return equationsOfMotionNumericalSolution_;
+        return getHistoryMap( equationsOfMotionNumericalSolution_, equationsOfMotionNumericalSolutionMap_,
+                              isEquationsOfMotionNumericalSolutionMapUpToDate_ );
     }
 
     //! Function to return the map of state history of numerically integrated bodies, in propagation coordinates.
     /*!
-     * Function to return the map of state history of numerically integrated bodies, in propagation coordinates.
+     * Function to return the map of state history of numerically integrated bodies, in propagation coordinates. The map
+     * is created from the (contiguously stored) state history upon the first call after the propagation, and retained until
+     * the next propagation. Use getEquationsOfMotionNumericalSolutionRawHistory to access the results without creating
+     * the map.
      * \return Map of state history of numerically integrated bodies, in propagation coordinates.
      */
     const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& getEquationsOfMotionNumericalSolutionRaw( )
     {
-        return equationsOfMotionNumericalSolutionRaw_;
+        return getHistoryMap( equationsOfMotionNumericalSolutionRaw_, equationsOfMotionNumericalSolutionRawMap_,
+                              isEquationsOfMotionNumericalSolutionRawMapUpToDate_ );
     }
 
     //! Function to return the map of dependent variable history that was saved during numerical propagation.
     /*!
-     * Function to return the map of dependent variable history that was saved during numerical propagation.
+     * Function to return the map of dependent variable history that was saved during numerical propagation. The map is
+     * created from the (contiguously stored) dependent variable history upon the first call after the propagation, and
+     * retained until the next propagation. Use getDependentVariableNumericalSolutionHistory to access the results without
+     * creating the map.
      * \return Map of dependent variable history that was saved during numerical propagation.
      */
     const std::map< TimeType, Eigen::VectorXd >& getDependentVariableHistory( )
     {
-        return dependentVariableHistory_;
+        return getHistoryMap( dependentVariableHistory_, dependentVariableHistoryMap_,
+                              isDependentVariableHistoryMapUpToDate_ );
     }
 
     //! Function to return the map of cumulative computation time history that was saved during numerical propagation.
@@ -588,13 +850,114 @@ public:
      * \return Map of cumulative computation time history that was saved during numerical propagation.
      */
     std::map< TimeType, double > getCumulativeComputationTimeHistory( )
+    {
+        return cumulativeComputationTimeHistory_.toMap( );
+    }
+
+    //! Function to return the state history of numerically integrated bodies, stored in contiguous memory.
+    /*!
+     * Function to return the state history of numerically integrated bodies, stored in contiguous memory (one column per
+     * epoch, see StateHistory), in the 'conventional form'.
+     * \return State history of numerically integrated bodies.
+     */
+    const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&
+    getEquationsOfMotionNumericalSolutionHistory( )
+    {
+        return equationsOfMotionNumericalSolution_;
+    }
+
+    //! Function to return the state history of numerically integrated bodies in propagation coordinates, stored in
+    //! contiguous memory.
+    /*!
+     * Function to return the state history of numerically integrated bodies in propagation coordinates, stored in
+     * contiguous memory (one column per epoch, see StateHistory).
+     * \return State history of numerically integrated bodies, in propagation coordinates.
+     */
+    const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&
+    getEquationsOfMotionNumericalSolutionRawHistory( )
+    {
+        return equationsOfMotionNumericalSolutionRaw_;
+    }
+
+    //! Function to return the dependent variable history that was saved during numerical propagation, stored in
+    //! contiguous memory.
+    /*!
+     * Function to return the dependent variable history that was saved during numerical propagation, stored in
+     * contiguous memory (one column per epoch, see StateHistory).
+     * \return Dependent variable history that was saved during numerical propagation.
+     */
+    const StateHistory< TimeType, Eigen::VectorXd >& getDependentVariableNumericalSolutionHistory( )
+    {
+        return dependentVariableHistory_;
+    }
+
+    //! Function to return the cumulative computation time history that was saved during numerical propagation, stored
+    //! in contiguous memory.
+    /*!
+     * Function to return the cumulative computation time history that was saved during numerical propagation, stored in
+     * contiguous memory (see StateHistory).
+     * \return Cumulative computation time history that was saved during numerical propagation.
+     */
+    const StateHistory< TimeType, double >& getCumulativeComputationTimeNumericalSolutionHistory( )
     {
         return cumulativeComputationTimeHistory_;
     }
 
+    //! Function to exchange the (contiguously stored) state history with another history, without copying it.
+    /*!
+     * Function to exchange the contents (and allocated memory) of the state history in 'conventional form' with those of
+     * another history, without copying any entries (e.g. to process the state histories of multiple arcs together).
+     * \param equationsOfMotionNumericalSolution State history with which the state history of this object is to be
+     * exchanged (modified by reference)
+     */
+    void swapEquationsOfMotionNumericalSolutionHistory(
+            StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+    {
+        equationsOfMotionNumericalSolution_.swap( equationsOfMotionNumericalSolution );
+        resetHistoryMaps( );
+    }
+
+    //! Function to take over the results of the last propagation of another simulator of the same dynamics.
+    /*!
+     * Function to take over the results of the last propagation of another simulator of the same dynamics (e.g. one using
+     * a copy of the environment of this object on another thread), so that the results can be retrieved from this object
+     * as if it had performed the propagation. The (contiguously stored) histories are exchanged with those of the other
+     * simulator, without copying them. The termination reason, final time/state/dependent variables, detected events,
+     * function evaluation counts and profiling statistics are copied. The checkpoint handler of the other simulator is not
+     * taken over, so that getNumberOfWrittenCheckpoints only refers to propagations performed by this object. Note that
+     * the environment of this object (e.g. the current states of the bodies and the acceleration model caches) is not
+     * modified.
+     * \param sourceSimulator Simulator from which the results of the last propagation are to be taken over.
+     */
+    void takeOverPropagationResults(
+            const std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > sourceSimulator )
+    {
+        equationsOfMotionNumericalSolution_.swap( sourceSimulator->equationsOfMotionNumericalSolution_ );
+        equationsOfMotionNumericalSolutionRaw_.swap( sourceSimulator->equationsOfMotionNumericalSolutionRaw_ );
+        dependentVariableHistory_.swap( sourceSimulator->dependentVariableHistory_ );
+        cumulativeComputationTimeHistory_.swap( sourceSimulator->cumulativeComputationTimeHistory_ );
+        resetHistoryMaps( );
+        sourceSimulator->resetHistoryMaps( );
+
+        propagationTerminationReason_ = sourceSimulator->propagationTerminationReason_;
+        detectedEvents_ = sourceSimulator->detectedEvents_;
+        cumulativeNumberOfFunctionEvaluations_ = sourceSimulator->cumulativeNumberOfFunctionEvaluations_;
+        isFixedSizeStatePropagationUsed_ = sourceSimulator->isFixedSizeStatePropagationUsed_;
+        numberOfStreamedEpochs_ = sourceSimulator->numberOfStreamedEpochs_;
+        finalPropagationTime_ = sourceSimulator->finalPropagationTime_;
+        finalPropagatedState_ = sourceSimulator->finalPropagatedState_;
+        finalDependentVariables_ = sourceSimulator->finalDependentVariables_;
+        if( propagationProfiler_ != nullptr && sourceSimulator->propagationProfiler_ != nullptr )
+        {
+            propagationProfiler_->copyStatistics( *sourceSimulator->propagationProfiler_ );
+        }
+    }
+
     //! Function to return the map of number of cumulative function evaluations that was saved during numerical propagation.
     /*!
      * Function to return the map of cumulative number of function evaluations that was saved during numerical propagation.
+     * Note that this map is only filled if setRecordCumulativeNumberOfFunctionEvaluations( true ) was called before the
+     * propagation, and is empty otherwise.
      * \return Map of cumulative number of function evaluations that was saved during numerical propagation.
      */
     std::map< TimeType, unsigned int > getCumulativeNumberOfFunctionEvaluations( )
@@ -602,6 +965,43 @@ public:
         return cumulativeNumberOfFunctionEvaluations_;
     }
 
+    //! Function to set whether the cumulative number of function evaluations is recorded during numerical propagation.
+    /*!
+     * Function to set whether the cumulative number of function evaluations is recorded during numerical propagation
+     * (see getCumulativeNumberOfFunctionEvaluations). This is off by default, as it requires an allocation per function
+     * evaluation. Setting takes effect for the next call to integrateEquationsOfMotion.
+     * \param recordCumulativeNumberOfFunctionEvaluations Boolean denoting whether the cumulative number of function
+     * evaluations is to be recorded.
+     */
+    void setRecordCumulativeNumberOfFunctionEvaluations( const bool recordCumulativeNumberOfFunctionEvaluations )
+    {
+        dynamicsStateDerivative_->setRecordCumulativeFunctionEvaluations( recordCumulativeNumberOfFunctionEvaluations );
+    }
+
+    //! Function to set whether a fixed-size state vector is used when propagating a single body.
+    /*!
+     * Function to set whether a fixed-size state vector (of size 6 or 7) is used in the numerical integration when the
+     * translational dynamics of only a single body (and optionally its mass) is propagated. This is on by default, and
+     * provides the same results as the propagation with a dynamically-sized state vector, without its heap allocations.
+     * Setting takes effect for the next call to integrateEquationsOfMotion.
+     * \param useFixedSizeStatePropagation Boolean denoting whether a fixed-size state vector is used if possible.
+     */
+    void setUseFixedSizeStatePropagation( const bool useFixedSizeStatePropagation )
+    {
+        useFixedSizeStatePropagation_ = useFixedSizeStatePropagation;
+    }
+
+    //! Function to retrieve whether a fixed-size state vector was used in the last numerical integration.
+    /*!
+     * Function to retrieve whether a fixed-size state vector was used in the last numerical integration
+     * (see setUseFixedSizeStatePropagation).
+     * \return Boolean denoting whether a fixed-size state vector was used in the last numerical integration.
+     */
+    bool isFixedSizeStatePropagationUsed( )
+    {
+        return isFixedSizeStatePropagationUsed_;
+    }
+
     //! Function to return the map of state history of numerically integrated bodies (base class interface).
     /*!
      * Function to return the map of state history of numerically integrated bodies (base class interface).
@@ -649,12 +1049,13 @@ public:
             const bool processSolution = true )
     {
         equationsOfMotionNumericalSolution_ = equationsOfMotionNumericalSolution;
+        dependentVariableHistory_ = dependentVariableHistory;
+        resetHistoryMaps( );
+
         if( processSolution )
         {
             processNumericalEquationsOfMotionSolution( );
         }
-
-        dependentVariableHistory_ = dependentVariableHistory;
     }
 
     //! Function to get the settings for the numerical integrator.
@@ -753,14 +1154,77 @@ public:
         return propagationTerminationReason_;
     }
 
+    //! Function to retrieve the time at the end of the last propagation
+    /*!
+     * Function to retrieve the time at the end of the last propagation, i.e. at the end of the last integration step, or at
+     * the exact final condition or terminal event. Contrary to the last epoch of the numerical solution, this time is
+     * also available if the final state is not saved (due to the save frequency), or if the numerical solution is cleared.
+     * \return Time at the end of the last propagation (NaN if no propagation was performed)
+     */
+    TimeType getFinalPropagationTime( )
+    {
+        return finalPropagationTime_;
+    }
+
+    //! Function to retrieve the state at the end of the last propagation
+    /*!
+     * Function to retrieve the (conventional) state at the end of the last propagation (see getFinalPropagationTime).
+     * \return State at the end of the last propagation
+     */
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getFinalPropagatedState( )
+    {
+        return finalPropagatedState_;
+    }
+
+    //! Function to retrieve the dependent variables at the end of the last propagation
+    /*!
+     * Function to retrieve the dependent variables at the end of the last propagation (see getFinalPropagationTime).
+     * \return Dependent variables at the end of the last propagation (empty if no dependent variables are saved)
+     */
+    Eigen::VectorXd getFinalDependentVariables( )
+    {
+        return finalDependentVariables_;
+    }
+
+    //! Function to retrieve the object in which the computation time of the models is recorded.
+    /*!
+     * Function to retrieve the object in which the computation time of the models (acceleration, torque and mass rate
+     * models, environment updates and dependent variables) is recorded during the propagation.
+     * \return Object in which the computation time of the models is recorded (nullptr if profiling is not used, see
+     * SingleArcPropagatorSettings::setProfilePropagation).
+     */
+    std::shared_ptr< PropagationProfiler > getPropagationProfiler( )
+    {
+        return propagationProfiler_;
+    }
+
+    //! Function to retrieve the computation time statistics of the models, as recorded during the last propagation.
+    /*!
+     * Function to retrieve the computation time statistics of the models, as recorded during the last propagation.
+     * \return Wall time and number of calls of each profiled model (empty if profiling is not used).
+     */
+    std::vector< ProfiledFunctionStatistics > getPropagationProfilingReport( )
+    {
+        if( propagationProfiler_ == nullptr )
+        {
+            return std::vector< ProfiledFunctionStatistics >( );
+        }
+        else
+        {
+            return propagationProfiler_->getProfilingReport( );
+        }
+    }
+
     //! Get whether the integration was completed successfully.
     /*!
      * Get whether the integration was completed successfully.
-     * \return Whether the integration was completed successfully by reaching the termination condition.
+     * \return Whether the integration was completed successfully by reaching the termination condition (or a terminal
+     * propagation event).
      */
     virtual bool integrationCompletedSuccessfully( ) const
     {
-        return ( propagationTerminationReason_->getPropagationTerminationReason( ) == termination_condition_reached );
+        return ( propagationTerminationReason_->getPropagationTerminationReason( ) == termination_condition_reached ||
+                 propagationTerminationReason_->getPropagationTerminationReason( ) == terminal_event_detected );
     }
 
     //! Function to retrieve the dependent variables IDs
@@ -803,6 +1267,174 @@ public:
         return dependentVariablesFunctions_;
     }
 
+    //! Function to compute dependent variables a posteriori, from a given history of propagated states.
+    /*!
+     *  Function to compute dependent variables a posteriori, from a given history of propagated states (in conventional
+     *  form, as returned by getEquationsOfMotionNumericalSolution), without repeating the propagation. At each requested
+     *  epoch, the stored state is set in the environment, and the environment and state derivative models are updated as
+     *  during the propagation, after which the dependent variables are evaluated. The dependent variables need not be
+     *  the same as those saved during the propagation, but must be computable from the models in this simulator (e.g.
+     *  an acceleration must be used in the propagation for it to be saved). After calling this function, the environment
+     *  is left at the last epoch that was evaluated by this object.
+     *
+     *  Since the epochs are mutually independent, they can be distributed over multiple threads. As for the parallel
+     *  propagation of multiple arcs (see MultiArcDynamicsSimulator::setParallelArcPropagation), each additional thread
+     *  requires its own environment: the workerSimulatorCreationFunction is called once per additional thread, and must
+     *  return a single-arc simulator (not yet integrated) with the same settings as this object, but created from a newly
+     *  created body map and acceleration models. Models that are not thread-safe (such as direct calls to Spice) must not
+     *  be used. The dependent variable IDs can be retrieved with getPostProcessedDependentVariableIds.
+     *  \param dependentVariableSettings Settings for the dependent variables that are to be computed
+     *  \param stateHistory History of propagated states (in conventional form) from which the dependent variables are
+     *  to be computed
+     *  \param epochs Epochs at which the dependent variables are to be computed, each of which must be in stateHistory
+     *  (all epochs of stateHistory if empty)
+     *  \param numberOfThreads Number of threads over which the epochs are to be distributed (0 to use all threads available
+     *  on the current machine)
+     *  \param workerSimulatorCreationFunction Function creating a single-arc simulator, with its own environment, to be
+     *  used by a single additional thread (only required if more than one thread is used)
+     *  \return History of dependent variables at the requested epochs
+     */
+    std::map< TimeType, Eigen::VectorXd > computeDependentVariablesFromStateHistory(
+            const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings,
+            const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& stateHistory,
+            const std::vector< TimeType >& epochs = std::vector< TimeType >( ),
+            const unsigned int numberOfThreads = 1,
+            const std::function< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > >( ) >&
+            workerSimulatorCreationFunction = nullptr )
+    {
+        if( dependentVariableSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when computing dependent variables from state history, no settings provided." );
+        }
+
+        // Retrieve states at requested epochs
+        std::vector< TimeType > epochsToEvaluate = epochs;
+        if( epochsToEvaluate.size( ) == 0 )
+        {
+            for( auto stateIterator : stateHistory )
+            {
+                epochsToEvaluate.push_back( stateIterator.first );
+            }
+        }
+
+        std::vector< const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >* > statesToEvaluate;
+        statesToEvaluate.reserve( epochsToEvaluate.size( ) );
+        for( unsigned int i = 0; i < epochsToEvaluate.size( ); i++ )
+        {
+            typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator
+                    stateIterator = stateHistory.find( epochsToEvaluate.at( i ) );
+            if( stateIterator == stateHistory.end( ) )
+            {
+                throw std::runtime_error( "Error when computing dependent variables from state history, no state found at "
+                                          "epoch " + std::to_string( static_cast< double >( epochsToEvaluate.at( i ) ) ) );
+            }
+            statesToEvaluate.push_back( &( stateIterator->second ) );
+        }
+
+        // Create functions that compute the dependent variables from the state, one per thread (each with its own environment)
+        unsigned int numberOfUsedThreads =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        numberOfUsedThreads = std::max( 1u, std::min(
+                                            numberOfUsedThreads, static_cast< unsigned int >( epochsToEvaluate.size( ) ) ) );
+        if( numberOfUsedThreads > 1 && workerSimulatorCreationFunction == nullptr )
+        {
+            throw std::runtime_error( "Error when computing dependent variables from state history, no function to create "
+                                      "environment for additional threads provided." );
+        }
+
+        std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > workerSimulators;
+        std::vector< std::function< Eigen::VectorXd( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& ) > >
+                dependentVariableFunctionPerThread;
+        std::pair< std::function< Eigen::VectorXd( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& ) >,
+                std::map< int, std::string > > dependentVariableData =
+                createDependentVariableFunctionFromState( dependentVariableSettings );
+        dependentVariableFunctionPerThread.push_back( dependentVariableData.first );
+        for( unsigned int i = 1; i < numberOfUsedThreads; i++ )
+        {
+            std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > workerSimulator =
+                    workerSimulatorCreationFunction( );
+            if( workerSimulator == nullptr )
+            {
+                throw std::runtime_error( "Error when computing dependent variables from state history, worker simulator is "
+                                          "not defined." );
+            }
+
+            for( auto bodyIterator : workerSimulator->getNamedBodyMap( ) )
+            {
+                if( bodyMap_.count( bodyIterator.first ) > 0 && bodyMap_.at( bodyIterator.first ) == bodyIterator.second )
+                {
+                    throw std::runtime_error( "Error when computing dependent variables from state history, body " +
+                                              bodyIterator.first + " is shared between threads." );
+                }
+            }
+
+            dependentVariableFunctionPerThread.push_back(
+                        workerSimulator->createDependentVariableFunctionFromState( dependentVariableSettings ).first );
+            workerSimulators.push_back( workerSimulator );
+        }
+
+        // Compute dependent variables, distributing the epochs over the threads
+        std::vector< Eigen::VectorXd > dependentVariables( epochsToEvaluate.size( ) );
+        utilities::executeTasksInParallel(
+                    epochsToEvaluate.size( ), numberOfUsedThreads,
+                    [ & ]( const unsigned int epochIndex, const unsigned int threadIndex )
+        {
+            dependentVariables[ epochIndex ] = dependentVariableFunctionPerThread.at( threadIndex )(
+                        epochsToEvaluate.at( epochIndex ), *statesToEvaluate.at( epochIndex ) );
+        }, false );
+
+        std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+        for( unsigned int i = 0; i < epochsToEvaluate.size( ); i++ )
+        {
+            dependentVariableHistory[ epochsToEvaluate.at( i ) ] = dependentVariables.at( i );
+        }
+        postProcessedDependentVariableIds_ = dependentVariableData.second;
+
+        return dependentVariableHistory;
+    }
+
+    //! Function to compute dependent variables a posteriori, from the states computed by the last propagation.
+    /*!
+     *  Function to compute dependent variables a posteriori, from the states computed by the last propagation (see
+     *  computeDependentVariablesFromStateHistory). The state history must have been retained during the propagation (i.e.
+     *  not only streamed to an output sink).
+     *  \param dependentVariableSettings Settings for the dependent variables that are to be computed
+     *  \param epochs Epochs at which the dependent variables are to be computed, each of which must be in the state history
+     *  (all epochs of the state history if empty)
+     *  \param numberOfThreads Number of threads over which the epochs are to be distributed (0 to use all threads available
+     *  on the current machine)
+     *  \param workerSimulatorCreationFunction Function creating a single-arc simulator, with its own environment, to be
+     *  used by a single additional thread (only required if more than one thread is used)
+     *  \return History of dependent variables at the requested epochs
+     */
+    std::map< TimeType, Eigen::VectorXd > computeDependentVariablesFromNumericalSolution(
+            const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings,
+            const std::vector< TimeType >& epochs = std::vector< TimeType >( ),
+            const unsigned int numberOfThreads = 1,
+            const std::function< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > >( ) >&
+            workerSimulatorCreationFunction = nullptr )
+    {
+        if( getEquationsOfMotionNumericalSolution( ).size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when computing dependent variables from numerical solution, no state history "
+                                      "is available." );
+        }
+        return computeDependentVariablesFromStateHistory(
+                    dependentVariableSettings, getEquationsOfMotionNumericalSolution( ), epochs,
+                    numberOfThreads, workerSimulatorCreationFunction );
+    }
+
+    //! Function to retrieve the IDs of the dependent variables that were last computed a posteriori
+    /*!
+     * Function to retrieve the IDs of the dependent variables that were last computed a posteriori (by
+     * computeDependentVariablesFromStateHistory).
+     * \return Map listing starting entry of dependent variables in output vector, along with associated ID
+     */
+    std::map< int, std::string > getPostProcessedDependentVariableIds( )
+    {
+        return postProcessedDependentVariableIds_;
+    }
+
     //! Function to reset the object that checks whether the simulation has finished from
     //! (newly defined) propagation settings.
     /*!
@@ -824,7 +1456,7 @@ public:
      */
     void processNumericalEquationsOfMotionSolution( )
     {
-        // Create and set interpolators for ephemerides
+        // Create and set interpolators for ephemerides (directly from contiguously stored results)
         resetIntegratedStates( equationsOfMotionNumericalSolution_, integratedStateProcessors_ );
 
         // Clear numerical solution if so required.
@@ -832,6 +1464,9 @@ public:
         {
             equationsOfMotionNumericalSolution_.clear( );
             equationsOfMotionNumericalSolutionRaw_.clear( );
+            equationsOfMotionNumericalSolution_.shrinkToFit( );
+            equationsOfMotionNumericalSolutionRaw_.shrinkToFit( );
+            resetHistoryMaps( );
         }
 
         for( simulation_setup::NamedBodyMap::const_iterator
@@ -844,6 +1479,328 @@ public:
 
 protected:
 
+    //! Function to retrieve the sink to which the results are to be streamed during the propagation
+    /*!
+     * Function to retrieve the sink to which the results are to be streamed during the propagation, as set in the propagator
+     * settings. An error is thrown if the sink is of the wrong type, or if the integrated results are to be set in the
+     * environment (which requires the full state history).
+     * \return Sink to which the results are to be streamed during the propagation (nullptr if none)
+     */
+    std::shared_ptr< PropagationOutputSink< StateScalarType, TimeType > > getOutputSink( )
+    {
+        std::shared_ptr< PropagationOutputSink< StateScalarType, TimeType > > outputSink;
+        if( propagatorSettings_->getOutputSink( ) != nullptr )
+        {
+            outputSink = std::dynamic_pointer_cast< PropagationOutputSink< StateScalarType, TimeType > >(
+                        propagatorSettings_->getOutputSink( ) );
+            if( outputSink == nullptr )
+            {
+                throw std::runtime_error( "Error in single-arc dynamics simulator, propagation output sink is not "
+                                          "consistent with state scalar type and time type of simulator." );
+            }
+            if( this->setIntegratedResult_ )
+            {
+                throw std::runtime_error( "Error in single-arc dynamics simulator, cannot set integrated result in "
+                                          "environment when streaming results to propagation output sink." );
+            }
+        }
+        return outputSink;
+    }
+
+    //! Function to retrieve the size of the fixed-size state vector that can be used in the numerical integration.
+    /*!
+     * Function to retrieve the size of the fixed-size state vector that can be used in the numerical integration, which
+     * is the case if only the translational state of a single body (and optionally its mass) is propagated.
+     * \return Size of propagated state vector (6 or 7) if a fixed-size state can be used, 0 otherwise.
+     */
+    int getFixedSizePropagatedStateSize( )
+    {
+        bool isTranslationalStatePropagated = false;
+        for( auto stateDerivativeIterator : dynamicsStateDerivative_->getStateDerivativeModels( ) )
+        {
+            if( stateDerivativeIterator.first == translational_state )
+            {
+                isTranslationalStatePropagated = true;
+            }
+            else if( stateDerivativeIterator.first != body_mass_state )
+            {
+                return 0;
+            }
+        }
+
+        // A translational state has at least 6 entries per body, so that a state size of 6 or 7 denotes a single body
+        const int propagatedStateSize = dynamicsStateDerivative_->getPropagatedStateSize( );
+        return ( isTranslationalStatePropagated && ( propagatedStateSize == 6 || propagatedStateSize == 7 ) ) ?
+                    propagatedStateSize : 0;
+    }
+
+    //! Function to numerically integrate the equations of motion, using a fixed-size state vector.
+    /*!
+     * Function to numerically integrate the equations of motion, using a fixed-size state vector throughout the numerical
+     * integration, so that the integrator does not allocate (or resize) any states. The state derivative is computed by
+     * dynamicsStateDerivative_ directly into the fixed-size state derivative. The propagated states are copied to
+     * equationsOfMotionNumericalSolutionRaw_ after the propagation.
+     * \param initialPropagatedState Initial state, in propagator-specific form (must be of size StateSize).
+     * \param outputStreamingFunction Function to which the saved states and dependent variables are passed during the
+     * propagation (empty if not used).
+     * \param finalStateFunction Function to which the time, state and dependent variables at the end of the propagation
+     * are passed.
+     * \param checkpointHandler Object with which checkpoints are written, and/or from which the propagation is resumed
+     * (nullptr if not used).
+     * \return Event that triggered the termination of the propagation
+     */
+    template< int StateSize >
+    std::shared_ptr< PropagationTerminationDetails > integrateEquationsOfMotionWithFixedSizeState(
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& initialPropagatedState,
+            const std::function< void( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                                       const Eigen::VectorXd& ) >& outputStreamingFunction,
+            const std::function< void( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >&,
+                                       const Eigen::VectorXd& ) >& finalStateFunction,
+            const std::shared_ptr< PropagationCheckpointHandler > checkpointHandler )
+    {
+        typedef Eigen::Matrix< StateScalarType, StateSize, 1 > FixedSizeStateType;
+
+        // Create functions to compute state derivative of fixed-size state
+        std::function< void( const TimeType, const FixedSizeStateType&, FixedSizeStateType& ) >
+                inPlaceStateDerivativeFunction =
+                std::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::template computeStateDerivativeInPlace<
+                           FixedSizeStateType >,
+                           dynamicsStateDerivative_, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3 );
+        std::function< FixedSizeStateType( const TimeType, const FixedSizeStateType& ) > stateDerivativeFunction =
+                [ = ]( const TimeType time, const FixedSizeStateType& state )
+        {
+            FixedSizeStateType stateDerivative;
+            inPlaceStateDerivativeFunction( time, state, stateDerivative );
+            return stateDerivative;
+        };
+
+        // Create function to post-process state (only if required by state derivative models), using pre-allocated buffer
+        std::function< void( FixedSizeStateType& ) > statePostProcessingFunction;
+        if( dynamicsStateDerivative_->isStateToBePostProcessed( ) )
+        {
+            std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative =
+                    dynamicsStateDerivative_;
+            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > unprocessedState = initialPropagatedState;
+            statePostProcessingFunction = [ = ]( FixedSizeStateType& state ) mutable
+            {
+                unprocessedState = state;
+                dynamicsStateDerivative->postProcessState( unprocessedState );
+                state = unprocessedState;
+            };
+        }
+
+        // Create function to stream results in dynamically-sized state, using pre-allocated buffer
+        std::function< void( const TimeType, const FixedSizeStateType&, const Eigen::VectorXd& ) >
+                fixedSizeOutputStreamingFunction;
+        if( outputStreamingFunction != nullptr )
+        {
+            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > streamedState = initialPropagatedState;
+            fixedSizeOutputStreamingFunction = [ = ]( const TimeType time, const FixedSizeStateType& state,
+                    const Eigen::VectorXd& dependentVariables ) mutable
+            {
+                streamedState = state;
+                outputStreamingFunction( time, streamedState, dependentVariables );
+            };
+        }
+
+        // Create function to pass final results in dynamically-sized state
+        std::function< void( const TimeType, const FixedSizeStateType&, const Eigen::VectorXd& ) >
+                fixedSizeFinalStateFunction = [ = ]( const TimeType time, const FixedSizeStateType& state,
+                const Eigen::VectorXd& dependentVariables )
+        {
+            finalStateFunction( time, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >( state ), dependentVariables );
+        };
+
+        std::shared_ptr< PropagationEventDetector< FixedSizeStateType, TimeType > > eventDetector =
+                createPropagationEventDetector< FixedSizeStateType >( );
+
+        StateHistory< TimeType, FixedSizeStateType > fixedSizeStateHistory;
+        std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason =
+                EquationIntegrationInterface< FixedSizeStateType, TimeType >::integrateEquations(
+                    stateDerivativeFunction, fixedSizeStateHistory,
+                    FixedSizeStateType( initialPropagatedState ), integratorSettings_,
+                    propagationTerminationCondition_,
+                    dependentVariableHistory_,
+                    cumulativeComputationTimeHistory_,
+                    dependentVariablesFunctions_,
+                    statePostProcessingFunction,
+                    propagatorSettings_->getPrintInterval( ),
+                    initialClockTime_,
+                    fixedSizeOutputStreamingFunction,
+                    inPlaceStateDerivativeFunction,
+                    checkpointHandler,
+                    eventDetector,
+                    fixedSizeFinalStateFunction );
+        setDetectedEvents( eventDetector );
+
+        // Copy propagated states to raw numerical solution
+        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentState = initialPropagatedState;
+        equationsOfMotionNumericalSolutionRaw_.reserve( fixedSizeStateHistory.size( ) );
+        for( unsigned int i = 0; i < fixedSizeStateHistory.size( ); i++ )
+        {
+            currentState = fixedSizeStateHistory.getState( i );
+            equationsOfMotionNumericalSolutionRaw_.insert( fixedSizeStateHistory.getTime( i ), currentState );
+        }
+
+        return propagationTerminationReason;
+    }
+
+    //! Function to create the function that computes dependent variables from a propagated state.
+    /*!
+     * Function to create the function that computes dependent variables from a propagated state (in conventional form)
+     * and time. This function sets the state in the environment, updates the environment and state derivative models in
+     * the same manner as during the propagation, and subsequently updates any environment models that are additionally
+     * required for the dependent variables (and not for the propagation).
+     * \param dependentVariableSettings Settings for the dependent variables that are to be computed
+     * \return Pair of function computing dependent variables from time and conventional state, and dependent variable IDs
+     */
+    std::pair< std::function< Eigen::VectorXd( const TimeType, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& ) >,
+    std::map< int, std::string > > createDependentVariableFunctionFromState(
+            const std::shared_ptr< DependentVariableSaveSettings > dependentVariableSettings )
+    {
+        // Create updater for environment models that are required for dependent variables, but not for propagation
+        std::map< propagators::EnvironmentModelsToUpdate, std::vector< std::string > > additionalEnvironmentModelsToUpdate =
+                createEnvironmentUpdaterSettings( dependentVariableSettings, bodyMap_ );
+        removePropagatedStatesFomEnvironmentUpdates(
+                    additionalEnvironmentModelsToUpdate, getIntegratedTypeAndBodyList< StateScalarType >( propagatorSettings_ ) );
+        std::shared_ptr< EnvironmentUpdater< StateScalarType, TimeType > > additionalEnvironmentUpdater;
+        if( additionalEnvironmentModelsToUpdate.size( ) > 0 )
+        {
+            additionalEnvironmentUpdater = std::make_shared< EnvironmentUpdater< StateScalarType, TimeType > >(
+                        bodyMap_, additionalEnvironmentModelsToUpdate );
+        }
+
+        std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::string > > dependentVariableData =
+                createDependentVariableListFunction< TimeType, StateScalarType >(
+                    dependentVariableSettings, bodyMap_, dynamicsStateDerivative_->getStateDerivativeModels( ) );
+
+        const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative =
+                dynamicsStateDerivative_;
+        const std::function< Eigen::VectorXd( ) > dependentVariableFunction = dependentVariableData.first;
+        return std::make_pair(
+                    [ = ]( const TimeType time, const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& conventionalState )
+        {
+            dynamicsStateDerivative->computeStateDerivative(
+                        time, dynamicsStateDerivative->convertFromOutputSolution( conventionalState, time ) );
+            if( additionalEnvironmentUpdater != nullptr )
+            {
+                additionalEnvironmentUpdater->updateEnvironment(
+                            time, std::unordered_map< IntegratedStateType,
+                            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >( ) );
+            }
+            return dependentVariableFunction( );
+        }, dependentVariableData.second );
+    }
+
+    //! Function to create the object with which the propagation events are detected.
+    /*!
+     * Function to create the object with which the propagation events are detected, from the event settings in
+     * propagatorSettings_. The event functions are evaluated from the propagated state converted to conventional form.
+     * \return Object with which the propagation events are detected (nullptr if no events are defined).
+     */
+    template< typename StateType >
+    std::shared_ptr< PropagationEventDetector< StateType, TimeType > > createPropagationEventDetector( )
+    {
+        const std::vector< std::shared_ptr< PropagationEventSettings > > eventSettings =
+                propagatorSettings_->getEventSettings( );
+        if( eventSettings.size( ) == 0 )
+        {
+            return nullptr;
+        }
+
+        std::vector< std::string > eventNames;
+        std::vector< PropagationEventCrossingDirection > crossingDirections;
+        std::vector< bool > areEventsTerminal;
+        for( unsigned int i = 0; i < eventSettings.size( ); i++ )
+        {
+            eventNames.push_back( eventSettings.at( i )->eventName_ );
+            crossingDirections.push_back( eventSettings.at( i )->crossingDirection_ );
+            areEventsTerminal.push_back( eventSettings.at( i )->isTerminal_ );
+        }
+
+        // Create function computing events from propagated state, using pre-allocated buffer
+        const std::function< void( const double, const Eigen::VectorXd&, Eigen::VectorXd& ) > conventionalEventFunction =
+                createPropagationEventFunctions< StateScalarType, TimeType >(
+                    eventSettings, bodyMap_, dynamicsStateDerivative_ );
+        std::shared_ptr< DynamicsStateDerivativeModel< TimeType, StateScalarType > > dynamicsStateDerivative =
+                dynamicsStateDerivative_;
+        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > propagatedState;
+        typename PropagationEventDetector< StateType, TimeType >::EventFunction eventFunction =
+                [ = ]( const TimeType time, const StateType& state, Eigen::VectorXd& eventValues ) mutable
+        {
+            propagatedState = state;
+            conventionalEventFunction(
+                        static_cast< double >( time ),
+                        dynamicsStateDerivative->convertToOutputSolution( propagatedState, time ).template cast< double >( ),
+                        eventValues );
+        };
+
+        return std::make_shared< PropagationEventDetector< StateType, TimeType > >(
+                    eventFunction, eventNames, crossingDirections, areEventsTerminal );
+    }
+
+    //! Function to set the events detected during the last numerical integration, with states in conventional form.
+    /*!
+     * Function to set the events detected during the last numerical integration (detectedEvents_), with states
+     * converted to conventional form.
+     * \param eventDetector Object with which the propagation events were detected (nullptr if none)
+     */
+    template< typename StateType >
+    void setDetectedEvents( const std::shared_ptr< PropagationEventDetector< StateType, TimeType > > eventDetector )
+    {
+        detectedEvents_.clear( );
+        if( eventDetector != nullptr )
+        {
+            for( auto detectedEvent: eventDetector->getDetectedEvents( ) )
+            {
+                DetectedPropagationEvent< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > convertedEvent;
+                convertedEvent.eventIndex_ = detectedEvent.eventIndex_;
+                convertedEvent.eventName_ = detectedEvent.eventName_;
+                convertedEvent.eventTime_ = detectedEvent.eventTime_;
+                convertedEvent.eventState_ = dynamicsStateDerivative_->convertToOutputSolution(
+                            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >( detectedEvent.eventState_ ),
+                            detectedEvent.eventTime_ );
+                convertedEvent.isIncreasing_ = detectedEvent.isIncreasing_;
+                convertedEvent.isTerminal_ = detectedEvent.isTerminal_;
+                detectedEvents_.push_back( convertedEvent );
+            }
+        }
+    }
+
+    //! Function to retrieve a map with the contents of a state history, creating it if it is not up to date.
+    /*!
+     * Function to retrieve a map with the contents of a state history, creating it if it is not up to date.
+     * \param history State history for which the map is to be retrieved
+     * \param historyMap Map with contents of history (updated by reference if not up to date)
+     * \param isHistoryMapUpToDate Boolean denoting whether historyMap is up to date (set to true by reference)
+     * \return Map with contents of history
+     */
+    template< typename StateType >
+    const std::map< TimeType, StateType >& getHistoryMap(
+            const StateHistory< TimeType, StateType >& history,
+            std::map< TimeType, StateType >& historyMap,
+            bool& isHistoryMapUpToDate )
+    {
+        if( !isHistoryMapUpToDate )
+        {
+            historyMap = history.toMap( );
+            isHistoryMapUpToDate = true;
+        }
+        return historyMap;
+    }
+
+    //! Function to clear the maps created from the state histories (e.g. after the state histories have been modified)
+    void resetHistoryMaps( )
+    {
+        equationsOfMotionNumericalSolutionMap_.clear( );
+        equationsOfMotionNumericalSolutionRawMap_.clear( );
+        dependentVariableHistoryMap_.clear( );
+
+        isEquationsOfMotionNumericalSolutionMapUpToDate_ = false;
+        isEquationsOfMotionNumericalSolutionRawMapUpToDate_ = false;
+        isDependentVariableHistoryMapUpToDate_ = false;
+    }
+
     //! List of object (per dynamics type) that process the integrated numerical solution by updating the environment
     std::map< IntegratedStateType, std::vector< std::shared_ptr<
     IntegratedStateProcessor< TimeType, StateScalarType > > > > integratedStateProcessors_;
@@ -895,32 +1852,53 @@ protected:
     //! Map listing starting entry of dependent variables in output vector, along with associated ID.
     std::map< int, std::string > dependentVariableIds_;
 
+    //! Map listing starting entry of dependent variables last computed a posteriori, along with associated ID.
+    std::map< int, std::string > postProcessedDependentVariableIds_;
+
     //! Object for retrieving ephemerides for transformation of reference frame (origins)
     std::shared_ptr< ephemerides::ReferenceFrameManager > frameManager_;
 
-    //! Map of state history of numerically integrated bodies.
+    //! State history of numerically integrated bodies.
     /*!
-     *  Map of state history of numerically integrated bodies, i.e. the result of the numerical integration, transformed
-     *  into the 'conventional form' (\sa SingleStateTypeDerivative::convertToOutputSolution). Key of map denotes time,
-     *  values are concatenated vectors of integrated body states (order defined by propagatorSettings_).
-     *  NOTE: this map is empty if clearNumericalSolutions_ is set to true.
+     *  State history of numerically integrated bodies, i.e. the result of the numerical integration, transformed
+     *  into the 'conventional form' (\sa SingleStateTypeDerivative::convertToOutputSolution). Entries are concatenated
+     *  vectors of integrated body states (order defined by propagatorSettings_).
+     *  NOTE: this history is empty if clearNumericalSolutions_ is set to true.
      */
-    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolution_;
+    StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolution_;
 
-    //! Map of state history of numerically integrated bodies.
+    //! State history of numerically integrated bodies, in propagation coordinates.
     /*!
-    *  Map of state history of numerically integrated bodies, i.e. the result of the numerical integration, in the
-    *  original propagation coordinates. Key of map denotes time, values are concatenated vectors of integrated body
+    *  State history of numerically integrated bodies, i.e. the result of the numerical integration, in the
+    *  original propagation coordinates. Entries are concatenated vectors of integrated body
     * states (order defined by propagatorSettings_).
-    *  NOTE: this map is empty if clearNumericalSolutions_ is set to true.
+    *  NOTE: this history is empty if clearNumericalSolutions_ is set to true.
     */
-    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionRaw_;
+    StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionRaw_;
+
+    //! Dependent variable history that was saved during numerical propagation.
+    StateHistory< TimeType, Eigen::VectorXd > dependentVariableHistory_;
+
+    //! Cumulative computation time history that was saved during numerical propagation.
+    StateHistory< TimeType, double > cumulativeComputationTimeHistory_;
+
+    //! Map with contents of equationsOfMotionNumericalSolution_ (only created when requested through map interface).
+    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionMap_;
+
+    //! Map with contents of equationsOfMotionNumericalSolutionRaw_ (only created when requested through map interface).
+    std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolutionRawMap_;
 
-    //! Map of dependent variable history that was saved during numerical propagation.
-    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory_;
+    //! Map with contents of dependentVariableHistory_ (only created when requested through map interface).
+    std::map< TimeType, Eigen::VectorXd > dependentVariableHistoryMap_;
 
-    //! Map of cumulative computation time history that was saved during numerical propagation.
-    std::map< TimeType, double > cumulativeComputationTimeHistory_;
+    //! Boolean denoting whether equationsOfMotionNumericalSolutionMap_ is up to date.
+    bool isEquationsOfMotionNumericalSolutionMapUpToDate_ = false;
+
+    //! Boolean denoting whether equationsOfMotionNumericalSolutionRawMap_ is up to date.
+    bool isEquationsOfMotionNumericalSolutionRawMapUpToDate_ = false;
+
+    //! Boolean denoting whether dependentVariableHistoryMap_ is up to date.
+    bool isDependentVariableHistoryMapUpToDate_ = false;
 
     //! Map of cumulative number of function evaluations that was saved during numerical propagation.
     std::map< TimeType, unsigned int > cumulativeNumberOfFunctionEvaluations_;
@@ -937,6 +1915,37 @@ protected:
     //! Event that triggered the termination of the propagation
     std::shared_ptr< PropagationTerminationDetails > propagationTerminationReason_;
 
+    //! Object in which the computation time of the models is recorded (nullptr if not used).
+    std::shared_ptr< PropagationProfiler > propagationProfiler_;
+
+    //! Boolean denoting whether a fixed-size state vector is used when propagating a single body.
+    bool useFixedSizeStatePropagation_ = true;
+
+    //! Boolean denoting whether a fixed-size state vector was used in the last numerical integration.
+    bool isFixedSizeStatePropagationUsed_ = false;
+
+    //! Name of the checkpoint file from which the next numerical integration is resumed (empty if none).
+    std::string resumeCheckpointFile_;
+
+    //! Object with which checkpoints were written/read during the last numerical integration (nullptr if none).
+    std::shared_ptr< PropagationCheckpointHandler > checkpointHandler_;
+
+    //! Number of epochs passed to the output sink during the current numerical integration.
+    unsigned int numberOfStreamedEpochs_ = 0;
+
+    //! Events detected during the last numerical integration, with states in conventional form.
+    std::vector< DetectedPropagationEvent< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    detectedEvents_;
+
+    //! Time at the end of the last numerical integration (NaN if none was performed).
+    TimeType finalPropagationTime_ = TUDAT_NAN;
+
+    //! State (in conventional form) at the end of the last numerical integration.
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > finalPropagatedState_;
+
+    //! Dependent variables at the end of the last numerical integration (empty if none are saved).
+    Eigen::VectorXd finalDependentVariables_;
+
 };
 
 //! Function to get a vector of initial states from a vector of propagator settings
@@ -958,16 +1967,16 @@ std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1  > > getInitialSt
     return initialStatesList;
 }
 
-//! Function to get the initial state of a translational state arc from the previous state's numerical solution
+//! Function to interpolate the initial state of an arc from the previous arc's numerical solution
 /*!
- *  Function to get the initial state of a translational state arc from the previous state's numerical solution
- *  \param previousArcDynamicsSolution Numerical solution of previous arc
+ *  Function to interpolate the initial state of an arc from the previous arc's numerical solution
+ *  \param previousArcDynamicsSolution Numerical solution of previous arc (std::map or StateHistory)
  *  \param currentArcInitialTime Start time of current arc
  *  \return Interpolated initial state of current arc
  */
-template< typename StateScalarType = double, typename TimeType = double >
-Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getArcInitialStateFromPreviousArcResult(
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& previousArcDynamicsSolution,
+template< typename StateScalarType, typename TimeType, typename NumericalSolutionType >
+Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > interpolateArcInitialStateFromPreviousArcResult(
+        const NumericalSolutionType& previousArcDynamicsSolution,
         const double currentArcInitialTime )
 {
     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentArcInitialState;
@@ -986,8 +1995,8 @@ Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getArcInitialStateFromPrevio
             std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > initialStateInterpolationMap;
 
             // Set sub-part of previous arc to interpolate for current arc
-            for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::
-                 const_reverse_iterator previousArcIterator = previousArcDynamicsSolution.rbegin( );
+            for( typename NumericalSolutionType::const_reverse_iterator previousArcIterator =
+                 previousArcDynamicsSolution.rbegin( );
                  previousArcIterator != previousArcDynamicsSolution.rend( ); previousArcIterator++ )
             {
                 initialStateInterpolationMap[ previousArcIterator->first ] = previousArcIterator->second;
@@ -1019,6 +2028,39 @@ Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getArcInitialStateFromPrevio
     return currentArcInitialState;
 }
 
+//! Function to get the initial state of a translational state arc from the previous state's numerical solution
+/*!
+ *  Function to get the initial state of a translational state arc from the previous state's numerical solution
+ *  \param previousArcDynamicsSolution Numerical solution of previous arc
+ *  \param currentArcInitialTime Start time of current arc
+ *  \return Interpolated initial state of current arc
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getArcInitialStateFromPreviousArcResult(
+        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& previousArcDynamicsSolution,
+        const double currentArcInitialTime )
+{
+    return interpolateArcInitialStateFromPreviousArcResult< StateScalarType, TimeType >(
+                previousArcDynamicsSolution, currentArcInitialTime );
+}
+
+//! Function to get the initial state of a translational state arc from the previous state's numerical solution
+/*!
+ *  Function to get the initial state of a translational state arc from the previous state's numerical solution, stored
+ *  in contiguous memory.
+ *  \param previousArcDynamicsSolution Numerical solution of previous arc
+ *  \param currentArcInitialTime Start time of current arc
+ *  \return Interpolated initial state of current arc
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > getArcInitialStateFromPreviousArcResult(
+        const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& previousArcDynamicsSolution,
+        const double currentArcInitialTime )
+{
+    return interpolateArcInitialStateFromPreviousArcResult< StateScalarType, TimeType >(
+                previousArcDynamicsSolution, currentArcInitialTime );
+}
+
 //! Class for performing full numerical integration of a dynamical system over multiple arcs.
 /*!
  *  Class for performing full numerical integration of a dynamical system over multiple arcs, equations of motion are set up
@@ -1086,9 +2128,6 @@ public:
                 singleArcDynamicsSimulators_[ i ]->resetSetIntegratedResult( false );
             }
 
-            equationsOfMotionNumericalSolution_.resize( arcStartTimes.size( ) );
-            dependentVariableHistory_.resize( arcStartTimes.size( ) );
-            cumulativeComputationTimeHistory_.resize( arcStartTimes.size( ) );
             propagationTerminationReasons_.resize( arcStartTimes.size( ) );
 
             // Integrate equations of motion if required.
@@ -1149,9 +2188,6 @@ public:
                 singleArcDynamicsSimulators_[ i ]->resetSetIntegratedResult( false );
             }
 
-            equationsOfMotionNumericalSolution_.resize( singleArcSettings.size( ) );
-            dependentVariableHistory_.resize( singleArcSettings.size( ) );
-            cumulativeComputationTimeHistory_.resize( singleArcSettings.size( ) );
             propagationTerminationReasons_.resize( singleArcSettings.size( ) );
 
             // Integrate equations of motion if required.
@@ -1168,7 +2204,7 @@ public:
     //! This function numerically (re-)integrates the equations of motion, using concatenated states for all arcs
     /*!
      *  This function numerically (re-)integrates the equations of motion, using the settings set through the constructor
-     *  and a new initial state vector provided here. The raw results are set in the equationsOfMotionNumericalSolution_
+     *  and a new initial state vector provided here. The results of each arc are stored in the single-arc simulator of that arc
      *  \param concatenatedInitialStates Initial state vector that is to be used for numerical integration. Note that this state
      *  should be in the correct frame (i.e. corresponding to centralBodies in propagatorSettings_), but not in the propagator-
      *  specific form (i.e Encke, Gauss, etc. for translational dynamics). The states for all arcs must be concatenated in
@@ -1198,7 +2234,7 @@ public:
     //! This function numerically (re-)integrates the equations of motion, using separate states for all arcs
     /*!
      *  This function numerically (re-)integrates the equations of motion, using the settings set through the constructor
-     *  and a new initial state vector provided here. The raw results are set in the equationsOfMotionNumericalSolution_
+     *  and a new initial state vector provided here. The results of each arc are stored in the single-arc simulator of that arc
      *  \param initialStatesList Initial state vector that is to be used for numerical integration. Note that this state should
      *  be in the correct frame (i.e. corresponding to centralBodies in propagatorSettings_), but not in the propagator-
      *  specific form (i.e Encke, Gauss, etc. for translational dynamics). The states for all stored, in order, in the input
@@ -1207,57 +2243,60 @@ public:
     void integrateEquationsOfMotion(
             const std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& initialStatesList )
     {
-        // Clear existing solution (if any)
-        for( unsigned int i = 0; i < equationsOfMotionNumericalSolution_.size( ); i++ )
-        {
-            equationsOfMotionNumericalSolution_.at( i ).clear( );
-        }
-
-        for( unsigned int i = 0; i < dependentVariableHistory_.size( ); i++ )
-        {
-            dependentVariableHistory_.at( i ).clear( );
-        }
-
-        for( unsigned int i = 0; i < cumulativeComputationTimeHistory_.size( ); i++ )
-        {
-            cumulativeComputationTimeHistory_.at( i ).clear( );
-        }
-
-
-        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentArcInitialState;
         std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > arcInitialStateList;
-        bool updateInitialStates = false;
+        arcInitialStateList.resize( singleArcDynamicsSimulators_.size( ) );
 
-        // Propagate dynamics for each arc
+        // If initial state is NaN, this signals that the initial state is to be taken from previous arc. Arcs for which this
+        // is not the case start a new sequence of arcs that have to be propagated one after the other.
+        std::vector< std::vector< unsigned int > > arcSequences;
+        bool updateInitialStates = false;
         for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
         {
-            // Get arc initial state. If initial state is NaN, this signals that the initial state is to be taken from previous
-            // arc
             if( ( i == 0 ) || ( !linear_algebra::doesMatrixHaveNanEntries( initialStatesList.at( i ) ) ) )
             {
-                currentArcInitialState = initialStatesList.at( i );
+                arcSequences.push_back( std::vector< unsigned int >( ) );
             }
             else
             {
-                currentArcInitialState = getArcInitialStateFromPreviousArcResult(
-                            equationsOfMotionNumericalSolution_.at( i - 1 ),
-                            singleArcDynamicsSimulators_.at( i )->getInitialPropagationTime( ) );
-
                 // If arc initial state is taken from previous arc, this indicates that the initial states in propagator settings
                 // need to be updated.
                 updateInitialStates = true;
             }
-            arcInitialStateList.push_back( currentArcInitialState );
+            arcSequences.back( ).push_back( i );
+        }
 
-            singleArcDynamicsSimulators_.at( i )->integrateEquationsOfMotion( currentArcInitialState );
-            equationsOfMotionNumericalSolution_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getEquationsOfMotionNumericalSolution( ) );
-            dependentVariableHistory_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getDependentVariableHistory( ) );
-            cumulativeComputationTimeHistory_[ i ] =
-                    std::move( singleArcDynamicsSimulators_.at( i )->getCumulativeComputationTimeHistory( ) );
-            propagationTerminationReasons_[ i ] = singleArcDynamicsSimulators_.at( i )->getPropagationTerminationReason( );
-            arcStartTimes_[ i ] = equationsOfMotionNumericalSolution_[ i ].begin( )->first;
+        // Apply changes in the environment of this object to the simulators of the additional threads (if any).
+        if( workerSimulatorSynchronizationFunction_ != nullptr )
+        {
+            for( unsigned int i = 0; i < workerDynamicsSimulators_.size( ); i++ )
+            {
+                workerSimulatorSynchronizationFunction_( workerDynamicsSimulators_.at( i ) );
+            }
+        }
+
+        // Propagate dynamics for each arc, with independent sequences of arcs distributed over the available threads
+        // (if parallel arc propagation is used). Each thread only uses the simulators (and environment) assigned to it.
+        std::vector< unsigned int > arcThreadIndices( singleArcDynamicsSimulators_.size( ), 0 );
+        utilities::executeTasksInParallel(
+                    arcSequences.size( ), workerDynamicsSimulators_.size( ) + 1,
+                    [ & ]( const unsigned int sequenceIndex, const unsigned int threadIndex )
+        {
+            for( unsigned int arcIndex: arcSequences.at( sequenceIndex ) )
+            {
+                integrateSingleArc( threadIndex, arcIndex, initialStatesList.at( arcIndex ),
+                                    arcInitialStateList.at( arcIndex ) );
+                arcThreadIndices[ arcIndex ] = threadIndex;
+            }
+        } );
+
+        // Move the results of arcs propagated by additional threads to the single-arc simulators of this object.
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        {
+            if( arcThreadIndices.at( i ) > 0 )
+            {
+                singleArcDynamicsSimulators_.at( i )->takeOverPropagationResults(
+                            getSingleArcDynamicsSimulatorOfThread( i, arcThreadIndices.at( i ) ) );
+            }
         }
 
         if( updateInitialStates )
@@ -1275,13 +2314,23 @@ public:
     //! Function to return the numerical solution to the equations of motion.
     /*!
      *  Function to return the numerical solution to the equations of motion for last numerical integration. Each vector entry
-     *  denotes one arc. Key of map denotes time, values are full propagated state vectors.
+     *  denotes one arc. Key of map denotes time, values are full propagated state vectors. The results of each arc are
+     *  stored (in contiguous memory) by the single-arc simulator of that arc, from which the maps are created when calling
+     *  this function. Use getSingleArcDynamicsSimulators( ).at( i )->getEquationsOfMotionNumericalSolutionHistory( ) to
+     *  access the results without creating the maps.
      *  \return List of maps of history of numerically integrated states.
      */
     std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
     getEquationsOfMotionNumericalSolution( )
     {
-        return equationsOfMotionNumericalSolution_;
+        std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+                equationsOfMotionNumericalSolution;
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        {
+            equationsOfMotionNumericalSolution.push_back(
+                        singleArcDynamicsSimulators_.at( i )->getEquationsOfMotionNumericalSolution( ) );
+        }
+        return equationsOfMotionNumericalSolution;
     }
 
     //! Function to return the numerical solution of the dependent variables
@@ -1292,12 +2341,23 @@ public:
      */
     std::vector< std::map< TimeType, Eigen::VectorXd > > getDependentVariableHistory( )
     {
-        return dependentVariableHistory_;
+        std::vector< std::map< TimeType, Eigen::VectorXd > > dependentVariableHistory;
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        {
+            dependentVariableHistory.push_back( singleArcDynamicsSimulators_.at( i )->getDependentVariableHistory( ) );
+        }
+        return dependentVariableHistory;
     }
 
     std::vector< std::map< TimeType, double > > getCumulativeComputationTimeHistory( )
     {
-        return cumulativeComputationTimeHistory_;
+        std::vector< std::map< TimeType, double > > cumulativeComputationTimeHistory;
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        {
+            cumulativeComputationTimeHistory.push_back(
+                        singleArcDynamicsSimulators_.at( i )->getCumulativeComputationTimeHistory( ) );
+        }
+        return cumulativeComputationTimeHistory;
     }
 
     //! Function to return the numerical solution to the equations of motion (base class interface).
@@ -1332,10 +2392,9 @@ public:
     /*!
      *  Function to reset the environment using an externally provided list of (numerically integrated) states, for instance
      *  provided by a variational equations solver.
-     *  \param equationsOfMotionNumericalSolution Vector of state histories
-     *  (externally provided equationsOfMotionNumericalSolution_)
-     *  \param dependentVariableHistory Vector of dependent variable histories
-     *  (externally provided dependentVariableHistory_)
+     *  The histories of each arc are set in the single-arc simulator of that arc.
+     *  \param equationsOfMotionNumericalSolution Vector of state histories, one per arc (cleared by this function)
+     *  \param dependentVariableHistory Vector of dependent variable histories, one per arc (cleared by this function)
      *  \param processSolution True if the new solution is to be immediately processed (default true).
      */
     void manuallySetAndProcessRawNumericalEquationsOfMotionSolution(
@@ -1344,15 +2403,25 @@ public:
             std::vector< std::map< TimeType, Eigen::VectorXd > >& dependentVariableHistory,
             const bool processSolution = true )
     {
-        // Set equationsOfMotionNumericalSolution_
-        equationsOfMotionNumericalSolution_.resize( equationsOfMotionNumericalSolution.size( ) );
+        if( equationsOfMotionNumericalSolution.size( ) != singleArcDynamicsSimulators_.size( ) )
+        {
+            throw std::runtime_error( "Error when manually setting multi-arc numerical solution, number of arcs is inconsistent" );
+        }
 
+        // Set numerical solution of each arc in the associated single-arc simulator
         for( unsigned int i = 0; i < equationsOfMotionNumericalSolution.size( ); i++ )
         {
-            equationsOfMotionNumericalSolution_[ i ].clear( );
-            equationsOfMotionNumericalSolution_[ i ] = std::move( equationsOfMotionNumericalSolution[ i ] );
-            arcStartTimes_[ i ] = equationsOfMotionNumericalSolution_[ i ].begin( )->first;
+            singleArcDynamicsSimulators_.at( i )->manuallySetAndProcessRawNumericalEquationsOfMotionSolution(
+                        equationsOfMotionNumericalSolution.at( i ),
+                        ( i < dependentVariableHistory.size( ) ) ? dependentVariableHistory.at( i ) :
+                                                                   std::map< TimeType, Eigen::VectorXd >( ), false );
+            arcStartTimes_[ i ] = equationsOfMotionNumericalSolution.at( i ).begin( )->first;
+            equationsOfMotionNumericalSolution.at( i ).clear( );
+        }
 
+        for( unsigned int i = 0; i < dependentVariableHistory.size( ); i++ )
+        {
+            dependentVariableHistory.at( i ).clear( );
         }
 
         // Reset environment with new states.
@@ -1360,14 +2429,6 @@ public:
         {
             processNumericalEquationsOfMotionSolution( );
         }
-
-        dependentVariableHistory_.resize( dependentVariableHistory.size( ) );
-
-        for( unsigned int i = 0; i < dependentVariableHistory.size( ); i++ )
-        {
-            dependentVariableHistory_[ i ].clear( );
-            dependentVariableHistory_[ i ] = std::move( dependentVariableHistory[ i ] );
-        }
     }
 
     //! Function to get the list of DynamicsStateDerivativeModel objects used for each arc
@@ -1395,6 +2456,16 @@ public:
         return singleArcDynamicsSimulators_;
     }
 
+    //! Function to retrieve the propagator settings used by this object
+    /*!
+     * Function to retrieve the propagator settings used by this object
+     * \return Propagator settings used by this object
+     */
+    std::shared_ptr< MultiArcPropagatorSettings< StateScalarType > > getMultiArcPropagatorSettings( )
+    {
+        return multiArcPropagatorSettings_;
+    }
+
     //! Function to retrieve the current state and end times of the arcs
     /*!
      * Function to retrieve the current state and end times of the arcs
@@ -1405,6 +2476,16 @@ public:
         return arcStartTimes_;
     }
 
+    //! Function to retrieve the events that triggered the termination of the last propagation of each arc
+    /*!
+     * Function to retrieve the events that triggered the termination of the last propagation of each arc
+     * \return Events that triggered the termination of the last propagation of each arc
+     */
+    std::vector< std::shared_ptr< PropagationTerminationDetails > > getPropagationTerminationReasons( )
+    {
+        return propagationTerminationReasons_;
+    }
+
     //! Get whether the integration was completed successfully.
     /*!
      * @copybrief integrationCompletedSuccessfully
@@ -1412,10 +2493,12 @@ public:
      */
     virtual bool integrationCompletedSuccessfully( ) const
     {
-        for ( const std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > >
-              singleArcDynamicsSimulator : singleArcDynamicsSimulators_ )
+        for ( const std::shared_ptr< PropagationTerminationDetails >& propagationTerminationReason :
+              propagationTerminationReasons_ )
         {
-            if ( ! singleArcDynamicsSimulator->integrationCompletedSuccessfully( ) )
+            if ( propagationTerminationReason == nullptr ||
+                 ( propagationTerminationReason->getPropagationTerminationReason( ) != termination_condition_reached &&
+                   propagationTerminationReason->getPropagationTerminationReason( ) != terminal_event_detected ) )
             {
                 return false;
             }
@@ -1423,6 +2506,130 @@ public:
         return true;
     }
 
+    //! Function to set up the concurrent propagation of independent arcs.
+    /*!
+     *  Function to set up the concurrent propagation of independent arcs. Each arc for which an initial state is provided
+     *  (i.e. which does not take its initial state from the previous arc) starts a sequence of arcs that is propagated
+     *  independently of the other sequences. These sequences are distributed over the requested number of threads.
+     *  Since the environment (body states, rotations, acceleration model caches, etc.) is modified during propagation, each
+     *  thread requires its own copy of it. For the first thread, this object is used. For each additional thread, the
+     *  workerSimulatorCreationFunction is called (once, when calling this function), which must return a multi-arc
+     *  simulator (not yet integrated) with the same arcs and settings as this object, but created from a newly created
+     *  body map, acceleration models and integrator settings. No environment models may be shared between the threads,
+     *  and models that are not thread-safe (such as direct calls to Spice) must not be used in the propagation.
+     *  Since the propagation of each arc is fully determined by its environment and settings, the results are identical
+     *  to those of the serial propagation. After the propagation, the results of arcs propagated by additional threads
+     *  (histories, termination reason, detected events and profiling statistics) are taken over by the single-arc
+     *  simulators of this object (see getSingleArcDynamicsSimulators), as for a serial propagation. The environment of
+     *  this object is only updated through the processing of the propagated states (e.g. resetting the ephemerides); the
+     *  state of the environment models at the end of each arc is not.
+     *  Note that the worker simulators are created only once: changes made to the environment of this object after calling
+     *  this function (e.g. modified body properties or gravity field coefficients) are not applied to the environments of
+     *  the other threads, unless a workerSimulatorSynchronizationFunction is provided that applies them. This function is
+     *  called for each worker simulator at the start of each propagation (before the arcs are distributed over the threads).
+     *  \param numberOfThreads Number of threads to use (1 to disable parallel arc propagation; 0 to use all threads
+     *  available on the current machine).
+     *  \param workerSimulatorCreationFunction Function creating a multi-arc simulator, with its own environment, to be used
+     *  by a single additional thread.
+     *  \param workerSimulatorSynchronizationFunction Function updating the environment of a worker simulator to that of
+     *  this object, called before each propagation (none by default).
+     */
+    void setParallelArcPropagation(
+            const unsigned int numberOfThreads,
+            const std::function< std::shared_ptr< MultiArcDynamicsSimulator< StateScalarType, TimeType > >( ) >&
+            workerSimulatorCreationFunction = nullptr,
+            const std::function< void( const std::shared_ptr< MultiArcDynamicsSimulator< StateScalarType, TimeType > >& ) >&
+            workerSimulatorSynchronizationFunction = nullptr )
+    {
+        workerDynamicsSimulators_.clear( );
+        workerSimulatorSynchronizationFunction_ = nullptr;
+
+        unsigned int numberOfUsedThreads =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        if( numberOfUsedThreads > 1 && workerSimulatorCreationFunction == nullptr )
+        {
+            throw std::runtime_error( "Error when setting parallel multi-arc propagation, no function to create environment "
+                                      "for additional threads provided." );
+        }
+
+        // Retrieve integrator settings used by this object
+        std::vector< std::set< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > > >
+                integratorSettingsPerThread;
+        integratorSettingsPerThread.push_back( getIntegratorSettingsOfArcs( singleArcDynamicsSimulators_ ) );
+
+        for( unsigned int i = 1; i < numberOfUsedThreads; i++ )
+        {
+            std::shared_ptr< MultiArcDynamicsSimulator< StateScalarType, TimeType > > workerSimulator =
+                    workerSimulatorCreationFunction( );
+
+            // Check consistency of new simulator
+            if( workerSimulator == nullptr )
+            {
+                throw std::runtime_error( "Error when setting parallel multi-arc propagation, worker simulator is not defined." );
+            }
+
+            std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > workerArcSimulators =
+                    workerSimulator->getSingleArcDynamicsSimulators( );
+            if( workerArcSimulators.size( ) != singleArcDynamicsSimulators_.size( ) )
+            {
+                throw std::runtime_error( "Error when setting parallel multi-arc propagation, worker simulator has " +
+                                          std::to_string( workerArcSimulators.size( ) ) + " arcs, expected " +
+                                          std::to_string( singleArcDynamicsSimulators_.size( ) ) );
+            }
+
+            for( unsigned int j = 0; j < workerArcSimulators.size( ); j++ )
+            {
+                if( workerArcSimulators.at( j )->getInitialPropagationTime( ) !=
+                        singleArcDynamicsSimulators_.at( j )->getInitialPropagationTime( ) )
+                {
+                    throw std::runtime_error( "Error when setting parallel multi-arc propagation, start time of arc " +
+                                              std::to_string( j ) + " of worker simulator is inconsistent." );
+                }
+            }
+
+            for( auto bodyIterator : workerSimulator->getNamedBodyMap( ) )
+            {
+                if( bodyMap_.count( bodyIterator.first ) > 0 && bodyMap_.at( bodyIterator.first ) == bodyIterator.second )
+                {
+                    throw std::runtime_error( "Error when setting parallel multi-arc propagation, body " + bodyIterator.first +
+                                              " is shared between threads." );
+                }
+            }
+
+            std::set< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > > workerIntegratorSettings =
+                    getIntegratorSettingsOfArcs( workerArcSimulators );
+            for( unsigned int j = 0; j < integratorSettingsPerThread.size( ); j++ )
+            {
+                for( auto integratorSettings : workerIntegratorSettings )
+                {
+                    if( integratorSettingsPerThread.at( j ).count( integratorSettings ) > 0 )
+                    {
+                        throw std::runtime_error( "Error when setting parallel multi-arc propagation, integrator settings "
+                                                  "are shared between threads." );
+                    }
+                }
+            }
+            integratorSettingsPerThread.push_back( workerIntegratorSettings );
+
+            workerDynamicsSimulators_.push_back( workerSimulator );
+        }
+
+        if( workerDynamicsSimulators_.size( ) > 0 )
+        {
+            workerSimulatorSynchronizationFunction_ = workerSimulatorSynchronizationFunction;
+        }
+    }
+
+    //! Function to retrieve the number of threads used for propagating independent arcs
+    /*!
+     * Function to retrieve the number of threads used for propagating independent arcs
+     * \return Number of threads used for propagating independent arcs
+     */
+    unsigned int getNumberOfArcPropagationThreads( )
+    {
+        return workerDynamicsSimulators_.size( ) + 1;
+    }
+
     //! This function updates the environment with the numerical solution of the propagation.
     /*!
      *  This function updates the environment with the numerical solution of the propagation. It sets
@@ -1431,33 +2638,108 @@ public:
      */
     void processNumericalEquationsOfMotionSolution( )
     {
+        // Temporarily take over the state histories of the arcs (without copying them) to process them together.
+        std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+                equationsOfMotionNumericalSolution( singleArcDynamicsSimulators_.size( ) );
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
+        {
+            singleArcDynamicsSimulators_.at( i )->swapEquationsOfMotionNumericalSolutionHistory(
+                        equationsOfMotionNumericalSolution.at( i ) );
+        }
+
         resetIntegratedMultiArcStatesWithEqualArcDynamics(
-                    equationsOfMotionNumericalSolution_,
+                    equationsOfMotionNumericalSolution,
                     singleArcDynamicsSimulators_.at( 0 )->getIntegratedStateProcessors( ), arcStartTimes_ );
 
-        if( clearNumericalSolutions_ )
+        // Return state histories to the arcs (emptied, if so required).
+        for( unsigned int i = 0; i < singleArcDynamicsSimulators_.size( ); i++ )
         {
-            for( unsigned int i = 0; i < equationsOfMotionNumericalSolution_.size( ); i++ )
+            if( clearNumericalSolutions_ )
             {
-                equationsOfMotionNumericalSolution_.at( i ).clear( );
+                equationsOfMotionNumericalSolution.at( i ).clear( );
             }
-            equationsOfMotionNumericalSolution_.clear( );
+            singleArcDynamicsSimulators_.at( i )->swapEquationsOfMotionNumericalSolutionHistory(
+                        equationsOfMotionNumericalSolution.at( i ) );
         }
     }
 
 protected:
 
-    //! List of maps of state history of numerically integrated states.
+    //! Function to propagate the dynamics of a single arc
     /*!
-     *  List of maps of state history of numerically integrated states. Each entry in the list contains data on a single arc.
-     *  Key of map denotes time, values are concatenated vectors of body states in order of bodiesToIntegrate
+     * Function to propagate the dynamics of a single arc, using the single-arc simulator of the arc that is assigned to the
+     * current thread (see getSingleArcDynamicsSimulatorOfThread), which stores the results. If the arc's initial state
+     * is to be taken from the previous arc, the previous arc must have been propagated (on the same thread) before calling
+     * this function.
+     * \param threadIndex Index of thread on which the arc is propagated (0 for the thread using this object's environment)
+     * \param arcIndex Index of the arc that is to be propagated
+     * \param inputInitialState Initial state of arc, as provided by the user (NaN to take initial state from previous arc)
+     * \param arcInitialState Initial state with which the arc was propagated (returned by reference)
      */
-    std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > > equationsOfMotionNumericalSolution_;
+    void integrateSingleArc(
+            const unsigned int threadIndex,
+            const unsigned int arcIndex,
+            const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& inputInitialState,
+            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& arcInitialState )
+    {
+        std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > singleArcDynamicsSimulator =
+                getSingleArcDynamicsSimulatorOfThread( arcIndex, threadIndex );
 
-    //! List of maps of dependent variable history that was saved during numerical propagation.
-    std::vector< std::map< TimeType, Eigen::VectorXd > > dependentVariableHistory_;
+        // Get arc initial state. If initial state is NaN, this signals that the initial state is to be taken from previous
+        // arc
+        if( ( arcIndex == 0 ) || ( !linear_algebra::doesMatrixHaveNanEntries( inputInitialState ) ) )
+        {
+            arcInitialState = inputInitialState;
+        }
+        else
+        {
+            arcInitialState = getArcInitialStateFromPreviousArcResult(
+                        getSingleArcDynamicsSimulatorOfThread( arcIndex - 1, threadIndex )->
+                        getEquationsOfMotionNumericalSolutionHistory( ),
+                        singleArcDynamicsSimulator->getInitialPropagationTime( ) );
+        }
+
+        singleArcDynamicsSimulator->integrateEquationsOfMotion( arcInitialState );
+        propagationTerminationReasons_[ arcIndex ] = singleArcDynamicsSimulator->getPropagationTerminationReason( );
+        arcStartTimes_[ arcIndex ] = singleArcDynamicsSimulator->getEquationsOfMotionNumericalSolutionHistory( ).begin( )->first;
+    }
+
+    //! Function to retrieve the single-arc simulator that is to be used for a given arc on a given thread
+    /*!
+     * Function to retrieve the single-arc simulator that is to be used for a given arc on a given thread
+     * \param arcIndex Index of arc
+     * \param threadIndex Index of thread (0 for the thread using this object's environment)
+     * \return Single-arc simulator that is to be used for a given arc on a given thread
+     */
+    std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > getSingleArcDynamicsSimulatorOfThread(
+            const unsigned int arcIndex, const unsigned int threadIndex )
+    {
+        if( threadIndex == 0 )
+        {
+            return singleArcDynamicsSimulators_.at( arcIndex );
+        }
+        else
+        {
+            return workerDynamicsSimulators_.at( threadIndex - 1 )->getSingleArcDynamicsSimulators( ).at( arcIndex );
+        }
+    }
 
-    std::vector< std::map< TimeType, double > > cumulativeComputationTimeHistory_;
+    //! Function to retrieve the (unique) integrator settings objects used by a list of single-arc simulators
+    /*!
+     * Function to retrieve the (unique) integrator settings objects used by a list of single-arc simulators
+     * \param arcSimulators List of single-arc simulators
+     * \return Set of integrator settings objects used by arcSimulators
+     */
+    std::set< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > > getIntegratorSettingsOfArcs(
+            const std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > >& arcSimulators )
+    {
+        std::set< std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > > integratorSettings;
+        for( unsigned int i = 0; i < arcSimulators.size( ); i++ )
+        {
+            integratorSettings.insert( arcSimulators.at( i )->getIntegratorSettings( ) );
+        }
+        return integratorSettings;
+    }
 
     //! Objects used to compute the dynamics of the sepatrate arcs
     std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > singleArcDynamicsSimulators_;
@@ -1470,6 +2752,17 @@ protected:
 
     //! Propagator settings used by this objec
     std::shared_ptr< MultiArcPropagatorSettings< StateScalarType > > multiArcPropagatorSettings_;
+
+    //! Simulators (each with their own environment) used by additional threads for parallel arc propagation.
+    /*!
+     *  Simulators (each with their own environment) used by additional threads for parallel arc propagation. Entry i is
+     *  used by thread i + 1. Empty if arcs are propagated serially (default).
+     */
+    std::vector< std::shared_ptr< MultiArcDynamicsSimulator< StateScalarType, TimeType > > > workerDynamicsSimulators_;
+
+    //! Function updating the environment of a worker simulator to that of this object, called before each propagation.
+    std::function< void( const std::shared_ptr< MultiArcDynamicsSimulator< StateScalarType, TimeType > >& ) >
+    workerSimulatorSynchronizationFunction_;
 };
 
 //! Class for performing full numerical integration of a dynamical system, with a compbination of single and multi-arc propagations
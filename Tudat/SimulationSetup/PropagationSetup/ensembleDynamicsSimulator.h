@@ -0,0 +1,317 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_ENSEMBLEDYNAMICSSIMULATOR_H
+#define TUDAT_ENSEMBLEDYNAMICSSIMULATOR_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelExecution.h"
+#include "Tudat/Mathematics/Statistics/basicStatistics.h"
+#include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Class for propagating an ensemble of perturbed versions of a single-arc dynamical model (e.g. for Monte Carlo analyses)
+/*!
+ *  Class for propagating an ensemble of perturbed versions of a single-arc dynamical model (e.g. for Monte Carlo analyses).
+ *  All members of the ensemble are propagated with the same integrator and propagator settings, and differ only in their
+ *  initial state and in the environment perturbations applied to them (e.g. dispersed drag coefficients or solar
+ *  activity). The members are distributed over a number of threads. Since the environment is modified during propagation,
+ *  each thread uses its own SingleArcDynamicsSimulator (and environment), created once by a user-supplied function when
+ *  constructing this object. The function may share models that are not modified during propagation (e.g. gravity field
+ *  coefficients or atmosphere tables) between the environments it creates, but no bodies, acceleration models or other
+ *  models with a state that is updated during propagation, and no models that are not thread-safe (e.g. direct calls
+ *  to Spice). Since each member is propagated from scratch in a fully defined environment, the results do not depend on the
+ *  number of threads used. The final time, state and dependent variables of each member are those at the actual end of its
+ *  propagation (see SingleArcDynamicsSimulator::getFinalPropagatedState), independently of the save frequency of the
+ *  integrator, and of whether the numerical solution is cleared.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class EnsembleDynamicsSimulator
+{
+public:
+
+    //! Typedef for state vector
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > StateVectorType;
+
+    //! Constructor
+    /*!
+     *  Constructor, creates the single-arc simulators that are used by each of the threads.
+     *  \param simulatorCreationFunction Function creating a single-arc simulator (with areEquationsOfMotionToBeIntegrated
+     *  set to false) with its own environment. Called once per thread, from the thread that calls this constructor. The
+     *  integrated results of the members are not used to set the ephemerides of the thread environments (i.e.
+     *  setIntegratedResult is reset to false for each simulator).
+     *  \param numberOfThreads Number of threads over which the ensemble members are distributed (0 to use all threads
+     *  available on the current machine).
+     */
+    EnsembleDynamicsSimulator(
+            const std::function< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > >( ) >&
+            simulatorCreationFunction,
+            const unsigned int numberOfThreads = 0 )
+    {
+        unsigned int numberOfUsedThreads =
+                ( numberOfThreads == 0 ) ? utilities::getNumberOfAvailableThreads( ) : numberOfThreads;
+        for( unsigned int i = 0; i < numberOfUsedThreads; i++ )
+        {
+            std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > currentSimulator =
+                    simulatorCreationFunction( );
+            if( currentSimulator == nullptr )
+            {
+                throw std::runtime_error( "Error when creating ensemble dynamics simulator, simulator is not defined." );
+            }
+
+            // Check that no bodies are shared between threads.
+            for( unsigned int j = 0; j < threadSimulators_.size( ); j++ )
+            {
+                simulation_setup::NamedBodyMap existingBodyMap = threadSimulators_.at( j )->getNamedBodyMap( );
+                for( auto bodyIterator : currentSimulator->getNamedBodyMap( ) )
+                {
+                    if( existingBodyMap.count( bodyIterator.first ) > 0 &&
+                            existingBodyMap.at( bodyIterator.first ) == bodyIterator.second )
+                    {
+                        throw std::runtime_error( "Error when creating ensemble dynamics simulator, body " + bodyIterator.first +
+                                                  " is shared between threads." );
+                    }
+                }
+
+                if( threadSimulators_.at( j )->getIntegratorSettings( ) == currentSimulator->getIntegratorSettings( ) )
+                {
+                    throw std::runtime_error( "Error when creating ensemble dynamics simulator, integrator settings are "
+                                              "shared between threads." );
+                }
+            }
+
+            // Do not process (and possibly clear) the results of each member into the thread environment
+            currentSimulator->resetSetIntegratedResult( false );
+            threadSimulators_.push_back( currentSimulator );
+        }
+
+        nominalInitialState_ = threadSimulators_.at( 0 )->getPropagatorSettings( )->getInitialStates( );
+    }
+
+    //! Destructor
+    ~EnsembleDynamicsSimulator( ){ }
+
+    //! Function to propagate all members of the ensemble
+    /*!
+     *  Function to propagate all members of the ensemble. The initial state of member i is the nominal initial state (from
+     *  the propagator settings of the simulators), plus the i-th entry of initialStateDispersions. If provided, the
+     *  environmentPerturbationFunction is called before propagating each member, with the index of the member and the body
+     *  map of the thread on which it is propagated, and must (re)set all perturbed environment properties of the member.
+     *  Results of any previous call to this function are cleared.
+     *  \param initialStateDispersions List of initial state dispersions (w.r.t. the nominal initial state), one per member.
+     *  \param environmentPerturbationFunction Function applying the environment perturbations of a member (default none).
+     *  \param saveMemberHistories Boolean denoting whether the full state and dependent variable histories of each member
+     *  are to be stored (default false, only the final state and dependent variables are stored).
+     */
+    void propagateEnsemble(
+            const std::vector< StateVectorType >& initialStateDispersions,
+            const std::function< void( const unsigned int, const simulation_setup::NamedBodyMap& ) >&
+            environmentPerturbationFunction = nullptr,
+            const bool saveMemberHistories = false )
+    {
+        unsigned int numberOfMembers = initialStateDispersions.size( );
+        for( unsigned int i = 0; i < numberOfMembers; i++ )
+        {
+            if( initialStateDispersions.at( i ).rows( ) != nominalInitialState_.rows( ) )
+            {
+                throw std::runtime_error( "Error when propagating ensemble, size of initial state dispersion of member " +
+                                          std::to_string( i ) + " is inconsistent with propagator settings." );
+            }
+        }
+
+        // Reset output
+        finalTimes_.assign( numberOfMembers, TUDAT_NAN );
+        finalStates_.assign( numberOfMembers, StateVectorType( ) );
+        finalDependentVariables_.assign( numberOfMembers, Eigen::VectorXd( ) );
+        propagationTerminationReasons_.assign( numberOfMembers, nullptr );
+        stateHistories_.clear( );
+        dependentVariableHistories_.clear( );
+        if( saveMemberHistories )
+        {
+            stateHistories_.resize( numberOfMembers );
+            dependentVariableHistories_.resize( numberOfMembers );
+        }
+
+        // Propagate members, each thread using its own simulator
+        utilities::executeTasksInParallel(
+                    numberOfMembers, threadSimulators_.size( ),
+                    [ & ]( const unsigned int memberIndex, const unsigned int threadIndex )
+        {
+            std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > currentSimulator =
+                    threadSimulators_.at( threadIndex );
+            if( environmentPerturbationFunction != nullptr )
+            {
+                environmentPerturbationFunction( memberIndex, currentSimulator->getNamedBodyMap( ) );
+            }
+
+            currentSimulator->integrateEquationsOfMotion( nominalInitialState_ + initialStateDispersions.at( memberIndex ) );
+
+            // Retrieve results at actual end of propagation (which need not be saved in the histories)
+            finalTimes_[ memberIndex ] = currentSimulator->getFinalPropagationTime( );
+            finalStates_[ memberIndex ] = currentSimulator->getFinalPropagatedState( );
+            finalDependentVariables_[ memberIndex ] = currentSimulator->getFinalDependentVariables( );
+            propagationTerminationReasons_[ memberIndex ] = currentSimulator->getPropagationTerminationReason( );
+
+            if( saveMemberHistories )
+            {
+                stateHistories_[ memberIndex ] = currentSimulator->getEquationsOfMotionNumericalSolutionHistory( ).toMap( );
+                dependentVariableHistories_[ memberIndex ] =
+                        currentSimulator->getDependentVariableNumericalSolutionHistory( ).toMap( );
+            }
+        }, false );
+    }
+
+    //! Function to retrieve the final times of the propagation of each member
+    /*!
+     * Function to retrieve the final times of the propagation of each member
+     * \return Final times of the propagation of each member
+     */
+    std::vector< TimeType > getFinalTimes( )
+    {
+        return finalTimes_;
+    }
+
+    //! Function to retrieve the final states of each member
+    /*!
+     * Function to retrieve the final (conventional) propagated states of each member
+     * \return Final states of each member
+     */
+    std::vector< StateVectorType > getFinalStates( )
+    {
+        return finalStates_;
+    }
+
+    //! Function to retrieve the dependent variables at the final time of each member
+    /*!
+     * Function to retrieve the dependent variables at the final time of each member (empty vectors if no dependent
+     * variables are saved).
+     * \return Dependent variables at the final time of each member
+     */
+    std::vector< Eigen::VectorXd > getFinalDependentVariables( )
+    {
+        return finalDependentVariables_;
+    }
+
+    //! Function to retrieve the events that triggered the termination of the propagation of each member
+    /*!
+     * Function to retrieve the events that triggered the termination of the propagation of each member
+     * \return Events that triggered the termination of the propagation of each member
+     */
+    std::vector< std::shared_ptr< PropagationTerminationDetails > > getPropagationTerminationReasons( )
+    {
+        return propagationTerminationReasons_;
+    }
+
+    //! Function to retrieve the state histories of each member (only if saveMemberHistories was set to true).
+    /*!
+     * Function to retrieve the state histories of each member (only if saveMemberHistories was set to true).
+     * \return State histories of each member
+     */
+    std::vector< std::map< TimeType, StateVectorType > > getStateHistories( )
+    {
+        return stateHistories_;
+    }
+
+    //! Function to retrieve the dependent variable histories of each member (only if saveMemberHistories was set to true).
+    /*!
+     * Function to retrieve the dependent variable histories of each member (only if saveMemberHistories was set to true).
+     * \return Dependent variable histories of each member
+     */
+    std::vector< std::map< TimeType, Eigen::VectorXd > > getDependentVariableHistories( )
+    {
+        return dependentVariableHistories_;
+    }
+
+    //! Function to compute the sample mean of the final states of the members
+    /*!
+     * Function to compute the sample mean of the final states of the members
+     * \return Sample mean of the final states of the members
+     */
+    Eigen::VectorXd getFinalStateSampleMean( )
+    {
+        return statistics::computeSampleMean( getFinalStatesInDoublePrecision( ) );
+    }
+
+    //! Function to compute the sample covariance of the final states of the members
+    /*!
+     * Function to compute the sample covariance of the final states of the members
+     * \return Sample covariance of the final states of the members
+     */
+    Eigen::MatrixXd getFinalStateSampleCovariance( )
+    {
+        return statistics::computeSampleCovariance( getFinalStatesInDoublePrecision( ) );
+    }
+
+    //! Function to retrieve the single-arc simulators used by each of the threads
+    /*!
+     * Function to retrieve the single-arc simulators used by each of the threads
+     * \return Single-arc simulators used by each of the threads
+     */
+    std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > getThreadSimulators( )
+    {
+        return threadSimulators_;
+    }
+
+protected:
+
+    //! Function to retrieve the final states of the members as double precision vectors
+    std::vector< Eigen::VectorXd > getFinalStatesInDoublePrecision( )
+    {
+        std::vector< Eigen::VectorXd > finalStates;
+        for( unsigned int i = 0; i < finalStates_.size( ); i++ )
+        {
+            finalStates.push_back( finalStates_.at( i ).template cast< double >( ) );
+        }
+        return finalStates;
+    }
+
+    //! Single-arc simulators (each with its own environment) used by each of the threads
+    std::vector< std::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > > threadSimulators_;
+
+    //! Nominal initial state, w.r.t. which initial state dispersions are applied
+    StateVectorType nominalInitialState_;
+
+    //! Final times of the propagation of each member
+    std::vector< TimeType > finalTimes_;
+
+    //! Final states of each member
+    std::vector< StateVectorType > finalStates_;
+
+    //! Dependent variables at the final time of each member
+    std::vector< Eigen::VectorXd > finalDependentVariables_;
+
+    //! Events that triggered the termination of the propagation of each member
+    std::vector< std::shared_ptr< PropagationTerminationDetails > > propagationTerminationReasons_;
+
+    //! State histories of each member (only if saveMemberHistories was set to true)
+    std::vector< std::map< TimeType, StateVectorType > > stateHistories_;
+
+    //! Dependent variable histories of each member (only if saveMemberHistories was set to true)
+    std::vector< std::map< TimeType, Eigen::VectorXd > > dependentVariableHistories_;
+};
+
+extern template class EnsembleDynamicsSimulator< double, double >;
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_ENSEMBLEDYNAMICSSIMULATOR_H
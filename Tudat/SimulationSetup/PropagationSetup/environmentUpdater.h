@@ -25,6 +25,7 @@
 #include "Tudat/Astrodynamics/Gravitation/timeDependentSphericalHarmonicsGravityField.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationSettings.h"
 #include "Tudat/Astrodynamics/Propagators/environmentUpdateTypes.h"
+#include "Tudat/Astrodynamics/Propagators/propagationProfiler.h"
 
 namespace tudat
 {
@@ -116,9 +117,44 @@ public:
 
         // Evaluate time-dependent update functions (dependent variables of state and time)
         // determined by setUpdateFunctions
-        for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+        if( propagationProfiler_ == nullptr )
+        {
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            }
+        }
+        else
+        {
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                PropagationProfiler::ClockType::time_point startTime = PropagationProfiler::ClockType::now( );
+                updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+                propagationProfiler_->addFunctionCall( profiledUpdateFunctionIndices_[ i ], startTime );
+            }
+        }
+    }
+
+    //! Function to set the object used to profile the computation time of the environment update functions.
+    /*!
+     * Function to set the object used to profile the computation time of the environment update functions. Each update
+     * function is registered with the profiler by this function, identified by its type and the body that is updated.
+     * \param profiler Object used to profile the computation time of the update functions (nullptr to stop profiling).
+     */
+    void setPropagationProfiler( const std::shared_ptr< PropagationProfiler > profiler )
+    {
+        propagationProfiler_ = profiler;
+        profiledUpdateFunctionIndices_.clear( );
+        if( propagationProfiler_ != nullptr )
         {
-            updateFunctionVector_.at( i ).template get< 2 >( )( currentTime );
+            for( unsigned int i = 0; i < updateFunctionVector_.size( ); i++ )
+            {
+                profiledUpdateFunctionIndices_.push_back(
+                            propagationProfiler_->addProfiledFunction(
+                                environment_update_profile,
+                                getEnvironmentUpdateTypeName( updateFunctionVector_.at( i ).template get< 0 >( ) ) +
+                                " of " + updateFunctionVector_.at( i ).template get< 1 >( ) ) );
+            }
         }
     }
 
@@ -682,6 +718,12 @@ private:
     //! time step).
     std::vector< boost::tuple< EnvironmentModelsToUpdate, std::string, std::function< void( ) > > > resetFunctionVector_;
 
+    //! Object used to profile the computation time of the update functions (nullptr if not profiled).
+    std::shared_ptr< PropagationProfiler > propagationProfiler_;
+
+    //! Index in propagationProfiler_ of each entry of updateFunctionVector_.
+    std::vector< unsigned int > profiledUpdateFunctionIndices_;
+
 
 
 
@@ -0,0 +1,258 @@
+/*    Copyright (c) 2010-2019, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PROPAGATIONEVENTSETTINGS_H
+#define TUDAT_PROPAGATIONEVENTSETTINGS_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propagators/propagationEventDetection.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Enum listing the available types of propagation events.
+enum PropagationEventTypes
+{
+    custom_propagation_event,
+    altitude_crossing_event,
+    eclipse_event,
+    node_crossing_event,
+    apsis_event
+};
+
+//! Base class for defining an event that is to be detected during the propagation.
+/*!
+ *  Base class for defining an event that is to be detected during the propagation, i.e. a zero crossing of an event
+ *  function of the time and state. Events are detected after each integration step, without re-integrating the step
+ *  (see PropagationEventDetector), and are either logged, or stop the propagation (terminal events). Each particular
+ *  type of event requires a different derived class.
+ */
+class PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param eventType Type of event that is to be detected.
+     * \param eventName Name of the event (used to identify the detected events).
+     * \param associatedBody Propagated body for which the event is defined (empty if not applicable).
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     */
+    PropagationEventSettings( const PropagationEventTypes eventType,
+                              const std::string& eventName,
+                              const std::string& associatedBody,
+                              const PropagationEventCrossingDirection crossingDirection,
+                              const bool isTerminal ):
+        eventType_( eventType ), eventName_( eventName ), associatedBody_( associatedBody ),
+        crossingDirection_( crossingDirection ), isTerminal_( isTerminal ){ }
+
+    //! Destructor
+    virtual ~PropagationEventSettings( ){ }
+
+    //! Type of event that is to be detected.
+    PropagationEventTypes eventType_;
+
+    //! Name of the event (used to identify the detected events).
+    std::string eventName_;
+
+    //! Propagated body for which the event is defined (empty if not applicable).
+    std::string associatedBody_;
+
+    //! Direction of the zero crossings of the event function that are to be detected.
+    PropagationEventCrossingDirection crossingDirection_;
+
+    //! Boolean denoting whether the propagation is to be stopped at the (first) event.
+    bool isTerminal_;
+};
+
+//! Class for defining an event from a user-defined event function.
+class CustomPropagationEventSettings: public PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param eventName Name of the event (used to identify the detected events).
+     * \param eventFunction Function of time and full propagated state in conventional form (e.g. Cartesian states w.r.t.
+     * the central bodies for translational dynamics), of which the zero crossings are the events.
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     */
+    CustomPropagationEventSettings(
+            const std::string& eventName,
+            const std::function< double( const double, const Eigen::VectorXd& ) > eventFunction,
+            const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+            const bool isTerminal = false ):
+        PropagationEventSettings( custom_propagation_event, eventName, "", crossingDirection, isTerminal ),
+        eventFunction_( eventFunction ){ }
+
+    //! Destructor
+    ~CustomPropagationEventSettings( ){ }
+
+    //! Function of time and full propagated state in conventional form, of which the zero crossings are the events.
+    std::function< double( const double, const Eigen::VectorXd& ) > eventFunction_;
+};
+
+//! Class for defining the crossing of a given altitude w.r.t. the central body of a propagated body.
+/*!
+ *  Class for defining the crossing of a given altitude w.r.t. the central body of a propagated body. The event function
+ *  is the altitude (computed from the shape and rotation model of the central body, or w.r.t. its average radius if it
+ *  has no rotation model) minus the given altitude, so that an increasing crossing denotes the body rising through the
+ *  altitude, and a decreasing crossing the body descending through it.
+ */
+class AltitudeCrossingEventSettings: public PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param associatedBody Propagated body of which the altitude is to be checked.
+     * \param altitude Altitude of which the crossings are to be detected.
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     * \param eventName Name of the event (default "Altitude crossing of " + associatedBody).
+     */
+    AltitudeCrossingEventSettings( const std::string& associatedBody,
+                                   const double altitude,
+                                   const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+                                   const bool isTerminal = false,
+                                   const std::string& eventName = "" ):
+        PropagationEventSettings( altitude_crossing_event,
+                                  eventName.empty( ) ? "Altitude crossing of " + associatedBody : eventName,
+                                  associatedBody, crossingDirection, isTerminal ),
+        altitude_( altitude ){ }
+
+    //! Destructor
+    ~AltitudeCrossingEventSettings( ){ }
+
+    //! Altitude of which the crossings are to be detected.
+    double altitude_;
+};
+
+//! Class for defining the entry into, and exit from, the (partial) shadow of an occulting body by a propagated body.
+/*!
+ *  Class for defining the entry into, and exit from, the (partial) shadow of an occulting body by a propagated body. The
+ *  event function is the angular separation between the centers of the light source and the occulting body, as seen from
+ *  the propagated body, minus the sum of their apparent angular radii. It is negative when the occulting body (partially)
+ *  covers the light source, so that a decreasing crossing denotes the entry into, and an increasing crossing the exit
+ *  from, the penumbra.
+ */
+class EclipseEventSettings: public PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param associatedBody Propagated body for which eclipses are to be detected.
+     * \param occultingBody Body that occults the light source.
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     * \param lightSource Body emitting the light that is occulted (default Sun).
+     * \param eventName Name of the event (default "Eclipse of " + associatedBody + " by " + occultingBody).
+     */
+    EclipseEventSettings( const std::string& associatedBody,
+                          const std::string& occultingBody,
+                          const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+                          const bool isTerminal = false,
+                          const std::string& lightSource = "Sun",
+                          const std::string& eventName = "" ):
+        PropagationEventSettings( eclipse_event,
+                                  eventName.empty( ) ? "Eclipse of " + associatedBody + " by " + occultingBody : eventName,
+                                  associatedBody, crossingDirection, isTerminal ),
+        occultingBody_( occultingBody ), lightSource_( lightSource ){ }
+
+    //! Destructor
+    ~EclipseEventSettings( ){ }
+
+    //! Body that occults the light source.
+    std::string occultingBody_;
+
+    //! Body emitting the light that is occulted.
+    std::string lightSource_;
+};
+
+//! Class for defining the crossings of the x-y plane of the propagation frame by a propagated body.
+/*!
+ *  Class for defining the crossings of the x-y plane of the propagation frame (global frame orientation, centered on the
+ *  central body) by a propagated body. The event function is the z-component of the position w.r.t. the central body, so
+ *  that an increasing crossing denotes the ascending node, and a decreasing crossing the descending node.
+ */
+class NodeCrossingEventSettings: public PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param associatedBody Propagated body of which the node crossings are to be detected.
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     * \param eventName Name of the event (default "Node crossing of " + associatedBody).
+     */
+    NodeCrossingEventSettings( const std::string& associatedBody,
+                               const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+                               const bool isTerminal = false,
+                               const std::string& eventName = "" ):
+        PropagationEventSettings( node_crossing_event,
+                                  eventName.empty( ) ? "Node crossing of " + associatedBody : eventName,
+                                  associatedBody, crossingDirection, isTerminal ){ }
+
+    //! Destructor
+    ~NodeCrossingEventSettings( ){ }
+};
+
+//! Class for defining the apsis passages of a propagated body w.r.t. its central body.
+/*!
+ *  Class for defining the apsis passages of a propagated body w.r.t. its central body. The event function is the inner
+ *  product of the position and velocity w.r.t. the central body, so that an increasing crossing denotes a periapsis, and
+ *  a decreasing crossing an apoapsis passage.
+ */
+class ApsisEventSettings: public PropagationEventSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param associatedBody Propagated body of which the apsis passages are to be detected.
+     * \param crossingDirection Direction of the zero crossings of the event function that are to be detected.
+     * \param isTerminal Boolean denoting whether the propagation is to be stopped at the (first) event.
+     * \param eventName Name of the event (default "Apsis of " + associatedBody).
+     */
+    ApsisEventSettings( const std::string& associatedBody,
+                        const PropagationEventCrossingDirection crossingDirection = any_event_crossing,
+                        const bool isTerminal = false,
+                        const std::string& eventName = "" ):
+        PropagationEventSettings( apsis_event,
+                                  eventName.empty( ) ? "Apsis of " + associatedBody : eventName,
+                                  associatedBody, crossingDirection, isTerminal ){ }
+
+    //! Destructor
+    ~ApsisEventSettings( ){ }
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATIONEVENTSETTINGS_H
@@ -404,7 +404,8 @@ template std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::str
         const std::shared_ptr< DependentVariableSaveSettings > saveSettings,
         const simulation_setup::NamedBodyMap& bodyMap,
         const std::unordered_map< IntegratedStateType,
-        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > >& stateDerivativeModels );
+        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > >& stateDerivativeModels,
+        const std::shared_ptr< PropagationProfiler > propagationProfiler );
 
 //template std::pair< std::function< Eigen::VectorXd( ) >, int > getVectorDependentVariableFunction< double, double >(
 //        const std::shared_ptr< SingleDependentVariableSaveSettings > dependentVariableSettings,
@@ -1688,6 +1688,8 @@ Eigen::VectorXd evaluateListOfVectorFunctions(
  *  \param saveSettings Object containing types and other properties of dependent variables.
  *  \param bodyMap List of bodies to use in simulations (containing full environment).
  *  \param stateDerivativeModels List of state derivative models used in simulations (sorted by dynamics type as key)
+ *  \param propagationProfiler Object in which the computation time of each dependent variable function is to be recorded
+ *  (nullptr if computation time is not to be recorded).
  *  \return Pair with function returning requested dependent variable values, and list variable names with start entries.
  *  NOTE: The environment and state derivative models need to
  *  be updated to current state and independent variable before computation is performed.
@@ -1699,7 +1701,8 @@ std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::string > > c
         const std::unordered_map< IntegratedStateType,
         std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > >& stateDerivativeModels =
         std::unordered_map< IntegratedStateType,
-        std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > >( ) )
+        std::vector< std::shared_ptr< SingleStateTypeDerivative< StateScalarType, TimeType > > > >( ),
+        const std::shared_ptr< PropagationProfiler > propagationProfiler = nullptr )
 {
     // Retrieve list of save settings
     std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables =
@@ -1736,6 +1739,14 @@ std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::string > > c
                     getVectorDependentVariableFunction( variable, bodyMap, stateDerivativeModels );
 #endif
         }
+
+        // Record computation time of dependent variable, if required
+        if( propagationProfiler != nullptr )
+        {
+            vectorFunction.first = propagationProfiler->createProfiledFunction< Eigen::VectorXd >(
+                        dependent_variable_profile, getDependentVariableId( variable ), vectorFunction.first );
+        }
+
         vectorFunctionList.push_back( vectorFunction );
         vectorVariableList.push_back( std::make_pair( getDependentVariableId( variable ), vectorFunction.second ) );
     }
@@ -1758,7 +1769,8 @@ extern template std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, s
         const std::shared_ptr< DependentVariableSaveSettings > saveSettings,
         const simulation_setup::NamedBodyMap& bodyMap,
         const std::unordered_map< IntegratedStateType,
-        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > >& stateDerivativeModels );
+        std::vector< std::shared_ptr< SingleStateTypeDerivative< double, double > > > >& stateDerivativeModels,
+        const std::shared_ptr< PropagationProfiler > propagationProfiler );
 
 //extern template std::pair< std::function< Eigen::VectorXd( ) >, int > getVectorDependentVariableFunction< double, double >(
 //        const std::shared_ptr< SingleDependentVariableSaveSettings > dependentVariableSettings,
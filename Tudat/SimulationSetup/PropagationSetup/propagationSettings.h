@@ -26,7 +26,10 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/massRateModel.h"
 #include "Tudat/Astrodynamics/Propagators/singleStateTypeDerivative.h"
 #include "Tudat/Astrodynamics/Propagators/nBodyStateDerivative.h"
+#include "Tudat/Astrodynamics/Propagators/propagationCheckpoint.h"
+#include "Tudat/Astrodynamics/Propagators/propagationOutputSink.h"
 #include "Tudat/Astrodynamics/Propagators/rotationalMotionStateDerivative.h"
+#include "Tudat/SimulationSetup/PropagationSetup/propagationEventSettings.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationOutputSettings.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationTerminationSettings.h"
 #include "Tudat/SimulationSetup/PropagationSetup/createAccelerationModels.h"
@@ -166,7 +169,8 @@ public:
                                  const double printInterval = TUDAT_NAN ):
         PropagatorSettings< StateScalarType >( initialBodyStates, false ),
         stateType_( stateType ), terminationSettings_( terminationSettings ),
-        dependentVariablesToSave_( dependentVariablesToSave ), printInterval_( printInterval)
+        dependentVariablesToSave_( dependentVariablesToSave ), printInterval_( printInterval),
+        profilePropagation_( false )
     { }
 
     //! Virtual destructor.
@@ -240,6 +244,96 @@ public:
         terminationSettings_ = terminationSettings;
     }
 
+    //! Function to retrieve the sink to which the propagation results are passed during the propagation.
+    /*!
+     * Function to retrieve the sink to which the propagation results are passed during the propagation.
+     * \return Sink to which the propagation results are passed during the propagation (nullptr if none).
+     */
+    std::shared_ptr< PropagationOutputSinkBase > getOutputSink( )
+    {
+        return outputSink_;
+    }
+
+    //! Function to reset the sink to which the propagation results are passed during the propagation.
+    /*!
+     * Function to reset the sink to which the propagation results are passed during the propagation. If set, the
+     * dynamics simulator streams the results to this sink (which must be a PropagationOutputSink with the
+     * StateScalarType and TimeType of the dynamics simulator) and only retains the results at the final epoch,
+     * instead of the full state and dependent variable histories. Use an InMemoryPropagationOutputSink (combined with
+     * other sinks through a MultiplePropagationOutputSink) to stream the results while also retaining them in memory.
+     * \param outputSink Sink to which the propagation results are passed during the propagation (nullptr for none).
+     */
+    void resetOutputSink( const std::shared_ptr< PropagationOutputSinkBase > outputSink )
+    {
+        outputSink_ = outputSink;
+    }
+
+    //! Function to retrieve whether the computation time of the individual models is to be recorded during propagation.
+    /*!
+     * Function to retrieve whether the computation time of the individual models is to be recorded during propagation.
+     * \return Boolean denoting whether the computation time of the individual models is to be recorded.
+     */
+    bool getProfilePropagation( )
+    {
+        return profilePropagation_;
+    }
+
+    //! Function to set whether the computation time of the individual models is to be recorded during propagation.
+    /*!
+     * Function to set whether the computation time of the individual models is to be recorded during propagation. If set,
+     * the dynamics simulator records the wall time and number of calls of each acceleration, torque and mass rate model,
+     * environment update function and dependent variable function (see PropagationProfiler).
+     * \param profilePropagation Boolean denoting whether the computation time of the individual models is to be recorded.
+     */
+    void setProfilePropagation( const bool profilePropagation )
+    {
+        profilePropagation_ = profilePropagation;
+    }
+
+    //! Function to retrieve the settings for the checkpoints that are to be written during the propagation.
+    /*!
+     * Function to retrieve the settings for the checkpoints that are to be written during the propagation.
+     * \return Settings for the checkpoints that are to be written during the propagation (nullptr if none).
+     */
+    std::shared_ptr< PropagationCheckpointSettings > getCheckpointSettings( )
+    {
+        return checkpointSettings_;
+    }
+
+    //! Function to reset the settings for the checkpoints that are to be written during the propagation.
+    /*!
+     * Function to reset the settings for the checkpoints that are to be written during the propagation. If set, the
+     * dynamics simulator periodically writes a checkpoint, from which the propagation can be resumed (see
+     * SingleArcDynamicsSimulator::resumeEquationsOfMotionIntegrationFromCheckpoint).
+     * \param checkpointSettings Settings for the checkpoints that are to be written (nullptr for none).
+     */
+    void resetCheckpointSettings( const std::shared_ptr< PropagationCheckpointSettings > checkpointSettings )
+    {
+        checkpointSettings_ = checkpointSettings;
+    }
+
+    //! Function to retrieve the settings for the events that are to be detected during the propagation.
+    /*!
+     * Function to retrieve the settings for the events that are to be detected during the propagation.
+     * \return Settings for the events that are to be detected during the propagation (empty if none).
+     */
+    std::vector< std::shared_ptr< PropagationEventSettings > > getEventSettings( )
+    {
+        return eventSettings_;
+    }
+
+    //! Function to reset the settings for the events that are to be detected during the propagation.
+    /*!
+     * Function to reset the settings for the events that are to be detected during the propagation. The events are
+     * detected after each integration step, and are either logged (see SingleArcDynamicsSimulator::getDetectedEvents) or
+     * stop the propagation at the event (if terminal), in addition to the termination settings.
+     * \param eventSettings Settings for the events that are to be detected (empty for none).
+     */
+    void resetEventSettings( const std::vector< std::shared_ptr< PropagationEventSettings > >& eventSettings )
+    {
+        eventSettings_ = eventSettings;
+    }
+
 protected:
 
     //!Type of state being propagated
@@ -255,6 +349,18 @@ protected:
     //! current state and time are to be printed to console (default never).
     double printInterval_;
 
+    //! Sink to which the propagation results are passed during the propagation (default none).
+    std::shared_ptr< PropagationOutputSinkBase > outputSink_;
+
+    //! Boolean denoting whether the computation time of the individual models is to be recorded (default false).
+    bool profilePropagation_;
+
+    //! Settings for the checkpoints that are to be written during the propagation (default none).
+    std::shared_ptr< PropagationCheckpointSettings > checkpointSettings_;
+
+    //! Settings for the events that are to be detected during the propagation (default none).
+    std::vector< std::shared_ptr< PropagationEventSettings > > eventSettings_;
+
 };
 
 //! Function to get the total size of multi-arc initial state vector
@@ -737,6 +843,10 @@ public:
     //! Type of translational state propagator to be used
     TranslationalPropagatorType propagator_;
 
+    //! Number of threads over which independent groups of acceleration models are updated (1: serial, 0: all available).
+    //! See NBodyStateDerivative::setNumberOfAccelerationEvaluationThreads.
+    unsigned int numberOfAccelerationEvaluationThreads_ = 1;
+
     //! Function to create the acceleration models.
     /*!
      * Function to create the acceleration models.
@@ -29,7 +29,8 @@ enum PropagationTerminationReason
     unknown_propagation_termination_reason,
     termination_condition_reached,
     runtime_error_caught_in_propagation,
-    nan_or_inf_detected_in_state
+    nan_or_inf_detected_in_state,
+    terminal_event_detected
 };
 
 //! Base class for checking whether the numerical propagation is to be stopped at current time step or not
@@ -12,6 +12,7 @@
 #define TUDAT_SETNUMERICALLYINTEGRATEDSTATES_H
 
 #include "Tudat/Basics/utilities.h"
+#include "Tudat/Astrodynamics/Propagators/stateHistory.h"
 #include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
 #include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
 #include "Tudat/Astrodynamics/Ephemerides/multiArcEphemeris.h"
@@ -156,12 +157,11 @@ void resetIntegratedEphemerisOfBody(
  * \param integrationToEphemerisFrameFunction Function to provide the state of the ephemeris origin
  * of the current body w.r.t. its integration origin.
 */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void convertNumericalSolutionToEphemerisInput(
         const int bodyIndex,
         const int startIndex,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >&
-        equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisTable,
         const std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) >
         integrationToEphemerisFrameFunction = nullptr )
@@ -170,7 +170,7 @@ void convertNumericalSolutionToEphemerisInput(
     // extract required indices.
     if( integrationToEphemerisFrameFunction == 0 )
     {
-        for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator
+        for( typename NumericalSolutionType::const_iterator
              bodyIterator = equationsOfMotionNumericalSolution.begin( );
              bodyIterator != equationsOfMotionNumericalSolution.end( ); bodyIterator++ )
         {
@@ -180,7 +180,7 @@ void convertNumericalSolutionToEphemerisInput(
     // Else, extract indices and add required translation from integrationToEphemerisFrameFunction
     else
     {
-        for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator
+        for( typename NumericalSolutionType::const_iterator
              bodyIterator = equationsOfMotionNumericalSolution.begin( );
              bodyIterator != equationsOfMotionNumericalSolution.end( ); bodyIterator++ )
         {
@@ -206,12 +206,12 @@ void convertNumericalSolutionToEphemerisInput(
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void getSingleBodyStateHistoryFromPropagationOutpiut(
         const std::vector< std::string >& bodiesToIntegrate,
         const int translationalStateStartIndex,
         const std::string& bodyForWhichToRetrieveState,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > >& ephemerisInput,
         int& bodyIndex,
         const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
@@ -255,13 +255,13 @@ void getSingleBodyStateHistoryFromPropagationOutpiut(
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void createAndSetInterpolatorsForEphemerides(
         const simulation_setup::NamedBodyMap& bodyMap,
         const std::vector< std::string >& bodiesToIntegrate,
         const int startIndex,
         const std::vector< std::string >& ephemerisUpdateOrder,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         const std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
         std::map< std::string, std::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
@@ -275,7 +275,7 @@ void createAndSetInterpolatorsForEphemerides(
     for( unsigned int i = 0; i < ephemerisUpdateOrder.size( ); i++ )
     {
         ephemerisInput.clear( );
-        getSingleBodyStateHistoryFromPropagationOutpiut(
+        getSingleBodyStateHistoryFromPropagationOutpiut< TimeType, StateScalarType >(
                     bodiesToIntegrate, startIndex, ephemerisUpdateOrder.at( i ), equationsOfMotionNumericalSolution,
                     ephemerisInput, bodyIndex, integrationToEphemerisFrameFunctions );
         resetIntegratedEphemerisOfBody(
@@ -298,10 +298,10 @@ void createAndSetInterpolatorsForEphemerides(
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void resetIntegratedEphemerides(
         const simulation_setup::NamedBodyMap& bodyMap,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate,
         const std::pair< unsigned int, unsigned int > startIndexAndSize,
         std::vector< std::string > ephemerisUpdateOrder = std::vector< std::string >( ),
@@ -333,7 +333,7 @@ void resetIntegratedEphemerides(
     }
     
     // Create interpolators from numerical integration results (states) at discrete times.
-    createAndSetInterpolatorsForEphemerides(
+    createAndSetInterpolatorsForEphemerides< TimeType, StateScalarType >(
                 bodyMap, bodiesToIntegrate, startIndexAndSize.first, ephemerisUpdateOrder,
                 equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions );
 }
@@ -354,11 +354,10 @@ void resetIntegratedEphemerides(
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void resetMultiArcIntegratedEphemerides(
         const simulation_setup::NamedBodyMap& bodyMap,
-        const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
-        equationsOfMotionNumericalSolution,
+        const std::vector< NumericalSolutionType >& equationsOfMotionNumericalSolution,
         const std::vector< double > arcStartTimes,
         const std::vector< std::string >& bodiesToIntegrate,
         const std::pair< unsigned int, unsigned int > startIndexAndSize,
@@ -409,7 +408,7 @@ void resetMultiArcIntegratedEphemerides(
             }
 
             std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > currentArcSolution;
-            convertNumericalSolutionToEphemerisInput(
+            convertNumericalSolutionToEphemerisInput< TimeType, StateScalarType >(
                         bodyIndex, startIndexAndSize.first,
                         equationsOfMotionNumericalSolution.at( j ), currentArcSolution, integrationToEphemerisFrameFunction );
             
@@ -484,14 +483,14 @@ void resetIntegratedRotationalEphemerisOfBody(
  * \param equationsOfMotionNumericalSolution Full numerical solution of numerical integrator,
  * already converted to Cartesian states (w.r.t. the integration origin of the body of bodyIndex)
 */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void convertNumericalSolutionToRotationalEphemerisInput(
         const int startIndex,
         const int bodyIndex,
         std::map< TimeType, Eigen::Matrix< StateScalarType, 7, 1 > >& ephemerisTable,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+        const NumericalSolutionType& equationsOfMotionNumericalSolution )
 {
-    for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator bodyIterator =
+    for( typename NumericalSolutionType::const_iterator bodyIterator =
          equationsOfMotionNumericalSolution.begin( ); bodyIterator != equationsOfMotionNumericalSolution.end( ); bodyIterator++ )
     {
         ephemerisTable[ bodyIterator->first ] = bodyIterator->second.block( startIndex + 7 * bodyIndex, 0, 7, 1 );
@@ -528,12 +527,12 @@ createRotationalStateInterpolator(
  * \param startIndex Index in the state vector where the rotational state starts.
  * \param equationsOfMotionNumericalSolution New rotational state history that is to be set
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void createAndSetInterpolatorsForRotationalEphemerides(
         const simulation_setup::NamedBodyMap& bodyMap,
         const std::vector< std::string >& bodiesToIntegrate,
         const int startIndex,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+        const NumericalSolutionType& equationsOfMotionNumericalSolution )
 {
     using namespace tudat::interpolators;
     
@@ -563,15 +562,15 @@ void createAndSetInterpolatorsForRotationalEphemerides(
  * \param startIndexAndSize Pair with start index and total (contiguous) size of integrated states in entries of
  * equationsOfMotionNumericalSolution
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void resetIntegratedRotationalEphemerides(
         const simulation_setup::NamedBodyMap& bodyMap,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate,
         const std::pair< unsigned int, unsigned int > startIndexAndSize )
 {
     // Create interpolators from numerical integration results (states) at discrete times.
-    createAndSetInterpolatorsForRotationalEphemerides(
+    createAndSetInterpolatorsForRotationalEphemerides< TimeType, StateScalarType >(
                 bodyMap, bodiesToIntegrate, startIndexAndSize.first, equationsOfMotionNumericalSolution );
     
     // Having set new ephemerides, update body properties depending on ephemerides.
@@ -593,10 +592,10 @@ void resetIntegratedRotationalEphemerides(
  * \param startIndexAndSize Pair with start index and total (contiguous) size of integrated states in entries of
  * equationsOfMotionNumericalSolution
  */
-template< typename TimeType, typename StateScalarType >
+template< typename TimeType, typename StateScalarType, typename NumericalSolutionType >
 void resetIntegratedBodyMass(
         const simulation_setup::NamedBodyMap& bodyMap,
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const NumericalSolutionType& equationsOfMotionNumericalSolution,
         const std::vector< std::string >& bodiesToIntegrate ,
         const std::pair< unsigned int, unsigned int > startIndexAndSize )
 {
@@ -611,7 +610,7 @@ void resetIntegratedBodyMass(
         std::map< double, double > currentBodyMassMap;
         
         // Create mass map with double entries.
-        for( typename std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >::const_iterator
+        for( typename NumericalSolutionType::const_iterator
              stateIterator = equationsOfMotionNumericalSolution.begin( );
              stateIterator != equationsOfMotionNumericalSolution.end( ); stateIterator++ )
         {
@@ -662,11 +661,10 @@ public:
      * convertToOutputSolution function in associated SingleStateTypeDerivative derived class.
      */
     virtual void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType,
-            Eigen::Dynamic, 1 > >& numericalSolution ) = 0;
+            const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution ) = 0;
     
     virtual void processIntegratedMultiArcStates(
-            const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
+            const std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
             const std::vector< double >& arcStartTimes ) = 0;
     
     
@@ -735,8 +733,7 @@ public:
      * convertToOutputSolution function in NBodyStateDerivative class.
      */
     void processIntegratedStates(
-            const std::map< TimeType,
-            Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
     {
         resetIntegratedEphemerides< TimeType, StateScalarType >(
                     bodyMap_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_, ephemerisUpdateOrder_,
@@ -753,7 +750,7 @@ public:
      * \param arcStartTimes List of start times of the propagation arcs.
      */
     void processIntegratedMultiArcStates(
-            const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
+            const std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
             const std::vector< double >& arcStartTimes )
     {
         resetMultiArcIntegratedEphemerides< TimeType, StateScalarType >(
@@ -816,7 +813,7 @@ public:
      * convertToOutputSolution function in RotationalMotionStateDerivative class.
      */
     void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
     {
         resetIntegratedRotationalEphemerides< TimeType, StateScalarType >(
                     bodyMap_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
@@ -830,7 +827,7 @@ public:
      * \param arcStartTimes List of start times of the propagation arcs.
      */
     void processIntegratedMultiArcStates(
-            const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
+            const std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
             const std::vector< double >& arcStartTimes )
     {
         throw std::runtime_error( "Error, cannot yet set multi-arc rotational ephemeris" );
@@ -883,9 +880,9 @@ public:
      * for mass).
      */
     void processIntegratedStates(
-            const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
+            const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& numericalSolution )
     {
-        resetIntegratedBodyMass( bodyMap_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
+        resetIntegratedBodyMass< TimeType, StateScalarType >( bodyMap_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_ );
     }
     
     //! Function processing multi-arc translational mass, resetting bodies' mass models
@@ -895,7 +892,7 @@ public:
      * \param arcStartTimes List of start times of the propagation arcs.
      */
     void processIntegratedMultiArcStates(
-            const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
+            const std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >& numericalSolution,
             const std::vector< double >& arcStartTimes )
     {
         throw std::runtime_error( "Error, cannot yet reset multi-arc mass model" );
@@ -1092,7 +1089,7 @@ createIntegratedStateProcessors(
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedStates(
-        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
         const std::map< IntegratedStateType, std::vector< std::shared_ptr<
         IntegratedStateProcessor< TimeType, StateScalarType > > > >  integratedStateProcessors )
 {
@@ -1108,6 +1105,25 @@ void resetIntegratedStates(
     }
 }
 
+//! Function resetting dynamical properties of environment from numerical dynamics solution, provided as a map
+/*!
+ * Function to reset the dynamical properties of the environment from the numerically integrated
+ * dynamics solution, provided as a map (which is first copied into a StateHistory).
+ * \param equationsOfMotionNumericalSolution Solution produced by the numerical integration, in the
+ * 'conventional form'
+ * \param integratedStateProcessors List of objects (per dynamics type) used to process integrated
+ * results into environment
+ */
+template< typename TimeType, typename StateScalarType >
+void resetIntegratedStates(
+        const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
+        const std::map< IntegratedStateType, std::vector< std::shared_ptr<
+        IntegratedStateProcessor< TimeType, StateScalarType > > > >  integratedStateProcessors )
+{
+    resetIntegratedStates( StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >(
+                               equationsOfMotionNumericalSolution ), integratedStateProcessors );
+}
+
 //! Function resetting dynamical properties of environment from numerical multi-arc dynamics solution
 /*!
  * Function to reset the dynamical properties of the environment from the numerically integrated multi-arc
@@ -1121,7 +1137,7 @@ void resetIntegratedStates(
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedMultiArcStatesWithEqualArcDynamics(
-        const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
+        const std::vector< StateHistory< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
         equationsOfMotionNumericalSolution,
         const std::map< IntegratedStateType,
         std::vector< std::shared_ptr< IntegratedStateProcessor< TimeType, StateScalarType > > > >
@@ -288,6 +288,105 @@ BOOST_AUTO_TEST_CASE( test_shGravityModelSetup )
 
 }
 
+//! Test set up of gridded spherical harmonic gravitational acceleration.
+BOOST_AUTO_TEST_CASE( test_griddedShGravityModelSetup )
+{
+    // Load Spice kernels.
+    spice_interface::loadStandardSpiceKernels( );
+
+    // Create body map
+    NamedBodyMap bodyMap;
+    bodyMap[ "Earth" ] = std::make_shared< Body >( );
+    bodyMap[ "Vehicle" ] = std::make_shared< Body >( );
+
+    // Set constant state for Earth and Vehicle
+    Eigen::Vector6d dummyEarthState =
+            ( Eigen::Vector6d ( ) << 1.1E11, 0.5E11, 0.01E11, 0.0, 0.0, 0.0
+              ).finished( );
+    bodyMap[ "Earth" ]->setState( dummyEarthState );
+    bodyMap[ "Vehicle" ]->setState(
+                ( Eigen::Vector6d ( ) << 7.0e6, 8.0e6, 9.0e6, 0.0, 0.0, 0.0
+                  ).finished( ) + dummyEarthState );
+
+    // Define Earth gravity field (random coefficients of realistic magnitude up to degree and order 10).
+    double gravitationalParameter = 3.986004418e14;
+    double planetaryRadius = 6378137.0;
+    Eigen::MatrixXd cosineCoefficients = 1.0E-6 * Eigen::MatrixXd::Random( 11, 11 );
+    Eigen::MatrixXd sineCoefficients = 1.0E-6 * Eigen::MatrixXd::Random( 11, 11 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.841651437908150e-4;
+    cosineCoefficients.block( 1, 0, 1, 11 ).setZero( );
+    sineCoefficients.block( 1, 0, 1, 11 ).setZero( );
+    sineCoefficients.col( 0 ).setZero( );
+    bodyMap[ "Earth" ]->setGravityFieldModel(
+                std::make_shared< gravitation::SphericalHarmonicsGravityField >(
+                    gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, "IAU_Earth" ) );
+    bodyMap[ "Earth" ]->setRotationalEphemeris(
+                std::make_shared< ephemerides::SpiceRotationalEphemeris >(
+                    "ECLIPJ2000", "IAU_Earth" ) );
+    bodyMap[ "Earth" ]->setCurrentRotationToLocalFrameFromEphemeris( 0.0 );
+
+    // Define settings for direct and gridded acceleration models, grid covering 10000 to 20000 km.
+    std::shared_ptr< GriddedSphericalHarmonicAccelerationSettings > griddedSettings =
+            std::make_shared< GriddedSphericalHarmonicAccelerationSettings >(
+                10, 10, 1.0E7, 2.0E7, 8, 37, 72 );
+    SelectedAccelerationMap accelerationSettingsMap;
+    accelerationSettingsMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< SphericalHarmonicAccelerationSettings >( 10, 10 ) );
+    accelerationSettingsMap[ "Vehicle" ][ "Earth" ].push_back( griddedSettings );
+    accelerationSettingsMap[ "Vehicle" ][ "Earth" ].push_back( griddedSettings );
+
+    // Set accelerations to be calculated w.r.t. the Earth.
+    std::map< std::string, std::string > centralBodies;
+    centralBodies[ "Vehicle" ] = "Earth";
+
+    // Create and retrieve accelerations.
+    AccelerationMap accelerationsMap = createAccelerationModelsMap(
+                bodyMap, accelerationSettingsMap, centralBodies );
+    std::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > >
+            directAcceleration = accelerationsMap[ "Vehicle" ][ "Earth" ][ 0 ];
+    std::shared_ptr< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel > griddedAcceleration =
+            std::dynamic_pointer_cast< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel >(
+                accelerationsMap[ "Vehicle" ][ "Earth" ][ 1 ] );
+    std::shared_ptr< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel > secondGriddedAcceleration =
+            std::dynamic_pointer_cast< gravitation::GriddedSphericalHarmonicsGravitationalAccelerationModel >(
+                accelerationsMap[ "Vehicle" ][ "Earth" ][ 2 ] );
+    BOOST_CHECK_EQUAL( getAccelerationModelType( griddedAcceleration ), gridded_spherical_harmonic_gravity );
+
+    // Check that the grid is computed only once for both models, and that it is stored in the settings.
+    BOOST_CHECK_EQUAL( griddedAcceleration->getAccelerationGrid( ),
+                       secondGriddedAcceleration->getAccelerationGrid( ) );
+    BOOST_CHECK_EQUAL( griddedAcceleration->getAccelerationGrid( ), griddedSettings->accelerationGrid_ );
+    BOOST_CHECK_EQUAL( griddedAcceleration->getAccelerationGrid( )->getMaximumDegree( ), 10 );
+
+    // Compare gridded and direct acceleration, inside of the grid.
+    Eigen::Vector3d expectedAcceleration = updateAndGetAcceleration( directAcceleration, 0.0 );
+    Eigen::Vector3d griddedAccelerationValue = updateAndGetAcceleration(
+                std::shared_ptr< AccelerationModel3d >( griddedAcceleration ), 0.0 );
+    BOOST_CHECK_SMALL( ( griddedAccelerationValue - expectedAcceleration ).norm( ),
+                       2.0 * griddedAcceleration->getAccelerationGrid( )->getMaximumInterpolationError( ) +
+                       1.0E-14 * expectedAcceleration.norm( ) );
+    BOOST_CHECK_EQUAL( griddedAcceleration->getNumberOfDirectEvaluations( ), 0 );
+
+    // Compare gridded and direct acceleration, outside of the grid (direct evaluation is used).
+    bodyMap[ "Vehicle" ]->setState(
+                ( Eigen::Vector6d ( ) << 1.0e7, 2.0e7, 3.0e7, 0.0, 0.0, 0.0
+                  ).finished( ) + dummyEarthState );
+    expectedAcceleration = updateAndGetAcceleration( directAcceleration, 1.0 );
+    griddedAccelerationValue = updateAndGetAcceleration(
+                std::shared_ptr< AccelerationModel3d >( griddedAcceleration ), 1.0 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( griddedAccelerationValue, expectedAcceleration, 1.0E-12 );
+    BOOST_CHECK_EQUAL( griddedAcceleration->getNumberOfDirectEvaluations( ), 1 );
+
+    // Check that grid files that do not exist cannot be used without grid settings.
+    accelerationSettingsMap[ "Vehicle" ][ "Earth" ].clear( );
+    accelerationSettingsMap[ "Vehicle" ][ "Earth" ].push_back(
+                std::make_shared< GriddedSphericalHarmonicAccelerationSettings >( "nonExistingGridFile.bin" ) );
+    BOOST_CHECK_THROW( createAccelerationModelsMap( bodyMap, accelerationSettingsMap, centralBodies ),
+                       std::runtime_error );
+}
+
 //! Test radiation pressure acceleration
 BOOST_AUTO_TEST_CASE( test_radiationPressureAcceleration )
 {
@@ -12,6 +12,7 @@
 
 #include <limits>
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/make_shared.hpp>
 
@@ -43,6 +44,7 @@
 #endif
 #include "Tudat/Astrodynamics/Gravitation/triAxialEllipsoidGravity.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/binaryGravityFieldFile.h"
 #include "Tudat/InputOutput/matrixTextFileReader.h"
 #include "Tudat/InputOutput/solarActivityData.h"
 #include "Tudat/InputOutput/parseSolarActivityData.h"
@@ -429,6 +431,63 @@ BOOST_AUTO_TEST_CASE( test_gravityFieldSetup )
 
 }
 
+//! Test conversion of gravity field files to binary format, and loading of binary gravity field files.
+BOOST_AUTO_TEST_CASE( test_binaryGravityFieldFileSetup )
+{
+    const std::string binaryFileName = ( boost::filesystem::temp_directory_path( ) /
+                                         boost::filesystem::unique_path( "testGravityField-%%%%-%%%%.bin" ) ).string( );
+
+    std::vector< SphericalHarmonicsModel > modelsToConvert = { egm96, ggm02c, lpe200, jgmro120d };
+    for( unsigned int i = 0; i < modelsToConvert.size( ); i++ )
+    {
+        const std::string textFileName = getPathForSphericalHarmonicsModel( modelsToConvert.at( i ) );
+        convertSphericalHarmonicsModelToBinary( modelsToConvert.at( i ), binaryFileName );
+        BOOST_CHECK_EQUAL( isBinaryGravityFieldFile( binaryFileName ), true );
+        BOOST_CHECK_THROW( convertGravityFieldFileToBinary( binaryFileName, binaryFileName, 0, 1 ), std::runtime_error );
+
+        // Check that all coefficients are converted.
+        std::pair< int, int > maximumDegreeAndOrder = getMaximumDegreeAndOrderOfGravityFieldFile( textFileName, true );
+        {
+            MemoryMappedGravityFieldFile binaryFile( binaryFileName );
+            BOOST_CHECK_EQUAL( binaryFile.getMaximumDegree( ), maximumDegreeAndOrder.first );
+            BOOST_CHECK_EQUAL( binaryFile.getMaximumOrder( ), maximumDegreeAndOrder.second );
+        }
+
+        // Compare (truncated) coefficients and reference data loaded from text and binary file (must be identical).
+        for( int test = 0; test < 3; test++ )
+        {
+            const int maximumDegree = ( test == 0 ) ? maximumDegreeAndOrder.first : ( ( test == 1 ) ? 50 : 100 );
+            const int maximumOrder = ( test == 0 ) ? maximumDegreeAndOrder.second : ( ( test == 1 ) ? 50 : 20 );
+
+            std::pair< Eigen::MatrixXd, Eigen::MatrixXd > textCoefficients, binaryCoefficients;
+            std::pair< double, double > textReferenceData = readGravityFieldFile(
+                        textFileName, maximumDegree, maximumOrder, textCoefficients, 0, 1 );
+            std::pair< double, double > binaryReferenceData = readGravityFieldFile(
+                        binaryFileName, maximumDegree, maximumOrder, binaryCoefficients, 0, 1 );
+
+            BOOST_CHECK_EQUAL( textReferenceData.first, binaryReferenceData.first );
+            BOOST_CHECK_EQUAL( textReferenceData.second, binaryReferenceData.second );
+            BOOST_CHECK_EQUAL( ( textCoefficients.first == binaryCoefficients.first ), true );
+            BOOST_CHECK_EQUAL( ( textCoefficients.second == binaryCoefficients.second ), true );
+        }
+
+        // Check gravity field settings created from binary file.
+        FromFileSphericalHarmonicsGravityFieldSettings textFieldSettings(
+                    textFileName, getReferenceFrameForSphericalHarmonicsModel( modelsToConvert.at( i ) ), 30, 30, 0, 1 );
+        FromFileSphericalHarmonicsGravityFieldSettings binaryFieldSettings(
+                    binaryFileName, getReferenceFrameForSphericalHarmonicsModel( modelsToConvert.at( i ) ), 30, 30, 0, 1 );
+        BOOST_CHECK_EQUAL( textFieldSettings.getGravitationalParameter( ),
+                           binaryFieldSettings.getGravitationalParameter( ) );
+        BOOST_CHECK_EQUAL( textFieldSettings.getReferenceRadius( ), binaryFieldSettings.getReferenceRadius( ) );
+        BOOST_CHECK_EQUAL( ( textFieldSettings.getCosineCoefficients( ) ==
+                             binaryFieldSettings.getCosineCoefficients( ) ), true );
+        BOOST_CHECK_EQUAL( ( textFieldSettings.getSineCoefficients( ) ==
+                             binaryFieldSettings.getSineCoefficients( ) ), true );
+    }
+
+    boost::filesystem::remove( binaryFileName );
+}
+
 //! Test set up of triaxial ellipsoid gravity field model settings
 BOOST_AUTO_TEST_CASE( test_triaxialEllipsoidGravityFieldSetup )
 {